@@ -20,6 +20,9 @@
 #ifdef SIMP_EXTERNAL
 #include <ddMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
 #include <util/accumulators/Average.h>
 #include <util/format/Int.h>
 #include <util/format/Dbl.h>
@@ -53,6 +56,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       externalAveragePtr_(0),
       #endif
+      #ifdef SIMP_COULOMB
+      coulombAveragePtr_(0),
+      #endif
       nSamplePerBlock_(0),
       isInitialized_(false)
    {  setClassName("EnergyAnalyzer"); }
@@ -93,6 +99,12 @@ namespace DdMd
             externalAveragePtr_->setNSamplePerBlock(nSamplePerBlock_);
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (sim.hasCoulomb()) {
+            coulombAveragePtr_ = new Average;
+            coulombAveragePtr_->setNSamplePerBlock(nSamplePerBlock_);
+         }
+         #endif
       }
 
       isInitialized_ = true;
@@ -143,6 +155,12 @@ namespace DdMd
             ar >> *externalAveragePtr_;
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (sim.hasCoulomb()) {
+            coulombAveragePtr_ = new Average;
+            ar >> *coulombAveragePtr_;
+         }
+         #endif
       }
 
       isInitialized_ = true;
@@ -183,6 +201,11 @@ namespace DdMd
          ar << *externalAveragePtr_;
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (sim.hasCoulomb()) {
+         ar << *coulombAveragePtr_;
+      }
+      #endif
    }
   
    /*
@@ -215,6 +238,11 @@ namespace DdMd
             externalAveragePtr_->clear();
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (sim.hasCoulomb()) {
+            coulombAveragePtr_->clear();
+         }
+         #endif
       }
    }
 
@@ -284,6 +312,14 @@ namespace DdMd
                // outputFile_ << Dbl(external, 15);
             }
             #endif
+            #ifdef SIMP_COULOMB
+            if (sim.hasCoulomb()) {
+               double coulomb = sim.coulombPotential().energy();
+               potential += coulomb;
+               coulombAveragePtr_->sample(coulomb);
+               // outputFile_ << Dbl(coulomb, 15);
+            }
+            #endif
             double total = kinetic + potential;
             totalAveragePtr_->sample(total);
             // outputFile_ << Dbl(total, 20)
@@ -315,6 +351,11 @@ namespace DdMd
                   outputFile_ << Dbl(externalAveragePtr_->blockAverage());
                }
                #endif
+               #ifdef SIMP_COULOMB
+               if (sim.hasCoulomb()) {
+                  outputFile_ << Dbl(coulombAveragePtr_->blockAverage());
+               }
+               #endif
                outputFile_ << Dbl(totalAveragePtr_->blockAverage());
                outputFile_ << "\n";
             }
@@ -378,6 +419,13 @@ namespace DdMd
             outputFile_ << "External  " << Dbl(ave) << " +- " << Dbl(err, 9, 2) << "\n";
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (sim.hasCoulomb()) {
+            ave = coulombAveragePtr_->average();
+            err = coulombAveragePtr_->blockingError();
+            outputFile_ << "Coulomb   " << Dbl(ave) << " +- " << Dbl(err, 9, 2) << "\n";
+         }
+         #endif
          ave = totalAveragePtr_->average();
          err = totalAveragePtr_->blockingError();
          outputFile_ << "Total     " << Dbl(ave) << " +- " << Dbl(err, 9, 2) << "\n";
@@ -425,6 +473,14 @@ namespace DdMd
             externalAveragePtr_->output(outputFile_);
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (sim.hasCoulomb()) {
+            outputFile_ << 
+            "---------------------------------------------------------------------------------\n";
+            outputFile_ << "Coulomb:\n\n";
+            coulombAveragePtr_->output(outputFile_);
+         }
+         #endif
          outputFile_ << 
          "---------------------------------------------------------------------------------\n";
          outputFile_ << "Total:\n\n";
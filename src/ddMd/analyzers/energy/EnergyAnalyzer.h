@@ -117,6 +117,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       Average* externalAveragePtr_;
       #endif
+      #ifdef SIMP_COULOMB
+      Average* coulombAveragePtr_;
+      #endif
 
       // Number of sample per block average
       int nSamplePerBlock_;
@@ -19,6 +19,9 @@
 #ifdef SIMP_EXTERNAL
 #include <ddMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
 #include <util/format/Int.h>
 #include <util/format/Dbl.h>
 #include <util/mpi/MpiLoader.h>
@@ -143,6 +146,13 @@ namespace DdMd
                outputFile_ << Dbl(external, 15);
             }
             #endif
+            #ifdef SIMP_COULOMB
+            if (sim.hasCoulomb()) {
+               double coulomb = sim.coulombPotential().energy();
+               potential += coulomb;
+               outputFile_ << Dbl(coulomb, 15);
+            }
+            #endif
             outputFile_ << Dbl(kinetic + potential, 20)
                         << std::endl;
          }
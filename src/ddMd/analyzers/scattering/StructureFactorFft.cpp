@@ -0,0 +1,194 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorFft.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <simp/boundary/Boundary.h>
+#include <util/space/Vector.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   StructureFactorFft::StructureFactorFft(Simulation& simulation) 
+    : Analyzer(simulation),
+      nMode_(0),
+      order_(4),
+      nAtomType_(0),
+      isInitialized_(false)
+   {  setClassName("StructureFactorFft"); }
+
+   /*
+   * Destructor.
+   */
+   StructureFactorFft::~StructureFactorFft() 
+   {}
+
+   /*
+   * Read parameters from file, and allocate mesh.
+   */
+   void StructureFactorFft::readParameters(std::istream& in) 
+   {
+      nAtomType_ = simulation().nAtomType();
+
+      readInterval(in);
+      readOutputFileName(in);
+      read<int>(in, "nMode", nMode_);
+      modes_.allocate(nMode_, nAtomType_);
+      readDMatrix<double>(in, "modes", modes_, nMode_, nAtomType_);
+      read<IntVector>(in, "gridDimensions", gridDimensions_);
+      order_ = 4;
+      readOptional<int>(in, "order", order_);
+
+      allocate();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void StructureFactorFft::loadParameters(Serializable::IArchive &ar)
+   {
+      nAtomType_ = simulation().nAtomType();
+
+      loadInterval(ar);
+      loadOutputFileName(ar);
+      loadParameter<int>(ar, "nMode", nMode_);
+      modes_.allocate(nMode_, nAtomType_);
+      loadDMatrix<double>(ar, "modes", modes_, nMode_, nAtomType_);
+      loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      order_ = 4;
+      bool isRequired = false;
+      loadParameter<int>(ar, "order", order_, isRequired);
+
+      allocate();
+
+      // Accumulators exist only on master.
+      if (simulation().domain().isMaster()) {
+         mesh_.serialize(ar, 0);
+      }
+
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void StructureFactorFft::save(Serializable::OArchive &ar)
+   {
+      saveInterval(ar);
+      saveOutputFileName(ar);
+      ar << nMode_;
+      ar << modes_;
+      ar << gridDimensions_;
+      bool isActive = true;
+      Parameter::saveOptional(ar, order_, isActive);
+      mesh_.serialize(ar, 0);
+   }
+
+   /*
+   * Allocate mesh and per-type weights.
+   */
+   void StructureFactorFft::allocate()
+   {
+      mesh_.allocate(gridDimensions_, nMode_, order_);
+      weights_.allocate(nAtomType_, nMode_);
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            weights_(i, j) = modes_(j, i);
+         }
+      }
+      if (simulation().domain().isMaster()) {
+         totalGrid_.allocate(mesh_.gridSize());
+      }
+   }
+  
+   /*
+   * Define shells and clear accumulators.
+   */
+   void StructureFactorFft::clear() 
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Error: object is not initialized");
+      }
+      if (simulation().domain().isMaster()) {
+         mesh_.setBins(simulation().boundary());
+      }
+   }
+
+   /*
+   * Spread local atoms, sum meshes on master, and sample.
+   */
+   void StructureFactorFft::sample(long iStep) 
+   {
+      if (!isAtInterval(iStep))  {
+         UTIL_THROW("Time step index not a multiple of interval");
+      }
+
+      // Assign weights of local atoms to mesh
+      Boundary& boundary = simulation().boundary();
+      bool isCartesian = simulation().atomStorage().isCartesian();
+      Vector r;
+      AtomIterator atomIter;
+      mesh_.clearGrid();
+      simulation().atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         if (isCartesian) {
+            boundary.transformCartToGen(atomIter->position(), r);
+         } else {
+            r = atomIter->position();
+         }
+         mesh_.spread(r, &weights_(atomIter->typeId(), 0));
+      }
+
+      // Sum meshes on master
+      double* grid = mesh_.grid();
+      int size = mesh_.gridSize();
+      #ifdef UTIL_MPI
+      simulation().domain().communicator().
+                   Reduce(grid, totalGrid_.cArray(), size,
+                          MPI::DOUBLE, MPI::SUM, 0);
+      if (simulation().domain().isMaster()) {
+         for (int i = 0; i < size; ++i) {
+            grid[i] = totalGrid_[i];
+         }
+      }
+      #endif
+
+      // Transform and accumulate
+      if (simulation().domain().isMaster()) {
+         mesh_.sample(boundary);
+      }
+   }
+
+   /*
+   * Write parameters and structure factors.
+   */
+   void StructureFactorFft::output()
+   {
+      if (simulation().domain().isMaster()) {
+         simulation().fileMaster().openOutputFile(outputFileName(".prm"), 
+                                                  outputFile_);
+         writeParam(outputFile_);
+         outputFile_.close();
+
+         simulation().fileMaster().openOutputFile(outputFileName(".dat"), 
+                                                  outputFile_);
+         mesh_.output(outputFile_);
+         outputFile_.close();
+      }
+   }
+
+}
@@ -0,0 +1,137 @@
+#ifndef DDMD_STRUCTURE_FACTOR_FFT_H
+#define DDMD_STRUCTURE_FACTOR_FFT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/Analyzer.h>
+#include <simp/scattering/StructureFactorMesh.h>  // member
+#include <util/containers/DMatrix.h>              // member template
+#include <util/containers/DArray.h>               // member template
+#include <util/space/IntVector.h>                 // member
+
+#include <iostream>
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Spherically averaged structure factors, computed with an FFT.
+   *
+   * This analyzer computes the same quantities as StructureFactor, 
+   * \f$ S_m(q) = < |\rho_m(q)|^2 / V > \f$ for weighted densities
+   * defined by a set of mode vectors, but for all wavevectors up to
+   * the Nyquist limit of a mesh, averaged over spherical shells. 
+   * Each processor assigns the weights of its local atoms to a mesh
+   * with B-spline assignment functions of a specified order. The 
+   * meshes are summed on the master processor, which performs the 
+   * FFT, deconvolves the assignment function and accumulates the 
+   * results (see Simp::StructureFactorMesh). Requires SIMP_FFTW.
+   *
+   * \sa \ref ddMd_analyzer_StructureFactorFft_page "param file format"
+   * 
+   * \ingroup DdMd_Analyzer_Scattering_Module
+   */
+   class StructureFactorFft : public Analyzer
+   {
+
+   public:
+
+      /**	
+      * Constructor.
+      *
+      * \param simulation  reference to parent Simulation object
+      */
+      StructureFactorFft(Simulation& simulation);
+
+      /**	
+      * Destructor.
+      */
+      ~StructureFactorFft();
+
+      /**
+      * Read parameters from file, and allocate the mesh.
+      *
+      * \param in  input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar  input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar  output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+  
+      /** 
+      * Define shells, using the current boundary, and clear accumulators.
+      */
+      virtual void clear();
+   
+      /**
+      * Assign atoms to the mesh, transform, and add to accumulators.
+      *
+      * \param iStep  MD time step counter
+      */
+      void sample(long iStep);
+
+      /**
+      * Output results to file.
+      */
+      virtual void output();
+
+   private:
+
+      /// Output file stream.
+      std::ofstream outputFile_;
+
+      /// Mesh, FFT and shell accumulators.
+      StructureFactorMesh mesh_;
+
+      /// Sum of meshes from all processors (master only).
+      DArray<double> totalGrid_;
+
+      /// Mode vectors, indexed by mode and atom type.
+      DMatrix<double> modes_;
+
+      /// Weights, indexed by atom type and mode (transpose of modes_).
+      DMatrix<double> weights_;
+
+      /// Number of grid points in each direction.
+      IntVector gridDimensions_;
+
+      /// Number of mode vectors.
+      int nMode_;
+
+      /// Order of the B-spline assignment function.
+      int order_;
+
+      /// Number of atom types, copied from Simulation::nAtomType().
+      int nAtomType_;
+
+      /// Has readParam been called?
+      bool isInitialized_;
+
+      /*
+      * Allocate mesh and work space, after reading parameters.
+      */
+      void allocate();
+
+   };
+
+}
+#endif
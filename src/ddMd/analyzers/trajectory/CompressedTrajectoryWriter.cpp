@@ -0,0 +1,182 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryWriter.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/AtomCollector.h>
+#include <ddMd/chemistry/Atom.h>
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryWriter::CompressedTrajectoryWriter(Simulation& sim)
+    : TrajectoryWriter(sim, true),
+      encoder_(),
+      positions_(),
+      velocities_(),
+      velocityPrecision_(0.0),
+      positionBits_(20),
+      nAtom_(0)
+   {  setClassName("CompressedTrajectoryWriter"); }
+
+   /*
+   * Destructor.
+   */
+   CompressedTrajectoryWriter::~CompressedTrajectoryWriter()
+   {}
+
+   /*
+   * Read parameters of base class, and optional compression parameters.
+   */
+   void CompressedTrajectoryWriter::readParameters(std::istream& in)
+   {
+      TrajectoryWriter::readParameters(in);
+      positionBits_ = 20;
+      readOptional<int>(in, "positionBits", positionBits_);
+      velocityPrecision_ = 0.0;
+      readOptional<double>(in, "velocityPrecision", velocityPrecision_);
+      encoder_.setPositionBits(positionBits_);
+      encoder_.setVelocityPrecision(velocityPrecision_);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void 
+   CompressedTrajectoryWriter::loadParameters(Serializable::IArchive &ar)
+   {
+      TrajectoryWriter::loadParameters(ar);
+      bool isRequired = false;
+      positionBits_ = 20;
+      loadParameter<int>(ar, "positionBits", positionBits_, isRequired);
+      velocityPrecision_ = 0.0;
+      loadParameter<double>(ar, "velocityPrecision", velocityPrecision_, 
+                            isRequired);
+      encoder_.setPositionBits(positionBits_);
+      encoder_.setVelocityPrecision(velocityPrecision_);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void CompressedTrajectoryWriter::save(Serializable::OArchive &ar)
+   {
+      TrajectoryWriter::save(ar);
+      bool isActive = true;
+      Parameter::saveOptional(ar, positionBits_, isActive);
+      isActive = (velocityPrecision_ > 0.0);
+      Parameter::saveOptional(ar, velocityPrecision_, isActive);
+   }
+
+   /*
+   * Store number of atoms and allocate arrays indexed by id.
+   */
+   void CompressedTrajectoryWriter::allocate(int nAtom)
+   {
+      if (positions_.isAllocated() && positions_.capacity() != nAtom) {
+         positions_.deallocate();
+         if (velocities_.isAllocated()) {
+            velocities_.deallocate();
+         }
+      }
+      if (!positions_.isAllocated() && nAtom > 0) {
+         positions_.allocate(nAtom);
+      }
+      if (encoder_.hasVelocities()) {
+         if (!velocities_.isAllocated() && nAtom > 0) {
+            velocities_.allocate(nAtom);
+         }
+      }
+      nAtom_ = nAtom;
+   }
+
+   /*
+   * Write file header (master only).
+   */
+   void CompressedTrajectoryWriter::writeHeader(std::ofstream &file)
+   {
+      atomStorage().computeNAtomTotal(domain().communicator());
+      if (domain().isMaster()) {  
+         allocate(atomStorage().nAtomTotal());
+         encoder_.writeHeader(file, nAtom_);
+      }
+   }
+
+   /*
+   * Collect atoms by id, compress and write one frame.
+   */
+   void CompressedTrajectoryWriter::writeFrame(std::ofstream &file, long iStep)
+   {
+      if (domain().isMaster()) {  
+         bool isCartesian = atomStorage().isCartesian();
+         bool hasVelocities = encoder_.hasVelocities();
+         int id;
+         int n = 0;
+         atomCollector().setup();
+         Atom* atomPtr = atomCollector().nextPtr();
+         while (atomPtr) {
+            id = atomPtr->id();
+            if (id < 0 || id >= nAtom_) {
+               UTIL_THROW("Atom id out of range");
+            }
+            if (isCartesian) {
+               boundary().transformCartToGen(atomPtr->position(), 
+                                             positions_[id]);
+            } else {
+               positions_[id] = atomPtr->position();
+            }
+            if (hasVelocities) {
+               velocities_[id] = atomPtr->velocity();
+            }
+            ++n;
+            atomPtr = atomCollector().nextPtr();
+         }
+         if (n != nAtom_) {
+            UTIL_THROW("Number of atoms collected != nAtom in header");
+         }
+         encoder_.writeFrame(file, iStep, boundary(), positions_.cArray(),
+                             hasVelocities ? velocities_.cArray() : 0);
+      } else { 
+         atomCollector().send();
+      }
+   }
+
+   /*
+   * Write a frame from a staging buffer (master only, no velocities).
+   */
+   void CompressedTrajectoryWriter::encodeFrame(std::ofstream &file, 
+                                                TrajectoryFrame& frame)
+   {
+      int n = frame.size();
+      if (n != nAtom_) {
+         UTIL_THROW("Number of atoms collected != nAtom in header");
+      }
+      int id;
+      for (int i = 0; i < n; ++i) {
+         id = frame.ids[i];
+         if (id < 0 || id >= nAtom_) {
+            UTIL_THROW("Atom id out of range");
+         }
+         positions_[id] = frame.positions[i];
+      }
+      encoder_.writeFrame(file, frame.iStep, frame.boundary, 
+                          positions_.cArray(), 0);
+   }
+
+   /*
+   * Write the frame index at the end of the file.
+   */
+   void CompressedTrajectoryWriter::writeFooter(std::ofstream &file)
+   {  encoder_.writeIndex(file); }
+
+}
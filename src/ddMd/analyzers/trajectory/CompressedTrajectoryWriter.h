@@ -0,0 +1,146 @@
+#ifndef DDMD_COMPRESSED_TRAJECTORY_WRITER_H
+#define DDMD_COMPRESSED_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/trajectory/TrajectoryWriter.h>   // base class
+#include <simp/trajectory/CompressedTrajectoryEncoder.h>  // member
+#include <util/containers/DArray.h>                       // member
+#include <util/space/Vector.h>                            // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Write a trajectory in the compressed, indexed binary format.
+   *
+   * See Simp::CompressedTrajectoryEncoder for a description of the 
+   * file format. Atom ids must be 0,...,nAtom-1. Frames are indexed,
+   * so that readers can seek directly to any frame.
+   *
+   * Parameter file format:
+   * \code
+   *    interval           int
+   *    outputFileName     string
+   *    nFrameBuffer*      int    (0 by default)
+   *    positionBits*      int    (20 by default)
+   *    velocityPrecision* double (0.0 by default, no velocities)
+   * \endcode
+   * Asynchronous output (nFrameBuffer > 0) is not available when 
+   * velocities are written.
+   *
+   * \ingroup DdMd_Analyzer_Trajectory_Module
+   */
+   class CompressedTrajectoryWriter : public TrajectoryWriter
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object
+      */
+      CompressedTrajectoryWriter(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CompressedTrajectoryWriter();
+
+      /**
+      * Read parameters.
+      *
+      * \param in input parameter file
+      */
+      virtual void readParameters(std::istream& in);
+   
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+   protected:
+
+      /**
+      * Write trajectory file header.
+      *
+      * \param file output file stream
+      */
+      void writeHeader(std::ofstream &file);
+
+      /**
+      * Write a single frame. 
+      *
+      * \param file output file stream
+      * \param iStep MD time step index
+      */
+      void writeFrame(std::ofstream &file, long iStep);
+
+      /**
+      * Write a frame from a staging buffer.
+      *
+      * \param file output file stream
+      * \param frame staging copy of the frame
+      */
+      void encodeFrame(std::ofstream &file, TrajectoryFrame& frame);
+
+      /**
+      * Return true if velocities are not written.
+      */
+      bool hasEncodeFrame() const
+      {  return (velocityPrecision_ <= 0.0); }
+
+      /**
+      * Write the frame index.
+      *
+      * \param file output file stream
+      */
+      void writeFooter(std::ofstream &file);
+
+   private:
+
+      /// Compression and file format.
+      CompressedTrajectoryEncoder encoder_;
+
+      /// Generalized positions, indexed by atom id (master only).
+      DArray<Vector> positions_;
+
+      /// Velocities, indexed by atom id (master only).
+      DArray<Vector> velocities_;
+
+      /// Resolution of velocity components (0 for no velocities).
+      double velocityPrecision_;
+
+      /// Number of bits per generalized coordinate.
+      int positionBits_;
+
+      /// Number of atoms in the file.
+      int nAtom_;
+
+      /*
+      * Check and store number of atoms, allocate arrays.
+      */
+      void allocate(int nAtom);
+
+   };
+
+}
+#endif
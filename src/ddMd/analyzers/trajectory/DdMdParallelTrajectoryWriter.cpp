@@ -0,0 +1,179 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdParallelTrajectoryWriter.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/chemistry/Atom.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/space/Vector.h>
+#include <util/misc/FileMaster.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   DdMdParallelTrajectoryWriter::DdMdParallelTrajectoryWriter(
+                                                    Simulation& simulation)
+    : TrajectoryWriter(simulation, true),
+      offset_(0),
+      nAtom_(0),
+      isOpen_(false),
+      hasRecordType_(false)
+   {  setClassName("DdMdParallelTrajectoryWriter"); }
+
+   /*
+   * Destructor.
+   */
+   DdMdParallelTrajectoryWriter::~DdMdParallelTrajectoryWriter()
+   {
+      if (isOpen_) {
+         file_.Close();
+      }
+      if (hasRecordType_) {
+         recordType_.Free();
+      }
+   }
+
+   /*
+   * Open the file on all processors and write header (number of atoms).
+   */
+   void DdMdParallelTrajectoryWriter::setup()
+   {
+      if (nFrameBuffer() > 0) {
+         UTIL_THROW("nFrameBuffer > 0 not supported by this format");
+      }
+      MPI::Intracomm& comm = domain().communicator();
+      if (!hasRecordType_) {
+         recordType_ = MPI::BYTE.Create_contiguous(sizeof(Record));
+         recordType_.Commit();
+         hasRecordType_ = true;
+      }
+      if (isOpen_) {
+         file_.Close();
+         isOpen_ = false;
+      }
+      int mode = MPI::MODE_WRONLY | MPI::MODE_CREATE;
+      std::string filename = simulation().fileMaster().outputPrefix()
+                           + outputFileName();
+      file_ = MPI::File::Open(comm, filename.c_str(), mode, MPI::INFO_NULL);
+      file_.Set_size(0);
+      isOpen_ = true;
+
+      atomStorage().computeNAtomTotal(comm);
+      if (domain().isMaster()) {
+         nAtom_ = atomStorage().nAtomTotal();
+         file_.Write_at(0, &nAtom_, sizeof(int), MPI::BYTE);
+      }
+      comm.Bcast(&nAtom_, 1, MPI::INT, 0);
+      offset_ = sizeof(int);
+   }
+
+   /*
+   * Write one frame.
+   */
+   void
+   DdMdParallelTrajectoryWriter::writeFrame(std::ofstream &file, long iStep)
+   {
+      UTIL_CHECK(isOpen_);
+      MPI::Intracomm& comm = domain().communicator();
+
+      // Pack and sort records for local atoms
+      Vector r;
+      int i, j;
+      bool isCartesian = atomStorage().isCartesian();
+      int nLocal = atomStorage().nAtom();
+      localRecords_.resize(nLocal);
+      AtomIterator atomIter;
+      atomStorage().begin(atomIter);
+      for (i = 0; atomIter.notEnd(); ++atomIter, ++i) {
+         Record& record = localRecords_[i];
+         if (atomIter->id() < 0 || atomIter->id() >= nAtom_) {
+            UTIL_THROW("Atom ids must be 0,...,nAtom-1");
+         }
+         record.id = atomIter->id();
+         if (isCartesian) {
+            boundary().transformCartToGen(atomIter->position(), r);
+         } else {
+            r = atomIter->position();
+         }
+         for (j = 0; j < Dimension; ++j) {
+            if (r[j] >= 1.0) r[j] -= 1.0;
+            if (r[j] <  0.0) r[j] += 1.0;
+            record.ir[j] = floor( UINT_MAX*r[j] + r[j] + 0.5 );
+         }
+      }
+      std::sort(localRecords_.cArray(), localRecords_.cArray() + nLocal,
+                IdLess());
+
+      ids_.resize(nLocal);
+      for (i = 0; i < nLocal; ++i) {
+         ids_[i] = localRecords_[i].id;
+      }
+
+      // Check total number of atoms
+      long long localCount = nLocal;
+      long long total = 0;
+      comm.Allreduce(&localCount, &total, 1, MPI::LONG_LONG, MPI::SUM);
+      if (total != (long long)nAtom_) {
+         UTIL_THROW("Number of atoms has changed since header was written");
+      }
+
+      // Step index and boundary, written by the master. The boundary
+      // is identical on all processors, so all can compute its size.
+      int headerSize = memorySize(iStep) + memorySize(boundary());
+      if (domain().isMaster()) {
+         MemoryOArchive ar;
+         ar.allocate(headerSize);
+         ar << iStep;
+         ar << boundary();
+         file_.Write_at(offset_, ar.begin(), headerSize, MPI::BYTE);
+      }
+
+      // Write all records collectively, with record i of the frame
+      // for the atom with id i. The file view of each processor selects
+      // the records of its own atoms.
+      MPI::Datatype fileType;
+      if (nLocal > 0) {
+         fileType = recordType_.Create_indexed_block(nLocal, 1,
+                                                     ids_.cArray());
+      } else {
+         fileType = recordType_.Dup();
+      }
+      fileType.Commit();
+      MPI::Offset begin = offset_ + headerSize;
+      file_.Set_view(begin, recordType_, fileType, "native", MPI::INFO_NULL);
+      file_.Write_all(localRecords_.cArray(), nLocal, recordType_);
+      file_.Set_view(0, MPI::BYTE, MPI::BYTE, "native", MPI::INFO_NULL);
+      fileType.Free();
+
+      const MPI::Offset size = sizeof(Record);
+      offset_ += headerSize + size*nAtom_;
+   }
+
+   /*
+   * Close the file.
+   */
+   void DdMdParallelTrajectoryWriter::clear()
+   {
+      if (isOpen_) {
+         file_.Close();
+         isOpen_ = false;
+      }
+      TrajectoryWriter::clear();
+   }
+
+}
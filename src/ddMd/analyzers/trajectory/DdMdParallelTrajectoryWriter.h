@@ -0,0 +1,125 @@
+#ifndef DDMD_DDMD_PARALLEL_TRAJECTORY_WRITER_H
+#define DDMD_DDMD_PARALLEL_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/trajectory/TrajectoryWriter.h>   // base class
+#include <util/containers/GArray.h>                       // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * Native binary trajectory format, written collectively with MPI-IO.
+   *
+   * This class writes files in exactly the same format as the
+   * DdMdTrajectoryWriter, and may be read by the same readers, but
+   * does not pass atoms through the master processor. Each processor
+   * packs a compressed record (atom id and three integer generalized
+   * coordinates) for each of its local atoms, sorted by atom id. The
+   * master writes the step index and boundary of each frame, and all
+   * processors then write their records with a single collective
+   * MPI::File::Write_all, through a file view that places the record
+   * of the atom with id i at record i of the frame. Atoms are thus in
+   * order of id within each frame, and atom ids must be 0,...,nAtom-1.
+   * File offsets are of type MPI::Offset (64 bit), so frames may exceed
+   * 2 GB.
+   *
+   * The file name is outputFileName with the FileMaster output prefix
+   * prepended, as for other trajectory writers.
+   *
+   * \ingroup DdMd_Analyzer_Trajectory_Module
+   */
+   class DdMdParallelTrajectoryWriter : public TrajectoryWriter
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object
+      */
+      DdMdParallelTrajectoryWriter(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~DdMdParallelTrajectoryWriter();
+
+      /**
+      * Open the trajectory file collectively and write the header.
+      */
+      virtual void setup();
+
+      /**
+      * Close the trajectory file.
+      */
+      virtual void clear();
+
+      /**
+      * Write a single frame.
+      *
+      * Must be called on all processors. The stream argument is unused,
+      * since the frame is written through the MPI file.
+      *
+      * \param file output file stream (unused)
+      * \param iStep MD time step index
+      */
+      void writeFrame(std::ofstream &file, long iStep);
+
+   private:
+
+      /**
+      * Compressed atom record, with the layout used in the file.
+      */
+      struct Record
+      {
+         int id;
+         unsigned int ir[Dimension];
+      };
+
+      /**
+      * Ordering of records by atom id.
+      */
+      struct IdLess
+      {
+         bool operator () (const Record& a, const Record& b) const
+         {  return (a.id < b.id); }
+      };
+
+      /// Records for local atoms on this processor.
+      GArray<Record> localRecords_;
+
+      /// Ids of local atoms, in the same order as localRecords_.
+      GArray<int> ids_;
+
+      /// Trajectory file, opened on all processors.
+      MPI::File file_;
+
+      /// MPI datatype for one Record.
+      MPI::Datatype recordType_;
+
+      /// Offset of the end of the file, in bytes.
+      MPI::Offset offset_;
+
+      /// Number of atoms in the file.
+      int nAtom_;
+
+      /// Is file_ open?
+      bool isOpen_;
+
+      /// Has recordType_ been committed?
+      bool hasRecordType_;
+
+   };
+
+}
+#endif
@@ -85,4 +85,30 @@ namespace DdMd
 
    }
 
+   /*
+   * Write a frame from a staging buffer (master only).
+   */
+   void DdMdTrajectoryWriter::encodeFrame(std::ofstream &file, 
+                                          TrajectoryFrame& frame)
+   {
+      BinaryFileOArchive ar(file);
+      ar << frame.iStep;
+      ar << frame.boundary;
+
+      Vector r;
+      int i, j;
+      unsigned int ir;
+      int n = frame.size();
+      for (i = 0; i < n; ++i) {
+         ar << frame.ids[i];
+         r = frame.positions[i];
+         for (j = 0; j < Dimension; ++j) {
+            if (r[j] >= 1.0) r[j] -= 1.0;
+            if (r[j] <  0.0) r[j] += 1.0;
+            ir = floor( UINT_MAX*r[j] + r[j] + 0.5 );
+            ar << ir;
+         }
+      }
+   }
+
 }
@@ -0,0 +1,198 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "FrameWriterThread.h"
+#include "TrajectoryWriter.h"
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   FrameWriterThread::FrameWriterThread(TrajectoryWriter& writer)
+    : frames_(),
+      writerPtr_(&writer),
+      filePtr_(0),
+      head_(0),
+      size_(0),
+      capacity_(0),
+      isStopping_(false),
+      isRunning_(false),
+      hasError_(false)
+   {
+      pthread_mutex_init(&mutex_, 0);
+      pthread_cond_init(&notEmpty_, 0);
+      pthread_cond_init(&notFull_, 0);
+   }
+
+   /*
+   * Destructor.
+   */
+   FrameWriterThread::~FrameWriterThread()
+   {
+      if (isRunning_) {
+         pthread_mutex_lock(&mutex_);
+         isStopping_ = true;
+         pthread_cond_signal(&notEmpty_);
+         pthread_mutex_unlock(&mutex_);
+         pthread_join(thread_, 0);
+         isRunning_ = false;
+      }
+      pthread_cond_destroy(&notFull_);
+      pthread_cond_destroy(&notEmpty_);
+      pthread_mutex_destroy(&mutex_);
+   }
+
+   /*
+   * Allocate frames and start the I/O thread.
+   */
+   void FrameWriterThread::start(std::ofstream& file, int capacity)
+   {
+      UTIL_CHECK(!isRunning_);
+      UTIL_CHECK(capacity > 0);
+      if (!frames_.isAllocated()) {
+         frames_.allocate(capacity);
+      }
+      UTIL_CHECK(frames_.capacity() == capacity);
+      filePtr_ = &file;
+      capacity_ = capacity;
+      head_ = 0;
+      size_ = 0;
+      isStopping_ = false;
+      hasError_ = false;
+      if (pthread_create(&thread_, 0, &FrameWriterThread::run, this)) {
+         UTIL_THROW("Failed to create trajectory output thread");
+      }
+      isRunning_ = true;
+   }
+
+   /*
+   * Return the next free frame, waiting while the queue is full.
+   *
+   * The free slot follows the last queued frame, and so is never the
+   * frame being written by the I/O thread. Returns 0 after an error.
+   */
+   TrajectoryFrame* FrameWriterThread::beginFrame()
+   {
+      UTIL_CHECK(isRunning_);
+      pthread_mutex_lock(&mutex_);
+      while (size_ == capacity_ && !hasError_) {
+         pthread_cond_wait(&notFull_, &mutex_);
+      }
+      TrajectoryFrame* framePtr = 0;
+      if (!hasError_) {
+         framePtr = &frames_[(head_ + size_) % capacity_];
+      }
+      pthread_mutex_unlock(&mutex_);
+      return framePtr;
+   }
+
+   /*
+   * Publish the frame returned by beginFrame().
+   */
+   void FrameWriterThread::endFrame()
+   {
+      pthread_mutex_lock(&mutex_);
+      ++size_;
+      pthread_cond_signal(&notEmpty_);
+      pthread_mutex_unlock(&mutex_);
+   }
+
+   /*
+   * Wait until all queued frames have been written.
+   */
+   void FrameWriterThread::flush()
+   {
+      if (!isRunning_) return;
+      pthread_mutex_lock(&mutex_);
+      while (size_ > 0 && !hasError_) {
+         pthread_cond_wait(&notFull_, &mutex_);
+      }
+      checkError();
+      pthread_mutex_unlock(&mutex_);
+      filePtr_->flush();
+   }
+
+   /*
+   * Write all queued frames, stop and join the thread.
+   */
+   void FrameWriterThread::stop()
+   {
+      if (!isRunning_) return;
+      pthread_mutex_lock(&mutex_);
+      isStopping_ = true;
+      pthread_cond_signal(&notEmpty_);
+      pthread_mutex_unlock(&mutex_);
+      pthread_join(thread_, 0);
+      isRunning_ = false;
+      filePtr_->flush();
+      if (hasError_) {
+         UTIL_THROW("Error writing frame in trajectory output thread");
+      }
+   }
+
+   /*
+   * Thread entry point.
+   */
+   void* FrameWriterThread::run(void* arg)
+   {
+      static_cast<FrameWriterThread*>(arg)->writeFrames();
+      return 0;
+   }
+
+   /*
+   * Main loop of the I/O thread: write frames until stopped and empty.
+   *
+   * The frame at the head remains in the queue while it is encoded, so
+   * that the main thread cannot reuse its buffer.
+   */
+   void FrameWriterThread::writeFrames()
+   {
+      pthread_mutex_lock(&mutex_);
+      for (;;) {
+         while (size_ == 0 && !isStopping_) {
+            pthread_cond_wait(&notEmpty_, &mutex_);
+         }
+         if (size_ == 0) break;
+         TrajectoryFrame& frame = frames_[head_];
+         bool skip = hasError_;
+         pthread_mutex_unlock(&mutex_);
+
+         if (!skip) {
+            try {
+               writerPtr_->encodeFrame(*filePtr_, frame);
+            } catch (...) {
+               pthread_mutex_lock(&mutex_);
+               hasError_ = true;
+               pthread_mutex_unlock(&mutex_);
+            }
+         }
+
+         pthread_mutex_lock(&mutex_);
+         head_ = (head_ + 1) % capacity_;
+         --size_;
+         pthread_cond_signal(&notFull_);
+      }
+      pthread_mutex_unlock(&mutex_);
+   }
+
+   /*
+   * Throw if the I/O thread failed (call with mutex locked).
+   */
+   void FrameWriterThread::checkError()
+   {
+      if (hasError_) {
+         pthread_mutex_unlock(&mutex_);
+         UTIL_THROW("Error writing frame in trajectory output thread");
+      }
+   }
+
+}
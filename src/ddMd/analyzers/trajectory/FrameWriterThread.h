@@ -0,0 +1,160 @@
+#ifndef DDMD_FRAME_WRITER_THREAD_H
+#define DDMD_FRAME_WRITER_THREAD_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/trajectory/TrajectoryFrame.h>   // member
+#include <util/containers/DArray.h>                      // member
+
+#include <fstream>
+#include <pthread.h>
+
+namespace DdMd
+{
+
+   class TrajectoryWriter;
+
+   using namespace Util;
+
+   /**
+   * Background thread that encodes and writes trajectory frames.
+   *
+   * A FrameWriterThread owns a bounded circular queue of TrajectoryFrame
+   * staging buffers and a POSIX thread that removes frames from the
+   * front of the queue and passes them to TrajectoryWriter::encodeFrame().
+   * The main thread obtains an empty frame from beginFrame(), fills it,
+   * and publishes it with endFrame(). If all buffers are full, beginFrame()
+   * blocks until the I/O thread has written the oldest frame, so that
+   * the simulation can never run more than capacity frames ahead of the
+   * file. With capacity 2, output is double-buffered.
+   *
+   * beginFrame() does not throw if the I/O thread failed, but returns a
+   * null pointer, so that the caller can share the error state with
+   * other processors before any collective communication.
+   *
+   * Used only on the master processor. Requires DDMD_ASYNC_IO.
+   *
+   * \ingroup DdMd_Analyzer_Trajectory_Module
+   */
+   class FrameWriterThread
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param writer  TrajectoryWriter that encodes frames
+      */
+      FrameWriterThread(TrajectoryWriter& writer);
+
+      /**
+      * Destructor (stops the thread, if running).
+      */
+      ~FrameWriterThread();
+
+      /**
+      * Allocate frame buffers and start the I/O thread.
+      *
+      * \param file  open output file (used only by the I/O thread)
+      * \param capacity  maximum number of queued frames
+      */
+      void start(std::ofstream& file, int capacity);
+
+      /**
+      * Return the next empty frame, blocking while the queue is full.
+      *
+      * \return pointer to an empty frame, or 0 if a frame write failed
+      */
+      TrajectoryFrame* beginFrame();
+
+      /**
+      * Add the frame returned by beginFrame() to the queue.
+      */
+      void endFrame();
+
+      /**
+      * Block until all queued frames have been written.
+      */
+      void flush();
+
+      /**
+      * Write all queued frames, then stop and join the I/O thread.
+      */
+      void stop();
+
+      /**
+      * Is the I/O thread running?
+      */
+      bool isRunning() const;
+
+   private:
+
+      /// Circular array of frame buffers.
+      DArray<TrajectoryFrame> frames_;
+
+      /// Thread that encodes and writes frames.
+      pthread_t thread_;
+
+      /// Mutex that protects queue indices and flags.
+      pthread_mutex_t mutex_;
+
+      /// Signalled when a frame is added, or when stopping.
+      pthread_cond_t notEmpty_;
+
+      /// Signalled when a frame has been written.
+      pthread_cond_t notFull_;
+
+      /// Pointer to writer that encodes frames.
+      TrajectoryWriter* writerPtr_;
+
+      /// Pointer to output file.
+      std::ofstream* filePtr_;
+
+      /// Index of oldest queued frame.
+      int head_;
+
+      /// Number of queued frames, including one being written.
+      int size_;
+
+      /// Maximum number of queued frames.
+      int capacity_;
+
+      /// Has stop() been requested?
+      bool isStopping_;
+
+      /// Is the thread running?
+      bool isRunning_;
+
+      /// Did encoding a frame fail?
+      bool hasError_;
+
+      /*
+      * Thread entry point (arg is a pointer to this object).
+      */
+      static void* run(void* arg);
+
+      /*
+      * Main loop of the I/O thread.
+      */
+      void writeFrames();
+
+      /*
+      * Throw if a frame could not be written (call with mutex locked).
+      */
+      void checkError();
+
+   };
+
+   // Inline method
+
+   inline bool FrameWriterThread::isRunning() const
+   {  return isRunning_; }
+
+}
+#endif
@@ -78,7 +78,7 @@ namespace DdMd
             file << typeId + 1 << " ";
             file << molId << " ";
             for (int i=0; i < Util::Dimension; ++i) {
-               file << Dbl(atomPtr->position()[i], 13) << " ";
+               file << Dbl(r[i], 13) << " ";
             }
             for (int i=0; i < Util::Dimension; ++i) {
                file << shift << " ";
@@ -93,4 +93,42 @@ namespace DdMd
 
    }
 
+   /*
+   * Write a frame from a staging buffer (master only).
+   */
+   void LammpsDumpWriter::encodeFrame(std::ofstream &file, 
+                                      TrajectoryFrame& frame)
+   {
+      int n = frame.size();
+      file << "ITEM: TIMESTEP" << "\n";
+      file << frame.iStep << "\n";
+
+      file << "ITEM: NUMBER OF ATOMS" << "\n";
+      file << n << "\n";
+
+      file << "ITEM: BOX BOUNDS pp pp pp" << "\n";
+      Vector lengths = frame.boundary.lengths();
+      file << Dbl(0.0) << Dbl(lengths[0]) << "\n";
+      file << Dbl(0.0) << Dbl(lengths[1]) << "\n";
+      file << Dbl(0.0) << Dbl(lengths[2]) << "\n";
+
+      Vector r;
+      int shift = 0;
+      int molId = 1;
+      file << "ITEM: ATOMS id type mol x y z" << "\n";
+      for (int j = 0; j < n; ++j) {
+         frame.boundary.transformGenToCart(frame.positions[j], r);
+         file << frame.ids[j] + 1 << " ";
+         file << frame.typeIds[j] + 1 << " ";
+         file << molId << " ";
+         for (int i=0; i < Util::Dimension; ++i) {
+            file << Dbl(r[i], 13) << " ";
+         }
+         for (int i=0; i < Util::Dimension; ++i) {
+            file << shift << " ";
+         }
+         file << "\n";
+      }
+   }
+
 }
@@ -45,6 +45,20 @@ namespace DdMd
       */
       void writeFrame(std::ofstream &file, long iStep);
 
+      /**
+      * Write a frame from a staging buffer.
+      *
+      * \param file output file stream
+      * \param frame staging copy of the frame
+      */
+      void encodeFrame(std::ofstream &file, TrajectoryFrame& frame);
+
+      /**
+      * Return true (encodeFrame is implemented).
+      */
+      bool hasEncodeFrame() const
+      {  return true; }
+
    private:
 
       /// Number of atoms in the file.
@@ -0,0 +1,93 @@
+#ifndef DDMD_TRAJECTORY_FRAME_H
+#define DDMD_TRAJECTORY_FRAME_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <simp/boundary/Boundary.h>          // member
+#include <util/containers/GArray.h>          // member
+#include <util/space/Vector.h>               // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Staging copy of one trajectory frame, collected on the master.
+   *
+   * A TrajectoryFrame holds a private copy of the boundary and of the
+   * id, type and generalized position of every atom at one time step.
+   * It is filled by TrajectoryWriter::collectFrame() in the main thread
+   * and encoded by TrajectoryWriter::encodeFrame(), possibly in a
+   * FrameWriterThread. Arrays keep their capacity when cleared, so that
+   * a frame may be reused without reallocation.
+   *
+   * \ingroup DdMd_Analyzer_Trajectory_Module
+   */
+   class TrajectoryFrame
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      TrajectoryFrame()
+       : iStep(0)
+      {}
+
+      /**
+      * Remove all atoms (retain capacity).
+      */
+      void clear()
+      {
+         ids.clear();
+         typeIds.clear();
+         positions.clear();
+      }
+
+      /**
+      * Add one atom.
+      *
+      * \param id  global atom id
+      * \param typeId  atom type index
+      * \param position  atom position, in generalized coordinates
+      */
+      void append(int id, int typeId, const Vector& position)
+      {
+         ids.append(id);
+         typeIds.append(typeId);
+         positions.append(position);
+      }
+
+      /**
+      * Number of atoms in this frame.
+      */
+      int size() const
+      {  return ids.size(); }
+
+      /// Boundary at the time of the frame.
+      Boundary boundary;
+
+      /// Atom ids.
+      GArray<int> ids;
+
+      /// Atom type ids.
+      GArray<int> typeIds;
+
+      /// Atom positions, in generalized coordinates.
+      GArray<Vector> positions;
+
+      /// MD time step index.
+      long iStep;
+
+   };
+
+}
+#endif
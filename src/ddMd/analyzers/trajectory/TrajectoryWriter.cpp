@@ -6,8 +6,14 @@
 */
 
 #include "TrajectoryWriter.h"
+#ifdef DDMD_ASYNC_IO
+#include "FrameWriterThread.h"
+#endif
 #include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/AtomCollector.h>
+#include <ddMd/chemistry/Atom.h>
 #include <util/mpi/MpiLoader.h>
+#include <util/mpi/MpiSendRecv.h>
 
 #include <fstream>
 #include <ios>
@@ -24,6 +30,8 @@ namespace DdMd
     : Analyzer(simulation),
       isInitialized_(false),
       isBinary_(isBinary),
+      nFrameBuffer_(0),
+      frameWriterPtr_(0),
       domainPtr_(0),
       boundaryPtr_(0),
       atomStoragePtr_(0)
@@ -54,12 +62,29 @@ namespace DdMd
    }
 
    /*
-   * Read interval and outputFileName.
+   * Destructor.
+   */
+   TrajectoryWriter::~TrajectoryWriter()
+   {
+      #ifdef DDMD_ASYNC_IO
+      if (frameWriterPtr_) {
+         delete frameWriterPtr_;
+      }
+      #endif
+   }
+
+   /*
+   * Read interval, outputFileName and optional nFrameBuffer.
    */
    void TrajectoryWriter::readParameters(std::istream& in)
    {
       readInterval(in);
       readOutputFileName(in);
+      nFrameBuffer_ = 0;
+      readOptional<int>(in, "nFrameBuffer", nFrameBuffer_);
+      if (nFrameBuffer_ < 0) {
+         UTIL_THROW("Negative nFrameBuffer");
+      }
       isInitialized_ = true;
    }
 
@@ -70,6 +95,9 @@ namespace DdMd
    {
       loadInterval(ar);
       loadOutputFileName(ar);
+      nFrameBuffer_ = 0;
+      bool isRequired = false;
+      loadParameter<int>(ar, "nFrameBuffer", nFrameBuffer_, isRequired);
       isInitialized_ = true;
    }
 
@@ -80,13 +108,25 @@ namespace DdMd
    {
       saveInterval(ar);
       saveOutputFileName(ar);
+      bool isActive = bool(nFrameBuffer_);
+      Parameter::saveOptional(ar, nFrameBuffer_, isActive);
    }
 
    /*
-   * Setup - open the trajectory file.
+   * Setup - open the trajectory file, start output thread if needed.
    */
    void TrajectoryWriter::setup()
    {  
+      if (nFrameBuffer_ > 0) {
+         #ifndef DDMD_ASYNC_IO
+         UTIL_THROW("nFrameBuffer > 0 requires DDMD_ASYNC_IO");
+         #endif
+         if (!hasEncodeFrame()) {
+            UTIL_THROW("nFrameBuffer > 0 not supported by this format");
+         }
+      }
+      stopFrameWriter();
+
       FileMaster& fileMaster = simulation().fileMaster();
       if (isIoProcessor()) {
          if (isBinary()) {
@@ -97,30 +137,124 @@ namespace DdMd
          }
       }
       writeHeader(outputFile_);
+
+      #ifdef DDMD_ASYNC_IO
+      if (nFrameBuffer_ > 0 && domain().isMaster()) {
+         frameWriterPtr_ = new FrameWriterThread(*this);
+         frameWriterPtr_->start(outputFile_, nFrameBuffer_);
+      }
+      #endif
    }
 
    /*
-   * Write a frame to file.
+   * Write a frame to file, or queue it for the output thread.
    */
    void TrajectoryWriter::sample(long iStep)
    {
       if (isAtInterval(iStep))  {
+         #ifdef DDMD_ASYNC_IO
+         if (nFrameBuffer_ > 0) {
+
+            // Check for an output thread error on the master before
+            // collecting atoms, so that all processors throw together.
+            TrajectoryFrame* framePtr = 0;
+            int hasError = 0;
+            if (domain().isMaster()) {
+               framePtr = frameWriterPtr_->beginFrame();
+               hasError = framePtr ? 0 : 1;
+            }
+            #ifdef UTIL_MPI
+            bcast<int>(domain().communicator(), hasError, 0);
+            #endif
+            if (hasError) {
+               UTIL_THROW("Error writing frame in trajectory output thread");
+            }
+
+            if (domain().isMaster()) {
+               collectFrame(*framePtr, iStep);
+               frameWriterPtr_->endFrame();
+            } else {
+               atomCollector().send();
+            }
+            return;
+         }
+         #endif
          writeFrame(outputFile_, iStep);
       }
    }
 
    /*
-   * Clear sample counter and close file.
+   * Collect all atoms into a staging frame on the master.
+   */
+   void TrajectoryWriter::collectFrame(TrajectoryFrame& frame, long iStep)
+   {
+      if (domain().isMaster()) {
+         frame.iStep = iStep;
+         frame.boundary = boundary();
+         frame.clear();
+
+         Vector r;
+         bool isCartesian = atomStorage().isCartesian();
+         atomCollector().setup();
+         Atom* atomPtr = atomCollector().nextPtr();
+         while (atomPtr) {
+            if (isCartesian) {
+               boundary().transformCartToGen(atomPtr->position(), r);
+            } else {
+               r = atomPtr->position();
+            }
+            frame.append(atomPtr->id(), atomPtr->typeId(), r);
+            atomPtr = atomCollector().nextPtr();
+         }
+      } else {
+         atomCollector().send();
+      }
+   }
+
+   /*
+   * Default implementation of encodeFrame (throws).
+   */
+   void TrajectoryWriter::encodeFrame(std::ofstream& out,
+                                      TrajectoryFrame& frame)
+   {  UTIL_THROW("encodeFrame is not implemented by this class"); }
+
+   /*
+   * Write queued frames, stop and destroy output thread (if any).
+   *
+   * The thread object is destroyed even if stop() throws to report an
+   * error in the output thread, and the exception is then rethrown.
+   */
+   void TrajectoryWriter::stopFrameWriter()
+   {
+      #ifdef DDMD_ASYNC_IO
+      if (frameWriterPtr_) {
+         FrameWriterThread* ptr = frameWriterPtr_;
+         frameWriterPtr_ = 0;
+         try {
+            ptr->stop();
+         } catch (...) {
+            delete ptr;
+            throw;
+         }
+         delete ptr;
+      }
+      #endif
+   }
+
+   /*
+   * Write queued frames and footer, and close file.
    */
    void TrajectoryWriter::clear()
    {
+      stopFrameWriter();
       if (outputFile_.is_open()) {
+         writeFooter(outputFile_);
          outputFile_.close();
       }
    }
 
    /*
-   * Clear sample counter and close output file.
+   * Write queued frames and close output file.
    */
    void TrajectoryWriter::output()
    {  clear(); }
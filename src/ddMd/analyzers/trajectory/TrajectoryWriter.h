@@ -20,6 +20,7 @@
 #include <ddMd/storage/DihedralStorage.h>               
 #endif
 #include <simp/boundary/Boundary.h>         // typedef
+#include <ddMd/analyzers/trajectory/TrajectoryFrame.h>   // argument
 
 namespace DdMd
 {
@@ -27,6 +28,7 @@ namespace DdMd
    class Simulation;
    class Domain;
    class AtomCollector;
+   class FrameWriterThread;
    template <int N> class GroupCollector;
 
    using namespace Util;
@@ -35,6 +37,24 @@ namespace DdMd
    /**
    * Base class to write a trajectory to a single file.
    *
+   * Frames are normally written by writeFrame(), which blocks the
+   * integration loop until the frame has been written. Subclasses that
+   * also implement encodeFrame() support an asynchronous mode, which is
+   * enabled by giving the optional parameter nFrameBuffer a positive
+   * value in a program compiled with DDMD_ASYNC_IO. In this mode, each
+   * frame is collected into a TrajectoryFrame staging buffer on the
+   * master, and is encoded and written by a FrameWriterThread while the
+   * simulation continues. At most nFrameBuffer frames may be queued;
+   * when all buffers are full, the next frame waits for the oldest
+   * one to be written.
+   *
+   * Parameter file format:
+   * \code
+   *    interval        int
+   *    outputFileName  string
+   *    nFrameBuffer*   int  (0 by default, synchronous output)
+   * \endcode
+   *
    * \ingroup DdMd_Analyzer_Trajectory_Module
    */
    class TrajectoryWriter : public Analyzer
@@ -53,8 +73,7 @@ namespace DdMd
       /**
       * Destructor.
       */
-      virtual ~TrajectoryWriter()
-      {} 
+      virtual ~TrajectoryWriter();
    
       /**
       * Read parameters and initialize.
@@ -90,12 +109,12 @@ namespace DdMd
       virtual void sample(long iStep);
 
       /**
-      * Clear nSample counter.
+      * Write any queued frames and close the output file.
       */
       virtual void clear();
   
       /**
-      * Close ouput file.
+      * Write any queued frames and close the output file.
       */
       virtual void output();
 
@@ -106,6 +125,11 @@ namespace DdMd
       */
       bool isBinary() const;
 
+      /**
+      * Get the maximum number of queued frames (0 if synchronous).
+      */
+      int nFrameBuffer() const;
+
       /**
       * Write data that should appear once, at beginning of the file. 
       *
@@ -124,6 +148,51 @@ namespace DdMd
       */
       virtual void writeFrame(std::ofstream& out, long iStep) = 0;
 
+      /**
+      * Write data that should appear once, at the end of the file.
+      *
+      * Called by clear() on the I/O processor, after all queued frames
+      * have been written and before the file is closed. Default 
+      * implementation is empty.
+      *
+      * \param out output file stream
+      */
+      virtual void writeFooter(std::ofstream& out)
+      {};
+
+      /**
+      * Does this class implement encodeFrame()?
+      *
+      * Asynchronous output (nFrameBuffer > 0) is allowed only if this
+      * function returns true. Default implementation returns false.
+      */
+      virtual bool hasEncodeFrame() const
+      {  return false; }
+
+      /**
+      * Write a frame from a staging buffer collected by collectFrame().
+      *
+      * Called only on the master processor, and possibly from a separate
+      * I/O thread, so implementations may use only the frame and file
+      * arguments, and may not access the Simulation or communicate.
+      * Default implementation throws an Exception.
+      *
+      * \param out output file stream
+      * \param frame staging copy of the frame
+      */
+      virtual void encodeFrame(std::ofstream& out, TrajectoryFrame& frame);
+
+      /**
+      * Collect all atoms into a staging buffer on the master processor.
+      *
+      * Call on all processors. Positions are stored in generalized
+      * coordinates. The frame argument is used only on the master.
+      *
+      * \param frame staging buffer (output, on master)
+      * \param iStep MD time step index
+      */
+      void collectFrame(TrajectoryFrame& frame, long iStep);
+
       /**
       * Get the Domain by reference.
       */
@@ -191,6 +260,12 @@ namespace DdMd
       /// Is the trajectory file a binary file? 
       bool isBinary_;
 
+      /// Maximum number of queued frames (0 for synchronous output).
+      int nFrameBuffer_;
+
+      /// Pointer to output thread (master only, if nFrameBuffer_ > 0).
+      FrameWriterThread* frameWriterPtr_;
+
       // Pointers to associated Domain.
       Domain* domainPtr_;
 
@@ -209,6 +284,15 @@ namespace DdMd
       DihedralStorage* dihedralStoragePtr_;
       #endif
 
+      /*
+      * Write queued frames, stop and destroy the output thread.
+      */
+      void stopFrameWriter();
+
+   // friends:
+
+      friend class FrameWriterThread;
+
    };
 
    // Inline method definitions
@@ -219,6 +303,12 @@ namespace DdMd
    inline bool TrajectoryWriter::isBinary() const
    {  return isBinary_; }
 
+   /**
+   * Get the maximum number of queued frames.
+   */
+   inline int TrajectoryWriter::nFrameBuffer() const
+   {  return nFrameBuffer_; }
+
    inline Domain& TrajectoryWriter::domain()
    {  return *domainPtr_; }
 
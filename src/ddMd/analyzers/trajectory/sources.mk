@@ -2,9 +2,16 @@ ddMd_analyzers_trajectory_=\
      ddMd/analyzers/trajectory/ConfigWriter.cpp\
      ddMd/analyzers/trajectory/TrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/DdMdTrajectoryWriter.cpp\
+     ddMd/analyzers/trajectory/DdMdParallelTrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/DdMdGroupTrajectoryWriter.cpp\
+     ddMd/analyzers/trajectory/CompressedTrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/LammpsDumpWriter.cpp
 
+ifdef DDMD_ASYNC_IO
+ddMd_analyzers_trajectory_+=\
+     ddMd/analyzers/trajectory/FrameWriterThread.cpp
+endif
+
 ddMd_analyzers_trajectory_SRCS=\
      $(addprefix $(SRC_DIR)/, $(ddMd_analyzers_trajectory_))
 ddMd_analyzers_trajectory_OBJS=\
@@ -254,6 +254,26 @@ namespace DdMd
       force() += f;
       buffer.decrementRecvSize();
    }
+
+   // Ghost Velocity Updates
+
+   /*
+   * Pack ghost velocity.
+   */
+   void Atom::packVelocity(Buffer& buffer)
+   {
+      buffer.pack<Vector>(velocity());
+      buffer.incrementSendSize();
+   }
+
+   /*
+   * Unpack ghost velocity.
+   */
+   void Atom::unpackVelocity(Buffer& buffer)
+   {
+      buffer.unpack<Vector>(velocity());
+      buffer.decrementRecvSize();
+   }
    #endif // ifdef UTIL_MPI
 
    /*
@@ -210,6 +210,14 @@ namespace DdMd
       */
       bool isGhost() const;
 
+      /**
+      * Get index of this atom within its parent AtomArray.
+      *
+      * Local atoms and ghosts are stored in different AtomArrays, so
+      * a local atom and a ghost may have the same arrayIndex.
+      */
+      int arrayIndex() const;
+
       /**
       * Get the position Vector (const reference).
       */
@@ -335,6 +343,24 @@ namespace DdMd
       */
       void unpackForce(Buffer& buffer);
 
+      /**
+      * Pack ghost velocity into send buffer.
+      *
+      * Packs velocity Vector, increments buffer sendSize counter.
+      *
+      * \param buffer communication buffer
+      */
+      void packVelocity(Buffer& buffer);
+
+      /**
+      * Unpack ghost velocity from recv buffer.
+      *
+      * Unpacks velocity Vector, decrements buffer recvSize counter.
+      *
+      * \param buffer communication buffer
+      */
+      void unpackVelocity(Buffer& buffer);
+
       #endif // ifdef UTIL_MPI
 
       /**
@@ -462,6 +488,12 @@ namespace DdMd
       return bool(localId_ & 1);
    }
 
+   /*
+   * Get index of this atom within its parent AtomArray.
+   */
+   inline int Atom::arrayIndex() const
+   {  return int(localId_ >> 1); }
+
    /*
    * Get position by reference.
    */
@@ -10,6 +10,7 @@
 #include <util/misc/Memory.h>
 
 #include <stdlib.h>
+#include <new>
 
 namespace DdMd
 {
@@ -23,6 +24,7 @@ namespace DdMd
    */
    AtomArray::AtomArray() 
     : Array<Atom>(),
+      memory_(0),
       velocities_(0),
       masks_(0),
       plans_(0),
@@ -37,7 +39,9 @@ namespace DdMd
    AtomArray::~AtomArray()
    {
       if (data_) {
-         Memory::deallocate<Atom>(data_, capacity_);
+         // Atom has a trivial destructor, so just release the block
+         Memory::deallocate<char>(memory_, memorySize(capacity_));
+         data_ = 0;
          Memory::deallocate<Vector>(velocities_, capacity_);
          Memory::deallocate<Mask>(masks_, capacity_);
          Memory::deallocate<Plan>(plans_, capacity_);
@@ -67,9 +71,19 @@ namespace DdMd
          Log::file() << "Size of Atom* = " << sizeof(Atom*) << std::endl;
       }
 
-      // Allocate memory
-      //posix_memalign((void**) &data_, 64, capacity*sizeof(Atom));
-      Memory::allocate<Atom>(data_, capacity);
+      // Allocate memory for Atom objects, aligned to a cache line
+      Memory::allocate<char>(memory_, memorySize(capacity));
+      char* ptr = memory_;
+      size_t offset = ((size_t) ptr) % AtomAlignment;
+      if (offset) {
+         ptr += AtomAlignment - offset;
+      }
+      data_ = (Atom*) ptr;
+      for (int i = 0; i < capacity; ++i) {
+         new(data_ + i) Atom();
+      }
+
+      // Allocate memory for pseudo-member arrays
       Memory::allocate<Vector>(velocities_, capacity);
       Memory::allocate<Mask>(masks_, capacity);
       Memory::allocate<Plan>(plans_, capacity);
@@ -107,6 +121,12 @@ namespace DdMd
       }
    }
 
+   /*
+   * Number of bytes allocated for a block of capacity Atom objects.
+   */
+   size_t AtomArray::memorySize(int capacity)
+   {  return ((size_t) capacity)*sizeof(Atom) + AtomAlignment; }
+
    /*
    * Return true if this is already allocated, false otherwise.
    */
@@ -10,6 +10,7 @@
 
 #include <util/containers/Array.h>   // base class template
 #include "AtomContext.h"             // context structure.
+#include <cstddef>                   // size_t
 
 namespace Util {
    class Vector;
@@ -36,6 +37,12 @@ namespace DdMd
    * each Atom in separate arrays. The interface of an Atom hides this, 
    * allowing pseudo-members to be accessed as if they were true class
    * members. See file Atom.h for further implementation details.
+   *
+   * The Atom objects themselves are allocated in a block that is 
+   * aligned to a 64 byte boundary. Because sizeof(Atom) is 64 bytes
+   * on 64 bit machines, the position, force, type id and ghost flag 
+   * of each Atom then occupy exactly one cache line, so that force 
+   * and integration loops never load a line that straddles two atoms.
    */
    class AtomArray : public Array<Atom>
    { 
@@ -73,9 +80,19 @@ namespace DdMd
   
    private:
  
+      /**
+      * Alignment of the array of Atom objects, in bytes.
+      */
+      static const int AtomAlignment = 64;
+
       using Array<Atom>::data_;
       using Array<Atom>::capacity_;
 
+      /**
+      * Start of raw memory block that contains the aligned data_ array.
+      */
+      char* memory_;
+
       /*
       * The following C-arrays store data for Atom "psuedo-members".
       * Data associated with the Atom in element i of the main data_
@@ -112,6 +129,13 @@ namespace DdMd
       */
       AtomContext* contexts_;
 
+      /**
+      * Size of raw memory block for an array of Atom objects, in bytes.
+      *
+      * \param capacity number of Atom objects
+      */
+      static size_t memorySize(int capacity);
+
       /**
       * Copy ctor (prohibited - private and not implemented).
       */
@@ -20,6 +20,10 @@ namespace DdMd
     : mass_(1.0),
       name_(),
       id_(-1) 
+      #ifdef SIMP_COULOMB
+      , charge_(0.0)
+      , hasCharge_(false)
+      #endif
    {}
 
    /*
@@ -28,6 +32,23 @@ namespace DdMd
    void AtomType::setId(int id)
    {  id_ = id; }
 
+   #ifdef SIMP_COULOMB
+   /*
+   * Set the hasCharge property.
+   */
+   void AtomType::setHasCharge(bool hasCharge)
+   {  hasCharge_ = hasCharge; }
+
+   /*
+   * Set the electrical charge.
+   */
+   void AtomType::setCharge(double charge)
+   {
+      UTIL_CHECK(hasCharge_);
+      charge_ = charge;
+   }
+   #endif
+
    /* 
    * Input a AtomType from an istream, without line breaks.
    */
@@ -35,6 +56,11 @@ namespace DdMd
    {
       in >> atomType.name_;
       in >> atomType.mass_;
+      #ifdef SIMP_COULOMB
+      if (atomType.hasCharge_) {
+         in >> atomType.charge_;
+      }
+      #endif
       return in;
    }
    
@@ -49,6 +75,12 @@ namespace DdMd
       out.width(Parameter::Width);
       out.precision(Parameter::Precision);
       out << atomType.mass_;
+      #ifdef SIMP_COULOMB
+      if (atomType.hasCharge_) {
+         out.width(Parameter::Width);
+         out << atomType.charge_;
+      }
+      #endif
       return out;
    }
 
@@ -76,6 +108,14 @@ namespace Util
       double      mass = data.mass();
       send<std::string>(comm, name, dest, tag);
       send<double>(comm, mass, dest, tag);
+      #ifdef SIMP_COULOMB
+      bool hasCharge = data.hasCharge();
+      send<bool>(comm, hasCharge, dest, tag);
+      if (hasCharge) {
+         double charge = data.charge();
+         send<double>(comm, charge, dest, tag);
+      }
+      #endif
    }
 
    template <>
@@ -87,6 +127,16 @@ namespace Util
       recv<double>(comm, mass, source, tag);
       data.setName(name);
       data.setMass(mass);
+      #ifdef SIMP_COULOMB
+      bool hasCharge;
+      recv<bool>(comm, hasCharge, source, tag);
+      data.setHasCharge(hasCharge);
+      if (hasCharge) {
+         double charge;
+         recv<double>(comm, charge, source, tag);
+         data.setCharge(charge);
+      }
+      #endif
    }
 
    template <>
@@ -94,16 +144,38 @@ namespace Util
    {
       std::string name;
       double      mass; 
+      #ifdef SIMP_COULOMB
+      double      charge = 0.0;
+      bool        hasCharge = false;
+      #endif
       int         rank = comm.Get_rank();
       if (rank == root) {
          name = data.name();
          mass = data.mass();
+         #ifdef SIMP_COULOMB
+         hasCharge = data.hasCharge();
+         if (hasCharge) {
+            charge = data.charge();
+         }
+         #endif
       }
       bcast<std::string>(comm, name, root);
       bcast<double>(comm, mass, root);
+      #ifdef SIMP_COULOMB
+      bcast<bool>(comm, hasCharge, root);
+      if (hasCharge) {
+         bcast<double>(comm, charge, root);
+      }
+      #endif
       if (rank != root) {
          data.setName(name);
          data.setMass(mass);
+         #ifdef SIMP_COULOMB
+         data.setHasCharge(hasCharge);
+         if (hasCharge) {
+            data.setCharge(charge);
+         }
+         #endif
       }
    }
 
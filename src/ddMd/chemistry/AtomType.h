@@ -18,8 +18,9 @@ namespace DdMd
    /**
    * Descriptor for a type of Atom.
    *
-   * An AtomTypeType has a mass, a name string, and an integer id.
-   * [It will later acquire a charge.]
+   * An AtomType has a mass, a name string, and an integer id.
+   * If coulomb interactions are enabled (ifdef SIMP_COULOMB), it
+   * may also have an electrical charge.
    *
    * \ingroup DdMd_Chemistry_Module
    */
@@ -57,6 +58,30 @@ namespace DdMd
       */
       void setName(std::string name);
 
+      #ifdef SIMP_COULOMB
+      /**
+      * Set the boolean "hasCharge" property.
+      *
+      * A charge value appears in the text representation of an
+      * AtomType, as read by the >> and written by the << operators,
+      * if and only if hasCharge is true. It should be set true for
+      * all atom types (even neutral ones) in a system with Coulomb
+      * interactions, and false otherwise.
+      *
+      * \param hasCharge true if this system has Coulomb interactions.
+      */
+      void setHasCharge(bool hasCharge);
+
+      /**
+      * Set the charge value.
+      *
+      * \pre The hasCharge property must have been set true.
+      *
+      * \param charge atom electrical charge
+      */
+      void setCharge(double charge);
+      #endif
+
       //@}
       /// \name Accessors
       //@{
@@ -70,6 +95,14 @@ namespace DdMd
       /// Get the index.
       int id() const;
 
+      #ifdef SIMP_COULOMB
+      /// Does this type have a charge value?
+      bool hasCharge() const;
+
+      /// Get the electrical charge value.
+      double charge() const;
+      #endif
+
       //@}
 
       #ifdef UTIL_MPI
@@ -90,6 +123,14 @@ namespace DdMd
       /// Integer index.
       int          id_;
 
+      #ifdef SIMP_COULOMB
+      /// Electrical charge.
+      double       charge_;
+
+      /// Does this type have a charge value?
+      bool         hasCharge_;
+      #endif
+
    //friends:
 
       friend std::istream& operator>>(std::istream& in, AtomType &atomType);
@@ -122,6 +163,19 @@ namespace DdMd
    inline int  AtomType::id() const
    {  return id_; }
 
+   #ifdef SIMP_COULOMB
+   // Does this type have a charge?
+   inline bool AtomType::hasCharge() const
+   {  return hasCharge_; }
+
+   // Get the electrical charge.
+   inline double AtomType::charge() const
+   {
+      UTIL_ASSERT(hasCharge_);
+      return charge_;
+   }
+   #endif
+
    // Friend operator declarations
 
    /**
@@ -129,7 +183,9 @@ namespace DdMd
    *
    * Format:
    *
-   *    name  mass
+   *    name  mass [charge]
+   *
+   * The charge is present iff hasCharge is true.
    *
    * \param in        input stream
    * \param atomType  AtomType to be read from stream
@@ -142,7 +198,7 @@ namespace DdMd
    *
    * Format, one one line with no line break:
    *
-   *    name  mass
+   *    name  mass [charge]
    *
    * \param out      output stream
    * \param atomType AtomType to be written to stream
@@ -162,6 +218,12 @@ namespace DdMd
    {
       ar & atomType.name_;
       ar & atomType.mass_;
+      #ifdef SIMP_COULOMB
+      ar & atomType.hasCharge_;
+      if (atomType.hasCharge_) {
+         ar & atomType.charge_;
+      }
+      #endif
    }
 
 }
@@ -40,8 +40,15 @@ namespace DdMd
       atomCapacity_(-1),
       ghostCapacity_(-1),
       maxSendLocal_(0),
+      sendCounter_(0),
+      sendByteCounter_(0.0),
       isInitialized_(false)
-   {  setClassName("Buffer"); }
+   {  
+      setClassName("Buffer"); 
+      #ifdef UTIL_MPI
+      isPending_ = false;
+      #endif
+   }
 
    /*
    * Destructor.
@@ -318,8 +325,15 @@ namespace DdMd
    */
    void Buffer::sendRecv(MPI::Intracomm& comm, int source, int dest)
    {
+      beginSendRecv(comm, source, dest);
+      endSendRecv();
+   }
 
-      MPI::Request request[2];
+   /*
+   * Begin non-blocking send to dest and receive from source.
+   */
+   void Buffer::beginSendRecv(MPI::Intracomm& comm, int source, int dest)
+   {
       int  sendBytes = 0;
       int  myRank    = comm.Get_rank();
       int  comm_size = comm.Get_size();
@@ -337,26 +351,44 @@ namespace DdMd
       if (source == myRank) {
          UTIL_THROW("Source and my rank are identical");
       }
+      if (isPending_) {
+         UTIL_THROW("A non-blocking sendRecv is already in progress");
+      }
 
       // Start nonblocking receive.
-      request[0] = comm.Irecv(recvBufferBegin_, bufferCapacity_ ,
-                              MPI::CHAR, source, 5);
+      requests_[0] = comm.Irecv(recvBufferBegin_, bufferCapacity_ ,
+                                MPI::CHAR, source, 5);
 
       // Start nonblocking send.
       sendBytes = sendPtr_ - sendBufferBegin_;
-      request[1] = comm.Isend(sendBufferBegin_, sendBytes , MPI::CHAR, dest, 5);
-
-      // Wait for completion of receive.
-      request[0].Wait();
-      recvPtr_ = recvBufferBegin_;
-
-      // Wait for completion of send.
-      request[1].Wait();
+      requests_[1] = comm.Isend(sendBufferBegin_, sendBytes , MPI::CHAR, 
+                                dest, 5);
+      isPending_ = true;
 
       // Update statistics.
       if (sendBytes > maxSendLocal_) {
          maxSendLocal_ = sendBytes;
       }
+      ++sendCounter_;
+      sendByteCounter_ += double(sendBytes);
+   }
+
+   /*
+   * Complete a non-blocking send and receive.
+   */
+   void Buffer::endSendRecv()
+   {
+      if (!isPending_) {
+         UTIL_THROW("No non-blocking sendRecv in progress");
+      }
+
+      // Wait for completion of receive.
+      requests_[0].Wait();
+      recvPtr_ = recvBufferBegin_;
+
+      // Wait for completion of send.
+      requests_[1].Wait();
+      isPending_ = false;
    }
 
    /*
@@ -385,6 +417,8 @@ namespace DdMd
       if (sendBytes > maxSendLocal_) {
          maxSendLocal_ = sendBytes;
       }
+      ++sendCounter_;
+      sendByteCounter_ += double(sendBytes);
    }
 
    /*
@@ -438,6 +472,10 @@ namespace DdMd
       if (sendBytes > maxSendLocal_) {
          maxSendLocal_ = sendBytes;
       }
+      if (myRank == source) {
+         ++sendCounter_;
+         sendByteCounter_ += double(sendBytes);
+      }
 
    }
    #endif
@@ -467,6 +505,8 @@ namespace DdMd
    {
       maxSendLocal_ = 0;
       maxSend_.unset();
+      sendCounter_ = 0;
+      sendByteCounter_ = 0.0;
    }
 
    /*
@@ -483,6 +523,18 @@ namespace DdMd
           << std::endl;
    }
 
+   /*
+   * Number of messages sent since statistics were cleared.
+   */
+   long Buffer::sendCounter() const
+   {  return sendCounter_; }
+
+   /*
+   * Total bytes sent since statistics were cleared.
+   */
+   double Buffer::sendByteCounter() const
+   {  return sendByteCounter_; }
+
    /*
    * Number of items packed thus far in current data send block.
    */
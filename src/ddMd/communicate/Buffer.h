@@ -386,6 +386,30 @@ namespace DdMd
       */
       void sendRecv(MPI::Intracomm& comm, int source, int dest);
 
+      /**
+      * Begin a non-blocking sendRecv operation.
+      *
+      * Posts a non-blocking receive from processor source and a 
+      * non-blocking send to processor dest, and returns immediately.
+      * The operation must be completed by endSendRecv() before the
+      * receive buffer is unpacked or the send buffer is modified. 
+      * The sequence beginSendRecv(), endSendRecv() is equivalent 
+      * to sendRecv(), but allows computation between the two calls.
+      *
+      * \param comm   MPI communicator object
+      * \param source MPI rank of processor from which data is sent
+      * \param dest   MPI rank of processor to which data is sent
+      */
+      void beginSendRecv(MPI::Intracomm& comm, int source, int dest);
+
+      /**
+      * Complete a sendRecv operation begun by beginSendRecv().
+      *
+      * Waits for completion of the receive and send, and sets the 
+      * receive buffer for unpacking.
+      */
+      void endSendRecv();
+
       /**
       * Send a complete buffer.
       *
@@ -444,6 +468,16 @@ namespace DdMd
       * Clear any accumulated usage statistics.
       */
       void clearStatistics();
+
+      /**
+      * Number of messages sent by this processor since statistics cleared.
+      */
+      long sendCounter() const;
+
+      /**
+      * Total bytes sent by this processor since statistics cleared.
+      */
+      double sendByteCounter() const;
       
       //@}
       /// \name Accessors
@@ -546,9 +580,23 @@ namespace DdMd
       /// Maximum size used for send buffers on any processor, in bytes.
       Setable<int> maxSend_;
 
+      /// Number of messages sent by this processor.
+      long sendCounter_;
+
+      /// Total bytes sent by this processor.
+      double sendByteCounter_;
+
       /// Has this buffer been initialized ?
       bool isInitialized_;
 
+      #ifdef UTIL_MPI
+      /// Requests for non-blocking receive [0] and send [1].
+      MPI::Request requests_[2];
+
+      /// Is a non-blocking sendRecv in progress?
+      bool isPending_;
+      #endif
+
       /*
       * Allocate send and recv buffers, using preset capacities.
       */
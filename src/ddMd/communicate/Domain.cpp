@@ -8,6 +8,8 @@
 #include "Domain.h"
 #include <util/space/Dimension.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
@@ -25,6 +27,7 @@ namespace DdMd
       gridCoordinates_(),
       gridRank_(-1),
       gridIsPeriodic_(),
+      bounds_(),
       #if UTIL_MPI
       intracommPtr_(0),
       #endif
@@ -147,6 +150,21 @@ namespace DdMd
       // Find grid coordinates for this processor
       gridCoordinates_ = grid_.position(gridRank_);
 
+      // Initialize uniform domain boundaries
+      double dL;
+      int c;
+      for (int i = 0; i < Dimension; i++) {
+         if (bounds_[i].isAllocated()) {
+            bounds_[i].deallocate();
+         }
+         bounds_[i].allocate(gridDimensions_[i] + 1);
+         dL = 1.0 / double(gridDimensions_[i]);
+         for (c = 0; c < gridDimensions_[i]; ++c) {
+            bounds_[i][c] = c*dL;
+         }
+         bounds_[i][gridDimensions_[i]] = 1.0;
+      }
+
       IntVector sourceCoordinates;
       int       i, j, k, jp;
 
@@ -197,9 +215,7 @@ namespace DdMd
       assert(j >= 0);
       assert(j < 2);
 
-      double dL;
-      dL = 1.0 / double(gridDimensions_[i]);
-      return (gridCoordinates_[i] + j)*dL;
+      return bounds_[i][gridCoordinates_[i] + j];
    }
 
    /*
@@ -211,15 +227,17 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
+      const double* begin;
+      const double* end;
       IntVector r;
       for (int i = 0; i < Dimension; ++i) {
-         dL = 1.0 / double(gridDimensions_[i]);
-         r[i] = int(position[i] / dL);
+         // Find the slab c with bounds_[i][c] <= position[i] < bounds_[i][c+1]
+         begin = &bounds_[i][0];
+         end = begin + gridDimensions_[i] + 1;
+         r[i] = int(std::upper_bound(begin, end, position[i]) - begin) - 1;
          if (r[i] < 0 || r[i] >= gridDimensions_[i]) {
             Log::file() << "Cart i   = " << i << std::endl;
             Log::file() << "position = " << position[i] << std::endl;
-            Log::file() << "dL       = " << dL << std::endl;
             Log::file() << "r        = " << r[i] << std::endl;
             Log::file() << "gridDim  = " << gridDimensions_[i] << std::endl;
             UTIL_THROW("Invalid grid coordinate");
@@ -237,18 +255,122 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       bool isIn = true;
       for (int i = 0; i < Dimension; ++i) {  
-         dL = 1.0 / double(gridDimensions_[i]);
-         if (position[i] <   gridCoordinates_[i]*dL) {
+         if (position[i] <   bounds_[i][gridCoordinates_[i]]) {
             isIn = false;
          }
-         if (position[i] >= (gridCoordinates_[i] + 1)*dL) {
+         if (position[i] >= bounds_[i][gridCoordinates_[i] + 1]) {
             isIn = false;
          }
       }
       return isIn;
    }
 
+   /*
+   * Shift domain boundaries to balance load among processors.
+   */
+   void Domain::balance(double load, const Vector& minWidths,
+                        const Vector& maxDisplacements)
+   {
+      // Preconditions
+      assert(isInitialized_);
+
+      DArray<double> localLoads;
+      DArray<double> slabLoads;
+      DArray<double> cumLoads;
+      DArray<double> newBounds;
+      double total, target, shift, maxShift, width, newWidth, alpha;
+      int i, c, m, n;
+
+      for (i = 0; i < Dimension; ++i) {
+         n = gridDimensions_[i];
+         if (n == 1) continue;
+
+         // Sum loads of all processors in each slab 
+         localLoads.allocate(n);
+         slabLoads.allocate(n);
+         for (c = 0; c < n; ++c) {
+            localLoads[c] = 0.0;
+         }
+         localLoads[gridCoordinates_[i]] = load;
+         #ifdef UTIL_MPI
+         communicator().Allreduce(&localLoads[0], &slabLoads[0], n, 
+                                  MPI::DOUBLE, MPI::SUM);
+         #else
+         for (c = 0; c < n; ++c) {
+            slabLoads[c] = localLoads[c];
+         }
+         #endif
+
+         // Compute cumulative load cumLoads[c] below bound c
+         cumLoads.allocate(n + 1);
+         cumLoads[0] = 0.0;
+         for (c = 0; c < n; ++c) {
+            cumLoads[c+1] = cumLoads[c] + slabLoads[c];
+         }
+         total = cumLoads[n];
+
+         if (total > 0.0) {
+
+            // Find bounds that equalize slab loads, assuming uniform
+            // load density within each slab. Limit shifts to less than
+            // half the width of either neighboring slab, and to less
+            // than that width minus the maximum atomic displacement, so
+            // that no atom is more than one slab from its new owner.
+            newBounds.allocate(n + 1);
+            newBounds[0] = 0.0;
+            newBounds[n] = 1.0;
+            c = 0;
+            for (m = 1; m < n; ++m) {
+               target = total*double(m)/double(n);
+               while (c < n - 1 && cumLoads[c+1] < target) {
+                  ++c;
+               }
+               if (slabLoads[c] > 0.0) {
+                  newBounds[m] = bounds_[i][c] 
+                               + (target - cumLoads[c])/slabLoads[c]
+                                 *(bounds_[i][c+1] - bounds_[i][c]);
+               } else {
+                  newBounds[m] = bounds_[i][m];
+               }
+               shift = newBounds[m] - bounds_[i][m];
+               width = std::min(bounds_[i][m] - bounds_[i][m-1], 
+                                bounds_[i][m+1] - bounds_[i][m]);
+               maxShift = std::min(0.49*width, width - maxDisplacements[i]);
+               if (maxShift < 0.0) maxShift = 0.0;
+               if (shift > maxShift) shift = maxShift;
+               if (shift < -maxShift) shift = -maxShift;
+               newBounds[m] = bounds_[i][m] + shift;
+            }
+
+            // Reduce all shifts by a common factor alpha <= 1, if needed, 
+            // so that no slab becomes narrower than minWidths[i]. Slab 
+            // widths are linear functions of alpha.
+            alpha = 1.0;
+            for (c = 0; c < n; ++c) {
+               width = bounds_[i][c+1] - bounds_[i][c];
+               newWidth = newBounds[c+1] - newBounds[c];
+               if (newWidth < minWidths[i] && newWidth < width) {
+                  if (width > minWidths[i]) {
+                     alpha = std::min(alpha, 
+                             (width - minWidths[i])/(width - newWidth));
+                  } else {
+                     alpha = 0.0;
+                  }
+               }
+            }
+            for (m = 1; m < n; ++m) {
+               bounds_[i][m] += alpha*(newBounds[m] - bounds_[i][m]);
+            }
+
+            newBounds.deallocate();
+         }
+
+         localLoads.deallocate();
+         slabLoads.deallocate();
+         cumLoads.deallocate();
+      }
+   }
+
 }
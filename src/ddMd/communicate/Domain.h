@@ -12,6 +12,7 @@
 #include <util/param/ParamComposite.h>  // base class
 #include <util/containers/FMatrix.h>    // member template
 #include <util/containers/FArray.h>     // member template
+#include <util/containers/DArray.h>     // member template
 #include <util/space/IntVector.h>       // member
 #include <util/space/Grid.h>            // member
 #include <util/space/Dimension.h>       // constant expression
@@ -191,6 +192,37 @@ namespace DdMd
       */
       bool isInDomain(const Vector& position) const;
 
+      /**
+      * Shift domain boundaries to balance load among processors.
+      *
+      * Must be called simultaneously on all processors. For each direction
+      * i with gridDimension(i) > 1, the load of each slab of processors 
+      * with equal grid coordinate i is summed over processors. Boundaries
+      * between slabs are then shifted so as to equalize the load of all 
+      * slabs, assuming a load density that is uniform within each slab.
+      *
+      * To allow atoms to be reassigned by a subsequent call to 
+      * Exchanger::exchange(), which moves an atom by at most one domain
+      * in each direction, each boundary is shifted by less than half 
+      * the width of either neighboring domain, and by no more than the
+      * width of either neighboring domain minus maxDisplacements[i], 
+      * and no domain is made narrower than minWidths[i] (or narrower 
+      * than its current width, if this is already less than minWidths[i]).
+      * An atom that has moved a distance less than maxDisplacements[i]
+      * along axis i beyond the boundary of the domain that owns it is
+      * then in that domain or a neighboring domain.
+      *
+      * Atomic coordinates should be generalized on entry, and should not
+      * contain ghosts. 
+      *
+      * \param load      load on this processor (e.g., cpu time)
+      * \param minWidths minimum width of a domain, in generalized coordinates
+      * \param maxDisplacements maximum displacement of an atom beyond the 
+      *                  boundary of its domain, in generalized coordinates
+      */
+      void balance(double load, const Vector& minWidths, 
+                   const Vector& maxDisplacements);
+
       /**
       * Has this Domain been initialized by calling readParam?
       */
@@ -227,6 +259,13 @@ namespace DdMd
       // Is each direction periodic (1 = true, 0 = false).
       FArray<bool, Dimension> gridIsPeriodic_;
 
+      // Boundaries of processor grid slabs in each direction.
+      //
+      // Element bounds_[i][c] is the lower bound (generalized coordinate) 
+      // for domains with grid coordinate c in direction i, for 0 <= c <=
+      // gridDimensions_[i], with bounds_[i][0] = 0 and upper bound 1.
+      FArray< DArray<double>, Dimension> bounds_;
+
       #if UTIL_MPI
 
       // Pointer to Intracommunicator.
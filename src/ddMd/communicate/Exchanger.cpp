@@ -44,7 +44,13 @@ namespace DdMd
       groupExchangers_(),
       bufferPtr_(0),
       pairCutoff_(-1.0),
-      timer_(Exchanger::NTime)
+      sortCounter_(0),
+      updateStep_(0),
+      isUpdatePending_(false),
+      timer_(Exchanger::NTime),
+      exchangeCounter_(0),
+      atomSendCounter_(0),
+      ghostSendCounter_(0)
    {  groupExchangers_.reserve(8); }
 
    /*
@@ -110,6 +116,15 @@ namespace DdMd
       }
       exchangeAtoms();
       exchangeGhosts();
+
+      // Update statistics
+      ++exchangeCounter_;
+      for (int i = 0; i < Dimension; ++i) {
+         if (gridFlags_[i]) {
+            ghostSendCounter_ += sendArray_(i, 0).size();
+            ghostSendCounter_ += sendArray_(i, 1).size();
+         }
+      }
    }
 
    /*
@@ -404,6 +419,7 @@ namespace DdMd
                   #ifdef UTIL_MPI
                   if (gridFlags_[i]) {
                      sentAtoms_.append(*atomIter);
+                     ++atomSendCounter_;
                      atomIter->packAtom(*bufferPtr_);
                   } else
                   #endif
@@ -567,6 +583,16 @@ namespace DdMd
       *    All pointers to ghost atoms in Groups are null.
       */
 
+      // Periodically sort local atoms in memory (optional)
+      if (atomStoragePtr_->sortInterval() > 0) {
+         ++sortCounter_;
+         if (sortCounter_ >= atomStoragePtr_->sortInterval()) {
+            sortAtoms();
+            sortCounter_ = 0;
+         }
+      }
+      stamp(SORT_ATOMS);
+
       #ifdef UTIL_DEBUG
       #ifdef DDMD_EXCHANGER_DEBUG
       // Validity checks
@@ -590,6 +616,54 @@ namespace DdMd
       stamp(MARK_GROUP_GHOSTS);
    }
 
+   /*
+   * Sort local atoms and reset all pointers to local atoms (private).
+   *
+   * Called within exchangeAtoms, when no ghosts exist, after all local 
+   * atoms are on the correct processor, and before markGhosts.
+   */
+   void Exchanger::sortAtoms()
+   {
+      // Reorder atoms along a space-filling curve within this domain
+      Vector lower;
+      Vector upper;
+      int i, j, k;
+      for (i = 0; i < Dimension; ++i) {
+         lower[i] = bound_(i, 0);
+         upper[i] = bound_(i, 1);
+      }
+      atomStoragePtr_->sortAtoms(lower, upper);
+
+      // Reset pointers to local atoms in all groups
+      for (k = 0; k < groupExchangers_.size(); ++k) {
+         groupExchangers_[k].findLocals(*atomStoragePtr_);
+      }
+
+      /*
+      * Rebuild send arrays. At this point, every local atom will stay
+      * on this processor, and send arrays contain only local atoms. 
+      * Each atom is added to sendArray_(i, j) iff plan().ghost(i, j).
+      */
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < 2; ++j) {
+            sendArray_(i, j).clear();
+         }
+      }
+      AtomIterator atomIter;
+      Plan* planPtr;
+      atomStoragePtr_->begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         planPtr = &atomIter->plan();
+         for (i = 0; i < Dimension; ++i) {
+            for (j = 0; j < 2; ++j) {
+               if (planPtr->ghost(i, j)) {
+                  sendArray_(i, j).append(*atomIter);
+               }
+            }
+         }
+      }
+   }
+
    /*
    * Exchange ghost atoms.
    *
@@ -819,78 +893,149 @@ namespace DdMd
    * Call on time steps for which no reneighboring is required.
    */
    void Exchanger::update()
+   {
+      beginUpdate();
+      endUpdate();
+   }
+
+   /*
+   * Begin non-blocking update of ghost atom positions.
+   *
+   * Transmissions are numbered by step = 2*i + j, where i is a Cartesian 
+   * direction and j is a transmit direction. Transmissions must be 
+   * completed in this order, because ghosts received in direction i 
+   * may be sent again in a later direction. 
+   */
+   void Exchanger::beginUpdate()
    {
       stamp(START);
       if (!atomStoragePtr_->isCartesian()) {
          UTIL_THROW("Error: Coordinates not Cartesian on entry to update");
       }
+      if (isUpdatePending_) {
+         UTIL_THROW("Error: Update is already in progress");
+      }
 
-      Atom*  atomPtr;
-      int    i, j, k, source, dest, size, shift;
-
-      for (i = 0; i < Dimension; ++i) {
-         for (j = 0; j < 2; ++j) {
-
-            // Shift on receiving processor for periodic boundary conditions
-            shift = domainPtr_->shift(i, j);
-
-            if (gridFlags_[i]) {
-
-               // Pack ghost positions for sending
-               bufferPtr_->clearSendBuffer();
-               bufferPtr_->beginSendBlock(Buffer::UPDATE);
-               size = sendArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &sendArray_(i, j)[k];
-                  atomPtr->packUpdate(*bufferPtr_);
-               }
-               bufferPtr_->endSendBlock();
-               stamp(PACK_UPDATE);
+      int i, j;
+      for (updateStep_ = 0; updateStep_ < 2*Dimension; ++updateStep_) {
+         i = updateStep_/2;
+         j = updateStep_%2;
+         if (gridFlags_[i]) {
+
+            // Post non-blocking transmission, and return
+            packUpdate(i, j);
+            bufferPtr_->beginSendRecv(domainPtr_->communicator(), 
+                                      domainPtr_->sourceRank(i, j), 
+                                      domainPtr_->destRank(i, j));
+            isUpdatePending_ = true;
+            stamp(SEND_RECV_UPDATE);
+            return;
 
-               // Send and receive buffers
-               source = domainPtr_->sourceRank(i, j);
-               dest   = domainPtr_->destRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(), source, dest);
-               stamp(SEND_RECV_UPDATE);
+         } else {
+            localUpdate(i, j);
+         }
+      }
+   }
 
-               // Unpack ghost positions
-               bufferPtr_->beginRecvBlock();
-               size = recvArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->unpackUpdate(*bufferPtr_);
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               bufferPtr_->endRecvBlock();
-               stamp(UNPACK_UPDATE);
+   /*
+   * Complete update of ghost atom positions.
+   */
+   void Exchanger::endUpdate()
+   {
+      int i, j;
 
-            } else {
+      // Complete pending transmission, if any
+      if (isUpdatePending_) {
+         i = updateStep_/2;
+         j = updateStep_%2;
+         bufferPtr_->endSendRecv();
+         isUpdatePending_ = false;
+         stamp(SEND_RECV_UPDATE);
+         unpackUpdate(i, j);
+         ++updateStep_;
+      }
 
-               // If grid().dimension(i) == 1, then copy positions of atoms
-               // listed in sendArray to those listed in the recvArray.
+      // Complete remaining transmissions
+      for ( ; updateStep_ < 2*Dimension; ++updateStep_) {
+         i = updateStep_/2;
+         j = updateStep_%2;
+         if (gridFlags_[i]) {
+            packUpdate(i, j);
+            bufferPtr_->sendRecv(domainPtr_->communicator(), 
+                                 domainPtr_->sourceRank(i, j), 
+                                 domainPtr_->destRank(i, j));
+            stamp(SEND_RECV_UPDATE);
+            unpackUpdate(i, j);
+         } else {
+            localUpdate(i, j);
+         }
+      }
+   }
 
-               size = sendArray_(i, j).size();
-               assert(size == recvArray_(i, j).size());
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->copyLocalUpdate(sendArray_(i, j)[k]);
-                  #if 0
-                  atomPtr->position() = sendArray_(i, j)[k].position();
-                  #endif
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               stamp(LOCAL_UPDATE);
+   /*
+   * Pack ghost positions for transmission in direction (i, j).
+   */
+   void Exchanger::packUpdate(int i, int j)
+   {
+      Atom* atomPtr;
+      int k;
+      bufferPtr_->clearSendBuffer();
+      bufferPtr_->beginSendBlock(Buffer::UPDATE);
+      int size = sendArray_(i, j).size();
+      for (k = 0; k < size; ++k) {
+         atomPtr = &sendArray_(i, j)[k];
+         atomPtr->packUpdate(*bufferPtr_);
+      }
+      bufferPtr_->endSendBlock();
+      stamp(PACK_UPDATE);
+   }
 
-            }
+   /*
+   * Unpack ghost positions received in direction (i, j).
+   */
+   void Exchanger::unpackUpdate(int i, int j)
+   {
+      // Shift on receiving processor for periodic boundary conditions
+      int shift = domainPtr_->shift(i, j);
 
-         } // transmit direction j = 0, 1
+      Atom* atomPtr;
+      int k;
+      bufferPtr_->beginRecvBlock();
+      int size = recvArray_(i, j).size();
+      for (k = 0; k < size; ++k) {
+         atomPtr = &recvArray_(i, j)[k];
+         atomPtr->unpackUpdate(*bufferPtr_);
+         if (shift) {
+            boundaryPtr_->applyShift(atomPtr->position(), i, shift);
+         }
+      }
+      bufferPtr_->endRecvBlock();
+      stamp(UNPACK_UPDATE);
+   }
 
-      } // Cartesian direction i = 0, ..., Dimension - 1
+   /*
+   * Copy ghost positions in direction (i, j), if grid dimension i is 1.
+   *
+   * If grid().dimension(i) == 1, then copy positions of atoms listed in
+   * sendArray to those listed in the recvArray.
+   */
+   void Exchanger::localUpdate(int i, int j)
+   {
+      // Shift on receiving processor for periodic boundary conditions
+      int shift = domainPtr_->shift(i, j);
 
+      Atom* atomPtr;
+      int k;
+      int size = sendArray_(i, j).size();
+      assert(size == recvArray_(i, j).size());
+      for (k = 0; k < size; ++k) {
+         atomPtr = &recvArray_(i, j)[k];
+         atomPtr->copyLocalUpdate(sendArray_(i, j)[k]);
+         if (shift) {
+            boundaryPtr_->applyShift(atomPtr->position(), i, shift);
+         }
+      }
+      stamp(LOCAL_UPDATE);
    }
 
    /*
@@ -959,6 +1104,77 @@ namespace DdMd
 
    }
 
+   /*
+   * Update ghost atom velocities.
+   */
+   void Exchanger::updateVelocities()
+   {
+      if (isUpdatePending_) {
+         UTIL_THROW("Error: Update is already in progress");
+      }
+      stamp(START);
+      Atom*  atomPtr;
+      int    i, j, k, size;
+
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < 2; ++j) {
+
+            if (gridFlags_[i]) {
+
+               // Pack velocities of atoms sent as ghosts
+               bufferPtr_->clearSendBuffer();
+               bufferPtr_->beginSendBlock(Buffer::UPDATE);
+               size = sendArray_(i, j).size();
+               for (k = 0; k < size; ++k) {
+                  atomPtr = &sendArray_(i, j)[k];
+                  atomPtr->packVelocity(*bufferPtr_);
+               }
+               bufferPtr_->endSendBlock();
+               stamp(PACK_UPDATE);
+
+               bufferPtr_->sendRecv(domainPtr_->communicator(), 
+                                    domainPtr_->sourceRank(i, j), 
+                                    domainPtr_->destRank(i, j));
+               stamp(SEND_RECV_UPDATE);
+
+               // Unpack ghost velocities (no periodic shift)
+               bufferPtr_->beginRecvBlock();
+               size = recvArray_(i, j).size();
+               for (k = 0; k < size; ++k) {
+                  atomPtr = &recvArray_(i, j)[k];
+                  atomPtr->unpackVelocity(*bufferPtr_);
+               }
+               bufferPtr_->endRecvBlock();
+               stamp(UNPACK_UPDATE);
+
+            } else {
+
+               size = sendArray_(i, j).size();
+               assert(size == recvArray_(i, j).size());
+               for (k = 0; k < size; ++k) {
+                  recvArray_(i, j)[k].velocity() 
+                                      = sendArray_(i, j)[k].velocity();
+               }
+               stamp(LOCAL_UPDATE);
+
+            }
+
+         } // transmit direction j = 0 or 1
+
+      } // Cartesian direction i
+
+   }
+
+   /*
+   * Clear counters of exchanges and sent atoms.
+   */
+   void Exchanger::clearStatistics()
+   {
+      exchangeCounter_ = 0;
+      atomSendCounter_ = 0;
+      ghostSendCounter_ = 0;
+   }
+
    /*
    * Output statistics.
    */
@@ -1053,6 +1269,12 @@ namespace DdMd
           << Dbl(UnpackGroupsT*factor1, 12, 6) << "   " 
           << Dbl(UnpackGroupsT*factor2, 12, 6) << "   " 
           << Dbl(UnpackGroupsT*factor3, 12, 6, true) << std::endl;
+      double SortAtomsT = timer_.time(Exchanger::SORT_ATOMS);
+      atomExchangeT += SortAtomsT;
+      out << "SortAtoms            " 
+          << Dbl(SortAtomsT*factor1, 12, 6) << "   " 
+          << Dbl(SortAtomsT*factor2, 12, 6) << "   " 
+          << Dbl(SortAtomsT*factor3, 12, 6, true) << std::endl;
       double MarkGroupGhostsT = timer_.time(Exchanger::MARK_GROUP_GHOSTS);
       atomExchangeT += MarkGroupGhostsT;
       out << "MarkGroupGhosts      " 
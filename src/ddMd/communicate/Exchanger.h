@@ -100,6 +100,27 @@ namespace DdMd
       */
       void update();
 
+      /**
+      * Begin a non-blocking update of ghost atom coordinates.
+      *
+      * Performs any initial local copies of ghost positions, packs
+      * positions for the first transmission that requires interprocessor
+      * communication, and posts a non-blocking send and receive for this
+      * transmission. Calling beginUpdate() and then endUpdate() is 
+      * equivalent to calling update(). Calculations between these calls 
+      * may use positions of local atoms, but not positions of ghosts, 
+      * and may not modify positions of local atoms.
+      */
+      void beginUpdate();
+
+      /**
+      * Complete an update of ghost atom coordinates.
+      *
+      * Completes the transmission begun by beginUpdate(), and then
+      * completes all remaining transmissions.
+      */
+      void endUpdate();
+
       /**
       * Update ghost atom forces.
       * 
@@ -112,11 +133,41 @@ namespace DdMd
       */
       void reverseUpdate();
 
+      /**
+      * Update ghost atom velocities.
+      *
+      * Communicates velocities for the same ghosts, and in the same 
+      * order, as update() communicates positions. Ghost velocities are 
+      * otherwise undefined. This is used by constraint algorithms that
+      * require velocities of both atoms in a group.
+      */
+      void updateVelocities();
+
       /**
       * Output statistics.
       */
       void outputStatistics(std::ostream& out, double time, int nStep);
 
+      /**
+      * Clear counters of exchanges and sent atoms.
+      */
+      void clearStatistics();
+
+      /**
+      * Number of calls to exchange() since statistics were cleared.
+      */
+      long exchangeCounter() const;
+
+      /**
+      * Number of local atoms sent to other processors by exchange().
+      */
+      long atomSendCounter() const;
+
+      /**
+      * Number of ghosts sent to other processors by exchange().
+      */
+      long ghostSendCounter() const;
+
       /**
       * Return internal timer by reference
       */
@@ -128,7 +179,7 @@ namespace DdMd
       enum timeId {START, ATOM_PLAN, INIT_GROUP_PLAN, CLEAR_GHOSTS,
                    PACK_ATOMS, PACK_GROUPS, REMOVE_ATOMS, 
                    SEND_RECV_ATOMS, UNPACK_ATOMS, UNPACK_GROUPS, 
-                   MARK_GROUP_GHOSTS, INIT_SEND_ARRAYS, PACK_GHOSTS, 
+                   SORT_ATOMS, MARK_GROUP_GHOSTS, INIT_SEND_ARRAYS, PACK_GHOSTS, 
                    SEND_RECV_GHOSTS, UNPACK_GHOSTS, FIND_GROUP_GHOSTS, 
                    PACK_UPDATE, SEND_RECV_UPDATE, UNPACK_UPDATE, 
                    LOCAL_UPDATE, PACK_FORCE, SEND_RECV_FORCE, 
@@ -199,9 +250,27 @@ namespace DdMd
       /// Cutoff for pair list (potential cutoff + skin).
       double pairCutoff_;
 
+      /// Number of atom exchanges since local atoms were last sorted.
+      int sortCounter_;
+
+      /// Index of next update transmission, 0 <= updateStep_ <= 2*Dimension.
+      int updateStep_;
+
+      /// Is a non-blocking update transmission in progress?
+      bool isUpdatePending_;
+
       /// Timer
       DdTimer timer_;
 
+      /// Number of calls to exchange().
+      long exchangeCounter_;
+
+      /// Number of local atoms sent to other processors.
+      long atomSendCounter_;
+
+      /// Number of ghosts sent to other processors.
+      long ghostSendCounter_;
+
       /**
       * Exchange ownership of local atoms.
       *
@@ -221,6 +290,41 @@ namespace DdMd
       */
       void exchangeGhosts();
 
+      /**
+      * Sort local atoms in memory and reset pointers to local atoms.
+      *
+      * This method is called within exchangeAtoms() every sortInterval
+      * exchanges, after all atoms and groups have been exchanged, but
+      * before calling GroupExchanger::markGhosts. It reorders local
+      * atoms by calling AtomStorage::sortAtoms, resets pointers to
+      * local atoms in all groups, and rebuilds the ghost send arrays.
+      */
+      void sortAtoms();
+
+      /**
+      * Pack ghost positions for an update transmission.
+      *
+      * \param i Cartesian direction index
+      * \param j transmit direction index (0 or 1)
+      */
+      void packUpdate(int i, int j);
+
+      /**
+      * Unpack ghost positions received in an update transmission.
+      *
+      * \param i Cartesian direction index
+      * \param j transmit direction index (0 or 1)
+      */
+      void unpackUpdate(int i, int j);
+
+      /**
+      * Copy ghost positions for a direction with one processor.
+      *
+      * \param i Cartesian direction index
+      * \param j transmit direction index (0 or 1)
+      */
+      void localUpdate(int i, int j);
+
       /**
       * Stamp internal timer.
       */
@@ -234,6 +338,18 @@ namespace DdMd
    inline DdTimer& Exchanger::timer()
    {  return timer_; }
 
+   // Return number of exchanges.
+   inline long Exchanger::exchangeCounter() const
+   {  return exchangeCounter_; }
+
+   // Return number of local atoms sent.
+   inline long Exchanger::atomSendCounter() const
+   {  return atomSendCounter_; }
+
+   // Return number of ghosts sent.
+   inline long Exchanger::ghostSendCounter() const
+   {  return ghostSendCounter_; }
+
    // Stamp internal timer (private)
    inline void Exchanger::stamp(unsigned int timeId) 
    {  timer_.stamp(timeId); }
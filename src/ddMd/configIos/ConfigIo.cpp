@@ -131,6 +131,25 @@ namespace DdMd
    }
 
 
+   /*
+   * Are files read and written collectively? (default false).
+   */
+   bool ConfigIo::isCollective() const
+   {  return false; }
+
+   /*
+   * Read a configuration file collectively (default throws).
+   */
+   void ConfigIo::readCollective(const std::string& filename, 
+                                 MaskPolicy maskPolicy)
+   {  UTIL_THROW("Collective input not implemented by this ConfigIo"); }
+
+   /*
+   * Write a configuration file collectively (default throws).
+   */
+   void ConfigIo::writeCollective(const std::string& filename)
+   {  UTIL_THROW("Collective output not implemented by this ConfigIo"); }
+
    /*
    * Private method to read Group<N> objects.
    */
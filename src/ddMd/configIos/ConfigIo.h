@@ -159,6 +159,40 @@ namespace DdMd
       */
       virtual void writeConfig(std::ofstream& file) = 0;
 
+      /**
+      * Are files read and written collectively by all processors?
+      *
+      * If this returns true, Simulation::readConfig(), writeConfig(),
+      * save() and load() call readCollective() and writeCollective() 
+      * on all processors, rather than opening a stream on the master
+      * and calling readConfig() or writeConfig(). Default returns false.
+      */
+      virtual bool isCollective() const;
+
+      /**
+      * Read a configuration file collectively.
+      *
+      * Call on all processors. Preconditions and postconditions are
+      * those of readConfig(std::ifstream&, MaskPolicy). The default
+      * implementation throws an Exception.
+      *
+      * \param filename full path of file, identical on all processors
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual 
+      void readCollective(const std::string& filename, MaskPolicy maskPolicy);
+
+      /**
+      * Write a configuration file collectively.
+      *
+      * Call on all processors. Requirements are those of 
+      * writeConfig(std::ofstream&). The default implementation 
+      * throws an Exception.
+      *
+      * \param filename full path of file, identical on all processors
+      */
+      virtual void writeCollective(const std::string& filename);
+
    protected:
 
       /**
@@ -0,0 +1,655 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdParallelConfigIo.h"
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/Domain.h>
+
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GroupStorage.tpp>
+#include <ddMd/storage/GroupIterator.h>
+#ifdef SIMP_BOND
+#include <ddMd/storage/BondStorage.h>
+#endif
+#ifdef SIMP_ANGLE
+#include <ddMd/storage/AngleStorage.h>
+#endif
+#ifdef SIMP_DIHEDRAL
+#include <ddMd/storage/DihedralStorage.h>
+#endif
+
+#include <ddMd/chemistry/Atom.h>
+#include <ddMd/chemistry/Group.h>
+#include <ddMd/chemistry/MaskPolicy.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryCounter.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/mpi/MpiSendRecv.h>
+#include <util/misc/Log.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Default constructor.
+   */
+   DdMdParallelConfigIo::DdMdParallelConfigIo()
+    : ConfigIo(),
+      atomBegin_(0),
+      atomEnd_(0),
+      nAtom_(0)
+   {  setClassName("DdMdParallelConfigIo"); }
+
+   /*
+   * Constructor.
+   */
+   DdMdParallelConfigIo::DdMdParallelConfigIo(Simulation& simulation)
+    : ConfigIo(simulation),
+      atomBegin_(0),
+      atomEnd_(0),
+      nAtom_(0)
+   {  setClassName("DdMdParallelConfigIo"); }
+
+   /*
+   * Stream input is not supported.
+   */
+   void DdMdParallelConfigIo::readConfig(std::ifstream& file,
+                                         MaskPolicy maskPolicy)
+   {  UTIL_THROW("DdMdParallelConfigIo supports only collective input"); }
+
+   /*
+   * Stream output is not supported.
+   */
+   void DdMdParallelConfigIo::writeConfig(std::ofstream& file)
+   {  UTIL_THROW("DdMdParallelConfigIo supports only collective output"); }
+
+   /*
+   * Files are read and written collectively.
+   */
+   bool DdMdParallelConfigIo::isCollective() const
+   {  return true; }
+
+   /*
+   * Allocate count and displacement arrays (private).
+   */
+   void DdMdParallelConfigIo::allocateCounts()
+   {
+      if (!sendCounts_.isAllocated()) {
+         int nProc = domain().communicator().Get_size();
+         sendCounts_.allocate(nProc);
+         sendDispls_.allocate(nProc);
+         recvCounts_.allocate(nProc);
+         recvDispls_.allocate(nProc);
+      }
+   }
+
+   /*
+   * Rank that reads the record of an atom (private).
+   *
+   * Processor p reads atoms with ids in the range [nAtom_*p/nProc,
+   * nAtom_*(p+1)/nProc), using integer division.
+   */
+   int DdMdParallelConfigIo::atomBlockRank(int atomId) const
+   {
+      long long nProc = sendCounts_.capacity();
+      return (int)( ((long long)(atomId + 1)*nProc - 1)/((long long)nAtom_) );
+   }
+
+   /*
+   * Send records to destination processors (private).
+   */
+   template <typename Record>
+   void DdMdParallelConfigIo::exchangeRecords(GArray<Record>& records,
+                                              GArray<int>& destinations,
+                                              int width,
+                                              GArray<Record>& recvRecords,
+                                              MPI::Datatype& recordType)
+   {
+      const int nProc = sendCounts_.capacity();
+      const int n = records.size();
+      int i, j, p, pos;
+
+      // Count records sent to each processor
+      for (p = 0; p < nProc; ++p) {
+         sendCounts_[p] = 0;
+      }
+      for (i = 0; i < n*width; ++i) {
+         if (destinations[i] >= 0) {
+            ++sendCounts_[destinations[i]];
+         }
+      }
+      DArray<int> offsets;
+      offsets.allocate(nProc);
+      pos = 0;
+      for (p = 0; p < nProc; ++p) {
+         sendDispls_[p] = pos;
+         offsets[p] = pos;
+         pos += sendCounts_[p];
+      }
+
+      // Pack records in order of destination
+      GArray<Record> sendRecords;
+      sendRecords.resize(pos);
+      for (i = 0; i < n; ++i) {
+         for (j = 0; j < width; ++j) {
+            p = destinations[i*width + j];
+            if (p >= 0) {
+               sendRecords[offsets[p]] = records[i];
+               ++offsets[p];
+            }
+         }
+      }
+
+      // Exchange record counts, then records
+      MPI::Intracomm& comm = domain().communicator();
+      comm.Alltoall(&sendCounts_[0], 1, MPI::INT,
+                    &recvCounts_[0], 1, MPI::INT);
+      pos = 0;
+      for (p = 0; p < nProc; ++p) {
+         recvDispls_[p] = pos;
+         pos += recvCounts_[p];
+      }
+      recvRecords.resize(pos);
+      comm.Alltoallv(sendRecords.cArray(), &sendCounts_[0], &sendDispls_[0],
+                     recordType,
+                     recvRecords.cArray(), &recvCounts_[0], &recvDispls_[0],
+                     recordType);
+   }
+
+   /*
+   * Write records with ids in ids_ to one section of the file (private).
+   */
+   void DdMdParallelConfigIo::writeRecords(MPI::File& file, MPI::Offset begin,
+                                           const void* buffer,
+                                           MPI::Datatype& recordType)
+   {
+      // The file view of this processor selects records with ids in ids_.
+      int n = ids_.size();
+      MPI::Datatype fileType;
+      if (n > 0) {
+         fileType = recordType.Create_indexed_block(n, 1, ids_.cArray());
+      } else {
+         fileType = recordType.Dup();
+      }
+      fileType.Commit();
+      file.Set_view(begin, recordType, fileType, "native", MPI::INFO_NULL);
+      file.Write_all(buffer, n, recordType);
+      file.Set_view(0, MPI::BYTE, MPI::BYTE, "native", MPI::INFO_NULL);
+      fileType.Free();
+   }
+
+   /*
+   * Read groups of one type, send each to the owners of its atoms (private).
+   */
+   template <int N>
+   void DdMdParallelConfigIo::readGroups(MPI::File& file, MPI::Offset begin,
+                                         int nGroup, GroupStorage<N>& storage)
+   {
+      MPI::Intracomm& comm = domain().communicator();
+      const int nProc = comm.Get_size();
+      const int rank = comm.Get_rank();
+      MPI::Datatype groupType
+                      = MPI::BYTE.Create_contiguous(sizeof(GroupRecord<N>));
+      groupType.Commit();
+
+      // Read a contiguous block of group records
+      int groupBegin = (int)( ((long long)nGroup*rank)/nProc );
+      int groupEnd = (int)( ((long long)nGroup*(rank + 1))/nProc );
+      int n = groupEnd - groupBegin;
+      GArray< GroupRecord<N> > records;
+      records.resize(n);
+      MPI::Offset size = sizeof(GroupRecord<N>);
+      file.Read_at_all(begin + size*groupBegin, records.cArray(), n,
+                       groupType);
+
+      // Send each group to the processors that read records of its atoms
+      GArray<int> destinations;
+      destinations.resize(n*N);
+      int i, j, k, atomId, p;
+      for (i = 0; i < n; ++i) {
+         GroupRecord<N>& record = records[i];
+         if (record.id != groupBegin + i) {
+            UTIL_THROW("Group records are not in order of id");
+         }
+         for (j = 0; j < N; ++j) {
+            atomId = record.atomIds[j];
+            if (atomId < 0 || atomId >= nAtom_) {
+               UTIL_THROW("Invalid atom id in group");
+            }
+            p = atomBlockRank(atomId);
+            for (k = 0; k < j; ++k) {
+               if (destinations[i*N + k] == p) p = -1;
+            }
+            destinations[i*N + j] = p;
+         }
+      }
+      GArray< GroupRecord<N> > blockRecords;
+      exchangeRecords(records, destinations, N, blockRecords, groupType);
+
+      // Forward each group to the owners of its atoms in this block
+      n = blockRecords.size();
+      destinations.resize(n*N);
+      for (i = 0; i < n; ++i) {
+         GroupRecord<N>& record = blockRecords[i];
+         for (j = 0; j < N; ++j) {
+            atomId = record.atomIds[j];
+            p = -1;
+            if (atomId >= atomBegin_ && atomId < atomEnd_) {
+               p = owners_[atomId - atomBegin_];
+               for (k = 0; k < j; ++k) {
+                  if (destinations[i*N + k] == p) p = -1;
+               }
+            }
+            destinations[i*N + j] = p;
+         }
+      }
+      exchangeRecords(blockRecords, destinations, N, records, groupType);
+      groupType.Free();
+
+      // Add groups to storage. A group may be received more than once
+      // if this processor owns more than one of its atoms.
+      Group<N>* groupPtr;
+      n = records.size();
+      for (i = 0; i < n; ++i) {
+         GroupRecord<N>& record = records[i];
+         if (record.id < 0 || record.id >= storage.totalCapacity()) {
+            UTIL_THROW("Invalid group id");
+         }
+         if (storage.find(record.id)) continue;
+         groupPtr = storage.newPtr();
+         groupPtr->setId(record.id);
+         groupPtr->setTypeId(record.typeId);
+         for (j = 0; j < N; ++j) {
+            groupPtr->setAtomId(j, record.atomIds[j]);
+         }
+         if (atomStorage().map().findGroupLocalAtoms(*groupPtr) > 0) {
+            storage.add();
+         } else {
+            storage.returnPtr();
+            UTIL_THROW("Group received by processor that owns none of its atoms");
+         }
+      }
+
+      // Validate
+      storage.unsetNTotal();
+      storage.computeNTotal(comm);
+      if (domain().isMaster()) {
+         if (storage.nTotal() != nGroup) {
+            UTIL_THROW("Number of groups after distribution != nGroup");
+         }
+      }
+   }
+
+   /*
+   * Read a configuration file collectively.
+   */
+   void DdMdParallelConfigIo::readCollective(const std::string& filename,
+                                             MaskPolicy maskPolicy)
+   {
+      // Preconditions
+      if (atomStorage().nAtom()) {
+         UTIL_THROW("Atom storage is not empty (has local atoms)");
+      }
+      if (atomStorage().nGhost()) {
+         UTIL_THROW("Atom storage is not empty (has ghost atoms)");
+      }
+      if (atomStorage().isCartesian()) {
+         UTIL_THROW("Error: Atom storage is set for Cartesian coordinates");
+      }
+
+      MPI::Intracomm& comm = domain().communicator();
+      const int nProc = comm.Get_size();
+      const int rank = comm.Get_rank();
+      allocateCounts();
+
+      // Read header on master, and broadcast
+      int nAtom = 0;
+      #ifdef SIMP_BOND
+      int nBond = 0;
+      #endif
+      #ifdef SIMP_ANGLE
+      int nAngle = 0;
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      int nDihedral = 0;
+      #endif
+      if (domain().isMaster()) {
+         std::ifstream in(filename.c_str(),
+                          std::ios_base::in | std::ios_base::binary);
+         if (in.fail()) {
+            Log::file() << "Filename = " << filename << std::endl;
+            UTIL_THROW("Error opening configuration file");
+         }
+         BinaryFileIArchive ar(in);
+         ar >> nAtom;
+         #ifdef SIMP_BOND
+         ar >> nBond;
+         #endif
+         #ifdef SIMP_ANGLE
+         ar >> nAngle;
+         #endif
+         #ifdef SIMP_DIHEDRAL
+         ar >> nDihedral;
+         #endif
+         ar >> boundary();
+         in.close();
+      }
+      bcast<int>(comm, nAtom, 0);
+      #ifdef SIMP_BOND
+      bcast<int>(comm, nBond, 0);
+      #endif
+      #ifdef SIMP_ANGLE
+      bcast<int>(comm, nAngle, 0);
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      bcast<int>(comm, nDihedral, 0);
+      #endif
+      bcast(comm, boundary(), 0);
+      MPI::Offset begin = memorySize(nAtom) + memorySize(boundary());
+      #ifdef SIMP_BOND
+      begin += memorySize(nBond);
+      #endif
+      #ifdef SIMP_ANGLE
+      begin += memorySize(nAngle);
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      begin += memorySize(nDihedral);
+      #endif
+
+      MPI::File file = MPI::File::Open(comm, filename.c_str(),
+                                       MPI::MODE_RDONLY, MPI::INFO_NULL);
+
+      // Read a contiguous block of atom records
+      nAtom_ = nAtom;
+      atomBegin_ = (int)( ((long long)nAtom*rank)/nProc );
+      atomEnd_ = (int)( ((long long)nAtom*(rank + 1))/nProc );
+      int n = atomEnd_ - atomBegin_;
+      atomRecords_.resize(n);
+      MPI::Datatype atomType
+                    = MPI::BYTE.Create_contiguous(sizeof(AtomRecord));
+      atomType.Commit();
+      const MPI::Offset size = sizeof(AtomRecord);
+      file.Read_at_all(begin + size*atomBegin_, atomRecords_.cArray(), n,
+                       atomType);
+
+      // Send each atom to the processor that owns it
+      int totalAtomCapacity = atomStorage().totalAtomCapacity();
+      owners_.resize(n);
+      int i;
+      for (i = 0; i < n; ++i) {
+         AtomRecord& record = atomRecords_[i];
+         if (record.id != atomBegin_ + i) {
+            UTIL_THROW("Atom records are not in order of id");
+         }
+         if (record.id >= totalAtomCapacity) {
+            UTIL_THROW("Invalid atom id");
+         }
+         boundary().shiftGen(record.position);
+         owners_[i] = domain().ownerRank(record.position);
+      }
+      GArray<AtomRecord> recvRecords;
+      exchangeRecords(atomRecords_, owners_, 1, recvRecords, atomType);
+      atomType.Free();
+
+      // Add received atoms to storage
+      bool hasContext = Atom::hasAtomContext();
+      Atom* atomPtr;
+      n = recvRecords.size();
+      for (i = 0; i < n; ++i) {
+         AtomRecord& record = recvRecords[i];
+         atomPtr = atomStorage().newAtomPtr();
+         atomPtr->setId(record.id);
+         atomPtr->setTypeId(record.typeId);
+         atomPtr->position() = record.position;
+         atomPtr->velocity() = record.velocity;
+         if (hasContext) {
+            atomPtr->context().speciesId = record.speciesId;
+            atomPtr->context().moleculeId = record.moleculeId;
+            atomPtr->context().atomId = record.atomId;
+         }
+         atomStorage().addNewAtom();
+      }
+      atomStorage().unsetNAtomTotal();
+      atomStorage().computeNAtomTotal(comm);
+      if (domain().isMaster()) {
+         if (atomStorage().nAtomTotal() != nAtom) {
+            UTIL_THROW("nAtomTotal != nAtom after distribution");
+         }
+      }
+      begin += size*nAtom;
+
+      // Read covalent groups
+      bool hasGhosts = false;
+      #ifdef SIMP_BOND
+      if (bondStorage().capacity()) {
+         readGroups<2>(file, begin, nBond, bondStorage());
+         bondStorage().isValid(atomStorage(), comm, hasGhosts);
+         if (maskPolicy == MaskBonded) {
+            setAtomMasks();
+         }
+      }
+      begin += (MPI::Offset)(sizeof(GroupRecord<2>))*nBond;
+      #endif
+      #ifdef SIMP_ANGLE
+      if (angleStorage().capacity()) {
+         readGroups<3>(file, begin, nAngle, angleStorage());
+         angleStorage().isValid(atomStorage(), comm, hasGhosts);
+      }
+      begin += (MPI::Offset)(sizeof(GroupRecord<3>))*nAngle;
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      if (dihedralStorage().capacity()) {
+         readGroups<4>(file, begin, nDihedral, dihedralStorage());
+         dihedralStorage().isValid(atomStorage(), comm, hasGhosts);
+      }
+      #endif
+
+      file.Close();
+   }
+
+   /*
+   * Write the groups of one type (private).
+   *
+   * Each group is written by the processor that owns its first atom.
+   */
+   template <int N>
+   void DdMdParallelConfigIo::writeGroups(MPI::File& file, MPI::Offset begin,
+                                          int nGroup, GroupStorage<N>& storage)
+   {
+      GArray< GroupRecord<N> > records;
+      GroupRecord<N> record;
+      GroupIterator<N> iter;
+      Atom* atomPtr;
+      int i, j;
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         atomPtr = iter->atomPtr(0);
+         if (atomPtr && !atomPtr->isGhost()) {
+            if (iter->id() < 0 || iter->id() >= nGroup) {
+               UTIL_THROW("Group ids must be 0,...,nGroup-1");
+            }
+            record.id = iter->id();
+            record.typeId = iter->typeId();
+            for (j = 0; j < N; ++j) {
+               record.atomIds[j] = iter->atomId(j);
+            }
+            records.append(record);
+         }
+      }
+      int n = records.size();
+      std::sort(records.cArray(), records.cArray() + n,
+                IdLess< GroupRecord<N> >());
+      ids_.resize(n);
+      for (i = 0; i < n; ++i) {
+         ids_[i] = records[i].id;
+      }
+
+      MPI::Datatype groupType
+                      = MPI::BYTE.Create_contiguous(sizeof(GroupRecord<N>));
+      groupType.Commit();
+      writeRecords(file, begin, records.cArray(), groupType);
+      groupType.Free();
+   }
+
+   /*
+   * Write a configuration file collectively.
+   */
+   void DdMdParallelConfigIo::writeCollective(const std::string& filename)
+   {
+      MPI::Intracomm& comm = domain().communicator();
+      bool isMaster = domain().isMaster();
+
+      // Compute and broadcast numbers of atoms and groups
+      atomStorage().computeNAtomTotal(comm);
+      int nAtom = 0;
+      if (isMaster) {
+         nAtom = atomStorage().nAtomTotal();
+      }
+      bcast<int>(comm, nAtom, 0);
+      #ifdef SIMP_BOND
+      int nBond = 0;
+      if (bondStorage().capacity()) {
+         bondStorage().computeNTotal(comm);
+         if (isMaster) {
+            nBond = bondStorage().nTotal();
+         }
+      }
+      bcast<int>(comm, nBond, 0);
+      #endif
+      #ifdef SIMP_ANGLE
+      int nAngle = 0;
+      if (angleStorage().capacity()) {
+         angleStorage().computeNTotal(comm);
+         if (isMaster) {
+            nAngle = angleStorage().nTotal();
+         }
+      }
+      bcast<int>(comm, nAngle, 0);
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      int nDihedral = 0;
+      if (dihedralStorage().capacity()) {
+         dihedralStorage().computeNTotal(comm);
+         if (isMaster) {
+            nDihedral = dihedralStorage().nTotal();
+         }
+      }
+      bcast<int>(comm, nDihedral, 0);
+      #endif
+
+      int mode = MPI::MODE_WRONLY | MPI::MODE_CREATE;
+      MPI::File file = MPI::File::Open(comm, filename.c_str(), mode,
+                                       MPI::INFO_NULL);
+      file.Set_size(0);
+
+      // Header, written by the master. The boundary is identical on
+      // all processors, so all can compute the header size.
+      int headerSize = memorySize(nAtom) + memorySize(boundary());
+      #ifdef SIMP_BOND
+      headerSize += memorySize(nBond);
+      #endif
+      #ifdef SIMP_ANGLE
+      headerSize += memorySize(nAngle);
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      headerSize += memorySize(nDihedral);
+      #endif
+      if (isMaster) {
+         MemoryOArchive ar;
+         ar.allocate(headerSize);
+         ar << nAtom;
+         #ifdef SIMP_BOND
+         ar << nBond;
+         #endif
+         #ifdef SIMP_ANGLE
+         ar << nAngle;
+         #endif
+         #ifdef SIMP_DIHEDRAL
+         ar << nDihedral;
+         #endif
+         ar << boundary();
+         file.Write_at(0, ar.begin(), headerSize, MPI::BYTE);
+      }
+
+      // Pack and sort records for local atoms
+      bool isCartesian = atomStorage().isCartesian();
+      bool hasContext = Atom::hasAtomContext();
+      int n = atomStorage().nAtom();
+      atomRecords_.resize(n);
+      AtomIterator atomIter;
+      int i = 0;
+      for (atomStorage().begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         AtomRecord& record = atomRecords_[i];
+         if (atomIter->id() < 0 || atomIter->id() >= nAtom) {
+            UTIL_THROW("Atom ids must be 0,...,nAtom-1");
+         }
+         record.id = atomIter->id();
+         record.typeId = atomIter->typeId();
+         if (isCartesian) {
+            boundary().transformCartToGen(atomIter->position(),
+                                          record.position);
+         } else {
+            record.position = atomIter->position();
+         }
+         record.velocity = atomIter->velocity();
+         if (hasContext) {
+            record.speciesId = atomIter->context().speciesId;
+            record.moleculeId = atomIter->context().moleculeId;
+            record.atomId = atomIter->context().atomId;
+         } else {
+            record.speciesId = -1;
+            record.moleculeId = -1;
+            record.atomId = -1;
+         }
+         record.padding = 0;
+         ++i;
+      }
+      std::sort(atomRecords_.cArray(), atomRecords_.cArray() + n,
+                IdLess<AtomRecord>());
+      ids_.resize(n);
+      for (i = 0; i < n; ++i) {
+         ids_[i] = atomRecords_[i].id;
+      }
+
+      // Write atoms
+      MPI::Datatype atomType
+                    = MPI::BYTE.Create_contiguous(sizeof(AtomRecord));
+      atomType.Commit();
+      MPI::Offset begin = headerSize;
+      writeRecords(file, begin, atomRecords_.cArray(), atomType);
+      atomType.Free();
+      begin += (MPI::Offset)(sizeof(AtomRecord))*nAtom;
+
+      // Write covalent groups
+      #ifdef SIMP_BOND
+      if (nBond) {
+         writeGroups<2>(file, begin, nBond, bondStorage());
+      }
+      begin += (MPI::Offset)(sizeof(GroupRecord<2>))*nBond;
+      #endif
+      #ifdef SIMP_ANGLE
+      if (nAngle) {
+         writeGroups<3>(file, begin, nAngle, angleStorage());
+      }
+      begin += (MPI::Offset)(sizeof(GroupRecord<3>))*nAngle;
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      if (nDihedral) {
+         writeGroups<4>(file, begin, nDihedral, dihedralStorage());
+      }
+      #endif
+
+      file.Close();
+   }
+
+}
@@ -0,0 +1,251 @@
+#ifndef DDMD_DDMD_PARALLEL_CONFIG_IO_H
+#define DDMD_DDMD_PARALLEL_CONFIG_IO_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/configIos/ConfigIo.h>        // base class
+#include <util/containers/GArray.h>         // member
+#include <util/containers/DArray.h>         // member
+#include <util/space/Vector.h>              // member
+
+namespace DdMd
+{
+
+   class Simulation;
+
+   using namespace Util;
+
+   /**
+   * Binary configuration file format, read and written with MPI-IO.
+   *
+   * Files are read and written collectively by all processors, by the
+   * readCollective() and writeCollective() functions. No atom or group
+   * passes through the master processor, and no processor needs more
+   * memory than that required for its share of the atoms and groups.
+   *
+   * A file contains a header, followed by one section of fixed size
+   * records for atoms and for each type of covalent group. The header
+   * contains the total number of atoms, the number of bonds, angles
+   * and dihedrals (only for those types of group that are enabled at
+   * compile time), and the boundary, all in native binary format.
+   * Record i of each section describes the atom or group with id i,
+   * so that atom and group ids must be 0,...,n-1 for n atoms or groups.
+   * Atom records contain the id, type id, atom context (or -1 if the
+   * context is not enabled), position in generalized coordinates and
+   * velocity. Group records contain the id, type id and atom ids.
+   *
+   * On output, each processor writes the records of atoms it owns,
+   * and of groups for which it owns atom 0, with a single collective
+   * write for each section. On input, each processor reads a block of
+   * records in each section, sends each atom directly to its owner, and
+   * sends each group to every processor that owns one of its atoms.
+   *
+   * The stream based readConfig() and writeConfig() functions are not
+   * supported, and throw an Exception.
+   *
+   * \ingroup DdMd_ConfigIo_Module
+   */
+   class DdMdParallelConfigIo  : public ConfigIo
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      DdMdParallelConfigIo();
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object
+      */
+      DdMdParallelConfigIo(Simulation& simulation);
+
+      /**
+      * Not supported (throws an Exception).
+      *
+      * \param file input file stream
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual void readConfig(std::ifstream& file, MaskPolicy maskPolicy);
+
+      /**
+      * Not supported (throws an Exception).
+      *
+      * \param file output file stream
+      */
+      virtual void writeConfig(std::ofstream& file);
+
+      /**
+      * Return true: files are read and written collectively.
+      */
+      virtual bool isCollective() const;
+
+      /**
+      * Read a configuration file collectively.
+      *
+      * \pre  There are no atoms, ghosts, or groups.
+      * \pre  AtomStorage is set for scaled / generalized coordinates
+      *
+      * \post Atomic coordinates are scaled / generalized
+      * \post There are no ghosts
+      *
+      * \param filename full path of file, identical on all processors
+      * \param maskPolicy MaskPolicy to be used in setting atom masks
+      */
+      virtual
+      void readCollective(const std::string& filename, MaskPolicy maskPolicy);
+
+      /**
+      * Write a configuration file collectively.
+      *
+      * Atomic coordinates may be Cartesian or generalized on entry, and
+      * are not modified.
+      *
+      * \param filename full path of file, identical on all processors
+      */
+      virtual void writeCollective(const std::string& filename);
+
+   private:
+
+      /**
+      * Atom record, with the layout used in the file.
+      */
+      struct AtomRecord
+      {
+         Vector position;
+         Vector velocity;
+         int id;
+         int typeId;
+         int speciesId;
+         int moleculeId;
+         int atomId;
+         int padding;
+      };
+
+      /**
+      * Group record, with the layout used in the file.
+      */
+      template <int N>
+      struct GroupRecord
+      {
+         int id;
+         int typeId;
+         int atomIds[N];
+      };
+
+      /**
+      * Ordering of records by id.
+      */
+      template <typename Record>
+      struct IdLess
+      {
+         bool operator () (const Record& a, const Record& b) const
+         {  return (a.id < b.id); }
+      };
+
+      /// Atom records, read or written by this processor.
+      GArray<AtomRecord> atomRecords_;
+
+      /// Owner ranks of the atoms in the block read by this processor.
+      GArray<int> owners_;
+
+      /// Ids of records written by this processor, in increasing order.
+      GArray<int> ids_;
+
+      /// Number of records sent to each processor.
+      DArray<int> sendCounts_;
+
+      /// Offset of the first record sent to each processor.
+      DArray<int> sendDispls_;
+
+      /// Number of records received from each processor.
+      DArray<int> recvCounts_;
+
+      /// Offset of the first record received from each processor.
+      DArray<int> recvDispls_;
+
+      /// Id of the first atom in the block read by this processor.
+      int atomBegin_;
+
+      /// Id one past the last atom in the block read by this processor.
+      int atomEnd_;
+
+      /// Total number of atoms in the file being read.
+      int nAtom_;
+
+      /**
+      * Allocate count and displacement arrays, if not done previously.
+      */
+      void allocateCounts();
+
+      /**
+      * Rank of the processor that reads the record of an atom.
+      *
+      * \param atomId global atom id, 0 <= atomId < nAtom_
+      */
+      int atomBlockRank(int atomId) const;
+
+      /**
+      * Send records to other processors, with one all-to-all exchange.
+      *
+      * Element i*width + j of destinations is the rank to which record
+      * i should be sent, or -1 if none, for j = 0, ..., width - 1. 
+      *
+      * \param records records to be sent
+      * \param destinations ranks of destination processors
+      * \param width number of destinations per record
+      * \param recvRecords records received (output)
+      * \param recordType MPI datatype for one record
+      */
+      template <typename Record>
+      void exchangeRecords(GArray<Record>& records, 
+                           GArray<int>& destinations, int width,
+                           GArray<Record>& recvRecords,
+                           MPI::Datatype& recordType);
+
+      /**
+      * Write records with ids in ids_ to one section of the file.
+      *
+      * \param file open MPI file
+      * \param begin offset of the first record of the section, in bytes
+      * \param buffer records, in the same order as ids_
+      * \param recordType MPI datatype for one record
+      */
+      void writeRecords(MPI::File& file, MPI::Offset begin,
+                        const void* buffer, MPI::Datatype& recordType);
+
+      /**
+      * Read the groups of one type, and send each to its owners.
+      *
+      * \param file open MPI file
+      * \param begin offset of the first group record, in bytes
+      * \param nGroup number of groups in the file
+      * \param storage GroupStorage for groups of this type
+      */
+      template <int N>
+      void readGroups(MPI::File& file, MPI::Offset begin, int nGroup,
+                      GroupStorage<N>& storage);
+
+      /**
+      * Write the groups of one type.
+      *
+      * \param file open MPI file
+      * \param begin offset of the first group record, in bytes
+      * \param nGroup total number of groups of this type
+      * \param storage GroupStorage for groups of this type
+      */
+      template <int N>
+      void writeGroups(MPI::File& file, MPI::Offset begin, int nGroup,
+                       GroupStorage<N>& storage);
+
+   };
+
+}
+#endif
@@ -0,0 +1,341 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "BondConstraints.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/GroupStorage.h>
+#include <ddMd/storage/GroupIterator.h>
+#include <ddMd/communicate/Exchanger.h>
+#include <ddMd/communicate/Domain.h>
+#include <simp/boundary/Boundary.h>
+#include <util/param/Parameter.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+#include <cmath>
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   BondConstraints::BondConstraints(Simulation& simulation)
+    : SimulationAccess(simulation),
+      dt_(0.0),
+      tolerance_(1.0E-8),
+      maxIter_(100),
+      nConstraintType_(0),
+      nConstraintTotal_(0)
+   {
+      setClassName("BondConstraints");
+      stress_.zero();
+      shakeStress_.zero();
+   }
+
+   /*
+   * Destructor.
+   */
+   BondConstraints::~BondConstraints()
+   {}
+
+   /*
+   * Read constrained bond types and lengths.
+   */
+   void BondConstraints::readParameters(std::istream& in)
+   {
+      read<int>(in, "nConstraintType", nConstraintType_);
+      bondTypeIds_.allocate(nConstraintType_);
+      readDArray<int>(in, "bondTypeIds", bondTypeIds_, nConstraintType_);
+      bondLengths_.allocate(nConstraintType_);
+      readDArray<double>(in, "lengths", bondLengths_, nConstraintType_);
+      tolerance_ = 1.0E-8;
+      readOptional<double>(in, "tolerance", tolerance_);
+      maxIter_ = 100;
+      readOptional<int>(in, "maxIter", maxIter_);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void BondConstraints::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<int>(ar, "nConstraintType", nConstraintType_);
+      bondTypeIds_.allocate(nConstraintType_);
+      loadDArray<int>(ar, "bondTypeIds", bondTypeIds_, nConstraintType_);
+      bondLengths_.allocate(nConstraintType_);
+      loadDArray<double>(ar, "lengths", bondLengths_, nConstraintType_);
+      tolerance_ = 1.0E-8;
+      loadParameter<double>(ar, "tolerance", tolerance_, false);
+      maxIter_ = 100;
+      loadParameter<int>(ar, "maxIter", maxIter_, false);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void BondConstraints::save(Serializable::OArchive &ar)
+   {
+      ar << nConstraintType_;
+      ar << bondTypeIds_;
+      ar << bondLengths_;
+      Parameter::saveOptional(ar, tolerance_, true);
+      Parameter::saveOptional(ar, maxIter_, true);
+   }
+
+   /*
+   * Set time step, inverse masses and per-type lengths; count constraints.
+   */
+   void BondConstraints::setup(double dt)
+   {
+      dt_ = dt;
+
+      int nAtomType = simulation().nAtomType();
+      if (!inverseMasses_.isAllocated()) {
+         inverseMasses_.allocate(nAtomType);
+      }
+      int i;
+      for (i = 0; i < nAtomType; ++i) {
+         inverseMasses_[i] = 1.0/simulation().atomType(i).mass();
+      }
+
+      int nBondType = simulation().nBondType();
+      if (!lengths_.isAllocated()) {
+         lengths_.allocate(nBondType);
+      }
+      for (i = 0; i < nBondType; ++i) {
+         lengths_[i] = -1.0;
+      }
+      int typeId;
+      for (i = 0; i < nConstraintType_; ++i) {
+         typeId = bondTypeIds_[i];
+         if (typeId < 0 || typeId >= nBondType) {
+            UTIL_THROW("Invalid constrained bond type id");
+         }
+         if (bondLengths_[i] <= 0.0) {
+            UTIL_THROW("Constrained bond length must be positive");
+         }
+         lengths_[typeId] = bondLengths_[i];
+      }
+
+      // Count constraints, each once (on owner of atom 0)
+      GroupIterator<2> iter;
+      int nConstraint = 0;
+      bondStorage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         if (lengths_[iter->typeId()] > 0.0) {
+            if (!iter->atomPtr(0)->isGhost()) {
+               ++nConstraint;
+            }
+         }
+      }
+      #ifdef UTIL_MPI
+      domain().communicator().Allreduce(&nConstraint, &nConstraintTotal_, 
+                                        1, MPI::INT, MPI::SUM);
+      #else
+      nConstraintTotal_ = nConstraint;
+      #endif
+
+      stress_.zero();
+      shakeStress_.zero();
+   }
+
+   /*
+   * Store bond vectors of constrained bonds, before a position update.
+   */
+   void BondConstraints::saveReferences()
+   {
+      GroupIterator<2> iter;
+      Vector dr;
+      references_.clear();
+      bondStorage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         if (lengths_[iter->typeId()] > 0.0) {
+            boundary().distanceSq(iter->atomPtr(0)->position(), 
+                                  iter->atomPtr(1)->position(), dr);
+            references_.append(dr);
+         }
+      }
+   }
+
+   /*
+   * SHAKE iteration for positions.
+   *
+   * For each bond with current separation d = r0 - r1 and reference
+   * vector s, atom positions are shifted by +g*s/m0 and -g*s/m1, 
+   * with g chosen so that |d|^2 = L^2 to first order in g. Velocities
+   * are shifted by the same amounts divided by dt. The corresponding 
+   * constraint force on atom 0 is 2*g*s/dt^2, which acts at the 
+   * positions of the previous step.
+   */
+   void BondConstraints::constrainPositions(bool isStep)
+   {
+      GroupIterator<2> iter;
+      Vector dr, dp, f;
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      double length, lengthSq, rsq, w0, w1, g, sd, error, maxError;
+      int iIter, k, i, j;
+
+      shakeStress_.zero();
+      for (iIter = 0; iIter < maxIter_; ++iIter) {
+         exchanger().update();
+         maxError = 0.0;
+         k = 0;
+         bondStorage().begin(iter);
+         for ( ; iter.notEnd(); ++iter) {
+            length = lengths_[iter->typeId()];
+            if (length <= 0.0) continue;
+            atom0Ptr = iter->atomPtr(0);
+            atom1Ptr = iter->atomPtr(1);
+            lengthSq = length*length;
+            rsq = boundary().distanceSq(atom0Ptr->position(), 
+                                        atom1Ptr->position(), dr);
+            error = 0.5*std::fabs(rsq - lengthSq)/lengthSq;
+            if (error > maxError) maxError = error;
+            if (error > tolerance_) {
+               const Vector& s = references_[k];
+               w0 = inverseMasses_[atom0Ptr->typeId()];
+               w1 = inverseMasses_[atom1Ptr->typeId()];
+               sd = s.dot(dr);
+               if (sd < 0.1*lengthSq) {
+                  UTIL_THROW("Bond rotation too large for SHAKE");
+               }
+               g = (lengthSq - rsq)/(2.0*(w0 + w1)*sd);
+               dp.multiply(s, g*w0);
+               atom0Ptr->position() += dp;
+               dp.multiply(s, g*w1);
+               atom1Ptr->position() -= dp;
+               if (isStep) {
+                  dp.multiply(s, g*w0/dt_);
+                  atom0Ptr->velocity() += dp;
+                  dp.multiply(s, g*w1/dt_);
+                  atom1Ptr->velocity() -= dp;
+
+                  // Stress, with half weight for bonds shared with a ghost
+                  f.multiply(s, 2.0*g/(dt_*dt_));
+                  if (atom0Ptr->isGhost() || atom1Ptr->isGhost()) {
+                     f *= 0.5;
+                  }
+                  for (i = 0; i < Dimension; ++i) {
+                     for (j = 0; j < Dimension; ++j) {
+                        shakeStress_(i, j) += f[i]*s[j];
+                     }
+                  }
+               }
+            }
+            ++k;
+         }
+         if (maxAll(maxError) <= tolerance_) {
+            return;
+         }
+      }
+      UTIL_THROW("SHAKE failed to converge");
+   }
+
+   /*
+   * RATTLE iteration for velocities, and constraint stress.
+   *
+   * For each bond with separation d = r0 - r1, velocities are shifted
+   * by +k*d/m0 and -k*d/m1, with k chosen to remove the component of
+   * the relative velocity along d. The corresponding constraint force 
+   * on atom 0 is 2*k*d/dt. The stress is the average of the stresses
+   * of the velocity constraint forces and of the position constraint
+   * forces of the same step.
+   */
+   void BondConstraints::constrainVelocities()
+   {
+      GroupIterator<2> iter;
+      Tensor localStress;
+      Vector dr, dv, f;
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      double length, rsq, w0, w1, rv, k, error, maxError;
+      int iIter, i, j;
+      bool isLocal0, isLocal1;
+
+      localStress.zero();
+      for (iIter = 0; iIter < maxIter_; ++iIter) {
+         exchanger().updateVelocities();
+         maxError = 0.0;
+         bondStorage().begin(iter);
+         for ( ; iter.notEnd(); ++iter) {
+            length = lengths_[iter->typeId()];
+            if (length <= 0.0) continue;
+            atom0Ptr = iter->atomPtr(0);
+            atom1Ptr = iter->atomPtr(1);
+            rsq = boundary().distanceSq(atom0Ptr->position(), 
+                                        atom1Ptr->position(), dr);
+            dv.subtract(atom0Ptr->velocity(), atom1Ptr->velocity());
+            rv = dr.dot(dv);
+            error = std::fabs(rv)*dt_/rsq;
+            if (error > maxError) maxError = error;
+            if (error > tolerance_) {
+               w0 = inverseMasses_[atom0Ptr->typeId()];
+               w1 = inverseMasses_[atom1Ptr->typeId()];
+               k = -rv/((w0 + w1)*rsq);
+               dv.multiply(dr, k*w0);
+               atom0Ptr->velocity() += dv;
+               dv.multiply(dr, k*w1);
+               atom1Ptr->velocity() -= dv;
+
+               // Stress, with half weight for bonds shared with a ghost
+               f.multiply(dr, 2.0*k/dt_);
+               isLocal0 = !(atom0Ptr->isGhost());
+               isLocal1 = !(atom1Ptr->isGhost());
+               if (!(isLocal0 && isLocal1)) {
+                  f *= 0.5;
+               }
+               for (i = 0; i < Dimension; ++i) {
+                  for (j = 0; j < Dimension; ++j) {
+                     localStress(i, j) += f[i]*dr[j];
+                  }
+               }
+            }
+         }
+         if (maxAll(maxError) <= tolerance_) {
+            break;
+         }
+      }
+      if (iIter == maxIter_) {
+         UTIL_THROW("RATTLE failed to converge");
+      }
+
+      // Average with SHAKE stress, normalize by volume, sum on master
+      localStress += shakeStress_;
+      localStress /= 2.0*boundary().volume();
+      #ifdef UTIL_MPI
+      domain().communicator().Reduce(&localStress(0,0), &stress_(0,0), 
+                                     Dimension*Dimension, MPI::DOUBLE, 
+                                     MPI::SUM, 0);
+      if (!domain().isMaster()) {
+         stress_.zero();
+      }
+      #else
+      stress_ = localStress;
+      #endif
+   }
+
+   /*
+   * Return maximum of a value over all processors.
+   */
+   double BondConstraints::maxAll(double value)
+   {
+      #ifdef UTIL_MPI
+      double result;
+      domain().communicator().Allreduce(&value, &result, 1, 
+                                        MPI::DOUBLE, MPI::MAX);
+      return result;
+      #else
+      return value;
+      #endif
+   }
+
+}
@@ -0,0 +1,190 @@
+#ifndef DDMD_BOND_CONSTRAINTS_H
+#define DDMD_BOND_CONSTRAINTS_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>          // base class
+#include <ddMd/simulation/SimulationAccess.h>   // base class
+#include <util/containers/DArray.h>             // member
+#include <util/containers/GArray.h>             // member
+#include <util/space/Vector.h>                  // member template argument
+#include <util/space/Tensor.h>                  // member
+
+namespace DdMd
+{
+
+   class Simulation;
+   using namespace Util;
+
+   /**
+   * Fixed bond length constraints, imposed with SHAKE and RATTLE.
+   *
+   * Bonds of specified bond types are constrained to fixed lengths. 
+   * After the position update of a velocity-Verlet step, positions 
+   * (and the corresponding velocities) are corrected iteratively 
+   * along the bond vectors of the previous step (SHAKE). After the 
+   * final velocity update, velocity components along each bond are 
+   * removed (RATTLE). The constrained bonds must still have a bond 
+   * potential type, which normally should be given zero strength.
+   *
+   * Bonds that span domain boundaries are handled by both processors 
+   * that own one of their atoms. At the beginning of each iteration, 
+   * ghost positions (or velocities) are updated by the Exchanger, and 
+   * each processor then applies corrections to all of its bonds in
+   * sequence. Iteration stops when the largest relative error on any
+   * processor is less than the tolerance.
+   *
+   * The constraint contribution to the virial stress is the average of
+   * the position (SHAKE) and velocity (RATTLE) constraint stresses of 
+   * the most recent step. Each of these constraint forces acts during
+   * one half of the velocity-Verlet kick, so that their average is the
+   * mean constraint force over the step.
+   *
+   * \sa \ref ddMd_integrator_BondConstraints_page "param file format"
+   *
+   * \ingroup DdMd_Integrator_Module
+   */
+   class BondConstraints : public ParamComposite, public SimulationAccess
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation  parent Simulation
+      */
+      BondConstraints(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~BondConstraints();
+
+      /**
+      * Read constrained bond types, lengths, and tolerance.
+      *
+      * \param in input parameter stream
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Setup before the main loop.
+      *
+      * Sets the time step and inverse masses, and counts constraints.
+      * Must be called on all processors.
+      *
+      * \param dt  integrator time step
+      */
+      void setup(double dt);
+
+      /**
+      * Store current bond vectors. Call just before positions change.
+      */
+      void saveReferences();
+
+      /**
+      * Apply SHAKE to positions, and correct velocities accordingly.
+      *
+      * Must be called on all processors, after the position update and
+      * before the next exchange or update of ghosts. On return, ghost
+      * positions are undefined. If isStep is false, positions are 
+      * projected onto the constraints without changing velocities, and
+      * no constraint stress is recorded (use before the first step).
+      *
+      * \param isStep  true within a step, false for initial projection
+      */
+      void constrainPositions(bool isStep = true);
+
+      /**
+      * Apply RATTLE to velocities, and compute the constraint stress.
+      *
+      * Must be called on all processors, after the final velocity update.
+      * Ghost positions must be current.
+      */
+      void constrainVelocities();
+
+      /**
+      * Get constraint virial stress (only valid on master).
+      */
+      const Tensor& stress() const;
+
+      /**
+      * Get total number of constraints, on all processors.
+      */
+      int nConstraintTotal() const;
+
+   private:
+
+      /// Reference bond vectors, for constrained bonds in iteration order.
+      GArray<Vector> references_;
+
+      /// Constraint length for each bond type (negative if unconstrained).
+      DArray<double> lengths_;
+
+      /// Constrained bond type ids (parameter).
+      DArray<int> bondTypeIds_;
+
+      /// Constrained bond lengths (parameter).
+      DArray<double> bondLengths_;
+
+      /// Inverse masses, indexed by atom type.
+      DArray<double> inverseMasses_;
+
+      /// Constraint virial stress (sum on master).
+      Tensor stress_;
+
+      /// Local position constraint stress of the current step.
+      Tensor shakeStress_;
+
+      /// Time step.
+      double dt_;
+
+      /// Maximum relative error in bond lengths and velocities.
+      double tolerance_;
+
+      /// Maximum number of iterations.
+      int maxIter_;
+
+      /// Number of constrained bond types.
+      int nConstraintType_;
+
+      /// Total number of constrained bonds.
+      int nConstraintTotal_;
+
+      /*
+      * Return maximum of a value over all processors.
+      */
+      double maxAll(double value);
+
+   };
+
+   // Inline methods
+
+   inline const Tensor& BondConstraints::stress() const
+   {  return stress_; }
+
+   inline int BondConstraints::nConstraintTotal() const
+   {  return nConstraintTotal_; }
+
+}
+#endif
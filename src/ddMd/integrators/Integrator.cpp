@@ -11,6 +11,8 @@
 #include <ddMd/storage/AtomIterator.h>
 #include <ddMd/storage/GroupStorage.tpp>
 #include <ddMd/communicate/Exchanger.h>
+#include <ddMd/communicate/Buffer.h>
+#include <ddMd/communicate/Domain.h>
 #include <ddMd/analyzers/AnalyzerManager.h>
 #include <ddMd/potentials/pair/PairPotential.h>
 #ifdef SIMP_BOND
@@ -25,15 +27,25 @@
 #ifdef SIMP_EXTERNAL
 #include <ddMd/potentials/external/ExternalPotential.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
 
 #include <simp/ensembles/BoundaryEnsemble.h>
 
+#include <util/containers/FArray.h>
+#include <util/misc/FileMaster.h>
 #include <util/mpi/MpiLoader.h>
+#include <util/param/Parameter.h>
 #include <util/format/Dbl.h>
 #include <util/format/Int.h>
 #include <util/format/Bool.h>
+#include <util/misc/ioUtil.h>
 #include <util/global.h>
 
+#include <fstream>
+#include <iomanip>
+
 namespace DdMd
 {
 
@@ -42,6 +54,18 @@ namespace DdMd
    using namespace Util;
    using namespace Simp;
 
+   /*
+   * Names of TimeId intervals, used in statistics and trace output.
+   */
+   const char* const Integrator::timeNames_[Integrator::NTime] = 
+      {"Analyzers", "Integrate1", "Check", "AllReduce", 
+       "Transform (forward)", "Exchange", "Balance", "CellList", 
+       "Transform (reverse)", "PairList", "Update", "Zero Forces", 
+       "Pair Forces", "Bond Forces", "Angle Forces", "Dihedral Forces", 
+       "External Forces", "Coulomb Forces", "Integrate2", 
+       "Inner Integrate", "Inner Update", "Inner Forces", "Constraints",
+       "Modifiers", "Debug", "Signal", "Misc"};
+
    /*
    * Constructor.
    */
@@ -50,8 +74,20 @@ namespace DdMd
        timer_(Integrator::NTime),
        isSetup_(false),
        saveFileName_(),
-       saveInterval_(0)
-   {}
+       saveInterval_(0),
+       overlapUpdate_(false),
+       balanceInterval_(0),
+       pairForceTime_(0.0),
+       traceFileName_(),
+       traceBegin_(0),
+       traceNStep_(0)
+   {
+      for (int i = 0; i < NCount; ++i) {
+         for (int j = 0; j < 3; ++j) {
+            counts_(i, j) = 0.0;
+         }
+      }
+   }
 
    /*
    * Destructor.
@@ -75,6 +111,16 @@ namespace DdMd
          }
          read<std::string>(in, "saveFileName", saveFileName_);
       }
+      overlapUpdate_ = false;
+      readOptional<bool>(in, "overlapUpdate", overlapUpdate_);
+      balanceInterval_ = 0;
+      readOptional<int>(in, "balanceInterval", balanceInterval_);
+      traceNStep_ = 0;
+      readOptional<int>(in, "traceNStep", traceNStep_);
+      if (traceNStep_ > 0) {
+         read<int>(in, "traceBegin", traceBegin_);
+         read<std::string>(in, "traceFileName", traceFileName_);
+      }
    }
 
    /*
@@ -93,6 +139,16 @@ namespace DdMd
          }
          loadParameter<std::string>(ar, "saveFileName", saveFileName_);
       }
+      overlapUpdate_ = false;
+      loadParameter<bool>(ar, "overlapUpdate", overlapUpdate_, false);
+      balanceInterval_ = 0;
+      loadParameter<int>(ar, "balanceInterval", balanceInterval_, false);
+      traceNStep_ = 0;
+      loadParameter<int>(ar, "traceNStep", traceNStep_, false);
+      if (traceNStep_ > 0) {
+         loadParameter<int>(ar, "traceBegin", traceBegin_);
+         loadParameter<std::string>(ar, "traceFileName", traceFileName_);
+      }
 
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(iStep_);
@@ -108,6 +164,13 @@ namespace DdMd
       if (saveInterval_ > 0) {
          ar << saveFileName_;
       }
+      Parameter::saveOptional(ar, overlapUpdate_, overlapUpdate_);
+      Parameter::saveOptional(ar, balanceInterval_, (bool)balanceInterval_);
+      Parameter::saveOptional(ar, traceNStep_, (bool)traceNStep_);
+      if (traceNStep_ > 0) {
+         ar << traceBegin_;
+         ar << traceFileName_;
+      }
       ar << iStep_;
       ar << isSetup_;
    }
@@ -134,6 +197,9 @@ namespace DdMd
          simulation().computeForcesAndVirial();
       }
 
+      // Pair force time used by balanceDomains() is measured from here.
+      pairForceTime_ = timer_.time(PAIR_FORCE);
+
       // Postcondition - coordinates are Cartesian
       if (!atomStorage().isCartesian()) {
          UTIL_THROW("Atom coordinates are not Cartesian");
@@ -155,6 +221,47 @@ namespace DdMd
       timer_.stamp(ZERO_FORCE);
       pairPotential().computeForces();
       timer_.stamp(PAIR_FORCE);
+      computeOtherForces();
+   }
+
+   /*
+   * Zero forces and compute pair forces between local atoms, with timing.
+   */
+   void Integrator::computeLocalForces()
+   {
+      // Precondition
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are not Cartesian");
+      }
+
+      timer_.stamp(MISC);
+      simulation().zeroForces();
+      timer_.stamp(ZERO_FORCE);
+      pairPotential().computeLocalForces();
+      timer_.stamp(PAIR_FORCE);
+   }
+
+   /*
+   * Complete force calculation begun by computeLocalForces().
+   */
+   void Integrator::computeGhostForces()
+   {
+      // Precondition
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are not Cartesian");
+      }
+
+      timer_.stamp(MISC);
+      pairPotential().computeGhostForces();
+      timer_.stamp(PAIR_FORCE);
+      computeOtherForces();
+   }
+
+   /*
+   * Compute all forces other than pair forces, with timing (private).
+   */
+   void Integrator::computeOtherForces()
+   {
       #ifdef SIMP_BOND
       if (nBondType()) {
          bondPotential().computeForces();
@@ -179,6 +286,12 @@ namespace DdMd
          timer_.stamp(EXTERNAL_FORCE);
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb()) {
+         coulombPotential().computeForces();
+         timer_.stamp(COULOMB_FORCE);
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag()) {
@@ -228,6 +341,12 @@ namespace DdMd
          timer_.stamp(EXTERNAL_FORCE);
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb()) {
+         coulombPotential().computeForcesAndStress(domain().communicator());
+         timer_.stamp(COULOMB_FORCE);
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag()) {
@@ -238,6 +357,39 @@ namespace DdMd
       // simulation().forceSignal().notify();
    }
 
+   /*
+   * Shift domain boundaries to balance pair force time among processors.
+   */
+   void Integrator::balanceDomains()
+   {
+      // Precondition
+      if (atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are Cartesian");
+      }
+
+      // Load = pair force time on this processor since previous balance
+      double time = timer_.time(PAIR_FORCE);
+      double load = time - pairForceTime_;
+      if (load < 0.0) {
+         load = 0.0;
+      }
+      pairForceTime_ = time;
+
+      // Domains must remain at least as wide as the pair list cutoff.
+      // Atoms may have moved up to half the exchange skin beyond the
+      // boundaries of the domains that own them.
+      Vector minWidths;
+      Vector maxDisplacements;
+      double length;
+      for (int i = 0; i < Dimension; ++i) {
+         length = boundary().length(i);
+         minWidths[i] = pairPotential().cutoff()/length;
+         maxDisplacements[i] = 0.5*pairPotential().exchangeSkin()/length;
+      }
+      domain().balance(load, minWidths, maxDisplacements);
+      timer_.stamp(BALANCE);
+   }
+
    /*
    * Determine whether an atom exchange and reneighboring is needed.
    */
@@ -318,8 +470,41 @@ namespace DdMd
    */
    void Integrator::computeStatistics()
    {  
+      // Local values of per-processor counts
+      FArray<double, NCount> local;
+      local[N_ATOM] = double(atomStorage().nAtom());
+      local[N_GHOST] = double(atomStorage().nGhost());
+      local[N_PAIR] = double(pairPotential().pairList().nPair());
+      const Exchanger& exchanger = simulation().exchanger();
+      double nExchange = double(exchanger.exchangeCounter());
+      if (nExchange < 1.0) nExchange = 1.0;
+      local[ATOM_SEND] = double(exchanger.atomSendCounter())/nExchange;
+      local[GHOST_SEND] = double(exchanger.ghostSendCounter())/nExchange;
+      const Buffer& buffer = simulation().buffer();
+      double nSend = double(buffer.sendCounter());
+      if (nSend < 1.0) nSend = 1.0;
+      local[SEND_BYTES] = buffer.sendByteCounter()/nSend;
+
       #ifdef UTIL_MPI
       timer().reduce(domain().communicator());  
+
+      MPI::Intracomm& communicator = domain().communicator();
+      FArray<double, NCount> min, max, sum;
+      communicator.Allreduce(&local[0], &min[0], NCount, MPI::DOUBLE, MPI::MIN);
+      communicator.Allreduce(&local[0], &max[0], NCount, MPI::DOUBLE, MPI::MAX);
+      communicator.Allreduce(&local[0], &sum[0], NCount, MPI::DOUBLE, MPI::SUM);
+      double nProc = double(communicator.Get_size());
+      for (int i = 0; i < NCount; ++i) {
+         counts_(i, 0) = min[i];
+         counts_(i, 1) = max[i];
+         counts_(i, 2) = sum[i]/nProc;
+      }
+      #else
+      for (int i = 0; i < NCount; ++i) {
+         counts_(i, 0) = local[i];
+         counts_(i, 1) = local[i];
+         counts_(i, 2) = local[i];
+      }
       #endif
    }
 
@@ -400,6 +585,13 @@ namespace DdMd
           << "   "
           << Dbl(exchangeT*factor2, 12, 6)
           << "   " << Dbl(100.0*exchangeT/time, 12, 6, true) << std::endl;
+      double balanceT = timer().time(BALANCE);
+      totalT += balanceT;
+      out << "Balance              " 
+          << Dbl(balanceT*factor1, 12, 6)
+          << "   "
+          << Dbl(balanceT*factor2, 12, 6)
+          << "   " << Dbl(100.0*balanceT/time, 12, 6, true) << std::endl;
       double cellListT = timer().time(CELLLIST);
       totalT += cellListT;
       out << "CellList             " 
@@ -486,6 +678,55 @@ namespace DdMd
              << "   " << Dbl(100.0*externalForceT/time, 12 , 6, true) << std::endl;
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb()) {
+         double coulombForceT = timer().time(COULOMB_FORCE);
+         totalT += coulombForceT;
+         out << "Coulomb Forces       " 
+             << Dbl(coulombForceT*factor1, 12, 6) 
+             << "   "
+             << Dbl(coulombForceT*factor2, 12, 6)
+             << "   " << Dbl(100.0*coulombForceT/time, 12 , 6, true) << std::endl;
+      }
+      #endif
+      // Inner loop of a multiple time step integrator (if any)
+      double innerForceT = timer().time(INNER_FORCE);
+      if (innerForceT > 0.0) {
+         double innerIntegrateT = timer().time(INNER_INTEGRATE);
+         totalT += innerIntegrateT;
+         out << "Inner Integrate      " 
+             << Dbl(innerIntegrateT*factor1, 12, 6) 
+             << "   "
+             << Dbl(innerIntegrateT*factor2, 12, 6)
+             << "   " << Dbl(100.0*innerIntegrateT/time, 12 , 6, true) 
+             << std::endl;
+         double innerUpdateT = timer().time(INNER_UPDATE);
+         totalT += innerUpdateT;
+         out << "Inner Update         " 
+             << Dbl(innerUpdateT*factor1, 12, 6) 
+             << "   "
+             << Dbl(innerUpdateT*factor2, 12, 6)
+             << "   " << Dbl(100.0*innerUpdateT/time, 12 , 6, true) 
+             << std::endl;
+         totalT += innerForceT;
+         out << "Inner Forces         " 
+             << Dbl(innerForceT*factor1, 12, 6) 
+             << "   "
+             << Dbl(innerForceT*factor2, 12, 6)
+             << "   " << Dbl(100.0*innerForceT/time, 12 , 6, true) 
+             << std::endl;
+      }
+      // Bond constraints (if any)
+      double constrainT = timer().time(CONSTRAIN);
+      if (constrainT > 0.0) {
+         totalT += constrainT;
+         out << "Constraints          " 
+             << Dbl(constrainT*factor1, 12, 6) 
+             << "   "
+             << Dbl(constrainT*factor2, 12, 6)
+             << "   " << Dbl(100.0*constrainT/time, 12 , 6, true) 
+             << std::endl;
+      }
       double integrate2T = timer().time(INTEGRATE2);
       totalT += integrate2T;
       out << "Integrate2           " 
@@ -511,6 +752,50 @@ namespace DdMd
       #endif
       out << std::endl;
 
+      #ifdef UTIL_MPI
+      // Output range of times over processors, for nonzero intervals
+      out << "Load balance: time per step (T/M) on each processor" 
+          << std::endl << std::endl;
+      out << "                     " 
+          << "     min [sec]  "
+          << "     max [sec]  "
+          << "    mean [sec]  "
+          << "    max/mean" << std::endl;
+      double maxT, meanT;
+      for (int i = 0; i < NTime; ++i) {
+         maxT = timer().maxTime(i);
+         if (maxT > 0.0) {
+            meanT = timer().time(i);
+            out << std::left << std::setw(21) << timeNames_[i] 
+                << std::right
+                << Dbl(timer().minTime(i)*factor1, 14, 6) << "  "
+                << Dbl(maxT*factor1, 14, 6) << "  "
+                << Dbl(meanT*factor1, 14, 6) << "  "
+                << Dbl(maxT/meanT, 12, 4) << std::endl;
+         }
+      }
+      out << std::endl;
+      #endif
+
+      // Output range of per-processor counts
+      out << "Per-processor counts" << std::endl << std::endl;
+      out << "                     " 
+          << "           min  "
+          << "           max  "
+          << "          mean" << std::endl;
+      const char* countNames[NCount] = {"atoms", "ghosts", "pairs",
+                                        "atoms sent/exchange",
+                                        "ghosts sent/exchange",
+                                        "bytes/message"};
+      for (int i = 0; i < NCount; ++i) {
+         out << std::left << std::setw(21) << countNames[i] 
+             << std::right
+             << Dbl(counts_(i, 0), 14, 6) << "  "
+             << Dbl(counts_(i, 1), 14, 6) << "  "
+             << Dbl(counts_(i, 2), 14, 6) << std::endl;
+      }
+      out << std::endl;
+
       // Output info about timer resolution
       double tick = MPI::Wtick();
       out << "Timer resolution     " 
@@ -529,6 +814,12 @@ namespace DdMd
       out << "steps per build      "
                   << Dbl(double(iStep_)/double(buildCounter), 12, 6)
                   << std::endl;
+      if (pairPotential().isIncremental()) {
+         int updateCounter = pairPotential().pairList().updateCounter(); 
+         out << "updateCounter        " 
+                     << Int(updateCounter, 12)
+                     << std::endl;
+      }
       out << std::endl;
 
    }
@@ -542,6 +833,7 @@ namespace DdMd
       initDynamicalState();
       timer().clear(); 
       simulation().exchanger().timer().clear();
+      simulation().exchanger().clearStatistics();
       simulation().buffer().clearStatistics();
       atomStorage().clearStatistics();
       pairPotential().pairList().clearStatistics();
@@ -557,4 +849,40 @@ namespace DdMd
       simulation().analyzerManager().clear();
    }
 
+   /*
+   * Begin, mark or end a timeline trace (called only if traceNStep > 0).
+   */
+   void Integrator::updateTrace()
+   {
+      if (iStep_ >= traceBegin_ && iStep_ < traceBegin_ + traceNStep_) {
+         if (!timer_.isTracing()) {
+            timer_.beginTrace();
+         }
+         timer_.markStep(iStep_);
+      } else 
+      if (timer_.isTracing()) {
+         finishTrace();
+         timer_.stamp(MISC);
+      }
+   }
+
+   /*
+   * End trace and write it to file traceFileName.rank.json, if tracing.
+   */
+   void Integrator::finishTrace()
+   {
+      if (!timer_.isTracing()) return;
+      timer_.endTrace();
+
+      int rank = domain().gridRank();
+      std::string filename = traceFileName_;
+      filename += ".";
+      filename += toString(rank);
+      filename += ".json";
+      std::ofstream file;
+      simulation().fileMaster().openOutputFile(filename, file);
+      timer_.writeTrace(file, timeNames_, rank);
+      file.close();
+   }
+
 }
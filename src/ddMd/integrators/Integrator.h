@@ -4,6 +4,8 @@
 #include <util/param/ParamComposite.h>          // base class
 #include <ddMd/simulation/SimulationAccess.h>   // base class
 #include <ddMd/misc/DdTimer.h>                  // member
+#include <util/space/Tensor.h>                  // argument
+#include <util/containers/FMatrix.h>            // member
 
 #include <iostream>
 
@@ -42,7 +44,7 @@ namespace DdMd
       ~Integrator();
 
       /**
-      * Read saveInterval and saveFileName.
+      * Read saveInterval, saveFileName and optional parameters.
       *
       * \param in input parameter stream
       */   
@@ -90,7 +92,10 @@ namespace DdMd
       * On return, the value of each of the time intervals stored by the
       * internal DdMd::Timer is replaced by its average over all processors.
       * It does not reset the timer to zero, and may thus be called more 
-      * than once while contining to accumulate statistics.
+      * than once while contining to accumulate statistics. It also computes
+      * the minimum, maximum and average over processors of the number of
+      * atoms, ghosts and pairs, of the numbers of atoms and ghosts sent 
+      * per exchange, and of the number of bytes per Buffer message.
       */
       void computeStatistics();
 
@@ -103,6 +108,15 @@ namespace DdMd
       */
       virtual void outputStatistics(std::ostream& out);
 
+      /**
+      * Add virial stress of constraint forces, if any.
+      *
+      * Default implementation does nothing. Call only on master.
+      *
+      * \param stress  virial stress (incremented)
+      */
+      virtual void addConstraintStress(Tensor& stress) const;
+
       /**
       * Get average time per processor of previous run.
       */
@@ -117,9 +131,10 @@ namespace DdMd
 
       /// Timestamps for loop timing.
       enum TimeId {ANALYZER, INTEGRATE1, CHECK, ALLREDUCE, TRANSFORM_F, 
-                   EXCHANGE, CELLLIST, TRANSFORM_R, PAIRLIST, UPDATE, 
+                   EXCHANGE, BALANCE, CELLLIST, TRANSFORM_R, PAIRLIST, UPDATE, 
                    ZERO_FORCE, PAIR_FORCE, BOND_FORCE, ANGLE_FORCE, 
-                   DIHEDRAL_FORCE, EXTERNAL_FORCE, INTEGRATE2, 
+                   DIHEDRAL_FORCE, EXTERNAL_FORCE, COULOMB_FORCE, INTEGRATE2, 
+                   INNER_INTEGRATE, INNER_UPDATE, INNER_FORCE, CONSTRAIN,
                    MODIFIER, DEBUG, SIGNAL, MISC, NTime};
 
       /**
@@ -170,6 +185,25 @@ namespace DdMd
       */
       void computeForces();
 
+      /**
+      * Zero forces and compute pair forces between local atoms, with timing.
+      *
+      * This is the first stage of a force calculation that may overlap
+      * with a non-blocking update of ghost positions. It uses only the
+      * positions of local atoms. Calling computeLocalForces() and then
+      * computeGhostForces() is equivalent to calling computeForces().
+      */
+      void computeLocalForces();
+
+      /**
+      * Complete a force calculation begun by computeLocalForces().
+      *
+      * Computes pair forces that involve ghosts and all bonded and 
+      * external forces, and executes reverse communication if needed.
+      * Ghost positions must be current.
+      */
+      void computeGhostForces();
+
       /**
       * Compute forces for all local atoms and virial, with timing.
       *
@@ -188,6 +222,34 @@ namespace DdMd
       */
       bool isExchangeNeeded(double skin);
 
+      /**
+      * Shift domain boundaries to balance pair force time, with timing.
+      *
+      * Calls Domain::balance() with a load equal to the pair force time
+      * on this processor since the previous call, or since setupAtoms().
+      * Must be called on all processors, when atomic coordinates are
+      * generalized, just before an atom exchange.
+      */
+      void balanceDomains();
+
+      /**
+      * Begin, mark or end a timeline trace, if one is requested.
+      *
+      * Should be called at the beginning of every step of the main loop,
+      * before any timer stamp. Does nothing unless traceNStep > 0. The
+      * timer records a trace during steps traceBegin <= iStep <
+      * traceBegin + traceNStep, and the trace is written when the 
+      * window closes.
+      */
+      void traceStep();
+
+      /**
+      * End and write a timeline trace, if one is being recorded.
+      *
+      * Should be called after the main loop of run().
+      */
+      void finishTrace();
+
       /**
       * Get restart file base name. 
       */
@@ -198,6 +260,16 @@ namespace DdMd
       */
       int saveInterval() const;
 
+      /**
+      * Should ghost communication overlap with local force calculation?
+      */
+      bool overlapUpdate() const;
+
+      /**
+      * Get interval (# steps) between load balancing (0 if disabled).
+      */
+      int balanceInterval() const;
+
       /*
       * Return the timer by reference.
       */
@@ -220,6 +292,44 @@ namespace DdMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Overlap ghost position updates with local pair forces?
+      bool overlapUpdate_;
+
+      /// Interval (# steps) between domain load balancing (0 if disabled)
+      int balanceInterval_;
+
+      /// Value of pair force timer at previous load balance 
+      double pairForceTime_;
+
+      /// Base name of timeline trace files (one per processor)
+      std::string traceFileName_;
+
+      /// Index of first step of timeline trace
+      int traceBegin_;
+
+      /// Number of steps in timeline trace (no trace if 0)
+      int traceNStep_;
+
+      /// Identifiers for per-processor counts.
+      enum CountId {N_ATOM, N_GHOST, N_PAIR, ATOM_SEND, GHOST_SEND, 
+                    SEND_BYTES, NCount};
+
+      /// Minimum, maximum and average of counts, set by computeStatistics.
+      FMatrix<double, NCount, 3> counts_;
+
+      /// Names of TimeId intervals, in enumeration order.
+      static const char* const timeNames_[NTime];
+
+      /**
+      * Begin, mark or end a trace (called by traceStep).
+      */
+      void updateTrace();
+
+      /**
+      * Compute bonded and external forces, and reverse communicate.
+      */
+      void computeOtherForces();
+
    };
 
    /*
@@ -247,6 +357,22 @@ namespace DdMd
    */
    inline void Integrator::initDynamicalState(){}
 
+   /*
+   * Add constraint stress (none by default).
+   */
+   inline void Integrator::addConstraintStress(Tensor& stress) const
+   {}
+
+   /*
+   * Update timeline trace, if any.
+   */
+   inline void Integrator::traceStep()
+   {
+      if (traceNStep_ > 0) {
+         updateTrace();
+      }
+   }
+
    /*
    * Return the timer by reference.
    */
@@ -260,7 +386,19 @@ namespace DdMd
    { return saveFileName_; }
 
    /*
-   * Get interval for writing a restart file.
+   * Should ghost communication overlap with local force calculation?
+   */
+   inline bool Integrator::overlapUpdate() const
+   {  return overlapUpdate_; }
+
+   /*
+   * Get interval between domain load balancing.
+   */
+   inline int Integrator::balanceInterval() const
+   {  return balanceInterval_; }
+
+   /*
+   * Get interval for writing restart files.
    */
    inline int Integrator::saveInterval() const
    { return saveInterval_; }
@@ -40,6 +40,7 @@ namespace DdMd
    {
       read<double>(in, "dt", dt_);
       Integrator::readParameters(in);
+      readConstraints(in);
 
       int nAtomType = simulation().nAtomType();
       if (!prefactors_.isAllocated()) {
@@ -54,6 +55,7 @@ namespace DdMd
    {
       loadParameter<double>(ar, "dt", dt_);
       Integrator::loadParameters(ar);
+      loadConstraints(ar);
 
       int nAtomType = simulation().nAtomType();
       if (!prefactors_.isAllocated()) {
@@ -69,6 +71,7 @@ namespace DdMd
    {
       ar << dt_;
       Integrator::save(ar);
+      saveConstraints(ar);
    }
  
    /*
@@ -85,6 +88,7 @@ namespace DdMd
 
       // Exchange atoms, build pair list, compute forces.
       setupAtoms();
+      setupConstraints(dt_);
 
       // Set prefactors for acceleration
       double dtHalf = 0.5*dt_;
@@ -106,6 +110,8 @@ namespace DdMd
       double prefactor; // = 0.5*dt/mass
       AtomIterator atomIter;
 
+      saveConstraintReferences();
+
       // 1st half of velocity Verlet.
       atomStorage().begin(atomIter);
       for ( ; atomIter.notEnd(); ++atomIter) {
@@ -117,6 +123,8 @@ namespace DdMd
          dr.multiply(atomIter->velocity(), dt_);
          atomIter->position() += dr;
       }
+
+      constrainPositions();
    }
 
    /*
@@ -136,6 +144,8 @@ namespace DdMd
          atomIter->velocity() += dv;
       }
 
+      constrainVelocities();
+
       // Notify observers of change in velocity
       simulation().velocitySignal().notify();
    }
@@ -63,6 +63,7 @@ namespace DdMd
       read<double>(in, "dt",   dt_);
       read<double>(in, "tauT", tauT_);
       Integrator::readParameters(in);
+      readConstraints(in);
 
       nuT_ = 1.0/tauT_;
       int nAtomType = simulation().nAtomType();
@@ -83,6 +84,7 @@ namespace DdMd
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(nuT_);
       loader.load(xi_);
+      loadConstraints(ar);
 
       int nAtomType = simulation().nAtomType();
       if (!prefactors_.isAllocated()) {
@@ -100,6 +102,7 @@ namespace DdMd
       Integrator::save(ar);
       ar << nuT_;
       ar << xi_;
+      saveConstraints(ar);
    }
 
    /*
@@ -123,6 +126,7 @@ namespace DdMd
 
       // Exchange atoms, build pair list, compute forces.
       setupAtoms();
+      setupConstraints(dt_);
 
       // Calculate prefactors for acceleration
       double dtHalf = 0.5*dt_;
@@ -141,7 +145,7 @@ namespace DdMd
       if (domain().isMaster()) {
          T_target_ = simulation().energyEnsemble().temperature();
          nAtom_  = atomStorage().nAtomTotal();
-         T_kinetic_ = simulation().kineticEnergy()*2.0/double(3*nAtom_);
+         T_kinetic_ = simulation().kineticEnergy()*2.0/double(3*nAtom_ - nConstraint());
          xiDot_ = (T_kinetic_/T_target_ -1.0)*nuT_*nuT_;
       }
       #ifdef UTIL_MPI
@@ -163,6 +167,8 @@ namespace DdMd
       T_target_ = simulation().energyEnsemble().temperature();
       factor = exp(-dtHalf*(xi_ + xiDot_*dtHalf));
 
+      saveConstraintReferences();
+
       // 1st half of velocity Verlet.
       atomStorage().begin(atomIter);
       for ( ; atomIter.notEnd(); ++atomIter) {
@@ -173,6 +179,8 @@ namespace DdMd
          dr.multiply(atomIter->velocity(), dt_);
          atomIter->position() += dr;
       }
+
+      constrainPositions();
    }
 
    void NvtIntegrator::integrateStep2()
@@ -195,6 +203,8 @@ namespace DdMd
          atomIter->velocity() *=factor;
       }
 
+      constrainVelocities();
+
       // Notify observers of change in velocity
       simulation().velocitySignal().notify();
 
@@ -202,7 +212,7 @@ namespace DdMd
       simulation().computeKineticEnergy();
       if (domain().isMaster()) {
          xi_ += xiDot_*dtHalf;
-         T_kinetic_ = simulation().kineticEnergy()*2.0/double(3*nAtom_);
+         T_kinetic_ = simulation().kineticEnergy()*2.0/double(3*nAtom_ - nConstraint());
          xiDot_ = (T_kinetic_/T_target_  - 1.0)*nuT_*nuT_;
          xi_ += xiDot_*dtHalf;
       }
@@ -0,0 +1,316 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RespaIntegrator.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/communicate/Exchanger.h>
+#include <ddMd/potentials/pair/PairPotential.h>
+#ifdef SIMP_BOND
+#include <ddMd/potentials/bond/BondPotential.h>
+#endif
+#ifdef SIMP_ANGLE
+#include <ddMd/potentials/angle/AnglePotential.h>
+#endif
+#ifdef SIMP_DIHEDRAL
+#include <ddMd/potentials/dihedral/DihedralPotential.h>
+#endif
+#ifdef SIMP_EXTERNAL
+#include <ddMd/potentials/external/ExternalPotential.h>
+#endif
+#ifdef SIMP_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
+#include <simp/ensembles/BoundaryEnsemble.h>
+#include <util/global.h>
+
+#include <iostream>
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   RespaIntegrator::RespaIntegrator(Simulation& simulation)
+    : TwoStepIntegrator(simulation),
+      dt_(0.0),
+      nInnerStep_(1)
+   {  setClassName("RespaIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   RespaIntegrator::~RespaIntegrator()
+   {}
+
+   /*
+   * Read time step dt and number of inner steps.
+   */
+   void RespaIntegrator::readParameters(std::istream& in)
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nInnerStep", nInnerStep_);
+      if (nInnerStep_ < 1) {
+         UTIL_THROW("nInnerStep must be positive");
+      }
+      Integrator::readParameters(in);
+
+      int nAtomType = simulation().nAtomType();
+      if (!prefactors_.isAllocated()) {
+         prefactors_.allocate(nAtomType);
+      }
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void RespaIntegrator::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nInnerStep", nInnerStep_);
+      Integrator::loadParameters(ar);
+
+      int nAtomType = simulation().nAtomType();
+      if (!prefactors_.isAllocated()) {
+         prefactors_.allocate(nAtomType);
+      }
+      //  Note: Values of prefactors_ calculated in setup()
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void RespaIntegrator::save(Serializable::OArchive &ar)
+   {
+      ar << dt_;
+      ar << nInnerStep_;
+      Integrator::save(ar);
+   }
+
+   /*
+   * Check that the boundary ensemble is rigid, and that ghost updates
+   * are not overlapped with pair force calculations.
+   */
+   void RespaIntegrator::checkEnsemble()
+   {
+      if (!simulation().boundaryEnsemble().isRigid()) {
+         UTIL_THROW("RespaIntegrator requires a rigid boundary ensemble");
+      }
+      if (overlapUpdate()) {
+         UTIL_THROW("RespaIntegrator does not support overlapUpdate");
+      }
+   }
+ 
+   /*
+   * Setup at beginning of run, before entering main loop.
+   */ 
+   void RespaIntegrator::setup()
+   {
+      checkEnsemble();
+
+      // Initialize state and clear statistics on first usage.
+      if (!isSetup()) {
+         clear();
+         setIsSetup();
+      }
+
+      // Exchange atoms, build pair list, compute total forces.
+      setupAtoms();
+
+      // Set inverse masses
+      int nAtomType = prefactors_.capacity();
+      for (int i = 0; i < nAtomType; ++i) {
+         prefactors_[i] = 1.0/simulation().atomType(i).mass();
+      }
+
+      // Compute slow forces as total minus fast forces (without timing).
+      if (!slowForces_.isAllocated()) {
+         slowForces_.allocate(atomStorage().atomCapacity());
+      }
+      AtomIterator atomIter;
+      int i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         slowForces_[i] = atomIter->force();
+         ++i;
+      }
+      computeFastForces();
+      i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         slowForces_[i] -= atomIter->force();
+         atomIter->force() += slowForces_[i];
+         ++i;
+      }
+   }
+
+   /*
+   * Zero forces and compute fast (bonded) forces, without timing.
+   */
+   void RespaIntegrator::computeFastForces()
+   {
+      simulation().zeroForces();
+      #ifdef SIMP_BOND
+      if (nBondType()) {
+         bondPotential().computeForces();
+      }
+      #endif
+      #ifdef SIMP_ANGLE
+      if (nAngleType()) {
+         anglePotential().computeForces();
+      }
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      if (nDihedralType()) {
+         dihedralPotential().computeForces();
+      }
+      #endif
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+   }
+
+   /*
+   * Compute slow forces, with timing.
+   *
+   * On return, Atom::force() contains only the slow forces. Modifiers
+   * may add further forces before integrateStep2() stores them.
+   */
+   void RespaIntegrator::computeStepForces(bool isOverlapped)
+   {
+      // Precondition
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are not Cartesian");
+      }
+
+      timer().stamp(MISC);
+      simulation().zeroForces();
+      timer().stamp(ZERO_FORCE);
+      pairPotential().computeForces();
+      timer().stamp(PAIR_FORCE);
+      #ifdef SIMP_EXTERNAL
+      if (hasExternal()) {
+         externalPotential().computeForces();
+         timer().stamp(EXTERNAL_FORCE);
+      }
+      #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb()) {
+         coulombPotential().computeForces();
+         timer().stamp(COULOMB_FORCE);
+      }
+      #endif
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+      timer().stamp(MISC);
+   }
+
+   /*
+   * Outer half step and inner steps.
+   *
+   * The velocity is first updated by dt/2 times the slow acceleration 
+   * and h/2 times the fast acceleration, with h = dt/nInnerStep. This 
+   * is followed by nInnerStep drifts of length h, separated by fast 
+   * force calculations and velocity updates of h times the fast 
+   * acceleration (two consecutive inner half steps).
+   */
+   void RespaIntegrator::integrateStep1()
+   {
+      Vector dv;
+      Vector dr;
+      double h = dt_/double(nInnerStep_);
+      double fastFactor = 0.5*h;
+      double slowFactor = 0.5*(dt_ - h);
+      double prefactor;
+      AtomIterator atomIter;
+      int i;
+
+      // Outer half step velocity update and first drift
+      i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         prefactor = prefactors_[atomIter->typeId()];
+         dv.multiply(atomIter->force(), fastFactor*prefactor);
+         atomIter->velocity() += dv;
+         dv.multiply(slowForces_[i], slowFactor*prefactor);
+         atomIter->velocity() += dv;
+         dr.multiply(atomIter->velocity(), h);
+         atomIter->position() += dr;
+         ++i;
+      }
+      timer().stamp(INTEGRATE1);
+
+      // Remaining inner steps
+      for (int j = 1; j < nInnerStep_; ++j) {
+         simulation().modifySignal().notify();
+         exchanger().update();
+         timer().stamp(INNER_UPDATE);
+         computeFastForces();
+         timer().stamp(INNER_FORCE);
+         atomStorage().begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            prefactor = prefactors_[atomIter->typeId()];
+            dv.multiply(atomIter->force(), h*prefactor);
+            atomIter->velocity() += dv;
+            dr.multiply(atomIter->velocity(), h);
+            atomIter->position() += dr;
+         }
+         timer().stamp(INNER_INTEGRATE);
+      }
+   }
+
+   /*
+   * Store slow forces, compute fast forces, and apply the final inner
+   * and outer half step velocity update.
+   *
+   * On return, Atom::force() is the total force and slowForces_ 
+   * holds the slow part, including any forces added by modifiers.
+   */
+   void RespaIntegrator::integrateStep2()
+   {
+      if (atomStorage().nAtom() > slowForces_.capacity()) {
+         UTIL_THROW("Number of local atoms exceeds slowForces_ capacity");
+      }
+      AtomIterator atomIter;
+      int i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         slowForces_[i] = atomIter->force();
+         ++i;
+      }
+      timer().stamp(INTEGRATE2);
+      computeFastForces();
+      timer().stamp(INNER_FORCE);
+
+      Vector dv;
+      double h = dt_/double(nInnerStep_);
+      double fastFactor = 0.5*h;
+      double slowFactor = 0.5*(dt_ - h);
+      double prefactor;
+      i = 0;
+      atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         atomIter->force() += slowForces_[i];
+         prefactor = prefactors_[atomIter->typeId()];
+         dv.multiply(atomIter->force(), fastFactor*prefactor);
+         atomIter->velocity() += dv;
+         dv.multiply(slowForces_[i], slowFactor*prefactor);
+         atomIter->velocity() += dv;
+         ++i;
+      }
+
+      // Notify observers of change in velocity
+      simulation().velocitySignal().notify();
+   }
+
+}
@@ -0,0 +1,137 @@
+#ifndef DDMD_RESPA_INTEGRATOR_H
+#define DDMD_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TwoStepIntegrator.h"          // base class
+#include <util/containers/DArray.h>     // member
+#include <util/space/Vector.h>          // member template argument
+
+namespace DdMd
+{
+
+   class Simulation;
+   using namespace Util;
+
+   /**
+   * A multiple time step (r-RESPA) constant energy integrator.
+   *
+   * Forces are split into fast bonded forces (bond, angle and dihedral)
+   * and slow nonbonded forces (pair, external and Coulomb). Each outer
+   * step of length dt contains nInnerStep velocity-Verlet steps of 
+   * length dt/nInnerStep that use only the fast forces, preceded and 
+   * followed by half-step velocity updates that use the slow forces.
+   * Slow forces are thus computed once per outer step, and the pair
+   * list, atom exchange and ghost identification are handled at outer 
+   * steps by the main loop of TwoStepIntegrator. Ghost positions are
+   * updated before each inner force calculation.
+   *
+   * Forces added by modifiers in ModifierManager::postForce() are
+   * treated as slow forces: the slow forces are stored after the 
+   * modifiers have acted, at the beginning of integrateStep2(), and
+   * the fast forces are computed only then. Between steps, 
+   * Atom::force() contains the total force on each atom, so analyzers
+   * see the same forces as with other integrators. Only rigid boundary
+   * (constant volume) ensembles are supported.
+   *
+   * \sa \ref ddMd_integrator_RespaIntegrator_page "param file format"
+   *
+   * \ingroup DdMd_Integrator_Module
+   */
+   class RespaIntegrator : public TwoStepIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      RespaIntegrator(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~RespaIntegrator();
+
+      /**
+      * Read required parameters.
+      *
+      * Reads the outer time step dt and the number nInnerStep of 
+      * inner steps per outer step.
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+   protected:
+
+      /**
+      * Setup state just before main loop.
+      *
+      * Calls Integrator::setupAtoms(), initializes prefactors_ array, 
+      * and computes the separate slow and fast forces.
+      */
+      void setup();
+
+      /**
+      * Outer half step velocity update, drift and inner steps.
+      */
+      virtual void integrateStep1();
+
+      /**
+      * Compute slow (nonbonded) forces, leaving them in Atom::force().
+      *
+      * \param isOverlapped unused (overlapUpdate is not supported)
+      */
+      virtual void computeStepForces(bool isOverlapped);
+
+      /**
+      * Store slow forces, compute fast forces and finish the outer step.
+      */
+      virtual void integrateStep2();
+
+   private:
+
+      /// Slow force on each local atom, in AtomIterator order.
+      DArray<Vector> slowForces_;
+
+      /// Inverse masses, indexed by atom type.
+      DArray<double> prefactors_;      
+
+      /// Outer time step.
+      double  dt_;
+
+      /// Number of inner steps per outer step.
+      int  nInnerStep_;
+  
+      /*
+      * Zero forces and compute fast (bonded) forces.
+      */
+      void computeFastForces();
+
+      /*
+      * Check preconditions for integration.
+      */
+      void checkEnsemble();
+
+   };
+
+}
+#endif
@@ -16,6 +16,8 @@
 #include <ddMd/potentials/pair/PairPotential.h>
 #include <simp/ensembles/BoundaryEnsemble.h>
 #include <util/misc/Log.h>
+#include <util/param/Parameter.h>
+#include <util/space/Tensor.h>
 #include <util/global.h>
 
 // Uncomment to enable paranoid validity checks.
@@ -31,7 +33,11 @@ namespace DdMd
    * Constructor.
    */
    TwoStepIntegrator::TwoStepIntegrator(Simulation& simulation)
-    : Integrator(simulation)
+    : Integrator(simulation),
+      #ifdef SIMP_BOND
+      constraints_(simulation),
+      #endif
+      hasConstraints_(false)
    {}
 
    /*
@@ -40,6 +46,159 @@ namespace DdMd
    TwoStepIntegrator::~TwoStepIntegrator()
    {}
 
+   /*
+   * Read optional bond constraints.
+   */
+   void TwoStepIntegrator::readConstraints(std::istream& in)
+   {
+      hasConstraints_ = false;
+      readOptional<bool>(in, "hasConstraints", hasConstraints_);
+      if (hasConstraints_) {
+         #ifdef SIMP_BOND
+         readParamComposite(in, constraints_);
+         #else
+         UTIL_THROW("Bond constraints require SIMP_BOND");
+         #endif
+      }
+   }
+
+   /*
+   * Load optional bond constraints.
+   */
+   void TwoStepIntegrator::loadConstraints(Serializable::IArchive& ar)
+   {
+      hasConstraints_ = false;
+      loadParameter<bool>(ar, "hasConstraints", hasConstraints_, false);
+      if (hasConstraints_) {
+         #ifdef SIMP_BOND
+         loadParamComposite(ar, constraints_);
+         #else
+         UTIL_THROW("Bond constraints require SIMP_BOND");
+         #endif
+      }
+   }
+
+   /*
+   * Save optional bond constraints.
+   */
+   void TwoStepIntegrator::saveConstraints(Serializable::OArchive& ar)
+   {
+      Parameter::saveOptional(ar, hasConstraints_, hasConstraints_);
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         constraints_.save(ar);
+      }
+      #endif
+   }
+
+   /*
+   * Setup bond constraints, if any.
+   */
+   void TwoStepIntegrator::setupConstraints(double dt)
+   {
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         constraints_.setup(dt);
+
+         // Project initial positions onto the constraints, update
+         // ghosts, recompute forces, and project velocities.
+         constraints_.saveReferences();
+         constraints_.constrainPositions(false);
+         exchanger().update();
+         if (simulation().boundaryEnsemble().isRigid()) {
+            simulation().computeForces();
+         } else {
+            simulation().computeForcesAndVirial();
+         }
+         constraints_.constrainVelocities();
+      }
+      #endif
+   }
+
+   /*
+   * Store constrained bond vectors, if any.
+   */
+   void TwoStepIntegrator::saveConstraintReferences()
+   {
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         constraints_.saveReferences();
+      }
+      #endif
+   }
+
+   /*
+   * Apply position constraints, with timing.
+   */
+   void TwoStepIntegrator::constrainPositions()
+   {
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         timer().stamp(INTEGRATE1);
+         constraints_.constrainPositions();
+         timer().stamp(CONSTRAIN);
+      }
+      #endif
+   }
+
+   /*
+   * Apply velocity constraints, with timing.
+   */
+   void TwoStepIntegrator::constrainVelocities()
+   {
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         timer().stamp(INTEGRATE2);
+         constraints_.constrainVelocities();
+         timer().stamp(CONSTRAIN);
+      }
+      #endif
+   }
+
+   /*
+   * Total number of constraints.
+   */
+   int TwoStepIntegrator::nConstraint() const
+   {
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         return constraints_.nConstraintTotal();
+      }
+      #endif
+      return 0;
+   }
+
+   /*
+   * Add constraint virial stress, if any.
+   */
+   void TwoStepIntegrator::addConstraintStress(Tensor& stress) const
+   {
+      #ifdef SIMP_BOND
+      if (hasConstraints_) {
+         stress += constraints_.stress();
+      }
+      #endif
+   }
+
+   /*
+   * Compute forces within the main loop.
+   */
+   void TwoStepIntegrator::computeStepForces(bool isOverlapped)
+   {
+      // If constant pressure ensemble (not rigid), also calculate the
+      // virial stress. All methods use the timer() internally, and all
+      // send the modifyForce signal.
+      if (simulation().boundaryEnsemble().isRigid()) {
+         if (isOverlapped) {
+            computeGhostForces();
+         } else {
+            computeForces();
+         }
+      } else {
+         computeForcesAndVirial();
+      }
+   }
+
    /*
    * Run integrator for nStep steps.
    */
@@ -78,8 +237,29 @@ namespace DdMd
       int  beginStep = iStep_;
       int  endStep = iStep_ + nStep;
       bool needExchange;
+      bool needBalance;
+
+      // Overlap ghost updates with local pair forces, if requested. This
+      // is disabled if modifiers may act between update and force steps, 
+      // if the virial must be computed with the forces, or if the pair
+      // list is updated incrementally using updated ghost positions.
+      bool overlap = overlapUpdate();
+      if (!simulation().boundaryEnsemble().isRigid()) {
+         overlap = false;
+      }
+      if (pairPotential().isIncremental()) {
+         overlap = false;
+      }
+      #ifdef DDMD_MODIFIERS 
+      if (modifierManager.size() > 0) {
+         overlap = false;
+      }
+      #endif
       for ( ; iStep_ < endStep; ++iStep_) {
 
+         // Begin, mark or end timeline trace, if requested.
+         traceStep();
+
          // Atomic coordinates must be Cartesian on entry to loop body.
          if (!atomStorage().isCartesian()) {
             UTIL_THROW("Error: Atomic coordinates are not Cartesian");
@@ -123,7 +303,16 @@ namespace DdMd
    
          // Check if exchange and reneighboring is necessary
          // Note: Integrate::isExchangeNeeded uses timer.
-         needExchange = isExchangeNeeded(pairPotential().skin());
+         needExchange = isExchangeNeeded(pairPotential().exchangeSkin());
+
+         // Force an exchange if domain boundaries are to be balanced
+         needBalance = false;
+         if (balanceInterval() > 0) {
+            if (iStep_ % balanceInterval() == 0) {
+               needBalance = true;
+               needExchange = true;
+            }
+         }
 
          if (!atomStorage().isCartesian()) {
             UTIL_THROW("Error: atomic coordinates are not Cartesian");
@@ -142,6 +331,11 @@ namespace DdMd
             atomStorage().transformCartToGen(boundary());
             timer().stamp(Integrator::TRANSFORM_F);
 
+            // Shift domain boundaries, if scheduled
+            if (needBalance) {
+               balanceDomains();
+            }
+
             #ifdef DDMD_MODIFIERS 
             modifierManager.preExchange(iStep_);
             timer().stamp(MODIFIER);
@@ -182,9 +376,23 @@ namespace DdMd
             #endif
      
             // Update all ghost atom positions 
-            exchanger().update();
+            if (overlap) {
+               // Compute local pair forces while ghosts are in transit
+               exchanger().beginUpdate();
+               timer().stamp(UPDATE);
+               computeLocalForces();
+               exchanger().endUpdate();
+            } else {
+               exchanger().update();
+            }
             timer().stamp(UPDATE);
 
+            // Incrementally update the pair list, if enabled
+            if (pairPotential().isIncremental()) {
+               pairPotential().updatePairList();
+               timer().stamp(PAIRLIST);
+            }
+
             #ifdef DDMD_MODIFIERS 
             modifierManager.postUpdate(iStep_);
             timer().stamp(MODIFIER);
@@ -208,16 +416,8 @@ namespace DdMd
          timer().stamp(MODIFIER);
          #endif
   
-         // Calculate forces: 
-         // Calculate new forces for all local atoms. If constant pressure
-         // ensemble (not rigid), also calculate the virial stress. Both 
-         // methods use the timer() internall, and both send the modifyForce 
-         // signal. 
-         if (simulation().boundaryEnsemble().isRigid()) {
-            computeForces();
-         } else {
-            computeForcesAndVirial();
-         }
+         // Calculate new forces for all local atoms (timed internally)
+         computeStepForces(overlap && !needExchange);
 
          #ifdef DDMD_MODIFIERS 
          modifierManager.postForce(iStep_);
@@ -243,6 +443,7 @@ namespace DdMd
       }
       exchanger().timer().stop();
       timer().stop();
+      finishTrace();
 
       // Final analyzers and restart file, if scheduled.
       analyzerManager.sample(iStep_);
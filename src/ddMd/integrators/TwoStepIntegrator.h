@@ -2,6 +2,9 @@
 #define DDMD_TWO_STEP_INTEGRATOR_H
 
 #include "Integrator.h"
+#ifdef SIMP_BOND
+#include "BondConstraints.h"
+#endif
 
 /*
 * Simpatico - Simulation Package for Polymeric and Molecular Liquids
@@ -43,8 +46,69 @@ namespace DdMd
       */
       void run(int nStep);
 
+      /**
+      * Add virial stress of bond constraint forces, if any.
+      *
+      * \param stress  virial stress (incremented, only on master)
+      */
+      virtual void addConstraintStress(Tensor& stress) const;
+
    protected:
 
+      /**
+      * Read optional hasConstraints flag and BondConstraints block.
+      *
+      * Subclasses that support bond constraints call this at the end 
+      * of readParameters. Constraints require SIMP_BOND.
+      *
+      * \param in input parameter stream
+      */
+      void readConstraints(std::istream& in);
+
+      /**
+      * Load optional bond constraints from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      void loadConstraints(Serializable::IArchive& ar);
+
+      /**
+      * Save optional bond constraints to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      void saveConstraints(Serializable::OArchive& ar);
+
+      /**
+      * Setup bond constraints, if any (call in setup after setupAtoms).
+      *
+      * Projects initial positions and velocities onto the constraints,
+      * and recomputes forces at the projected positions.
+      *
+      * \param dt integrator time step
+      */
+      void setupConstraints(double dt);
+
+      /**
+      * Store constrained bond vectors (call before updating positions).
+      */
+      void saveConstraintReferences();
+
+      /**
+      * Apply position constraints (call after updating positions).
+      */
+      void constrainPositions();
+
+      /**
+      * Apply velocity constraints (call after final velocity update).
+      */
+      void constrainVelocities();
+
+      /**
+      * Total number of constraints (zero if none).
+      */
+      int nConstraint() const;
+
       /**
       * Execute first step of two-step integrator.
       *
@@ -54,6 +118,19 @@ namespace DdMd
       */
       virtual void integrateStep1() = 0;
 
+      /**
+      * Compute forces within the main loop, before integrateStep2().
+      *
+      * The default implementation calls computeGhostForces() if the
+      * local pair forces were computed during the ghost update, and
+      * otherwise computeForces(), or computeForcesAndVirial() if the
+      * boundary ensemble is not rigid. Forces added by modifiers in
+      * postForce() are added after this function returns.
+      *
+      * \param isOverlapped were local pair forces computed during update?
+      */
+      virtual void computeStepForces(bool isOverlapped);
+
       /**
       * Execute secodn step of two-step integrator.
       *
@@ -62,6 +139,16 @@ namespace DdMd
       */
       virtual void integrateStep2() = 0;
 
+   private:
+
+      #ifdef SIMP_BOND
+      /// Bond length constraints.
+      BondConstraints constraints_;
+      #endif
+
+      /// Are bond constraints enabled?
+      bool hasConstraints_;
+
    };
 
 }
@@ -6,8 +6,14 @@ ddMd_integrators_=\
    ddMd/integrators/NvtLangevinIntegrator.cpp \
    ddMd/integrators/NptIntegrator.cpp \
    ddMd/integrators/NphIntegrator.cpp \
+   ddMd/integrators/RespaIntegrator.cpp \
    ddMd/integrators/IntegratorFactory.cpp
 
+ifdef SIMP_BOND
+ddMd_integrators_+=\
+   ddMd/integrators/BondConstraints.cpp
+endif
+
 ddMd_integrators_SRCS=\
      $(addprefix $(SRC_DIR)/, $(ddMd_integrators_))
 ddMd_integrators_OBJS=\
@@ -11,9 +11,18 @@ namespace DdMd
 {
 
    DdTimer::DdTimer(int size)
+    : previous_(0.0),
+      begin_(0.0),
+      time_(0.0),
+      traceBegin_(0.0),
+      traceStep_(0),
+      isTracing_(false)
    {
       times_.allocate(size);
       size_ = size;
+      localTimes_.allocate(size);
+      minTimes_.allocate(size);
+      maxTimes_.allocate(size);
       clear();
    }
 
@@ -24,6 +33,9 @@ namespace DdMd
    {
       for (int i = 0; i < size_; i++) {
          times_[i] = 0.0;
+         localTimes_[i] = 0.0;
+         minTimes_[i] = 0.0;
+         maxTimes_[i] = 0.0;
       }
       time_ = 0.0;
    }
@@ -38,6 +50,10 @@ namespace DdMd
    {
       double current = MPI_Wtime();
       times_[id] += current - previous_;
+      localTimes_[id] += current - previous_;
+      if (isTracing_) {
+         record(id, previous_, current);
+      }
       previous_ = current;
    }
 
@@ -45,6 +61,12 @@ namespace DdMd
    {  time_ += MPI_Wtime() - begin_; }
 
    #ifdef UTIL_MPI
+   /*
+   * Replace times by averages, and compute ranges, over all processors.
+   *
+   * Ranges are computed from localTimes_, which are never averaged, so
+   * that repeated calls to reduce() give consistent results.
+   */
    void DdTimer::reduce(MPI::Intracomm& communicator) 
    {
       int procs = communicator.Get_size();
@@ -55,7 +77,17 @@ namespace DdMd
       }
       communicator.Allreduce(&time_, &sum, 1, MPI::DOUBLE, MPI::SUM);
       time_ = sum/double(procs);
+      communicator.Allreduce(&localTimes_[0], &minTimes_[0], size_,
+                             MPI::DOUBLE, MPI::MIN);
+      communicator.Allreduce(&localTimes_[0], &maxTimes_[0], size_,
+                             MPI::DOUBLE, MPI::MAX);
    }
+
+   double DdTimer::minTime(int id) const
+   {  return minTimes_[id]; }
+
+   double DdTimer::maxTime(int id) const
+   {  return maxTimes_[id]; }
    #endif
 
    double DdTimer::time(int id) const
@@ -64,4 +96,83 @@ namespace DdMd
    double DdTimer::time() const
    {  return time_; }
 
+   /*
+   * Discard any previous trace, and begin recording.
+   */
+   void DdTimer::beginTrace()
+   {
+      trace_.clear();
+      traceBegin_ = MPI_Wtime();
+      traceStep_ = 0;
+      isTracing_ = true;
+   }
+
+   /*
+   * Stop recording.
+   */
+   void DdTimer::endTrace()
+   {  isTracing_ = false; }
+
+   /*
+   * Add a step marker to the trace.
+   */
+   void DdTimer::markStep(int iStep)
+   {
+      if (!isTracing_) return;
+      traceStep_ = iStep;
+      TraceEvent event;
+      event.begin = MPI_Wtime() - traceBegin_;
+      event.duration = 0.0;
+      event.id = -1;
+      event.step = iStep;
+      trace_.append(event);
+   }
+
+   /*
+   * Append an interval to the trace (called by stamp).
+   */
+   void DdTimer::record(int id, double begin, double end)
+   {
+      if (end <= begin) return;
+      TraceEvent event;
+      event.begin = begin - traceBegin_;
+      event.duration = end - begin;
+      event.id = id;
+      event.step = traceStep_;
+      trace_.append(event);
+   }
+
+   /*
+   * Write trace in Chrome trace event format, with times in microseconds.
+   */
+   void DdTimer::writeTrace(std::ostream& out, const char* const names[],
+                            int rank) const
+   {
+      std::ios_base::fmtflags flags = out.flags();
+      std::streamsize precision = out.precision();
+      out.setf(std::ios::fixed, std::ios::floatfield);
+      out.precision(3);
+
+      out << "{\"traceEvents\":[" << std::endl;
+      out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+          << ",\"tid\":0,\"args\":{\"name\":\"rank " << rank << "\"}}";
+      for (int i = 0; i < trace_.size(); ++i) {
+         const TraceEvent& event = trace_[i];
+         out << "," << std::endl;
+         if (event.id < 0) {
+            out << "{\"name\":\"step\",\"ph\":\"i\",\"s\":\"p\"";
+         } else {
+            out << "{\"name\":\"" << names[event.id] << "\",\"ph\":\"X\""
+                << ",\"dur\":" << 1.0E6*event.duration;
+         }
+         out << ",\"ts\":" << 1.0E6*event.begin
+             << ",\"pid\":" << rank << ",\"tid\":0"
+             << ",\"args\":{\"step\":" << event.step << "}}";
+      }
+      out << std::endl << "]}" << std::endl;
+
+      out.flags(flags);
+      out.precision(precision);
+   }
+
 }
@@ -9,8 +9,11 @@
 */
 
 #include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
 #include <util/global.h>
 
+#include <iostream>
+
 namespace DdMd 
 {
 
@@ -20,6 +23,12 @@ namespace DdMd
    * Class for measuring time intervals.
    *
    * Design adapted from the timer class in Lammps.
+   *
+   * A DdTimer can also record a timeline of all stamped intervals
+   * between calls to beginTrace() and endTrace(), which may then be
+   * written by writeTrace() in the Chrome trace event format (JSON),
+   * for viewing with chrome://tracing or Perfetto. Nothing is
+   * recorded when no trace is active.
    */
    class DdTimer 
    {
@@ -62,19 +71,127 @@ namespace DdMd
       #ifdef UTIL_MPI
       /**
       * Upon return, times on every processor replaced by average over procs.
+      *
+      * Also sets the minimum and maximum over processors of the time
+      * accumulated by each processor for each interval, which are
+      * returned by minTime(id) and maxTime(id).
       */
       void reduce(MPI::Intracomm& communicator);
+
+      /**
+      * Minimum over processors of time for interval id.
+      *
+      * Value is set by the most recent call to reduce().
+      */
+      double minTime(int id) const;
+
+      /**
+      * Maximum over processors of time for interval id.
+      *
+      * Value is set by the most recent call to reduce().
+      */
+      double maxTime(int id) const;
       #endif
+
+      /**
+      * Number of distinct time intervals.
+      */
+      int size() const;
+
+      /// \name Timeline trace
+      //@{
+
+      /**
+      * Discard any previous trace and begin recording a new one.
+      */
+      void beginTrace();
+
+      /**
+      * Stop recording a trace.
+      */
+      void endTrace();
+
+      /**
+      * Record the beginning of a time step in the current trace.
+      *
+      * Intervals stamped after this call are labelled by step index
+      * iStep. Does nothing if no trace is being recorded.
+      *
+      * \param iStep time step index
+      */
+      void markStep(int iStep);
+
+      /**
+      * Write recorded trace in Chrome trace event (JSON) format.
+      *
+      * Times are given relative to the call to beginTrace().
+      *
+      * \param out    output stream
+      * \param names  array of size() interval names, indexed by id
+      * \param rank   processor rank, used as the process id
+      */
+      void writeTrace(std::ostream& out, const char* const names[],
+                      int rank) const;
+
+      /**
+      * Is a trace currently being recorded?
+      */
+      bool isTracing() const;
+
+      /**
+      * Number of events in the current or most recent trace.
+      */
+      int nTraceEvent() const;
+
+      //@}
    
    private:
    
+      /**
+      * An interval or step marker in a timeline trace.
+      */
+      struct TraceEvent
+      {
+         /// Start time, relative to beginning of trace (sec)
+         double begin;
+         /// Duration (sec), or 0 for a step marker
+         double duration;
+         /// Interval id, or -1 for a step marker
+         int id;
+         /// Time step index
+         int step;
+      };
+
       DArray<double> times_;
+      DArray<double> localTimes_;
+      DArray<double> minTimes_;
+      DArray<double> maxTimes_;
+      GArray<TraceEvent> trace_;
       double previous_;
       double begin_;
       double time_;
+      double traceBegin_;
       int    size_;
+      int    traceStep_;
+      bool   isTracing_;
+
+      /*
+      * Append an event to the trace.
+      */
+      void record(int id, double begin, double end);
 
    };
 
+   // Inline methods
+
+   inline int DdTimer::size() const
+   {  return size_; }
+
+   inline bool DdTimer::isTracing() const
+   {  return isTracing_; }
+
+   inline int DdTimer::nTraceEvent() const
+   {  return trace_.size(); }
+
 }
 #endif
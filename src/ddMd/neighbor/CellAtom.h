@@ -31,7 +31,10 @@ namespace DdMd
       #endif
 
       void setPtr(Atom* atomPtr) 
-      {  ptr_ = atomPtr; }
+      {  
+         ptr_ = atomPtr; 
+         isMarked_ = false;
+      }
 
       void update() 
       {
@@ -59,11 +62,18 @@ namespace DdMd
          return &(ptr_->mask()); 
       }
 
+      void setIsMarked(bool isMarked)
+      {  isMarked_ = isMarked; }
+
+      bool isMarked() const
+      {  return isMarked_; }
+
    private:
 
       Vector position_;
       Atom* ptr_;
       int id_;
+      bool isMarked_;
 
    };
 
@@ -314,6 +314,54 @@ namespace DdMd
       }
    }
 
+   /*
+   * Mark all atoms in cells that contain an atom that has moved.
+   */
+   int CellList::markMoved(double maxDisplacement)
+   {
+      double maxSqDisplacement = maxDisplacement*maxDisplacement;
+      Vector dr;
+      CellAtom* cellAtomPtr = &atoms_[0];
+      int i, j, na, nCell;
+      bool isMoved;
+
+      // Cells own consecutive blocks of atoms_, in order of cell rank
+      nCell = 0;
+      for (i = 0; i < grid_.size(); ++i) {
+         na = cells_[i].nAtom();
+         isMoved = false;
+         for (j = 0; j < na; ++j) {
+            dr.subtract(cellAtomPtr[j].ptr()->position(), 
+                        cellAtomPtr[j].position());
+            if (dr.square() > maxSqDisplacement) {
+               isMoved = true;
+               break;
+            }
+         }
+         if (isMoved) {
+            for (j = 0; j < na; ++j) {
+               cellAtomPtr[j].setIsMarked(true);
+            }
+            ++nCell;
+         }
+         cellAtomPtr += na;
+      }
+      return nCell;
+   }
+
+   /*
+   * Update positions of marked atoms, and clear marks.
+   */
+   void CellList::updateMoved()
+   {
+      for (int i = 0; i < nAtom_; ++i) {
+         if (atoms_[i].isMarked()) {
+            atoms_[i].update();
+            atoms_[i].setIsMarked(false);
+         }
+      }
+   }
+
    /*
    * Get total number of atoms in this CellList.
    */
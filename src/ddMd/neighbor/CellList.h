@@ -211,6 +211,24 @@ namespace DdMd
       */
       void update();
 
+      /**
+      * Mark atoms in cells that contain an atom that has moved.
+      *
+      * Compares the current position of each atom to the position 
+      * stored in its CellAtom, and marks every CellAtom in each cell 
+      * that contains at least one atom that has moved a distance 
+      * greater than maxDisplacement. 
+      *
+      * \param maxDisplacement displacement threshold
+      * \return number of cells that contain marked atoms
+      */
+      int markMoved(double maxDisplacement);
+
+      /**
+      * Update stored positions of marked atoms, and clear all marks.
+      */
+      void updateMoved();
+
       /**
       * Reset the cell list to its empty state (no Atoms).
       */
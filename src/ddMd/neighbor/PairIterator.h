@@ -9,6 +9,7 @@
 */
 
 #include "PairList.h"
+#include <ddMd/chemistry/Atom.h>
 #include <util/global.h>
 
 namespace DdMd
@@ -100,25 +101,28 @@ namespace DdMd
 
    private:
  
-      /// Array of const pointers to primary atom in each pair.
-      Atom* const* atom1Ptrs_;  
+      /// Array of const indices of primary atom in each pair.
+      const int*   atom1Ids_;  
 
-      /// Array of const pointers to secondary atom in each pair.
-      Atom* const* atom2Ptrs_;  
+      /// Array of const packed indices of secondary atom in each pair.
+      const int*   atom2Ids_;  
 
-      /// Pointer to const index in atom2Ptrs_ of first neighbor of an Atom.
+      /// Pointer to const index in atom2Ids_ of first neighbor of an Atom.
       const int*   first_; 
 
-      /// Number of primary atoms in atom1Ptrs_.
+      /// Addresses of first local [0] and ghost [1] atoms.
+      Atom*  basePtrs_[2];
+
+      /// Number of primary atoms in atom1Ids_ (or end of partition).
       int    nAtom1_;      
   
-      /// Number of secondary atoms in atom2Ptrs_.
+      /// Number of secondary atoms in atom2Ids_ (or end of partition).
       int    nAtom2_;      
   
-      /// Current index of first atom in atom1Ptrs_.
+      /// Current index of first atom in atom1Ids_.
       int    atom1Id_;
 
-      /// Current index of second atom in atom2Ptrs_.
+      /// Current index of second atom in atom2Ids_.
       int    atom2Id_;
 
    // friends:
@@ -131,27 +135,34 @@ namespace DdMd
    * Default constructor.
    */
    inline PairIterator::PairIterator()
-    : atom1Ptrs_(0),
-      atom2Ptrs_(0),
+    : atom1Ids_(0),
+      atom2Ids_(0),
       first_(0),
       nAtom1_(0),
       nAtom2_(0),
       atom1Id_(0),
       atom2Id_(0)
-   {}
+   {
+      basePtrs_[0] = 0;
+      basePtrs_[1] = 0;
+   }
 
    /*
    * Constructor, initialized iterator.
    */
    inline PairIterator::PairIterator(const PairList &pairList)
-    : atom1Ptrs_(0),
-      atom2Ptrs_(0),
+    : atom1Ids_(0),
+      atom2Ids_(0),
       first_(0),
       nAtom1_(0),
       nAtom2_(0),
       atom1Id_(0),
       atom2Id_(0)
-   {  pairList.begin(*this); }
+   {
+      basePtrs_[0] = 0;
+      basePtrs_[1] = 0;
+      pairList.begin(*this); 
+   }
 
    /*
    * Get pointers to current pair of Atoms. 
@@ -162,8 +173,9 @@ namespace DdMd
       assert(atom1Id_ < nAtom1_);
       assert(atom2Id_ >=0);
       assert(atom2Id_ < nAtom2_);
-      atom1Ptr = atom1Ptrs_[atom1Id_];
-      atom2Ptr = atom2Ptrs_[atom2Id_];
+      const int id2 = atom2Ids_[atom2Id_];
+      atom1Ptr = basePtrs_[0] + atom1Ids_[atom1Id_];
+      atom2Ptr = basePtrs_[id2 & 1] + (id2 >> 1);
    }
  
    /*
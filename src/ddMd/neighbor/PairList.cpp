@@ -12,6 +12,8 @@
 #include <util/format/Int.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
@@ -21,19 +23,28 @@ namespace DdMd
    * Default constructor.
    */
    PairList::PairList()
-    : atom1Ptrs_(),
-      atom2Ptrs_(),
+    : atom1Ids_(),
+      atom2Ids_(),
       first_(),
+      cellFirst_(),
+      tmpAtom1Ids_(),
+      tmpAtom2Ids_(),
+      tmpFirst_(),
+      tmpCellFirst_(),
       cutoff_(0.0),
       atomCapacity_(0),
       pairCapacity_(0),
       maxNAtomLocal_(0),
       maxNPairLocal_(0),
       buildCounter_(0),
+      updateCounter_(0),
       maxNAtom_(0),
       maxNPair_(0),
       isAllocated_(false)
-   {}
+   {
+      basePtrs_[0] = 0;
+      basePtrs_[1] = 0;
+   }
    
    /*
    * Destructor.
@@ -50,8 +61,8 @@ namespace DdMd
       pairCapacity_ = pairCapacity;
       cutoff_       = cutoff;
 
-      atom1Ptrs_.reserve(atomCapacity_);
-      atom2Ptrs_.reserve(pairCapacity_);
+      atom1Ids_.reserve(atomCapacity_);
+      atom2Ids_.reserve(pairCapacity_);
       first_.reserve(atomCapacity_ + 1);
   
       isAllocated_ = true;
@@ -62,9 +73,25 @@ namespace DdMd
    */
    void PairList::clear()
    { 
-      atom1Ptrs_.clear();
-      atom2Ptrs_.clear();
+      atom1Ids_.clear();
+      atom2Ids_.clear();
       first_.clear();
+      cellFirst_.clear();
+      basePtrs_[0] = 0;
+      basePtrs_[1] = 0;
+   }
+
+   /*
+   * Return packed index of a secondary atom (private).
+   */
+   inline int PairList::packIndex(Atom* ptr)
+   {
+      int k = ptr->isGhost() ? 1 : 0;
+      if (!basePtrs_[k]) {
+         basePtrs_[k] = ptr - ptr->arrayIndex();
+      }
+      assert(basePtrs_[k] + ptr->arrayIndex() == ptr);
+      return (ptr->arrayIndex() << 1) | k;
    }
  
    /*
@@ -80,6 +107,7 @@ namespace DdMd
       const Cell* cellPtr;
       CellAtom* atom1Ptr;
       CellAtom* atom2Ptr;
+      Atom* ptr;
       Mask* maskPtr;
       Vector dr;
       int na;                 // number of atoms in this cell
@@ -91,10 +119,13 @@ namespace DdMd
       cutoffSq = cutoff_*cutoff_;
    
       // Initialize counters for primary atoms and neighbors
-      atom1Ptrs_.clear();
-      atom2Ptrs_.clear();
+      atom1Ids_.clear();
+      atom2Ids_.clear();
       first_.clear();
       first_.append(0);
+      cellFirst_.clear();
+      basePtrs_[0] = 0;
+      basePtrs_[1] = 0;
 
       // Copy positions and ids into cell list
       cellList.update();
@@ -102,6 +133,7 @@ namespace DdMd
       // Find all neighbors (cell list)
       cellPtr = cellList.begin();
       while (cellPtr) {
+         cellFirst_.append(atom1Ids_.size());
          na = cellPtr->nAtom(); // # of atoms in cell
 
          if (na) {
@@ -119,15 +151,21 @@ namespace DdMd
                   atom2Ptr = neighbors[j];
                   dr.subtract(atom2Ptr->position(), atom1Ptr->position()); 
                   if (dr.square() < cutoffSq && !maskPtr->isMasked(atom2Ptr->id())) {
-                     atom2Ptrs_.append(atom2Ptr->ptr());
+                     atom2Ids_.append(packIndex(atom2Ptr->ptr()));
                      hasNeighbor = true;
                   }
                }
 
                // Complete processing of atom1.
                if (hasNeighbor) {
-                  atom1Ptrs_.append(atom1Ptr->ptr());
-                  first_.append(atom2Ptrs_.size());
+                  ptr = atom1Ptr->ptr();
+                  assert(!ptr->isGhost());
+                  if (!basePtrs_[0]) {
+                     basePtrs_[0] = ptr - ptr->arrayIndex();
+                  }
+                  assert(basePtrs_[0] + ptr->arrayIndex() == ptr);
+                  atom1Ids_.append(ptr->arrayIndex());
+                  first_.append(atom2Ids_.size());
                }
 
             } // for ia 
@@ -136,16 +174,17 @@ namespace DdMd
          // Advance to next cell in a linked list
          cellPtr = cellPtr->nextCellPtr();
       }
+      cellFirst_.append(atom1Ids_.size());
 
       // Postconditions
-      if (atom1Ptrs_.size()) {
-         if (first_.size() != atom1Ptrs_.size() + 1) {
+      if (atom1Ids_.size()) {
+         if (first_.size() != atom1Ids_.size() + 1) {
             UTIL_THROW("Array size problem");
          }
          if (first_[0] != 0) {
             UTIL_THROW("Incorrect first element of first_");
          }
-         if (first_[atom1Ptrs_.size()] != atom2Ptrs_.size()) {
+         if (first_[atom1Ids_.size()] != atom2Ids_.size()) {
             UTIL_THROW("Incorrect last element of first_");
          }
       }
@@ -154,30 +193,200 @@ namespace DdMd
       ++buildCounter_;
  
       // Increment maxima
-      if (atom1Ptrs_.size() > maxNAtomLocal_) {
-         maxNAtomLocal_ = atom1Ptrs_.size();
+      if (atom1Ids_.size() > maxNAtomLocal_) {
+         maxNAtomLocal_ = atom1Ids_.size();
       }
-      if (atom2Ptrs_.size() > maxNPairLocal_) {
-         maxNPairLocal_ = atom2Ptrs_.size();
+      if (atom2Ids_.size() > maxNPairLocal_) {
+         maxNPairLocal_ = atom2Ids_.size();
       }
    }
 
+   /*
+   * Incrementally update the PairList, recomputing only cells near moved atoms.
+   */
+   bool PairList::update(CellList& cellList, double maxDisplacement, 
+                         bool reverseUpdateFlag)
+   {
+      // Precondition
+      assert(isAllocated());
+      assert(cellFirst_.size() > 0);
+
+      // Mark all atoms in cells that contain a moved atom
+      if (cellList.markMoved(maxDisplacement) == 0) {
+         return false;
+      }
+
+      Cell::NeighborArray neighbors;
+      double cutoffSq = cutoff_*cutoff_;
+      const Cell* cellPtr;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      Mask* maskPtr;
+      Vector dr;
+      int na, nn, i, j, k, iCell;
+      bool isStale, hasNeighbor;
+
+      tmpAtom1Ids_.clear();
+      tmpAtom2Ids_.clear();
+      tmpFirst_.clear();
+      tmpFirst_.append(0);
+      tmpCellFirst_.clear();
+
+      // Visit local cells in the same order as build()
+      iCell = 0;
+      cellPtr = cellList.begin();
+      while (cellPtr) {
+         tmpCellFirst_.append(tmpAtom1Ids_.size());
+         na = cellPtr->nAtom();
+         if (na) {
+            cellPtr->getNeighbors(neighbors, reverseUpdateFlag);
+            nn = neighbors.size();
+
+            // Check if any potential partner is marked
+            isStale = false;
+            for (j = 0; j < nn; ++j) {
+               if (neighbors[j]->isMarked()) {
+                  isStale = true;
+                  break;
+               }
+            }
+
+            if (isStale) {
+
+               // Recompute pairs, using current atomic positions
+               for (i = 0; i < na; ++i) {
+                  atom1Ptr = neighbors[i]->ptr();
+                  maskPtr  = &(atom1Ptr->mask());
+                  hasNeighbor = false;
+                  for (j = i + 1; j < nn; ++j) {
+                     atom2Ptr = neighbors[j]->ptr();
+                     dr.subtract(atom2Ptr->position(), atom1Ptr->position()); 
+                     if (dr.square() < cutoffSq 
+                         && !maskPtr->isMasked(neighbors[j]->id())) {
+                        tmpAtom2Ids_.append(packIndex(atom2Ptr));
+                        hasNeighbor = true;
+                     }
+                  }
+                  if (hasNeighbor) {
+                     assert(!atom1Ptr->isGhost());
+                     assert(basePtrs_[0] + atom1Ptr->arrayIndex() == atom1Ptr);
+                     tmpAtom1Ids_.append(atom1Ptr->arrayIndex());
+                     tmpFirst_.append(tmpAtom2Ids_.size());
+                  }
+               }
+
+            } else {
+
+               // Copy existing entries for primary atoms in this cell
+               for (i = cellFirst_[iCell]; i < cellFirst_[iCell+1]; ++i) {
+                  tmpAtom1Ids_.append(atom1Ids_[i]);
+                  for (j = first_[i]; j < first_[i+1]; ++j) {
+                     tmpAtom2Ids_.append(atom2Ids_[j]);
+                  }
+                  tmpFirst_.append(tmpAtom2Ids_.size());
+               }
+
+            }
+         }
+         ++iCell;
+         cellPtr = cellPtr->nextCellPtr();
+      }
+      tmpCellFirst_.append(tmpAtom1Ids_.size());
+      if (iCell + 1 != cellFirst_.size()) {
+         UTIL_THROW("CellList has changed since PairList was built");
+      }
+
+      // Copy workspace into permanent arrays
+      atom1Ids_.clear();
+      for (k = 0; k < tmpAtom1Ids_.size(); ++k) {
+         atom1Ids_.append(tmpAtom1Ids_[k]);
+      }
+      atom2Ids_.clear();
+      for (k = 0; k < tmpAtom2Ids_.size(); ++k) {
+         atom2Ids_.append(tmpAtom2Ids_[k]);
+      }
+      first_.clear();
+      for (k = 0; k < tmpFirst_.size(); ++k) {
+         first_.append(tmpFirst_[k]);
+      }
+      cellFirst_.clear();
+      for (k = 0; k < tmpCellFirst_.size(); ++k) {
+         cellFirst_.append(tmpCellFirst_[k]);
+      }
+
+      // Reset reference positions of marked atoms, all of whose pairs 
+      // have now been recomputed.
+      cellList.updateMoved();
+
+      ++updateCounter_;
+      if (atom1Ids_.size() > maxNAtomLocal_) {
+         maxNAtomLocal_ = atom1Ids_.size();
+      }
+      if (atom2Ids_.size() > maxNPairLocal_) {
+         maxNPairLocal_ = atom2Ids_.size();
+      }
+      return true;
+   }
+
    /*
    * Initialize a pair iterator.
    */
    void PairList::begin(PairIterator& iterator) const
    {
-      if (atom1Ptrs_.size()) {
-         iterator.atom1Ptrs_ = &atom1Ptrs_[0];
-         iterator.atom2Ptrs_ = &atom2Ptrs_[0];
+      if (atom1Ids_.size()) {
+         iterator.atom1Ids_  = &atom1Ids_[0];
+         iterator.atom2Ids_  = &atom2Ids_[0];
          iterator.first_     = &first_[0];
-         iterator.nAtom1_    = atom1Ptrs_.size();
-         iterator.nAtom2_    = atom2Ptrs_.size();
+         iterator.basePtrs_[0] = basePtrs_[0];
+         iterator.basePtrs_[1] = basePtrs_[1];
+         iterator.nAtom1_    = atom1Ids_.size();
+         iterator.nAtom2_    = atom2Ids_.size();
          iterator.atom1Id_   = 0;
          iterator.atom2Id_   = 0;
       }
    }
 
+   /*
+   * Initialize a pair iterator for one partition of the list.
+   */
+   void PairList::begin(PairIterator& iterator, 
+                        int iPartition, int nPartition) const
+   {
+      assert(nPartition > 0);
+      assert(iPartition >= 0 && iPartition < nPartition);
+
+      int nAtom1 = atom1Ids_.size();
+      int nAtom2 = atom2Ids_.size();
+      if (nAtom1) {
+
+         // Partition boundaries are the first primary atoms i for which
+         // first_[i] >= nAtom2*iPartition/nPartition. Elements of first_ 
+         // increase monotonically, from first_[0]=0 to first_[nAtom1]=nAtom2.
+         const int* firstBegin = &first_[0];
+         const int* firstEnd = firstBegin + nAtom1 + 1;
+         long target;
+         int begin, end;
+         target = (long(nAtom2)*long(iPartition))/long(nPartition);
+         begin = std::lower_bound(firstBegin, firstEnd, int(target)) 
+                 - firstBegin;
+         target = (long(nAtom2)*long(iPartition + 1))/long(nPartition);
+         end = std::lower_bound(firstBegin, firstEnd, int(target)) 
+               - firstBegin;
+         assert(begin <= end && end <= nAtom1);
+
+         // Iteration ends when atom2Id_ == nAtom2_ = first_[end]
+         iterator.atom1Ids_  = &atom1Ids_[0];
+         iterator.atom2Ids_  = &atom2Ids_[0];
+         iterator.first_     = firstBegin;
+         iterator.basePtrs_[0] = basePtrs_[0];
+         iterator.basePtrs_[1] = basePtrs_[1];
+         iterator.nAtom1_    = end;
+         iterator.nAtom2_    = first_[end];
+         iterator.atom1Id_   = begin;
+         iterator.atom2Id_   = first_[begin];
+      }
+   }
+
    /*
    * Compute memory usage statistics (call on all processors).
    */
@@ -214,6 +423,7 @@ namespace DdMd
       maxNAtom_.unset();
       maxNPair_.unset();
       buildCounter_ = 0;
+      updateCounter_ = 0;
    }
 
    /*
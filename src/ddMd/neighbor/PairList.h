@@ -81,6 +81,31 @@ namespace DdMd
       */
       void build(CellList& cellList, bool reverseUpdateFlag = false);
 
+      /**
+      * Incrementally update a PairList built from a CellList.
+      *
+      * Marks atoms in cells that contain an atom that has moved farther 
+      * than maxDisplacement since the pairs involving it were last 
+      * computed (see CellList::markMoved), and recomputes the neighbor 
+      * lists of primary atoms only for local cells with a marked atom in
+      * their neighborhood. Entries for all other cells are copied. The 
+      * CellList must be the one used in the last call to build(), and 
+      * must not have been rebuilt since. 
+      *
+      * The resulting list contains all pairs separated by less than the
+      * pair potential cutoff if maxDisplacement is no greater than one 
+      * quarter of the pair list skin, and if no atom has moved far 
+      * enough since the CellList was built to leave the neighborhood 
+      * searched for its partners.
+      *
+      * \param cellList  CellList object used by the last build()
+      * \param maxDisplacement displacement threshold
+      * \param reverseUpdateFlag is reverse communication enabled?
+      * \return true if any cell was updated, false otherwise
+      */
+      bool update(CellList& cellList, double maxDisplacement, 
+                  bool reverseUpdateFlag = false);
+
       //@}
       /// \name Accessors (miscellaneous)
       //@{ 
@@ -91,6 +116,21 @@ namespace DdMd
       * \param iterator a PairList, initialized on output
       */
       void begin(PairIterator &iterator) const;
+
+      /**
+      * Initialize a PairIterator for one of several equal partitions.
+      *
+      * Divides the list into nPartition contiguous ranges of primary
+      * atoms, each containing approximately the same number of pairs,
+      * and initializes iterator to iterate over pairs in partition
+      * iPartition. Every pair belongs to exactly one partition. This
+      * is used to distribute a loop over pairs among threads.
+      *
+      * \param iterator   a PairIterator, initialized on output
+      * \param iPartition index of partition (0 <= iPartition < nPartition)
+      * \param nPartition number of partitions
+      */
+      void begin(PairIterator &iterator, int iPartition, int nPartition) const;
  
       /**
       * Get the number of primary atoms in the PairList.
@@ -165,26 +205,49 @@ namespace DdMd
       */
       int buildCounter() const;
 
+      /**
+      * Return number of incremental updates thus far.
+      */
+      int updateCounter() const;
+
       //@}
 
    private:
   
-      /// Array of pointers to 1st (or primary) atom in each pair.
-      GArray<Atom*>  atom1Ptrs_;  
+      /// Array of indices of 1st (or primary) atom in each pair.
+      GArray<int>  atom1Ids_;  
 
-      /// Array of pointers to neighbor (or secondary) atom in each pair.
-      GArray<Atom*>  atom2Ptrs_;  
+      /// Array of packed indices of neighbor (or secondary) atom in each pair.
+      GArray<int>  atom2Ids_;  
 
-      /// Array of indices in atom2Ptrs_ of first neighbor of an Atom.
+      /// Array of indices in atom2Ids_ of first neighbor of an Atom.
       GArray<int>  first_; 
 
+      /// Array of indices in atom1Ids_ of first primary atom in each cell.
+      GArray<int>  cellFirst_; 
+
+      /// Addresses of element 0 of the local [0] and ghost [1] atom arrays.
+      Atom*  basePtrs_[2];
+
+      /// Workspace for atom1Ids_, used by update().
+      GArray<int>  tmpAtom1Ids_;  
+
+      /// Workspace for atom2Ids_, used by update().
+      GArray<int>  tmpAtom2Ids_;  
+
+      /// Workspace for first_, used by update().
+      GArray<int>  tmpFirst_; 
+
+      /// Workspace for cellFirst_, used by update().
+      GArray<int>  tmpCellFirst_; 
+
       /// Pair list cutoff radius (pair potential cutoff + skin_).
       double cutoff_;
    
-      /// Maximum number of atoms (dimension of atom1Ptrs_).
+      /// Maximum number of atoms (dimension of atom1Ids_).
       int  atomCapacity_;     
    
-      /// Maximum number of distinct pairs (dimension of atom2Ptrs_).
+      /// Maximum number of distinct pairs (dimension of atom2Ids_).
       int  pairCapacity_;     
    
       /// Maximum number of primary atoms on this proc since stats cleared.
@@ -196,6 +259,9 @@ namespace DdMd
       /// The number of times this list has been built since stats cleared.
       int  buildCounter_;
 
+      /// The number of incremental updates since stats cleared.
+      int  updateCounter_;
+
       /// Maximum number of primary atoms on all procs (defined only on master).
       Setable<int>  maxNAtom_;     
    
@@ -204,20 +270,42 @@ namespace DdMd
    
       /// Has memory been allocated?
       bool  isAllocated_;
+
+      /*
+      * Return the packed index of a secondary atom, and set the address 
+      * of the first element of the parent array on first use.
+      */
+      int packIndex(Atom* ptr);
   
       /* 
       * Implementation Notes:
       *
-      * The pair list is stored in Atom* pointer arrays atom1Ptrs_, atom2Ptrs_, 
-      * and in an integer array first_. Each element of atom1Ptrs_ contains a 
-      * pointer to the first atom in a pair (the primary Atom). Each element 
-      * of atom2Ptrs_ contains a pointer to the second atom in a pair (the 
-      * secondary Atom).  Secondary atoms that are neighbors of the same 
-      * primary atom are listed consecutively.  Element first_[i] contains the 
-      * array index of the first element in atom2Ptrs_ that contains a neighbor 
-      * of primary atom atom1Ptrs_[i]. Pointers to neighbors of primary atom
-      * *atom1Ptrs_[i] are thus stored in elements first_[i] <= j < first_[i+1]
-      * of atom2Ptrs_.  Each pair is included only once.
+      * The pair list is stored in integer arrays atom1Ids_, atom2Ids_ and 
+      * first_. Each element of atom1Ids_ contains the array index of the 
+      * first atom in a pair (the primary Atom), which is always a local 
+      * atom. Each element of atom2Ids_ contains a packed 32-bit index of 
+      * the second atom in a pair (the secondary Atom), which may be local 
+      * or ghost. The packed index has the same layout as the private 
+      * Atom::localId_ member: the array index, shifted left by one bit, 
+      * with a least significant bit that is 1 for a ghost and 0 for a local 
+      * atom. Pointers are recovered by adding the array index to the 
+      * address of the first element of the parent local or ghost atom 
+      * array, which are stored in basePtrs_[0] and basePtrs_[1]. Using 
+      * int rather than Atom* elements halves the memory required by the 
+      * list on a 64-bit machine.
+      *
+      * Secondary atoms that are neighbors of the same primary atom are 
+      * listed consecutively.  Element first_[i] contains the array index 
+      * of the first element in atom2Ids_ that contains a neighbor of 
+      * primary atom i. Indices of neighbors of this primary atom are 
+      * thus stored in elements first_[i] <= j < first_[i+1] of atom2Ids_, 
+      * so that the number of neighbors is first_[i+1] - first_[i]. Each 
+      * pair is included only once (a half-shell list).
+      *
+      * Primary atoms are listed in the order in which local cells are 
+      * visited in the CellList. Element cellFirst_[c] contains the index
+      * in atom1Ids_ of the first primary atom in the c-th local cell, so
+      * that update() can recompute the entries of a single cell.
       *
       * The only way legal way to loop over all atom pairs, using the public 
       * interface of a PairList, is to use a PairListIterator. See the 
@@ -230,12 +318,12 @@ namespace DdMd
       *    Atom* atom2Ptr;
       *
       *    \\ Loop over primary Atoms
-      *    for (i = 0; i < atom1Ptrs_.size(); ++i) {
-      *       atom1Ptr = atom1Ptrs_[i];
+      *    for (i = 0; i < atom1Ids_.size(); ++i) {
+      *       atom1Ptr = basePtrs_[0] + atom1Ids_[i];
       *
       *       // Loop over secondary atoms
       *       for (j = first_[i]; j < first_[i+1]; ++j) {
-      *           atom2Ptr = atom2Ptrs_[j];
+      *           atom2Ptr = basePtrs_[atom2Ids_[j] & 1] + (atom2Ids_[j] >> 1);
       *
       *           // ... Do something with Atoms *atom1Ptr and *atom2Ptr.
       *
@@ -243,7 +331,7 @@ namespace DdMd
       *    }
       *
       * Note that GArray<int> first_ contains one more elements than 
-      * atom1Ptrs_. The element first_[0] is equal to 0, and the last 
+      * atom1Ids_. The element first_[0] is equal to 0, and the last 
       * element is always equal to the total number of pairs.
       */
 
@@ -253,13 +341,13 @@ namespace DdMd
    * Get the current number of primary atoms in the pairlist.
    */ 
    inline int PairList::nAtom() const
-   {  return atom1Ptrs_.size(); }
+   {  return atom1Ids_.size(); }
 
    /*
    * Get the current number of pairs.
    */ 
    inline int PairList::nPair() const
-   {  return atom2Ptrs_.size(); }
+   {  return atom2Ids_.size(); }
 
    /**
    * Get the maximum number of pairs. 
@@ -291,6 +379,12 @@ namespace DdMd
    inline int PairList::buildCounter() const
    { return buildCounter_; }
 
+   /*
+   * Get the number of incremental updates of this PairList.
+   */ 
+   inline int PairList::updateCounter() const
+   { return updateCounter_; }
+
    /*
    * Has memory been allocated for this PairList?
    */ 
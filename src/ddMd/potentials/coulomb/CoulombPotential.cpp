@@ -0,0 +1,85 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CoulombPotential.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/communicate/Domain.h>
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CoulombPotential::CoulombPotential(Simulation& simulation)
+    : ewaldInteraction_(),
+      waveLengths_(0.0),
+      simulationPtr_(&simulation),
+      boundaryPtr_(&simulation.boundary()),
+      domainPtr_(&simulation.domain()),
+      storagePtr_(&simulation.atomStorage()),
+      hasWaves_(false)
+   {  setClassName("CoulombPotential"); }
+
+   /*
+   * Destructor.
+   */
+   CoulombPotential::~CoulombPotential()
+   {}
+
+   /*
+   * Modify an Ewald parameter.
+   *
+   * The r-space cutoff may not be modified, because it is used by the
+   * pair potential to set the pair list cutoff.
+   */
+   void CoulombPotential::set(std::string name, double value)
+   {
+      if (name != "epsilon" && name != "alpha") {
+         UTIL_THROW("Only epsilon and alpha may be modified");
+      }
+      ewaldInteraction_.set(name, value);
+      unsetWaves();
+      unsetEnergy();
+      unsetStress();
+   }
+
+   /*
+   * Get an Ewald parameter.
+   */
+   double CoulombPotential::get(std::string name) const
+   {  return ewaldInteraction_.get(name); }
+
+   /*
+   * Are waves current? Waves are outdated if the boundary has changed.
+   */
+   bool CoulombPotential::hasWaves() const
+   {
+      if (!hasWaves_) return false;
+      return (boundaryPtr_->lengths() == waveLengths_);
+   }
+
+   /*
+   * Mark waves as outdated.
+   */
+   void CoulombPotential::unsetWaves()
+   {  hasWaves_ = false; }
+
+   /*
+   * Mark waves as current for the current boundary (protected).
+   */
+   void CoulombPotential::setHasWaves()
+   {
+      waveLengths_ = boundaryPtr_->lengths();
+      hasWaves_ = true;
+   }
+
+}
@@ -0,0 +1,185 @@
+#ifndef DDMD_COULOMB_POTENTIAL_H
+#define DDMD_COULOMB_POTENTIAL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/potentials/Potential.h>                 // base class
+#include <simp/interaction/coulomb/EwaldInteraction.h> // member
+#include <simp/boundary/Boundary.h>                    // typedef
+#include <util/space/Vector.h>                         // member
+#include <util/global.h>
+
+#include <string>
+
+namespace DdMd
+{
+
+   class Simulation;
+   class Domain;
+   class AtomStorage;
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Long-range k-space part of an Ewald Coulomb potential.
+   *
+   * A CoulombPotential computes the long-range part of the Coulomb
+   * forces, energy and stress. The short-range erfc(alpha r) part is
+   * computed by the PairPotential, which is created with a pair
+   * interaction of type EwaldPair<Interaction> that refers to the
+   * EwaldInteraction owned by this object. Energy and stress values
+   * returned by a CoulombPotential thus include only the k-space and
+   * self-energy contributions, while r-space contributions are
+   * included in the values returned by the PairPotential.
+   *
+   * Charges are properties of atom types (AtomType::charge()).
+   *
+   * \ingroup DdMd_Coulomb_Module
+   */
+   class CoulombPotential : public Potential
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation  parent Simulation
+      */
+      CoulombPotential(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CoulombPotential();
+
+      /// \name Interaction parameters
+      //@{
+
+      /**
+      * Modify an Ewald parameter, identified by a string.
+      *
+      * Only "epsilon" and "alpha" may be modified.
+      *
+      * \param name  parameter name
+      * \param value new value of parameter
+      */
+      void set(std::string name, double value);
+
+      /**
+      * Get an Ewald parameter value, identified by a string.
+      *
+      * \param name parameter name
+      */
+      double get(std::string name) const;
+
+      /**
+      * Get the EwaldInteraction (parameters and r-space functions).
+      */
+      const EwaldInteraction& ewaldInteraction() const;
+
+      //@}
+      /// \name Waves (data that depends on the Boundary)
+      //@{
+
+      /**
+      * Compute wavevector data and influence function for this boundary.
+      *
+      * Call on all processors.
+      */
+      virtual void makeWaves() = 0;
+
+      /**
+      * Are the wavevector data up to date for the current boundary?
+      */
+      bool hasWaves() const;
+
+      /**
+      * Mark wavevector data as outdated.
+      */
+      void unsetWaves();
+
+      /**
+      * Total number of wavevectors (or k-space grid points).
+      */
+      virtual int nWave() const = 0;
+
+      //@}
+
+   protected:
+
+      /// Ewald parameters and r-space functions.
+      EwaldInteraction ewaldInteraction_;
+
+      /**
+      * Mark wavevector data as current, record boundary lengths.
+      */
+      void setHasWaves();
+
+      /**
+      * Get the parent Simulation by reference.
+      */
+      Simulation& simulation();
+
+      /**
+      * Get the Boundary by reference.
+      */
+      Boundary& boundary();
+
+      /**
+      * Get the Domain by reference.
+      */
+      Domain& domain();
+
+      /**
+      * Get the AtomStorage by reference.
+      */
+      AtomStorage& storage();
+
+   private:
+
+      /// Boundary lengths for which waves were last computed.
+      Vector waveLengths_;
+
+      /// Pointer to parent Simulation object.
+      Simulation* simulationPtr_;
+
+      /// Pointer to associated Boundary object.
+      Boundary* boundaryPtr_;
+
+      /// Pointer to associated Domain object.
+      Domain* domainPtr_;
+
+      /// Pointer to associated AtomStorage object.
+      AtomStorage* storagePtr_;
+
+      /// Are waves up to date?
+      bool hasWaves_;
+
+   };
+
+   // Inline methods
+
+   inline const EwaldInteraction& CoulombPotential::ewaldInteraction() const
+   {  return ewaldInteraction_; }
+
+   inline Simulation& CoulombPotential::simulation()
+   {  return *simulationPtr_; }
+
+   inline Boundary& CoulombPotential::boundary()
+   {  return *boundaryPtr_; }
+
+   inline Domain& CoulombPotential::domain()
+   {  return *domainPtr_; }
+
+   inline AtomStorage& CoulombPotential::storage()
+   {  return *storagePtr_; }
+
+}
+#endif
@@ -0,0 +1,922 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "SpmePotential.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/chemistry/AtomType.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/communicate/Domain.h>
+
+#include <util/space/Vector.h>
+#include <util/math/Constants.h>
+#include <util/global.h>
+
+#include <cmath>
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   namespace
+   {
+
+      /*
+      * Nonnegative remainder of i modulo n.
+      */
+      inline int modulo(int i, int n)
+      {
+         int r = i % n;
+         return (r < 0) ? r + n : r;
+      }
+
+      /*
+      * Wavenumber index in range -n/2 < m <= n/2 for grid index i.
+      */
+      inline int waveIndex(int i, int n)
+      {  return (i <= n/2) ? i : i - n; }
+
+   }
+
+   /*
+   * Constructor.
+   */
+   SpmePotential::SpmePotential(Simulation& simulation)
+    : CoulombPotential(simulation),
+      gridDimensions_(),
+      nProcessor_(1),
+      rank_(0),
+      nxLocal_(0),
+      nyLocal_(0),
+      order_(5),
+      isAllocated_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   SpmePotential::~SpmePotential()
+   {
+      if (isAllocated_) {
+         if (nxLocal_ > 0) {
+            fftw_destroy_plan(slabForwardPlan_);
+            fftw_destroy_plan(slabBackwardPlan_);
+         }
+         if (nyLocal_ > 0) {
+            fftw_destroy_plan(pencilForwardPlan_);
+            fftw_destroy_plan(pencilBackwardPlan_);
+         }
+      }
+   }
+
+   /*
+   * Read parameters and initialize.
+   */
+   void SpmePotential::readParameters(std::istream& in)
+   {
+      bool nextIndent = false;
+      addParamComposite(ewaldInteraction_, nextIndent);
+      ewaldInteraction_.readParameters(in);
+      read<IntVector>(in, "gridDimensions", gridDimensions_);
+      order_ = 5;
+      readOptional<int>(in, "order", order_);
+      allocate();
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void SpmePotential::loadParameters(Serializable::IArchive &ar)
+   {
+      bool nextIndent = false;
+      addParamComposite(ewaldInteraction_, nextIndent);
+      ewaldInteraction_.loadParameters(ar);
+      loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      order_ = 5;
+      loadParameter<int>(ar, "order", order_, false);
+      allocate();
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void SpmePotential::save(Serializable::OArchive &ar)
+   {
+      ewaldInteraction_.save(ar);
+      ar << gridDimensions_;
+      Parameter::saveOptional(ar, order_, true);
+   }
+
+   /*
+   * Total number of grid points.
+   */
+   int SpmePotential::nWave() const
+   {  return gridDimensions_[0]*gridDimensions_[1]*gridDimensions_[2]; }
+
+   /*
+   * Set decomposition, allocate grids and create FFTW plans (private).
+   */
+   void SpmePotential::allocate()
+   {
+      UTIL_CHECK(!isAllocated_);
+      for (int i = 0; i < Dimension; ++i) {
+         if (gridDimensions_[i] <= 0) {
+            UTIL_THROW("Nonpositive gridDimensions");
+         }
+         if (gridDimensions_[i] < order_) {
+            UTIL_THROW("gridDimensions must be >= order");
+         }
+      }
+      if (order_ < 2 || order_ > MaxOrder) {
+         UTIL_THROW("Invalid B-spline order");
+      }
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+
+      #ifdef UTIL_MPI
+      nProcessor_ = domain().communicator().Get_size();
+      rank_ = domain().communicator().Get_rank();
+      #else
+      nProcessor_ = 1;
+      rank_ = 0;
+      #endif
+
+      // Assign contiguous x planes (real space) and y planes (k-space)
+      xBegin_.allocate(nProcessor_ + 1);
+      yBegin_.allocate(nProcessor_ + 1);
+      for (int p = 0; p <= nProcessor_; ++p) {
+         xBegin_[p] = (p*n0)/nProcessor_;
+         yBegin_[p] = (p*n1)/nProcessor_;
+      }
+      xOwner_.allocate(n0);
+      for (int p = 0; p < nProcessor_; ++p) {
+         for (int x = xBegin_[p]; x < xBegin_[p+1]; ++x) {
+            xOwner_[x] = p;
+         }
+      }
+      nxLocal_ = xBegin_[rank_ + 1] - xBegin_[rank_];
+      nyLocal_ = yBegin_[rank_ + 1] - yBegin_[rank_];
+
+      // Counts and displacements for the x to y transpose, in doubles
+      transposeSendCounts_.allocate(nProcessor_);
+      transposeSendDispls_.allocate(nProcessor_);
+      transposeRecvCounts_.allocate(nProcessor_);
+      transposeRecvDispls_.allocate(nProcessor_);
+      int sendTotal = 0;
+      int recvTotal = 0;
+      for (int p = 0; p < nProcessor_; ++p) {
+         transposeSendDispls_[p] = sendTotal;
+         transposeSendCounts_[p] = 2*nxLocal_*(yBegin_[p+1] - yBegin_[p])*n2;
+         sendTotal += transposeSendCounts_[p];
+         transposeRecvDispls_[p] = recvTotal;
+         transposeRecvCounts_[p] = 2*(xBegin_[p+1] - xBegin_[p])*nyLocal_*n2;
+         recvTotal += transposeRecvCounts_[p];
+      }
+      sendCounts_.allocate(nProcessor_);
+      sendDispls_.allocate(nProcessor_);
+      recvCounts_.allocate(nProcessor_);
+      recvDispls_.allocate(nProcessor_);
+      offsets_.allocate(nProcessor_);
+
+      // Allocate grids (at least one element, even if a slab is empty)
+      int slabSize = nxLocal_*n1*n2;
+      int pencilSize = nyLocal_*n2*n0;
+      int bufferSize = (slabSize > pencilSize) ? slabSize : pencilSize;
+      slab_.allocate(slabSize > 0 ? slabSize : 1);
+      pencil_.allocate(pencilSize > 0 ? pencilSize : 1);
+      g_.allocate(pencilSize > 0 ? pencilSize : 1);
+      sendTranspose_.allocate(bufferSize > 0 ? bufferSize : 1);
+      recvTranspose_.allocate(bufferSize > 0 ? bufferSize : 1);
+
+      // 2D transforms over (y, z) for each x plane of the local slab
+      if (nxLocal_ > 0) {
+         fftw_complex* data;
+         data = reinterpret_cast<fftw_complex*>(slab_.cArray());
+         int n[2];
+         n[0] = n1;
+         n[1] = n2;
+         slabForwardPlan_ =
+               fftw_plan_many_dft(2, n, nxLocal_, data, 0, 1, n1*n2,
+                                  data, 0, 1, n1*n2,
+                                  FFTW_FORWARD, FFTW_MEASURE);
+         slabBackwardPlan_ =
+               fftw_plan_many_dft(2, n, nxLocal_, data, 0, 1, n1*n2,
+                                  data, 0, 1, n1*n2,
+                                  FFTW_BACKWARD, FFTW_MEASURE);
+      }
+
+      // 1D transforms along contiguous x lines of the transposed slab
+      if (nyLocal_ > 0) {
+         fftw_complex* data;
+         data = reinterpret_cast<fftw_complex*>(pencil_.cArray());
+         int n = n0;
+         pencilForwardPlan_ =
+               fftw_plan_many_dft(1, &n, nyLocal_*n2, data, 0, 1, n0,
+                                  data, 0, 1, n0,
+                                  FFTW_FORWARD, FFTW_MEASURE);
+         pencilBackwardPlan_ =
+               fftw_plan_many_dft(1, &n, nyLocal_*n2, data, 0, 1, n0,
+                                  data, 0, 1, n0,
+                                  FFTW_BACKWARD, FFTW_MEASURE);
+      }
+
+      isAllocated_ = true;
+      unsetWaves();
+   }
+
+   /*
+   * Compute influence function for local k-space slab.
+   */
+   void SpmePotential::makeWaves()
+   {
+      UTIL_CHECK(isAllocated_);
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+
+      // B-factors for each direction
+      DArray<double> b0, b1, b2;
+      b0.allocate(n0);
+      b1.allocate(n1);
+      b2.allocate(n2);
+      for (int i = 0; i < n0; ++i) b0[i] = bFactor(i, 0);
+      for (int i = 0; i < n1; ++i) b1[i] = bFactor(i, 1);
+      for (int i = 0; i < n2; ++i) b2[i] = bFactor(i, 2);
+
+      Vector r0 = boundary().reciprocalBasisVector(0);
+      Vector r1 = boundary().reciprocalBasisVector(1);
+      Vector r2 = boundary().reciprocalBasisVector(2);
+      Vector q1, q2, q;
+      double qSq;
+      int y, rank;
+      rank = 0;
+      for (int yl = 0; yl < nyLocal_; ++yl) {
+         y = yBegin_[rank_] + yl;
+         q1.multiply(r1, waveIndex(y, n1));
+         for (int z = 0; z < n2; ++z) {
+            q2.multiply(r2, waveIndex(z, n2));
+            q2 += q1;
+            for (int x = 0; x < n0; ++x) {
+               q.multiply(r0, waveIndex(x, n0));
+               q += q2;
+               qSq = q.square();
+               if (qSq > 1.0E-10) {
+                  g_[rank] = b0[x]*b1[y]*b2[z]
+                           * ewaldInteraction_.kSpacePotential(qSq);
+               } else {
+                  g_[rank] = 0.0;
+               }
+               ++rank;
+            }
+         }
+      }
+      setHasWaves();
+   }
+
+   /*
+   * SPME B-factor |b(k)|^2 for one direction (private).
+   */
+   double SpmePotential::bFactor(int k, int dim) const
+   {
+      const int n = gridDimensions_[dim];
+
+      // Interpolation fails for odd order at the Nyquist wavenumber.
+      if (order_%2 == 1 && 2*k == n) {
+         return 0.0;
+      }
+
+      double m[MaxOrder];
+      double dm[MaxOrder];
+      bSplines(0.0, m, dm);
+
+      const double twoPi = 2.0*Constants::Pi;
+      DCMPLX denom(0.0, 0.0);
+      double arg;
+      for (int j = 0; j <= order_ - 2; ++j) {
+         arg = twoPi*double(k*j)/double(n);
+         denom += m[j+1]*DCMPLX(cos(arg), sin(arg));
+      }
+      return 1.0/std::norm(denom);
+   }
+
+   /*
+   * Compute B-spline weights M_n(w + j) and derivatives (private).
+   *
+   * Uses M_p(x) = [x M_{p-1}(x) + (p - x) M_{p-1}(x - 1)]/(p - 1)
+   * and dM_n(x)/dx = M_{n-1}(x) - M_{n-1}(x - 1).
+   */
+   void SpmePotential::bSplines(double w, double* m, double* dm) const
+   {
+      int j, p;
+      m[0] = 1.0;
+      for (j = 1; j < order_; ++j) {
+         m[j] = 0.0;
+      }
+      for (p = 2; p <= order_; ++p) {
+         if (p == order_) {
+            dm[0] = m[0];
+            for (j = 1; j < order_; ++j) {
+               dm[j] = m[j] - m[j-1];
+            }
+         }
+         for (j = p - 1; j > 0; --j) {
+            m[j] = ((w + j)*m[j] + (p - w - j)*m[j-1])/double(p - 1);
+         }
+         m[0] = w*m[0]/double(p - 1);
+      }
+   }
+
+   /*
+   * Spread charges of local atoms onto the local brick (private).
+   */
+   void SpmePotential::spreadCharges()
+   {
+      UTIL_CHECK(storage().isCartesian());
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      AtomIterator iter;
+      Vector s;
+      IntVector floorIdx;
+      IntVector upper;
+      double charge;
+      int i;
+      bool hasCharge = false;
+
+      // Find bounds of brick containing all local charges
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         charge = simulation().atomType(iter->typeId()).charge();
+         if (charge == 0.0) continue;
+         boundary().transformCartToGen(iter->position(), s);
+         floorIdx[0] = int(floor(s[0]*n0));
+         floorIdx[1] = int(floor(s[1]*n1));
+         floorIdx[2] = int(floor(s[2]*n2));
+         if (!hasCharge) {
+            for (i = 0; i < Dimension; ++i) {
+               brickLower_[i] = floorIdx[i] - (order_ - 1);
+               upper[i] = floorIdx[i];
+            }
+            hasCharge = true;
+         } else {
+            for (i = 0; i < Dimension; ++i) {
+               if (floorIdx[i] - (order_ - 1) < brickLower_[i]) {
+                  brickLower_[i] = floorIdx[i] - (order_ - 1);
+               }
+               if (floorIdx[i] > upper[i]) {
+                  upper[i] = floorIdx[i];
+               }
+            }
+         }
+      }
+      if (hasCharge) {
+         for (i = 0; i < Dimension; ++i) {
+            brickDimensions_[i] = upper[i] - brickLower_[i] + 1;
+         }
+      } else {
+         brickLower_ = IntVector(0);
+         brickDimensions_ = IntVector(0);
+      }
+      const int b1 = brickDimensions_[1];
+      const int b2 = brickDimensions_[2];
+      const int size = brickDimensions_[0]*b1*b2;
+      brick_.resize(size);
+      for (i = 0; i < size; ++i) {
+         brick_[i] = 0.0;
+      }
+      if (!hasCharge) return;
+
+      // Spread charges
+      double mx[MaxOrder], my[MaxOrder], mz[MaxOrder];
+      double dm[MaxOrder];
+      double u[Dimension];
+      double wxy;
+      int ix, iy, iz, jx, jy;
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         charge = simulation().atomType(iter->typeId()).charge();
+         if (charge == 0.0) continue;
+         boundary().transformCartToGen(iter->position(), s);
+         for (i = 0; i < Dimension; ++i) {
+            u[i] = s[i]*gridDimensions_[i];
+            floorIdx[i] = int(floor(u[i]));
+         }
+         bSplines(u[0] - floorIdx[0], mx, dm);
+         bSplines(u[1] - floorIdx[1], my, dm);
+         bSplines(u[2] - floorIdx[2], mz, dm);
+         for (ix = 0; ix < order_; ++ix) {
+            jx = (floorIdx[0] - ix - brickLower_[0])*b1;
+            for (iy = 0; iy < order_; ++iy) {
+               jy = (jx + floorIdx[1] - iy - brickLower_[1])*b2
+                  + floorIdx[2] - brickLower_[2];
+               wxy = charge*mx[ix]*my[iy];
+               for (iz = 0; iz < order_; ++iz) {
+                  brick_[jy - iz] += wxy*mz[iz];
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Send brick planes to slab owners, add them to slab (private).
+   */
+   void SpmePotential::sendBrick()
+   {
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      const int b0 = brickDimensions_[0];
+      const int b1 = brickDimensions_[1];
+      const int b2 = brickDimensions_[2];
+      const int planeSize = b1*b2;
+      const int recordSize = HeaderSize + planeSize;
+      int p, gx, x, i, pos;
+
+      // Count doubles sent to each slab owner
+      for (p = 0; p < nProcessor_; ++p) {
+         sendCounts_[p] = 0;
+      }
+      for (gx = brickLower_[0]; gx < brickLower_[0] + b0; ++gx) {
+         sendCounts_[xOwner_[modulo(gx, n0)]] += recordSize;
+      }
+      pos = 0;
+      for (p = 0; p < nProcessor_; ++p) {
+         sendDispls_[p] = pos;
+         offsets_[p] = pos;
+         pos += sendCounts_[p];
+      }
+      sendBuffer_.resize(pos);
+
+      // Pack one record per brick plane
+      for (gx = brickLower_[0]; gx < brickLower_[0] + b0; ++gx) {
+         x = modulo(gx, n0);
+         p = xOwner_[x];
+         pos = offsets_[p];
+         sendBuffer_[pos] = double(x);
+         sendBuffer_[pos + 1] = double(brickLower_[1]);
+         sendBuffer_[pos + 2] = double(b1);
+         sendBuffer_[pos + 3] = double(brickLower_[2]);
+         sendBuffer_[pos + 4] = double(b2);
+         pos += HeaderSize;
+         const int first = (gx - brickLower_[0])*planeSize;
+         for (i = 0; i < planeSize; ++i) {
+            sendBuffer_[pos + i] = brick_[first + i];
+         }
+         offsets_[p] += recordSize;
+      }
+
+      // Exchange record counts, then records
+      #ifdef UTIL_MPI
+      domain().communicator().Alltoall(&sendCounts_[0], 1, MPI::INT,
+                                       &recvCounts_[0], 1, MPI::INT);
+      #else
+      recvCounts_[0] = sendCounts_[0];
+      #endif
+      pos = 0;
+      for (p = 0; p < nProcessor_; ++p) {
+         recvDispls_[p] = pos;
+         pos += recvCounts_[p];
+      }
+      recvBuffer_.resize(pos);
+      exchange(sendBuffer_.cArray(), sendCounts_, sendDispls_,
+               recvBuffer_.cArray(), recvCounts_, recvDispls_);
+
+      // Accumulate received planes into local slab
+      const int slabSize = nxLocal_*n1*n2;
+      for (i = 0; i < slabSize; ++i) {
+         slab_[i] = 0.0;
+      }
+      int end, lower1, lower2, c1, c2, xl, y, row, j, k;
+      for (p = 0; p < nProcessor_; ++p) {
+         pos = recvDispls_[p];
+         end = pos + recvCounts_[p];
+         while (pos < end) {
+            xl = int(recvBuffer_[pos]) - xBegin_[rank_];
+            lower1 = int(recvBuffer_[pos + 1]);
+            c1 = int(recvBuffer_[pos + 2]);
+            lower2 = int(recvBuffer_[pos + 3]);
+            c2 = int(recvBuffer_[pos + 4]);
+            pos += HeaderSize;
+            for (j = 0; j < c1; ++j) {
+               y = modulo(lower1 + j, n1);
+               row = (xl*n1 + y)*n2;
+               for (k = 0; k < c2; ++k) {
+                  slab_[row + modulo(lower2 + k, n2)] += recvBuffer_[pos];
+                  ++pos;
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Return potential on slab to the brick planes (private).
+   */
+   void SpmePotential::returnBrick()
+   {
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      int p, pos, end, lower1, lower2, c1, c2, xl, y, row, j, k;
+
+      // Overwrite values of received records with potential
+      for (p = 0; p < nProcessor_; ++p) {
+         pos = recvDispls_[p];
+         end = pos + recvCounts_[p];
+         while (pos < end) {
+            xl = int(recvBuffer_[pos]) - xBegin_[rank_];
+            lower1 = int(recvBuffer_[pos + 1]);
+            c1 = int(recvBuffer_[pos + 2]);
+            lower2 = int(recvBuffer_[pos + 3]);
+            c2 = int(recvBuffer_[pos + 4]);
+            pos += HeaderSize;
+            for (j = 0; j < c1; ++j) {
+               y = modulo(lower1 + j, n1);
+               row = (xl*n1 + y)*n2;
+               for (k = 0; k < c2; ++k) {
+                  recvBuffer_[pos] = std::real(slab_[row + modulo(lower2 + k, n2)]);
+                  ++pos;
+               }
+            }
+         }
+      }
+
+      // Return records along the reverse route
+      exchange(recvBuffer_.cArray(), recvCounts_, recvDispls_,
+               sendBuffer_.cArray(), sendCounts_, sendDispls_);
+
+      // Unpack records into brick, in the order in which they were packed
+      const int b0 = brickDimensions_[0];
+      const int planeSize = brickDimensions_[1]*brickDimensions_[2];
+      const int recordSize = HeaderSize + planeSize;
+      int gx, i;
+      for (p = 0; p < nProcessor_; ++p) {
+         offsets_[p] = sendDispls_[p];
+      }
+      for (gx = brickLower_[0]; gx < brickLower_[0] + b0; ++gx) {
+         p = xOwner_[modulo(gx, n0)];
+         pos = offsets_[p] + HeaderSize;
+         const int first = (gx - brickLower_[0])*planeSize;
+         for (i = 0; i < planeSize; ++i) {
+            brick_[first + i] = sendBuffer_[pos + i];
+         }
+         offsets_[p] += recordSize;
+      }
+   }
+
+   /*
+   * Forward 3D FFT from slab_ (x slab) to pencil_ (y slab) (private).
+   */
+   void SpmePotential::forwardTransform()
+   {
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      int p, xl, x, y, yl, z, k;
+
+      if (nxLocal_ > 0) {
+         fftw_execute(slabForwardPlan_);
+      }
+
+      // Pack slab columns by destination y slab
+      k = 0;
+      for (p = 0; p < nProcessor_; ++p) {
+         for (xl = 0; xl < nxLocal_; ++xl) {
+            for (y = yBegin_[p]; y < yBegin_[p+1]; ++y) {
+               for (z = 0; z < n2; ++z) {
+                  sendTranspose_[k] = slab_[(xl*n1 + y)*n2 + z];
+                  ++k;
+               }
+            }
+         }
+      }
+      exchange(reinterpret_cast<double*>(sendTranspose_.cArray()),
+               transposeSendCounts_, transposeSendDispls_,
+               reinterpret_cast<double*>(recvTranspose_.cArray()),
+               transposeRecvCounts_, transposeRecvDispls_);
+
+      // Unpack into contiguous x lines
+      k = 0;
+      for (p = 0; p < nProcessor_; ++p) {
+         for (x = xBegin_[p]; x < xBegin_[p+1]; ++x) {
+            for (yl = 0; yl < nyLocal_; ++yl) {
+               for (z = 0; z < n2; ++z) {
+                  pencil_[(yl*n2 + z)*n0 + x] = recvTranspose_[k];
+                  ++k;
+               }
+            }
+         }
+      }
+
+      if (nyLocal_ > 0) {
+         fftw_execute(pencilForwardPlan_);
+      }
+   }
+
+   /*
+   * Backward 3D FFT from pencil_ (y slab) to slab_ (x slab) (private).
+   */
+   void SpmePotential::backwardTransform()
+   {
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      int p, xl, x, y, yl, z, k;
+
+      if (nyLocal_ > 0) {
+         fftw_execute(pencilBackwardPlan_);
+      }
+
+      // Pack x lines by destination x slab
+      k = 0;
+      for (p = 0; p < nProcessor_; ++p) {
+         for (x = xBegin_[p]; x < xBegin_[p+1]; ++x) {
+            for (yl = 0; yl < nyLocal_; ++yl) {
+               for (z = 0; z < n2; ++z) {
+                  sendTranspose_[k] = pencil_[(yl*n2 + z)*n0 + x];
+                  ++k;
+               }
+            }
+         }
+      }
+      exchange(reinterpret_cast<double*>(sendTranspose_.cArray()),
+               transposeRecvCounts_, transposeRecvDispls_,
+               reinterpret_cast<double*>(recvTranspose_.cArray()),
+               transposeSendCounts_, transposeSendDispls_);
+
+      // Unpack into x slab
+      k = 0;
+      for (p = 0; p < nProcessor_; ++p) {
+         for (xl = 0; xl < nxLocal_; ++xl) {
+            for (y = yBegin_[p]; y < yBegin_[p+1]; ++y) {
+               for (z = 0; z < n2; ++z) {
+                  slab_[(xl*n1 + y)*n2 + z] = recvTranspose_[k];
+                  ++k;
+               }
+            }
+         }
+      }
+
+      if (nxLocal_ > 0) {
+         fftw_execute(slabBackwardPlan_);
+      }
+   }
+
+   /*
+   * Exchange variable length arrays among all processors (private).
+   */
+   void SpmePotential::exchange(double* sendData, DArray<int>& sendCounts,
+                                DArray<int>& sendDispls, double* recvData,
+                                DArray<int>& recvCounts,
+                                DArray<int>& recvDispls)
+   {
+      #ifdef UTIL_MPI
+      domain().communicator().Alltoallv(sendData, &sendCounts[0],
+                                        &sendDispls[0], MPI::DOUBLE,
+                                        recvData, &recvCounts[0],
+                                        &recvDispls[0], MPI::DOUBLE);
+      #else
+      UTIL_CHECK(sendCounts[0] == recvCounts[0]);
+      for (int i = 0; i < sendCounts[0]; ++i) {
+         recvData[recvDispls[0] + i] = sendData[sendDispls[0] + i];
+      }
+      #endif
+   }
+
+   /*
+   * Spread charges and compute Fourier amplitudes (private).
+   */
+   void SpmePotential::computeFourierCharges()
+   {
+      if (!hasWaves()) {
+         makeWaves();
+      }
+      spreadCharges();
+      sendBrick();
+      forwardTransform();
+   }
+
+   /*
+   * Compute potential on grid and add forces to local atoms (private).
+   *
+   * Requires Fourier amplitudes computed by computeFourierCharges().
+   */
+   void SpmePotential::addForces()
+   {
+      // Potential in k-space, then transform back to r-space brick
+      const double volume = boundary().volume();
+      const int pencilSize = nyLocal_*gridDimensions_[1]*gridDimensions_[0];
+      int i;
+      for (i = 0; i < pencilSize; ++i) {
+         pencil_[i] *= g_[i]/volume;
+      }
+      backwardTransform();
+      returnBrick();
+
+      // Columns of d(grid coordinate)/d(position), times 2 pi.
+      Vector r[Dimension];
+      for (i = 0; i < Dimension; ++i) {
+         r[i] = boundary().reciprocalBasisVector(i);
+         r[i] *= double(gridDimensions_[i])/(2.0*Constants::Pi);
+      }
+
+      const int b1 = brickDimensions_[1];
+      const int b2 = brickDimensions_[2];
+      AtomIterator iter;
+      Vector s, f, t;
+      IntVector floorIdx;
+      double mx[MaxOrder], my[MaxOrder], mz[MaxOrder];
+      double dmx[MaxOrder], dmy[MaxOrder], dmz[MaxOrder];
+      double u[Dimension];
+      double g0, g1, g2, phi, charge;
+      int ix, iy, iz, jx, jy;
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         charge = simulation().atomType(iter->typeId()).charge();
+         if (charge == 0.0) continue;
+         boundary().transformCartToGen(iter->position(), s);
+         for (i = 0; i < Dimension; ++i) {
+            u[i] = s[i]*gridDimensions_[i];
+            floorIdx[i] = int(floor(u[i]));
+         }
+         bSplines(u[0] - floorIdx[0], mx, dmx);
+         bSplines(u[1] - floorIdx[1], my, dmy);
+         bSplines(u[2] - floorIdx[2], mz, dmz);
+
+         // Gradient of interpolated potential in grid coordinates
+         g0 = g1 = g2 = 0.0;
+         for (ix = 0; ix < order_; ++ix) {
+            jx = (floorIdx[0] - ix - brickLower_[0])*b1;
+            for (iy = 0; iy < order_; ++iy) {
+               jy = (jx + floorIdx[1] - iy - brickLower_[1])*b2
+                  + floorIdx[2] - brickLower_[2];
+               for (iz = 0; iz < order_; ++iz) {
+                  phi = brick_[jy - iz];
+                  g0 += dmx[ix]*my[iy]*mz[iz]*phi;
+                  g1 += mx[ix]*dmy[iy]*mz[iz]*phi;
+                  g2 += mx[ix]*my[iy]*dmz[iz]*phi;
+               }
+            }
+         }
+         f.multiply(r[0], g0);
+         t.multiply(r[1], g1);
+         f += t;
+         t.multiply(r[2], g2);
+         f += t;
+         f *= -charge;
+         iter->force() += f;
+      }
+   }
+
+   /*
+   * Local k-space energy, from Fourier amplitudes (private).
+   */
+   double SpmePotential::localEnergy()
+   {
+      const int pencilSize = nyLocal_*gridDimensions_[1]*gridDimensions_[0];
+      double energy = 0.0;
+      for (int i = 0; i < pencilSize; ++i) {
+         energy += g_[i]*std::norm(pencil_[i]);
+      }
+      return energy/(2.0*boundary().volume());
+   }
+
+   /*
+   * Local self-energy correction (private).
+   */
+   double SpmePotential::localSelfEnergy()
+   {
+      AtomIterator iter;
+      double charge;
+      double sum = 0.0;
+      storage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         charge = simulation().atomType(iter->typeId()).charge();
+         sum += charge*charge;
+      }
+      const double pi = Constants::Pi;
+      return sum*ewaldInteraction_.alpha()
+             /(4.0*sqrt(pi)*pi*ewaldInteraction_.epsilon());
+   }
+
+   /*
+   * Local k-space stress, from Fourier amplitudes (private).
+   */
+   Tensor SpmePotential::localStress()
+   {
+      const int n0 = gridDimensions_[0];
+      const int n1 = gridDimensions_[1];
+      const int n2 = gridDimensions_[2];
+      const double alpha = ewaldInteraction_.alpha();
+      const double ca = 0.25/(alpha*alpha);
+      Vector r0 = boundary().reciprocalBasisVector(0);
+      Vector r1 = boundary().reciprocalBasisVector(1);
+      Vector r2 = boundary().reciprocalBasisVector(2);
+      Vector q1, q2, q;
+      Tensor K, stress;
+      double qSq;
+      int y, rank;
+
+      stress.zero();
+      rank = 0;
+      for (int yl = 0; yl < nyLocal_; ++yl) {
+         y = yBegin_[rank_] + yl;
+         q1.multiply(r1, waveIndex(y, n1));
+         for (int z = 0; z < n2; ++z) {
+            q2.multiply(r2, waveIndex(z, n2));
+            q2 += q1;
+            for (int x = 0; x < n0; ++x) {
+               if (g_[rank] != 0.0) {
+                  q.multiply(r0, waveIndex(x, n0));
+                  q += q2;
+                  qSq = q.square();
+                  K.dyad(q, q);
+                  K *= -2.0*(ca + 1.0/qSq);
+                  K.add(Tensor::Identity, K);
+                  K *= g_[rank]*std::norm(pencil_[rank]);
+                  stress += K;
+               }
+               ++rank;
+            }
+         }
+      }
+      double volume = boundary().volume();
+      stress /= 2.0*volume*volume;
+      return stress;
+   }
+
+   /*
+   * Add k-space forces to local atoms.
+   */
+   void SpmePotential::computeForces()
+   {
+      computeFourierCharges();
+      addForces();
+   }
+
+   /*
+   * Compute total k-space and self energy.
+   */
+   #ifdef UTIL_MPI
+   void SpmePotential::computeEnergy(MPI::Intracomm& communicator)
+   #else
+   void SpmePotential::computeEnergy()
+   #endif
+   {
+      if (isEnergySet()) return;
+      computeFourierCharges();
+      double energy = localEnergy() - localSelfEnergy();
+      #ifdef UTIL_MPI
+      reduceEnergy(energy, communicator);
+      #else
+      setEnergy(energy);
+      #endif
+   }
+
+   /*
+   * Compute total k-space stress.
+   */
+   #ifdef UTIL_MPI
+   void SpmePotential::computeStress(MPI::Intracomm& communicator)
+   #else
+   void SpmePotential::computeStress()
+   #endif
+   {
+      if (isStressSet()) return;
+      computeFourierCharges();
+      Tensor stress = localStress();
+      #ifdef UTIL_MPI
+      reduceStress(stress, communicator);
+      #else
+      setStress(stress);
+      #endif
+   }
+
+   /*
+   * Add forces and compute stress, using one forward transform.
+   */
+   #ifdef UTIL_MPI
+   void SpmePotential::computeForcesAndStress(MPI::Intracomm& communicator)
+   #else
+   void SpmePotential::computeForcesAndStress()
+   #endif
+   {
+      computeFourierCharges();
+      Tensor stress = localStress();
+      addForces();
+      #ifdef UTIL_MPI
+      reduceStress(stress, communicator);
+      #else
+      setStress(stress);
+      #endif
+   }
+
+}
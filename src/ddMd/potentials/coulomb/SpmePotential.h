@@ -0,0 +1,332 @@
+#ifndef DDMD_SPME_POTENTIAL_H
+#define DDMD_SPME_POTENTIAL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/potentials/coulomb/CoulombPotential.h>  // base class
+#include <util/space/IntVector.h>                      // member
+#include <util/space/Tensor.h>                         // argument
+#include <util/containers/DArray.h>                    // member
+#include <util/containers/GArray.h>                    // member
+
+#include <complex>
+#include <fftw3.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Smooth particle-mesh Ewald (SPME) k-space Coulomb potential.
+   *
+   * The charge density is interpolated onto a regular grid with
+   * cardinal B-splines, transformed with a distributed 3D FFT,
+   * multiplied by the SPME influence function, and transformed back
+   * to obtain the electrostatic potential on the grid, from which
+   * forces are obtained by analytic differentiation of the B-splines.
+   *
+   * The grid is decomposed into slabs of contiguous planes of constant
+   * x index, one slab per processor. The 3D FFT is performed as 2D
+   * transforms within each slab, followed by an all-to-all transpose
+   * to a decomposition into slabs of constant y index, and 1D
+   * transforms along x. The k-space influence function, energy and
+   * stress are evaluated in the transposed decomposition.
+   *
+   * Each processor spreads the charges of its local atoms onto a local
+   * brick of grid points that covers its domain, plus order - 1 extra
+   * planes. The planes of this brick are sent to the processors that
+   * own the corresponding slab, and the potential is returned along
+   * the same route in reverse, so that each processor communicates
+   * only with the slab owners that overlap its own domain.
+   *
+   * Pairs that are masked by the maskedPairPolicy (e.g., bonded pairs)
+   * are excluded only from the r-space sum computed by the pair 
+   * potential. The k-space sum includes all pairs, and no exclusion 
+   * correction -q_i q_j erf(alpha r)/(4 pi epsilon r) is subtracted, 
+   * so masked pairs interact through the smeared long-range potential
+   * q_i q_j erf(alpha r)/(4 pi epsilon r). This is the convention used
+   * by the McMd Ewald and SPME potentials.
+   *
+   * Parameter file format:
+   * \code
+   *    epsilon          double
+   *    alpha            double
+   *    rSpaceCutoff     double
+   *    gridDimensions   IntVector
+   *    order*           int  (5 by default)
+   * \endcode
+   *
+   * \ingroup DdMd_Coulomb_Module
+   */
+   class SpmePotential : public CoulombPotential
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation  parent Simulation
+      */
+      SpmePotential(Simulation& simulation);
+
+      /**
+      * Destructor (destroy FFTW plans).
+      */
+      virtual ~SpmePotential();
+
+      /// \name Initialization
+      //@{
+
+      /**
+      * Read parameters, allocate grids and create FFTW plans.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      //@}
+      /// \name Waves
+      //@{
+
+      /**
+      * Compute the influence function for the local k-space slab.
+      */
+      virtual void makeWaves();
+
+      /**
+      * Total number of grid points.
+      */
+      virtual int nWave() const;
+
+      //@}
+      /// \name Forces, energy and stress
+      //@{
+
+      /**
+      * Add k-space Coulomb forces to all local atoms.
+      *
+      * Call on all processors.
+      */
+      virtual void computeForces();
+
+      /**
+      * Compute k-space and self energy on all processors.
+      *
+      * \param communicator  domain communicator
+      */
+      #ifdef UTIL_MPI
+      virtual void computeEnergy(MPI::Intracomm& communicator);
+      #else
+      virtual void computeEnergy();
+      #endif
+
+      /**
+      * Compute k-space stress on all processors.
+      *
+      * \param communicator  domain communicator
+      */
+      #ifdef UTIL_MPI
+      virtual void computeStress(MPI::Intracomm& communicator);
+      #else
+      virtual void computeStress();
+      #endif
+
+      /**
+      * Compute forces and stress with a single forward transform.
+      *
+      * \param communicator  domain communicator
+      */
+      #ifdef UTIL_MPI
+      virtual void computeForcesAndStress(MPI::Intracomm& communicator);
+      #else
+      virtual void computeForcesAndStress();
+      #endif
+
+      //@}
+
+   private:
+
+      typedef std::complex<double> DCMPLX;
+
+      /// Number of header values in each brick plane record.
+      static const int HeaderSize = 5;
+
+      /// Maximum allowed B-spline order.
+      static const int MaxOrder = 10;
+
+      /// Number of grid points in each direction.
+      IntVector gridDimensions_;
+
+      /// Charges in the local x slab, layout [x][y][z].
+      DArray<DCMPLX> slab_;
+
+      /// Fourier amplitudes in the local y slab, layout [y][z][x].
+      DArray<DCMPLX> pencil_;
+
+      /// Influence function in the local y slab, layout [y][z][x].
+      DArray<double> g_;
+
+      /// Transpose buffers.
+      DArray<DCMPLX> sendTranspose_;
+      DArray<DCMPLX> recvTranspose_;
+
+      /// Charges, then potential, on the local brick, layout [x][y][z].
+      GArray<double> brick_;
+
+      /// Brick plane records sent to, and returned by, slab owners.
+      GArray<double> sendBuffer_;
+
+      /// Brick plane records received from, and returned to, bricks.
+      GArray<double> recvBuffer_;
+
+      /// First x plane of each slab (nProcessor + 1 elements).
+      DArray<int> xBegin_;
+
+      /// First y plane of each transposed slab (nProcessor + 1 elements).
+      DArray<int> yBegin_;
+
+      /// Owner of each x plane.
+      DArray<int> xOwner_;
+
+      /// Counts and displacements (in doubles) for brick exchanges.
+      DArray<int> sendCounts_;
+      DArray<int> sendDispls_;
+      DArray<int> recvCounts_;
+      DArray<int> recvDispls_;
+
+      /// Write position for each destination while packing records.
+      DArray<int> offsets_;
+
+      /// Counts and displacements (in doubles) for the x to y transpose.
+      DArray<int> transposeSendCounts_;
+      DArray<int> transposeSendDispls_;
+      DArray<int> transposeRecvCounts_;
+      DArray<int> transposeRecvDispls_;
+
+      /// Lower corner of the local brick (unwrapped grid indices).
+      IntVector brickLower_;
+
+      /// Dimensions of the local brick.
+      IntVector brickDimensions_;
+
+      /// FFTW plans for 2D transforms within the x slab.
+      fftw_plan slabForwardPlan_;
+      fftw_plan slabBackwardPlan_;
+
+      /// FFTW plans for 1D transforms along x in the y slab.
+      fftw_plan pencilForwardPlan_;
+      fftw_plan pencilBackwardPlan_;
+
+      /// Number of processors.
+      int nProcessor_;
+
+      /// Rank of this processor.
+      int rank_;
+
+      /// Number of x planes in the local x slab.
+      int nxLocal_;
+
+      /// Number of y planes in the local y slab.
+      int nyLocal_;
+
+      /// Order of the B-spline interpolation.
+      int order_;
+
+      /// Have grids been allocated and plans created?
+      bool isAllocated_;
+
+      /*
+      * Allocate grids, set decomposition and create FFTW plans.
+      */
+      void allocate();
+
+      /*
+      * Spread charges and compute Fourier amplitudes in pencil_.
+      */
+      void computeFourierCharges();
+
+      /*
+      * Spread charges of local atoms onto brick_.
+      */
+      void spreadCharges();
+
+      /*
+      * Send brick planes to slab owners and add them to slab_.
+      */
+      void sendBrick();
+
+      /*
+      * Return potential from slab_ to the brick planes of brick_.
+      */
+      void returnBrick();
+
+      /*
+      * Forward or backward transform of slab_ into pencil_.
+      */
+      void forwardTransform();
+      void backwardTransform();
+
+      /*
+      * Apply influence function, transform back, add forces.
+      */
+      void addForces();
+
+      /*
+      * Return the local k-space stress (before reduction).
+      */
+      Tensor localStress();
+
+      /*
+      * Return the local k-space energy (before reduction).
+      */
+      double localEnergy();
+
+      /*
+      * Return the local self-energy correction (before reduction).
+      */
+      double localSelfEnergy();
+
+      /*
+      * Compute B-spline weights m[j] = M_n(w + j) for j = 0,..,n-1,
+      * and their derivatives dm[j], for 0 <= w < 1.
+      */
+      void bSplines(double w, double* m, double* dm) const;
+
+      /*
+      * Compute SPME B-factor for wavenumber index k in direction dim.
+      */
+      double bFactor(int k, int dim) const;
+
+      /*
+      * All-to-all exchange of variable length double arrays.
+      */
+      void exchange(double* sendData, DArray<int>& sendCounts,
+                    DArray<int>& sendDispls, double* recvData,
+                    DArray<int>& recvCounts, DArray<int>& recvDispls);
+
+   };
+
+}
+#endif
@@ -0,0 +1,14 @@
+ddMd_potentials_coulomb_=\
+    ddMd/potentials/coulomb/CoulombPotential.cpp \
+    ddMd/potentials/coulomb/CoulombFactory.cpp 
+
+ifdef SIMP_FFTW
+ddMd_potentials_coulomb_+=\
+    ddMd/potentials/coulomb/SpmePotential.cpp 
+endif
+
+ddMd_potentials_coulomb_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(ddMd_potentials_coulomb_))
+ddMd_potentials_coulomb_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(ddMd_potentials_coulomb_:.cpp=.o))
+
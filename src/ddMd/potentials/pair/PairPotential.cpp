@@ -27,6 +27,7 @@ namespace DdMd
    */
    PairPotential::PairPotential()
     : skin_(0.0),
+      listSkin_(0.0),
       cutoff_(0.0),
       pairCapacity_(0),
       domainPtr_(0),
@@ -42,6 +43,7 @@ namespace DdMd
    */
    PairPotential::PairPotential(Simulation& simulation)
     : skin_(0.0),
+      listSkin_(0.0),
       cutoff_(0.0),
       pairCapacity_(0),
       domainPtr_(&simulation.domain()),
@@ -76,6 +78,7 @@ namespace DdMd
                                   int pairCapacity)
    {
       skin_ = skin;
+      listSkin_ = skin;
       pairCapacity_ = pairCapacity;
       maxBoundary_ = maxBoundary;
       cutoff_ = maxPairCutoff() + skin;
@@ -89,6 +92,11 @@ namespace DdMd
    void PairPotential::readParameters(std::istream& in)
    {
       read<double>(in, "skin", skin_);
+      listSkin_ = skin_; // Default value for optional parameter
+      readOptional<double>(in, "listSkin", listSkin_); 
+      if (listSkin_ <= 0.0 || listSkin_ > skin_) {
+         UTIL_THROW("Parameter listSkin must satisfy 0 < listSkin <= skin");
+      }
       nCellCut_ = 1; // Default value for optional parameter
       readOptional<int>(in, "nCellCut", nCellCut_); 
       read<int>(in, "pairCapacity", pairCapacity_);
@@ -104,6 +112,11 @@ namespace DdMd
    {
   
       loadParameter<double>(ar, "skin", skin_);
+      listSkin_ = skin_;
+      loadParameter<double>(ar, "listSkin", listSkin_, false);
+      if (listSkin_ <= 0.0 || listSkin_ > skin_) {
+         UTIL_THROW("Parameter listSkin must satisfy 0 < listSkin <= skin");
+      }
       loadParameter<int>(ar, "nCellCut", nCellCut_, false);
       loadParameter<int>(ar, "pairCapacity", pairCapacity_);
       loadParameter<Boundary>(ar, "maxBoundary", maxBoundary_);
@@ -120,6 +133,7 @@ namespace DdMd
    void PairPotential::save(Serializable::OArchive& ar)
    {
       ar << skin_;
+      Parameter::saveOptional(ar, listSkin_, isIncremental());
       Parameter::saveOptional(ar, nCellCut_, true);
       ar << pairCapacity_;
       ar << maxBoundary_;
@@ -136,7 +150,8 @@ namespace DdMd
    {
       // Allocate PairList
       int localCapacity = storage().atomCapacity();
-      pairList_.allocate(localCapacity, pairCapacity_, cutoff_);
+      double listCutoff = cutoff_ - skin_ + listSkin_;
+      pairList_.allocate(localCapacity, pairCapacity_, listCutoff);
 
       // Calculate cell list cutoff lengths for all directions
       Vector cutoffs;
@@ -211,6 +226,20 @@ namespace DdMd
       pairList_.build(cellList_, reverseUpdateFlag());
    }
 
+   /*
+   * Incrementally update the pair list.
+   */
+   void PairPotential::updatePairList()
+   {
+      if (!isIncremental()) {
+         return;
+      }
+      if (!storage().isCartesian()) {
+         UTIL_THROW("Coordinates not Cartesian entering updatePairList");
+      }
+      pairList_.update(cellList_, 0.25*listSkin_, reverseUpdateFlag());
+   }
+
    /*
    * Return value of pair energies.
    */
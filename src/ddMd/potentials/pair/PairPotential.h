@@ -221,6 +221,37 @@ namespace DdMd
       */
       void buildPairList();
 
+      /**
+      * Incrementally update the Verlet pair list, if enabled.
+      *
+      * Does nothing unless isIncremental(). Otherwise, recomputes pairs 
+      * only near atoms that have moved more than listSkin/4 since their 
+      * pairs were last computed (see PairList::update). This requires 
+      * only local and ghost positions, and no communication, but is 
+      * valid only if no atom has moved more than exchangeSkin()/2 since 
+      * the last exchange.
+      *
+      * Precondition: Atomic positions must be Cartesian.
+      */
+      void updatePairList();
+
+      /**
+      * Add forces for pairs that contain no ghost atoms.
+      *
+      * This method uses only positions of local atoms, and so may be 
+      * called while ghost positions are being updated. Calling 
+      * computeLocalForces() and then computeGhostForces() adds the
+      * same forces as computeForces().
+      */
+      virtual void computeLocalForces() = 0;
+
+      /**
+      * Add forces for pairs that contain a ghost atom.
+      *
+      * Completes a force calculation begun by computeLocalForces().
+      */
+      virtual void computeGhostForces() = 0;
+
       /**
       * Compute pair energies on all processors.
       *
@@ -288,7 +319,30 @@ namespace DdMd
       double skin() const;
 
       /**
-      * Get value of the pair list cutoff (maxPairCutoff + skin).
+      * Get value of the pair list skin used for incremental updates.
+      *
+      * Equal to skin() unless a smaller optional listSkin parameter 
+      * was read, in which case the pair list is built with a cutoff 
+      * maxPairCutoff + listSkin and updated incrementally between 
+      * exchanges.
+      */
+      double listSkin() const;
+
+      /**
+      * Are incremental pair list updates enabled (listSkin < skin)?
+      */
+      bool isIncremental() const;
+
+      /**
+      * Get the maximum displacement between exchanges, times two.
+      *
+      * Returns skin() if !isIncremental(), or skin() - listSkin() 
+      * otherwise.
+      */
+      double exchangeSkin() const;
+
+      /**
+      * Get value of the cell list and ghost cutoff (maxPairCutoff + skin).
       */
       double cutoff() const;
 
@@ -308,9 +362,12 @@ namespace DdMd
       /// Boundary used to allocate space for the cell list.
       Boundary maxBoundary_;
 
-      /// Difference between pairlist cutoff and pair potential cutoff. 
+      /// Difference between cell list cutoff and pair potential cutoff. 
       double skin_;
 
+      /// Difference between pair list cutoff and pair potential cutoff. 
+      double listSkin_;
+
       /// Minimum cell size = pair potential cutoff + skin.
       double cutoff_;
 
@@ -381,6 +438,15 @@ namespace DdMd
    inline double PairPotential::skin() const
    {  return skin_; }
 
+   inline double PairPotential::listSkin() const
+   {  return listSkin_; }
+
+   inline bool PairPotential::isIncremental() const
+   {  return (listSkin_ < skin_); }
+
+   inline double PairPotential::exchangeSkin() const
+   {  return isIncremental() ? (skin_ - listSkin_) : skin_; }
+
    inline double PairPotential::cutoff() const
    {  return cutoff_; }
 
@@ -14,6 +14,12 @@
 
 #include <algorithm>
 
+#ifdef DDMD_OPENMP
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+#include <omp.h>
+#endif
+
 // Block size used in cache-optimized algorithm
 #define PAIR_BLOCK_SIZE 16
 
@@ -193,6 +199,20 @@ namespace DdMd
       */
       virtual void computeForces();
 
+      /**
+      * Add forces for pairs that contain no ghost atoms.
+      *
+      * Uses only positions of local atoms. If methodId() != 0 (i.e., if
+      * no pair list is used) this method does nothing, and all forces
+      * are computed by computeGhostForces().
+      */
+      virtual void computeLocalForces();
+
+      /**
+      * Add forces for pairs that contain a ghost atom.
+      */
+      virtual void computeGhostForces();
+
       /**
       * Compute the total nonBonded pair energy for all processors
       * 
@@ -242,15 +262,32 @@ namespace DdMd
 
    private:
 
+      /*
+      * Selection of pairs included in a pair list force calculation.
+      */
+      enum PairSelect {ALL_PAIRS, LOCAL_PAIRS, GHOST_PAIRS};
+
       #ifdef PAIR_BLOCK_SIZE
       /*
-      * Struct used in inner-loop of cache-optimized algorithm.
+      * Block of pairs used in inner-loop of cache-optimized algorithm.
+      *
+      * Data for a block of up to PAIR_BLOCK_SIZE pairs is gathered 
+      * into separate contiguous arrays (a structure of arrays), so 
+      * that the loop that computes forceOverR for all pairs within 
+      * the cutoff reads only contiguous arrays of doubles and ints, 
+      * and contains no indirect loads. This allows the compiler to
+      * vectorize the force loop for simple inline interactions.
       */
-      struct PairForce {
-         Vector f;
-         double rsq;
-         Atom*  ptr0;
-         Atom*  ptr1;
+      struct PairBlock {
+         double dx[PAIR_BLOCK_SIZE];
+         double dy[PAIR_BLOCK_SIZE];
+         double dz[PAIR_BLOCK_SIZE];
+         double rsq[PAIR_BLOCK_SIZE];
+         double forceOverR[PAIR_BLOCK_SIZE];
+         int    type0[PAIR_BLOCK_SIZE];
+         int    type1[PAIR_BLOCK_SIZE];
+         Atom*  ptr0[PAIR_BLOCK_SIZE];
+         Atom*  ptr1[PAIR_BLOCK_SIZE];
       };
       #endif
 
@@ -267,8 +304,34 @@ namespace DdMd
       int nAtomType_;
 
       #ifdef PAIR_BLOCK_SIZE
-      PairForce pairs_[PAIR_BLOCK_SIZE];
-      PairForce* inPairs_[PAIR_BLOCK_SIZE];
+      /**
+      * Work space for cache-optimized pair list algorithm.
+      */
+      PairBlock block_;
+      #endif
+
+      #ifdef DDMD_OPENMP
+      /**
+      * Private force accumulators for all threads.
+      *
+      * The array for thread t begins at element t*n, where n is the
+      * number of local atoms, plus the number of ghosts if forces on
+      * ghosts are accumulated (reverse update). Forces are stored at
+      * the index given by threadIndex_. All elements are zero between
+      * calls to computeForcesListThreads.
+      */
+      DArray<Vector> threadForces_;
+
+      /**
+      * Index within each thread force array, indexed by arrayIndex for
+      * local atoms and by arrayIndex + atomCapacity for ghosts.
+      */
+      DArray<int> threadIndex_;
+
+      /**
+      * Atom associated with each index of a thread force array.
+      */
+      DArray<Atom*> threadAtoms_;
       #endif
 
       /**
@@ -283,8 +346,19 @@ namespace DdMd
 
       /**
       * Compute atomic pair forces, using PairList.
+      *
+      * \param select selects all pairs, or only local or ghost pairs
+      */
+      void computeForcesList(PairSelect select = ALL_PAIRS);
+
+      #ifdef DDMD_OPENMP
+      /**
+      * Compute atomic pair forces, using PairList and OpenMP threads.
+      *
+      * \param select selects all pairs, or only local or ghost pairs
       */
-      void computeForcesList();
+      void computeForcesListThreads(PairSelect select);
+      #endif
 
       /**
       * Compute atomic pair forces and/or pair potential energy.
@@ -474,6 +548,33 @@ namespace DdMd
        }
    }
 
+   /*
+   * Increment forces for pairs of local atoms.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeLocalForces()
+   {  
+       if (methodId() == 0) {
+          computeForcesList(LOCAL_PAIRS); 
+       }
+   }
+
+   /*
+   * Increment forces for pairs that contain a ghost.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeGhostForces()
+   {  
+       if (methodId() == 0) {
+          computeForcesList(GHOST_PAIRS); 
+       } else
+       if (methodId() == 1) {
+          computeForcesCell(); 
+       } else {
+          computeForcesNSq(); 
+       }
+   }
+
    /*
    * Compute total pair energy on all processors.
    */
@@ -544,22 +645,128 @@ namespace DdMd
    }
 
    /*
-   * Increment atomic forces and/or pair energy (private).
+   * Increment atomic forces, using the PairList (private).
+   *
+   * If select == LOCAL_PAIRS or GHOST_PAIRS, only pairs in which the
+   * secondary atom is local or ghost, respectively, are included. The
+   * primary atom of a pair is never a ghost.
    */
    template <class Interaction>
-   void PairPotentialImpl<Interaction>::computeForcesList()
+   void 
+   PairPotentialImpl<Interaction>::computeForcesList(PairSelect select)
    {
-      double rsq;
+      #ifdef DDMD_OPENMP
+      if (omp_get_max_threads() > 1) {
+         computeForcesListThreads(select);
+         return;
+      }
+      #endif
+
       PairIterator iter;
       Atom*  atom0Ptr;
       Atom*  atom1Ptr;
-      int    type0, type1;
 
-      if (reverseUpdateFlag()) {
+      #ifdef PAIR_BLOCK_SIZE
+      Vector f;
+      double cutoffSq;
+      int i, j, m, n;
+      bool reverse = reverseUpdateFlag();
+
+      pairList_.begin(iter);
+      j = pairList_.nPair();  // j = # of remaining unprocessed pairs
+      while (j) {
+
+         // Determine n = number of pairs in this block
+         n = std::min(PAIR_BLOCK_SIZE, j);
+
+         // Gather separation, rsq and atom types for each pair in block.
+         // Store only pairs with rsq < cutoffSq, compacting in place:
+         // Element i is always written to slot m <= i, but m is only
+         // incremented if the pair is within the cutoff.
+         m = 0;
+         for (i = 0; i < n; ++i) {
+            iter.getPair(atom0Ptr, atom1Ptr);
+            ++iter;
+            if (select != ALL_PAIRS) {
+               if (atom1Ptr->isGhost() != (select == GHOST_PAIRS)) {
+                  continue;
+               }
+            }
+            const Vector& r0 = atom0Ptr->position();
+            const Vector& r1 = atom1Ptr->position();
+            block_.dx[m] = r0[0] - r1[0];
+            block_.dy[m] = r0[1] - r1[1];
+            block_.dz[m] = r0[2] - r1[2];
+            block_.rsq[m] = block_.dx[m]*block_.dx[m] 
+                          + block_.dy[m]*block_.dy[m] 
+                          + block_.dz[m]*block_.dz[m];
+            block_.type0[m] = atom0Ptr->typeId();
+            block_.type1[m] = atom1Ptr->typeId();
+            block_.ptr0[m] = atom0Ptr;
+            block_.ptr1[m] = atom1Ptr;
+            cutoffSq = interactionPtr_->cutoffSq(block_.type0[m], 
+                                                 block_.type1[m]);
+            if (block_.rsq[m] < cutoffSq) {
+               ++m;
+            }
+         }
 
-         Vector f;
+         // Compute forceOverR for all m pairs with rsq < cutoff.
+         // This loop accesses only contiguous arrays in block_.
+         for (i = 0; i < m; ++i) {
+            block_.forceOverR[i] = 
+                interactionPtr_->forceOverR(block_.rsq[i], 
+                                            block_.type0[i], 
+                                            block_.type1[i]);
+         }
+
+         // Scatter forces back to atoms
+         if (reverse) {
+            for (i = 0; i < m; ++i) {
+               f[0] = block_.dx[i]*block_.forceOverR[i];
+               f[1] = block_.dy[i]*block_.forceOverR[i];
+               f[2] = block_.dz[i]*block_.forceOverR[i];
+               block_.ptr0[i]->force() += f;
+               block_.ptr1[i]->force() -= f;
+            }
+         } else {
+            for (i = 0; i < m; ++i) {
+               f[0] = block_.dx[i]*block_.forceOverR[i];
+               f[1] = block_.dy[i]*block_.forceOverR[i];
+               f[2] = block_.dz[i]*block_.forceOverR[i];
+               block_.ptr0[i]->force() += f;
+               if (!block_.ptr1[i]->isGhost()) {
+                  block_.ptr1[i]->force() -= f;
+               }
+            }
+         }
+
+         // Decrement number of remaining unprocessed pairs
+         j = j - n; 
+      }
+
+      #ifdef UTIL_DEBUG
+      if (j != 0) {
+         UTIL_THROW("Error in counting");
+      }
+      if (iter.notEnd()) {
+         UTIL_THROW("Error in iterator");
+      }
+      #endif // ifdef UTIL_DEBUG
+
+      #else  // ifndef PAIR_BLOCK_SIZE
+
+      Vector f;
+      double rsq;
+      int    type0, type1;
+      if (reverseUpdateFlag()) {
          for (pairList_.begin(iter); iter.notEnd(); ++iter) {
             iter.getPair(atom0Ptr, atom1Ptr);
+            if (select != ALL_PAIRS) {
+               if (atom1Ptr->isGhost() != (select == GHOST_PAIRS)) {
+                  continue;
+               }
+            }
             f.subtract(atom0Ptr->position(), atom1Ptr->position());
             rsq = f.square();
             type0 = atom0Ptr->typeId();
@@ -570,98 +777,185 @@ namespace DdMd
                atom1Ptr->force() -= f;
             }
          }
-
       } else {
+         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
+            iter.getPair(atom0Ptr, atom1Ptr);
+            if (select != ALL_PAIRS) {
+               if (atom1Ptr->isGhost() != (select == GHOST_PAIRS)) {
+                  continue;
+               }
+            }
+            f.subtract(atom0Ptr->position(), atom1Ptr->position());
+            rsq = f.square();
+            type0 = atom0Ptr->typeId();
+            type1 = atom1Ptr->typeId();
+            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+               f *= interactionPtr_->forceOverR(rsq, type0, type1);
+               atom0Ptr->force() += f;
+               if (!atom1Ptr->isGhost()) {
+                  atom1Ptr->force() -= f;
+               }
+            }
+         }
+      }
 
-         #ifdef PAIR_BLOCK_SIZE
-         PairForce* pairPtr;
-         Vector*    forcePtr;
-         int i, j, m, n;
+      #endif // ifdef PAIR_BLOCK_SIZE
+   }
 
-         pairList_.begin(iter);
-         j = pairList_.nPair();  // j = # of remaining unprocessed pairs
-         while (j) {
+   #ifdef DDMD_OPENMP
+   /*
+   * Increment atomic forces, using the PairList and threads (private).
+   *
+   * The pair list is divided into one partition per thread. Each thread
+   * accumulates forces in a private array, using the same blocked loop
+   * as computeForcesList(). Private arrays are indexed by a compact
+   * index of the local atoms (and ghosts, if reverse update is enabled),
+   * and so have one element per atom. Private arrays are then summed,
+   * added to atom forces and reset to zero, with each thread handling a
+   * different range of indices.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::computeForcesListThreads(PairSelect select)
+   {
+      const int atomCapacity = storage().atomCapacity();
+      const int maxThread = omp_get_max_threads();
+      const bool reverse = reverseUpdateFlag();
+
+      // Allocate index arrays, if necessary
+      const int capacity = atomCapacity + storage().ghostCapacity();
+      if (!threadIndex_.isAllocated()) {
+         threadIndex_.allocate(capacity);
+         threadAtoms_.allocate(capacity);
+      }
 
-            // Determine n = number of pairs in this block
-            n = std::min(PAIR_BLOCK_SIZE, j);
+      // Assign a compact index to each local atom, and to each ghost 
+      // if forces on ghosts are accumulated.
+      int j = 0;
+      AtomIterator atomIter;
+      for (storage().begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         threadIndex_[atomIter->arrayIndex()] = j;
+         threadAtoms_[j] = atomIter.get();
+         ++j;
+      }
+      if (reverse) {
+         GhostIterator ghostIter;
+         for (storage().begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+            threadIndex_[ghostIter->arrayIndex() + atomCapacity] = j;
+            threadAtoms_[j] = ghostIter.get();
+            ++j;
+         }
+      }
+      const int stride = j;
+      if (stride == 0) return;
+
+      // Allocate and zero private force arrays, if necessary. Elements
+      // are otherwise reset to zero by the reduction at the end of the
+      // previous call.
+      if (threadForces_.capacity() < maxThread*stride) {
+         if (threadForces_.isAllocated()) {
+            threadForces_.deallocate();
+         }
+         threadForces_.allocate(maxThread*stride);
+         for (int i = 0; i < threadForces_.capacity(); ++i) {
+            threadForces_[i].zero();
+         }
+      }
 
-            // Compute separation for each pair in block
-            for (i = 0; i < n; ++i) {
-               pairPtr = &pairs_[i];
+      #pragma omp parallel num_threads(maxThread)
+      {
+         PairBlock block;  // Thread-private block work space
+         PairIterator iter;
+         Vector f;
+         Atom* atom0Ptr;
+         Atom* atom1Ptr;
+         double cutoffSq;
+         int i, k, m, n;
+         const int nThread = omp_get_num_threads();
+         const int threadId = omp_get_thread_num();
+         Vector* forces = &threadForces_[threadId*stride];
+
+         pairList_.begin(iter, threadId, nThread);
+         while (iter.notEnd()) {
+
+            // Gather pairs within cutoff (as in computeForcesList)
+            m = 0;
+            for (n = 0; n < PAIR_BLOCK_SIZE && iter.notEnd(); ++n) {
                iter.getPair(atom0Ptr, atom1Ptr);
-               forcePtr = &(pairPtr->f);
-               forcePtr->subtract(atom0Ptr->position(), atom1Ptr->position());
-               pairPtr->ptr0 = atom0Ptr;
-               pairPtr->ptr1 = atom1Ptr;
-               pairPtr->rsq  = forcePtr->square();
                ++iter;
-            }
-
-            // Identify pairs in this block with rsq < cutoff
-            // Determine m = number of pairs with rsq < cutoff
-            m = 0; 
-            for (i = 0; i < n; ++i) {
-               pairPtr = &pairs_[i];
-               atom0Ptr = pairPtr->ptr0;
-               atom1Ptr = pairPtr->ptr1; 
-               type0 = atom0Ptr->typeId();
-               type1 = atom1Ptr->typeId();
-               inPairs_[m] = pairPtr;
-               if (pairPtr->rsq < interactionPtr_->cutoffSq(type0, type1)) {
+               if (select != ALL_PAIRS) {
+                  if (atom1Ptr->isGhost() != (select == GHOST_PAIRS)) {
+                     continue;
+                  }
+               }
+               const Vector& r0 = atom0Ptr->position();
+               const Vector& r1 = atom1Ptr->position();
+               block.dx[m] = r0[0] - r1[0];
+               block.dy[m] = r0[1] - r1[1];
+               block.dz[m] = r0[2] - r1[2];
+               block.rsq[m] = block.dx[m]*block.dx[m] 
+                            + block.dy[m]*block.dy[m] 
+                            + block.dz[m]*block.dz[m];
+               block.type0[m] = atom0Ptr->typeId();
+               block.type1[m] = atom1Ptr->typeId();
+               block.ptr0[m] = atom0Ptr;
+               block.ptr1[m] = atom1Ptr;
+               cutoffSq = interactionPtr_->cutoffSq(block.type0[m], 
+                                                    block.type1[m]);
+               if (block.rsq[m] < cutoffSq) {
                   ++m;
                }
             }
-              
-            // Compute and increment forces for pairs with rsq < cutoff 
+
+            // Compute forceOverR for all m pairs within the cutoff.
             for (i = 0; i < m; ++i) {
-               pairPtr =  inPairs_[i];
-               atom0Ptr = pairPtr->ptr0;
-               atom1Ptr = pairPtr->ptr1; 
-               forcePtr = &(pairPtr->f);
-               type0 = atom0Ptr->typeId();
-               type1 = atom1Ptr->typeId();
-               rsq   = pairPtr->rsq;
-               *forcePtr *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += *forcePtr;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= *forcePtr;
-               }
+               block.forceOverR[i] = 
+                   interactionPtr_->forceOverR(block.rsq[i], 
+                                               block.type0[i], 
+                                               block.type1[i]);
             }
 
-            // Decrement number of remaining unprocess pairs
-            j = j - n; 
-         }
-
-         #ifdef UTIL_DEBUG
-         if (j != 0) {
-            UTIL_THROW("Error in counting");
-         }
-         if (iter.notEnd()) {
-            UTIL_THROW("Error in iterator");
+            // Scatter forces to private arrays. Atom 0 is never a ghost.
+            for (i = 0; i < m; ++i) {
+               f[0] = block.dx[i]*block.forceOverR[i];
+               f[1] = block.dy[i]*block.forceOverR[i];
+               f[2] = block.dz[i]*block.forceOverR[i];
+               forces[threadIndex_[block.ptr0[i]->arrayIndex()]] += f;
+               if (!block.ptr1[i]->isGhost()) {
+                  k = threadIndex_[block.ptr1[i]->arrayIndex()];
+                  forces[k] -= f;
+               } else
+               if (reverse) {
+                  k = threadIndex_[block.ptr1[i]->arrayIndex() 
+                                   + atomCapacity];
+                  forces[k] -= f;
+               }
+            }
          }
-         #endif // ifdef UTIL_DEBUG
 
-         #else  // ifndef PAIR_BLOCK_SIZE
-
-         Vector f;
-         for (pairList_.begin(iter); iter.notEnd(); ++iter) {
-            iter.getPair(atom0Ptr, atom1Ptr);
-            f.subtract(atom0Ptr->position(), atom1Ptr->position());
-            rsq = f.square();
-            type0 = atom0Ptr->typeId();
-            type1 = atom1Ptr->typeId();
-            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
-               f *= interactionPtr_->forceOverR(rsq, type0, type1);
-               atom0Ptr->force() += f;
-               if (!atom1Ptr->isGhost()) {
-                  atom1Ptr->force() -= f;
-               }
+         // Wait until all threads have finished accumulating forces
+         #pragma omp barrier
+
+         // Each thread sums and zeroes private forces for a range of 
+         // indices, and adds the sums to the associated atoms.
+         const int begin = int(((long)stride*(long)threadId)/nThread);
+         const int end = int(((long)stride*(long)(threadId + 1))/nThread);
+         Vector* threadForcePtr;
+         Atom* atomPtr;
+         int t;
+         for (k = begin; k < end; ++k) {
+            atomPtr = threadAtoms_[k];
+            for (t = 0; t < nThread; ++t) {
+               threadForcePtr = &threadForces_[t*stride + k];
+               atomPtr->force() += *threadForcePtr;
+               threadForcePtr->zero();
             }
          }
-         #endif // ifdef PAIR_BLOCK_SIZE
 
-      }
+      } // end omp parallel
+
    }
+   #endif // ifdef DDMD_OPENMP
 
    /*
    * Increment atomic forces and/or pair energy (private).
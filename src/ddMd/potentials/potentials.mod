@@ -44,4 +44,11 @@ namespace DdMd
    * \brief    Classes that represent external one-body potentials.
    */
 
+   /**
+   * \defgroup DdMd_Coulomb_Module Coulomb Potentials
+   * \ingroup DdMd_Potential_Module
+   *
+   * \brief    Classes that compute long-range Coulomb interactions.
+   */
+
 }
@@ -39,6 +39,10 @@
 #include <ddMd/potentials/external/ExternalPotentialImpl.h>
 #include <ddMd/potentials/external/ExternalFactory.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#include <ddMd/potentials/coulomb/CoulombFactory.h>
+#endif
 
 // namespace Simp
 #include <simp/ensembles/EnergyEnsemble.h>
@@ -111,6 +115,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       externalPotentialPtr_(0),
       #endif
+      #ifdef SIMP_COULOMB
+      coulombPotentialPtr_(0),
+      #endif
       integratorPtr_(0),
       energyEnsemblePtr_(0),
       boundaryEnsemblePtr_(0),
@@ -134,6 +141,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       externalFactoryPtr_(0),
       #endif
+      #ifdef SIMP_COULOMB
+      coulombFactoryPtr_(0),
+      #endif
       integratorFactoryPtr_(0),
       configIoFactoryPtr_(0),
       pairStyle_(),
@@ -149,6 +159,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       externalStyle_(),
       #endif
+      #ifdef SIMP_COULOMB
+      coulombStyle_(),
+      #endif
       nAtomType_(0),
       #ifdef SIMP_BOND
       nBondType_(0),
@@ -162,6 +175,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       hasExternal_(false),
       #endif
+      #ifdef SIMP_COULOMB
+      hasCoulomb_(false),
+      #endif
       hasAtomContext_(false),
       maskedPairPolicy_(MaskBonded),
       reverseUpdateFlag_(false),
@@ -254,6 +270,14 @@ namespace DdMd
          delete externalPotentialPtr_;
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (coulombFactoryPtr_) {
+         delete coulombFactoryPtr_;
+      }
+      if (coulombPotentialPtr_) {
+         delete coulombPotentialPtr_;
+      }
+      #endif
       if (configIoFactoryPtr_) {
          delete configIoFactoryPtr_;
       }
@@ -513,6 +537,10 @@ namespace DdMd
       hasExternal_ = false;
       readOptional<bool>(in, "hasExternal", hasExternal_); 
       #endif
+      #ifdef SIMP_COULOMB
+      hasCoulomb_ = false;
+      readOptional<bool>(in, "hasCoulomb", hasCoulomb_); 
+      #endif
 
       hasAtomContext_ = false;
       readOptional<bool>(in, "hasAtomContext", hasAtomContext_); 
@@ -522,6 +550,9 @@ namespace DdMd
       atomTypes_.allocate(nAtomType_);
       for (int i = 0; i < nAtomType_; ++i) {
          atomTypes_[i].setId(i);
+         #ifdef SIMP_COULOMB
+         atomTypes_[i].setHasCharge(hasCoulomb_);
+         #endif
       }
       readDArray<AtomType>(in, "atomTypes", atomTypes_, nAtomType_);
 
@@ -548,6 +579,19 @@ namespace DdMd
 
       // Create and read potential energy classes
 
+      #ifdef SIMP_COULOMB
+      // Coulomb potential (read first, because the pair potential
+      // evaluates the Ewald r-space term with its parameters)
+      if (hasCoulomb_) {
+         assert(coulombPotentialPtr_ == 0);
+         coulombPotentialPtr_ = coulombFactory().factory(coulombStyle());
+         if (!coulombPotentialPtr_) {
+            UTIL_THROW("Unknown coulombStyle");
+         }
+         readParamComposite(in, *coulombPotentialPtr_);
+      }
+      #endif
+
       // Pair Potential
       assert(pairPotentialPtr_ == 0);
       pairPotentialPtr_ = pairFactory().factory(pairStyle());
@@ -705,6 +749,10 @@ namespace DdMd
       hasExternal_ = false;
       loadParameter<bool>(ar, "hasExternal", hasExternal_, false); // opt
       #endif
+      #ifdef SIMP_COULOMB
+      hasCoulomb_ = false;
+      loadParameter<bool>(ar, "hasCoulomb", hasCoulomb_, false); // opt
+      #endif
 
       hasAtomContext_ = false;
       loadParameter<bool>(ar, "hasAtomContext", hasAtomContext_, false); // opt
@@ -713,6 +761,9 @@ namespace DdMd
       atomTypes_.allocate(nAtomType_);
       for (int i = 0; i < nAtomType_; ++i) {
          atomTypes_[i].setId(i);
+         #ifdef SIMP_COULOMB
+         atomTypes_[i].setHasCharge(hasCoulomb_);
+         #endif
       }
       loadDArray<AtomType>(ar, "atomTypes", atomTypes_, nAtomType_);
 
@@ -738,6 +789,18 @@ namespace DdMd
       // Load potentials styles and parameters
       loadPotentialStyles(ar);
 
+      #ifdef SIMP_COULOMB
+      // Coulomb potential
+      assert(coulombPotentialPtr_ == 0);
+      if (hasCoulomb_) {
+         coulombPotentialPtr_ = coulombFactory().factory(coulombStyle());
+         if (!coulombPotentialPtr_) {
+            UTIL_THROW("Unknown coulombStyle");
+         }
+         loadParamComposite(ar, *coulombPotentialPtr_);
+      }
+      #endif
+
       // Pair Potential
       assert(pairPotentialPtr_ == 0);
       pairPotentialPtr_ = pairFactory().factory(pairStyle());
@@ -850,8 +913,28 @@ namespace DdMd
 
       isInitialized_ = true;
 
-      // Load the configuration (boundary + positions + groups)
-      serializeConfigIo().loadConfig(ar, maskedPairPolicy_);
+      // Load the configuration (boundary + positions + groups), either
+      // from the restart file or from a companion file written by a
+      // collective ConfigIo.
+      bool isCollective = false;
+      if (isIoProcessor()) {
+         ar >> isCollective;
+      }
+      bcast<bool>(domain_.communicator(), isCollective, 0);
+      if (isCollective) {
+         std::string className;
+         std::string configFileName;
+         if (isIoProcessor()) {
+            ar >> className;
+            ar >> configFileName;
+         }
+         bcast<std::string>(domain_.communicator(), className, 0);
+         bcast<std::string>(domain_.communicator(), configFileName, 0);
+         setConfigIo(className);
+         configIo().readCollective(configFileName, maskedPairPolicy_);
+      } else {
+         serializeConfigIo().loadConfig(ar, maskedPairPolicy_);
+      }
 
       // There are no ghosts yet, so exchange.
       exchanger_.exchange();
@@ -909,6 +992,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       Parameter::saveOptional(ar, hasExternal_, hasExternal_);
       #endif
+      #ifdef SIMP_COULOMB
+      Parameter::saveOptional(ar, hasCoulomb_, hasCoulomb_);
+      #endif
       Parameter::saveOptional(ar, hasAtomContext_, hasAtomContext_);
       ar << atomTypes_;
 
@@ -934,6 +1020,11 @@ namespace DdMd
 
       // Potential energy styles and potential classes
       savePotentialStyles(ar);
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().save(ar);
+      }
+      #endif
       pairPotential().save(ar);
       #ifdef SIMP_BOND
       if (nBondType_) {
@@ -1003,8 +1094,24 @@ namespace DdMd
          save(ar);
       }
 
-      // Save configuration (call on all processors)
-      serializeConfigIo().saveConfig(ar);
+      // Save configuration (call on all processors). A collective 
+      // ConfigIo writes a companion file, whose name is saved instead.
+      bool isCollective = configIo().isCollective();
+      if (isCollective) {
+         std::string configFileName = filename + ".cfg";
+         if (isIoProcessor()) {
+            std::string className = configIo().className();
+            ar << isCollective;
+            ar << className;
+            ar << configFileName;
+         }
+         configIo().writeCollective(configFileName);
+      } else {
+         if (isIoProcessor()) {
+            ar << isCollective;
+         }
+         serializeConfigIo().saveConfig(ar);
+      }
 
       if (isIoProcessor()) {
          ar.file().close();
@@ -1065,6 +1172,11 @@ namespace DdMd
          read<std::string>(in, "externalStyle", externalStyle_);
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         read<std::string>(in, "coulombStyle", coulombStyle_);
+      }
+      #endif
 
       // Read policy regarding whether to excluded pair interactions
       // between covalently bonded pairs.
@@ -1101,6 +1213,11 @@ namespace DdMd
          loadParameter<std::string>(ar, "externalStyle", externalStyle_);
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         loadParameter<std::string>(ar, "coulombStyle", coulombStyle_);
+      }
+      #endif
       loadParameter<MaskPolicy>(ar, "maskedPairPolicy", maskedPairPolicy_);
       loadParameter<bool>(ar, "reverseUpdateFlag", reverseUpdateFlag_);
 
@@ -1133,6 +1250,11 @@ namespace DdMd
          ar << externalStyle_;
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         ar << coulombStyle_;
+      }
+      #endif
       ar << maskedPairPolicy_;
       ar << reverseUpdateFlag_;
    }
@@ -1571,6 +1693,11 @@ namespace DdMd
          externalPotential().computeForces();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeForces();
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag_) {
@@ -1605,6 +1732,11 @@ namespace DdMd
          externalPotential().computeForces();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeForcesAndStress(domain_.communicator());
+      }
+      #endif
 
       // Reverse communication (if any)
       if (reverseUpdateFlag_) {
@@ -1769,6 +1901,11 @@ namespace DdMd
          externalPotential().computeEnergy(domain_.communicator());
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeEnergy(domain_.communicator());
+      }
+      #endif
    }
 
    #else
@@ -1798,6 +1935,11 @@ namespace DdMd
          externalPotential().computeEnergy();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeEnergy();
+      }
+      #endif
    }
    #endif
 
@@ -1838,6 +1980,11 @@ namespace DdMd
          energy += externalPotential().energy();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         energy += coulombPotential().energy();
+      }
+      #endif
       return energy;
    }
 
@@ -1867,6 +2014,11 @@ namespace DdMd
          externalPotential().unsetEnergy();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().unsetEnergy();
+      }
+      #endif
    }
 
    // --- Virial Stress Methods ----------------------------------------
@@ -1893,6 +2045,11 @@ namespace DdMd
          dihedralPotential().computeStress(domain_.communicator());
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeStress(domain_.communicator());
+      }
+      #endif
    }
    #else
    /*
@@ -1916,6 +2073,11 @@ namespace DdMd
          dihedralPotential().computeStress();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().computeStress();
+      }
+      #endif
    }
    #endif
 
@@ -1942,6 +2104,14 @@ namespace DdMd
          stress += dihedralPotential().stress();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         stress += coulombPotential().stress();
+      }
+      #endif
+      if (integratorPtr_) {
+         integratorPtr_->addConstraintStress(stress);
+      }
       return stress;
    }
 
@@ -1968,6 +2138,17 @@ namespace DdMd
          pressure += dihedralPotential().pressure();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         pressure += coulombPotential().pressure();
+      }
+      #endif
+      if (integratorPtr_) {
+         Tensor stress;
+         stress.zero();
+         integratorPtr_->addConstraintStress(stress);
+         pressure += (stress(0, 0) + stress(1, 1) + stress(2, 2))/3.0;
+      }
       return pressure;
    }
 
@@ -2017,6 +2198,11 @@ namespace DdMd
          dihedralPotential().unsetStress();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().unsetStress();
+      }
+      #endif
    }
 
    // --- ConfigIo Accessors -------------------------------------------
@@ -2052,10 +2238,16 @@ namespace DdMd
    // --- Config File Read and Write -----------------------------------
 
    /*
-   * Read configuration file on master and distribute atoms.
+   * Read configuration file and distribute atoms.
    */
    void Simulation::readConfig(const std::string& filename)
    {
+      if (configIo().isCollective()) {
+         std::string path = fileMaster().inputPrefix() + filename;
+         configIo().readCollective(path, maskedPairPolicy_);
+         exchanger_.exchange();
+         return;
+      }
       std::ifstream inputFile;
       if (domain_.isMaster()) {
          fileMaster().openInputFile(filename, inputFile);
@@ -2068,10 +2260,15 @@ namespace DdMd
    }
 
    /*
-   * Write configuration file on master.
+   * Write configuration file.
    */
    void Simulation::writeConfig(const std::string& filename)
    {
+      if (configIo().isCollective()) {
+         std::string path = fileMaster().outputPrefix() + filename;
+         configIo().writeCollective(path);
+         return;
+      }
       std::ofstream outputFile;
       if (domain_.isMaster()) {
          fileMaster().openOutputFile(filename, outputFile);
@@ -2182,6 +2379,26 @@ namespace DdMd
    {  return externalStyle_;  }
    #endif
 
+   #ifdef SIMP_COULOMB
+   /*
+   * Return the CoulombFactory by reference.
+   */
+   Factory<CoulombPotential>& Simulation::coulombFactory()
+   {
+      if (coulombFactoryPtr_ == 0) {
+         coulombFactoryPtr_ = new CoulombFactory(*this);
+      }
+      assert(coulombFactoryPtr_);
+      return *coulombFactoryPtr_;
+   }
+
+   /*
+   * Get the coulomb style string.
+   */
+   std::string Simulation::coulombStyle() const
+   {  return coulombStyle_;  }
+   #endif
+
    // --- Integrator and ConfigIo Management ---------------------------
 
    /*
@@ -2414,6 +2631,11 @@ namespace DdMd
          externalPotential().isValid(domain_.communicator());
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulomb_) {
+         coulombPotential().isValid(domain_.communicator());
+      }
+      #endif
       #endif // ifdef UTIL_MPI
 
       return true;
@@ -62,6 +62,9 @@ namespace DdMd
    #ifdef SIMP_EXTERNAL
    class ExternalPotential;
    #endif
+   #ifdef SIMP_COULOMB
+   class CoulombPotential;
+   #endif
 
    using namespace Util;
    using namespace Simp;
@@ -229,6 +232,11 @@ namespace DdMd
       * This function opens an archive file with a name given by filename
       * + ".rst" on the ioProcessor, calls save(Serializable::OArchive& ),
       * and closes the file.
+      *
+      * If the current ConfigIo is collective (ConfigIo::isCollective()),
+      * the configuration is instead written to a companion file named
+      * filename + ".cfg", and the archive records the ConfigIo class name
+      * and the companion file name.
       */
       void save(const std::string& filename);
 
@@ -291,6 +299,9 @@ namespace DdMd
       /**
       * Read configuration file on master and distribute atoms.
       *
+      * If the current ConfigIo is collective, the file is instead read 
+      * by all processors, by ConfigIo::readCollective().
+      *
       * Upon return, all processors should have all atoms and groups,
       * and a full set of ghost atoms, but values for the atomic
       * forces are undefined.
@@ -305,6 +316,9 @@ namespace DdMd
       /**
       * Write configuration file.
       *
+      * If the current ConfigIo is collective, the file is written by
+      * all processors, by ConfigIo::writeCollective().
+      *
       * \pre AtomStorage coordinates are generalized / scaled
       *
       * \param filename  name of output configuration file
@@ -613,6 +627,28 @@ namespace DdMd
       Factory<ExternalPotential>& externalFactory();
       #endif
 
+      #ifdef SIMP_COULOMB
+      /**
+      * Get the CoulombPotential by reference.
+      */
+      const CoulombPotential& coulombPotential() const;
+
+      /**
+      * Get the CoulombPotential by reference.
+      */
+      CoulombPotential& coulombPotential();
+
+      /**
+      * Return Coulomb potential style string.
+      */
+      std::string coulombStyle() const;
+
+      /**
+      * Get the associated Coulomb Factory by reference.
+      */
+      Factory<CoulombPotential>& coulombFactory();
+      #endif
+
       //@}
       /// \name Atom and Group Containers
       //@{
@@ -753,6 +789,13 @@ namespace DdMd
       bool hasExternal();
       #endif
 
+      #ifdef SIMP_COULOMB
+      /**
+      * Does this simulation have a Coulomb potential?
+      */
+      bool hasCoulomb();
+      #endif
+
       /**
       * Return the value of the mask policy (MaskNone or MaskBonded).
       */
@@ -936,6 +979,11 @@ namespace DdMd
       ExternalPotential* externalPotentialPtr_;
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Pointer to long-range Coulomb potential.
+      CoulombPotential* coulombPotentialPtr_;
+      #endif
+
       /// Pointer to MD integrator.
       Integrator* integratorPtr_;
 
@@ -985,6 +1033,11 @@ namespace DdMd
       Factory<ExternalPotential>* externalFactoryPtr_;
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Pointer to CoulombPotential Factory
+      Factory<CoulombPotential>* coulombFactoryPtr_;
+      #endif
+
       /// Pointer to MD integrator factory.
       Factory<Integrator>* integratorFactoryPtr_;
 
@@ -1014,6 +1067,11 @@ namespace DdMd
       std::string externalStyle_;
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Name of Coulomb potential style.
+      std::string coulombStyle_;
+      #endif
+
       /// Number of distinct atom types.
       int nAtomType_;
 
@@ -1037,6 +1095,11 @@ namespace DdMd
       bool hasExternal_;
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Does this simulation have a Coulomb potential?
+      bool hasCoulomb_;
+      #endif
+
       /// Does this simulation keep track of AtomContext info?
       bool hasAtomContext_;
 
@@ -1193,6 +1256,20 @@ namespace DdMd
    }
    #endif
 
+   #ifdef SIMP_COULOMB
+   inline const CoulombPotential& Simulation::coulombPotential() const
+   {
+      assert(coulombPotentialPtr_);
+      return *coulombPotentialPtr_;
+   }
+
+   inline CoulombPotential& Simulation::coulombPotential()
+   {
+      assert(coulombPotentialPtr_);
+      return *coulombPotentialPtr_;
+   }
+   #endif
+
    /// Get the MD integrator by reference.
    inline Integrator& Simulation::integrator()
    {
@@ -1269,6 +1346,12 @@ namespace DdMd
    {  return hasExternal_; }
    #endif
 
+   #ifdef SIMP_COULOMB
+   /// Does this simulation have a Coulomb potential?
+   inline bool Simulation::hasCoulomb()
+   {  return hasCoulomb_; }
+   #endif
+
    /// Get an AtomType descriptor for a specific type by reference.
    inline AtomType& Simulation::atomType(int i)
    {  return atomTypes_[i]; }
@@ -42,6 +42,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       externalPotentialPtr_(simulation.externalPotentialPtr_),
       #endif
+      #ifdef SIMP_COULOMB
+      coulombPotentialPtr_(simulation.coulombPotentialPtr_),
+      #endif
       energyEnsemblePtr_(simulation.energyEnsemblePtr_),
       boundaryEnsemblePtr_(simulation.boundaryEnsemblePtr_),
       randomPtr_(&simulation.random_),
@@ -61,6 +64,9 @@ namespace DdMd
       #ifdef SIMP_EXTERNAL
       hasExternal_(simulation.hasExternal_),
       #endif
+      #ifdef SIMP_COULOMB
+      hasCoulomb_(simulation.hasCoulomb_),
+      #endif
       maskedPairPolicy_(simulation.maskedPairPolicy_),
       reverseUpdateFlag_(simulation.reverseUpdateFlag_)
    {
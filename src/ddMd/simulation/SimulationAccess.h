@@ -42,6 +42,9 @@ namespace DdMd
    #ifdef SIMP_EXTERNAL
    class ExternalPotential;
    #endif
+   #ifdef SIMP_COULOMB
+   class CoulombPotential;
+   #endif
    class Domain;
    class Exchanger;
    class AtomType;
@@ -130,6 +133,11 @@ namespace DdMd
       /// Get the ExternalPotential.
       ExternalPotential& externalPotential();
       #endif
+
+      #ifdef SIMP_COULOMB
+      /// Get the CoulombPotential.
+      CoulombPotential& coulombPotential();
+      #endif
    
       /// Get the EnergyEnsemble.
       EnergyEnsemble& energyEnsemble();
@@ -172,6 +180,11 @@ namespace DdMd
       bool hasExternal();
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Does this simulation have a Coulomb potential?
+      bool hasCoulomb();
+      #endif
+
       /// Get an AtomType descriptor for atomtype i.
       AtomType& atomType(int i);
 
@@ -235,6 +248,11 @@ namespace DdMd
       ExternalPotential* externalPotentialPtr_;
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Pointer to long-range Coulomb potential.
+      CoulombPotential* coulombPotentialPtr_;
+      #endif
+
       /// Pointer to an EnergyEnsemble.
       EnergyEnsemble* energyEnsemblePtr_;
 
@@ -276,6 +294,11 @@ namespace DdMd
       bool hasExternal_;
       #endif
 
+      #ifdef SIMP_COULOMB
+      /// Does this simulation have a Coulomb potential?
+      bool hasCoulomb_;
+      #endif
+
       /**
       * Policy for suppressing pair interactions for some atom pairs.
       *
@@ -366,6 +389,14 @@ namespace DdMd
    }
    #endif
 
+   #ifdef SIMP_COULOMB
+   inline CoulombPotential& SimulationAccess::coulombPotential()
+   {  
+      assert(coulombPotentialPtr_);  
+      return *coulombPotentialPtr_; 
+   }
+   #endif
+
    inline EnergyEnsemble& SimulationAccess::energyEnsemble()
    {  return *energyEnsemblePtr_; }
 
@@ -407,6 +438,11 @@ namespace DdMd
    {  return hasExternal_; }
    #endif
 
+   #ifdef SIMP_COULOMB
+   inline bool SimulationAccess::hasCoulomb()
+   {  return hasCoulomb_; }
+   #endif
+
    inline AtomType& SimulationAccess::atomType(int i)
    {  return atomTypes_[i]; }
 
@@ -13,8 +13,11 @@
 #include <ddMd/chemistry/Group.h>
 #include <util/format/Int.h>
 #include <util/mpi/MpiLoader.h>
+#include <util/param/Parameter.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
@@ -36,6 +39,7 @@ namespace DdMd
       atomCapacity_(0),
       ghostCapacity_(0),
       totalAtomCapacity_(0),
+      sortInterval_(0),
       maxNAtomLocal_(0),
       maxNGhostLocal_(0),
       #ifdef UTIL_MPI
@@ -84,6 +88,8 @@ namespace DdMd
       read<int>(in, "atomCapacity", atomCapacity_);
       read<int>(in, "ghostCapacity", ghostCapacity_);
       read<int>(in, "totalAtomCapacity", totalAtomCapacity_);
+      sortInterval_ = 0; // Default value for optional parameter
+      readOptional<int>(in, "sortInterval", sortInterval_);
       allocate();
    }
 
@@ -95,6 +101,7 @@ namespace DdMd
       loadParameter<int>(ar, "atomCapacity", atomCapacity_);
       loadParameter<int>(ar, "ghostCapacity", ghostCapacity_);
       loadParameter<int>(ar, "totalAtomCapacity", totalAtomCapacity_);
+      loadParameter<int>(ar, "sortInterval", sortInterval_, false);
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(maxNAtomLocal_);
       loader.load(maxNGhostLocal_);
@@ -109,6 +116,7 @@ namespace DdMd
       ar << atomCapacity_;
       ar << ghostCapacity_;
       ar << totalAtomCapacity_;
+      Parameter::saveOptional(ar, sortInterval_, (bool)sortInterval_);
       ar << maxNAtomLocal_;
       ar << maxNGhostLocal_;
    }
@@ -424,6 +432,137 @@ namespace DdMd
       return max;
    }
 
+   // Spatial sorting
+
+   /*
+   * Reorder local atoms in memory along a Morton curve.
+   */
+   void AtomStorage::sortAtoms(const Vector& lower, const Vector& upper)
+   {
+      // Preconditions
+      if (locked_) {
+         UTIL_THROW("AtomStorage is locked");
+      }
+      if (newAtomPtr_ != 0) {
+         UTIL_THROW("Unregistered newAtomPtr_ still active");
+      }
+      if (nGhost() != 0) {
+         UTIL_THROW("Cannot sort atoms when ghosts exist");
+      }
+
+      // Allocate work space on first use
+      if (!sortKeys_.isAllocated()) {
+         sortKeys_.allocate(atomCapacity_);
+         sortDest_.allocate(atomCapacity_);
+         sortTemp_.allocate(1);
+      }
+
+      const int nBit = 10;
+      const int nGrid = 1 << nBit;
+      Vector scale;
+      int k;
+      for (k = 0; k < Dimension; ++k) {
+         scale[k] = double(nGrid)/(upper[k] - lower[k]);
+      }
+
+      // Compute Morton key and array index of every local atom
+      Atom* firstPtr = &atoms_[0];
+      AtomIterator iter;
+      int cell[Dimension];
+      unsigned int key;
+      int n = nAtom();
+      int i, b, c;
+      i = 0;
+      for (begin(iter); iter.notEnd(); ++iter) {
+         for (k = 0; k < Dimension; ++k) {
+            c = int((iter->position()[k] - lower[k])*scale[k]);
+            if (c < 0) c = 0;
+            if (c >= nGrid) c = nGrid - 1;
+            cell[k] = c;
+         }
+         key = 0;
+         for (b = 0; b < nBit; ++b) {
+            for (k = 0; k < Dimension; ++k) {
+               key |= ((cell[k] >> b) & 1u) << (Dimension*b + k);
+            }
+         }
+         sortKeys_[i].key = key;
+         sortKeys_[i].index = int(iter.get() - firstPtr);
+         ++i;
+      }
+      assert(i == n);
+      std::sort(&sortKeys_[0], &sortKeys_[0] + n);
+
+      // Remove all local atoms from the map and atom set, and empty
+      // the reservoir. These are rebuilt after atoms are moved.
+      Atom* atomPtr;
+      while (atomSet_.size() > 0) {
+         atomPtr = &atomSet_.pop();
+         map_.removeLocal(atomPtr);
+      }
+      while (atomReservoir_.size() > 0) {
+         atomReservoir_.pop();
+      }
+
+      // Atom with old index sortKeys_[i].index moves to element i.
+      // Set sortDest_[j] = new index of atom with old index j, or -1
+      // if element j does not contain a local atom.
+      for (i = 0; i < atomCapacity_; ++i) {
+         sortDest_[i] = -1;
+      }
+      for (i = 0; i < n; ++i) {
+         sortDest_[sortKeys_[i].index] = i;
+      }
+
+      /*
+      * Move atoms. Following the map i -> sortKeys_[i].index from any
+      * target element i < n that is initially empty gives a path that
+      * ends at an element >= n that is vacated. All other elements with 
+      * i < n belong to closed cycles, which require one temporary Atom.
+      * Upon completion of each move, sortDest_[i] is set to -2.
+      */
+      int source;
+      for (i = 0; i < n; ++i) {
+         if (sortDest_[i] == -1) {
+            k = i;
+            do {
+               source = sortKeys_[k].index;
+               atoms_[k] = atoms_[source];
+               sortDest_[k] = -2;
+               k = source;
+            } while (k < n);
+         }
+      }
+      for (i = 0; i < n; ++i) {
+         if (sortDest_[i] >= 0) {
+            if (sortKeys_[i].index == i) {
+               sortDest_[i] = -2;
+            } else {
+               sortTemp_[0] = atoms_[i];
+               k = i;
+               source = sortKeys_[k].index;
+               while (source != i) {
+                  atoms_[k] = atoms_[source];
+                  sortDest_[k] = -2;
+                  k = source;
+                  source = sortKeys_[k].index;
+               }
+               atoms_[k] = sortTemp_[0];
+               sortDest_[k] = -2;
+            }
+         }
+      }
+
+      // Rebuild reservoir, atom set and map, in order of new index
+      for (i = atomCapacity_ - 1; i >= n; --i) {
+         atomReservoir_.push(atoms_[i]);
+      }
+      for (i = 0; i < n; ++i) {
+         atomSet_.append(atoms_[i]);
+         map_.addLocal(&atoms_[i]);
+      }
+   }
+
    // Accessors
 
    /*
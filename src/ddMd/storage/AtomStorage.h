@@ -86,6 +86,7 @@ namespace DdMd
       *  - atomCapacity      [int]  max number of atoms owned by processor.
       *  - ghostCapacity     [int]  max number of ghosts on this processor.
       *  - totalatomCapacity [int]  max number of atoms on all processors.
+      *  - sortInterval      [int]  exchanges per sort (optional, 0=never)
       *
       * \param in input parameter stream.
       */
@@ -349,6 +350,40 @@ namespace DdMd
       */
       double maxSqDisplacement();
 
+      //@}
+      /// \name Spatial Sorting
+      //@{
+
+      /**
+      * Reorder local atoms in memory along a Morton (Z-order) curve.
+      *
+      * Copies the data for all local atoms into the first nAtom() 
+      * elements of the underlying AtomArray, in an order in which 
+      * atoms that are close in space are usually also close in memory. 
+      * The Morton key is computed on a 1024^3 grid spanning the 
+      * rectangular region between lower and upper, which should be 
+      * the bounds of the processor domain, in the same coordinates
+      * as the atom positions. Atoms outside this region are assigned 
+      * to the nearest boundary grid cell.
+      *
+      * Upon return, the atom set, reservoir and AtomMap are rebuilt, 
+      * but pointers to local atoms that are held by other objects 
+      * (e.g., in Groups, send arrays, or the cell and pair lists) are 
+      * invalid, and must be reset by the caller.
+      *
+      * \pre The storage may not be locked (i.e., no active snapshot).
+      * \pre There may be no ghost atoms.
+      *
+      * \param lower lower bounds of region used to compute sort keys
+      * \param upper upper bounds of region used to compute sort keys
+      */
+      void sortAtoms(const Vector& lower, const Vector& upper);
+
+      /**
+      * Number of atom exchanges per sort (0 if sorting is disabled).
+      */
+      int sortInterval() const;
+
       //@}
       /// \name Iteration
       //@{
@@ -528,6 +563,18 @@ namespace DdMd
 
    private:
 
+      /*
+      * Sort key and array index of a local atom, used by sortAtoms.
+      */
+      struct SortKey 
+      {
+         unsigned int key;
+         int index;
+
+         bool operator < (const SortKey& other) const
+         {  return key < other.key; }
+      };
+
       // Array that holds all available local Atom objects.
       AtomArray  atoms_;
 
@@ -552,6 +599,15 @@ namespace DdMd
       // Array of stored old positions.
       DArray<Vector>  snapshot_;
 
+      // Sort keys for local atoms (work space for sortAtoms).
+      DArray<SortKey>  sortKeys_;
+
+      // Destination index for each element of atoms_ (work space).
+      DArray<int>  sortDest_;
+
+      // Single temporary Atom used in cyclic permutation (work space).
+      AtomArray  sortTemp_;
+
       // Pointer to space for a new local Atom
       Atom*  newAtomPtr_;
 
@@ -567,6 +623,9 @@ namespace DdMd
       // Maximum number of atoms on all processors, maximum id + 1
       int  totalAtomCapacity_;
 
+      // Number of exchanges per spatial sort (0 if never sorted).
+      int  sortInterval_;
+
       /// Maximum number of atoms on this proc since stats cleared.
       int  maxNAtomLocal_; 
    
@@ -631,6 +690,9 @@ namespace DdMd
    inline int AtomStorage::totalAtomCapacity() const
    { return totalAtomCapacity_; }
 
+   inline int AtomStorage::sortInterval() const
+   { return sortInterval_; }
+
    inline bool AtomStorage::isCartesian() const
    { return isCartesian_; }
 
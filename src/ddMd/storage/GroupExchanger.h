@@ -110,6 +110,16 @@ namespace DdMd
       * \param atomStorage AtomStorage object used to find atom pointers
       */
       virtual void findGhosts(AtomStorage& atomStorage) = 0;
+
+      /**
+      * Reset pointers to all local atom members of groups.
+      *
+      * Usage: This is called after local atoms are moved in memory by
+      * AtomStorage::sortAtoms(), when there are no ghosts.
+      *
+      * \param atomStorage AtomStorage object used to find atom pointers
+      */
+      virtual void findLocals(AtomStorage& atomStorage) = 0;
    
       /**
       * Return true if the container is valid, or throw an Exception.
@@ -353,6 +353,17 @@ namespace DdMd
       */
       virtual
       void findGhosts(AtomStorage& atomStorage);
+
+      /**
+      * Reset pointers to all local atom members of groups.
+      *
+      * Usage: This is called after local atoms are moved in memory by
+      * AtomStorage::sortAtoms(), when there are no ghosts.
+      *
+      * \param atomStorage AtomStorage object used to find atom pointers
+      */
+      virtual
+      void findLocals(AtomStorage& atomStorage);
    
       /**
       * Return true if the container is valid, or throw an Exception.
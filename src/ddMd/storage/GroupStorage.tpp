@@ -823,5 +823,20 @@ namespace DdMd
       }
    }
 
+   /*
+   * Reset pointers to local atoms in all groups, after sorting.
+   */
+   template <int N>
+   void GroupStorage<N>::findLocals(AtomStorage& atomStorage)
+   {
+      GroupIterator<N> groupIter;
+      const AtomMap& atomMap = atomStorage.map();
+      for (begin(groupIter); groupIter.notEnd(); ++groupIter) {
+         if (atomMap.findGroupLocalAtoms(*groupIter) == 0) {
+            UTIL_THROW("Group with no local atoms after sorting");
+         }
+      }
+   }
+
 } // namespace DdMd
 #endif
@@ -0,0 +1,395 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/potentials/pair/PairPotentialImpl.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GhostIterator.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/communicate/Buffer.h>
+#include <ddMd/chemistry/Atom.h>
+#include <simp/interaction/pair/LJPair.h>
+#include <simp/boundary/Boundary.h>
+#include <simp/tests/bench/BenchmarkReport.h>
+#include <util/random/Random.h>
+#include <util/misc/Timer.h>
+
+#include <unistd.h>
+#include <cmath>
+#include <fstream>
+
+using namespace DdMd;
+using namespace Simp;
+using namespace Util;
+
+/**
+* Benchmarks of DdMd kernels on a single processor.
+*
+* Each system is constructed directly in an AtomStorage, in generalized
+* coordinates, with periodic images of atoms that lie within the pair
+* cutoff plus skin of a face of the box added as ghosts. This gives
+* the same local and ghost atom sets as an Exchanger would on a 1x1x1
+* processor grid, without the communication.
+*
+* Chains are random walks with bond length 0.97. No bond potential or
+* pair masks are used, so the chain systems differ from the liquids
+* only in local structure.
+*/
+class DdBench
+{
+
+public:
+
+   DdBench()
+    : nRep_(10),
+      nAtom_(0)
+   {  random_.setSeed(20); }
+
+   /**
+   * Read parameter file.
+   */
+   void readParam(const std::string& fileName)
+   {
+      pairPotential_.setNAtomType(1);
+      pairPotential_.associate(domain_, boundary_, storage_);
+      domain_.setBoundary(boundary_);
+      #ifdef UTIL_MPI
+      domain_.setGridCommunicator(MPI::COMM_WORLD);
+      #endif
+
+      std::ifstream in(fileName.c_str());
+      if (!in.is_open()) {
+         UTIL_THROW("Error opening parameter file");
+      }
+      domain_.readParam(in);
+      storage_.readParam(in);
+      pairPotential_.readParam(in);
+      #ifdef UTIL_MPI
+      buffer_.readParam(in);
+      #endif
+      in.close();
+   }
+
+   /**
+   * Generate a cubic system of about nAtom atoms.
+   *
+   * \param nAtomMolecule number of atoms per chain (1 for a liquid)
+   * \param nAtom   requested number of atoms
+   * \param density atom number density
+   */
+   void generate(int nAtomMolecule, int nAtom, double density)
+   {
+      int nMolecule = nAtom/nAtomMolecule;
+      nAtom_ = nMolecule*nAtomMolecule;
+      double length = std::pow(double(nAtom_)/density, 1.0/3.0);
+      if (storage_.isCartesian()) {
+         storage_.transformCartToGen(boundary_);
+      }
+      boundary_.setCubic(length);
+
+      storage_.clearGhosts();
+      storage_.clearAtoms();
+
+      // Place local atoms in generalized coordinates in [0,1)
+      Vector r;
+      Vector u;
+      Atom*  ptr;
+      int id = 0;
+      int i, j, k;
+      if (nAtomMolecule == 1) {
+         int nSide = int(std::ceil(std::pow(double(nAtom_), 1.0/3.0)));
+         double a = 1.0/double(nSide);
+         for (i = 0; i < nAtom_; ++i) {
+            r[0] = (double(i%nSide) + random_.uniform(0.0, 0.2))*a;
+            r[1] = (double((i/nSide)%nSide) + random_.uniform(0.0, 0.2))*a;
+            r[2] = (double(i/(nSide*nSide)) + random_.uniform(0.0, 0.2))*a;
+            addAtom(id, r);
+            ++id;
+         }
+      } else {
+         double step = 0.97/length;
+         for (i = 0; i < nMolecule; ++i) {
+            for (k = 0; k < Dimension; ++k) {
+               r[k] = random_.uniform(0.0, 1.0);
+            }
+            for (j = 0; j < nAtomMolecule; ++j) {
+               if (j > 0) {
+                  random_.unitVector(u);
+                  for (k = 0; k < Dimension; ++k) {
+                     r[k] += step*u[k];
+                     if (r[k] >= 1.0) r[k] -= 1.0;
+                     if (r[k] <  0.0) r[k] += 1.0;
+                  }
+               }
+               addAtom(id, r);
+               ++id;
+            }
+         }
+      }
+
+      // Add periodic images within the ghost margin as ghosts
+      double margin = pairPotential_.cutoff()/length;
+      AtomIterator atomIter;
+      IntVector shift;
+      bool isGhost;
+      storage_.begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         for (i = 0; i < 27; ++i) {
+            if (i == 13) continue;
+            shift[0] = i%3 - 1;
+            shift[1] = (i/3)%3 - 1;
+            shift[2] = i/9 - 1;
+            isGhost = true;
+            for (k = 0; k < Dimension; ++k) {
+               r[k] = atomIter->position()[k] + double(shift[k]);
+               if (r[k] < -margin || r[k] > 1.0 + margin) {
+                  isGhost = false;
+               }
+            }
+            if (isGhost) {
+               ptr = storage_.newGhostPtr();
+               ptr->setId(atomIter->id());
+               ptr->setTypeId(0);
+               ptr->position() = r;
+               storage_.addNewGhost();
+            }
+         }
+      }
+   }
+
+   /**
+   * Time construction of the cell list.
+   */
+   void benchCellList(BenchmarkReport& report,
+                      const std::string& name, double density)
+   {
+      Timer timer;
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         timer.start();
+         pairPotential_.buildCellList();
+         timer.stop();
+         storage_.transformGenToCart(boundary_);
+         storage_.transformCartToGen(boundary_);
+      }
+      report.add("DdMd::CellList::build", name, nAtom_, density,
+                 nRep_, timer.time(), 0.0);
+   }
+
+   /**
+   * Time construction of the Verlet pair list from the cell list.
+   *
+   * Upon return, coordinates are Cartesian.
+   */
+   void benchPairList(BenchmarkReport& report,
+                      const std::string& name, double density)
+   {
+      pairPotential_.buildCellList();
+      storage_.transformGenToCart(boundary_);
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         pairPotential_.buildPairList();
+      }
+      timer.stop();
+      double nPair = double(pairPotential_.pairList().nPair());
+      report.add("DdMd::PairList::build", name, nAtom_, density,
+                 nRep_, timer.time(), nPair);
+   }
+
+   /**
+   * Time pair force calculation, using the existing pair list.
+   */
+   void benchPairForces(BenchmarkReport& report,
+                        const std::string& name, double density)
+   {
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         zeroForces();
+         pairPotential_.computeForces();
+      }
+      timer.stop();
+      double nPair = double(pairPotential_.pairList().nPair());
+      report.add("DdMd::PairPotentialImpl::computeForces", name, nAtom_,
+                 density, nRep_, timer.time(), nPair);
+   }
+
+   #ifdef UTIL_MPI
+   /**
+   * Time packing of all local atoms into a send buffer.
+   */
+   void benchPack(BenchmarkReport& report,
+                  const std::string& name, double density)
+   {
+      AtomIterator atomIter;
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         buffer_.clearSendBuffer();
+         buffer_.beginSendBlock(Buffer::ATOM);
+         storage_.begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            atomIter->packAtom(buffer_);
+         }
+         buffer_.endSendBlock();
+      }
+      timer.stop();
+      report.add("DdMd::Atom::packAtom", name, nAtom_, density,
+                 nRep_, timer.time(), 0.0);
+
+      timer.clear();
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         buffer_.clearSendBuffer();
+         buffer_.beginSendBlock(Buffer::UPDATE);
+         storage_.begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            atomIter->packUpdate(buffer_);
+         }
+         buffer_.endSendBlock();
+      }
+      timer.stop();
+      report.add("DdMd::Atom::packUpdate", name, nAtom_, density,
+                 nRep_, timer.time(), 0.0);
+   }
+   #endif
+
+   /**
+   * Run all benchmarks for all systems.
+   */
+   void run(BenchmarkReport& report)
+   {
+      const int nSize = 3;
+      const int sizes[nSize] = {1000, 4000, 16000};
+      const int nDensity = 2;
+      const double densities[nDensity] = {0.6, 0.85};
+      const int nSystem = 2;
+      const char* names[nSystem] = {"lj", "chain"};
+      const int chainLengths[nSystem] = {1, 32};
+
+      int iSystem, iSize, iDensity;
+      double density;
+      for (iSystem = 0; iSystem < nSystem; ++iSystem) {
+         for (iSize = 0; iSize < nSize; ++iSize) {
+            for (iDensity = 0; iDensity < nDensity; ++iDensity) {
+               density = densities[iDensity];
+               generate(chainLengths[iSystem], sizes[iSize], density);
+               benchCellList(report, names[iSystem], density);
+               benchPairList(report, names[iSystem], density);
+               benchPairForces(report, names[iSystem], density);
+               #ifdef UTIL_MPI
+               benchPack(report, names[iSystem], density);
+               #endif
+            }
+         }
+      }
+   }
+
+   /**
+   * Set number of repetitions of each kernel.
+   */
+   void setNRep(int nRep)
+   {  nRep_ = nRep; }
+
+private:
+
+   Boundary boundary_;
+   Domain domain_;
+   AtomStorage storage_;
+   PairPotentialImpl<LJPair> pairPotential_;
+   #ifdef UTIL_MPI
+   Buffer buffer_;
+   #endif
+   Random random_;
+   int nRep_;
+   int nAtom_;
+
+   /*
+   * Add a local atom of type 0 at generalized position r.
+   */
+   void addAtom(int id, const Vector& r)
+   {
+      Atom* ptr = storage_.newAtomPtr();
+      ptr->setId(id);
+      ptr->setTypeId(0);
+      ptr->position() = r;
+      ptr->velocity().zero();
+      storage_.addNewAtom();
+   }
+
+   /*
+   * Set forces on all local and ghost atoms to zero.
+   */
+   void zeroForces()
+   {
+      AtomIterator  atomIter;
+      storage_.begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         atomIter->force().zero();
+      }
+      GhostIterator ghostIter;
+      storage_.begin(ghostIter);
+      for ( ; ghostIter.notEnd(); ++ghostIter) {
+         ghostIter->force().zero();
+      }
+   }
+
+};
+
+/*
+* Usage: DdBench [-o output.json] [-b baseline.json] [-t tol] [-r nRep]
+*
+* Must be run on a single processor. Returns a nonzero exit status if
+* any kernel is slower than the baseline by more than a fraction tol
+* (default 0.10).
+*/
+int main(int argc, char **argv)
+{
+   #ifdef UTIL_MPI
+   MPI::Init();
+   IntVector::commitMpiType();
+   Vector::commitMpiType();
+   #endif
+
+   std::string outFileName;
+   std::string baselineFileName;
+   double tolerance = 0.10;
+   int nRep = 10;
+   int c;
+   while ((c = getopt(argc, argv, "o:b:t:r:")) != -1) {
+      switch (c) {
+      case 'o':
+         outFileName = optarg;
+         break;
+      case 'b':
+         baselineFileName = optarg;
+         break;
+      case 't':
+         tolerance = atof(optarg);
+         break;
+      case 'r':
+         nRep = atoi(optarg);
+         break;
+      default:
+         std::cerr << "Unknown option" << std::endl;
+         return 1;
+      }
+   }
+
+   DdBench bench;
+   bench.readParam("in/DdBench");
+   bench.setNRep(nRep);
+   BenchmarkReport report;
+   bench.run(report);
+   int nRegression = report.output(outFileName, baselineFileName, tolerance);
+
+   #ifdef UTIL_MPI
+   MPI::Finalize();
+   #endif
+
+   return (nRegression > 0) ? 2 : 0;
+}
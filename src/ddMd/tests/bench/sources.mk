@@ -0,0 +1,8 @@
+ddMd_tests_bench_=ddMd/tests/bench/DdBench.cc
+
+ddMd_tests_bench_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(ddMd_tests_bench_))
+ddMd_tests_bench_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(ddMd_tests_bench_:.cc=.o))
+ddMd_tests_bench_EXES=\
+     $(addprefix $(BLD_DIR)/, $(ddMd_tests_bench_:.cc=))
@@ -19,6 +19,7 @@
 #include <test/ParamFileTest.h>
 
 #include <iostream>
+#include <cmath>
 
 using namespace Util;
 using namespace Simp;
@@ -131,6 +132,94 @@ public:
 
    }
 
+   void testBalance()
+   {  
+      printMethod(TEST_FUNC); 
+
+      Boundary boundary; 
+      domain_.setBoundary(boundary);
+
+      #if UTIL_MPI
+      openFile("in/Domain"); 
+      #else
+      openFile("in/Domain.111"); 
+      domain_.setRank(0);
+      #endif
+      domain_.readParam(file()); 
+
+      // Load increases with grid coordinate 0
+      double load = 1.0 + double(domain_.gridCoordinate(0));
+      Vector minWidths(0.01);
+      Vector maxDisplacements(0.0);
+      domain_.balance(load, minWidths, maxDisplacements);
+
+      int n = domain_.gridDimension(0);
+      double lower = domain_.domainBound(0, 0);
+      double upper = domain_.domainBound(0, 1);
+      TEST_ASSERT(lower < upper);
+      if (domain_.gridCoordinate(0) == 0) {
+         TEST_ASSERT(eq(lower, 0.0));
+         if (n > 1) {
+            // Least loaded slab should grow
+            TEST_ASSERT(upper > 1.0/double(n));
+         }
+      }
+      if (domain_.gridCoordinate(0) == n - 1) {
+         TEST_ASSERT(eq(upper, 1.0));
+      }
+
+      // Check consistency of ownerRank and isInDomain with bounds
+      Vector center;
+      for (int i = 0; i < Dimension; ++i) {
+         center[i] = 0.5*(domain_.domainBound(i, 0) 
+                        + domain_.domainBound(i, 1));
+      }
+      TEST_ASSERT(domain_.isInDomain(center));
+      TEST_ASSERT(domain_.ownerRank(center) == domain_.gridRank());
+   }
+
+   void testBalanceDisplacement()
+   {  
+      printMethod(TEST_FUNC); 
+
+      Boundary boundary; 
+      domain_.setBoundary(boundary);
+
+      #if UTIL_MPI
+      openFile("in/Domain"); 
+      #else
+      openFile("in/Domain.111"); 
+      domain_.setRank(0);
+      #endif
+      domain_.readParam(file()); 
+
+      // Strongly increasing load would shift bounds by the full 0.49 
+      // of a slab width, but atoms may have moved 0.8 of a slab width.
+      double load = 1.0 + 100.0*double(domain_.gridCoordinate(0));
+      Vector minWidths(0.01);
+      Vector maxDisplacements;
+      int i, j, n, c;
+      for (i = 0; i < Dimension; ++i) {
+         maxDisplacements[i] = 0.8/double(domain_.gridDimension(i));
+      }
+      domain_.balance(load, minWidths, maxDisplacements);
+
+      // No bound may move by more than 0.2 of a slab width
+      double width;
+      for (i = 0; i < Dimension; ++i) {
+         n = domain_.gridDimension(i);
+         c = domain_.gridCoordinate(i);
+         width = 1.0/double(n);
+         for (j = 0; j < 2; ++j) {
+            TEST_ASSERT(std::abs(domain_.domainBound(i, j) - (c + j)*width)
+                        < 0.2*width + 1.0E-10);
+         }
+      }
+      if (domain_.gridCoordinate(0) == 0 && domain_.gridDimension(0) > 1) {
+         TEST_ASSERT(domain_.domainBound(0, 1) > 1.0/domain_.gridDimension(0));
+      }
+   }
+
    #if UTIL_MPI
    void testPing()
    {  
@@ -186,6 +275,8 @@ public:
 
 TEST_BEGIN(DomainTest)
 TEST_ADD(DomainTest, testReadParam)
+TEST_ADD(DomainTest, testBalance)
+TEST_ADD(DomainTest, testBalanceDisplacement)
 #ifdef UTIL_MPI
 TEST_ADD(DomainTest, testPing)
 #endif
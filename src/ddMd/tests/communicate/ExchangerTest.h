@@ -71,6 +71,7 @@ public:
    void testDistribute();
    void testExchange();
    void testGhostUpdate();
+   void testNonBlockingGhostUpdate();
    void testGhostUpdateCycle();
    void testExchangeUpdateCycle();
 
@@ -369,6 +370,48 @@ void ExchangerTest::testGhostUpdate()
 
 }
 
+void ExchangerTest::testNonBlockingGhostUpdate()
+{
+   printMethod(TEST_FUNC);
+
+   GhostIterator  ghostIter;
+   DArray<Vector> ghostPositions;
+   int i;
+
+   double range = 0.1;
+   displaceAtoms(range);
+
+   atomStorage.clearSnapshot();
+   exchanger.exchange();
+   exchangeNotify();
+   atomStorage.transformGenToCart(boundary);
+   atomStorage.makeSnapshot();
+
+   // Update ghost positions with blocking update, and store positions
+   exchanger.update();
+   int nGhost = atomStorage.nGhost();
+   ghostPositions.allocate(nGhost);
+   i = 0;
+   for (atomStorage.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      ghostPositions[i] = ghostIter->position();
+      ghostIter->position().zero();
+      ++i;
+   }
+
+   // Repeat with non-blocking update, and compare
+   exchanger.beginUpdate();
+   exchanger.endUpdate();
+   TEST_ASSERT(nGhost == atomStorage.nGhost());
+   i = 0;
+   for (atomStorage.begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+      TEST_ASSERT(ghostIter->position() == ghostPositions[i]);
+      ++i;
+   }
+
+   atomStorage.transformCartToGen(boundary);
+   TEST_ASSERT(atomStorage.isValid());
+}
+
 void ExchangerTest::testGhostUpdateCycle()
 {
    printMethod(TEST_FUNC);
@@ -627,6 +670,7 @@ TEST_BEGIN(ExchangerTest)
 TEST_ADD(ExchangerTest, testDistribute)
 TEST_ADD(ExchangerTest, testExchange)
 TEST_ADD(ExchangerTest, testGhostUpdate)
+TEST_ADD(ExchangerTest, testNonBlockingGhostUpdate)
 TEST_ADD(ExchangerTest, testGhostUpdateCycle)
 TEST_ADD(ExchangerTest, testExchangeUpdateCycle)
 TEST_END(ExchangerTest)
@@ -0,0 +1,19 @@
+#include "ParallelConfigIoTest.h"
+
+int main()
+{
+   #ifdef UTIL_MPI
+   MPI::Init();
+   IntVector::commitMpiType();
+   Vector::commitMpiType();
+   #endif
+
+   TEST_RUNNER(ParallelConfigIoTest) runner;
+   runner.run();
+
+   #ifdef UTIL_MPI
+   MPI::Finalize();
+   #endif
+
+}
+
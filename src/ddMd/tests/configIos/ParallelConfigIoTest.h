@@ -0,0 +1,222 @@
+#ifndef DDMD_PARALLEL_CONFIG_IO_TEST_H
+#define DDMD_PARALLEL_CONFIG_IO_TEST_H
+
+#include <ddMd/configIos/DdMdConfigIo.h>
+#include <ddMd/configIos/DdMdParallelConfigIo.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/communicate/Buffer.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/storage/GroupStorage.tpp>
+#include <ddMd/storage/BondStorage.h>
+#include <ddMd/storage/AngleStorage.h>
+#include <ddMd/storage/DihedralStorage.h>
+#include <util/mpi/MpiLogger.h>
+
+#ifdef UTIL_MPI
+#ifndef TEST_MPI
+#define TEST_MPI
+#endif
+#endif
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+#include <test/ParamFileTest.h>
+
+using namespace Util;
+using namespace DdMd;
+
+class ParallelConfigIoTest: public ParamFileTest
+{
+
+   DdMdConfigIo configIo;
+   DdMdParallelConfigIo parallelConfigIo;
+   Boundary boundary;
+   Domain   domain;
+   Buffer   buffer;
+   AtomStorage  atomStorage;
+   BondStorage  bondStorage;
+   #ifdef SIMP_ANGLE
+   AngleStorage  angleStorage;
+   #endif
+   #ifdef SIMP_DIHEDRAL
+   DihedralStorage  dihedralStorage;
+   #endif
+   bool hasAngles;
+   bool hasDihedrals;
+
+public:
+
+   ParallelConfigIoTest()
+    : configIo(false) // hasMolecules = false
+   {}
+
+   virtual void setUp()
+   {
+      hasAngles = false;
+      #ifdef SIMP_ANGLE
+      hasAngles = true;
+      #endif
+      hasDihedrals = false;
+      #ifdef SIMP_DIHEDRAL
+      hasDihedrals = true;
+      #endif
+   }
+
+   void associate(ConfigIo& io)
+   {
+      io.associate(domain, boundary, atomStorage, bondStorage,
+                   #ifdef SIMP_ANGLE
+                   angleStorage,
+                   #endif
+                   #ifdef SIMP_DIHEDRAL
+                   dihedralStorage,
+                   #endif
+                   buffer);
+      #ifdef UTIL_MPI
+      io.setIoCommunicator(communicator());
+      #endif
+   }
+
+   void readParam()
+   {
+      // Set connections between objects
+      domain.setBoundary(boundary);
+      associate(configIo);
+      associate(parallelConfigIo);
+
+      #ifdef UTIL_MPI
+      // Set communicators
+      domain.setGridCommunicator(communicator());
+      domain.setIoCommunicator(communicator());
+      atomStorage.setIoCommunicator(communicator());
+      bondStorage.setIoCommunicator(communicator());
+      #ifdef SIMP_ANGLE
+      angleStorage.setIoCommunicator(communicator());
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      dihedralStorage.setIoCommunicator(communicator());
+      #endif
+      buffer.setIoCommunicator(communicator());
+      #else
+      domain.setRank(0);
+      #endif // ifdef UTIL_MPI
+
+      // Open parameter file
+      std::ifstream file;
+      if (hasDihedrals) {
+         openInputFile("in/ConfigIo_a_d", file);
+      } else {
+         if (hasAngles) {
+            openInputFile("in/ConfigIo_a", file);
+         } else {
+            openInputFile("in/ConfigIo", file);
+         }
+      }
+
+      domain.readParam(file);
+      buffer.readParam(file);
+
+      atomStorage.associate(domain, boundary, buffer);
+      atomStorage.readParam(file);
+
+      #ifdef SIMP_BOND
+      bondStorage.associate(domain, atomStorage, buffer);
+      bondStorage.readParam(file);
+      #endif
+
+      #ifdef SIMP_ANGLE
+      if (hasAngles) {
+         angleStorage.associate(domain, atomStorage, buffer);
+         angleStorage.readParam(file);
+      }
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      if (hasDihedrals) {
+         dihedralStorage.associate(domain, atomStorage, buffer);
+         dihedralStorage.readParam(file);
+      }
+      #endif
+
+      configIo.readParam(file);
+      file.close();
+   }
+
+   void clearStorage()
+   {
+      atomStorage.clearAtoms();
+      atomStorage.clearGhosts();
+      bondStorage.clearGroups();
+      #ifdef SIMP_ANGLE
+      angleStorage.clearGroups();
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      dihedralStorage.clearGroups();
+      #endif
+   }
+
+   void testReadWriteConfig()
+   {
+      printMethod(TEST_FUNC);
+      readParam();
+
+      std::ifstream inFile;
+      openInputFile("in/config", inFile);
+      configIo.readConfig(inFile, MaskBonded);
+      inFile.close();
+
+      // Store local atoms and number of bonds
+      int capacity = atomStorage.totalAtomCapacity();
+      DArray<Vector> positions;
+      DArray<Vector> velocities;
+      DArray<int> typeIds;
+      positions.allocate(capacity);
+      velocities.allocate(capacity);
+      typeIds.allocate(capacity);
+      int i;
+      for (i = 0; i < capacity; ++i) {
+         typeIds[i] = -1;
+      }
+      int nLocal = atomStorage.nAtom();
+      AtomIterator iter;
+      for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+         i = iter->id();
+         positions[i] = iter->position();
+         velocities[i] = iter->velocity();
+         typeIds[i] = iter->typeId();
+      }
+      bondStorage.computeNTotal(communicator());
+      int nBond = 0;
+      if (domain.isMaster()) {
+         nBond = bondStorage.nTotal();
+      }
+
+      // Write and read back collectively
+      std::string filename = filePrefix() + "tmp/config.par";
+      parallelConfigIo.writeCollective(filename);
+      clearStorage();
+      parallelConfigIo.readCollective(filename, MaskBonded);
+
+      // Each atom returns to the processor that owned it before
+      TEST_ASSERT(atomStorage.nAtom() == nLocal);
+      for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+         i = iter->id();
+         TEST_ASSERT(typeIds[i] == iter->typeId());
+         TEST_ASSERT(positions[i] == iter->position());
+         TEST_ASSERT(velocities[i] == iter->velocity());
+      }
+      bondStorage.unsetNTotal();
+      bondStorage.computeNTotal(communicator());
+      if (domain.isMaster()) {
+         TEST_ASSERT(bondStorage.nTotal() == nBond);
+      }
+      TEST_ASSERT(bondStorage.isValid(atomStorage, communicator(), false));
+   }
+
+};
+
+TEST_BEGIN(ParallelConfigIoTest)
+TEST_ADD(ParallelConfigIoTest, testReadWriteConfig)
+TEST_END(ParallelConfigIoTest)
+
+#endif
@@ -1,6 +1,7 @@
 ddMd_tests_configIos_=\
    ddMd/tests/configIos/ConfigIoTest.cc \
-   ddMd/tests/configIos/SerializeConfigIoTest.cc
+   ddMd/tests/configIos/SerializeConfigIoTest.cc \
+   ddMd/tests/configIos/ParallelConfigIoTest.cc
 
 ddMd_tests_configIos_SRCS=\
      $(addprefix $(SRC_DIR)/, $(ddMd_tests_configIos_))
@@ -21,6 +21,8 @@
 #include <test/UnitTestRunner.h>
 
 #include <iostream>
+#include <set>
+#include <utility>
 
 using namespace Util;
 using namespace DdMd;
@@ -363,12 +365,105 @@ public:
 
    }
 
+   void testPairIteratorGhost()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+
+      // Flag atoms outside the local domain as ghosts
+      int i, j;
+      for (i = 0; i < ghosts.size(); ++i) {
+         ghosts[i].setIsGhost(true);
+      }
+      pairList.build(cellList);
+
+      PairIterator iter;
+      Vector dr;
+      Atom*  atom1Ptr;
+      Atom*  atom2Ptr;
+      int    np = 0;
+      int    ng = 0;
+      for (pairList.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom1Ptr, atom2Ptr);
+
+         // Check that packed indices decode to atoms in the parent array
+         i = atom1Ptr - &atoms[0];
+         j = atom2Ptr - &atoms[0];
+         TEST_ASSERT(i >= 0 && i < nAtom);
+         TEST_ASSERT(j >= 0 && j < nAtom);
+         TEST_ASSERT(!atom1Ptr->isGhost());
+         dr.subtract(atom1Ptr->position(), atom2Ptr->position());
+         TEST_ASSERT(dr.square() < cutoffSq);
+         if (atom2Ptr->isGhost()) {
+            ++ng;
+         }
+         ++np;
+      }
+      TEST_ASSERT(np == pairList.nPair());
+      TEST_ASSERT(ng > 0);
+
+      for (i = 0; i < ghosts.size(); ++i) {
+         ghosts[i].setIsGhost(false);
+      }
+   }
+
+   void testUpdate()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+      pairList.build(cellList);
+
+      // Displace every tenth atom by less than skin/4 (skin = 0.4)
+      double skin = 0.4;
+      int i;
+      for (i = 0; i < nAtom; i += 10) {
+         atoms[i].position()[0] += 0.09;
+      }
+      TEST_ASSERT(!pairList.update(cellList, 0.1));
+      TEST_ASSERT(pairList.update(cellList, 0.05));
+      TEST_ASSERT(pairList.updateCounter() == 1);
+
+      // Collect pairs in incrementally updated list
+      std::set< std::pair<int, int> > pairs;
+      PairIterator iter;
+      Atom*  atom1Ptr;
+      Atom*  atom2Ptr;
+      int    id1, id2;
+      for (pairList.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom1Ptr, atom2Ptr);
+         id1 = atom1Ptr->id();
+         id2 = atom2Ptr->id();
+         if (id1 > id2) std::swap(id1, id2);
+         pairs.insert(std::make_pair(id1, id2));
+      }
+      TEST_ASSERT(int(pairs.size()) == pairList.nPair());
+
+      // Check that a full rebuild finds no missing pair within cutoff - skin
+      double rSq = (cutoff - skin)*(cutoff - skin);
+      Vector dr;
+      pairList.build(cellList);
+      for (pairList.begin(iter); iter.notEnd(); ++iter) {
+         iter.getPair(atom1Ptr, atom2Ptr);
+         dr.subtract(atom1Ptr->position(), atom2Ptr->position());
+         if (dr.square() < rSq) {
+            id1 = atom1Ptr->id();
+            id2 = atom2Ptr->id();
+            if (id1 > id2) std::swap(id1, id2);
+            TEST_ASSERT(pairs.count(std::make_pair(id1, id2)) == 1);
+         }
+      }
+   }
+
 };
 
 TEST_BEGIN(PairListTest)
 TEST_ADD(PairListTest, testCountNeighbors)
 TEST_ADD(PairListTest, testCountNeighbors2)
 TEST_ADD(PairListTest, testPairIterator)
+TEST_ADD(PairListTest, testPairIteratorGhost)
+TEST_ADD(PairListTest, testUpdate)
 TEST_END(PairListTest)
 
 #endif
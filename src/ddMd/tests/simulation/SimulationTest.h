@@ -6,10 +6,27 @@
 #include <ddMd/storage/GhostIterator.h>
 #include <ddMd/potentials/pair/PairPotential.h>
 #include <ddMd/integrators/Integrator.h>
+#include <ddMd/analyzers/trajectory/DdMdParallelTrajectoryWriter.h>
+#ifdef SIMP_BOND
+#include <ddMd/storage/BondStorage.h>
+#include <ddMd/storage/GroupIterator.h>
+#include <ddMd/potentials/bond/BondPotential.h>
+#endif
+#ifdef SIMP_COULOMB
+#include <ddMd/potentials/coulomb/CoulombPotential.h>
+#endif
+#include <util/containers/DArray.h>
+#include <util/space/Tensor.h>
+#include <util/math/Constants.h>
 #include <util/random/Random.h>
 #include <util/format/Dbl.h>
 #include <util/mpi/MpiLogger.h>
 #include <util/misc/FileMaster.h>
+#include <util/archives/BinaryFileIArchive.h>
+
+#include <climits>
+#include <cmath>
+#include <fstream>
 
 #ifdef UTIL_MPI
 #ifndef TEST_MPI
@@ -60,6 +77,24 @@ public:
 
    void testIntegrate1();
 
+   void testRespaIntegrate();
+
+   void testRespaMultipleTimeStep();
+
+   void testParallelTrajectoryWriter();
+
+   void testCollectiveRestart();
+
+   #ifdef SIMP_BOND
+   void testConstrainedIntegrate();
+   #endif
+
+   #ifdef SIMP_COULOMB
+   #ifdef SIMP_FFTW
+   void testSpmeEwald();
+   #endif
+   #endif
+
 };
 
 
@@ -347,6 +382,437 @@ inline void SimulationTest::testIntegrate1()
 
 }
 
+inline void SimulationTest::testRespaIntegrate()
+{
+   printMethod(TEST_FUNC); 
+
+   // Reference run with NveIntegrator
+   openFile("in/param2"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   std::string filename("config2");
+   simulation_.readConfig(filename);
+   double temperature = 1.0;
+   simulation_.setBoltzmannVelocities(temperature);
+   simulation_.integrator().run(40);
+   simulation_.computeKineticEnergy();
+   simulation_.computePotentialEnergies();
+
+   // Run with RespaIntegrator and nInnerStep = 1, from the same state
+   Label::clear();
+   DdMd::Simulation respa;
+   respa.fileMaster().setRootPrefix(filePrefix()); 
+   openFile("in/paramRespa"); 
+   respa.readParam(file()); 
+   closeFile();
+   respa.readConfig(filename);
+   respa.setBoltzmannVelocities(temperature);
+   respa.integrator().run(40);
+   TEST_ASSERT(respa.isValid());
+   respa.computeKineticEnergy();
+   respa.computePotentialEnergies();
+
+   // With one inner step, r-RESPA is identical to velocity-Verlet
+   if (simulation_.domain().isMaster()) {
+      double kinetic = simulation_.kineticEnergy();
+      double potential = simulation_.potentialEnergy();
+      double tolerance = 1.0E-8*(fabs(kinetic) + fabs(potential));
+      TEST_ASSERT(fabs(respa.kineticEnergy() - kinetic) < tolerance);
+      TEST_ASSERT(fabs(respa.potentialEnergy() - potential) < tolerance);
+   }
+}
+
+inline void SimulationTest::testRespaMultipleTimeStep()
+{
+   printMethod(TEST_FUNC); 
+
+   // Reference run with NveIntegrator and small time step 0.0005.
+   // Dimers with stiff harmonic bonds are the fast degrees of freedom.
+   openFile("in/paramDimerNve"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   std::string filename("config.dimers");
+   simulation_.readConfig(filename);
+   double temperature = 1.0;
+   simulation_.setBoltzmannVelocities(temperature);
+   double reference0, reference1;
+   simulation_.integrator().run(80);
+   simulation_.computeKineticEnergy();
+   simulation_.computePotentialEnergies();
+   reference0 = simulation_.kineticEnergy() 
+              + simulation_.potentialEnergy();
+   simulation_.integrator().run(320);
+   simulation_.computeKineticEnergy();
+   simulation_.computePotentialEnergies();
+   reference1 = simulation_.kineticEnergy() 
+              + simulation_.potentialEnergy();
+
+   // RespaIntegrator with outer step 0.004 and 8 inner steps, from the
+   // same initial state, sampled at the same times
+   Label::clear();
+   DdMd::Simulation respa;
+   respa.fileMaster().setRootPrefix(filePrefix()); 
+   openFile("in/paramDimerRespa"); 
+   respa.readParam(file()); 
+   closeFile();
+   respa.readConfig(filename);
+   respa.setBoltzmannVelocities(temperature);
+   double energy0, energy1;
+   respa.integrator().run(10);
+   respa.computeKineticEnergy();
+   respa.computePotentialEnergies();
+   energy0 = respa.kineticEnergy() + respa.potentialEnergy();
+   respa.integrator().run(40);
+   TEST_ASSERT(respa.isValid());
+   respa.computeKineticEnergy();
+   respa.computePotentialEnergies();
+   energy1 = respa.kineticEnergy() + respa.potentialEnergy();
+
+   // Both runs must conserve energy, and agree with each other
+   if (simulation_.domain().isMaster()) {
+      double tolerance = 2.0E-3*fabs(reference0);
+      TEST_ASSERT(fabs(reference1 - reference0) < tolerance);
+      TEST_ASSERT(fabs(energy1 - energy0) < tolerance);
+      TEST_ASSERT(fabs(energy0 - reference0) < tolerance);
+      TEST_ASSERT(fabs(energy1 - reference1) < tolerance);
+   }
+}
+
+inline void SimulationTest::testParallelTrajectoryWriter()
+{
+   printMethod(TEST_FUNC); 
+
+   openFile("in/param1"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   simulation_.fileMaster().setOutputPrefix("tmp/");
+   std::string filename("config1");
+   simulation_.readConfig(filename);
+
+   // Write one frame collectively
+   DdMdParallelTrajectoryWriter writer(simulation_);
+   openFile("in/ParallelTrajectoryWriter"); 
+   writer.readParam(file()); 
+   closeFile();
+   writer.setup();
+   writer.sample(0);
+   writer.clear();
+   MPI::Intracomm& communicator = simulation_.domain().communicator();
+   communicator.Barrier();
+
+   // Read the header on every processor
+   std::string path = simulation_.fileMaster().outputPrefix() + "traj";
+   std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+   TEST_ASSERT(!in.fail());
+   BinaryFileIArchive ar(in);
+   int nAtom;
+   long iStep;
+   Boundary boundary;
+   ar >> nAtom;
+   ar >> iStep;
+   ar >> boundary;
+   TEST_ASSERT(nAtom == 100);
+   TEST_ASSERT(iStep == 0);
+   std::streampos begin = in.tellg();
+
+   // The record of each local atom is at the position given by its id
+   struct Record
+   {
+      int id;
+      unsigned int ir[Dimension];
+   } record;
+   const double scale = 1.0/(double(UINT_MAX) + 1.0);
+   AtomStorage& atomStorage = simulation_.atomStorage();
+   TEST_ASSERT(!atomStorage.isCartesian());
+   AtomIterator atomIter;
+   Vector r;
+   int j;
+   atomStorage.begin(atomIter);
+   for ( ; atomIter.notEnd(); ++atomIter) {
+      in.seekg(begin + std::streamoff(sizeof(Record)*atomIter->id()));
+      in.read((char*)&record, sizeof(Record));
+      TEST_ASSERT(record.id == atomIter->id());
+      r = atomIter->position();
+      for (j = 0; j < Dimension; ++j) {
+         if (r[j] >= 1.0) r[j] -= 1.0;
+         if (r[j] <  0.0) r[j] += 1.0;
+         TEST_ASSERT(fabs(scale*record.ir[j] - r[j]) < 1.0E-8);
+      }
+   }
+   in.close();
+}
+
+inline void SimulationTest::testCollectiveRestart()
+{
+   printMethod(TEST_FUNC); 
+
+   openFile("in/param1"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   simulation_.fileMaster().setOutputPrefix("tmp/");
+   std::string filename("config1");
+   simulation_.readConfig(filename);
+
+   // Save, with the configuration written by a collective ConfigIo
+   std::string className("DdMdParallelConfigIo");
+   simulation_.setConfigIo(className);
+   simulation_.save("tmp/restart");
+
+   // Load into a new Simulation
+   Label::clear();
+   DdMd::Simulation restart;
+   restart.fileMaster().setRootPrefix(filePrefix()); 
+   restart.load("tmp/restart");
+   TEST_ASSERT(restart.isValid());
+
+   // Each atom is loaded by the processor that owned it before
+   AtomStorage& atomStorage = simulation_.atomStorage();
+   AtomStorage& restartStorage = restart.atomStorage();
+   TEST_ASSERT(restartStorage.nAtom() == atomStorage.nAtom());
+   AtomIterator atomIter;
+   Atom* atomPtr;
+   Vector dr;
+   atomStorage.begin(atomIter);
+   for ( ; atomIter.notEnd(); ++atomIter) {
+      atomPtr = restartStorage.map().find(atomIter->id());
+      TEST_ASSERT(atomPtr);
+      TEST_ASSERT(!atomPtr->isGhost());
+      TEST_ASSERT(atomPtr->typeId() == atomIter->typeId());
+      dr.subtract(atomPtr->position(), atomIter->position());
+      TEST_ASSERT(dr.square() < 1.0E-20);
+   }
+   #ifdef SIMP_BOND
+   MPI::Intracomm& communicator = simulation_.domain().communicator();
+   simulation_.bondStorage().unsetNTotal();
+   simulation_.bondStorage().computeNTotal(communicator);
+   restart.bondStorage().unsetNTotal();
+   restart.bondStorage().computeNTotal(communicator);
+   if (simulation_.domain().isMaster()) {
+      TEST_ASSERT(restart.bondStorage().nTotal() 
+                  == simulation_.bondStorage().nTotal());
+   }
+   #endif
+}
+
+#ifdef SIMP_BOND
+inline void SimulationTest::testConstrainedIntegrate()
+{
+   printMethod(TEST_FUNC); 
+
+   // Dimers on a lattice, with bonds of length 1.1 constrained to 1.0
+   openFile("in/paramConstraint"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   std::string filename("config.dimers");
+   simulation_.readConfig(filename);
+   double temperature = 1.0;
+   simulation_.setBoltzmannVelocities(temperature);
+   bool isMaster = simulation_.domain().isMaster();
+
+   // First run projects the configuration onto the constraints
+   double energy0 = 0.0;
+   double energy;
+   for (int i = 0; i < 5; ++i) {
+      simulation_.integrator().run(40);
+      TEST_ASSERT(simulation_.isValid());
+
+      // Total energy must remain close to that after the first run
+      simulation_.computeKineticEnergy();
+      simulation_.computePotentialEnergies();
+      if (isMaster) {
+         energy = simulation_.kineticEnergy() 
+                + simulation_.potentialEnergy();
+         if (i == 0) {
+            energy0 = energy;
+         } else {
+            TEST_ASSERT(fabs(energy - energy0) < 1.0E-2*fabs(energy0));
+         }
+      }
+
+      // Every constrained bond, local or shared with a ghost, has
+      // the constrained length
+      TEST_ASSERT(simulation_.atomStorage().isCartesian());
+      const Boundary& boundary = simulation_.boundary();
+      GroupIterator<2> iter;
+      double length;
+      simulation_.bondStorage().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         length = sqrt(boundary.distanceSq(iter->atomPtr(0)->position(),
+                                           iter->atomPtr(1)->position()));
+         TEST_ASSERT(fabs(length - 1.0) < 1.0E-6);
+      }
+   }
+
+   // The virial pressure includes the constraint stress
+   simulation_.computeVirialStress();
+   if (isMaster) {
+      Tensor stress;
+      stress.zero();
+      simulation_.integrator().addConstraintStress(stress);
+      double constraintPressure = (stress(0,0) + stress(1,1) 
+                                   + stress(2,2))/3.0;
+      TEST_ASSERT(fabs(constraintPressure) > 1.0E-6);
+      double pressure = simulation_.pairPotential().pressure()
+                      + simulation_.bondPotential().pressure()
+                      + constraintPressure;
+      TEST_ASSERT(eq(simulation_.virialPressure(), pressure));
+   }
+}
+#endif
+
+#ifdef SIMP_COULOMB
+#ifdef SIMP_FFTW
+inline void SimulationTest::testSpmeEwald()
+{
+   printMethod(TEST_FUNC); 
+
+   openFile("in/paramSpme"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   std::string filename("config.charged");
+   simulation_.readConfig(filename);
+
+   Domain& domain = simulation_.domain();
+   AtomStorage& atomStorage = simulation_.atomStorage();
+   Boundary& boundary = simulation_.boundary();
+   CoulombPotential& coulomb = simulation_.coulombPotential();
+   const EwaldInteraction& ewald = coulomb.ewaldInteraction();
+   MPI::Intracomm& communicator = domain.communicator();
+   atomStorage.transformGenToCart(boundary);
+
+   // SPME k-space energy and forces
+   simulation_.zeroForces();
+   coulomb.computeForces();
+   coulomb.unsetEnergy();
+   coulomb.computeEnergy(communicator);
+
+   // Gather generalized coordinates and charges of all atoms
+   int nProc = communicator.Get_size();
+   int nLocal = atomStorage.nAtom();
+   DArray<int> counts;
+   DArray<int> displs;
+   counts.allocate(nProc);
+   displs.allocate(nProc);
+   int localCount = 4*nLocal;
+   communicator.Allgather(&localCount, 1, MPI::INT, 
+                          &counts[0], 1, MPI::INT);
+   int i, j, n;
+   n = 0;
+   for (i = 0; i < nProc; ++i) {
+      displs[i] = n;
+      n += counts[i];
+   }
+   int nAtom = n/4;
+   DArray<double> local;
+   DArray<double> all;
+   local.allocate(4*nLocal + 1);
+   all.allocate(n);
+   Vector s;
+   AtomIterator atomIter;
+   atomStorage.begin(atomIter);
+   for (i = 0; atomIter.notEnd(); ++atomIter, ++i) {
+      boundary.transformCartToGen(atomIter->position(), s);
+      for (j = 0; j < Dimension; ++j) {
+         local[4*i + j] = s[j];
+      }
+      local[4*i + 3] = simulation_.atomType(atomIter->typeId()).charge();
+   }
+   communicator.Allgatherv(&local[0], localCount, MPI::DOUBLE, &all[0], 
+                           &counts[0], &displs[0], MPI::DOUBLE);
+
+   // Direct Ewald sum over wavevectors k = m0*b0 + m1*b1 + m2*b2, for 
+   // -mMax <= m_i <= mMax, excluding k = 0. Reference forces on local 
+   // atoms are accumulated in the same order as the AtomIterator.
+   const int mMax = 14;
+   const double twoPi = 2.0*Constants::Pi;
+   const double volume = boundary.volume();
+   DArray<Vector> forces;
+   forces.allocate(nLocal + 1);
+   for (i = 0; i < nLocal; ++i) {
+      forces[i].zero();
+   }
+   Vector b0 = boundary.reciprocalBasisVector(0);
+   Vector b1 = boundary.reciprocalBasisVector(1);
+   Vector b2 = boundary.reciprocalBasisVector(2);
+   Vector k, dF;
+   double kEnergy = 0.0;
+   double g, phase, re, im, sinPhase, cosPhase;
+   int m0, m1, m2;
+   for (m0 = -mMax; m0 <= mMax; ++m0) {
+      for (m1 = -mMax; m1 <= mMax; ++m1) {
+         for (m2 = -mMax; m2 <= mMax; ++m2) {
+            if (m0 == 0 && m1 == 0 && m2 == 0) continue;
+            k.multiply(b0, double(m0));
+            dF.multiply(b1, double(m1));
+            k += dF;
+            dF.multiply(b2, double(m2));
+            k += dF;
+            g = ewald.kSpacePotential(k.square());
+
+            // Fourier component rho(k) = sum_j q_j exp(i k.r_j)
+            re = 0.0;
+            im = 0.0;
+            for (i = 0; i < nAtom; ++i) {
+               phase = twoPi*(m0*all[4*i] + m1*all[4*i+1] + m2*all[4*i+2]);
+               re += all[4*i + 3]*cos(phase);
+               im += all[4*i + 3]*sin(phase);
+            }
+            kEnergy += 0.5*g*(re*re + im*im)/volume;
+
+            // F_i = (q_i/V) sum_k g(k) k Im[conj(rho(k)) exp(i k.r_i)]
+            for (i = 0; i < nLocal; ++i) {
+               phase = twoPi*(m0*local[4*i] + m1*local[4*i+1] 
+                              + m2*local[4*i+2]);
+               sinPhase = sin(phase);
+               cosPhase = cos(phase);
+               dF.multiply(k, local[4*i+3]*g*(re*sinPhase - im*cosPhase)
+                              /volume);
+               forces[i] += dF;
+            }
+         }
+      }
+   }
+
+   // Self energy
+   double qSqSum = 0.0;
+   for (i = 0; i < nAtom; ++i) {
+      qSqSum += all[4*i + 3]*all[4*i + 3];
+   }
+   const double pi = Constants::Pi;
+   double selfEnergy = qSqSum*ewald.alpha()
+                       /(4.0*sqrt(pi)*pi*ewald.epsilon());
+
+   // Compare energies (on master)
+   if (domain.isMaster()) {
+      double error = coulomb.energy() - (kEnergy - selfEnergy);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         std::cout << "SPME energy   = " << Dbl(coulomb.energy(), 20, 12)
+                   << std::endl;
+         std::cout << "Ewald energy  = " 
+                   << Dbl(kEnergy - selfEnergy, 20, 12) << std::endl;
+      }
+      TEST_ASSERT(fabs(error) < 1.0E-3*selfEnergy);
+   }
+
+   // Compare forces on local atoms, relative to rms force
+   double localSums[2];
+   double sums[2];
+   localSums[0] = 0.0;
+   localSums[1] = 0.0;
+   atomStorage.begin(atomIter);
+   for (i = 0; atomIter.notEnd(); ++atomIter, ++i) {
+      dF.subtract(atomIter->force(), forces[i]);
+      localSums[0] += dF.square();
+      localSums[1] += forces[i].square();
+   }
+   communicator.Allreduce(localSums, sums, 2, MPI::DOUBLE, MPI::SUM);
+   TEST_ASSERT(sums[1] > 0.0);
+   TEST_ASSERT(sqrt(sums[0]/sums[1]) < 1.0E-2);
+}
+#endif
+#endif
+
 TEST_BEGIN(SimulationTest)
 TEST_ADD(SimulationTest, testReadParam)
 TEST_ADD(SimulationTest, testReadConfig)
@@ -355,6 +821,18 @@ TEST_ADD(SimulationTest, testExchange)
 TEST_ADD(SimulationTest, testUpdate)
 TEST_ADD(SimulationTest, testCalculateForces)
 TEST_ADD(SimulationTest, testIntegrate1)
+TEST_ADD(SimulationTest, testRespaIntegrate)
+TEST_ADD(SimulationTest, testRespaMultipleTimeStep)
+TEST_ADD(SimulationTest, testParallelTrajectoryWriter)
+TEST_ADD(SimulationTest, testCollectiveRestart)
+#ifdef SIMP_BOND
+TEST_ADD(SimulationTest, testConstrainedIntegrate)
+#endif
+#ifdef SIMP_COULOMB
+#ifdef SIMP_FFTW
+TEST_ADD(SimulationTest, testSpmeEwald)
+#endif
+#endif
 TEST_END(SimulationTest)
 
 #endif
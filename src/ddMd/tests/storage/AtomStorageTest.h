@@ -60,6 +60,8 @@ public:
 
    void testTransforms();
 
+   void testSortAtoms();
+
 };
 
 inline void AtomStorageTest::testReadParam()
@@ -501,6 +503,46 @@ void AtomStorageTest::testTransforms()
 
 }
 
+void AtomStorageTest::testSortAtoms()
+{
+   printMethod(TEST_FUNC);
+
+   // Add atoms, then remove one to leave a hole in the atoms_ array
+   Atom* ptr;
+   ptr = storage_.addAtom(53);
+   ptr->position() = Vector(0.9, 0.9, 0.9);
+   ptr = storage_.addAtom(35);
+   ptr->position() = Vector(0.6, 0.1, 0.1);
+   ptr = storage_.addAtom(18);
+   ptr->position() = Vector(0.5, 0.5, 0.5);
+   ptr = storage_.addAtom(44);
+   ptr->position() = Vector(0.8, 0.2, 0.6);
+   ptr = storage_.addAtom(17);
+   ptr->position() = Vector(0.1, 0.1, 0.1);
+   ptr = storage_.addAtom(12);
+   ptr->position() = Vector(0.2, 0.6, 0.1);
+   storage_.removeAtom(map_.find(35));
+   TEST_ASSERT(storage_.nAtom() == 5);
+   TEST_ASSERT(storage_.isValid());
+
+   Vector lower(0.0, 0.0, 0.0);
+   Vector upper(1.0, 1.0, 1.0);
+   storage_.sortAtoms(lower, upper);
+   TEST_ASSERT(storage_.nAtom() == 5);
+   TEST_ASSERT(storage_.atomReservoir_.size() == storage_.atomCapacity()-5);
+   TEST_ASSERT(storage_.isValid());
+
+   // Check order in memory (Morton order) and preserved positions
+   TEST_ASSERT(&storage_.atoms_[0] == map_.find(17));
+   TEST_ASSERT(&storage_.atoms_[1] == map_.find(12));
+   TEST_ASSERT(&storage_.atoms_[2] == map_.find(44));
+   TEST_ASSERT(&storage_.atoms_[3] == map_.find(18));
+   TEST_ASSERT(&storage_.atoms_[4] == map_.find(53));
+   TEST_ASSERT(eq(map_.find(44)->position()[2], 0.6));
+   TEST_ASSERT(eq(map_.find(12)->position()[1], 0.6));
+   TEST_ASSERT(map_.find(35) == 0);
+}
+
 TEST_BEGIN(AtomStorageTest)
 TEST_ADD(AtomStorageTest, testReadParam)
 TEST_ADD(AtomStorageTest, testAddAtoms)
@@ -509,6 +551,7 @@ TEST_ADD(AtomStorageTest, testClear)
 TEST_ADD(AtomStorageTest, testIterators)
 TEST_ADD(AtomStorageTest, testSnapshot)
 TEST_ADD(AtomStorageTest, testTransforms)
+TEST_ADD(AtomStorageTest, testSortAtoms)
 TEST_END(AtomStorageTest)
 
 #endif
@@ -0,0 +1,176 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryWriter.h"
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <simp/species/Species.h>
+#include <util/misc/FileMaster.h>
+#include <util/archives/Serializable_includes.h>
+
+#include <ios>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryWriter::CompressedTrajectoryWriter(System& system) 
+    : SystemAnalyzer<System>(system),
+      encoder_(),
+      positions_(),
+      velocities_(),
+      velocityPrecision_(0.0),
+      positionBits_(20),
+      nAtom_(0),
+      isInitialized_(false)
+   {  setClassName("CompressedTrajectoryWriter"); }
+
+   /*
+   * Read interval, outputFileName and optional parameters.
+   */
+   void CompressedTrajectoryWriter::readParameters(std::istream& in) 
+   {
+      readInterval(in);
+      readOutputFileName(in);
+      positionBits_ = 20;
+      readOptional<int>(in, "positionBits", positionBits_);
+      velocityPrecision_ = 0.0;
+      readOptional<double>(in, "velocityPrecision", velocityPrecision_);
+      encoder_.setPositionBits(positionBits_);
+      encoder_.setVelocityPrecision(velocityPrecision_);
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load state from an archive.
+   */
+   void CompressedTrajectoryWriter::loadParameters(Serializable::IArchive& ar)
+   {
+      Analyzer::loadParameters(ar);
+      bool isRequired = false;
+      positionBits_ = 20;
+      loadParameter<int>(ar, "positionBits", positionBits_, isRequired);
+      velocityPrecision_ = 0.0;
+      loadParameter<double>(ar, "velocityPrecision", velocityPrecision_, 
+                            isRequired);
+      encoder_.setPositionBits(positionBits_);
+      encoder_.setVelocityPrecision(velocityPrecision_);
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save state to archive.
+   */
+   void CompressedTrajectoryWriter::save(Serializable::OArchive& ar)
+   {
+      Analyzer::save(ar);
+      bool isActive = true;
+      Parameter::saveOptional(ar, positionBits_, isActive);
+      isActive = (velocityPrecision_ > 0.0);
+      Parameter::saveOptional(ar, velocityPrecision_, isActive);
+   }
+
+   /*
+   * Count atoms in all molecules currently in the system.
+   */
+   int CompressedTrajectoryWriter::countAtoms()
+   {
+      int nSpecies = system().simulation().nSpecies();
+      int nAtom = 0;
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         nAtom += system().nMolecule(iSpecies)
+                  * system().simulation().species(iSpecies).nAtom();
+      }
+      return nAtom;
+   }
+
+   /*
+   * Open file, allocate arrays and write header.
+   */
+   void CompressedTrajectoryWriter::setup() 
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Object is not initialized");
+      }
+      if (outputFile_.is_open()) {
+         encoder_.writeIndex(outputFile_);
+         outputFile_.close();
+      }
+
+      nAtom_ = countAtoms();
+      if (positions_.isAllocated() && positions_.capacity() != nAtom_) {
+         positions_.deallocate();
+         if (velocities_.isAllocated()) {
+            velocities_.deallocate();
+         }
+      }
+      if (!positions_.isAllocated() && nAtom_ > 0) {
+         positions_.allocate(nAtom_);
+         if (encoder_.hasVelocities()) {
+            velocities_.allocate(nAtom_);
+         }
+      }
+
+      fileMaster().openOutputFile(outputFileName(), outputFile_,
+                                  std::ios::out | std::ios::binary);
+      encoder_.writeHeader(outputFile_, nAtom_);
+   }
+
+   /*
+   * Write a frame, with atoms in species and molecule order.
+   */
+   void CompressedTrajectoryWriter::sample(long iStep) 
+   {
+      if (isAtInterval(iStep))  {
+         if (countAtoms() != nAtom_) {
+            UTIL_THROW("Number of atoms changed since setup");
+         }
+
+         Boundary& boundary = system().boundary();
+         bool hasVelocities = encoder_.hasVelocities();
+         int nSpecies = system().simulation().nSpecies();
+         int iSpecies, iMol, nMolecule;
+         Molecule::AtomIterator atomIter;
+         int id = 0;
+         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+            nMolecule = system().nMolecule(iSpecies);
+            for (iMol = 0; iMol < nMolecule; ++iMol) {
+               Molecule& molecule = system().molecule(iSpecies, iMol);
+               for (molecule.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+                  boundary.transformCartToGen(atomIter->position(), 
+                                              positions_[id]);
+                  if (hasVelocities) {
+                     velocities_[id] = atomIter->velocity();
+                  }
+                  ++id;
+               }
+            }
+         }
+
+         Vector* velocities = hasVelocities ? velocities_.cArray() : 0;
+         encoder_.writeFrame(outputFile_, iStep, boundary, 
+                             positions_.cArray(), velocities);
+      }
+   }
+
+   /*
+   * Write index and close file.
+   */
+   void CompressedTrajectoryWriter::output() 
+   {
+      if (outputFile_.is_open()) {
+         encoder_.writeIndex(outputFile_);
+         outputFile_.close();
+      }
+   }
+  
+}
@@ -0,0 +1,127 @@
+#ifndef MCMD_COMPRESSED_TRAJECTORY_WRITER_H
+#define MCMD_COMPRESSED_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/analyzers/SystemAnalyzer.h>
+#include <mcMd/simulation/System.h>
+#include <simp/trajectory/CompressedTrajectoryEncoder.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+#include <fstream>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Write a trajectory in the compressed, indexed binary format.
+   *
+   * Atoms are numbered consecutively in order of species, molecule and
+   * atom within each molecule, as assumed by CompressedTrajectoryReader.
+   * The number of molecules of each species may not change during a
+   * simulation. See Simp::CompressedTrajectoryEncoder for the format.
+   *
+   * \sa \ref mcMd_analyzer_CompressedTrajectoryWriter_page "parameter file format"
+   *
+   * \ingroup McMd_Analyzer_McMd_Module
+   */
+   class CompressedTrajectoryWriter : public SystemAnalyzer<System>
+   {
+   
+   public:
+   
+      /**
+      * Constructor.
+      *
+      * \param system parent System object. 
+      */
+      CompressedTrajectoryWriter(System& system);
+   
+      /**
+      * Destructor.
+      */
+      virtual ~CompressedTrajectoryWriter()
+      {} 
+   
+      /**
+      * Read interval, outputFileName and optional compression parameters.
+      *
+      * \param in input parameter file
+      */
+      virtual void readParameters(std::istream& in);
+   
+      /**
+      * Load state from an archive.
+      *
+      * \param ar loading (input) archive.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save state to archive.
+      *
+      * \param ar saving (output) archive.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Open the trajectory file and write the header.
+      */
+      virtual void setup();
+  
+      /**
+      * Write a frame to file.
+      *
+      * \param iStep step index
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Write the frame index and close the file.
+      */
+      virtual void output();
+  
+   private:
+      
+      /// Output file stream.
+      std::ofstream outputFile_;
+
+      /// Compression and file format.
+      CompressedTrajectoryEncoder encoder_;
+
+      /// Generalized positions, in atom order.
+      DArray<Vector> positions_;
+
+      /// Velocities, in atom order.
+      DArray<Vector> velocities_;
+
+      /// Resolution of velocity components (0 for no velocities).
+      double velocityPrecision_;
+
+      /// Number of bits per generalized coordinate.
+      int positionBits_;
+
+      /// Number of atoms in the file.
+      int nAtom_;
+   
+      /// Has readParam been called?
+      bool isInitialized_;
+
+      /*
+      * Count atoms in all molecules of the system.
+      */
+      int countAtoms();
+
+   };
+
+}
+#endif 
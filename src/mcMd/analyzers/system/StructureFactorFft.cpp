@@ -0,0 +1,167 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorFft.h"
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <simp/boundary/Boundary.h>
+#include <util/misc/FileMaster.h>
+#include <util/archives/Serializable_includes.h>
+#include <util/space/Vector.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   StructureFactorFft::StructureFactorFft(System& system) 
+    : SystemAnalyzer<System>(system),
+      nMode_(0),
+      order_(4),
+      nAtomType_(0),
+      isInitialized_(false)
+   {  setClassName("StructureFactorFft"); }
+
+   /*
+   * Destructor.
+   */
+   StructureFactorFft::~StructureFactorFft() 
+   {}
+
+   /*
+   * Read parameters from file, and allocate memory.
+   */
+   void StructureFactorFft::readParameters(std::istream& in) 
+   {
+      readInterval(in);
+      readOutputFileName(in);
+      read<int>(in, "nMode", nMode_);
+      nAtomType_ = system().simulation().nAtomType();
+      modes_.allocate(nMode_, nAtomType_);
+      readDMatrix<double>(in, "modes", modes_, nMode_, nAtomType_);
+      read<IntVector>(in, "gridDimensions", gridDimensions_);
+      order_ = 4;
+      readOptional<int>(in, "order", order_);
+
+      allocate();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load state from an archive.
+   */
+   void StructureFactorFft::loadParameters(Serializable::IArchive& ar)
+   {
+      Analyzer::loadParameters(ar);
+      ar & nAtomType_;
+      loadParameter<int>(ar, "nMode", nMode_);
+      loadDMatrix<double>(ar, "modes", modes_, nMode_, nAtomType_);
+      loadParameter<IntVector>(ar, "gridDimensions", gridDimensions_);
+      order_ = 4;
+      bool isRequired = false;
+      loadParameter<int>(ar, "order", order_, isRequired);
+
+      if (nAtomType_ != system().simulation().nAtomType()) {
+         UTIL_THROW("Inconsistent values of nAtomType_");
+      }
+
+      allocate();
+      mesh_.serialize(ar, 0);
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save state to archive.
+   */
+   void StructureFactorFft::save(Serializable::OArchive& ar)
+   {
+      Analyzer::save(ar);
+      ar & nAtomType_;
+      ar & nMode_;
+      ar & modes_;
+      ar & gridDimensions_;
+      bool isActive = true;
+      Parameter::saveOptional(ar, order_, isActive);
+      mesh_.serialize(ar, 0);
+   }
+
+   /*
+   * Allocate mesh and per-type weights.
+   */
+   void StructureFactorFft::allocate()
+   {
+      mesh_.allocate(gridDimensions_, nMode_, order_);
+      weights_.allocate(nAtomType_, nMode_);
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            weights_(i, j) = modes_(j, i);
+         }
+      }
+   }
+
+   /*
+   * Define shells and clear accumulators.
+   */
+   void StructureFactorFft::setup() 
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Error: object is not initialized");
+      }
+      mesh_.setBins(system().boundary());
+   }
+
+   /* 
+   * Assign all atoms to mesh, transform and accumulate.
+   */
+   void StructureFactorFft::sample(long iStep) 
+   {
+      if (isAtInterval(iStep))  {
+         Boundary& boundary = system().boundary();
+         Vector r;
+         System::ConstMoleculeIterator molIter;
+         Molecule::ConstAtomIterator atomIter;
+         int nSpecies, iSpecies;
+
+         mesh_.clearGrid();
+         nSpecies = system().simulation().nSpecies();
+         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+            system().begin(iSpecies, molIter); 
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter); 
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  boundary.transformCartToGen(atomIter->position(), r);
+                  mesh_.spread(r, &weights_(atomIter->typeId(), 0));
+               }
+            }
+         }
+         mesh_.sample(boundary);
+      }
+   }
+
+   /*
+   * Output final results to output files.
+   */
+   void StructureFactorFft::output() 
+   {
+      // Echo parameters to a log file
+      fileMaster().openOutputFile(outputFileName(".prm"), outputFile_);
+      writeParam(outputFile_);
+      outputFile_.close();
+
+      // Output spherically averaged structure factors
+      fileMaster().openOutputFile(outputFileName(".dat"), outputFile_);
+      mesh_.output(outputFile_);
+      outputFile_.close();
+   }
+
+}
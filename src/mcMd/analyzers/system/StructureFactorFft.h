@@ -0,0 +1,134 @@
+#ifndef MCMD_STRUCTURE_FACTOR_FFT_H
+#define MCMD_STRUCTURE_FACTOR_FFT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/analyzers/SystemAnalyzer.h>    // base class template
+#include <mcMd/simulation/System.h>           // base class template parameter
+#include <simp/scattering/StructureFactorMesh.h>  // member
+#include <util/containers/DMatrix.h>              // member template
+#include <util/space/IntVector.h>                 // member
+
+#include <util/global.h>
+
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Spherically averaged structure factors, computed with an FFT.
+   *
+   * This analyzer computes the same quantities as StructureFactor, 
+   * \f$ S_m(q) = < |\rho_m(q)|^2 / V > \f$ for weighted densities
+   * defined by a set of mode vectors, but for all wavevectors up to
+   * the Nyquist limit of a mesh, averaged over spherical shells.
+   * Atom weights are assigned to the mesh with B-spline assignment 
+   * functions of a specified order, and the mesh is transformed with
+   * FFTW (see Simp::StructureFactorMesh). Requires SIMP_FFTW.
+   *
+   * \sa \ref mcMd_analyzer_StructureFactorFft_page "parameter file format"
+   * 
+   * \ingroup McMd_Analyzer_McMd_Module
+   */
+   class StructureFactorFft : public SystemAnalyzer<System>
+   {
+
+   public:
+
+      /**	
+      * Constructor.
+      *
+      * \param system  reference to parent System object
+      */
+      StructureFactorFft(System& system);
+
+      /**	
+      * Destructor.
+      */
+      ~StructureFactorFft();
+
+      /**
+      * Read parameters from file, and allocate the mesh.
+      *
+      * \param in  input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load state from an archive.
+      *
+      * \param ar  loading (input) archive
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save state to archive.
+      *
+      * \param ar  saving (output) archive
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /** 
+      * Define shells, using the current boundary, and clear accumulators.
+      */
+      virtual void setup();
+   
+      /**
+      * Assign atoms to the mesh, transform, and add to accumulators.
+      *
+      * \param iStep  step counter
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Output results to file.
+      */
+      virtual void output();
+
+   private:
+
+      /// Output file stream.
+      std::ofstream outputFile_;
+
+      /// Mesh, FFT and shell accumulators.
+      StructureFactorMesh mesh_;
+
+      /// Mode vectors, indexed by mode and atom type.
+      DMatrix<double> modes_;
+
+      /// Weights, indexed by atom type and mode (transpose of modes_).
+      DMatrix<double> weights_;
+
+      /// Number of grid points in each direction.
+      IntVector gridDimensions_;
+
+      /// Number of mode vectors.
+      int nMode_;
+
+      /// Order of the B-spline assignment function.
+      int order_;
+
+      /// Number of atom types, copied from Simulation::nAtomType().
+      int nAtomType_;
+
+      /// Has readParam been called?
+      bool isInitialized_;
+
+      /*
+      * Allocate mesh and weights, after reading parameters.
+      */
+      void allocate();
+
+   };
+
+}
+#endif
@@ -10,7 +10,8 @@ mcMd_analyzers_system_=\
     mcMd/analyzers/system/SystemAnalyzerFactory.cpp \
     mcMd/analyzers/system/VanHove.cpp \
     mcMd/analyzers/system/BoundaryAverage.cpp \
-    mcMd/analyzers/system/ConfigWriter.cpp 
+    mcMd/analyzers/system/ConfigWriter.cpp \
+    mcMd/analyzers/system/CompressedTrajectoryWriter.cpp 
 
 ifdef SIMP_BOND
 mcMd_analyzers_system_+=\
@@ -27,6 +28,11 @@ mcMd_analyzers_system_+=\
     mcMd/analyzers/system/Cluster.cpp 
 endif
 
+ifdef SIMP_FFTW
+mcMd_analyzers_system_+=\
+    mcMd/analyzers/system/StructureFactorFft.cpp 
+endif
+
 mcMd_analyzers_system_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_analyzers_system_))
 mcMd_analyzers_system_OBJS=\
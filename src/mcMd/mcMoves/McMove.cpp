@@ -24,6 +24,16 @@ namespace McMd
       nAccept_(0)
    {}
 
+   /*
+   * Constructor, with a specified random number generator.
+   */
+   McMove::McMove(Simulation& simulation, Random& random) 
+    : simulationPtr_(&simulation),
+      randomPtr_(&random),
+      nAttempt_(0),
+      nAccept_(0)
+   {}
+
    /*
    * Destructor, empty default implementation.
    */
@@ -80,6 +90,20 @@ namespace McMd
       return false; 
    }
 
+   /*
+   * Default implementation - the energy cache is not maintained.
+   */
+   bool McMove::keepsEnergyCache() const
+   {  return false; }
+
+   #ifdef SIMP_COULOMB
+   /*
+   * Default implementation - Coulomb energy is not included.
+   */
+   bool McMove::includesCoulomb() const
+   {  return false; }
+   #endif
+
    /*
    * Trivial default implementation - do nothing
    */
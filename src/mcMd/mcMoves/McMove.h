@@ -40,6 +40,14 @@ namespace McMd
       */
       McMove(Simulation& simulation);
 
+      /**
+      * Constructor, with a specified random number generator.
+      *
+      * \param simulation parent Simulation object.
+      * \param random random number generator used by this move.
+      */
+      McMove(Simulation& simulation, Random& random);
+
       /**
       * Destructor.
       *
@@ -101,6 +109,29 @@ namespace McMd
       */
       virtual bool move();
 
+      /**
+      * Does move() keep the McSystem energy cache up to date?
+      *
+      * A move for which this returns false may change atomic positions
+      * without updating the McEnergyCache of the system, which must 
+      * then be unset after the move. Default implementation returns 
+      * false.
+      */
+      virtual bool keepsEnergyCache() const;
+
+      #ifdef SIMP_COULOMB
+      /**
+      * Does move() include changes in Coulomb energy?
+      *
+      * A move for which this returns true includes the r-space and 
+      * k-space Coulomb energy in its acceptance criterion, and keeps
+      * the Fourier charge density of the McCoulombPotential up to 
+      * date. Moves that return false may not be used in a system with
+      * a Coulomb potential. Default implementation returns false.
+      */
+      virtual bool includesCoulomb() const;
+      #endif
+
       // Accessor Functions
 
       /**
@@ -141,7 +172,7 @@ namespace McMd
       Simulation& simulation();
 
       /**
-      * Get Random number generator of parent Simulation.
+      * Get Random number generator.
       */
       Random& random();
 
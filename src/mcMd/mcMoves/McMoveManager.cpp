@@ -25,6 +25,14 @@ namespace McMd
      randomPtr_(&simulation.random())
    {  setClassName("McMoveManager"); }
 
+   // Constructor, for moves of a specified system.
+   McMoveManager::McMoveManager(McSimulation& simulation, McSystem& system)
+   : Manager<McMove>(),
+     simulationPtr_(&simulation),
+     systemPtr_(&system),
+     randomPtr_(&system.random())
+   {  setClassName("McMoveManager"); }
+
    // Destructor
    McMoveManager::~McMoveManager()
    {}
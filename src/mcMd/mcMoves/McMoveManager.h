@@ -42,6 +42,17 @@ namespace McMd
       */
       McMoveManager(McSimulation& simulation);
 
+      /**
+      * Constructor, for moves of a specified McSystem.
+      *
+      * Moves act on the specified system, and moves are chosen using 
+      * the random number generator of that system.
+      *
+      * \param simulation parent McSimulation
+      * \param system McSystem acted upon by moves
+      */
+      McMoveManager(McSimulation& simulation, McSystem& system);
+
       /**
       * Destructor.
       */
@@ -18,7 +18,7 @@ namespace McMd
    * Constructor
    */
    SystemMove::SystemMove(McSystem& system) :
-      McMove(system.simulation()),
+      McMove(system.simulation(), system.random()),
       systemPtr_(&system),
       boundaryPtr_(&system.boundary())
    {
@@ -62,123 +62,47 @@ namespace McMd
    CfbEndBase::deleteEndAtom(Atom* endPtr, Atom* pvtPtr, int bondType,
                             double &rosenbluth, double &energy)
    {
+      Vector trialPos[MaxTrial_];
       Vector bondVec;
       Vector pvtPos = pvtPtr->position();
-      double trialEnergy, lengthSq, length;
+      double trialEnergy[MaxTrial_];
+      double lengthSq, length;
+      int    iTrial;
    
       // Calculate bond length of pvt-end bond
       lengthSq = boundary().distanceSq(pvtPos, endPtr->position());
       length   = sqrt(lengthSq);
 
-      // Calculate current nonbonded pair energy of end atom
+      // Trial 0 is the current position. Generate nTrial - 1 others.
+      trialPos[0] = endPtr->position();
+      for (iTrial = 1; iTrial < nTrial_; ++iTrial) {
+         random().unitVector(bondVec);
+         bondVec *= length;
+         trialPos[iTrial].add(pvtPos, bondVec);  
+         boundary().shift(trialPos[iTrial]);
+      }
+
+      // Calculate nonbonded pair energies for all trials
       #ifndef SIMP_NOPAIR
-      energy = system().pairPotential().atomEnergy(*endPtr);
+      system().pairPotential().
+               trialEnergies(*endPtr, trialPos, nTrial_, trialEnergy);
       #else
-      energy = 0.0;
-      #endif
-
-      #ifdef SIMP_ANGLE
-      AtomAngleArray angles;
-      const Angle *anglePtr;
-      const Atom  *pvtPtr2(NULL);
-      Vector dr1, dr2;
-      int    iAngle, angleTypeId(0);
-      double rsq1, rsq2, cosTheta;
-
-      if (system().hasAnglePotential()) {
-
-         // Get the angle type and pointers of atoms forming the angle.
-         getAtomAngles(*endPtr, angles);
-         for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-            anglePtr = angles[iAngle];
-            if (&anglePtr->atom(1) == pvtPtr) {
-               if (&anglePtr->atom(0) == endPtr) {
-                  pvtPtr2 = &anglePtr->atom(2);
-               } else {
-                  pvtPtr2 = &anglePtr->atom(0);
-               }
-               angleTypeId = anglePtr->typeId();
-            }
-         }
-   
-         // Calculate angle energy. 
-         rsq1 = boundary().distanceSq(pvtPtr->position(),
-                                      pvtPtr2->position(), dr1);
-         rsq2 = boundary().distanceSq(endPtr->position(),
-                                      pvtPtr->position(), dr2);
-         cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
-   
-         energy += system().anglePotential().energy(cosTheta, angleTypeId);
-
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
       }
       #endif
 
-      #ifdef SIMP_EXTERNAL
-      if (system().hasExternalPotential()) {
-         energy += system().externalPotential().atomEnergy(*endPtr);
+      // Add angle and external energies, and sum Rosenbluth factor 
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
+         trialEnergy[iTrial] += angleExternalEnergy(endPtr, pvtPtr);
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
-      #endif
 
-      // Rosenbluth factor = exp(-beta*(pair + angle + external))
-      rosenbluth = boltzmann(energy);
-      
-      // Add bond energy of current pvt-end bond to energy.
-      // This is the final value of inout energy parameter.
+      // Total energy of the current position, including the bond energy
+      energy  = trialEnergy[0];
       energy += system().bondPotential().energy(lengthSq, bondType);
-
-      // Loop over nTrial - 1 additional trial positions:
-      for (int iTrial=0; iTrial < nTrial_ - 1; ++iTrial) {
-
-         random().unitVector(bondVec);
-         bondVec *= length;
-         endPtr->position().add(pvtPos, bondVec);  
-         boundary().shift(endPtr->position());
-
-         #ifndef SIMP_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*endPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
-
-         #ifdef SIMP_ANGLE
-         if (system().hasAnglePotential()) {
-
-            // Get the angle type and atom pointer at the angle.
-            getAtomAngles(*endPtr, angles);
-            for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-               anglePtr = angles[iAngle];
-               if (&anglePtr->atom(1) == pvtPtr) {
-                  if (&anglePtr->atom(0) == endPtr) {
-                     pvtPtr2 = &anglePtr->atom(2);
-                  } else {
-                     pvtPtr2 = &anglePtr->atom(0);
-                  }
-                  angleTypeId = anglePtr->typeId();
-               }
-            }
-
-            // Calculate energy.
-            rsq1 = boundary().distanceSq(pvtPtr->position(),
-                                         pvtPtr2->position(), dr1);
-            rsq2 = boundary().distanceSq(endPtr->position(),
-                                         pvtPtr->position(), dr2);
-            cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
-   
-            trialEnergy += system().anglePotential()
-                                   .energy(cosTheta, angleTypeId);
-         }
-         #endif
-
-         #ifdef SIMP_EXTERNAL
-         if (system().hasExternalPotential()) {
-            trialEnergy += 
-               system().externalPotential().atomEnergy(*endPtr);
-         }
-         #endif
-
-         rosenbluth += boltzmann(trialEnergy);
-      }
-
    }
    
   
@@ -195,71 +119,36 @@ namespace McMd
       double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
       double beta, length;
       int    iTrial;
-
-      #ifdef SIMP_ANGLE
-      AtomAngleArray angles;
-      const Angle *anglePtr;
-      const Atom  *pvtPtr2(NULL);
-      Vector dr1, dr2;
-      int    iAngle, angleTypeId(0);
-      double rsq1, rsq2, cosTheta;
-      #endif
    
       // Generate a random bond length
       beta   = energyEnsemble().beta();
       length = 
          system().bondPotential().randomBondLength(&random(), beta, bondType);
    
-      // Loop over nTrial trial positions:
-      rosenbluth = 0.0;
-      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
+      // Generate nTrial trial positions
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
          random().unitVector(bondVec);
          bondVec *= length;
          // trialPos = pvtPos + bondVec
          trialPos[iTrial].add(pvtPos, bondVec); 
          boundary().shift(trialPos[iTrial]);
-         endPtr->position() = trialPos[iTrial];
-         #ifndef SIMP_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*endPtr);
-         #else
-         trialEnergy[iTrial] = 0.0;
-         #endif
-
-         #ifdef SIMP_ANGLE
-         if (system().hasAnglePotential()) {
-
-            getAtomAngles(*endPtr, angles);
-            for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-               anglePtr = angles[iAngle];
-               if (&anglePtr->atom(1) == pvtPtr) {
-                  if (&anglePtr->atom(0) == endPtr) {
-                     pvtPtr2 = &anglePtr->atom(2);
-                  } else {
-                     pvtPtr2 = &anglePtr->atom(0);
-                  }
-                  angleTypeId = anglePtr->typeId();
-               }
-            }
-   
-            // Get the angle spanned.
-            rsq1 = boundary().distanceSq(pvtPtr->position(),
-                                         pvtPtr2->position(), dr1);
-            rsq2 = boundary().distanceSq(endPtr->position(),
-                                         pvtPtr->position(), dr2);
-            cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
-   
-            trialEnergy[iTrial] += system().anglePotential().
-                                   energy(cosTheta, angleTypeId);
-         }
-         #endif
+      }
 
-         #ifdef SIMP_EXTERNAL
-         if (system().hasExternalPotential()) {
-            trialEnergy[iTrial] += 
-                system().externalPotential().atomEnergy(*endPtr);
-         }
-         #endif
+      // Calculate nonbonded pair energies for all trials
+      #ifndef SIMP_NOPAIR
+      system().pairPotential().
+               trialEnergies(*endPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
 
+      // Add angle and external energies, and compute Boltzmann weights
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
+         trialEnergy[iTrial] += angleExternalEnergy(endPtr, pvtPtr);
          trialProb[iTrial] = boltzmann(trialEnergy[iTrial]);
          rosenbluth += trialProb[iTrial];
       }
@@ -281,4 +170,61 @@ namespace McMd
 
    }
 
+   /*
+   * Angle, external and r-space Coulomb energy of an end atom.
+   */
+   double 
+   CfbEndBase::angleExternalEnergy(const Atom* endPtr, const Atom* pvtPtr)
+   {
+      double energy = 0.0;
+
+      #ifdef SIMP_ANGLE
+      if (system().hasAnglePotential()) {
+         AtomAngleArray angles;
+         const Angle *anglePtr;
+         const Atom  *pvtPtr2(NULL);
+         Vector dr1, dr2;
+         int    iAngle, angleTypeId(0);
+         double rsq1, rsq2, cosTheta;
+
+         // Get the angle type and pointers of atoms forming the angle.
+         getAtomAngles(*endPtr, angles);
+         for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
+            anglePtr = angles[iAngle];
+            if (&anglePtr->atom(1) == pvtPtr) {
+               if (&anglePtr->atom(0) == endPtr) {
+                  pvtPtr2 = &anglePtr->atom(2);
+               } else {
+                  pvtPtr2 = &anglePtr->atom(0);
+               }
+               angleTypeId = anglePtr->typeId();
+            }
+         }
+   
+         // Calculate angle energy. 
+         rsq1 = boundary().distanceSq(pvtPtr->position(),
+                                      pvtPtr2->position(), dr1);
+         rsq2 = boundary().distanceSq(endPtr->position(),
+                                      pvtPtr->position(), dr2);
+         cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
+   
+         energy += system().anglePotential().energy(cosTheta, angleTypeId);
+      }
+      #endif
+
+      #ifdef SIMP_EXTERNAL
+      if (system().hasExternalPotential()) {
+         energy += system().externalPotential().atomEnergy(*endPtr);
+      }
+      #endif
+
+      #ifdef SIMP_COULOMB
+      if (system().hasCoulombPotential()) {
+         energy += system().coulombPotential().rSpaceAtomEnergy(*endPtr);
+      }
+      #endif
+
+      return energy;
+   }
+
 }
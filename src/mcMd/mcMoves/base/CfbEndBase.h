@@ -116,6 +116,13 @@ namespace McMd
       /// Grant friend access to unit test class
       //  friend class CbEndBaseTest;
 
+   private:
+
+      /*
+      * Angle, external and r-space Coulomb energy of an end atom.
+      */
+      double angleExternalEnergy(const Atom* endPtr, const Atom* pvtPtr);
+
    };
 
 }      
@@ -156,8 +156,10 @@ namespace McMd
       Vector  prevPos = prevPtr->position();
       Vector  nextPos = nextPtr->position();
       Vector  partPos = partPtr->position();
-      Vector  bondVec, trialPos, u_20, u_21;
-      double  trialEnergy, bondEnergy, wExt, length, lengthSq;
+      Vector  bondVec, u_20, u_21;
+      Vector  trialPos[MaxTrial_];
+      double  trialEnergy[MaxTrial_], bondEnergy[MaxTrial_];
+      double  wExt, length, lengthSq;
       double  l_20, l_21, bias;
       double  prefAng, kappaAng, normConst;
       int     iTrial;
@@ -175,30 +177,10 @@ namespace McMd
       energy = system().bondPotential().energy(lengthSq, prevBType);
    
       // Bond length between 1 and 0 & bonding energy
-      lengthSq   = boundary().distanceSq(partPos, nextPos);
-      bondEnergy = system().bondPotential().energy(lengthSq, nextBType);
-      energy    += bondEnergy;
-   
-      // Nonbonded pair energy of current position 
-      #ifndef SIMP_NOPAIR
-      trialEnergy = system().pairPotential().atomEnergy(*partPtr);
-      #else
-      trialEnergy = 0.0;
-      #endif
-
-      #ifdef SIMP_ANGLE
-      if (system().hasAnglePotential()) {
-         trialEnergy += system().anglePotential().atomEnergy(*partPtr);
-      }
-      #endif
-
-      #ifdef SIMP_EXTERNAL
-      if (system().hasExternalPotential()) {
-         trialEnergy += system().externalPotential().atomEnergy(*partPtr);
-      }
-      #endif
-
-      energy += trialEnergy;
+      lengthSq      = boundary().distanceSq(partPos, nextPos);
+      bondEnergy[0] = system().bondPotential().energy(lengthSq, nextBType);
+      energy       += bondEnergy[0];
+      trialPos[0]   = partPos;
     
       // Compute orientation/Angle bias factor and the normalization factor.
       getAngKappaNorm(l_20, prefAng, kappaAng, normConst);
@@ -207,20 +189,17 @@ namespace McMd
       // remove normalized orientation bias
       rosenbluth = normConst / bias;
    
-      // start to accumulate Rosenbluth factor
-      wExt = boltzmann(trialEnergy + bondEnergy);
-      
       // Generate "nTrial-1" trial positions based on 1-0 bonding.
       length = l_21;
-      for (iTrial=0; iTrial < nTrial_ - 1; iTrial++) {
+      for (iTrial = 1; iTrial < nTrial_; iTrial++) {
          ready = false;
          while (!ready) {
             random().unitVector(bondVec);
             bondVec *= length;
-            trialPos.add(prevPos, bondVec);
-            boundary().shift(trialPos);
+            trialPos[iTrial].add(prevPos, bondVec);
+            boundary().shift(trialPos[iTrial]);
    
-            lengthSq = boundary().distanceSq(trialPos, prevPos, u_21);
+            lengthSq = boundary().distanceSq(trialPos[iTrial], prevPos, u_21);
             l_21  = sqrt(lengthSq);
             u_21 /= l_21;
             orientationBias(u_21, u_20, prefAng, kappaAng, bias);
@@ -232,29 +211,50 @@ namespace McMd
          }
          
          // Bond 1-0 potential energy
-         lengthSq   = boundary().distanceSq(trialPos, nextPos);
-         bondEnergy = system().bondPotential().energy(lengthSq, nextBType);
-         partPtr->position() = trialPos;
-         #ifndef SIMP_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*partPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
+         lengthSq = boundary().distanceSq(trialPos[iTrial], nextPos);
+         bondEnergy[iTrial] = 
+            system().bondPotential().energy(lengthSq, nextBType);
+      }
+
+      // Nonbonded pair energies of current position (trial 0) and trials
+      #ifndef SIMP_NOPAIR
+      system().pairPotential().
+               trialEnergies(*partPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial_; iTrial++) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
+
+      // Accumulate Rosenbluth factor
+      wExt = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; iTrial++) {
+         partPtr->position() = trialPos[iTrial];
 
          #ifdef SIMP_ANGLE
          if (system().hasAnglePotential()) {
-            trialEnergy += system().anglePotential().atomEnergy(*partPtr);
+            trialEnergy[iTrial] += 
+                  system().anglePotential().atomEnergy(*partPtr);
          }
          #endif
 
          #ifdef SIMP_EXTERNAL
          if (system().hasExternalPotential()) {
-            trialEnergy += system().externalPotential().atomEnergy(*partPtr);
+            trialEnergy[iTrial] += 
+                  system().externalPotential().atomEnergy(*partPtr);
          }
          #endif
 
-         wExt += boltzmann(trialEnergy + bondEnergy);
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            trialEnergy[iTrial] += 
+                  system().coulombPotential().rSpaceAtomEnergy(*partPtr);
+         }
+         #endif
+
+         wExt += boltzmann(trialEnergy[iTrial] + bondEnergy[iTrial]);
       }
+      energy += trialEnergy[0];
    
       // Update Rosenbluth weight (orientation bias has been removed earlier)
       rosenbluth *= wExt;
@@ -324,13 +324,21 @@ namespace McMd
          lengthSq = boundary().distanceSq(trialPos[iTrial], nextPos);
          bondEnergy[iTrial] = 
             system().bondPotential().energy(lengthSq, nextBType);
-         partPtr->position() = trialPos[iTrial];
+      }
 
-         #ifndef SIMP_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*partPtr);
-         #else
+      // Nonbonded pair energies of all trials
+      #ifndef SIMP_NOPAIR
+      system().pairPotential().
+               trialEnergies(*partPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
          trialEnergy[iTrial] = 0.0;
-         #endif
+      }
+      #endif
+
+      // Add angle and external energies, and compute Boltzmann weights
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
+         partPtr->position() = trialPos[iTrial];
 
          #ifdef SIMP_ANGLE
          if (system().hasAnglePotential()) {
@@ -346,6 +354,13 @@ namespace McMd
          }
          #endif
 
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            trialEnergy[iTrial] += 
+                  system().coulombPotential().rSpaceAtomEnergy(*partPtr);
+         }
+         #endif
+
          trialProb[iTrial] =
             boltzmann(trialEnergy[iTrial] + bondEnergy[iTrial]);
          wExt += trialProb[iTrial];
@@ -9,6 +9,10 @@
 #include <mcMd/mcSimulation/McSystem.h>
 #ifndef SIMP_NOPAIR
 #include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/mcSimulation/McEnergyCache.h>
+#endif
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
 #endif
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
@@ -80,23 +84,60 @@ namespace McMd
       iAtom   = random().uniformInt(0, molPtr->nAtom());
       atomPtr = &molPtr->atom(iAtom);
 
-      // Calculate current pair energy and store old position
+      #ifndef SIMP_NOPAIR
+      McEnergyCache* cachePtr = 0;
+      if (system().hasEnergyCache()) {
+         cachePtr = &system().energyCache();
+      }
+      #endif
+
+      // Calculate current energy and store old position
       oldPos    = atomPtr->position();
-      oldEnergy = system().atomPotentialEnergy(*atomPtr);
+      #ifndef SIMP_NOPAIR
+      if (cachePtr) {
+         oldEnergy = cachePtr->atomEnergy(*atomPtr);
+      } else
+      #endif
+      {
+         oldEnergy = system().atomPotentialEnergy(*atomPtr);
+      }
 
       for (int j = 0; j < Dimension; ++j) {
          atomPtr->position()[j] += random().uniform(-delta_, delta_);
       }
       boundary().shift(atomPtr->position());
-      newEnergy = system().atomPotentialEnergy(*atomPtr);
+      #ifndef SIMP_NOPAIR
+      if (cachePtr) {
+         newEnergy = cachePtr->trialEnergy(*atomPtr);
+      } else
+      #endif
+      {
+         newEnergy = system().atomPotentialEnergy(*atomPtr);
+      }
+      #ifdef SIMP_COULOMB
+      if (system().hasCoulombPotential()) {
+         McCoulombPotential& coulomb = system().coulombPotential();
+         coulomb.clearTrial();
+         coulomb.addTrialMove(*atomPtr, oldPos, atomPtr->position());
+         newEnergy += coulomb.trialEnergy();
+      }
+      #endif
 
       // Decide whether to accept forward move
       bool accept = random().metropolis(boltzmann(newEnergy - oldEnergy));
 
       if (accept) {
          #ifndef SIMP_NOPAIR
+         if (cachePtr) {
+            cachePtr->acceptMove(*atomPtr, oldPos);
+         }
          system().pairPotential().updateAtomCell(*atomPtr);
          #endif
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            system().coulombPotential().acceptTrial();
+         }
+         #endif
          incrementNAccept();
       } else {
          atomPtr->position() = oldPos;
@@ -105,4 +146,18 @@ namespace McMd
       return accept;
    }
 
+   /*
+   * Return true: move() updates the energy cache, if any.
+   */
+   bool AtomDisplaceMove::keepsEnergyCache() const
+   {  return true; }
+
+   #ifdef SIMP_COULOMB
+   /*
+   * Return true: move() includes r-space and k-space Coulomb energy.
+   */
+   bool AtomDisplaceMove::includesCoulomb() const
+   {  return true; }
+   #endif
+
 }      
@@ -59,6 +59,18 @@ namespace McMd
       */
       virtual bool move();
 
+      /**
+      * Return true: this move updates the energy cache, if any.
+      */
+      virtual bool keepsEnergyCache() const;
+
+      #ifdef SIMP_COULOMB
+      /**
+      * Return true: this move includes Coulomb energy changes.
+      */
+      virtual bool includesCoulomb() const;
+      #endif
+
    private:
 
       /// Maximum magnitude of displacement.
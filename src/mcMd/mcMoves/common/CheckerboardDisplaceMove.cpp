@@ -0,0 +1,475 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CheckerboardDisplaceMove.h"
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/pair/McPairPotential.h>
+#ifdef SIMP_BOND
+#include <mcMd/potentials/bond/BondPotential.h>
+#endif
+#ifdef SIMP_ANGLE
+#include <mcMd/potentials/angle/AnglePotential.h>
+#endif
+#ifdef SIMP_DIHEDRAL
+#include <mcMd/potentials/dihedral/DihedralPotential.h>
+#endif
+#ifdef SIMP_EXTERNAL
+#include <mcMd/potentials/external/ExternalPotential.h>
+#endif
+#include <mcMd/chemistry/getAtomGroups.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <simp/boundary/Boundary.h>
+#include <util/random/Random.h>
+#include <util/space/Vector.h>
+#include <util/space/Dimension.h>
+#include <util/misc/Log.h>
+#include <util/global.h>
+
+#ifdef MCMD_OPENMP
+#include <omp.h>
+#endif
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor
+   */
+   CheckerboardDisplaceMove::CheckerboardDisplaceMove(McSystem& system)
+    : SystemMove(system),
+      nTrialTotal_(0),
+      nAcceptTotal_(0),
+      delta_(0.0),
+      speciesId_(-1),
+      nThread_(0),
+      nThreadCapacity_(0)
+   {  setClassName("CheckerboardDisplaceMove"); }
+
+   /*
+   * Destructor.
+   */
+   CheckerboardDisplaceMove::~CheckerboardDisplaceMove()
+   {
+      for (int i = 0; i < nThreadCapacity_; ++i) {
+         delete randoms_[i];
+      }
+   }
+
+   /*
+   * Read speciesId, delta and optional nThread.
+   */
+   void CheckerboardDisplaceMove::readParameters(std::istream& in)
+   {
+      readProbability(in);
+      read<int>(in, "speciesId", speciesId_);
+      read<double>(in, "delta", delta_);
+      nThread_ = 0;
+      readOptional<int>(in, "nThread", nThread_);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void CheckerboardDisplaceMove::loadParameters(Serializable::IArchive &ar)
+   {
+      McMove::loadParameters(ar);
+      loadParameter<int>(ar, "speciesId", speciesId_);
+      loadParameter<double>(ar, "delta", delta_);
+      nThread_ = 0;
+      loadParameter<int>(ar, "nThread", nThread_, false);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void CheckerboardDisplaceMove::save(Serializable::OArchive &ar)
+   {
+      McMove::save(ar);
+      ar << speciesId_;
+      ar << delta_;
+      Parameter::saveOptional(ar, nThread_, (bool)(nThread_ > 0));
+   }
+
+   /*
+   * Check potentials, and allocate per-thread work space.
+   */
+   void CheckerboardDisplaceMove::allocate()
+   {
+      #ifdef MCMD_LINK
+      if (system().hasLinkPotential()) {
+         UTIL_THROW("CheckerboardDisplaceMove cannot be used with links");
+      }
+      #endif
+
+      #ifdef MCMD_OPENMP
+      nThreadCapacity_ = nThread_ > 0 ? nThread_ : omp_get_max_threads();
+      #else
+      nThreadCapacity_ = 1;
+      #endif
+      // Growth of a PackedCellList by one thread would invalidate all cells
+      if (system().pairPotential().hasPackedCells() && nThreadCapacity_ > 1) {
+         UTIL_THROW("CheckerboardDisplaceMove threads require packedCells = 0");
+      }
+      randoms_.allocate(nThreadCapacity_);
+      neighbors_.allocate(nThreadCapacity_);
+      nTrials_.allocate(nThreadCapacity_);
+      nAccepts_.allocate(nThreadCapacity_);
+      for (int i = 0; i < nThreadCapacity_; ++i) {
+         randoms_[i] = new Random();
+         randoms_[i]->setSeed(random().uniformInt(1, 1000000000));
+      }
+
+      atomDomains_.allocate(system().simulation().atomCapacity());
+   }
+
+   /*
+   * Choose the domain grid and a random shift of the checkerboard.
+   *
+   * Domains are at least one cell wide, and at least two cells wide
+   * when the grid is large enough, to limit rejection of moves near
+   * domain boundaries. The number of domains along each axis is even,
+   * except along an axis with a single cell, so that domain colors
+   * alternate across periodic boundaries.
+   */
+   void CheckerboardDisplaceMove::setupDomains()
+   {
+      const CellList& cellList = system().pairPotential().cellList();
+      int nDomain = 1;
+      for (int i = 0; i < Dimension; ++i) {
+         nCells_[i] = cellList.gridDimension(i);
+         if (nCells_[i] < 2) {
+            nDomains_[i] = 1;
+         } else if (nCells_[i] < 8) {
+            nDomains_[i] = 2;
+         } else {
+            nDomains_[i] = 2*(nCells_[i]/4);
+         }
+         offsets_[i] = random().uniformInt(0, nCells_[i]);
+         nDomain *= nDomains_[i];
+      }
+      if (domainBegins_.capacity() < nDomain + 1) {
+         if (domainBegins_.isAllocated()) {
+            domainBegins_.deallocate();
+            colorDomains_.deallocate();
+         }
+         domainBegins_.allocate(nDomain + 1);
+         colorDomains_.allocate(nDomain);
+      }
+   }
+
+   /*
+   * Return the index of the domain containing a cell.
+   */
+   inline int CheckerboardDisplaceMove::domainIndex(int cellId) const
+   {
+      int c[Dimension];
+      c[2] = cellId % nCells_[2];
+      c[1] = (cellId / nCells_[2]) % nCells_[1];
+      c[0] = cellId / (nCells_[2]*nCells_[1]);
+      int d[Dimension];
+      for (int i = 0; i < Dimension; ++i) {
+         c[i] = (c[i] + nCells_[i] - offsets_[i]) % nCells_[i];
+         d[i] = (c[i]*nDomains_[i])/nCells_[i];
+      }
+      return d[2] + nDomains_[2]*(d[1] + nDomains_[1]*d[0]);
+   }
+
+   /*
+   * Return the color of a domain, from the parities of its coordinates.
+   */
+   inline int CheckerboardDisplaceMove::color(int domainId) const
+   {
+      int d2 = domainId % nDomains_[2];
+      int d1 = (domainId / nDomains_[2]) % nDomains_[1];
+      int d0 = domainId / (nDomains_[2]*nDomains_[1]);
+      return 4*(d0 % 2) + 2*(d1 % 2) + (d2 % 2);
+   }
+
+   /*
+   * Return false if the atom shares a covalent group with an atom in a
+   * different domain of the same color, which may be moved concurrently.
+   */
+   bool
+   CheckerboardDisplaceMove::isMovable(const Atom& atom, int domainId) const
+   {
+      int c = color(domainId);
+      int j, k, otherId;
+
+      #ifdef SIMP_BOND
+      AtomBondArray bonds;
+      getAtomBonds(atom, bonds);
+      for (j = 0; j < bonds.size(); ++j) {
+         for (k = 0; k < 2; ++k) {
+            otherId = atomDomains_[bonds[j]->atom(k).id()];
+            if (otherId != domainId && color(otherId) == c) return false;
+         }
+      }
+      #endif
+
+      #ifdef SIMP_ANGLE
+      AtomAngleArray angles;
+      getAtomAngles(atom, angles);
+      for (j = 0; j < angles.size(); ++j) {
+         for (k = 0; k < 3; ++k) {
+            otherId = atomDomains_[angles[j]->atom(k).id()];
+            if (otherId != domainId && color(otherId) == c) return false;
+         }
+      }
+      #endif
+
+      #ifdef SIMP_DIHEDRAL
+      AtomDihedralArray dihedrals;
+      getAtomDihedrals(atom, dihedrals);
+      for (j = 0; j < dihedrals.size(); ++j) {
+         for (k = 0; k < 4; ++k) {
+            otherId = atomDomains_[dihedrals[j]->atom(k).id()];
+            if (otherId != domainId && color(otherId) == c) return false;
+         }
+      }
+      #endif
+
+      return true;
+   }
+
+   /*
+   * Energy of one atom. Equivalent to McSystem::atomPotentialEnergy,
+   * except that the pair energy uses the work array neighbors.
+   */
+   double
+   CheckerboardDisplaceMove::atomEnergy(const Atom& atom,
+                                        CellList::NeighborArray& neighbors)
+   {
+      double energy = system().pairPotential().atomEnergy(atom, neighbors);
+      #ifdef SIMP_BOND
+      if (system().hasBondPotential()) {
+         energy += system().bondPotential().atomEnergy(atom);
+      }
+      #endif
+      #ifdef SIMP_ANGLE
+      if (system().hasAnglePotential()) {
+         energy += system().anglePotential().atomEnergy(atom);
+      }
+      #endif
+      #ifdef SIMP_DIHEDRAL
+      if (system().hasDihedralPotential()) {
+         energy += system().dihedralPotential().atomEnergy(atom);
+      }
+      #endif
+      #ifdef SIMP_EXTERNAL
+      if (system().hasExternalPotential()) {
+         energy += system().externalPotential().atomEnergy(atom);
+      }
+      #endif
+      return energy;
+   }
+
+   /*
+   * Attempt about one displacement per atom of one domain.
+   *
+   * Uses only the random number generator and work space of thread
+   * threadId, and modifies only atoms and cells in this domain.
+   */
+   void CheckerboardDisplaceMove::sweepDomain(int domainId, int threadId)
+   {
+      Random& random = *randoms_[threadId];
+      CellList::NeighborArray& neighbors = neighbors_[threadId];
+      const CellList& cellList = system().pairPotential().cellList();
+      Boundary& boundary = system().boundary();
+      Vector oldPos;
+      double newEnergy, oldEnergy;
+      Atom*  atomPtr;
+      long   nTrial = 0;
+      long   nAccept = 0;
+      int    begin = domainBegins_[domainId];
+      int    nAtom = domainBegins_[domainId + 1] - begin;
+      bool   accept;
+
+      for (int i = 0; i < nAtom; ++i) {
+         atomPtr = domainAtoms_[begin + random.uniformInt(0, nAtom)];
+         ++nTrial;
+         if (!isMovable(*atomPtr, domainId)) continue;
+
+         oldPos    = atomPtr->position();
+         oldEnergy = atomEnergy(*atomPtr, neighbors);
+
+         for (int j = 0; j < Dimension; ++j) {
+            atomPtr->position()[j] += random.uniform(-delta_, delta_);
+         }
+         boundary.shift(atomPtr->position());
+
+         // Reject any move out of the domain
+         accept = false;
+         if (domainIndex(cellList.cellIndexFromPosition(atomPtr->position()))
+             == domainId) {
+            newEnergy = atomEnergy(*atomPtr, neighbors);
+            accept = random.metropolis(boltzmann(newEnergy - oldEnergy));
+         }
+
+         if (accept) {
+            system().pairPotential().updateAtomCell(*atomPtr);
+            ++nAccept;
+         } else {
+            atomPtr->position() = oldPos;
+         }
+      }
+      nTrials_[threadId] += nTrial;
+      nAccepts_[threadId] += nAccept;
+   }
+
+   /*
+   * Perform one sweep of trial moves over all domains.
+   */
+   bool CheckerboardDisplaceMove::move()
+   {
+      if (nThreadCapacity_ == 0) {
+         allocate();
+      }
+      incrementNAttempt();
+      setupDomains();
+      const CellList& cellList = system().pairPotential().cellList();
+      int nDomain = nDomains_[0]*nDomains_[1]*nDomains_[2];
+      int i, j, k;
+
+      // Assign every atom of the system to a domain, and count atoms
+      // of the chosen species in each domain.
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      int nSpecies = system().simulation().nSpecies();
+      int nAtom = 0;
+      for (i = 0; i <= nDomain; ++i) {
+         domainBegins_[i] = 0;
+      }
+      for (i = 0; i < nSpecies; ++i) {
+         system().begin(i, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               j = domainIndex(cellList.cellIndexFromPosition(
+                                                  atomIter->position()));
+               atomDomains_[atomIter->id()] = j;
+               if (i == speciesId_) {
+                  ++domainBegins_[j + 1];
+                  ++nAtom;
+               }
+            }
+         }
+      }
+
+      // Sort atoms of the species by domain (counting sort)
+      for (i = 0; i < nDomain; ++i) {
+         domainBegins_[i + 1] += domainBegins_[i];
+      }
+      if (domainAtoms_.capacity() < nAtom) {
+         if (domainAtoms_.isAllocated()) {
+            domainAtoms_.deallocate();
+         }
+         domainAtoms_.allocate(nAtom);
+      }
+      system().begin(speciesId_, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            j = atomDomains_[atomIter->id()];
+            domainAtoms_[domainBegins_[j]] = &(*atomIter);
+            ++domainBegins_[j];
+         }
+      }
+      for (i = nDomain; i > 0; --i) {
+         domainBegins_[i] = domainBegins_[i - 1];
+      }
+      domainBegins_[0] = 0;
+
+      // Choose a random order of the 8 colors
+      int colors[8];
+      for (i = 0; i < 8; ++i) {
+         colors[i] = i;
+      }
+      for (i = 7; i > 0; --i) {
+         j = random().uniformInt(0, i + 1);
+         k = colors[i];
+         colors[i] = colors[j];
+         colors[j] = k;
+      }
+
+      for (i = 0; i < nThreadCapacity_; ++i) {
+         nTrials_[i] = 0;
+         nAccepts_[i] = 0;
+      }
+
+      // Sweep domains of each color. Domains of one color do not
+      // interact, and so may be swept concurrently. Exceptions may
+      // not leave a parallel region, and are re-thrown after it.
+      int nColorDomain;
+      int c;
+      bool hasError = false;
+      for (c = 0; c < 8; ++c) {
+         nColorDomain = 0;
+         for (i = 0; i < nDomain; ++i) {
+            if (color(i) == colors[c]) {
+               colorDomains_[nColorDomain] = i;
+               ++nColorDomain;
+            }
+         }
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(dynamic, 1) \
+                 num_threads(nThreadCapacity_)
+         #endif
+         for (i = 0; i < nColorDomain; ++i) {
+            try {
+               #ifdef MCMD_OPENMP
+               sweepDomain(colorDomains_[i], omp_get_thread_num());
+               #else
+               sweepDomain(colorDomains_[i], 0);
+               #endif
+            } catch (...) {
+               #ifdef MCMD_OPENMP
+               #pragma omp critical
+               #endif
+               hasError = true;
+            }
+         }
+         if (hasError) {
+            UTIL_THROW("Exception in checkerboard sweep");
+         }
+      }
+
+      long nTrial = 0;
+      long nAccept = 0;
+      for (i = 0; i < nThreadCapacity_; ++i) {
+         nTrial += nTrials_[i];
+         nAccept += nAccepts_[i];
+      }
+      nTrialTotal_ += nTrial;
+      nAcceptTotal_ += nAccept;
+
+      if (nAccept > 0) {
+         incrementNAccept();
+         return true;
+      } else {
+         return false;
+      }
+   }
+
+   /*
+   * Output acceptance statistics for individual trial moves.
+   */
+   void CheckerboardDisplaceMove::output()
+   {
+      Log::file() << "CheckerboardDisplaceMove: speciesId = " << speciesId_
+                  << ", trial moves = " << nTrialTotal_
+                  << ", accepted = " << nAcceptTotal_;
+      if (nTrialTotal_ > 0) {
+         Log::file() << ", acceptance ratio = "
+                     << double(nAcceptTotal_)/double(nTrialTotal_);
+      }
+      Log::file() << std::endl;
+   }
+
+}
@@ -0,0 +1,198 @@
+#ifndef MCMD_CHECKERBOARD_DISPLACE_MOVE_H
+#define MCMD_CHECKERBOARD_DISPLACE_MOVE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mcMoves/SystemMove.h>        // base class
+#include <mcMd/neighbor/CellList.h>         // typedef in member
+#include <util/containers/DArray.h>         // member template
+#include <util/space/IntVector.h>           // member
+#include <util/global.h>
+
+namespace Util { class Random; }
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class McSystem;
+
+   /**
+   * Sweep of random single atom displacements, on a checkerboard.
+   *
+   * Each call to move() performs a sweep of single atom displacements
+   * of all atoms of one species, with about one trial per atom. The
+   * grid of the pair potential cell list is divided into an even number
+   * of domains along each axis, each at least one cell wide, and these
+   * domains are colored like a three dimensional checkerboard, with 8
+   * colors. Domains of the same color are separated by at least one
+   * domain, and thus by at least the pair cutoff, so atoms in different
+   * domains of the same color do not interact. The domains of each color
+   * are swept in turn, in random order, and the domains of one color may
+   * be swept concurrently by different threads.
+   *
+   * Trial moves that would take an atom out of its domain are rejected.
+   * To preserve detailed balance and allow atoms to cross domain
+   * boundaries, the checkerboard is shifted by a random number of cells
+   * along each axis at the beginning of every sweep. A trial move of an
+   * atom is also rejected if the atom shares a bond, angle or dihedral
+   * with an atom in a different domain of the same color.
+   *
+   * If compiled with MCMD_OPENMP defined, the domains of each color are
+   * distributed among a pool of OpenMP threads, each of which has its
+   * own random number generator. Otherwise, they are swept sequentially.
+   *
+   * Each sweep counts as a single attempt in the statistics kept by the
+   * McMove base class, which is counted as accepted if any trial move
+   * was accepted. Acceptance statistics for individual trial moves are
+   * written by output().
+   *
+   * \sa \ref mcMd_mcMove_CheckerboardDisplaceMove_page "parameter file format"
+   *
+   * \ingroup McMd_McMove_Module McMove_Module
+   */
+   class CheckerboardDisplaceMove : public SystemMove
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CheckerboardDisplaceMove(McSystem& system);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CheckerboardDisplaceMove();
+
+      /**
+      * Read speciesId, delta and optional nThread.
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Perform one sweep of trial moves over all domains.
+      *
+      * \return true if any trial move was accepted
+      */
+      virtual bool move();
+
+      /**
+      * Output acceptance statistics for individual trial moves.
+      */
+      virtual void output();
+
+   private:
+
+      /// Number of domains along each axis (even).
+      IntVector nDomains_;
+
+      /// Number of cells along each axis in the current sweep.
+      IntVector nCells_;
+
+      /// Shift of the checkerboard in the current sweep, in cells.
+      IntVector offsets_;
+
+      /// Domain index for every atom in the system, indexed by atom id.
+      DArray<int> atomDomains_;
+
+      /// Pointers to atoms of the species, sorted by domain.
+      DArray<Atom*> domainAtoms_;
+
+      /// Index of first element of domainAtoms_ for each domain.
+      DArray<int> domainBegins_;
+
+      /// Indices of the domains of the current color.
+      DArray<int> colorDomains_;
+
+      /// Random number generator for each thread.
+      DArray<Random*> randoms_;
+
+      /// Neighbor work array for each thread.
+      DArray<CellList::NeighborArray> neighbors_;
+
+      /// Number of trial moves by each thread in the current sweep.
+      DArray<long> nTrials_;
+
+      /// Number of accepted trial moves by each thread in current sweep.
+      DArray<long> nAccepts_;
+
+      /// Total number of trial moves.
+      long nTrialTotal_;
+
+      /// Total number of accepted trial moves.
+      long nAcceptTotal_;
+
+      /// Maximum magnitude of displacement.
+      double delta_;
+
+      /// Integer Id of Species.
+      int speciesId_;
+
+      /// Maximum number of threads (0 for the OpenMP default).
+      int nThread_;
+
+      /// Number of threads for which work space is allocated.
+      int nThreadCapacity_;
+
+      /*
+      * Check potentials, and allocate per-thread work space.
+      */
+      void allocate();
+
+      /*
+      * Set up domain grid and checkerboard shift for a new sweep.
+      */
+      void setupDomains();
+
+      /*
+      * Return the index of the domain containing a cell.
+      */
+      int domainIndex(int cellId) const;
+
+      /*
+      * Return the color of a domain, 0 <= color < 8.
+      */
+      int color(int domainId) const;
+
+      /*
+      * Can an atom be moved without affecting atoms in other domains?
+      */
+      bool isMovable(const Atom& atom, int domainId) const;
+
+      /*
+      * Sweep trial moves over the atoms of one domain.
+      */
+      void sweepDomain(int domainId, int threadId);
+
+      /*
+      * Energy of one atom, without modifying any shared work space.
+      */
+      double atomEnergy(const Atom& atom,
+                        CellList::NeighborArray& neighbors);
+
+   };
+
+}
+#endif
@@ -131,7 +131,7 @@ namespace McMd
       nphIntegratorPtr_->setup();
       
       // generate integrator variables from a Gaussian distribution
-      Random& random = simulation().random();
+      Random& random = system().random();
       
       double temp = system().energyEnsemble().temperature();
        
@@ -103,6 +103,12 @@ namespace McMd
             oldEnergy += system().externalPotential().atomEnergy(*atomPtr);
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            oldEnergy += 
+                  system().coulombPotential().rSpaceAtomEnergy(*atomPtr);
+         }
+         #endif
          #ifdef SIMP_TETHER
          oldEnergy += system().atomTetherEnergy(*atomPtr);
          #endif
@@ -113,6 +119,12 @@ namespace McMd
          dr[j] = random().uniform(-delta_, delta_);
       }
 
+      #ifdef SIMP_COULOMB
+      if (system().hasCoulombPotential()) {
+         system().coulombPotential().clearTrial();
+      }
+      #endif
+
       // Move every atom by dr and calculate new trial energy.
       newEnergy = 0.0;
       for (iAtom = 0; iAtom < nAtom_; ++iAtom) {
@@ -120,6 +132,7 @@ namespace McMd
          atomPtr->position() += dr;
          boundary().shift(atomPtr->position());
          #ifndef SIMP_NOPAIR
+         system().pairPotential().updateAtomCell(*atomPtr);
          newEnergy += system().pairPotential().atomEnergy(*atomPtr);
          #endif
          #ifdef SIMP_EXTERNAL
@@ -127,34 +140,59 @@ namespace McMd
             newEnergy += system().externalPotential().atomEnergy(*atomPtr);
          }
          #endif
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            McCoulombPotential& coulomb = system().coulombPotential();
+            newEnergy += coulomb.rSpaceAtomEnergy(*atomPtr);
+            coulomb.addTrialMove(*atomPtr, oldPositions_[iAtom], 
+                                 atomPtr->position());
+         }
+         #endif
          #ifdef SIMP_TETHER
          newEnergy += system().atomTetherEnergy(*atomPtr);
          #endif
       }
 
+      #ifdef SIMP_COULOMB
+      if (system().hasCoulombPotential()) {
+         newEnergy += system().coulombPotential().trialEnergy();
+      }
+      #endif
+
       // Decide whether to accept the move
       bool accept = random().metropolis(boltzmann(newEnergy - oldEnergy));
 
       if (accept) {
    
-         #ifndef SIMP_NOPAIR
-         // Update cell
-         for (iAtom = 0; iAtom < nAtom_; ++iAtom) {
-            system().pairPotential().updateAtomCell(molPtr->atom(iAtom));
+         // Cells were updated as atoms were moved
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            system().coulombPotential().acceptTrial();
          }
          #endif
-
          incrementNAccept();
 
       } else {
    
          // Return atoms to original positions
          for (iAtom = 0; iAtom < nAtom_; ++iAtom) {
-            molPtr->atom(iAtom).position() = oldPositions_[iAtom];
+            atomPtr = &molPtr->atom(iAtom);
+            atomPtr->position() = oldPositions_[iAtom];
+            #ifndef SIMP_NOPAIR
+            system().pairPotential().updateAtomCell(*atomPtr);
+            #endif
          }
    
       }
       return accept;
    }
 
+   #ifdef SIMP_COULOMB
+   /*
+   * Return true: move() includes r-space and k-space Coulomb energy.
+   */
+   bool RigidDisplaceMove::includesCoulomb() const
+   {  return true; }
+   #endif
+
 }      
@@ -72,6 +72,13 @@ namespace McMd
       */
       virtual bool move();
 
+      #ifdef SIMP_COULOMB
+      /**
+      * Return true: this move includes Coulomb energy changes.
+      */
+      virtual bool includesCoulomb() const;
+      #endif
+
    private:
 
       /// Array of old positions.
@@ -6,6 +6,11 @@ mcMd_mcMoves_common_=\
     mcMd/mcMoves/common/MdMove.cpp \
     mcMd/mcMoves/common/RigidDisplaceMove.cpp 
 
+ifndef SIMP_NOPAIR
+mcMd_mcMoves_common_+=\
+    mcMd/mcMoves/common/CheckerboardDisplaceMove.cpp 
+endif
+
 mcMd_mcMoves_common_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_mcMoves_common_))
 mcMd_mcMoves_common_OBJS=\
@@ -13,6 +13,10 @@
 #include <mcMd/chemistry/Atom.h>
 #ifndef SIMP_NOPAIR
 #include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/mcSimulation/McEnergyCache.h>
+#endif
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
 #endif
 #include <simp/species/Linear.h>
 #include <simp/boundary/Boundary.h>
@@ -180,14 +184,43 @@ namespace McMd
       }
    
       // Decide whether to accept or reject
-      accept = random().metropolis(rosen_f/rosen_r);
+      double ratio = rosen_f/rosen_r;
+      #ifdef SIMP_COULOMB
+      // The k-space Coulomb energy is not included in the Rosenbluth
+      // factors, but is instead included in the acceptance criterion.
+      if (system().hasCoulombPotential()) {
+         McCoulombPotential& coulomb = system().coulombPotential();
+         coulomb.clearTrial();
+         endPtr = &(molPtr->atom(beginId));
+         for (i = 0; i < nRegrow_; ++i) {
+            coulomb.addTrialMove(*endPtr, oldPos_[i], endPtr->position());
+            endPtr += sign;
+         }
+         ratio *= boltzmann(coulomb.trialEnergy());
+      }
+      #endif
+      accept = random().metropolis(ratio);
       if (accept) {
 
          // Increment counter for accepted moves of this class.
          incrementNAccept();
 
+         #ifdef SIMP_COULOMB
+         if (system().hasCoulombPotential()) {
+            system().coulombPotential().acceptTrial();
+         }
+         #endif
+
          // If the move is accepted, keep current positions.
 
+         #ifndef SIMP_NOPAIR
+         // Replay the regrowth, one atom at a time, in the energy cache
+         if (system().hasEnergyCache()) {
+            system().energyCache().acceptSequence(&(molPtr->atom(beginId)),
+                                                  sign, nRegrow_, oldPos_);
+         }
+         #endif
+
       } else {
 
          // If the move is rejected, restore old positions
@@ -206,4 +239,19 @@ namespace McMd
       return accept;
    
    }
+
+   /*
+   * Return true: move() updates the energy cache, if any.
+   */
+   bool CfbEndMove::keepsEnergyCache() const
+   {  return true; }
+
+   #ifdef SIMP_COULOMB
+   /*
+   * Return true: move() includes r-space and k-space Coulomb energy.
+   */
+   bool CfbEndMove::includesCoulomb() const
+   {  return true; }
+   #endif
+
 }
@@ -62,6 +62,18 @@ namespace McMd
       * Generate and accept or reject configuration bias move
       */
       virtual bool move();
+
+      /**
+      * Return true: this move updates the energy cache, if any.
+      */
+      virtual bool keepsEnergyCache() const;
+
+      #ifdef SIMP_COULOMB
+      /**
+      * Return true: this move includes Coulomb energy changes.
+      */
+      virtual bool includesCoulomb() const;
+      #endif
    
    protected:
    
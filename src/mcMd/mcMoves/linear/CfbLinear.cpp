@@ -142,12 +142,12 @@ namespace McMd
       u1 = v1;
       u1 /= r1;      // bond unit vector
 
-      #ifndef SIMP_NOPAIR
-      McPairPotential& pairPotential = system().pairPotential();
-      energy = pairPotential.atomEnergy(atom0);
-      #else
-      energy = 0.0;
-      #endif
+      // Trial 0 is the current position. Until pair energies are added
+      // below, trialEnergy holds only angle energies.
+      Vector trialPos[MaxTrial_];
+      double trialEnergy[MaxTrial_];
+      trialPos[0] = pos0;
+      trialEnergy[0] = 0.0;
 
       #ifdef SIMP_ANGLE
       Vector u2;
@@ -174,63 +174,65 @@ namespace McMd
             double cosTheta = u1.dot(u2);
             angleTypeId = molecule.bond(atomId - 2*shift).typeId();
             anglePotentialPtr = &system().anglePotential();
-            energy += anglePotentialPtr->energy(cosTheta, angleTypeId);
+            trialEnergy[0] = anglePotentialPtr->energy(cosTheta, angleTypeId);
          }
       }
       #endif
 
-      #ifdef SIMP_EXTERNAL
-      ExternalPotential* externalPotentialPtr = 0;
-      if (hasExternal_) {
-         externalPotentialPtr = &system().externalPotential();
-         assert(externalPotentialPtr);
-         energy += externalPotentialPtr->atomEnergy(atom0);
-      }
-      #endif
-
-      // Here: energy = total energy - bond energy
-      // Rosenbluth factor = exp(-beta*(pair + angle + external))
-      rosenbluth = boltzmann(energy);
-
-      // Add bond energy to total energy in current position
-      energy += bondEnergy;
-
-      // Loop over nTrial - 1 additional trial positions:
-      double trialEnergy;
-      for (int iTrial = 0; iTrial < nTrial_ - 1; ++iTrial) {
-
-         // Generate trial position
+      // Generate nTrial - 1 additional trial positions
+      int iTrial;
+      for (iTrial = 1; iTrial < nTrial_; ++iTrial) {
          random().unitVector(u1);
          v1 = u1;
          v1 *= r1;
-         pos0.subtract(pos1, v1);
-         boundary().shift(pos0);
-
-         // Compute trial energy (excluding bond energy)
-         #ifndef SIMP_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(atom0);
-         #else
-         trialEnergy = 0.0;
-         #endif
+         trialPos[iTrial].subtract(pos1, v1);
+         boundary().shift(trialPos[iTrial]);
+         trialEnergy[iTrial] = 0.0;
          #ifdef SIMP_ANGLE
          if (hasAngles_) {
             if (hasAngle) {
                assert(anglePotentialPtr);
                double cosTheta = u1.dot(u2);
-               trialEnergy += anglePotentialPtr->energy(cosTheta, angleTypeId);
+               trialEnergy[iTrial] = 
+                  anglePotentialPtr->energy(cosTheta, angleTypeId);
             }
          }
          #endif
+      }
+
+      // Add pair energies of all trials, computed together
+      #ifndef SIMP_NOPAIR
+      double pairEnergy[MaxTrial_];
+      system().pairPotential().
+               trialEnergies(atom0, trialPos, nTrial_, pairEnergy);
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] += pairEnergy[iTrial];
+      }
+      #endif
+
+      #ifdef SIMP_EXTERNAL
+      ExternalPotential* externalPotentialPtr = 0;
+      if (hasExternal_) {
+         externalPotentialPtr = &system().externalPotential();
+         assert(externalPotentialPtr);
+      }
+      #endif
+
+      // Rosenbluth factor = sum of exp(-beta*(pair + angle + external))
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         pos0 = trialPos[iTrial];
          #ifdef SIMP_EXTERNAL
          if (hasExternal_) {
-            assert(externalPotentialPtr);
-            trialEnergy += externalPotentialPtr->atomEnergy(atom0);
+            trialEnergy[iTrial] += externalPotentialPtr->atomEnergy(atom0);
          }
          #endif
-
-         rosenbluth += boltzmann(trialEnergy);
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
 
+      // Total energy in current position, including bond energy
+      energy = trialEnergy[0] + bondEnergy;
+
    }
 
    /*
@@ -256,10 +258,6 @@ namespace McMd
       beta = energyEnsemble().beta();
       r1 = system().bondPotential().randomBondLength(&random(), beta, bondTypeId);
 
-      #ifndef SIMP_NOPAIR
-      McPairPotential& pairPotential = system().pairPotential();
-      #endif
-
       #ifdef SIMP_ANGLE
       // Compute vector v2 = pos2 - pos1, r2 = |v2|
       Vector u2;
@@ -297,37 +295,46 @@ namespace McMd
       }
       #endif
 
-      // Loop over nTrial trial positions:
+      // Generate nTrial trial positions, and compute angle energies
       Vector v1, u1;
       Vector trialPos[MaxTrial_];
       double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
-      rosenbluth = 0.0;
       for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
 
-         // Generate trial bond vector v1 and position pos0
+         // Generate trial bond vector v1 and position
          random().unitVector(u1);
          v1 = u1;
          v1 *= r1;
          trialPos[iTrial].subtract(pos1, v1);
          boundary().shift(trialPos[iTrial]);
-         pos0 = trialPos[iTrial];
 
-         // Compute trial energy (excluding bond energy)
-         #ifndef SIMP_NOPAIR
-         trialEnergy[iTrial] = pairPotential.atomEnergy(atom0);
-         #else
          trialEnergy[iTrial] = 0.0;
-         #endif
          #ifdef SIMP_ANGLE
          if (hasAngles_) {
             if (hasAngle) {
                assert(anglePotentialPtr);
                double cosTheta = u1.dot(u2);
-               trialEnergy[iTrial] += 
+               trialEnergy[iTrial] = 
                   anglePotentialPtr->energy(cosTheta, angleTypeId);
             }
          }
          #endif
+      }
+
+      // Add pair energies of all trials, computed together
+      #ifndef SIMP_NOPAIR
+      double pairEnergy[MaxTrial_];
+      system().pairPotential().
+               trialEnergies(atom0, trialPos, nTrial_, pairEnergy);
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] += pairEnergy[iTrial];
+      }
+      #endif
+
+      // Add external energies, and compute Boltzmann weights
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         pos0 = trialPos[iTrial];
          #ifdef SIMP_EXTERNAL
          if (hasExternal_) {
             assert(externalPotentialPtr);
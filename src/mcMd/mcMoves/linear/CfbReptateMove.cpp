@@ -327,6 +327,7 @@ namespace McMd
 
          #ifndef SIMP_NOPAIR
          hAtomPtr->setTypeId(tType);
+         system().pairPotential().updateAtomType(*hAtomPtr);
          newEnergy = system().pairPotential().atomEnergy(*hAtomPtr);
          #else
          newEnergy = 0.0;
@@ -352,6 +353,7 @@ namespace McMd
             hType    = lTypes_[i];
          }
          hAtomPtr->setTypeId(hType);
+         system().pairPotential().updateAtomType(*hAtomPtr);
       }
       return factor;
 
@@ -356,6 +356,7 @@ namespace McMd
 
          #ifndef SIMP_NOPAIR
          hAtomPtr->setTypeId(tType);
+         system().pairPotential().updateAtomType(*hAtomPtr);
          newEnergy = system().pairPotential().atomEnergy(*hAtomPtr);
          #endif
 
@@ -382,6 +383,7 @@ namespace McMd
             hType    = lTypes_[i];
          }
          hAtomPtr->setTypeId(hType);
+         system().pairPotential().updateAtomType(*hAtomPtr);
       }
       return factor;
 
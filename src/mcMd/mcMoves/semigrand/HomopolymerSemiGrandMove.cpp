@@ -105,6 +105,13 @@ namespace McMd
 
       if (accept) {
 
+         #ifndef SIMP_NOPAIR
+         // Record new atom types in the cell list
+         for (int i = 0; i < molecule.nAtom(); ++i) {
+            system().pairPotential().updateAtomType(molecule.atom(i));
+         }
+         #endif
+
          incrementNAccept();
 
       } else {
@@ -79,6 +79,17 @@ namespace McMd
          bool isContinuation = true;
          simulation().simulate(endStep, isContinuation);
       } else
+      if (name == "SIMULATE_REPLICAS") {
+         int endStep;
+         in >> endStep;
+         Log::file() << "  " << endStep << std::endl;
+         simulation().replicaBatch().simulate(endStep);
+      } else
+      if (name == "WRITE_REPLICA_CONFIGS") {
+         in >> filename;
+         Log::file() << Str(filename, 15) << std::endl;
+         simulation().replicaBatch().writeConfigs(filename);
+      } else
       if (name == "ANALYZE_CONFIGS") {
          int min, max;
          in >> min >> max >> filename;
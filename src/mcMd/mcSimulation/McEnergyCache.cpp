@@ -0,0 +1,263 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "McEnergyCache.h"
+#include "McSystem.h"
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/chemistry/getAtomGroups.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   McEnergyCache::McEnergyCache(McSystem& system)
+    : totalEnergy_(0.0),
+      trialPairEnergy_(0.0),
+      trialNonPairEnergy_(0.0),
+      systemPtr_(&system),
+      trialAtomId_(-1),
+      isValid_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   McEnergyCache::~McEnergyCache()
+   {}
+
+   /*
+   * Allocate arrays of atomic energies.
+   */
+   void McEnergyCache::allocate(int atomCapacity)
+   {
+      pairEnergies_.allocate(atomCapacity);
+      nonPairEnergies_.allocate(atomCapacity);
+      atomCells_.allocate(atomCapacity);
+      isValid_ = false;
+   }
+
+   /*
+   * Compute energies of all atoms and cells, and the total energy.
+   */
+   void McEnergyCache::compute()
+   {
+      McSystem& system = *systemPtr_;
+      McPairPotential& pairPotential = system.pairPotential();
+      const CellList& cellList = pairPotential.cellList();
+
+      // Discard cached energies before computing the total, since
+      // McSystem::potentialEnergy() returns totalEnergy_ when valid.
+      isValid_ = false;
+      trialAtomId_ = -1;
+      system.positionSignal().notify();
+      totalEnergy_ = system.potentialEnergy();
+
+      // Reallocate cell totals if the number of cells has changed
+      int nCell = cellList.totCells();
+      if (cellEnergies_.isAllocated() && cellEnergies_.capacity() != nCell) {
+         cellEnergies_.deallocate();
+      }
+      if (!cellEnergies_.isAllocated()) {
+         cellEnergies_.allocate(nCell);
+      }
+      for (int ic = 0; ic < nCell; ++ic) {
+         cellEnergies_[ic] = 0.0;
+      }
+
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      int id, ic;
+      int nSpecies = system.simulation().nSpecies();
+      for (int iSpec = 0; iSpec < nSpecies; ++iSpec) {
+         for (system.begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               pairEnergies_[id] = pairPotential.atomEnergy(*atomIter);
+               nonPairEnergies_[id] = system.atomNonPairEnergy(*atomIter);
+               ic = cellList.cellIndexFromPosition(atomIter->position());
+               atomCells_[id] = ic;
+               cellEnergies_[ic] += pairEnergies_[id] + nonPairEnergies_[id];
+            }
+         }
+      }
+      isValid_ = true;
+   }
+
+   /*
+   * Return the cached potential energy of an atom.
+   */
+   double McEnergyCache::atomEnergy(const Atom& atom)
+   {
+      if (!isValid_) {
+         compute();
+      }
+      int id = atom.id();
+      return pairEnergies_[id] + nonPairEnergies_[id];
+   }
+
+   /*
+   * Compute the energy of an atom at a trial position, and retain the
+   * pair energies with all of its neighbors.
+   */
+   double McEnergyCache::trialEnergy(const Atom& atom)
+   {
+      assert(isValid_);
+      trialPairEnergy_ = systemPtr_->pairPotential().
+                         atomEnergy(atom, trialNeighbors_, trialEnergies_);
+      trialNonPairEnergy_ = systemPtr_->atomNonPairEnergy(atom);
+      trialAtomId_ = atom.id();
+      return trialPairEnergy_ + trialNonPairEnergy_;
+   }
+
+   /*
+   * Update cached energies after acceptance of a trial move.
+   *
+   * The pair energy of each neighbor is decreased by its pair energy
+   * with the atom at its old position, and increased by that at the new
+   * position. Pair energies with the moved atom itself, and with masked
+   * partners, are zero, and so may be added without a test. The energy
+   * of the moved atom is removed from the total of its old cell and
+   * added to that of its new cell.
+   */
+   void McEnergyCache::acceptMove(Atom& atom, const Vector& oldPosition)
+   {
+      assert(isValid_);
+      int id = atom.id();
+      if (trialAtomId_ != id) {
+         UTIL_THROW("acceptMove not preceded by trialEnergy for same atom");
+      }
+      double oldEnergy = pairEnergies_[id] + nonPairEnergies_[id];
+      double newEnergy = trialPairEnergy_ + trialNonPairEnergy_;
+      totalEnergy_ += newEnergy - oldEnergy;
+      cellEnergies_[atomCells_[id]] -= oldEnergy;
+
+      // Pair energies at the old position
+      Vector newPosition = atom.position();
+      atom.position() = oldPosition;
+      systemPtr_->pairPotential().atomEnergy(atom, oldNeighbors_,
+                                             oldEnergies_);
+      atom.position() = newPosition;
+
+      int j;
+      for (j = 0; j < oldNeighbors_.size(); ++j) {
+         addPairEnergy(oldNeighbors_[j]->id(), -oldEnergies_[j]);
+      }
+      for (j = 0; j < trialNeighbors_.size(); ++j) {
+         addPairEnergy(trialNeighbors_[j]->id(), trialEnergies_[j]);
+      }
+
+      // Move the energy of the atom to its new cell
+      pairEnergies_[id] = trialPairEnergy_;
+      nonPairEnergies_[id] = trialNonPairEnergy_;
+      atomCells_[id] = systemPtr_->pairPotential().cellList().
+                       cellIndexFromPosition(atom.position());
+      cellEnergies_[atomCells_[id]] += newEnergy;
+
+      updatePartners(atom);
+      trialAtomId_ = -1;
+   }
+
+   /*
+   * Move one atom, and update the cache and the CellList.
+   */
+   void McEnergyCache::moveAtom(Atom& atom, const Vector& position)
+   {
+      Vector oldPosition = atom.position();
+      atom.position() = position;
+      trialEnergy(atom);
+      acceptMove(atom, oldPosition);
+      systemPtr_->pairPotential().updateAtomCell(atom);
+   }
+
+   /*
+   * Update the cache after an accepted move of a sequence of atoms.
+   */
+   void McEnergyCache::acceptSequence(Atom* first, int stride, int nAtom,
+                                      const DArray<Vector>& oldPositions)
+   {
+      // An invalid cache will be rebuilt when next used.
+      if (!isValid_) return;
+
+      McPairPotential& pairPotential = systemPtr_->pairPotential();
+      Atom* atomPtr = first;
+      int i;
+      newPositions_.clear();
+      for (i = 0; i < nAtom; ++i) {
+         newPositions_.append(atomPtr->position());
+         atomPtr->position() = oldPositions[i];
+         pairPotential.updateAtomCell(*atomPtr);
+         atomPtr += stride;
+      }
+      atomPtr = first;
+      for (i = 0; i < nAtom; ++i) {
+         moveAtom(*atomPtr, newPositions_[i]);
+         atomPtr += stride;
+      }
+   }
+
+   /*
+   * Recompute the non-pair energy of every atom that shares a bond,
+   * angle or dihedral with an atom.
+   */
+   void McEnergyCache::updatePartners(const Atom& atom)
+   {
+      McSystem& system = *systemPtr_;
+      const Atom* otherPtr;
+      int j, k;
+
+      #ifdef SIMP_BOND
+      AtomBondArray bonds;
+      getAtomBonds(atom, bonds);
+      for (j = 0; j < bonds.size(); ++j) {
+         for (k = 0; k < 2; ++k) {
+            otherPtr = &bonds[j]->atom(k);
+            if (otherPtr != &atom) {
+               setNonPairEnergy(otherPtr->id(),
+                                system.atomNonPairEnergy(*otherPtr));
+            }
+         }
+      }
+      #endif
+
+      #ifdef SIMP_ANGLE
+      AtomAngleArray angles;
+      getAtomAngles(atom, angles);
+      for (j = 0; j < angles.size(); ++j) {
+         for (k = 0; k < 3; ++k) {
+            otherPtr = &angles[j]->atom(k);
+            if (otherPtr != &atom) {
+               setNonPairEnergy(otherPtr->id(),
+                                system.atomNonPairEnergy(*otherPtr));
+            }
+         }
+      }
+      #endif
+
+      #ifdef SIMP_DIHEDRAL
+      AtomDihedralArray dihedrals;
+      getAtomDihedrals(atom, dihedrals);
+      for (j = 0; j < dihedrals.size(); ++j) {
+         for (k = 0; k < 4; ++k) {
+            otherPtr = &dihedrals[j]->atom(k);
+            if (otherPtr != &atom) {
+               setNonPairEnergy(otherPtr->id(),
+                                system.atomNonPairEnergy(*otherPtr));
+            }
+         }
+      }
+      #endif
+   }
+
+}
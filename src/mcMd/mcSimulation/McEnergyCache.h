@@ -0,0 +1,274 @@
+#ifndef MCMD_MC_ENERGY_CACHE_H
+#define MCMD_MC_ENERGY_CACHE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/pair/McPairPotential.h>  // typedefs
+#include <mcMd/neighbor/CellList.h>                // typedef
+#include <util/containers/DArray.h>                // member template
+#include <util/containers/GArray.h>                // member template
+#include <util/space/Vector.h>                     // template argument
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class McSystem;
+   class Atom;
+
+   /**
+   * Cache of the potential energy of every atom in an McSystem.
+   *
+   * An McEnergyCache stores the current potential energy of each atom,
+   * i.e., the sum of all interactions in which it participates, as
+   * returned by McSystem::atomPotentialEnergy(), and the total potential
+   * energy of the system. The pair and non-pair parts of each atomic
+   * energy are stored separately. The cache also keeps the sum of the
+   * energies of the atoms in each cell of the CellList of the McPairPotential,
+   * in which each pair energy is counted once for each atom of the pair.
+   *
+   * Monte Carlo moves that keep the cache up to date obtain the energy
+   * of an atom before a trial move from atomEnergy(), at no cost, and
+   * evaluate the trial configuration with trialEnergy(). If the move is
+   * accepted, acceptMove() updates the energies of the moved atom and
+   * of all atoms that interact with it, reusing the pair energies
+   * computed by trialEnergy(). Rejected moves thus require only one
+   * evaluation of the energy of the moved atom, rather than two.
+   *
+   * Any change of atomic positions that is not reported to the cache
+   * must be followed by a call to unset(). The cache is rebuilt by the
+   * next call to atomEnergy() or compute().
+   *
+   * The cache may not be used with link potentials, which couple atoms
+   * that are not members of a common covalent group.
+   *
+   * \ingroup McMd_System_Module
+   */
+   class McEnergyCache
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system parent McSystem
+      */
+      McEnergyCache(McSystem& system);
+
+      /**
+      * Destructor.
+      */
+      ~McEnergyCache();
+
+      /**
+      * Allocate arrays.
+      *
+      * \param atomCapacity maximum number of atoms in the simulation
+      */
+      void allocate(int atomCapacity);
+
+      /**
+      * Compute energies of all atoms and the total energy.
+      */
+      void compute();
+
+      /**
+      * Mark the cache as invalid.
+      */
+      void unset();
+
+      /**
+      * Return the cached potential energy of an atom.
+      *
+      * Calls compute() first if the cache is not valid.
+      *
+      * \param atom Atom object of interest
+      */
+      double atomEnergy(const Atom& atom);
+
+      /**
+      * Compute the potential energy of an atom at its current position.
+      *
+      * Call this function after assigning a trial position to an atom.
+      * The CellList need not be updated. The pair energies of the atom
+      * with its neighbors are retained for use by acceptMove(), and the
+      * cached energies are not modified.
+      *
+      * \param atom Atom object with a trial position
+      * \return potential energy of atom at its trial position
+      */
+      double trialEnergy(const Atom& atom);
+
+      /**
+      * Update cached energies after acceptance of a trial move.
+      *
+      * Call after trialEnergy() for the same atom, with the atom still
+      * at the trial position. The CellList may or may not already have
+      * been updated.
+      *
+      * \param atom Atom that was moved
+      * \param oldPosition position of the atom before the move
+      */
+      void acceptMove(Atom& atom, const Vector& oldPosition);
+
+      /**
+      * Move one atom, and update the cache and the CellList.
+      *
+      * \param atom Atom to be moved
+      * \param position new position of the atom
+      */
+      void moveAtom(Atom& atom, const Vector& position);
+
+      /**
+      * Update the cache after an accepted move of several atoms.
+      *
+      * On entry, the nAtom atoms with addresses first, first + stride,
+      * first + 2*stride, ... occupy their new positions, which must be
+      * recorded in the CellList, and oldPositions[i] is the previous
+      * position of the atom with address first + i*stride. The atoms
+      * are returned to their old positions, and then moved one at a
+      * time to their new positions with moveAtom().
+      *
+      * \param first pointer to first atom of sequence
+      * \param stride address increment between atoms (usually +1 or -1)
+      * \param nAtom number of atoms in the sequence
+      * \param oldPositions positions of the atoms before the move
+      */
+      void acceptSequence(Atom* first, int stride, int nAtom,
+                          const DArray<Vector>& oldPositions);
+
+      /**
+      * Return the total potential energy of the system.
+      */
+      double totalEnergy() const;
+
+      /**
+      * Return the sum of the cached energies of atoms in one cell.
+      *
+      * \param cellId index of a cell of the pair potential CellList
+      */
+      double cellEnergy(int cellId) const;
+
+      /**
+      * Return the number of cells for which totals are stored.
+      */
+      int nCell() const;
+
+      /**
+      * Is the cache consistent with the current configuration?
+      */
+      bool isValid() const;
+
+   private:
+
+      /// Pair energy of each atom, indexed by atom id.
+      DArray<double> pairEnergies_;
+
+      /// Non-pair energy of each atom, indexed by atom id.
+      DArray<double> nonPairEnergies_;
+
+      /// Sum of atomic energies in each cell, indexed by cell id.
+      DArray<double> cellEnergies_;
+
+      /// Cell containing each atom, indexed by atom id.
+      DArray<int> atomCells_;
+
+      /// Neighbors of the atom of the most recent trial.
+      CellList::NeighborArray trialNeighbors_;
+
+      /// Pair energies with trialNeighbors_.
+      McPairPotential::NeighborEnergyArray trialEnergies_;
+
+      /// Neighbors of the old position in acceptMove().
+      CellList::NeighborArray oldNeighbors_;
+
+      /// Pair energies with oldNeighbors_.
+      McPairPotential::NeighborEnergyArray oldEnergies_;
+
+      /// New positions of atoms in acceptSequence().
+      GArray<Vector> newPositions_;
+
+      /// Total potential energy.
+      double totalEnergy_;
+
+      /// Pair energy of the atom of the most recent trial.
+      double trialPairEnergy_;
+
+      /// Non-pair energy of the atom of the most recent trial.
+      double trialNonPairEnergy_;
+
+      /// Pointer to parent McSystem.
+      McSystem* systemPtr_;
+
+      /// Id of the atom of the most recent trial (-1 if none).
+      int trialAtomId_;
+
+      /// Are the cached energies valid?
+      bool isValid_;
+
+      /*
+      * Recompute the non-pair energy of every atom that shares a
+      * covalent group with an atom.
+      */
+      void updatePartners(const Atom& atom);
+
+      /*
+      * Add an increment to the pair energy of an atom and its cell.
+      */
+      void addPairEnergy(int atomId, double dE);
+
+      /*
+      * Reset the non-pair energy of an atom, and update its cell.
+      */
+      void setNonPairEnergy(int atomId, double energy);
+
+   };
+
+   // Inline functions
+
+   inline double McEnergyCache::totalEnergy() const
+   {
+      assert(isValid_);
+      return totalEnergy_;
+   }
+
+   inline double McEnergyCache::cellEnergy(int cellId) const
+   {
+      assert(isValid_);
+      return cellEnergies_[cellId];
+   }
+
+   inline int McEnergyCache::nCell() const
+   {  return cellEnergies_.capacity(); }
+
+   inline bool McEnergyCache::isValid() const
+   {  return isValid_; }
+
+   inline void McEnergyCache::unset()
+   {
+      isValid_ = false;
+      trialAtomId_ = -1;
+   }
+
+   inline void McEnergyCache::addPairEnergy(int atomId, double dE)
+   {
+      pairEnergies_[atomId] += dE;
+      cellEnergies_[atomCells_[atomId]] += dE;
+   }
+
+   inline void McEnergyCache::setNonPairEnergy(int atomId, double energy)
+   {
+      cellEnergies_[atomCells_[atomId]] += energy - nonPairEnergies_[atomId];
+      nonPairEnergies_[atomId] = energy;
+   }
+
+}
+#endif
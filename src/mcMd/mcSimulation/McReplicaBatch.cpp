@@ -0,0 +1,418 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "McReplicaBatch.h"
+#include "McSimulation.h"
+#include "McSystem.h"
+#include <mcMd/mcMoves/McMoveManager.h>
+#include <mcMd/mcMoves/McMove.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#ifndef SIMP_NOPAIR
+#include <mcMd/potentials/pair/McPairPotential.h>
+#include "McEnergyCache.h"
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
+#endif
+#endif
+#include <simp/species/Species.h>
+#include <simp/ensembles/EnergyEnsemble.h>
+#include <util/random/Random.h>
+#include <util/misc/Timer.h>
+#include <util/misc/Log.h>
+#include <util/misc/ioUtil.h>
+#include <util/global.h>
+
+#ifdef MCMD_OPENMP
+#include <omp.h>
+#endif
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   McReplicaBatch::McReplicaBatch(McSimulation& simulation,
+                                  McMoveManager& moveManager)
+    : replicas_(),
+      temperatures_(),
+      replicaIds_(),
+      swapAttempts_(),
+      swapAccepts_(),
+      simulationPtr_(&simulation),
+      moveManagerPtr_(&moveManager),
+      minTemperature_(1.0),
+      maxTemperature_(1.0),
+      time_(0.0),
+      nReplica_(0),
+      swapInterval_(0),
+      nThread_(0),
+      nStep_(0),
+      parity_(0),
+      isActive_(false),
+      isInitialized_(false)
+   {  setClassName("McReplicaBatch"); }
+
+   /*
+   * Destructor.
+   */
+   McReplicaBatch::~McReplicaBatch()
+   {
+      if (isInitialized_) {
+         for (int i = 0; i < nReplica_; ++i) {
+            delete replicas_[i].moveManagerPtr;
+            delete replicas_[i].systemPtr;
+            delete replicas_[i].randomPtr;
+         }
+      }
+   }
+
+   /*
+   * Read parameters and compute the temperature ladder.
+   */
+   void McReplicaBatch::readParameters(std::istream& in)
+   {
+      read<int>(in, "nReplica", nReplica_);
+      if (nReplica_ < 1) {
+         UTIL_THROW("nReplica must be positive");
+      }
+      read<double>(in, "minTemperature", minTemperature_);
+      read<double>(in, "maxTemperature", maxTemperature_);
+      if (minTemperature_ <= 0.0 || maxTemperature_ < minTemperature_) {
+         UTIL_THROW("Invalid temperature range");
+      }
+      read<int>(in, "swapInterval", swapInterval_);
+      if (swapInterval_ < 1) {
+         UTIL_THROW("swapInterval must be positive");
+      }
+      nThread_ = 0; // default
+      readOptional<int>(in, "nThread", nThread_);
+
+      // Geometric ladder of temperatures
+      temperatures_.allocate(nReplica_);
+      temperatures_[0] = minTemperature_;
+      if (nReplica_ > 1) {
+         double ratio = maxTemperature_/minTemperature_;
+         double exponent;
+         for (int k = 1; k < nReplica_; ++k) {
+            exponent = double(k)/double(nReplica_ - 1);
+            temperatures_[k] = minTemperature_*std::pow(ratio, exponent);
+         }
+      }
+
+      replicaIds_.allocate(nReplica_);
+      swapAttempts_.allocate(nReplica_);
+      swapAccepts_.allocate(nReplica_);
+      for (int k = 0; k < nReplica_; ++k) {
+         replicaIds_[k] = k;
+         swapAttempts_[k] = 0;
+         swapAccepts_[k] = 0;
+      }
+      isActive_ = true;
+   }
+
+   /*
+   * Create all replicas, using parameters of the main system.
+   *
+   * The parameter blocks of the main McSystem and McMoveManager are
+   * written to strings, and read by every replica, so that replicas
+   * use exactly the same potentials, ensembles and moves.
+   */
+   void McReplicaBatch::initialize()
+   {
+      UTIL_CHECK(isActive_);
+      UTIL_CHECK(!isInitialized_);
+
+      McSimulation& simulation = *simulationPtr_;
+      McSystem& main = simulation.system();
+      #ifdef MCMD_PERTURB
+      if (main.hasPerturbation()) {
+         UTIL_THROW("McReplicaBatch cannot be used with a perturbation");
+      }
+      #endif
+      if (!main.energyEnsemble().isIsothermal()) {
+         UTIL_THROW("McReplicaBatch requires an isothermal ensemble");
+      }
+
+      // Check that reservoirs can hold molecules for all replicas
+      int nSpecies = simulation.nSpecies();
+      int iSpecies, nMolecule;
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         nMolecule = main.nMolecule(iSpecies);
+         if ((nReplica_ + 1)*nMolecule
+             > simulation.species(iSpecies).capacity()) {
+            Log::file() << "Species " << iSpecies
+                        << " needs capacity >= "
+                        << (nReplica_ + 1)*nMolecule << std::endl;
+            UTIL_THROW("Species capacity too small for replicas");
+         }
+      }
+
+      // Write parameters of main system and moves
+      std::stringstream systemParam;
+      std::stringstream moveParam;
+      main.writeParam(systemParam);
+      moveManagerPtr_->writeParam(moveParam);
+
+      replicas_.allocate(nReplica_);
+      int i, j, k;
+      for (i = 0; i < nReplica_; ++i) {
+         Replica& replica = replicas_[i];
+
+         replica.randomPtr = new Random();
+         replica.randomPtr->setSeed(simulation.random().uniformInt(1,
+                                                           1000000000));
+
+         replica.systemPtr = new McSystem();
+         McSystem& system = *replica.systemPtr;
+         system.setId(i + 1);
+         system.setSimulation(simulation);
+         system.setFileMaster(simulation.fileMaster());
+         system.setRandom(*replica.randomPtr);
+         systemParam.clear();
+         systemParam.seekg(0);
+         system.readParam(systemParam);
+
+         replica.moveManagerPtr = new McMoveManager(simulation, system);
+         moveParam.clear();
+         moveParam.seekg(0);
+         replica.moveManagerPtr->readParam(moveParam);
+
+         // Copy boundary and configuration of main system
+         system.boundary() = main.boundary();
+         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+            nMolecule = main.nMolecule(iSpecies);
+            for (j = 0; j < nMolecule; ++j) {
+               Molecule& source = main.molecule(iSpecies, j);
+               Molecule& molecule = simulation.getMolecule(iSpecies);
+               for (k = 0; k < source.nAtom(); ++k) {
+                  molecule.atom(k).position() = source.atom(k).position();
+               }
+               system.addMolecule(molecule);
+            }
+         }
+         #ifndef SIMP_NOPAIR
+         system.pairPotential().buildCellList();
+         #endif
+         #ifdef SIMP_COULOMB
+         if (system.hasCoulombPotential()) {
+            McMoveManager& moveManager = *replica.moveManagerPtr;
+            for (j = 0; j < moveManager.size(); ++j) {
+               if (!moveManager[j].includesCoulomb()) {
+                  UTIL_THROW("McMove does not include Coulomb energy");
+               }
+            }
+            system.coulombPotential().unsetWaves();
+            system.coulombPotential().computeKSpaceCharge();
+         }
+         #endif
+
+         system.energyEnsemble().setTemperature(temperatures_[i]);
+         replica.energy = 0.0;
+      }
+
+      isInitialized_ = true;
+   }
+
+   /*
+   * Advance one replica, and compute its final potential energy.
+   */
+   void McReplicaBatch::advance(Replica& replica, int nStep)
+   {
+      McSystem& system = *replica.systemPtr;
+      McMoveManager& moveManager = *replica.moveManagerPtr;
+      for (int iStep = 0; iStep < nStep; ++iStep) {
+         McMove& move = moveManager.chooseMove();
+         move.move();
+         #ifndef SIMP_NOPAIR
+         if (system.hasEnergyCache() && !move.keepsEnergyCache()) {
+            system.energyCache().unset();
+         }
+         #endif
+      }
+      system.positionSignal().notify();
+      replica.energy = system.potentialEnergy();
+   }
+
+   /*
+   * Attempt swaps between temperature indices k and k+1, for all k of
+   * the current parity, using energies from the most recent round.
+   */
+   void McReplicaBatch::attemptSwaps()
+   {
+      Random& random = simulationPtr_->random();
+      int i, j, k;
+      double dBeta, dEnergy;
+      for (k = parity_; k + 1 < nReplica_; k += 2) {
+         i = replicaIds_[k];
+         j = replicaIds_[k + 1];
+         dBeta = 1.0/temperatures_[k] - 1.0/temperatures_[k + 1];
+         dEnergy = replicas_[i].energy - replicas_[j].energy;
+         ++swapAttempts_[k];
+         if (random.metropolis(std::exp(dBeta*dEnergy))) {
+            ++swapAccepts_[k];
+            replicaIds_[k] = j;
+            replicaIds_[k + 1] = i;
+            replicas_[j].systemPtr->energyEnsemble()
+                                   .setTemperature(temperatures_[k]);
+            replicas_[i].systemPtr->energyEnsemble()
+                                   .setTemperature(temperatures_[k + 1]);
+         }
+      }
+      parity_ = 1 - parity_;
+   }
+
+   /*
+   * Run a batched simulation.
+   */
+   void McReplicaBatch::simulate(int endStep)
+   {
+      if (!isActive_) {
+         UTIL_THROW("No McReplicaBatch block in parameter file");
+      }
+      if (!isInitialized_) {
+         initialize();
+      }
+      for (int k = 0; k < nReplica_; ++k) {
+         swapAttempts_[k] = 0;
+         swapAccepts_[k] = 0;
+      }
+
+      #ifdef MCMD_OPENMP
+      int nThread = nThread_ > 0 ? nThread_ : omp_get_max_threads();
+      Log::file() << "Replicas advanced by " << nThread
+                  << " threads" << std::endl;
+      #endif
+
+      Timer timer;
+      timer.start();
+      int iStep = 0;
+      int nStep, i;
+      int errorId;
+      while (iStep < endStep) {
+         nStep = swapInterval_;
+         if (nStep > endStep - iStep) {
+            nStep = endStep - iStep;
+         }
+
+         // Advance all replicas. Exceptions may not leave a parallel
+         // region, and so are recorded and re-thrown after it.
+         errorId = -1;
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(dynamic, 1) num_threads(nThread)
+         #endif
+         for (i = 0; i < nReplica_; ++i) {
+            try {
+               advance(replicas_[i], nStep);
+            } catch (...) {
+               #ifdef MCMD_OPENMP
+               #pragma omp critical
+               #endif
+               errorId = i;
+            }
+         }
+         if (errorId >= 0) {
+            Log::file() << "Error in replica " << errorId << std::endl;
+            UTIL_THROW("Exception while advancing replica");
+         }
+         iStep += nStep;
+
+         attemptSwaps();
+      }
+      timer.stop();
+      time_ = timer.time();
+      nStep_ = endStep;
+
+      outputStatistics(Log::file());
+   }
+
+   /*
+   * Write configuration of the replica at each temperature.
+   */
+   void McReplicaBatch::writeConfigs(const std::string& baseName)
+   {
+      UTIL_CHECK(isInitialized_);
+      for (int k = 0; k < nReplica_; ++k) {
+         system(k).writeConfig(baseName + toString(k));
+      }
+   }
+
+   /*
+   * Output statistics of the most recent run.
+   */
+   void McReplicaBatch::outputStatistics(std::ostream& out) const
+   {
+      UTIL_CHECK(isInitialized_);
+      using namespace std;
+      out << endl;
+      out << "nReplica          " << nReplica_ << endl;
+      out << "nStep / replica   " << nStep_ << endl;
+      out << "run time          " << time_ << " sec" << endl;
+      if (nStep_ > 0) {
+         out << "time / step       "
+             << time_/(double(nStep_)*double(nReplica_)) << " sec" << endl;
+      }
+      out << endl;
+
+      out << "Replica Statistics:" << endl << endl;
+      out << setw(6) << right << "k"
+          << setw(15) << right << "Temperature"
+          << setw(9) << right << "Replica"
+          << setw(18) << right << "Energy"
+          << setw(15) << right << "SwapRate" << endl;
+      int i;
+      long attempt, accept;
+      for (int k = 0; k < nReplica_; ++k) {
+         i = replicaIds_[k];
+         out << setw(6) << right << k
+             << setw(15) << fixed << setprecision(6) << temperatures_[k]
+             << setw(9) << i
+             << setw(18) << setprecision(6) << replicas_[i].energy;
+         if (k + 1 < nReplica_) {
+            attempt = swapAttempts_[k];
+            accept = swapAccepts_[k];
+            out << setw(15) << setprecision(6)
+                << (attempt == 0 ? 0.0 : double(accept)/double(attempt));
+         }
+         out << endl;
+      }
+      out << endl;
+
+      // McMove acceptance statistics, summed over replicas
+      out << "Move Statistics (all replicas):" << endl << endl;
+      out << setw(32) << left <<  "Move Name"
+          << setw(12) << right << "Attempted"
+          << setw(12) << right << "Accepted"
+          << setw(15) << right << "AcceptRate" << endl;
+      McMoveManager& first = *replicas_[0].moveManagerPtr;
+      int nMove = first.size();
+      for (int iMove = 0; iMove < nMove; ++iMove) {
+         attempt = 0;
+         accept = 0;
+         for (i = 0; i < nReplica_; ++i) {
+            attempt += (*replicas_[i].moveManagerPtr)[iMove].nAttempt();
+            accept  += (*replicas_[i].moveManagerPtr)[iMove].nAccept();
+         }
+         out << setw(32) << left << first.className(iMove)
+             << setw(12) << right << attempt
+             << setw(12) << accept
+             << setw(15) << fixed << setprecision(6)
+             << (attempt == 0 ? 0.0 : double(accept)/double(attempt))
+             << endl;
+      }
+      out << endl;
+   }
+
+}
@@ -0,0 +1,235 @@
+#ifndef MCMD_MC_REPLICA_BATCH_H
+#define MCMD_MC_REPLICA_BATCH_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>   // base class
+#include <util/containers/DArray.h>      // member template
+#include <util/global.h>
+
+#include <string>
+
+namespace Util { class Random; }
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class McSimulation;
+   class McSystem;
+   class McMoveManager;
+
+   /**
+   * A batch of McSystem replicas, simulated in one process.
+   *
+   * An McReplicaBatch performs a parallel tempering (temperature replica
+   * exchange) simulation of many small replicas of the main McSystem of
+   * an McSimulation, within a single process. Each replica is a separate
+   * McSystem, with its own McMoveManager and random number generator,
+   * created with the same parameters as the main system and move manager
+   * and initialized with a copy of the current configuration of the main
+   * system. Replicas are assigned temperatures from a geometric ladder.
+   *
+   * The simulation proceeds in rounds. In each round, every replica is
+   * advanced by swapInterval MC steps, and swaps of temperature between
+   * replicas at neighboring temperatures are then attempted, alternating
+   * between even and odd pairs of temperatures in successive rounds.
+   * Swaps exchange temperatures, not configurations, and so require no
+   * copying of atomic coordinates.
+   *
+   * If compiled with MCMD_OPENMP defined, replicas are advanced by a pool
+   * of OpenMP threads within each round. Replicas are handed out one at
+   * a time to whichever thread is idle, so that threads that finish
+   * cheap replicas take on the remaining ones. Otherwise, replicas are
+   * advanced sequentially.
+   *
+   * Molecules of all replicas are taken from the reservoirs of the
+   * parent Simulation, so the capacity of each species must be at least
+   * nReplica + 1 times the number of molecules in the main system. Moves
+   * that change the number of molecules or use the Simulation random
+   * number generator directly may not be used with a batch.
+   *
+   * \sa \ref mcMd_mcSimulation_McReplicaBatch_page "parameter file format"
+   *
+   * \ingroup McMd_Simulation_Module
+   */
+   class McReplicaBatch : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent McSimulation
+      * \param moveManager McMoveManager of main system of simulation
+      */
+      McReplicaBatch(McSimulation& simulation, McMoveManager& moveManager);
+
+      /**
+      * Destructor.
+      */
+      virtual ~McReplicaBatch();
+
+      /**
+      * Read parameters from file.
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Run a batched simulation of all replicas.
+      *
+      * Replicas are created upon the first call, by copying the current
+      * configuration of the main system. Subsequent calls continue from
+      * the current configurations and temperatures of the replicas.
+      *
+      * \param endStep number of MC steps per replica
+      */
+      void simulate(int endStep);
+
+      /**
+      * Write the configuration of the replica at each temperature.
+      *
+      * The configuration of the replica at temperature index k is written
+      * to a file named baseName + k.
+      *
+      * \param baseName base name for configuration files
+      */
+      void writeConfigs(const std::string& baseName);
+
+      /**
+      * Output temperatures, energies and acceptance statistics.
+      *
+      * \param out output stream
+      */
+      void outputStatistics(std::ostream& out) const;
+
+      /**
+      * Get the number of replicas.
+      */
+      int nReplica() const;
+
+      /**
+      * Get the temperature with index k.
+      *
+      * \param k temperature index, 0 <= k < nReplica()
+      */
+      double temperature(int k) const;
+
+      /**
+      * Get the replica that is currently at temperature index k.
+      *
+      * \param k temperature index, 0 <= k < nReplica()
+      */
+      McSystem& system(int k);
+
+      /**
+      * Was a parameter block read for this batch?
+      */
+      bool isActive() const;
+
+   private:
+
+      /**
+      * One replica, with its own system, moves and random numbers.
+      */
+      struct Replica
+      {
+         McSystem* systemPtr;
+         McMoveManager* moveManagerPtr;
+         Random* randomPtr;
+         double energy;
+      };
+
+      /// Array of replicas, indexed by replica id.
+      DArray<Replica> replicas_;
+
+      /// Temperatures, in increasing order.
+      DArray<double> temperatures_;
+
+      /// Replica id at each temperature index.
+      DArray<int> replicaIds_;
+
+      /// Number of attempted swaps between indices k and k + 1.
+      DArray<long> swapAttempts_;
+
+      /// Number of accepted swaps between indices k and k + 1.
+      DArray<long> swapAccepts_;
+
+      /// Pointer to parent McSimulation.
+      McSimulation* simulationPtr_;
+
+      /// Pointer to McMoveManager of main system.
+      McMoveManager* moveManagerPtr_;
+
+      /// Lowest temperature.
+      double minTemperature_;
+
+      /// Highest temperature.
+      double maxTemperature_;
+
+      /// Wall clock time of most recent run (sec).
+      double time_;
+
+      /// Number of replicas.
+      int nReplica_;
+
+      /// Number of MC steps per replica between swap attempts.
+      int swapInterval_;
+
+      /// Maximum number of threads (0 for the OpenMP default).
+      int nThread_;
+
+      /// Number of steps per replica in most recent run.
+      int nStep_;
+
+      /// Parity of the next set of swap attempts (0 or 1).
+      int parity_;
+
+      /// Was a parameter block read?
+      bool isActive_;
+
+      /// Have the replicas been created?
+      bool isInitialized_;
+
+      /*
+      * Create replicas and copy configuration of main system.
+      */
+      void initialize();
+
+      /*
+      * Advance one replica by nStep MC steps, and compute its energy.
+      */
+      void advance(Replica& replica, int nStep);
+
+      /*
+      * Attempt swaps of temperature for one set of neighboring pairs.
+      */
+      void attemptSwaps();
+
+   };
+
+   // Inline functions
+
+   inline int McReplicaBatch::nReplica() const
+   {  return nReplica_; }
+
+   inline double McReplicaBatch::temperature(int k) const
+   {  return temperatures_[k]; }
+
+   inline McSystem& McReplicaBatch::system(int k)
+   {  return *replicas_[replicaIds_[k]].systemPtr; }
+
+   inline bool McReplicaBatch::isActive() const
+   {  return isActive_; }
+
+}
+#endif
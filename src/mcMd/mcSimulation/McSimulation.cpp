@@ -14,8 +14,10 @@
 #include <mcMd/trajectory/TrajectoryReader.h>
 #include <mcMd/generators/Generator.h>
 #include <mcMd/generators/generatorFactory.h>
+#include <mcMd/mcMoves/McMove.h>
 #ifndef SIMP_NOPAIR
 #include <mcMd/potentials/pair/McPairPotential.h>
+#include "McEnergyCache.h"
 #endif
 #ifdef SIMP_BOND
 #include <mcMd/potentials/bond/BondPotential.h>
@@ -26,6 +28,9 @@
 #ifdef SIMP_DIHEDRAL
 #include <mcMd/potentials/dihedral/DihedralPotential.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
+#endif
 #ifdef UTIL_MPI
 #ifdef MCMD_PERTURB
 #include <mcMd/perturb/ReplicaMove.h>
@@ -65,6 +70,7 @@ namespace McMd
       mcMoveManager_(*this),
       mcAnalyzerManager_(*this),
       mcCommandManager_(*this),
+      replicaBatch_(*this, mcMoveManager_),
       paramFilePtr_(0),
       saveFileName_(),
       saveInterval_(0),
@@ -93,6 +99,7 @@ namespace McMd
       mcMoveManager_(*this),
       mcAnalyzerManager_(*this),
       mcCommandManager_(*this),
+      replicaBatch_(*this, mcMoveManager_),
       paramFilePtr_(0),
       saveFileName_(),
       saveInterval_(0),
@@ -279,6 +286,9 @@ namespace McMd
       readParamCompositeOptional(in, analyzerManager());
       readParamCompositeOptional(in, commandManager());
 
+      // Read batch of replicas (optionally)
+      readParamCompositeOptional(in, replicaBatch_);
+
       // Parameters for writing restart files (optionally)
       saveInterval_ = 0; // default value
       readOptional<int>(in, "saveInterval", saveInterval_);
@@ -514,6 +524,23 @@ namespace McMd
       int nStep = endStep - beginStep;
       Log::file() << std::endl;
       system().positionSignal().notify();
+      #ifndef SIMP_NOPAIR
+      if (system().hasEnergyCache()) {
+         system().energyCache().unset();
+      }
+      #endif
+      #ifdef SIMP_COULOMB
+      // Every move must maintain the Fourier charge density.
+      if (system().hasCoulombPotential()) {
+         for (int iMove = 0; iMove < mcMoveManager().size(); ++iMove) {
+            if (!mcMoveManager()[iMove].includesCoulomb()) {
+               UTIL_THROW("McMove does not include Coulomb energy");
+            }
+         }
+         system().coulombPotential().unsetWaves();
+         system().coulombPotential().computeKSpaceCharge();
+      }
+      #endif
 
       // Main Monte Carlo loop
       Timer timer;
@@ -539,7 +566,13 @@ namespace McMd
          }
 
          // Choose and attempt an McMove
-         mcMoveManager().chooseMove().move();
+         McMove& move = mcMoveManager().chooseMove();
+         move.move();
+         #ifndef SIMP_NOPAIR
+         if (system().hasEnergyCache() && !move.keepsEnergyCache()) {
+            system().energyCache().unset();
+         }
+         #endif
 
          #ifdef UTIL_MPI
          #ifdef MCMD_PERTURB
@@ -552,6 +585,15 @@ namespace McMd
                   #ifndef SIMP_NOPAIR
                   if (success) {
                      system().pairPotential().buildCellList();
+                     if (system().hasEnergyCache()) {
+                        system().energyCache().unset();
+                     }
+                  }
+                  #endif
+                  #ifdef SIMP_COULOMB
+                  if (success && system().hasCoulombPotential()) {
+                     system().coulombPotential().unsetWaves();
+                     system().coulombPotential().computeKSpaceCharge();
                   }
                   #endif
                }
@@ -564,6 +606,13 @@ namespace McMd
       timer.stop();
       double time = timer.time();
 
+      #ifndef SIMP_NOPAIR
+      // Configuration may be modified by commands between runs
+      if (system().hasEnergyCache()) {
+         system().energyCache().unset();
+      }
+      #endif
+
       // Final analyzers
       assert(iStep_ == endStep);
       if (Analyzer::baseInterval > 0) {
@@ -750,7 +799,13 @@ namespace McMd
       Log::file() << "Begin main loop" << std::endl;
       bool hasFrame = true;
       timer.start();
-      for (iStep_ = 0; iStep_ <= max && hasFrame; ++iStep_) {
+      iStep_ = 0;
+      if (min > 0) {
+         // Skip frames before min (seeks, if supported by the reader)
+         hasFrame = trajectoryReaderPtr->skipFrames(min);
+         iStep_ = min;
+      }
+      for ( ; iStep_ <= max && hasFrame; ++iStep_) {
          hasFrame = trajectoryReaderPtr->readFrame();
          if (hasFrame) {
             #ifndef SIMP_NOPAIR
@@ -13,6 +13,7 @@
 #include <mcMd/mcSimulation/McAnalyzerManager.h>  // member
 #include <mcMd/mcSimulation/McCommandManager.h>   // member
 #include <mcMd/mcMoves/McMoveManager.h>           // member
+#include <mcMd/mcSimulation/McReplicaBatch.h>     // member
 #include <util/global.h>
 
 namespace Util { template <typename T> class Factory; }
@@ -294,6 +295,14 @@ namespace McMd
       */
       Factory<McMove>& mcMoveFactory();
 
+      /**
+      * Get the batch of replicas by reference.
+      *
+      * The batch is active only if the parameter file contains an
+      * optional McReplicaBatch block.
+      */
+      McReplicaBatch& replicaBatch();
+
       /**
       * Return true if valid, or throw an Exception. 
       */
@@ -322,6 +331,9 @@ namespace McMd
       /// Manager for Command objects.
       McCommandManager mcCommandManager_;
 
+      /// Batch of replicas simulated within this process.
+      McReplicaBatch replicaBatch_;
+
       /// Pointer to parameter file passed to readParameters(istream&)
       std::istream* paramFilePtr_;
 
@@ -353,6 +365,12 @@ namespace McMd
    inline const McSystem& McSimulation::system() const
    {  return system_; }
 
+   /* 
+   * Get the McReplicaBatch by reference.
+   */
+   inline McReplicaBatch& McSimulation::replicaBatch()
+   {  return replicaBatch_; }
+
    /* 
    * Get the McMoveManager (protected).
    */
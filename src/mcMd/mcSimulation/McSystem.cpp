@@ -13,6 +13,7 @@
 #ifndef SIMP_NOPAIR
 #include <mcMd/potentials/pair/McPairPotential.h>
 #include <mcMd/potentials/pair/PairFactory.h>
+#include "McEnergyCache.h"
 #endif
 #ifdef SIMP_BOND
 #include <mcMd/potentials/bond/BondPotential.h>
@@ -23,6 +24,10 @@
 #ifdef SIMP_DIHEDRAL
 #include <mcMd/potentials/dihedral/DihedralPotential.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
+#include <mcMd/potentials/coulomb/CoulombFactory.h>
+#endif
 #ifdef SIMP_EXTERNAL
 #include <mcMd/potentials/external/ExternalPotential.h>
 #endif
@@ -66,6 +71,7 @@ namespace McMd
       System()
       #ifndef SIMP_NOPAIR
       , pairPotentialPtr_(0)
+      , energyCachePtr_(0)
       #endif
       #ifdef SIMP_BOND
       , bondPotentialPtr_(0)
@@ -76,6 +82,9 @@ namespace McMd
       #ifdef SIMP_DIHEDRAL
       , dihedralPotentialPtr_(0)
       #endif
+      #ifdef SIMP_COULOMB
+      , coulombPotentialPtr_(0)
+      #endif
       #ifdef SIMP_EXTERNAL
       , externalPotentialPtr_(0)
       #endif
@@ -101,6 +110,7 @@ namespace McMd
    {
       #ifndef SIMP_NOPAIR
       if (pairPotentialPtr_) delete pairPotentialPtr_;
+      if (energyCachePtr_) delete energyCachePtr_;
       #endif
       #ifdef SIMP_BOND
       if (bondPotentialPtr_) delete bondPotentialPtr_;
@@ -114,6 +124,9 @@ namespace McMd
       #ifdef SIMP_EXTERNAL
       if (externalPotentialPtr_) delete externalPotentialPtr_;
       #endif
+      #ifdef SIMP_COULOMB
+      if (coulombPotentialPtr_) delete coulombPotentialPtr_;
+      #endif
       #ifdef MCMD_LINK
       if (linkPotentialPtr_) delete linkPotentialPtr_;
       #endif
@@ -134,6 +147,18 @@ namespace McMd
       readFileMaster(in);
       readPotentialStyles(in);
 
+      #ifdef SIMP_COULOMB
+      assert(coulombPotentialPtr_ == 0);
+      if (simulation().hasCoulomb()) {
+         coulombPotentialPtr_ = 
+                   coulombFactory().mcFactory(coulombStyle(), *this);
+         if (coulombPotentialPtr_ == 0) {
+            UTIL_THROW("Failed attempt to create CoulombPotential");
+         }
+         readParamComposite(in, *coulombPotentialPtr_);
+      }
+      #endif
+
       #ifndef SIMP_NOPAIR
       assert(pairPotentialPtr_ == 0);
       pairPotentialPtr_ = pairFactory().mcFactory(pairStyle(), *this);
@@ -141,6 +166,12 @@ namespace McMd
          UTIL_THROW("Failed attempt to create McPairPotential");
       }
       readParamComposite(in, *pairPotentialPtr_);
+      #ifdef SIMP_COULOMB
+      if (coulombPotentialPtr_) {
+         pairPotentialPtr_->
+                   setMinCellCutoff(coulombPotentialPtr_->rSpaceCutoff());
+      }
+      #endif
       #endif
 
       #ifdef SIMP_BOND
@@ -214,6 +245,14 @@ namespace McMd
       // Read EnergyEnsemble and BoundaryEnsemble
       readEnsembles(in);
 
+      #ifndef SIMP_NOPAIR
+      bool hasEnergyCache = false;
+      readOptional<bool>(in, "energyCache", hasEnergyCache);
+      if (hasEnergyCache) {
+         createEnergyCache();
+      }
+      #endif
+
       #ifdef MCMD_PERTURB
       readPerturbation(in);
       #ifdef UTIL_MPI
@@ -231,12 +270,30 @@ namespace McMd
       loadFileMaster(ar);
       loadPotentialStyles(ar);
 
+      #ifdef SIMP_COULOMB
+      assert(coulombPotentialPtr_ == 0);
+      if (simulation().hasCoulomb()) {
+         coulombPotentialPtr_ = 
+                   coulombFactory().mcFactory(coulombStyle(), *this);
+         if (coulombPotentialPtr_ == 0) {
+            UTIL_THROW("Failed attempt to create CoulombPotential");
+         }
+         loadParamComposite(ar, *coulombPotentialPtr_);
+      }
+      #endif
+
       #ifndef SIMP_NOPAIR
       pairPotentialPtr_ = pairFactory().mcFactory(pairStyle(), *this);
       if (pairPotentialPtr_ == 0) {
          UTIL_THROW("Failed attempt to create McPairPotential");
       }
       loadParamComposite(ar, *pairPotentialPtr_);
+      #ifdef SIMP_COULOMB
+      if (coulombPotentialPtr_) {
+         pairPotentialPtr_->
+                   setMinCellCutoff(coulombPotentialPtr_->rSpaceCutoff());
+      }
+      #endif
       #endif
 
       #ifdef SIMP_BOND
@@ -309,6 +366,14 @@ namespace McMd
 
       loadEnsembles(ar);
 
+      #ifndef SIMP_NOPAIR
+      bool hasEnergyCache = false;
+      loadParameter<bool>(ar, "energyCache", hasEnergyCache, false);
+      if (hasEnergyCache) {
+         createEnergyCache();
+      }
+      #endif
+
       #ifdef MCMD_PERTURB
       loadPerturbation(ar);
       #ifdef UTIL_MPI
@@ -325,6 +390,12 @@ namespace McMd
    {
       saveFileMaster(ar);
       savePotentialStyles(ar);
+      #ifdef SIMP_COULOMB
+      if (simulation().hasCoulomb()) {
+         assert(coulombPotentialPtr_);
+         coulombPotentialPtr_->save(ar); 
+      }
+      #endif
       #ifndef SIMP_NOPAIR 
       pairPotential().save(ar); 
       #endif
@@ -367,6 +438,11 @@ namespace McMd
 
       saveEnsembles(ar);
 
+      #ifndef SIMP_NOPAIR
+      bool hasEnergyCache = bool(energyCachePtr_);
+      Parameter::saveOptional(ar, hasEnergyCache, hasEnergyCache);
+      #endif
+
       #ifdef MCMD_PERTURB
       savePerturbation(ar);
       #ifdef UTIL_MPI
@@ -386,6 +462,10 @@ namespace McMd
       System::readConfig(in);
       #ifndef SIMP_NOPAIR
       pairPotential().buildCellList();
+      if (energyCachePtr_) energyCachePtr_->unset();
+      #endif
+      #ifdef SIMP_COULOMB
+      if (coulombPotentialPtr_) coulombPotentialPtr_->unsetWaves();
       #endif
    }
 
@@ -397,6 +477,10 @@ namespace McMd
       System::loadConfig(ar); 
       #ifndef SIMP_NOPAIR
       pairPotential().buildCellList();
+      if (energyCachePtr_) energyCachePtr_->unset();
+      #endif
+      #ifdef SIMP_COULOMB
+      if (coulombPotentialPtr_) coulombPotentialPtr_->unsetWaves();
       #endif
    }
 
@@ -434,6 +518,10 @@ namespace McMd
 
       #ifndef SIMP_NOPAIR
       pairPotential().buildCellList();
+      if (energyCachePtr_) energyCachePtr_->unset();
+      #endif
+      #ifdef SIMP_COULOMB
+      if (coulombPotentialPtr_) coulombPotentialPtr_->unsetWaves();
       #endif
 
       #ifdef UTIL_DEBUG
@@ -441,6 +529,28 @@ namespace McMd
       #endif
    }
 
+   #ifndef SIMP_NOPAIR
+   /*
+   * Create and allocate the energy cache.
+   */
+   void McSystem::createEnergyCache()
+   {
+      #ifdef MCMD_LINK
+      if (hasLinkPotential()) {
+         UTIL_THROW("An energy cache cannot be used with links");
+      }
+      #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulombPotential()) {
+         UTIL_THROW("An energy cache cannot be used with Coulomb potentials");
+      }
+      #endif
+      assert(energyCachePtr_ == 0);
+      energyCachePtr_ = new McEnergyCache(*this);
+      energyCachePtr_->allocate(simulation().atomCapacity());
+   }
+   #endif
+
    // -------------------------------------------------------------
    // Energy Evaluators (including all components)
 
@@ -449,10 +559,24 @@ namespace McMd
    */
    double McSystem::atomPotentialEnergy(const Atom &atom) const
    {
-      double energy = 0.0;
+      double energy = atomNonPairEnergy(atom);
       #ifndef SIMP_NOPAIR
       energy += pairPotential().atomEnergy(atom);
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulombPotential()) {
+         energy += coulombPotential().rSpaceAtomEnergy(atom);
+      }
+      #endif
+      return energy;
+   }
+
+   /*
+   * Return potential energy for one Atom, excluding pair interactions.
+   */
+   double McSystem::atomNonPairEnergy(const Atom &atom) const
+   {
+      double energy = 0.0;
       #ifdef SIMP_BOND
       if (hasBondPotential()) {
          energy += bondPotential().atomEnergy(atom);
@@ -493,6 +617,14 @@ namespace McMd
    */
    double McSystem::potentialEnergy() const
    {
+      #ifndef SIMP_NOPAIR
+      if (energyCachePtr_) {
+         if (energyCachePtr_->isValid()) {
+            return energyCachePtr_->totalEnergy();
+         }
+      }
+      #endif
+
       double energy = 0.0;
       #ifndef SIMP_NOPAIR
       energy += pairPotential().energy();
@@ -512,6 +644,11 @@ namespace McMd
          energy += dihedralPotential().energy();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulombPotential()) {
+         energy += coulombPotential().energy();
+      }
+      #endif
       #ifdef SIMP_EXTERNAL
       if (hasExternalPotential()) {
          energy += externalPotential().energy();
@@ -553,6 +690,11 @@ namespace McMd
           dihedralPotential().unsetEnergy();
       }
       #endif
+      #ifdef SIMP_COULOMB
+      if (hasCoulombPotential()) {
+          coulombPotential().unsetEnergy();
+      }
+      #endif
       #ifdef SIMP_EXTERNAL
       if (hasExternalPotential()) {
           externalPotential().unsetEnergy();
@@ -21,6 +21,7 @@ namespace McMd
    class Atom;
    #ifndef SIMP_NOPAIR
    class McPairPotential;
+   class McEnergyCache;
    #endif
    #ifdef SIMP_BOND
    class BondPotential;
@@ -32,7 +33,7 @@ namespace McMd
    class DihedralPotential;
    #endif
    #ifdef SIMP_COULOMB
-   class CoulombPotential;
+   class McCoulombPotential;
    #endif
    #ifdef SIMP_EXTERNAL
    class ExternalPotential;
@@ -138,13 +139,29 @@ namespace McMd
       /**
       * Calculate the total potential energy for one Atom.
       *
+      * If a Coulomb potential exists, this includes the short-range
+      * r-space Coulomb energy of the atom, but not the k-space energy,
+      * which must be obtained from McCoulombPotential::trialEnergy().
+      *
       * \param  atom Atom object of interest
       * \return potential energy of atom
       */
       double atomPotentialEnergy(const Atom& atom) const;
 
+      /**
+      * Calculate the potential energy for one Atom, excluding pair
+      * interactions.
+      *
+      * \param  atom Atom object of interest
+      * \return bonded, external and tether energy of atom
+      */
+      double atomNonPairEnergy(const Atom& atom) const;
+
       /**
       * Return total potential energy of this System.
+      *
+      * If this system has a valid energy cache, the cached total is
+      * returned. Otherwise, the energy is obtained from the potentials.
       */
       double potentialEnergy() const;
 
@@ -243,9 +260,9 @@ namespace McMd
       bool hasCoulombPotential() const;
 
       /**
-      * Return CoulombPotential by reference.
+      * Return McCoulombPotential by reference.
       */
-      CoulombPotential& coulombPotential() const;
+      McCoulombPotential& coulombPotential() const;
       #endif
 
       #ifdef SIMP_EXTERNAL
@@ -279,6 +296,18 @@ namespace McMd
       TetherPotential& tetherPotential() const;
       #endif
 
+      #ifndef SIMP_NOPAIR
+      /**
+      * Does this system keep a cache of atomic energies?
+      */
+      bool hasEnergyCache() const;
+
+      /**
+      * Return the energy cache by reference.
+      */
+      McEnergyCache& energyCache() const;
+      #endif
+
       //@}
       /// \name Miscellaneous
       //@{
@@ -320,6 +349,9 @@ namespace McMd
       mutable CellList::NeighborArray neighbors_;
 
       McPairPotential* pairPotentialPtr_;
+
+      /// Pointer to energy cache (null if none).
+      McEnergyCache* energyCachePtr_;
       #endif
 
       #ifdef SIMP_BOND
@@ -337,8 +369,8 @@ namespace McMd
       #endif
 
       #ifdef SIMP_COULOMB
-      /// Pointer to a CoulombPotential. 
-      CoulombPotential* coulombPotentialPtr_;
+      /// Pointer to an McCoulombPotential (null if none).
+      McCoulombPotential* coulombPotentialPtr_;
       #endif
 
       #ifdef SIMP_EXTERNAL
@@ -372,6 +404,13 @@ namespace McMd
       template <typename T>
       void computeVirialStressImpl(T& stress) const;
 
+      #ifndef SIMP_NOPAIR
+      /*
+      * Create and allocate the energy cache.
+      */
+      void createEnergyCache();
+      #endif
+
       #ifdef MCMD_LINK
       template <typename T>
       void computeLinkStressImpl(T& stress) const;
@@ -392,6 +431,23 @@ namespace McMd
    }
    #endif
 
+   #ifndef SIMP_NOPAIR
+   /*
+   * Does this system keep a cache of atomic energies?
+   */
+   inline bool McSystem::hasEnergyCache() const
+   {  return bool(energyCachePtr_); }
+
+   /*
+   * Return the energy cache by reference.
+   */
+   inline McEnergyCache& McSystem::energyCache() const
+   {  
+      assert(energyCachePtr_);
+      return *energyCachePtr_; 
+   }
+   #endif
+
    #ifdef SIMP_BOND
    /*
    * Does a bond potential exist?
@@ -453,7 +509,7 @@ namespace McMd
    /*
    * Return Coulomb potential by reference.
    */
-   inline CoulombPotential& McSystem::coulombPotential() const
+   inline McCoulombPotential& McSystem::coulombPotential() const
    {  
       assert(coulombPotentialPtr_);  
       return *coulombPotentialPtr_; 
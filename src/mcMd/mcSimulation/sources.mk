@@ -5,6 +5,12 @@ mcMd_mcSimulation_=\
     mcMd/mcSimulation/McSystemInterface.cpp \
     mcMd/mcSimulation/McAnalyzerManager.cpp \
     mcMd/mcSimulation/McCommandManager.cpp \
+    mcMd/mcSimulation/McReplicaBatch.cpp 
+
+ifndef SIMP_NOPAIR
+mcMd_mcSimulation_+=\
+    mcMd/mcSimulation/McEnergyCache.cpp 
+endif
 
 mcMd_mcSimulation_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_mcSimulation_))
@@ -41,7 +41,7 @@ namespace McMd
      pairListPtr_(&system.pairPotential().pairList()),
      #endif
      boundaryPtr_(&system.boundary()),
-     randomPtr_(&system.simulation().random()),
+     randomPtr_(&system.random()),
      energyEnsemblePtr_(&system.energyEnsemble()),
      atomCapacity_(system.simulation().atomCapacity()),
      isInitialized_(false)
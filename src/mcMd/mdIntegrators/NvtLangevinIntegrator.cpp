@@ -186,7 +186,7 @@ namespace McMd
       system().calculateForces();
 
       // 2nd half velocity Verlet, loop over atoms
-      Random& random = simulation().random();
+      Random& random = system().random();
       int j;
       #if USE_ITERATOR
       for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
@@ -645,7 +645,13 @@ namespace McMd
       Log::file() << "Begin main loop" << std::endl;
       bool hasFrame = true;
       timer.start();
-      for (iStep_ = 0; iStep_ <= max && hasFrame; ++iStep_) {
+      iStep_ = 0;
+      if (min > 0) {
+         // Skip frames before min (seeks, if supported by the reader)
+         hasFrame = trajectoryReaderPtr->skipFrames(min);
+         iStep_ = min;
+      }
+      for ( ; iStep_ <= max && hasFrame; ++iStep_) {
          hasFrame = trajectoryReaderPtr->readFrame();
          if (hasFrame) {
             #ifndef SIMP_NOPAIR
@@ -17,6 +17,7 @@
 #include <mcMd/generators/generatorFactory.h>
 #include <mcMd/potentials/pair/MdPairPotential.h>
 #include <mcMd/potentials/pair/PairFactory.h>
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/simulation/stress.h>
 
 #ifdef SIMP_BOND
@@ -101,7 +102,9 @@ namespace McMd
       #endif
       mdIntegratorPtr_(0),
       mdIntegratorFactoryPtr_(0),
-      createdMdIntegratorFactory_(false)
+      createdMdIntegratorFactory_(false),
+      nThread_(0),
+      deterministicForces_(false)
    {  
       setClassName("MdSystem"); 
 
@@ -144,7 +147,9 @@ namespace McMd
       #endif
       mdIntegratorPtr_(0),
       mdIntegratorFactoryPtr_(0),
-      createdMdIntegratorFactory_(false)
+      createdMdIntegratorFactory_(false),
+      nThread_(0),
+      deterministicForces_(false)
    {
       setClassName("MdSystem");
 
@@ -388,6 +393,14 @@ namespace McMd
          readEnsembles(in);
       }
 
+      // Threads used to compute forces (0 for all OpenMP threads)
+      nThread_ = 0;
+      readOptional<int>(in, "nThread", nThread_);
+      deterministicForces_ = false;
+      readOptional<bool>(in, "deterministicForces", deterministicForces_);
+      threadPool().setNThread(nThread_);
+      threadPool().setDeterministic(deterministicForces_);
+
       // Check for MdIntegratorFactory, create default if necessary.
       if (mdIntegratorFactoryPtr_ == 0) {
          mdIntegratorFactoryPtr_ = new MdIntegratorFactory(*this);
@@ -540,6 +553,15 @@ namespace McMd
          loadEnsembles(ar);
       }
 
+      // Threads used to compute forces (0 for all OpenMP threads)
+      nThread_ = 0;
+      loadParameter<int>(ar, "nThread", nThread_, false);
+      deterministicForces_ = false;
+      loadParameter<bool>(ar, "deterministicForces", deterministicForces_,
+                          false);
+      threadPool().setNThread(nThread_);
+      threadPool().setDeterministic(deterministicForces_);
+
       // Check for MdIntegratorFactory, create default if necessary.
       if (mdIntegratorFactoryPtr_ == 0) {
          mdIntegratorFactoryPtr_ = new MdIntegratorFactory(*this);
@@ -626,6 +648,8 @@ namespace McMd
          #endif
          saveEnsembles(ar);
       }
+      Parameter::saveOptional(ar, nThread_, (bool)(nThread_ > 0));
+      Parameter::saveOptional(ar, deterministicForces_, deterministicForces_);
       std::string className = mdIntegratorPtr_->className();
       ar & className;
       mdIntegratorPtr_->save(ar);
@@ -782,7 +806,7 @@ namespace McMd
    void MdSystem::setBoltzmannVelocities(double temperature)
    {
       Simulation& sim = simulation();
-      Random &random = sim.random();
+      Random &random = System::random();
       double scale;
       double mass;
       MoleculeIterator molIter;
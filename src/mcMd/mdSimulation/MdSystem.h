@@ -172,6 +172,11 @@ namespace McMd
       * list if necessary before calculating pair forces. On exit,
       * all atomic forces are updated to values corresponding to
       * current positions.
+      *
+      * If compiled with MCMD_OPENMP defined, the pair, bond, angle,
+      * dihedral, external and SPME potentials use the threads of
+      * the System ThreadPool (see the optional nThread and
+      * deterministicForces parameters).
       */
       void calculateForces();
 
@@ -481,6 +486,12 @@ namespace McMd
       /// Did this class create the MdIntegratorFactory?
       bool createdMdIntegratorFactory_;
 
+      /// Requested number of threads for forces (0 if not specified).
+      int nThread_;
+
+      /// Should threaded pair forces be independent of scheduling?
+      bool deterministicForces_;
+
       /*
       * Implementations of the explicit specializations of the public
       * stress calculators computeVirialStress(T& ) etc. for T = double,
@@ -0,0 +1,279 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "PackedCellList.h"
+#include <util/space/Dimension.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   PackedCellList::PackedCellList()
+    : totCells_(0),
+      cellCapacity_(MinCellCapacity),
+      atomCapacity_(0),
+      boundaryPtr_(0)
+   {
+      for (int i = 0; i < Dimension; ++i) {
+         invCellWidths_[i] = 0.0;
+         numCells_[i] = 0;
+      }
+   }
+
+   /*
+   * Destructor.
+   */
+   PackedCellList::~PackedCellList()
+   {}
+
+   /*
+   * Set atomCapacity and, if necessary, allocate arrays indexed by id.
+   */
+   void PackedCellList::setAtomCapacity(int atomCapacity)
+   {
+      if (atomCapacity <= 0) {
+         UTIL_THROW("atomCapacity must be > 0");
+      }
+      if (atomCapacity > atomCellIds_.capacity()) {
+         if (atomCellIds_.isAllocated()) {
+            atomCellIds_.deallocate();
+            atomSlots_.deallocate();
+         }
+         atomCellIds_.allocate(atomCapacity);
+         atomSlots_.allocate(atomCapacity);
+      }
+      atomCapacity_ = atomCapacity;
+      for (int i = 0; i < atomCapacity_; ++i) {
+         atomCellIds_[i] = -1;
+         atomSlots_[i] = -1;
+      }
+   }
+
+   /*
+   * Setup an empty grid of cells.
+   */
+   void PackedCellList::setup(const Boundary& boundary, double cutoff)
+   {
+      if (cutoff <= 0) {
+         UTIL_THROW("cutoff must be > 0");
+      }
+      if (atomCapacity_ <= 0) {
+         UTIL_THROW("setAtomCapacity must be called before setup");
+      }
+
+      Vector lengths = boundary.lengths();
+      for (int i = 0; i < Dimension; ++i) {
+         numCells_[i] = (int)(lengths[i]/cutoff);
+         if (numCells_[i] < 1) {
+            numCells_[i] = 1;
+         }
+         invCellWidths_[i] = (double)numCells_[i];
+      }
+      totCells_ = numCells_[0]*numCells_[1]*numCells_[2];
+      boundaryPtr_ = &boundary;
+
+      if (totCells_ > cellSizes_.capacity()) {
+         if (cellSizes_.isAllocated()) {
+            cellSizes_.deallocate();
+            nNeighborCells_.deallocate();
+            neighborCells_.deallocate();
+         }
+         cellSizes_.allocate(totCells_);
+         nNeighborCells_.allocate(totCells_);
+         neighborCells_.allocate(totCells_*MaxNeighborCell);
+      }
+      if (totCells_*cellCapacity_ > positions_.capacity()) {
+         allocatePacked();
+      }
+      setNeighborCells();
+      clear();
+   }
+
+   /*
+   * Remove all atoms.
+   */
+   void PackedCellList::clear()
+   {
+      int i;
+      for (i = 0; i < totCells_; ++i) {
+         cellSizes_[i] = 0;
+      }
+      for (i = 0; i < atomCapacity_; ++i) {
+         atomCellIds_[i] = -1;
+         atomSlots_[i] = -1;
+      }
+   }
+
+   /*
+   * Compute the list of distinct neighboring cells of each cell.
+   *
+   * The range of offsets along each axis is -1..1 if there are more
+   * than two cells along that axis, -1..0 if there are two, and 0..0
+   * if there is one, as in CellList, so no cell is listed twice.
+   */
+   void PackedCellList::setNeighborCells()
+   {
+      IntVector minDel, maxDel;
+      int i;
+      for (i = 0; i < Dimension; ++i) {
+         if (numCells_[i] > 2) {
+            minDel[i] = -1;
+            maxDel[i] =  1;
+         } else if (numCells_[i] == 2) {
+            minDel[i] = -1;
+            maxDel[i] =  0;
+         } else {
+            minDel[i] =  0;
+            maxDel[i] =  0;
+         }
+      }
+
+      int ic, icx, icy, icz, jc, jcx, jcy, jcz, dcx, dcy, dcz, n;
+      for (icx = 0; icx < numCells_[0]; ++icx) {
+         for (icy = 0; icy < numCells_[1]; ++icy) {
+            for (icz = 0; icz < numCells_[2]; ++icz) {
+               ic = icz + numCells_[2]*(icy + numCells_[1]*icx);
+
+               // The cell itself is listed first
+               neighborCells_[ic*MaxNeighborCell] = ic;
+               n = 1;
+               for (dcx = minDel[0]; dcx <= maxDel[0]; ++dcx) {
+                  jcx = (icx + dcx + numCells_[0]) % numCells_[0];
+                  for (dcy = minDel[1]; dcy <= maxDel[1]; ++dcy) {
+                     jcy = (icy + dcy + numCells_[1]) % numCells_[1];
+                     for (dcz = minDel[2]; dcz <= maxDel[2]; ++dcz) {
+                        jcz = (icz + dcz + numCells_[2]) % numCells_[2];
+                        jc = jcz + numCells_[2]*(jcy + numCells_[1]*jcx);
+                        if (jc != ic) {
+                           neighborCells_[ic*MaxNeighborCell + n] = jc;
+                           ++n;
+                        }
+                     }
+                  }
+               }
+               nNeighborCells_[ic] = n;
+
+            }
+         }
+      }
+   }
+
+   /*
+   * Allocate packed arrays for current totCells_ and cellCapacity_.
+   */
+   void PackedCellList::allocatePacked()
+   {
+      if (positions_.isAllocated()) {
+         positions_.deallocate();
+         typeIds_.deallocate();
+         atomPtrs_.deallocate();
+      }
+      int size = totCells_*cellCapacity_;
+      positions_.allocate(size);
+      typeIds_.allocate(size);
+      atomPtrs_.allocate(size);
+   }
+
+   /*
+   * Double the capacity of every cell, and repack the contents.
+   */
+   void PackedCellList::grow()
+   {
+      DArray<Vector> oldPositions;
+      DArray<int> oldTypeIds;
+      DArray<Atom*> oldAtomPtrs;
+      int oldCapacity = cellCapacity_;
+      int size = totCells_*oldCapacity;
+      oldPositions.allocate(size);
+      oldTypeIds.allocate(size);
+      oldAtomPtrs.allocate(size);
+      int ic, j, oldSlot, newSlot;
+      for (ic = 0; ic < totCells_; ++ic) {
+         for (j = 0; j < cellSizes_[ic]; ++j) {
+            oldSlot = ic*oldCapacity + j;
+            oldPositions[oldSlot] = positions_[oldSlot];
+            oldTypeIds[oldSlot] = typeIds_[oldSlot];
+            oldAtomPtrs[oldSlot] = atomPtrs_[oldSlot];
+         }
+      }
+
+      cellCapacity_ = 2*oldCapacity;
+      allocatePacked();
+      for (ic = 0; ic < totCells_; ++ic) {
+         for (j = 0; j < cellSizes_[ic]; ++j) {
+            oldSlot = ic*oldCapacity + j;
+            newSlot = ic*cellCapacity_ + j;
+            positions_[newSlot] = oldPositions[oldSlot];
+            typeIds_[newSlot] = oldTypeIds[oldSlot];
+            atomPtrs_[newSlot] = oldAtomPtrs[oldSlot];
+            atomSlots_[atomPtrs_[newSlot]->id()] = newSlot;
+         }
+      }
+   }
+
+   /*
+   * Get total number of atoms in this list.
+   */
+   int PackedCellList::nAtom() const
+   {
+      int nAtomSum = 0;
+      for (int ic = 0; ic < totCells_; ++ic) {
+         nAtomSum += cellSizes_[ic];
+      }
+      return nAtomSum;
+   }
+
+   /*
+   * Check validity of list, throw an Exception if an error is found.
+   */
+   bool PackedCellList::isValid(int nAtom) const
+   {
+      const Atom* atomPtr;
+      int ic, j, slot, atomId;
+      int nAtomSum = 0;
+      for (ic = 0; ic < totCells_; ++ic) {
+         if (cellSizes_[ic] < 0 || cellSizes_[ic] > cellCapacity_) {
+            UTIL_THROW("Invalid cell size");
+         }
+         for (j = 0; j < cellSizes_[ic]; ++j) {
+            slot = ic*cellCapacity_ + j;
+            atomPtr = atomPtrs_[slot];
+            if (atomPtr == 0) {
+               UTIL_THROW("Null atom pointer in occupied slot");
+            }
+            atomId = atomPtr->id();
+            if (atomCellIds_[atomId] != ic) {
+               UTIL_THROW("Inconsistent cell id for atom");
+            }
+            if (atomSlots_[atomId] != slot) {
+               UTIL_THROW("Inconsistent slot for atom");
+            }
+            if (!(positions_[slot] == atomPtr->position())) {
+               UTIL_THROW("Stored position differs from atom position");
+            }
+            if (typeIds_[slot] != atomPtr->typeId()) {
+               UTIL_THROW("Stored type id differs from atom type id");
+            }
+            if (cellIndexFromPosition(positions_[slot]) != ic) {
+               UTIL_THROW("Atom is not in cell containing its position");
+            }
+         }
+         nAtomSum += cellSizes_[ic];
+      }
+      if (nAtom >= 0) {
+         if (nAtomSum != nAtom) {
+            UTIL_THROW("Number of atoms in all cells != nAtom");
+         }
+      }
+      return true;
+   }
+
+}
@@ -0,0 +1,362 @@
+#ifndef MCMD_PACKED_CELL_LIST_H
+#define MCMD_PACKED_CELL_LIST_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/chemistry/Atom.h>
+#include <simp/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+class PackedCellListTest;
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * A cell list that stores packed copies of atomic positions and types.
+   *
+   * A PackedCellList divides the volume within a Boundary into the same
+   * grid of cells as a CellList with the same cutoff. Unlike a CellList,
+   * which stores an array of pointers to Atom objects for each cell, a
+   * PackedCellList stores a copy of the position and type id of each
+   * atom, along with its address, in contiguous arrays. Each cell owns
+   * a block of equal capacity within three flat arrays of positions,
+   * type ids and Atom pointers, and the atoms of each cell occupy the
+   * beginning of its block, with no empty elements. When an atom is
+   * added to a full cell, the capacity of every cell is doubled and the
+   * arrays are repacked, so there is no fixed limit on the number of
+   * atoms in a cell.
+   *
+   * Neighbors of a position are accessed with visitNeighbors(), which
+   * passes the packed arrays of each cell in the neighborhood of the
+   * position to a visitor object. No array of neighbor pointers is
+   * filled, and a visitor need not dereference an Atom pointer to
+   * obtain the position or type of a neighbor.
+   *
+   * Because positions and type ids are copies, updateAtom() must be
+   * called after any change of the position or type of an atom in the
+   * list, before the list is used to compute energies, even if the atom
+   * stays within the same cell. A change of type can also be recorded
+   * by updateAtom().
+   *
+   * \ingroup McMd_Neighbor_Module
+   */
+   class PackedCellList
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      PackedCellList();
+
+      /**
+      * Destructor.
+      */
+      ~PackedCellList();
+
+      /**
+      * Set atom capacity, and allocate arrays indexed by atom id.
+      *
+      * \param atomCapacity dimension of global array of atoms
+      */
+      void setAtomCapacity(int atomCapacity);
+
+      /**
+      * Setup grid of empty cells.
+      *
+      * The grid is chosen as in CellList::setup(), so that the width of
+      * each cell in each direction is at least cutoff. Storage is
+      * reallocated only if the grid is larger than any previous grid.
+      *
+      * \param boundary  Boundary object for the system
+      * \param cutoff  minimum dimension of a cell in any direction
+      */
+      void setup(const Boundary& boundary, double cutoff);
+
+      /**
+      * Remove all atoms, without changing the grid.
+      */
+      void clear();
+
+      /**
+      * Return index of the cell that contains a position.
+      *
+      * \param pos position vector, within the primary cell
+      */
+      int cellIndexFromPosition(const Vector& pos) const;
+
+      /**
+      * Add an Atom to the appropriate cell, based on its position.
+      *
+      * \param atom  Atom object to be added
+      */
+      void addAtom(Atom& atom);
+
+      /**
+      * Remove an Atom from its cell.
+      *
+      * \param atom  Atom object to be removed
+      */
+      void deleteAtom(Atom& atom);
+
+      /**
+      * Record the current position and type of an Atom in the list.
+      *
+      * Moves the atom to a new cell if necessary, and otherwise updates
+      * the stored position and type id in place. Does nothing if the
+      * atom is not in the list.
+      *
+      * \param atom  Atom object that has been moved or retyped
+      */
+      void updateAtom(Atom& atom);
+
+      /**
+      * Visit all atoms in the cell containing a position and its neighbors.
+      *
+      * For each cell in the neighborhood of the cell containing pos,
+      * this function calls
+      * \code
+      *    visitor(positions, typeIds, atomPtrs, n);
+      * \endcode
+      * in which positions, typeIds and atomPtrs are pointers to the
+      * first elements of contiguous arrays containing the positions,
+      * type ids and addresses of the n atoms in the cell. The cell that
+      * contains pos is visited first. Each cell is visited once, even
+      * when the grid has fewer than three cells along some direction.
+      *
+      * \param pos  position vector, within the primary cell
+      * \param visitor  function object (modified by calls)
+      */
+      template <class Visitor>
+      void visitNeighbors(const Vector& pos, Visitor& visitor) const;
+
+      /**
+      * Number of cells along axis i.
+      *
+      * \param i index for axis (direction).
+      */
+      int gridDimension(int i) const;
+
+      /**
+      * Get total number of cells.
+      */
+      int totCells() const;
+
+      /**
+      * Get the current maximum number of atoms per cell.
+      */
+      int cellCapacity() const;
+
+      /**
+      * Get total number of atoms in this list.
+      */
+      int nAtom() const;
+
+      /**
+      * Return true if valid, or throw Exception.
+      *
+      * Checks that every stored position and type id equals that of
+      * the corresponding Atom, and that each atom is in the cell that
+      * contains its position. If nAtom >= 0, also checks that the total
+      * number of atoms equals nAtom.
+      *
+      * \param nAtom expected number of atoms, or -1 to skip this check
+      */
+      bool isValid(int nAtom = -1) const;
+
+   private:
+
+      /// Maximum number of cells in the neighborhood of a cell.
+      static const int MaxNeighborCell = 27;
+
+      /// Initial number of atoms per cell.
+      static const int MinCellCapacity = 16;
+
+      /// Packed atomic positions, cellCapacity_ elements per cell.
+      DArray<Vector> positions_;
+
+      /// Packed atom type ids, cellCapacity_ elements per cell.
+      DArray<int> typeIds_;
+
+      /// Packed Atom pointers, cellCapacity_ elements per cell.
+      DArray<Atom*> atomPtrs_;
+
+      /// Number of atoms in each cell.
+      DArray<int> cellSizes_;
+
+      /// Indices of cells in the neighborhood of each cell (27 per cell).
+      DArray<int> neighborCells_;
+
+      /// Number of distinct cells in the neighborhood of each cell.
+      DArray<int> nNeighborCells_;
+
+      /// Index of the cell containing each atom, indexed by atom id.
+      DArray<int> atomCellIds_;
+
+      /// Index of each atom in the packed arrays, indexed by atom id.
+      DArray<int> atomSlots_;
+
+      /// Number of cells along each axis, per unit generalized coordinate.
+      Vector invCellWidths_;
+
+      /// Number of cells along each axis.
+      IntVector numCells_;
+
+      /// Total number of cells in grid.
+      int totCells_;
+
+      /// Maximum number of atoms in each cell.
+      int cellCapacity_;
+
+      /// Maximum atom id + 1.
+      int atomCapacity_;
+
+      /// Pointer to associated Boundary.
+      const Boundary* boundaryPtr_;
+
+      /*
+      * Compute the list of neighboring cells for every cell.
+      */
+      void setNeighborCells();
+
+      /*
+      * Allocate packed arrays for the current grid and cellCapacity_.
+      */
+      void allocatePacked();
+
+      /*
+      * Double the capacity of every cell, preserving its contents.
+      */
+      void grow();
+
+   //friends:
+
+      /// Grant access to unit test class.
+      friend class ::PackedCellListTest;
+
+   };
+
+   // Inline functions
+
+   /*
+   * Return index of the cell that contains a position.
+   */
+   inline int PackedCellList::cellIndexFromPosition(const Vector& pos) const
+   {
+      Vector posG;
+      boundaryPtr_->transformCartToGen(pos, posG);
+      int cx = int(posG[0]*invCellWidths_[0]);
+      int cy = int(posG[1]*invCellWidths_[1]);
+      int cz = int(posG[2]*invCellWidths_[2]);
+      assert(cx >= 0 && cx < numCells_[0]);
+      assert(cy >= 0 && cy < numCells_[1]);
+      assert(cz >= 0 && cz < numCells_[2]);
+      return cz + numCells_[2]*(cy + numCells_[1]*cx);
+   }
+
+   /*
+   * Add an Atom to the appropriate cell.
+   */
+   inline void PackedCellList::addAtom(Atom& atom)
+   {
+      int atomId = atom.id();
+      assert(atomId >= 0 && atomId < atomCapacity_);
+      assert(atomCellIds_[atomId] < 0);
+      int cellId = cellIndexFromPosition(atom.position());
+      if (cellSizes_[cellId] == cellCapacity_) {
+         grow();
+      }
+      int slot = cellId*cellCapacity_ + cellSizes_[cellId];
+      positions_[slot] = atom.position();
+      typeIds_[slot] = atom.typeId();
+      atomPtrs_[slot] = &atom;
+      ++cellSizes_[cellId];
+      atomCellIds_[atomId] = cellId;
+      atomSlots_[atomId] = slot;
+   }
+
+   /*
+   * Remove an Atom, replacing it by the last atom of its cell.
+   */
+   inline void PackedCellList::deleteAtom(Atom& atom)
+   {
+      int atomId = atom.id();
+      assert(atomId >= 0 && atomId < atomCapacity_);
+      int cellId = atomCellIds_[atomId];
+      assert(cellId >= 0);
+      int slot = atomSlots_[atomId];
+      int last = cellId*cellCapacity_ + cellSizes_[cellId] - 1;
+      if (slot != last) {
+         positions_[slot] = positions_[last];
+         typeIds_[slot] = typeIds_[last];
+         atomPtrs_[slot] = atomPtrs_[last];
+         atomSlots_[atomPtrs_[slot]->id()] = slot;
+      }
+      --cellSizes_[cellId];
+      atomCellIds_[atomId] = -1;
+      atomSlots_[atomId] = -1;
+   }
+
+   /*
+   * Record the current position and type of an Atom.
+   */
+   inline void PackedCellList::updateAtom(Atom& atom)
+   {
+      int atomId = atom.id();
+      assert(atomId >= 0 && atomId < atomCapacity_);
+      int oldCell = atomCellIds_[atomId];
+      if (oldCell < 0) return;
+      int newCell = cellIndexFromPosition(atom.position());
+      if (newCell == oldCell) {
+         int slot = atomSlots_[atomId];
+         positions_[slot] = atom.position();
+         typeIds_[slot] = atom.typeId();
+      } else {
+         deleteAtom(atom);
+         addAtom(atom);
+      }
+   }
+
+   /*
+   * Visit atoms in all cells in the neighborhood of a position.
+   */
+   template <class Visitor>
+   void
+   PackedCellList::visitNeighbors(const Vector& pos, Visitor& visitor) const
+   {
+      int ic = cellIndexFromPosition(pos);
+      const int* cellPtr = &neighborCells_[ic*MaxNeighborCell];
+      int nCell = nNeighborCells_[ic];
+      int jc, begin;
+      for (int k = 0; k < nCell; ++k) {
+         jc = cellPtr[k];
+         begin = jc*cellCapacity_;
+         visitor(&positions_[begin], &typeIds_[begin], &atomPtrs_[begin],
+                 cellSizes_[jc]);
+      }
+   }
+
+   inline int PackedCellList::gridDimension(int i) const
+   {  return numCells_[i]; }
+
+   inline int PackedCellList::totCells() const
+   {  return totCells_; }
+
+   inline int PackedCellList::cellCapacity() const
+   {  return cellCapacity_; }
+
+}
+#endif
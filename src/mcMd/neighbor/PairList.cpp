@@ -11,6 +11,8 @@
 #include <util/space/Vector.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace McMd
 {
 
@@ -303,6 +305,30 @@ namespace McMd
       iterator.atom2Id_   = 0;
    }
 
+   /*
+   * Initialize a PairIterator for pairs beginPair <= i < endPair.
+   */
+   void PairList::begin(PairIterator& iterator, int beginPair, int endPair)
+   const
+   {
+      assert(beginPair >= 0);
+      assert(beginPair <= endPair);
+      assert(endPair <= nAtom2_);
+
+      // Find primary atom i with first_[i] <= beginPair < first_[i+1]
+      const int* firstPtr = &first_[0];
+      int i = std::upper_bound(firstPtr, firstPtr + nAtom1_ + 1, beginPair)
+            - firstPtr - 1;
+
+      iterator.atom1Ptrs_ = &atom1Ptrs_[0];
+      iterator.atom2Ptrs_ = &atom2Ptrs_[0];
+      iterator.first_     = firstPtr;
+      iterator.nAtom1_    = nAtom1_;
+      iterator.nAtom2_    = endPair;
+      iterator.atom1Id_   = i;
+      iterator.atom2Id_   = beginPair;
+   }
+
    
    /*
    * Return false if any atom has moved a distance greater than skin/2,
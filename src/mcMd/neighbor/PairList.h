@@ -157,6 +157,19 @@ namespace McMd
       * \param iterator a PairList, initialized on output
       */
       void begin(PairIterator &iterator) const;
+
+      /**
+      * Initialize a PairIterator for a contiguous range of pairs.
+      *
+      * The iterator visits pairs with indices beginPair <= i < endPair,
+      * in the same order as the PairIterator returned by begin(). This
+      * allows the list to be divided among threads.
+      *
+      * \param iterator  PairIterator, initialized on output
+      * \param beginPair  index of first pair, 0 <= beginPair <= nPair()
+      * \param endPair  index one past last pair, endPair <= nPair()
+      */
+      void begin(PairIterator &iterator, int beginPair, int endPair) const;
  
       //@}
       /// \name Accessors (miscellaneous)
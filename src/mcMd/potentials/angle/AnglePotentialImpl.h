@@ -203,6 +203,7 @@ namespace McMd
 
 #include <mcMd/simulation/System.h> 
 #include <mcMd/simulation/Simulation.h> 
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/simulation/stress.h>
 #include <mcMd/chemistry/getAtomGroups.h>
 #include <simp/boundary/Boundary.h> 
@@ -394,16 +395,23 @@ namespace McMd
    template <class Interaction>
    void AnglePotentialImpl<Interaction>::addForces() 
    {
-      Vector dr1, dr2, force1, force2;
-      System::MoleculeIterator molIter;
-      Molecule::AngleIterator angleIter;
-      Atom *atom0Ptr, *atom1Ptr, *atom2Ptr;
-      int iSpec;
+      int nThread = system().threadPool().nThread();
+      int iSpec, iMol, nMol;
 
+      // Angles are intramolecular, so molecules may be given to
+      // different threads (see BondPotentialImpl::addForces).
       for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
          if (simulation().species(iSpec).nAngle() > 0) {
-            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-               for (molIter->begin(angleIter); angleIter.notEnd(); ++angleIter){
+            nMol = nMolecule(iSpec);
+            #ifdef MCMD_OPENMP
+            #pragma omp parallel for schedule(static) num_threads(nThread)
+            #endif
+            for (iMol = 0; iMol < nMol; ++iMol) {
+               Molecule& molecule = system().molecule(iSpec, iMol);
+               Molecule::AngleIterator angleIter;
+               Vector dr1, dr2, force1, force2;
+               Atom *atom0Ptr, *atom1Ptr, *atom2Ptr;
+               for (molecule.begin(angleIter); angleIter.notEnd(); ++angleIter){
                   atom0Ptr = &(angleIter->atom(0));
                   atom1Ptr = &(angleIter->atom(1));
                   atom2Ptr = &(angleIter->atom(2));
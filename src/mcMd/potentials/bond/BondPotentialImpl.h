@@ -175,6 +175,7 @@ namespace McMd
 
 #include <mcMd/simulation/System.h> 
 #include <mcMd/simulation/Simulation.h> 
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/simulation/stress.h>
 #include <mcMd/chemistry/getAtomGroups.h>
 #include <simp/boundary/Boundary.h> 
@@ -352,18 +353,25 @@ namespace McMd
    template <class Interaction>
    void BondPotentialImpl<Interaction>::addForces() 
    {
-      Vector force;
-      double rsq;
-      System::MoleculeIterator molIter;
-      Molecule::BondIterator bondIter;
-      Atom *atom0Ptr, *atom1Ptr;
-      int iSpec;
+      int nThread = system().threadPool().nThread();
+      int iSpec, iMol, nMol;
 
-      // Loop over all bonds in system
+      // Loop over all bonds in system. Bonds connect atoms of the same
+      // molecule, so different molecules may be given to different
+      // threads without conflicting updates of atomic forces.
       for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
          if (simulation().species(iSpec).nBond() > 0) {
-            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-               for (molIter->begin(bondIter); bondIter.notEnd(); ++bondIter) {
+            nMol = nMolecule(iSpec);
+            #ifdef MCMD_OPENMP
+            #pragma omp parallel for schedule(static) num_threads(nThread)
+            #endif
+            for (iMol = 0; iMol < nMol; ++iMol) {
+               Molecule& molecule = system().molecule(iSpec, iMol);
+               Molecule::BondIterator bondIter;
+               Vector force;
+               double rsq;
+               Atom *atom0Ptr, *atom1Ptr;
+               for (molecule.begin(bondIter); bondIter.notEnd(); ++bondIter) {
                   atom0Ptr = &(bondIter->atom(0));
                   atom1Ptr = &(bondIter->atom(1));
                   rsq = boundary().distanceSq(atom0Ptr->position(), 
@@ -11,6 +11,7 @@
 #include <util/param/Factory.h>                         // base class template
 #include <mcMd/potentials/coulomb/MdCoulombPotential.h> // template argument
 #include <mcMd/potentials/coulomb/MdEwaldPotential.h>
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
 
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@ namespace McMd
 {
 
    class System;
+   class McSystem;
 
    /**
    * Factory for CoulombPotential objects.
@@ -40,6 +42,15 @@ namespace McMd
       */
       MdCoulombPotential* factory(const std::string& subclass) const;
 
+      /**
+      * Return a pointer to a new McCoulombPotential, if possible.
+      *
+      * \param subclass  name of the Coulomb potential style
+      * \param system  parent McSystem
+      */
+      McCoulombPotential* 
+      mcFactory(const std::string& subclass, McSystem& system) const;
+
    private:
 
       // Pointer to the parent System.
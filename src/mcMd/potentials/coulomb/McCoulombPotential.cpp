@@ -0,0 +1,100 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "McCoulombPotential.h"
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   McCoulombPotential::McCoulombPotential()
+    : hasWaves_(false),
+      hasKSpaceCharge_(false)
+   {  setClassName("CoulombPotential"); }
+
+   /*
+   * Destructor (does nothing)
+   */
+   McCoulombPotential::~McCoulombPotential()
+   {}
+
+   /*
+   * Modify an interaction parameter (default implementation throws).
+   */
+   void McCoulombPotential::set(std::string name, double value)
+   {  UTIL_THROW("Unimplemented virtual set method"); }
+
+   /*
+   * Get an interaction parameter (default implementation throws).
+   */
+   double McCoulombPotential::get(std::string name) const
+   {
+      UTIL_THROW("Unimplemented virtual get method");
+      return 0.0;
+   }
+
+   /*
+   * Unset waves, charge density and energies.
+   */
+   void McCoulombPotential::unsetWaves()
+   {
+      hasWaves_ = false;
+      unsetKSpaceCharge();
+   }
+
+   /*
+   * Unset Fourier charge density and energies.
+   */
+   void McCoulombPotential::unsetKSpaceCharge()
+   {
+      hasKSpaceCharge_ = false;
+      unsetEnergy();
+   }
+
+   /*
+   * Unset k-space and r-space energies.
+   */
+   void McCoulombPotential::unsetEnergy()
+   {
+      kSpaceEnergy_.unset();
+      rSpaceEnergy_.unset();
+   }
+
+   /*
+   * Get k-space energy (compute iff necessary).
+   */
+   double McCoulombPotential::kSpaceEnergy()
+   {
+      if (!kSpaceEnergy_.isSet()) {
+         computeKSpaceEnergy();
+      }
+      return kSpaceEnergy_.value();
+   }
+
+   /*
+   * Get r-space energy (compute iff necessary).
+   */
+   double McCoulombPotential::rSpaceEnergy()
+   {
+      if (!rSpaceEnergy_.isSet()) {
+         computeRSpaceEnergy();
+      }
+      return rSpaceEnergy_.value();
+   }
+
+   /*
+   * Get total Coulomb energy (recompute as needed).
+   */
+   double McCoulombPotential::energy()
+   {  return kSpaceEnergy() + rSpaceEnergy(); }
+
+}
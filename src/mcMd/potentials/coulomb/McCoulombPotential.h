@@ -4,11 +4,13 @@
 /*
 * Simpatico - Simulation Package for Polymeric and Molecular Liquids
 *
-* Copyright 2010 - 2012, David Morse (morse012@umn.edu)
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
 * Distributed under the terms of the GNU General Public License.
 */
 
-#include "CoulombPotential.h"
+#include <util/param/ParamComposite.h>     // base class
+#include <util/misc/Setable.h>             // member template
+#include <util/space/Vector.h>             // function parameter
 
 namespace McMd
 {
@@ -18,34 +20,225 @@ namespace McMd
    using namespace Util;
 
    /**
-   * Long-range part of Coulomb potential for MC.
+   * Coulomb potential for a Monte Carlo simulation.
+   *
+   * An McCoulombPotential computes the short-range r-space energy
+   * of individual atoms, and the long-range k-space energy of the
+   * system. It stores the Fourier components of the charge density,
+   * and can compute the change in k-space energy produced by moving
+   * one or several atoms at a cost proportional to the number of
+   * wavevectors, rather than to the number of atoms times the number
+   * of wavevectors.
+   *
+   * A Monte Carlo move that moves charged atoms must:
+   *
+   *  - Include rSpaceAtomEnergy() in the energy of each moved atom,
+   *    before and after the move.
+   *  - Call clearTrial(), then addTrialMove() for each moved atom,
+   *    and include trialEnergy() in the energy change of the move.
+   *  - Call acceptTrial() if the move is accepted.
+   *
+   * Any other change of atomic positions or charges must be followed
+   * by a call to unsetKSpaceCharge(), or unsetWaves() if the boundary
+   * has also changed, and then by computeKSpaceCharge() before the
+   * next trial. Because moves change atomic positions before calling
+   * trialEnergy(), the charge density is never recomputed lazily
+   * within a trial.
    *
    * \ingroup McMd_Coulomb_Module
    */
-   class McCoulombPotential : public CoulombPotential
+   class McCoulombPotential : public ParamComposite
    {
 
    public:
 
       /**
-      * Constructor .
+      * Constructor.
       */
-      McCoulombPotential(System& system);
+      McCoulombPotential();
 
       /**
-      * Destructor (does nothing)
+      * Destructor (does nothing).
       */
       virtual ~McCoulombPotential();
 
       /**
-      * Calculate the covalent bond energy for one Atom.
+      * Modify an interaction parameter, identified by a string.
+      *
+      * \param name  parameter name
+      * \param value new value of parameter
+      */
+      virtual void set(std::string name, double value);
+
+      /**
+      * Get an interaction parameter value, identified by a string.
+      *
+      * \param name parameter name
+      */
+      virtual double get(std::string name) const;
+
+      /**
+      * Return the cutoff distance of the r-space pair interaction.
+      */
+      virtual double rSpaceCutoff() const = 0;
+
+      /// \name Waves (data that depends on Boundary).
+      //@{
+
+      /**
+      * Are wavevectors and k-space influence function up to date?
+      */
+      bool hasWaves() const;
+
+      /**
+      * Generate wavevectors and influence function for this boundary.
+      */
+      virtual void makeWaves() = 0;
+
+      /**
+      * Unset all data that depends on the Boundary.
+      *
+      * Unsets waves, Fourier charge density and k-space energy.
+      */
+      void unsetWaves();
+
+      /**
+      * Current number of wavevectors.
+      */
+      virtual int nWave() const = 0;
+
+      //@}
+      /// \name Fourier charge density
+      //@{
+
+      /**
+      * Compute Fourier components of the charge density of all atoms.
+      *
+      * Generates waves first if necessary.
+      */
+      virtual void computeKSpaceCharge() = 0;
+
+      /**
+      * Are Fourier components of the charge density up to date?
+      */
+      bool hasKSpaceCharge() const;
+
+      /**
+      * Unset Fourier components of the charge density and k-space energy.
+      */
+      void unsetKSpaceCharge();
+
+      //@}
+      /// \name Trial moves
+      //@{
+
+      /**
+      * Discard any changes of charge density accumulated for a trial.
+      */
+      virtual void clearTrial() = 0;
+
+      /**
+      * Add the move of one atom to the current trial.
       *
-      * \param  atom Atom object of interest
-      * \return bond potential energy of atom
+      * \param atom  Atom that is moved (used only for its charge)
+      * \param oldPosition  position of atom before the trial move
+      * \param newPosition  position of atom after the trial move
       */
-      virtual double kspaceAtomEnergy(const Atom& atom) const = 0;
+      virtual void addTrialMove(const Atom& atom,
+                                const Vector& oldPosition,
+                                const Vector& newPosition) = 0;
+
+      /**
+      * Return the change in k-space energy produced by the current trial.
+      *
+      * The Fourier charge density must have been computed, by calling
+      * computeKSpaceCharge(), before any atom in the trial was moved.
+      */
+      virtual double trialEnergy() = 0;
+
+      /**
+      * Accept the current trial, and update the charge density and energy.
+      *
+      * Must be preceded by a call to trialEnergy() for the same trial.
+      */
+      virtual void acceptTrial() = 0;
+
+      //@}
+      /// \name Energy
+      //@{
+
+      /**
+      * Return the short-range r-space Coulomb energy of one atom.
+      *
+      * \param atom Atom object of interest
+      */
+      virtual double rSpaceAtomEnergy(const Atom& atom) const = 0;
+
+      /**
+      * Compute the long-range k-space part of the Coulomb energy.
+      */
+      virtual void computeKSpaceEnergy() = 0;
+
+      /**
+      * Compute the short-range r-space part of the Coulomb energy.
+      */
+      virtual void computeRSpaceEnergy() = 0;
+
+      /**
+      * Unset stored k-space and r-space energies.
+      */
+      void unsetEnergy();
+
+      /**
+      * Get long-range k-space part of Coulomb energy.
+      *
+      * Recomputes iff necessary (i.e., if not set).
+      */
+      double kSpaceEnergy();
+
+      /**
+      * Get short-range r-space part of Coulomb energy.
+      *
+      * Recomputes iff necessary (i.e., if not set).
+      */
+      double rSpaceEnergy();
+
+      /**
+      * Get total Coulomb energy.
+      */
+      double energy();
+
+      //@}
+
+   protected:
+
+      /// K-space part of Coulomb energy.
+      Setable<double> kSpaceEnergy_;
+
+      /// R-space part of Coulomb energy.
+      Setable<double> rSpaceEnergy_;
+
+      /// Are waves and k-space potential up to date?
+      bool hasWaves_;
+
+      /// Are Fourier components of the charge density up to date?
+      bool hasKSpaceCharge_;
 
    };
 
-} 
+   // Inline functions
+
+   /*
+   * Are wavevectors and k-space potential up to date?
+   */
+   inline bool McCoulombPotential::hasWaves() const
+   {  return hasWaves_; }
+
+   /*
+   * Are Fourier components of the charge density up to date?
+   */
+   inline bool McCoulombPotential::hasKSpaceCharge() const
+   {  return hasKSpaceCharge_; }
+
+}
 #endif
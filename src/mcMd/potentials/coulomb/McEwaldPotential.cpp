@@ -0,0 +1,483 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "McEwaldPotential.h"
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <mcMd/chemistry/AtomType.h>
+#include <simp/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/math/Constants.h>
+#include <util/containers/Array.h>
+
+#include <cmath>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   McEwaldPotential::McEwaldPotential(McSystem& system)
+    : McCoulombPotential(),
+      ewaldInteraction_(),
+      simulationPtr_(&system.simulation()),
+      systemPtr_(&system),
+      boundaryPtr_(&system.boundary()),
+      atomTypesPtr_(&system.simulation().atomTypes()),
+      trialEnergy_(0.0),
+      kSpaceCutoff_(0.0),
+      hasTrial_(false)
+   {
+      // Note: Don't setClassName - using "CoulombPotential" base class name
+   }
+
+   /*
+   * Destructor (does nothing)
+   */
+   McEwaldPotential::~McEwaldPotential()
+   {}
+
+   /*
+   * Read parameters and initialize.
+   */
+   void McEwaldPotential::readParameters(std::istream& in)
+   {
+      // Read EwaldInteraction block containing parameters
+      bool nextIndent = false;
+      addParamComposite(ewaldInteraction_, nextIndent);
+      ewaldInteraction_.readParameters(in);
+
+      read<double>(in, "kSpaceCutoff", kSpaceCutoff_);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void McEwaldPotential::loadParameters(Serializable::IArchive &ar)
+   {
+      bool nextIndent = false;
+      addParamComposite(ewaldInteraction_, nextIndent);
+      ewaldInteraction_.loadParameters(ar);
+
+      loadParameter<double>(ar, "kSpaceCutoff", kSpaceCutoff_);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void McEwaldPotential::save(Serializable::OArchive &ar)
+   {
+      ewaldInteraction_.save(ar);
+      ar << kSpaceCutoff_;
+   }
+
+   /*
+   * Set a parameter value, identified by a string.
+   */
+   void McEwaldPotential::set(std::string name, double value)
+   {
+      if (name == "kSpaceCutoff") {
+         kSpaceCutoff_ = value;
+      } else {
+         ewaldInteraction_.set(name, value);
+      }
+      unsetWaves();
+   }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double McEwaldPotential::get(std::string name) const
+   {
+      double value;
+      if (name == "kSpaceCutoff") {
+         value = kSpaceCutoff_;
+      } else {
+         value = ewaldInteraction_.get(name);
+      }
+      return value;
+   }
+
+   /*
+   * Return the r-space cutoff distance.
+   */
+   double McEwaldPotential::rSpaceCutoff() const
+   {  return ewaldInteraction_.rSpaceCutoff(); }
+
+   /*
+   * Get number of wavevectors.
+   */
+   int McEwaldPotential::nWave() const
+   {  return intWaves_.size(); }
+
+   /*
+   * Generate waves using kSpaceCutoff, and allocate associated arrays.
+   *
+   * As in MdEwaldPotential, only half of the waves are stored, and the
+   * first index is always non-negative.
+   */
+   void McEwaldPotential::makeWaves()
+   {
+      Vector    b0, b1, b2;    // Reciprocal basis vectors.
+      Vector    q0, q1, q;     // Partial and complete wavevectors.
+      double    ksq;
+      IntVector maxK, k;       // Max and running wave indices.
+      int       mink1, mink2;  // Minimum k-indices
+      int       j;
+
+      b0 = boundaryPtr_->reciprocalBasisVector(0);
+      b1 = boundaryPtr_->reciprocalBasisVector(1);
+      b2 = boundaryPtr_->reciprocalBasisVector(2);
+
+      // Get max wave indices
+      double pi2 = 2.0*Constants::Pi;
+      for (j=0; j < Dimension; ++j) {
+         maxK[j] =
+             ceil(kSpaceCutoff_*boundaryPtr_->bravaisBasisVector(j).abs()/pi2);
+         UTIL_CHECK(maxK[j] > 0);
+      }
+
+      intWaves_.clear();
+      g_.clear();
+      rho_.clear();
+      drho_.clear();
+      fexp0_.clear();
+      fexp1_.clear();
+      fexp2_.clear();
+
+      // Accumulate waves, and wave-related properties.
+      base0_ = 0;
+      upper0_ = -maxK[0];
+      base1_ = maxK[1];
+      upper1_ = -base1_;
+      base2_ = maxK[2];
+      upper2_ = -base2_;
+      double kSpaceCutoffSq = kSpaceCutoff_*kSpaceCutoff_;
+
+      q0.multiply(b0, -1);
+      for (k[0] = 0; k[0] <= maxK[0]; ++k[0]) {
+
+         // Note: First index always non-negative.
+         q0 += b0;
+
+         mink1 = (k[0] == 0 ? 0 : -maxK[1]);
+         q1.multiply(b1, mink1 - 1);
+         q1 += q0;
+         for (k[1] = mink1; k[1] <= maxK[1]; ++k[1]) {
+            q1 += b1;
+
+            mink2 = (k[0] == 0 && k[1] == 0 ? 1 : -maxK[2]);
+            q.multiply(b2, mink2 - 1);
+            q += q1;
+
+            for (k[2] = mink2; k[2] <= maxK[2]; ++k[2]) {
+               q += b2;
+
+               ksq = double(q.square());
+               if (ksq <= kSpaceCutoffSq) {
+
+                  if (k[0] > upper0_) upper0_ = k[0];
+
+                  if (k[1] < base1_ ) base1_  = k[1];
+                  if (k[1] > upper1_) upper1_ = k[1];
+
+                  if (k[2] < base2_ ) base2_  = k[2];
+                  if (k[2] > upper2_) upper2_ = k[2];
+
+                  intWaves_.append(k);
+                  g_.append(ewaldInteraction_.kSpacePotential(ksq));
+               }
+
+            } // for k[2]
+         } // for k[1]
+      } // for k[0]
+
+      // Resize work arrays
+      UTIL_CHECK(intWaves_.size() > 0);
+      UTIL_CHECK(upper0_ - base0_ + 1 > 0);
+      UTIL_CHECK(upper1_ - base1_ + 1 > 0);
+      UTIL_CHECK(upper2_ - base2_ + 1 > 0);
+      rho_.resize(intWaves_.size());
+      drho_.resize(intWaves_.size());
+      fexp0_.resize(upper0_ - base0_ + 1);
+      fexp1_.resize(upper1_ - base1_ + 1);
+      fexp2_.resize(upper2_ - base2_ + 1);
+
+      // Mark waves as updated, and charge density as stale
+      hasWaves_ = true;
+      hasKSpaceCharge_ = false;
+      kSpaceEnergy_.unset();
+      clearTrial();
+   }
+
+   /*
+   * Add weight*exp(i k.r) to each element of array.
+   */
+   void McEwaldPotential::addPhases(const Vector& position, double weight,
+                                    GArray<DCMPLX>& array)
+   {
+      Vector rg;
+      IntVector q;
+      DCMPLX de;
+      DCMPLX TwoPiIm = 2.0*Constants::Pi*Constants::Im;  // 2.0*pi*I
+      int i;
+
+      boundaryPtr_->transformCartToGen(position, rg);
+
+      // Tabulate the exponential factors along each axis.
+      fexp0_[0] = exp(TwoPiIm * rg[0] * double(base0_));
+      de = exp(TwoPiIm * rg[0]);
+      for (i = 1; i < fexp0_.size(); ++i) {
+         fexp0_[i] = fexp0_[i-1] * de;
+      }
+
+      fexp1_[0] = exp(TwoPiIm * rg[1] * double(base1_));
+      de = exp(TwoPiIm * rg[1]);
+      for (i = 1; i < fexp1_.size(); ++i) {
+         fexp1_[i] = fexp1_[i-1] * de;
+      }
+
+      fexp2_[0] = exp(TwoPiIm * rg[2] * double(base2_));
+      de = exp(TwoPiIm * rg[2]);
+      for (i = 1; i < fexp2_.size(); ++i) {
+         fexp2_[i] = fexp2_[i-1] * de;
+      }
+
+      // Accumulate phases for all waves
+      for (i = 0; i < intWaves_.size(); ++i) {
+         q = intWaves_[i];
+         array[i] += weight * fexp0_[q[0]-base0_]
+                            * fexp1_[q[1]-base1_]
+                            * fexp2_[q[2]-base2_];
+      }
+   }
+
+   /*
+   * Calculate Fourier modes of charge density.
+   */
+   void McEwaldPotential::computeKSpaceCharge()
+   {
+      // Compute waves if necessary
+      if (!hasWaves()) {
+         makeWaves();
+      }
+
+      // Clear rho for all waves
+      int i;
+      for (i = 0; i < rho_.size(); ++i) {
+         rho_[i] = DCMPLX(0.0, 0.0);
+      }
+
+      // Loop over species, molecules atoms
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      double charge;
+      double EPS(1.0E-10);  // Tiny number to check if is charge
+      int  nSpecies = simulationPtr_->nSpecies();
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         systemPtr_->begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               charge = (*atomTypesPtr_)[atomIter->typeId()].charge();
+               if (fabs(charge) > EPS) {
+                  addPhases(atomIter->position(), charge, rho_);
+               }
+            }
+         }
+      }
+
+      hasKSpaceCharge_ = true;
+   }
+
+   /*
+   * Discard the current trial.
+   *
+   * Array drho_ is zeroed by addTrialMove when a new trial begins.
+   */
+   void McEwaldPotential::clearTrial()
+   {
+      trialEnergy_ = 0.0;
+      hasTrial_ = false;
+   }
+
+   /*
+   * Add change of charge density due to move of one atom.
+   */
+   void McEwaldPotential::addTrialMove(const Atom& atom,
+                                       const Vector& oldPosition,
+                                       const Vector& newPosition)
+   {
+      double EPS(1.0E-10);  // Tiny number to check if is charge
+      double charge = (*atomTypesPtr_)[atom.typeId()].charge();
+      if (fabs(charge) > EPS) {
+         UTIL_CHECK(hasKSpaceCharge_);
+         if (!hasTrial_) {
+            for (int i = 0; i < drho_.size(); ++i) {
+               drho_[i] = DCMPLX(0.0, 0.0);
+            }
+            hasTrial_ = true;
+         }
+         addPhases(newPosition, charge, drho_);
+         addPhases(oldPosition, -charge, drho_);
+      }
+   }
+
+   /*
+   * Return change in k-space energy for the current trial.
+   */
+   double McEwaldPotential::trialEnergy()
+   {
+      trialEnergy_ = 0.0;
+      if (!hasTrial_) {
+         return trialEnergy_;
+      }
+      UTIL_CHECK(hasKSpaceCharge_);
+
+      // |rho + drho|^2 - |rho|^2 = 2 Re(conj(rho) drho) + |drho|^2
+      double x, y, dx, dy;
+      double energy = 0.0;
+      for (int i = 0; i < intWaves_.size(); ++i) {
+         x = rho_[i].real();
+         y = rho_[i].imag();
+         dx = drho_[i].real();
+         dy = drho_[i].imag();
+         energy += g_[i]*(2.0*(x*dx + y*dy) + dx*dx + dy*dy);
+      }
+      trialEnergy_ = energy/boundaryPtr_->volume();
+      return trialEnergy_;
+   }
+
+   /*
+   * Accept the current trial: update charge density and energy.
+   */
+   void McEwaldPotential::acceptTrial()
+   {
+      if (hasTrial_) {
+         assert(hasKSpaceCharge_);
+         for (int i = 0; i < rho_.size(); ++i) {
+            rho_[i] += drho_[i];
+         }
+         if (kSpaceEnergy_.isSet()) {
+            kSpaceEnergy_.set(kSpaceEnergy_.value() + trialEnergy_);
+         }
+      }
+      rSpaceEnergy_.unset();
+      clearTrial();
+   }
+
+   /*
+   * Return r-space Coulomb energy of one atom.
+   */
+   double McEwaldPotential::rSpaceAtomEnergy(const Atom& atom) const
+   {
+      double EPS(1.0E-10);  // Tiny number to check if is charge
+      double iCharge = (*atomTypesPtr_)[atom.typeId()].charge();
+      if (fabs(iCharge) <= EPS) {
+         return 0.0;
+      }
+
+      const Atom* jAtomPtr;
+      double jCharge, rsq;
+      double cutoffSq = ewaldInteraction_.rSpaceCutoffSq();
+      double energy = 0.0;
+      int id = atom.id();
+      systemPtr_->pairPotential().cellList()
+                 .getNeighbors(atom.position(), neighbors_);
+      int nNeighbor = neighbors_.size();
+      for (int j = 0; j < nNeighbor; ++j) {
+         jAtomPtr = neighbors_[j];
+         if (jAtomPtr->id() != id) {
+            if (!atom.mask().isMasked(*jAtomPtr)) {
+               jCharge = (*atomTypesPtr_)[jAtomPtr->typeId()].charge();
+               rsq = boundaryPtr_->
+                     distanceSq(atom.position(), jAtomPtr->position());
+               if (rsq < cutoffSq) {
+                  energy += ewaldInteraction_.rSpaceEnergy(rsq,
+                                                           iCharge*jCharge);
+               }
+            }
+         }
+      }
+      return energy;
+   }
+
+   /*
+   * Calculate the k-space contribution to the Coulomb energy.
+   */
+   void McEwaldPotential::computeKSpaceEnergy()
+   {
+      // Compute Fourier components of charge density, if necessary.
+      if (!hasKSpaceCharge()) {
+         computeKSpaceCharge();
+      }
+
+      // Main loop over wavevectors
+      double x, y, rhoSq;
+      double energy = 0.0;
+      for (int i = 0; i < intWaves_.size(); ++i) {
+         x = rho_[i].real();
+         y = rho_[i].imag();
+         rhoSq = x*x + y*y;
+         energy += rhoSq*g_[i];
+      }
+      energy /= boundaryPtr_->volume();
+      // Note: A factor of 0.5 in the expression for the kspace energy
+      // is cancelled by our use of only half the wavevectors
+
+      // Calculate self-energy correction to Ewald summation.
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      double charge;
+      double selfEnergy = 0.0;
+      int nSpecies = simulationPtr_->nSpecies();
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         systemPtr_->begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               charge = (*atomTypesPtr_)[atomIter->typeId()].charge();
+               selfEnergy += charge*charge;
+            }
+         }
+      }
+      double pi = Constants::Pi;
+      double alpha = ewaldInteraction_.alpha();
+      double epsilon = ewaldInteraction_.epsilon();
+      selfEnergy *= alpha/(4.0*sqrt(pi)*pi*epsilon);
+
+      kSpaceEnergy_.set(energy - selfEnergy);
+   }
+
+   /*
+   * Calculate the r-space contribution to the Coulomb energy.
+   */
+   void McEwaldPotential::computeRSpaceEnergy()
+   {
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      double energy = 0.0;
+      int nSpecies = simulationPtr_->nSpecies();
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         systemPtr_->begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               energy += rSpaceAtomEnergy(*atomIter);
+            }
+         }
+      }
+
+      // Each pair was counted twice
+      rSpaceEnergy_.set(0.5*energy);
+   }
+
+}
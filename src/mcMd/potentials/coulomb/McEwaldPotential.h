@@ -0,0 +1,255 @@
+#ifndef MCMD_MC_EWALD_POTENTIAL_H
+#define MCMD_MC_EWALD_POTENTIAL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>  // base class
+#include <mcMd/neighbor/CellList.h>      // member
+#include <mcMd/chemistry/AtomType.h>     // member template parameter
+
+#include <simp/interaction/coulomb/EwaldInteraction.h>   // member
+#include <simp/boundary/Boundary.h>      // typedef
+
+#include <util/space/IntVector.h>        // member template parameter
+#include <util/space/Vector.h>           // member template parameter
+#include <util/containers/GArray.h>      // member template
+#include <util/containers/Array.h>       // member class template
+
+#include <complex>
+
+namespace McMd
+{
+
+   class Simulation;
+   class McSystem;
+
+   typedef std::complex<double> DCMPLX;
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Ewald Coulomb potential for MC simulations.
+   *
+   * This class stores the Fourier components rho(k) of the charge
+   * density for half of the wavevectors with |k| < kSpaceCutoff, as
+   * in MdEwaldPotential. The change in k-space energy produced by a
+   * trial move of one or several atoms is computed from the change
+   * in rho(k), which costs O(nWave) operations per moved atom, and
+   * rho(k) is updated in place when the move is accepted. The r-space
+   * energy of an atom is computed using the CellList of the parent
+   * McSystem, which must be built with cells at least as wide as the
+   * r-space cutoff.
+   *
+   * \ingroup McMd_Coulomb_Module
+   */
+   class McEwaldPotential : public McCoulombPotential
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param system  parent system.
+      */
+      McEwaldPotential(McSystem& system);
+
+      /**
+      * Destructor (does nothing).
+      */
+      virtual ~McEwaldPotential();
+
+      /// \name Initialization
+      //@{
+
+      /**
+      * Read parameters and initialize.
+      *
+      * \param in input stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      //@}
+      /// \name Parameters (get/set)
+      //@{
+
+      /**
+      * Set a parameter value, identified by a string.
+      *
+      * \param name   parameter name
+      * \param value  new value of parameter
+      */
+      void set(std::string name, double value);
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * \param name   parameter name
+      */
+      double get(std::string name) const;
+
+      /**
+      * Return the cutoff distance of the r-space pair interaction.
+      */
+      double rSpaceCutoff() const;
+
+      //@}
+      /// \name Waves and charge density
+      //@{
+
+      /**
+      * Generate wavevectors for the current boundary and kCutoff.
+      */
+      virtual void makeWaves();
+
+      /**
+      * Current number of wavevectors with |k| < kCutoff.
+      */
+      int nWave() const;
+
+      /**
+      * Calculate Fourier coefficients of charge density.
+      */
+      virtual void computeKSpaceCharge();
+
+      //@}
+      /// \name Trial moves
+      //@{
+
+      /**
+      * Discard any changes of charge density accumulated for a trial.
+      */
+      virtual void clearTrial();
+
+      /**
+      * Add the move of one atom to the current trial.
+      *
+      * \param atom  Atom that is moved
+      * \param oldPosition  position of atom before the trial move
+      * \param newPosition  position of atom after the trial move
+      */
+      virtual void addTrialMove(const Atom& atom,
+                                const Vector& oldPosition,
+                                const Vector& newPosition);
+
+      /**
+      * Return the change in k-space energy produced by the current trial.
+      */
+      virtual double trialEnergy();
+
+      /**
+      * Accept the current trial.
+      */
+      virtual void acceptTrial();
+
+      //@}
+      /// \name Energy
+      //@{
+
+      /**
+      * Return the short-range r-space Coulomb energy of one atom.
+      *
+      * \param atom Atom object of interest
+      */
+      virtual double rSpaceAtomEnergy(const Atom& atom) const;
+
+      /**
+      * Calculate the long range k-space part of Coulomb energy.
+      */
+      virtual void computeKSpaceEnergy();
+
+      /**
+      * Calculate the short range r-space part of Coulomb energy.
+      */
+      virtual void computeRSpaceEnergy();
+
+      //@}
+
+      /**
+      * Return the EwaldInteraction by reference.
+      */
+      EwaldInteraction& ewaldInteraction()
+      { return ewaldInteraction_; }
+
+   private:
+
+      // Ewald Interaction - core Ewald computations
+      EwaldInteraction ewaldInteraction_;
+
+      // Pointer to parent Simulation
+      Simulation* simulationPtr_;
+
+      // Pointer to parent System
+      McSystem* systemPtr_;
+
+      // Pointer to boundary of associated System.
+      Boundary* boundaryPtr_;
+
+      // Pointer to array of atom types
+      const Array<AtomType>* atomTypesPtr_;
+
+      /// Array to hold neighbors returned by the CellList.
+      mutable CellList::NeighborArray neighbors_;
+
+      /// Exponential factor accessors.
+      int  base0_, base1_, base2_;
+      int  upper0_, upper1_, upper2_;
+      GArray<DCMPLX> fexp0_;
+      GArray<DCMPLX> fexp1_;
+      GArray<DCMPLX> fexp2_;
+
+      /// Wave vector indices.
+      GArray<IntVector> intWaves_;
+
+      /// Regularized Green's function (Gaussian/ksq)
+      GArray<double> g_;
+
+      /// Fourier modes of charge density.
+      GArray<DCMPLX> rho_;
+
+      /// Change in Fourier modes of charge density in current trial.
+      GArray<DCMPLX> drho_;
+
+      /// Change in k-space energy in current trial.
+      double trialEnergy_;
+
+      /// cutoff distance in k space
+      double kSpaceCutoff_;
+
+      /// Does the current trial move any charged atom?
+      bool hasTrial_;
+
+      /*
+      * Add weight*exp(i k.r) to array[i] for all waves k.
+      *
+      * \param position  atomic position (Cartesian)
+      * \param weight  real prefactor (atomic charge)
+      * \param array  array of Fourier modes (modified)
+      */
+      void addPhases(const Vector& position, double weight,
+                     GArray<DCMPLX>& array);
+
+   };
+
+}
+#endif
@@ -8,6 +8,7 @@
 #include "MdSpmePotential.h" 
 #include <mcMd/simulation/System.h>
 #include <mcMd/simulation/Simulation.h>
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/chemistry/AtomType.h>
 
 #include <simp/boundary/Boundary.h>
@@ -17,6 +18,10 @@
 #include <util/math/Constants.h>
 #include <util/containers/Array.h>
 
+#ifdef MCMD_OPENMP
+#include <omp.h>
+#endif
+
 #include <stdlib.h>
 #include <cmath>
 
@@ -38,6 +43,7 @@ namespace McMd
       atomTypesPtr_(&system.simulation().atomTypes()),
       gridDimensions_(),
       rhoR_(),
+      rhoRThreads_(),
       rhoK_(),
       g_(),
       sqWaves_(),
@@ -294,7 +300,70 @@ namespace McMd
          makeWaves();
       }
 
-      System::MoleculeIterator molIter;
+      int nSpecies = simulationPtr_->nSpecies();
+      int nThread = systemPtr_->threadPool().nThread();
+      int iSpecies, iMol, nMol;
+
+      if (nThread == 1) {
+         setGridToZero(rhoR_);
+         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+            nMol = systemPtr_->nMolecule(iSpecies);
+            for (iMol = 0; iMol < nMol; ++iMol) {
+               assignCharges(systemPtr_->molecule(iSpecies, iMol), rhoR_);
+            }
+         }
+         return;
+      }
+
+      // Allocate a private grid for each thread, if necessary
+      int t;
+      if (rhoRThreads_.capacity() != nThread) {
+         if (rhoRThreads_.isAllocated()) {
+            rhoRThreads_.deallocate();
+         }
+         rhoRThreads_.allocate(nThread);
+         for (t = 0; t < nThread; ++t) {
+            rhoRThreads_[t].allocate(gridDimensions_);
+         }
+      }
+
+      // Thread t assigns block t of the molecules of each species
+      #ifdef MCMD_OPENMP
+      #pragma omp parallel for schedule(static, 1) num_threads(nThread)
+      #endif
+      for (t = 0; t < nThread; ++t) {
+         int is, im, beginMol, endMol;
+         setGridToZero(rhoRThreads_[t]);
+         for (is = 0; is < nSpecies; ++is) {
+            ThreadPool::partition(systemPtr_->nMolecule(is), nThread, t,
+                                  beginMol, endMol);
+            for (im = beginMol; im < endMol; ++im) {
+               assignCharges(systemPtr_->molecule(is, im), rhoRThreads_[t]);
+            }
+         }
+      }
+
+      // Sum private grids in order of thread index
+      int rank;
+      int nGrid = rhoR_.size();
+      #ifdef MCMD_OPENMP
+      #pragma omp parallel for schedule(static) num_threads(nThread)
+      #endif
+      for (rank = 0; rank < nGrid; ++rank) {
+         DCMPLX sum = rhoRThreads_[0][rank];
+         for (int i = 1; i < nThread; ++i) {
+            sum += rhoRThreads_[i][rank];
+         }
+         rhoR_[rank] = sum;
+      }
+   } 
+
+   /*
+   * Add charges of the atoms of one molecule to a grid.
+   */
+   void MdSpmePotential::assignCharges(Molecule& molecule,
+                                       GridArray<DCMPLX>& grid)
+   {
       Molecule::AtomIterator atomIter;
       Vector  gpos; //general coordination of atom
       double xdistance, ydistance, zdistance;  // distance from atom to node
@@ -304,56 +373,47 @@ namespace McMd
       int ximg, yimg, zimg; // grid point coordinates
       int xknot, yknot, zknot;
 
-      setGridToZero(rhoR_);
-
-      // Loop over atoms.
-      int  nSpecies = simulationPtr_->nSpecies();
-      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
-         systemPtr_->begin(iSpecies, molIter);
-         for ( ; molIter.notEnd(); ++molIter) {
-            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
-               charge = (*atomTypesPtr_)[atomIter->typeId()].charge();
-
-               // Compute generalized position with components in [0,1]
-               boundaryPtr_->transformCartToGen(atomIter->position(), gpos);
-               boundaryPtr_->shiftGen(gpos);
-
-               // Find the floor grid point.
-               floorGridIdx[0]=floor(gpos[0]*gridDimensions_[0]);
-               floorGridIdx[1]=floor(gpos[1]*gridDimensions_[1]);
-               floorGridIdx[2]=floor(gpos[2]*gridDimensions_[2]);
-
-               // Have not incorporated reciprocal vector * lattice vector 
-               // for other lattice. Need to modify the expression of  distance.
-
-               for (int x = 0 ; x < order_ ; ++x) {
-                  ximg = floorGridIdx[0] + x - (order_ - 1);
-                  xdistance = (gpos[0]*gridDimensions_[0]-ximg);
-                  xknot = ximg < 0 ? ximg + gridDimensions_[0] : ximg;
-                  knot[0] = xknot;
-
-                  for (int y = 0 ; y < order_ ; ++y) {
-                     yimg = floorGridIdx[1] + y - (order_ - 1);
-                     ydistance = (gpos[1]*gridDimensions_[1]-yimg) ;
-                     yknot =  yimg < 0 ? yimg + gridDimensions_[1] : yimg;
-                     knot[1] = yknot;
-
-                     for (int z = 0; z < order_; ++z) {
-                        zimg = floorGridIdx[2] + z - (order_ - 1);
-                        zdistance = (gpos[2]*gridDimensions_[2]-zimg) ;
-                        zknot =  zimg < 0 ? zimg + gridDimensions_[2] : zimg;
-                        knot[2] = zknot;
-
-                        rhoR_(knot) += charge 
-                                      * basisSpline(xdistance)
-                                      * basisSpline(ydistance)
-                                      * basisSpline(zdistance);
-                     } //loop z
-                  } //loop y
-               } //loop x
-            } //loop atom
-         } //loop molecule
-      } //loop over species
+      for (molecule.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         charge = (*atomTypesPtr_)[atomIter->typeId()].charge();
+
+         // Compute generalized position with components in [0,1]
+         boundaryPtr_->transformCartToGen(atomIter->position(), gpos);
+         boundaryPtr_->shiftGen(gpos);
+
+         // Find the floor grid point.
+         floorGridIdx[0]=floor(gpos[0]*gridDimensions_[0]);
+         floorGridIdx[1]=floor(gpos[1]*gridDimensions_[1]);
+         floorGridIdx[2]=floor(gpos[2]*gridDimensions_[2]);
+
+         // Have not incorporated reciprocal vector * lattice vector 
+         // for other lattice. Need to modify the expression of  distance.
+
+         for (int x = 0 ; x < order_ ; ++x) {
+            ximg = floorGridIdx[0] + x - (order_ - 1);
+            xdistance = (gpos[0]*gridDimensions_[0]-ximg);
+            xknot = ximg < 0 ? ximg + gridDimensions_[0] : ximg;
+            knot[0] = xknot;
+
+            for (int y = 0 ; y < order_ ; ++y) {
+               yimg = floorGridIdx[1] + y - (order_ - 1);
+               ydistance = (gpos[1]*gridDimensions_[1]-yimg) ;
+               yknot =  yimg < 0 ? yimg + gridDimensions_[1] : yimg;
+               knot[1] = yknot;
+
+               for (int z = 0; z < order_; ++z) {
+                  zimg = floorGridIdx[2] + z - (order_ - 1);
+                  zdistance = (gpos[2]*gridDimensions_[2]-zimg) ;
+                  zknot =  zimg < 0 ? zimg + gridDimensions_[2] : zimg;
+                  knot[2] = zknot;
+
+                  grid(knot) += charge 
+                                * basisSpline(xdistance)
+                                * basisSpline(ydistance)
+                                * basisSpline(zdistance);
+               } //loop z
+            } //loop y
+         } //loop x
+      } //loop atom
    } 
  
    /*
@@ -399,25 +459,30 @@ namespace McMd
       fftw_execute(yfield_backward_plan);
       fftw_execute(zfield_backward_plan);
 
-      System::MoleculeIterator molIter;
-      Molecule::AtomIterator atomIter;
-      Vector fatom(0.0);
-      Vector floorGridIdx, gpos;
-      IntVector m;
-      IntVector knot;
-      double xdistance, ydistance, zdistance; // b-spline 
       double  EPS = 1.0E-10;  // Tiny number to check if is charged
-      double charge;  
-      int type;
-      int ximg, yimg, zimg;
-      int xknot, yknot, zknot;
+      int nThread = systemPtr_->threadPool().nThread();
+      int iMol, nMol;
 
-      // Loop over species, molecules atoms
+      // Loop over species, molecules atoms. Each thread updates forces
+      // only of atoms in its own molecules.
       int  nSpecies(simulationPtr_->nSpecies());
       for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
-         systemPtr_->begin(iSpecies, molIter); 
-         for ( ; molIter.notEnd(); ++molIter) {
-            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         nMol = systemPtr_->nMolecule(iSpecies);
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(static) num_threads(nThread)
+         #endif
+         for (iMol = 0; iMol < nMol; ++iMol) {
+            Molecule& molecule = systemPtr_->molecule(iSpecies, iMol);
+            Molecule::AtomIterator atomIter;
+            Vector fatom(0.0);
+            Vector floorGridIdx, gpos;
+            IntVector knot;
+            double xdistance, ydistance, zdistance; // b-spline 
+            double charge;  
+            int type;
+            int ximg, yimg, zimg;
+            int xknot, yknot, zknot;
+            for (molecule.begin(atomIter); atomIter.notEnd(); ++atomIter) {
                type = atomIter->typeId();
                charge = (*atomTypesPtr_)[type].charge();
 
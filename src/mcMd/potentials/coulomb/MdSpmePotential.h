@@ -21,6 +21,7 @@
 #include <util/containers/Pair.h>        // member template parameter
 #include <util/containers/GArray.h>      // member template
 #include <util/containers/GridArray.h>   // member template
+#include <util/containers/DArray.h>      // member template
 #include <util/misc/Setable.h>           // member template
 #include <util/containers/Array.h>       // member class template
 
@@ -32,6 +33,7 @@ namespace McMd
 
    class Simulation;
    class System;
+   class Molecule;
 
    typedef std::complex<double> DCMPLX;
 
@@ -44,6 +46,12 @@ namespace McMd
    * This class implements the smooth particle mesh ewald k-space
    * computations for the Coulomb energy and forces.
    *
+   * If the ThreadPool of the parent System has more than one thread,
+   * charges are assigned by all threads, each of which assigns the
+   * charges of a block of molecules to a private grid, and forces are
+   * interpolated by all threads. Private grids are summed in order of
+   * thread index, so results do not depend on scheduling.
+   *
    * \ingroup McMd_Coulomb_Module
    */
    class MdSpmePotential : public MdCoulombPotential
@@ -168,6 +176,9 @@ namespace McMd
       /// Charge density assigned to r-space grid
       GridArray<DCMPLX> rhoR_;
 
+      /// Charge density assigned by each thread (if more than one)
+      DArray< GridArray<DCMPLX> > rhoRThreads_;
+
       /// DFT of charge density on k-space grid
       GridArray<DCMPLX> rhoK_;
 
@@ -224,6 +235,14 @@ namespace McMd
       */
       void assignCharges();
 
+      /**
+      * Add charges of all atoms of one molecule to a grid.
+      *
+      * \param molecule  Molecule whose charges are assigned
+      * \param grid  charge density grid (modified)
+      */
+      void assignCharges(Molecule& molecule, GridArray<DCMPLX>& grid);
+
       /**
       * Expression for basis spline with order-5.
       */
@@ -2,6 +2,8 @@ mcMd_potentials_coulomb_=\
    mcMd/potentials/coulomb/CoulombFactory.cpp  \
    mcMd/potentials/coulomb/MdCoulombPotential.cpp \
    mcMd/potentials/coulomb/MdEwaldPotential.cpp \
+   mcMd/potentials/coulomb/McCoulombPotential.cpp \
+   mcMd/potentials/coulomb/McEwaldPotential.cpp \
    mcMd/potentials/coulomb/EwaldRSpaceAccumulator.cpp 
 
 ifdef SIMP_FFTW
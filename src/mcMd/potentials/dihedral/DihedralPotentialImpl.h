@@ -196,6 +196,7 @@ namespace McMd
 
 #include <mcMd/simulation/System.h> 
 #include <mcMd/simulation/Simulation.h> 
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/simulation/stress.h>
 #include <mcMd/chemistry/getAtomGroups.h>
 #include <simp/boundary/Boundary.h> 
@@ -372,16 +373,23 @@ namespace McMd
    template <class Interaction>
    void DihedralPotentialImpl<Interaction>::addForces() 
    {
-      Vector dr1, dr2, dr3, force1, force2, force3;
-      Atom *atom0Ptr, *atom1Ptr, *atom2Ptr, *atom3Ptr;
-      int iSpec;
+      int nThread = system().threadPool().nThread();
+      int iSpec, iMol, nMol;
 
-      System::MoleculeIterator molIter;
-      Molecule::DihedralIterator dihedralIter;
+      // Dihedrals are intramolecular, so molecules may be given to
+      // different threads (see BondPotentialImpl::addForces).
       for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
          if (simulation().species(iSpec).nDihedral() > 0) {
-            for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-               molIter->begin(dihedralIter); 
+            nMol = nMolecule(iSpec);
+            #ifdef MCMD_OPENMP
+            #pragma omp parallel for schedule(static) num_threads(nThread)
+            #endif
+            for (iMol = 0; iMol < nMol; ++iMol) {
+               Molecule& molecule = system().molecule(iSpec, iMol);
+               Molecule::DihedralIterator dihedralIter;
+               Vector dr1, dr2, dr3, force1, force2, force3;
+               Atom *atom0Ptr, *atom1Ptr, *atom2Ptr, *atom3Ptr;
+               molecule.begin(dihedralIter); 
                for ( ; dihedralIter.notEnd(); ++dihedralIter) {
 
                   atom0Ptr = &(dihedralIter->atom(0));
@@ -150,6 +150,7 @@ namespace McMd
 
 #include <mcMd/simulation/System.h>
 #include <mcMd/simulation/Simulation.h>
+#include <mcMd/simulation/ThreadPool.h>
 
 #include <simp/species/Species.h>
 #include <simp/boundary/Boundary.h>
@@ -262,12 +263,18 @@ namespace McMd
    template <class Interaction>
    void ExternalPotentialImpl<Interaction>::addForces()
    {
-      Vector  force;
-      System::MoleculeIterator molIter;
-      Molecule::AtomIterator   atomIter;
-      for (int iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
-         for (begin(iSpec, molIter); molIter.notEnd(); ++molIter) {
-            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+      int nThread = system().threadPool().nThread();
+      int iSpec, iMol, nMol;
+      for (iSpec=0; iSpec < simulation().nSpecies(); ++iSpec) {
+         nMol = nMolecule(iSpec);
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(static) num_threads(nThread)
+         #endif
+         for (iMol = 0; iMol < nMol; ++iMol) {
+            Molecule& molecule = system().molecule(iSpec, iMol);
+            Molecule::AtomIterator atomIter;
+            Vector force;
+            for (molecule.begin(atomIter); atomIter.notEnd(); ++atomIter) {
                interaction().getForce(atomIter->position(),
                                             atomIter->typeId(), force);
                atomIter->force() += force;
@@ -26,7 +26,9 @@ namespace McMd
    */
    McPairPotential::McPairPotential(System& system)
     : ParamComposite(),
-      SystemInterface(system)
+      SystemInterface(system),
+      minCellCutoff_(0.0),
+      hasPackedCells_(false)
    {  setClassName("McPairPotential"); }
  
    /* 
@@ -41,7 +43,14 @@ namespace McMd
    void McPairPotential::buildCellList() 
    {
       // Set up a grid of empty cells.
-      cellList_.setup(boundary(), maxPairCutoff());
+      double cutoff = maxPairCutoff();
+      if (minCellCutoff_ > cutoff) {
+         cutoff = minCellCutoff_;
+      }
+      cellList_.setup(boundary(), cutoff);
+      if (hasPackedCells_) {
+         packedCells_.setup(boundary(), cutoff);
+      }
 
       // Add all atoms to cellList_ 
       System::MoleculeIterator molIter;
@@ -51,10 +60,22 @@ namespace McMd
             for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
                boundary().shift(atomIter->position());
                cellList_.addAtom(*atomIter);
+               if (hasPackedCells_) {
+                  packedCells_.addAtom(*atomIter);
+               }
             }
          }
       }
 
    }
 
+   /*
+   * Set a lower bound on the width of cells.
+   */
+   void McPairPotential::setMinCellCutoff(double minCellCutoff)
+   {
+      UTIL_CHECK(minCellCutoff >= 0.0);
+      minCellCutoff_ = minCellCutoff;
+   }
+
 }
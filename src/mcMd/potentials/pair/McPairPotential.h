@@ -12,6 +12,9 @@
 #include <mcMd/simulation/SystemInterface.h>       // base class
 #include <mcMd/potentials/pair/PairPotential.h>    // base class
 #include <mcMd/neighbor/CellList.h>                // member
+#include <mcMd/neighbor/PackedCellList.h>          // member
+#include <util/containers/GArray.h>                // member template
+#include <util/space/Vector.h>                     // template argument
 
 #include <util/global.h>
 
@@ -33,6 +36,11 @@ namespace McMd
 
    public:
 
+      /**
+      * Array to hold the pair energies of an atom with its neighbors.
+      */
+      typedef FSArray<double, CellList::MaxNeighbor> NeighborEnergyArray;
+
       /**   
       * Constructor.
       */
@@ -54,6 +62,41 @@ namespace McMd
       */
       virtual double atomEnergy(const Atom& atom) const = 0;
 
+      /**
+      * Calculate the nonbonded pair energy for one Atom, using a 
+      * caller supplied array to hold neighbors.
+      *
+      * Unlike atomEnergy(const Atom&), this function modifies no
+      * member of the potential, and so may be called concurrently 
+      * from several threads, each with its own neighbors array.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors work array for neighbors of atom
+      * \return nonbonded pair potential energy of atom
+      */
+      virtual double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors) 
+      const = 0;
+
+      /**
+      * Calculate the nonbonded pair energy for one Atom, and each of
+      * its pair interactions.
+      *
+      * Upon return, neighbors contains pointers to all atoms in the cell
+      * containing the atom and in neighboring cells, and energies[j] is 
+      * the pair energy of the atom with neighbors[j], which is zero for 
+      * the atom itself and for masked pairs. Like the two parameter 
+      * version, this function modifies no member of the potential.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors (output) neighbors of atom
+      * \param  energies (output) pair energy with each neighbor
+      * \return nonbonded pair potential energy of atom
+      */
+      virtual double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors,
+                 NeighborEnergyArray& energies) const = 0;
+
       /**
       * Calculate the nonbonded pair energy for an entire Molecule.
       *
@@ -68,6 +111,29 @@ namespace McMd
       */
       virtual double moleculeEnergy(const Molecule& molecule) const = 0;
 
+      /**
+      * Calculate nonbonded pair energies of one Atom at trial positions.
+      *
+      * Upon return, energies[i] is the pair energy that the atom would 
+      * have at positions[i], for 0 <= i < nTrial, with all other atoms
+      * at their current positions. The atom itself is excluded, so the
+      * atom may or may not be in the cell list. The position of the atom
+      * is not modified. Each position must lie within the primary cell.
+      *
+      * Neighbors are gathered and packed once for each distinct cell 
+      * that contains one or more trial positions, and then used for all
+      * trial positions in that cell. This is faster than nTrial calls 
+      * to atomEnergy() in configuration bias moves, in which trials are
+      * clustered about a common anchor atom.
+      *
+      * \param  atom Atom object of interest
+      * \param  positions array of nTrial trial positions
+      * \param  nTrial number of trial positions
+      * \param  energies (output) pair energy at each trial position
+      */
+      virtual void trialEnergies(const Atom& atom, const Vector* positions,
+                                 int nTrial, double* energies) const = 0;
+
       //@}
       /// \name Cell List Management
       //@{
@@ -78,10 +144,24 @@ namespace McMd
       * Calls CellList::clear() to clear the CellList,
       * then adds every Atom in this System. Each Atom
       * position is shifted into the primary box by
-      * Boundary::shift() before being added.
+      * Boundary::shift() before being added. Also builds
+      * the PackedCellList, if any.
       */
       void buildCellList();
 
+      /**
+      * Set a lower bound on the width of cells in the CellList.
+      *
+      * The CellList is built with cells no narrower than the larger of
+      * maxPairCutoff() and this value, so that it can also be used to
+      * find neighbors for other short range interactions, such as the
+      * r-space part of a Coulomb potential. Takes effect in the next
+      * call to buildCellList().
+      *
+      * \param minCellCutoff  minimum cell width (default 0)
+      */
+      void setMinCellCutoff(double minCellCutoff);
+
       /**
       * Add an Atom to the CellList.
       *
@@ -106,6 +186,17 @@ namespace McMd
       */
       void updateAtomCell(Atom &atom);
 
+      /**
+      * Record a new type id for an Atom in the cell list.
+      *
+      * This must be called after changing the type id of an atom
+      * that is in the cell list, before computing any energy. It
+      * does nothing unless packed cells are enabled.
+      *
+      * \param atom Atom object whose type id has been modified.
+      */
+      void updateAtomType(Atom &atom);
+
       /**
       * Move an Atom position, and update the CellList.
       *
@@ -123,6 +214,16 @@ namespace McMd
       */
       const CellList& cellList() const;
 
+      /**
+      * Is a PackedCellList maintained, and used for atomic energies?
+      */
+      bool hasPackedCells() const;
+
+      /** 
+      * Get the PackedCellList by const reference.
+      */
+      const PackedCellList& packedCells() const;
+
       //@}
 
    protected:
@@ -130,35 +231,75 @@ namespace McMd
       /// Array to hold neighbors returned by a CellList.
       mutable CellList::NeighborArray neighbors_;
 
+      /// Positions of unmasked neighbors, packed by trialEnergies().
+      mutable GArray<Vector> packedPositions_;
+
+      /// Type ids of unmasked neighbors, packed by trialEnergies().
+      mutable GArray<int> packedTypeIds_;
+
+      /// Cell index of each trial position in trialEnergies().
+      mutable GArray<int> trialCellIds_;
+
       /// Cell list for atom positions.
       CellList cellList_;
 
+      /// Packed cell list, used only if hasPackedCells_ is true.
+      PackedCellList packedCells_;
+
+      /// Lower bound on the width of cells, set by setMinCellCutoff.
+      double minCellCutoff_;
+
+      /// Is packedCells_ maintained and used for atomic energies?
+      bool hasPackedCells_;
+
    };
 
    // Inline functions
   
    // Add an atom to CellList.
    inline void McPairPotential::addAtom(Atom &atom)
-   {  cellList_.addAtom(atom); }
+   {
+      cellList_.addAtom(atom); 
+      if (hasPackedCells_) packedCells_.addAtom(atom);
+   }
 
    // Delete an atom from the CellList.
    inline void McPairPotential::deleteAtom(Atom &atom)
-   {  cellList_.deleteAtom(atom); }
+   {
+      cellList_.deleteAtom(atom); 
+      if (hasPackedCells_) packedCells_.deleteAtom(atom);
+   }
 
    // Update the cell list to reflect a new Atom position.
    inline void McPairPotential::updateAtomCell(Atom &atom)
-   {  cellList_.updateAtomCell(atom, atom.position()); }
+   {
+      cellList_.updateAtomCell(atom, atom.position()); 
+      if (hasPackedCells_) packedCells_.updateAtom(atom);
+   }
+
+   // Record a new Atom type id.
+   inline void McPairPotential::updateAtomType(Atom &atom)
+   {  if (hasPackedCells_) packedCells_.updateAtom(atom); }
 
    // Move atom to a new position.
    inline void McPairPotential::moveAtom(Atom &atom, const Vector &position)
    {
       atom.position() = position;
       cellList_.updateAtomCell(atom, position);
+      if (hasPackedCells_) packedCells_.updateAtom(atom);
    }
 
    // Get the cellList by const reference.
    inline const CellList& McPairPotential::cellList() const
    { return cellList_; }
 
+   // Are packed cells enabled?
+   inline bool McPairPotential::hasPackedCells() const
+   { return hasPackedCells_; }
+
+   // Get the PackedCellList by const reference.
+   inline const PackedCellList& McPairPotential::packedCells() const
+   { return packedCells_; }
+
 } 
 #endif
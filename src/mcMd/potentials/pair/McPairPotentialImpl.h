@@ -135,6 +135,28 @@ namespace McMd
       */
       double atomEnergy(const Atom& atom) const;
 
+      /**
+      * Calculate the nonbonded pair energy for one Atom, thread-safely.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors work array for neighbors of atom
+      * \return nonbonded pair potential energy of atom
+      */
+      double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors) const;
+
+      /**
+      * Calculate the nonbonded pair energy for one Atom, and each term.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors (output) neighbors of atom
+      * \param  energies (output) pair energy with each neighbor
+      * \return nonbonded pair potential energy of atom
+      */
+      double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors,
+                 NeighborEnergyArray& energies) const;
+
       /**
       * Calculate the nonbonded pair energy for an entire Molecule.
       *
@@ -143,6 +165,17 @@ namespace McMd
       */
       double moleculeEnergy(const Molecule& molecule) const;
 
+      /**
+      * Calculate nonbonded pair energies of one Atom at trial positions.
+      *
+      * \param  atom Atom object of interest
+      * \param  positions array of nTrial trial positions
+      * \param  nTrial number of trial positions
+      * \param  energies (output) pair energy at each trial position
+      */
+      void trialEnergies(const Atom& atom, const Vector* positions,
+                         int nTrial, double* energies) const;
+
       /**
       * Compute and store nonbonded pair energy of this System.
       *
@@ -160,12 +193,44 @@ namespace McMd
       //@}
 
    private:
+
+      /*
+      * Function object that accumulates the pair energy of one atom
+      * with atoms of the cells visited by PackedCellList::visitNeighbors.
+      */
+      class EnergyVisitor
+      {
+      public:
+
+         EnergyVisitor(const Interaction& interaction, 
+                       const Boundary& boundary,
+                       const Atom& atom, const Vector& position);
+
+         void operator () (const Vector* positions, const int* typeIds,
+                           Atom* const * atomPtrs, int n);
+
+         double energy;
+
+      private:
+
+         const Interaction* interactionPtr_;
+         const Boundary* boundaryPtr_;
+         const Atom* atomPtr_;
+         const Vector* positionPtr_;
+         int typeId_;
+
+      };
  
       /**
       * Pair interaction object (e.g., Interaction == LJPair)
       */ 
       Interaction interaction_;
 
+      /*
+      * Pair energy of an atom at a position, using the PackedCellList.
+      */
+      double packedEnergy(const Atom& atom, const Vector& position) const;
+
       /**
       * Generalized stress computation, for variable type T.
       *
@@ -230,6 +295,13 @@ namespace McMd
 
       // Set atom capacity and allocate memory in the CellList.
       cellList_.setAtomCapacity(simulation().atomCapacity());
+
+      // Optionally, also maintain a PackedCellList.
+      hasPackedCells_ = false;
+      readOptional<bool>(in, "packedCells", hasPackedCells_);
+      if (hasPackedCells_) {
+         packedCells_.setAtomCapacity(simulation().atomCapacity());
+      }
    }
 
    /*
@@ -248,6 +320,12 @@ namespace McMd
 
       // Allocate memory for the CellList.
       cellList_.setAtomCapacity(simulation().atomCapacity());
+
+      hasPackedCells_ = false;
+      loadParameter<bool>(ar, "packedCells", hasPackedCells_, false);
+      if (hasPackedCells_) {
+         packedCells_.setAtomCapacity(simulation().atomCapacity());
+      }
    }
 
    /*
@@ -257,6 +335,7 @@ namespace McMd
    void McPairPotentialImpl<Interaction>::save(Serializable::OArchive &ar)
    {
       interaction().save(ar);
+      Parameter::saveOptional(ar, hasPackedCells_, hasPackedCells_);
    }
 
    /*
@@ -295,6 +374,21 @@ namespace McMd
    */
    template <class Interaction>
    double McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom) const
+   {
+      if (hasPackedCells_) {
+         return packedEnergy(atom, atom.position());
+      } else {
+         return atomEnergy(atom, neighbors_); 
+      }
+   }
+
+   /* 
+   * Return nonbonded pair energy for one Atom, using a work array.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom, 
+                                   CellList::NeighborArray& neighbors) const
    {
       Atom   *jAtomPtr;
       double  energy;
@@ -303,13 +397,13 @@ namespace McMd
       int     id = atom.id();
 
       // Get array of neighbors
-      cellList_.getNeighbors(atom.position(), neighbors_);
-      nNeighbor = neighbors_.size();
+      cellList_.getNeighbors(atom.position(), neighbors);
+      nNeighbor = neighbors.size();
 
       // Loop over neighboring atoms
       energy = 0.0;
       for (j = 0; j < nNeighbor; ++j) {
-         jAtomPtr = neighbors_[j];
+         jAtomPtr = neighbors[j];
          jId      = jAtomPtr->id();
 
          // Check if atoms are the same
@@ -327,6 +421,164 @@ namespace McMd
       return energy;
    }
 
+   /* 
+   * Return nonbonded pair energy for one Atom, and each pair term.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom, 
+                                   CellList::NeighborArray& neighbors,
+                                   NeighborEnergyArray& energies) const
+   {
+      Atom   *jAtomPtr;
+      double  energy, pairEnergy;
+      double  rsq;
+      int     j, nNeighbor;
+      int     id = atom.id();
+
+      // Get array of neighbors
+      cellList_.getNeighbors(atom.position(), neighbors);
+      nNeighbor = neighbors.size();
+      energies.clear();
+
+      // Loop over neighboring atoms
+      energy = 0.0;
+      for (j = 0; j < nNeighbor; ++j) {
+         jAtomPtr = neighbors[j];
+         pairEnergy = 0.0;
+         if (jAtomPtr->id() != id) {
+            if (!atom.mask().isMasked(*jAtomPtr)) {
+               rsq = boundary().
+                     distanceSq(atom.position(), jAtomPtr->position());
+               pairEnergy = interaction().
+                            energy(rsq, atom.typeId(), jAtomPtr->typeId());
+            }
+         }
+         energies.append(pairEnergy);
+         energy += pairEnergy;
+      } 
+      return energy;
+   }
+
+   /* 
+   * Compute nonbonded pair energies of one Atom at trial positions.
+   */
+   template <class Interaction>
+   void
+   McPairPotentialImpl<Interaction>::trialEnergies(const Atom& atom, 
+                                                   const Vector* positions,
+                                                   int nTrial, 
+                                                   double* energies) const
+   {
+      const Atom* jAtomPtr;
+      double energy, rsq;
+      int    i, j, k, cellId, nNeighbor, nPacked;
+      int    id = atom.id();
+      int    typeId = atom.typeId();
+
+      // With packed cells, neighbors are already packed by cell
+      if (hasPackedCells_) {
+         for (i = 0; i < nTrial; ++i) {
+            energies[i] = packedEnergy(atom, positions[i]);
+         }
+         return;
+      }
+
+      // Identify the cell containing each trial position
+      trialCellIds_.clear();
+      for (i = 0; i < nTrial; ++i) {
+         trialCellIds_.append(cellList_.cellIndexFromPosition(positions[i]));
+      }
+
+      for (i = 0; i < nTrial; ++i) {
+         cellId = trialCellIds_[i];
+
+         // Skip trials in cells that were already treated
+         for (k = 0; k < i; ++k) {
+            if (trialCellIds_[k] == cellId) break;
+         }
+         if (k < i) continue;
+
+         // Pack positions and types of unmasked neighbors of this cell
+         cellList_.getNeighbors(positions[i], neighbors_);
+         nNeighbor = neighbors_.size();
+         packedPositions_.clear();
+         packedTypeIds_.clear();
+         for (j = 0; j < nNeighbor; ++j) {
+            jAtomPtr = neighbors_[j];
+            if (jAtomPtr->id() != id) {
+               if (!atom.mask().isMasked(*jAtomPtr)) {
+                  packedPositions_.append(jAtomPtr->position());
+                  packedTypeIds_.append(jAtomPtr->typeId());
+               }
+            }
+         }
+         nPacked = packedPositions_.size();
+
+         // Evaluate all trial positions in this cell
+         for (k = i; k < nTrial; ++k) {
+            if (trialCellIds_[k] != cellId) continue;
+            energy = 0.0;
+            for (j = 0; j < nPacked; ++j) {
+               rsq = boundary().distanceSq(positions[k], packedPositions_[j]);
+               energy += interaction().energy(rsq, typeId, packedTypeIds_[j]);
+            }
+            energies[k] = energy;
+         }
+      }
+   }
+
+   /* 
+   * Return pair energy of an atom at a position, using packed cells.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::packedEnergy(const Atom& atom, 
+                                                  const Vector& position) 
+   const
+   {
+      EnergyVisitor visitor(interaction(), boundary(), atom, position);
+      packedCells_.visitNeighbors(position, visitor);
+      return visitor.energy;
+   }
+
+   /* 
+   * Constructor.
+   */
+   template <class Interaction>
+   McPairPotentialImpl<Interaction>::EnergyVisitor::EnergyVisitor(
+                                           const Interaction& interaction, 
+                                           const Boundary& boundary,
+                                           const Atom& atom, 
+                                           const Vector& position)
+    : energy(0.0),
+      interactionPtr_(&interaction),
+      boundaryPtr_(&boundary),
+      atomPtr_(&atom),
+      positionPtr_(&position),
+      typeId_(atom.typeId())
+   {}
+
+   /* 
+   * Add pair energies with the unmasked atoms of one cell.
+   */
+   template <class Interaction>
+   inline void
+   McPairPotentialImpl<Interaction>::EnergyVisitor::operator () 
+                       (const Vector* positions, const int* typeIds,
+                        Atom* const * atomPtrs, int n)
+   {
+      double rsq;
+      for (int j = 0; j < n; ++j) {
+         if (atomPtrs[j] != atomPtr_) {
+            if (!atomPtr_->mask().isMasked(*atomPtrs[j])) {
+               rsq = boundaryPtr_->distanceSq(*positionPtr_, positions[j]);
+               energy += interactionPtr_->energy(rsq, typeId_, typeIds[j]);
+            }
+         }
+      }
+   }
+
    /* 
    * Return nonbonded pair potential energy for one Molecule.
    */
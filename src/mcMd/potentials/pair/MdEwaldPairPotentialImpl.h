@@ -191,11 +191,16 @@ namespace McMd
       const AtomType& atomType(int i)
       {  return (*atomTypesPtr_)[i]; }
 
+      // Add both types of force for a range of pairs to a force array.
+      virtual
+      void addPairForces(int beginPair, int endPair, Vector* forces);
+
    };
 }
 
 #include <mcMd/simulation/System.h>
 #include <mcMd/simulation/Simulation.h>
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <mcMd/simulation/stress.h>
 #include <mcMd/neighbor/PairIterator.h>
@@ -382,6 +387,12 @@ namespace McMd
          buildPairList();
       }
 
+      // Divide the pair list among threads, if more than one
+      if (system().threadPool().nThread() > 1) {
+         addForcesThreaded();
+         return;
+      }
+
       PairIterator iter;
       Vector force;
       double forceOverR;
@@ -415,6 +426,47 @@ namespace McMd
 
    }
 
+   /*
+   * Add both types of pair force for a range of pairs to a force array.
+   */
+   template <class Interaction>
+   void
+   MdEwaldPairPotentialImpl<Interaction>::addPairForces(int beginPair,
+                                                        int endPair,
+                                                        Vector* forces)
+   {
+      PairIterator iter;
+      Vector force;
+      double forceOverR;
+      double rsq;
+      double qProduct;
+      double ewaldCutoffSq = ewaldInteractionPtr_->rSpaceCutoffSq();
+      Atom *atom0Ptr;
+      Atom *atom1Ptr;
+      int type0, type1;
+
+      pairList_.begin(iter, beginPair, endPair);
+      for ( ; iter.notEnd(); ++iter) {
+         iter.getPair(atom0Ptr, atom1Ptr);
+         rsq = boundary().
+               distanceSq(atom0Ptr->position(), atom1Ptr->position(),
+                          force);
+         if (rsq < ewaldCutoffSq) {
+            type0 = atom0Ptr->typeId();
+            type1 = atom1Ptr->typeId();
+            qProduct = (*atomTypesPtr_)[type0].charge();
+            qProduct *= (*atomTypesPtr_)[type1].charge();
+            forceOverR = ewaldInteractionPtr_->rSpaceForceOverR(rsq, qProduct);
+            if (rsq < pairPtr_->cutoffSq(type0, type1)) {
+               forceOverR += pairPtr_->forceOverR(rsq, type0, type1);
+            }
+            force *= forceOverR;
+            forces[atom0Ptr->id()] += force;
+            forces[atom1Ptr->id()] -= force;
+         }
+      }
+   }
+
    /*
    * Unset both energy accumulators.
    */
@@ -8,9 +8,14 @@
 #include "MdPairPotential.h"
 #include <mcMd/simulation/System.h> 
 #include <mcMd/simulation/Simulation.h> 
+#include <mcMd/simulation/ThreadPool.h> 
 #include <simp/boundary/Boundary.h> 
 #include <util/global.h> 
 
+#ifdef MCMD_OPENMP
+#include <omp.h>
+#endif
+
 #include <fstream>
 
 namespace McMd
@@ -67,6 +72,72 @@ namespace McMd
       pairList_.build(boundary());
    }
 
+   /* 
+   * Add pair forces to atomic forces, using all threads of the System.
+   */ 
+   void MdPairPotential::addForcesThreaded()
+   {
+      ThreadPool& pool = system().threadPool();
+      int nThread = pool.nThread();
+      int nPair = pairList_.nPair();
+      pool.allocateForces(simulation().atomCapacity());
+
+      // Exceptions may not leave a parallel region, and so are
+      // recorded and re-thrown after it.
+      bool hasError = false;
+      int i;
+      if (pool.isDeterministic()) {
+
+         // One range of pairs per force array, independent of scheduling
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(static, 1) num_threads(nThread)
+         #endif
+         for (i = 0; i < nThread; ++i) {
+            int beginPair, endPair;
+            ThreadPool::partition(nPair, nThread, i, beginPair, endPair);
+            try {
+               addPairForces(beginPair, endPair, pool.forces(i));
+            } catch (...) {
+               #ifdef MCMD_OPENMP
+               #pragma omp critical
+               #endif
+               hasError = true;
+            }
+         }
+
+      } else {
+
+         // Smaller ranges, handed out to whichever thread is idle
+         int nRange = 4*nThread;
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(dynamic, 1) num_threads(nThread)
+         #endif
+         for (i = 0; i < nRange; ++i) {
+            int beginPair, endPair;
+            ThreadPool::partition(nPair, nRange, i, beginPair, endPair);
+            try {
+               #ifdef MCMD_OPENMP
+               addPairForces(beginPair, endPair,
+                             pool.forces(omp_get_thread_num()));
+               #else
+               addPairForces(beginPair, endPair, pool.forces(0));
+               #endif
+            } catch (...) {
+               #ifdef MCMD_OPENMP
+               #pragma omp critical
+               #endif
+               hasError = true;
+            }
+         }
+
+      }
+      if (hasError) {
+         UTIL_THROW("Exception in threaded pair force calculation");
+      }
+
+      pool.reduceForces(system());
+   }
+
    /* 
    * Clear the PairList statistical accumulators
    */ 
@@ -98,6 +98,26 @@ namespace McMd
       /// Verlet neighbor pair list for nonbonded interactions.
       PairList pairList_;
 
+      /**
+      * Add forces for a contiguous range of pairs to a force array.
+      *
+      * \param beginPair  index of first pair in the PairList
+      * \param endPair  index one past the last pair
+      * \param forces  array of forces, indexed by atom id (modified)
+      */
+      virtual
+      void addPairForces(int beginPair, int endPair, Vector* forces) = 0;
+
+      /**
+      * Add pair forces to atomic forces using all threads of the System.
+      *
+      * Divides the PairList into ranges of pairs, calls addPairForces()
+      * for each range with a per-thread force array of the ThreadPool of
+      * the parent System, and then adds per-thread forces to atomic
+      * forces. The PairList must be current.
+      */
+      void addForcesThreaded();
+
    };
 
    // Inline functions
@@ -145,7 +145,9 @@ namespace McMd
       * Adds non-bonded pair forces to the current values of the
       * forces for all atoms in this system. Before calculating
       * forces, the method checks if the pair list is current,
-      * and rebuilds it if necessary.
+      * and rebuilds it if necessary. If the ThreadPool of the
+      * System has more than one thread, the pair list is divided
+      * among threads by MdPairPotential::addForcesThreaded().
       */
       virtual void addForces();
 
@@ -168,6 +170,16 @@ namespace McMd
       Interaction& interaction() const
       {  return *interactionPtr_; }
 
+      /**
+      * Add forces for a contiguous range of pairs to a force array.
+      *
+      * \param beginPair  index of first pair in the PairList
+      * \param endPair  index one past the last pair
+      * \param forces  array of forces, indexed by atom id (modified)
+      */
+      virtual
+      void addPairForces(int beginPair, int endPair, Vector* forces);
+
       /*
       * Generalized stress computation.
       */
@@ -186,6 +198,7 @@ namespace McMd
 
 #include <mcMd/simulation/System.h>
 #include <mcMd/simulation/Simulation.h>
+#include <mcMd/simulation/ThreadPool.h>
 #include <mcMd/simulation/stress.h>
 #include <mcMd/neighbor/PairIterator.h>
 #include <simp/boundary/Boundary.h>
@@ -328,6 +341,12 @@ namespace McMd
          buildPairList();
       }
 
+      // Divide the pair list among threads, if more than one
+      if (system().threadPool().nThread() > 1) {
+         addForcesThreaded();
+         return;
+      }
+
       PairIterator iter;
       Vector       force;
       double       rsq;
@@ -352,6 +371,38 @@ namespace McMd
 
    }
 
+   /*
+   * Add nonBonded forces for a range of pairs to a force array.
+   */
+   template <class Interaction>
+   void
+   MdPairPotentialImpl<Interaction>::addPairForces(int beginPair,
+                                                   int endPair,
+                                                   Vector* forces)
+   {
+      PairIterator iter;
+      Vector       force;
+      double       rsq;
+      Atom        *atom0Ptr;
+      Atom        *atom1Ptr;
+      int          type0, type1;
+
+      pairList_.begin(iter, beginPair, endPair);
+      for ( ; iter.notEnd(); ++iter) {
+         iter.getPair(atom0Ptr, atom1Ptr);
+         rsq = boundary().
+               distanceSq(atom0Ptr->position(), atom1Ptr->position(),
+                          force);
+         type0 = atom0Ptr->typeId();
+         type1 = atom1Ptr->typeId();
+         if (rsq < interaction().cutoffSq(type0, type1)) {
+            force *= interaction().forceOverR(rsq, type0, type1);
+            forces[atom0Ptr->id()] += force;
+            forces[atom1Ptr->id()] -= force;
+         }
+      }
+   }
+
    /*
    * Compute and store all short-range pair energy components.
    */
@@ -8,6 +8,7 @@
 // namespace McMd
 #include "System.h"
 #include "Simulation.h"
+#include "ThreadPool.h"
 #include <mcMd/configIos/ConfigIo.h>
 #include <mcMd/configIos/McConfigIo.h>
 #include <mcMd/configIos/ConfigIoFactory.h>
@@ -57,6 +58,7 @@
 #include <simp/ensembles/BoundaryEnsemble.h>
 
 #include <util/misc/FileMaster.h>
+#include <util/random/Random.h>
 #include <util/param/Factory.h>
 #include <util/archives/Serializable_includes.h>
 #include <util/archives/serialize.h>
@@ -116,6 +118,8 @@ namespace McMd
       configIoFactoryPtr_(0),
       trajectoryReaderFactoryPtr_(0),
       fileMasterPtr_(0),
+      randomPtr_(0),
+      threadPoolPtr_(0),
       #ifdef MCMD_PERTURB
       perturbationPtr_(0),
       perturbationFactoryPtr_(0),
@@ -166,6 +170,7 @@ namespace McMd
       boundaryPtr_     = new Boundary;
       energyEnsemblePtr_   = new EnergyEnsemble;
       boundaryEnsemblePtr_ = new BoundaryEnsemble;
+      threadPoolPtr_       = new ThreadPool;
    }
 
    /*
@@ -215,6 +220,8 @@ namespace McMd
       configIoFactoryPtr_(other.configIoFactoryPtr_),
       trajectoryReaderFactoryPtr_(other.trajectoryReaderFactoryPtr_),
       fileMasterPtr_(other.fileMasterPtr_),
+      randomPtr_(other.randomPtr_),
+      threadPoolPtr_(other.threadPoolPtr_),
       #ifdef MCMD_PERTURB
       perturbationPtr_(other.perturbationPtr_),
       perturbationFactoryPtr_(other.perturbationFactoryPtr_),
@@ -274,6 +281,9 @@ namespace McMd
          if (boundaryPtr_) {
             delete boundaryPtr_;
          }
+         if (threadPoolPtr_) {
+            delete threadPoolPtr_;
+         }
          #ifndef SIMP_NOPAIR
          if (pairFactoryPtr_) {
             delete pairFactoryPtr_;
@@ -863,8 +873,17 @@ namespace McMd
    {
       assert(!simulationPtr_);
       simulationPtr_ = &simulation;
+      if (!randomPtr_) {
+         randomPtr_ = &simulation.random();
+      }
    }
 
+   /*
+   * Set pointer to a random number generator.
+   */
+   void System::setRandom(Random& random)
+   {  randomPtr_ = &random; }
+
    /*
    * Set pointer to a FileMaster.
    */
@@ -1191,7 +1210,7 @@ namespace McMd
                      << " = " << nMol << std::endl;
          UTIL_THROW("Number of molecules in species <= 0");
       }
-      moleculeId = simulation().random().uniformInt(0, nMol);
+      moleculeId = random().uniformInt(0, nMol);
       return molecule(speciesId, moleculeId); 
    }
 
@@ -26,6 +26,7 @@
 class SystemTest;
 
 namespace Util { 
+   class Random;
    template <typename T> class Factory;
    class FileMaster;
 }
@@ -58,6 +59,7 @@ namespace McMd
    class Simulation;
    class ConfigIo;
    class TrajectoryReader;
+   class ThreadPool;
    class PairFactory;
    #ifdef SIMP_BOND
    class BondPotential;
@@ -168,6 +170,19 @@ namespace McMd
       */
       void setFileMaster(FileMaster& filemaster);
 
+      /** 
+      * Set the random number generator used by this System.
+      * 
+      * By default, a System uses the generator of the parent Simulation,
+      * which is set by setSimulation(). A separate generator is needed
+      * by each of several Systems that are evolved by different threads.
+      * This must be called before any McMove associated with this 
+      * System is created.
+      * 
+      * \param random Random number generator.
+      */
+      void setRandom(Random& random);
+
       /**
       * Read parameter file.
       *
@@ -620,6 +635,19 @@ namespace McMd
       */ 
       FileMaster& fileMaster() const;
 
+      /**
+      * Get the random number generator by reference.
+      */ 
+      Random& random() const;
+
+      /**
+      * Get the ThreadPool used by potentials of this System.
+      *
+      * A System created by the copy constructor shares the ThreadPool
+      * of the original.
+      */ 
+      ThreadPool& threadPool() const;
+
       /**
       * Was this System instantiated with the copy constructor?
       */
@@ -923,6 +951,12 @@ namespace McMd
 
       /// Pointer to a FileMaster.
       FileMaster* fileMasterPtr_;
+
+      /// Pointer to a random number generator.
+      Random* randomPtr_;
+
+      /// Pointer to threads and per-thread work space for potentials.
+      ThreadPool* threadPoolPtr_;
    
       #ifdef MCMD_PERTURB
       /// Pointer to a perturbation object.
@@ -1099,6 +1133,24 @@ namespace McMd
       return *fileMasterPtr_; 
    }
 
+   /* 
+   * Get the random number generator by reference.
+   */
+   inline Random& System::random() const
+   { 
+      assert(randomPtr_);
+      return *randomPtr_; 
+   }
+
+   /* 
+   * Get the ThreadPool by reference.
+   */
+   inline ThreadPool& System::threadPool() const
+   { 
+      assert(threadPoolPtr_);
+      return *threadPoolPtr_; 
+   }
+
    /* 
    * Was this System instantiated with the copy constructor?
    */
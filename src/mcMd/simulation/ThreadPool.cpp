@@ -0,0 +1,109 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ThreadPool.h"
+#include <mcMd/simulation/System.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+
+#ifdef MCMD_OPENMP
+#include <omp.h>
+#endif
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   ThreadPool::ThreadPool()
+    : forces_(),
+      nThread_(1),
+      atomCapacity_(0),
+      isDeterministic_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   ThreadPool::~ThreadPool()
+   {}
+
+   /*
+   * Set the number of threads.
+   */
+   void ThreadPool::setNThread(int nThread)
+   {
+      if (nThread < 0) {
+         UTIL_THROW("Negative nThread");
+      }
+      #ifdef MCMD_OPENMP
+      nThread_ = nThread > 0 ? nThread : omp_get_max_threads();
+      #else
+      nThread_ = 1;
+      #endif
+   }
+
+   /*
+   * Set to require a deterministic division of work.
+   */
+   void ThreadPool::setDeterministic(bool isDeterministic)
+   {  isDeterministic_ = isDeterministic; }
+
+   /*
+   * Allocate (or reallocate) and zero per-thread force arrays.
+   */
+   void ThreadPool::allocateForces(int atomCapacity)
+   {
+      int size = nThread_*atomCapacity;
+      if (forces_.isAllocated()) {
+         if (forces_.capacity() == size && atomCapacity_ == atomCapacity) {
+            return;
+         }
+         forces_.deallocate();
+      }
+      forces_.allocate(size);
+      atomCapacity_ = atomCapacity;
+      for (int i = 0; i < size; ++i) {
+         forces_[i].zero();
+      }
+   }
+
+   /*
+   * Add per-thread forces to atomic forces, and zero per-thread forces.
+   */
+   void ThreadPool::reduceForces(System& system)
+   {
+      assert(forces_.isAllocated());
+      int nSpecies = system.simulation().nSpecies();
+      int iSpecies, iMol, nMol;
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         nMol = system.nMolecule(iSpecies);
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for schedule(static) num_threads(nThread_)
+         #endif
+         for (iMol = 0; iMol < nMol; ++iMol) {
+            Molecule::AtomIterator atomIter;
+            Vector* threadForcePtr;
+            int id, i;
+            system.molecule(iSpecies, iMol).begin(atomIter);
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               for (i = 0; i < nThread_; ++i) {
+                  threadForcePtr = &forces_[i*atomCapacity_ + id];
+                  atomIter->force() += *threadForcePtr;
+                  threadForcePtr->zero();
+               }
+            }
+         }
+      }
+   }
+
+}
@@ -0,0 +1,175 @@
+#ifndef MCMD_THREAD_POOL_H
+#define MCMD_THREAD_POOL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/DArray.h>       // member template
+#include <util/space/Vector.h>            // member template parameter
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class System;
+
+   /**
+   * Threads and per-thread work space shared by the potentials of a System.
+   *
+   * A ThreadPool holds the number of threads used to compute forces,
+   * and a block of per-thread force arrays that is reused on every
+   * force evaluation. If compiled with MCMD_OPENMP defined, threads
+   * are the members of an OpenMP team created within each potential,
+   * with num_threads(nThread()). Otherwise, nThread() is always 1.
+   *
+   * A potential that accumulates forces on pairs of atoms that may be
+   * handled by different threads divides its work into nThread() (or
+   * more) parts. Each part adds forces to forces(i) for a thread or
+   * part index i, indexed by Atom::id(), and reduceForces() then adds
+   * these per-thread forces to the atomic forces. If isDeterministic()
+   * is true, work must be divided into exactly nThread() contiguous
+   * parts, part i must use forces(i), and the result is then independent
+   * of the assignment of parts to threads. Otherwise, work may be handed
+   * out dynamically, and part i should use forces(omp_get_thread_num()).
+   *
+   * The per-thread force arrays are zeroed by reduceForces(), and so are
+   * always zero between force evaluations.
+   *
+   * \ingroup McMd_Simulation_Module
+   */
+   class ThreadPool
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      ThreadPool();
+
+      /**
+      * Destructor.
+      */
+      ~ThreadPool();
+
+      /**
+      * Set the number of threads.
+      *
+      * If nThread == 0, use the maximum number of OpenMP threads. If
+      * compiled without MCMD_OPENMP, the number of threads is always 1.
+      *
+      * \param nThread  requested number of threads (0 for default)
+      */
+      void setNThread(int nThread);
+
+      /**
+      * Set to require a reduction that is independent of scheduling.
+      *
+      * \param isDeterministic  true to use a fixed division of work
+      */
+      void setDeterministic(bool isDeterministic);
+
+      /**
+      * Allocate per-thread force arrays, if not done previously.
+      *
+      * \param atomCapacity  maximum atom id, plus 1
+      */
+      void allocateForces(int atomCapacity);
+
+      /**
+      * Add per-thread forces to the forces of all atoms in a System.
+      *
+      * Forces for each atom are added in order of increasing thread
+      * index, and the per-thread forces are then reset to zero.
+      *
+      * \param system  System whose atoms were given per-thread forces
+      */
+      void reduceForces(System& system);
+
+      /**
+      * Get the force array for one thread, indexed by atom id.
+      *
+      * \param threadId  thread or part index, 0 <= threadId < nThread()
+      */
+      Vector* forces(int threadId);
+
+      /**
+      * Get the number of threads.
+      */
+      int nThread() const;
+
+      /**
+      * Is the division of work and order of reduction deterministic?
+      */
+      bool isDeterministic() const;
+
+      /**
+      * Get bounds of part i of a range [0, n) divided into nPart parts.
+      *
+      * \param n  number of elements in the range
+      * \param nPart  number of parts
+      * \param i  index of part, 0 <= i < nPart
+      * \param begin  index of first element of part i (output)
+      * \param end  index one past last element of part i (output)
+      */
+      static void partition(int n, int nPart, int i, int& begin, int& end);
+
+   private:
+
+      /// Per-thread forces, forces(i) begins at element i*atomCapacity_.
+      DArray<Vector> forces_;
+
+      /// Number of threads.
+      int nThread_;
+
+      /// Number of atoms in each per-thread block of forces_.
+      int atomCapacity_;
+
+      /// Is the division of work required to be deterministic?
+      bool isDeterministic_;
+
+   };
+
+   // Inline functions
+
+   /*
+   * Get the force array for one thread.
+   */
+   inline Vector* ThreadPool::forces(int threadId)
+   {
+      assert(threadId >= 0);
+      assert(threadId < nThread_);
+      assert(forces_.isAllocated());
+      return &forces_[threadId*atomCapacity_];
+   }
+
+   /*
+   * Get the number of threads.
+   */
+   inline int ThreadPool::nThread() const
+   {  return nThread_; }
+
+   /*
+   * Is the division of work and order of reduction deterministic?
+   */
+   inline bool ThreadPool::isDeterministic() const
+   {  return isDeterministic_; }
+
+   /*
+   * Get bounds of part i of a range [0, n) divided into nPart parts.
+   */
+   inline
+   void ThreadPool::partition(int n, int nPart, int i, int& begin, int& end)
+   {
+      begin = (int)( ((long)n*(long)i)/((long)nPart) );
+      end = (int)( ((long)n*(long)(i + 1))/((long)nPart) );
+   }
+
+}
+#endif
@@ -3,6 +3,7 @@ mcMd_simulation_= \
     mcMd/simulation/Simulation.cpp \
     mcMd/simulation/System.cpp \
     mcMd/simulation/SystemInterface.cpp \
+    mcMd/simulation/ThreadPool.cpp \
 
 ifdef UTIL_MPI
 mcMd_simulation_ += mcMd/simulation/McMd_mpi.cpp 
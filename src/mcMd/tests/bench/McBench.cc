@@ -0,0 +1,303 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mcSimulation/McSimulation.h>
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <simp/species/Species.h>
+#include <simp/boundary/Boundary.h>
+#include <simp/tests/bench/BenchmarkReport.h>
+#include <util/random/Random.h>
+#include <util/space/Vector.h>
+#include <util/misc/Timer.h>
+
+#include <unistd.h>
+#include <cmath>
+#include <fstream>
+
+using namespace McMd;
+using namespace Util;
+
+/**
+* Benchmarks of McMd Monte Carlo energy kernels.
+*
+* The parameter file defines an LJ liquid species (species 0) and a 
+* bead-spring chain species (species 1), with capacities large enough 
+* for the largest system. Each system is generated with one species,
+* and each kernel is then timed in isolation.
+*/
+class McBench 
+{
+
+public:
+
+   McBench()
+    : nRep_(10),
+      nAtom_(0)
+   {}
+
+   /**
+   * Read parameter file.
+   */
+   void readParam(const std::string& fileName) 
+   {
+      std::ifstream in(fileName.c_str());
+      if (!in.is_open()) {
+         UTIL_THROW("Error opening parameter file");
+      }
+      sim_.readParam(in);
+      in.close();
+
+      int nAtomType = sim_.nAtomType();
+      diameters_.allocate(nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         diameters_[i] = 0.7;
+      }
+      capacities_.allocate(sim_.nSpecies());
+   }
+
+   /**
+   * Generate a cubic system of about nAtom atoms of one species.
+   */
+   void generate(int speciesId, int nAtom, double density)
+   {
+      McSystem& system = sim_.system();
+      system.removeAllMolecules();
+
+      int nAtomMolecule = sim_.species(speciesId).nAtom();
+      int nMolecule = nAtom/nAtomMolecule;
+      nAtom_ = nMolecule*nAtomMolecule;
+      system.boundary().setCubic(std::pow(double(nAtom_)/density, 1.0/3.0));
+      for (int i = 0; i < sim_.nSpecies(); ++i) {
+         capacities_[i] = 0;
+      }
+      capacities_[speciesId] = nMolecule;
+      system.generateMolecules(capacities_, diameters_);
+   }
+
+   /**
+   * Time construction of the cell list of the pair potential.
+   */
+   void benchCellList(BenchmarkReport& report, 
+                      const std::string& name, double density)
+   {
+      McPairPotential& pair = sim_.system().pairPotential();
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         pair.buildCellList();
+      }
+      timer.stop();
+      report.add("McMd::McPairPotential::buildCellList", name, nAtom_, 
+                 density, nRep_, timer.time(), 0.0);
+   }
+
+   /**
+   * Time evaluation of the pair energy of every atom.
+   */
+   void benchAtomEnergy(BenchmarkReport& report, 
+                        const std::string& name, double density)
+   {
+      McSystem& system = sim_.system();
+      McPairPotential& pair = system.pairPotential();
+      pair.buildCellList();
+
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      double energy = 0.0;
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         for (int iSpecies = 0; iSpecies < sim_.nSpecies(); ++iSpecies) {
+            system.begin(iSpecies, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter); 
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  energy += pair.atomEnergy(*atomIter);
+               }
+            }
+         }
+      }
+      timer.stop();
+
+      // Output energy, so that the loop cannot be optimized away
+      std::cerr << "energy/atom = " 
+                << energy/double(nRep_*nAtom_) << std::endl;
+      report.add("McMd::McPairPotentialImpl::atomEnergy", name, nAtom_, 
+                 density, nRep_, timer.time(), 0.0);
+   }
+
+   /**
+   * Time evaluation of pair energies of configuration bias trials.
+   *
+   * For each atom, nTrial trial positions are generated at unit distance
+   * from the atom, as for a regrown end atom bonded to it. Energies are
+   * evaluated by one call to trialEnergies() and, for comparison, by one
+   * call to atomEnergy() per trial.
+   */
+   void benchTrialEnergies(BenchmarkReport& report, 
+                           const std::string& name, double density)
+   {
+      const int nTrial = 16;
+      McSystem& system = sim_.system();
+      Boundary& boundary = system.boundary();
+      McPairPotential& pair = system.pairPotential();
+      Random& random = sim_.random();
+      pair.buildCellList();
+
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      Vector trialPos[nTrial];
+      double trialEnergy[nTrial];
+      Vector oldPos, bondVec;
+      double energy;
+      int iRep, iSpecies, iTrial;
+      Timer timer;
+
+      // Batched evaluation
+      energy = 0.0;
+      timer.start();
+      for (iRep = 0; iRep < nRep_; ++iRep) {
+         for (iSpecies = 0; iSpecies < sim_.nSpecies(); ++iSpecies) {
+            system.begin(iSpecies, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter); 
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+                     random.unitVector(bondVec);
+                     trialPos[iTrial].add(atomIter->position(), bondVec);
+                     boundary.shift(trialPos[iTrial]);
+                  }
+                  pair.trialEnergies(*atomIter, trialPos, nTrial, 
+                                     trialEnergy);
+                  for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+                     energy += trialEnergy[iTrial];
+                  }
+               }
+            }
+         }
+      }
+      timer.stop();
+      std::cerr << "trial energy/atom = " 
+                << energy/double(nRep_*nAtom_*nTrial) << std::endl;
+      report.add("McMd::McPairPotentialImpl::trialEnergies", name, nAtom_, 
+                 density, nRep_, timer.time(), 0.0);
+
+      // Evaluation by one call to atomEnergy per trial
+      energy = 0.0;
+      timer.clear();
+      timer.start();
+      for (iRep = 0; iRep < nRep_; ++iRep) {
+         for (iSpecies = 0; iSpecies < sim_.nSpecies(); ++iSpecies) {
+            system.begin(iSpecies, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter); 
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  oldPos = atomIter->position();
+                  for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+                     random.unitVector(bondVec);
+                     atomIter->position().add(oldPos, bondVec);
+                     boundary.shift(atomIter->position());
+                     energy += pair.atomEnergy(*atomIter);
+                  }
+                  atomIter->position() = oldPos;
+               }
+            }
+         }
+      }
+      timer.stop();
+      std::cerr << "trial energy/atom = " 
+                << energy/double(nRep_*nAtom_*nTrial) << std::endl;
+      report.add("McMd::McPairPotentialImpl::atomEnergy(trials)", name, 
+                 nAtom_, density, nRep_, timer.time(), 0.0);
+   }
+
+   /**
+   * Run all benchmarks for all systems.
+   */
+   void run(BenchmarkReport& report)
+   {
+      const int nSize = 3;
+      const int sizes[nSize] = {1000, 4000, 16000};
+      const int nDensity = 2;
+      const double densities[nDensity] = {0.6, 0.85};
+      const char* names[2] = {"lj", "chain"};
+
+      int iSpecies, iSize, iDensity;
+      double density;
+      for (iSpecies = 0; iSpecies < 2; ++iSpecies) {
+         for (iSize = 0; iSize < nSize; ++iSize) {
+            for (iDensity = 0; iDensity < nDensity; ++iDensity) {
+               density = densities[iDensity];
+               generate(iSpecies, sizes[iSize], density);
+               benchCellList(report, names[iSpecies], density);
+               benchAtomEnergy(report, names[iSpecies], density);
+               benchTrialEnergies(report, names[iSpecies], density);
+            }
+         }
+      }
+   }
+
+   /**
+   * Set number of repetitions of each kernel.
+   */
+   void setNRep(int nRep)
+   {  nRep_ = nRep; }
+
+private:
+
+   McSimulation sim_;
+   DArray<int> capacities_;
+   DArray<double> diameters_;
+   int nRep_;
+   int nAtom_;
+
+};
+
+/*
+* Usage: McBench [-o output.json] [-b baseline.json] [-t tol] [-r nRep]
+*
+* Returns a nonzero exit status if any kernel is slower than the 
+* baseline by more than a fraction tol (default 0.10).
+*/
+int main(int argc, char **argv)
+{
+   std::string outFileName;
+   std::string baselineFileName;
+   double tolerance = 0.10;
+   int nRep = 10;
+   int c;
+   while ((c = getopt(argc, argv, "o:b:t:r:")) != -1) {
+      switch (c) {
+      case 'o': 
+         outFileName = optarg;
+         break;
+      case 'b': 
+         baselineFileName = optarg;
+         break;
+      case 't': 
+         tolerance = atof(optarg);
+         break;
+      case 'r': 
+         nRep = atoi(optarg);
+         break;
+      default:
+         std::cerr << "Unknown option" << std::endl;
+         return 1;
+      }
+   }
+
+   McBench bench;
+   bench.readParam("in/McBench");
+   bench.setNRep(nRep);
+   BenchmarkReport report;
+   bench.run(report);
+   int nRegression = report.output(outFileName, baselineFileName, tolerance);
+   return (nRegression > 0) ? 2 : 0;
+}
@@ -0,0 +1,236 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdSimulation/MdSimulation.h>
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/neighbor/CellList.h>
+#include <mcMd/neighbor/PairList.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <simp/species/Species.h>
+#include <simp/tests/bench/BenchmarkReport.h>
+#include <util/misc/Timer.h>
+
+#include <unistd.h>
+#include <cmath>
+#include <fstream>
+
+using namespace McMd;
+using namespace Util;
+
+/**
+* Benchmarks of McMd molecular dynamics kernels.
+*
+* The parameter file defines an LJ liquid species (species 0) and a 
+* bead-spring chain species (species 1), with capacities large enough 
+* for the largest system. Each system is generated with one species,
+* and each kernel is then timed in isolation.
+*/
+class MdBench 
+{
+
+public:
+
+   MdBench()
+    : nRep_(10),
+      nAtom_(0)
+   {}
+
+   /**
+   * Read parameter file.
+   */
+   void readParam(const std::string& fileName) 
+   {
+      std::ifstream in(fileName.c_str());
+      if (!in.is_open()) {
+         UTIL_THROW("Error opening parameter file");
+      }
+      sim_.readParam(in);
+      in.close();
+
+      int nAtomType = sim_.nAtomType();
+      diameters_.allocate(nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         diameters_[i] = 0.7;
+      }
+      capacities_.allocate(sim_.nSpecies());
+   }
+
+   /**
+   * Generate a cubic system of about nAtom atoms of one species.
+   */
+   void generate(int speciesId, int nAtom, double density)
+   {
+      MdSystem& system = sim_.system();
+      system.removeAllMolecules();
+
+      int nAtomMolecule = sim_.species(speciesId).nAtom();
+      int nMolecule = nAtom/nAtomMolecule;
+      nAtom_ = nMolecule*nAtomMolecule;
+      system.boundary().setCubic(std::pow(double(nAtom_)/density, 1.0/3.0));
+      for (int i = 0; i < sim_.nSpecies(); ++i) {
+         capacities_[i] = 0;
+      }
+      capacities_[speciesId] = nMolecule;
+      system.generateMolecules(capacities_, diameters_);
+   }
+
+   /**
+   * Time construction of a cell list.
+   */
+   void benchCellList(BenchmarkReport& report, 
+                      const std::string& name, double density)
+   {
+      MdSystem& system = sim_.system();
+      CellList cellList;
+      cellList.setAtomCapacity(sim_.atomCapacity());
+      double cutoff = system.pairPotential().maxPairCutoff();
+
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         cellList.setup(system.boundary(), cutoff);
+         for (int iSpecies = 0; iSpecies < sim_.nSpecies(); ++iSpecies) {
+            system.begin(iSpecies, molIter);
+            for ( ; molIter.notEnd(); ++molIter) {
+               molIter->begin(atomIter); 
+               for ( ; atomIter.notEnd(); ++atomIter) {
+                  cellList.addAtom(*atomIter);
+               }
+            }
+         }
+      }
+      timer.stop();
+      report.add("McMd::CellList::build", name, nAtom_, density, 
+                 nRep_, timer.time(), 0.0);
+   }
+
+   /**
+   * Time construction of the Verlet pair list.
+   */
+   void benchPairList(BenchmarkReport& report, 
+                      const std::string& name, double density)
+   {
+      MdPairPotential& pair = sim_.system().pairPotential();
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         pair.buildPairList();
+      }
+      timer.stop();
+      double nPair = double(pair.pairList().nPair());
+      report.add("McMd::PairList::build", name, nAtom_, density, 
+                 nRep_, timer.time(), nPair);
+   }
+
+   /**
+   * Time pair force calculation, using an existing pair list.
+   */
+   void benchPairForces(BenchmarkReport& report, 
+                        const std::string& name, double density)
+   {
+      MdSystem& system = sim_.system();
+      MdPairPotential& pair = system.pairPotential();
+      pair.buildPairList();
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         system.setZeroForces();
+         pair.addForces();
+      }
+      timer.stop();
+      double nPair = double(pair.pairList().nPair());
+      report.add("McMd::MdPairPotentialImpl::addForces", name, nAtom_, 
+                 density, nRep_, timer.time(), nPair);
+   }
+
+   /**
+   * Run all benchmarks for all systems.
+   */
+   void run(BenchmarkReport& report)
+   {
+      const int nSize = 3;
+      const int sizes[nSize] = {1000, 4000, 16000};
+      const int nDensity = 2;
+      const double densities[nDensity] = {0.6, 0.85};
+      const char* names[2] = {"lj", "chain"};
+
+      int iSpecies, iSize, iDensity;
+      double density;
+      for (iSpecies = 0; iSpecies < 2; ++iSpecies) {
+         for (iSize = 0; iSize < nSize; ++iSize) {
+            for (iDensity = 0; iDensity < nDensity; ++iDensity) {
+               density = densities[iDensity];
+               generate(iSpecies, sizes[iSize], density);
+               benchCellList(report, names[iSpecies], density);
+               benchPairList(report, names[iSpecies], density);
+               benchPairForces(report, names[iSpecies], density);
+            }
+         }
+      }
+   }
+
+   /**
+   * Set number of repetitions of each kernel.
+   */
+   void setNRep(int nRep)
+   {  nRep_ = nRep; }
+
+private:
+
+   MdSimulation sim_;
+   DArray<int> capacities_;
+   DArray<double> diameters_;
+   int nRep_;
+   int nAtom_;
+
+};
+
+/*
+* Usage: MdBench [-o output.json] [-b baseline.json] [-t tol] [-r nRep]
+*
+* Returns a nonzero exit status if any kernel is slower than the 
+* baseline by more than a fraction tol (default 0.10).
+*/
+int main(int argc, char **argv)
+{
+   std::string outFileName;
+   std::string baselineFileName;
+   double tolerance = 0.10;
+   int nRep = 10;
+   int c;
+   while ((c = getopt(argc, argv, "o:b:t:r:")) != -1) {
+      switch (c) {
+      case 'o': 
+         outFileName = optarg;
+         break;
+      case 'b': 
+         baselineFileName = optarg;
+         break;
+      case 't': 
+         tolerance = atof(optarg);
+         break;
+      case 'r': 
+         nRep = atoi(optarg);
+         break;
+      default:
+         std::cerr << "Unknown option" << std::endl;
+         return 1;
+      }
+   }
+
+   MdBench bench;
+   bench.readParam("in/MdBench");
+   bench.setNRep(nRep);
+   BenchmarkReport report;
+   bench.run(report);
+   int nRegression = report.output(outFileName, baselineFileName, tolerance);
+   return (nRegression > 0) ? 2 : 0;
+}
@@ -0,0 +1,161 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdSimulation/MdSimulation.h>
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/potentials/coulomb/MdCoulombPotential.h>
+#include <simp/tests/bench/BenchmarkReport.h>
+#include <util/misc/Timer.h>
+
+#include <unistd.h>
+#include <cmath>
+#include <fstream>
+
+using namespace McMd;
+using namespace Util;
+
+/**
+* Benchmark of the k-space part of the MdSpmePotential force calculation.
+*
+* The parameter file defines two species of oppositely charged point
+* particles, with equal capacities, and a fixed SPME grid. Each system
+* is a neutral cubic salt at a fixed number density.
+*/
+class SpmeBench 
+{
+
+public:
+
+   SpmeBench()
+    : nRep_(10),
+      nAtom_(0)
+   {}
+
+   /**
+   * Read parameter file.
+   */
+   void readParam(const std::string& fileName) 
+   {
+      std::ifstream in(fileName.c_str());
+      if (!in.is_open()) {
+         UTIL_THROW("Error opening parameter file");
+      }
+      sim_.readParam(in);
+      in.close();
+
+      int nAtomType = sim_.nAtomType();
+      diameters_.allocate(nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         diameters_[i] = 0.7;
+      }
+      capacities_.allocate(sim_.nSpecies());
+   }
+
+   /**
+   * Generate a neutral cubic system of nAtom point charges.
+   */
+   void generate(int nAtom, double density)
+   {
+      MdSystem& system = sim_.system();
+      system.removeAllMolecules();
+      capacities_[0] = nAtom/2;
+      capacities_[1] = nAtom/2;
+      nAtom_ = 2*(nAtom/2);
+      system.boundary().setCubic(std::pow(double(nAtom_)/density, 1.0/3.0));
+      system.generateMolecules(capacities_, diameters_);
+   }
+
+   /**
+   * Time k-space force calculation.
+   */
+   void benchForces(BenchmarkReport& report, double density)
+   {
+      MdSystem& system = sim_.system();
+      MdCoulombPotential& coulomb = system.coulombPotential();
+      coulomb.makeWaves();
+      Timer timer;
+      timer.start();
+      for (int iRep = 0; iRep < nRep_; ++iRep) {
+         system.setZeroForces();
+         coulomb.addForces();
+      }
+      timer.stop();
+      report.add("McMd::MdSpmePotential::addForces", "salt", nAtom_, 
+                 density, nRep_, timer.time(), 0.0);
+   }
+
+   /**
+   * Run benchmark for all system sizes.
+   */
+   void run(BenchmarkReport& report)
+   {
+      const int nSize = 2;
+      const int sizes[nSize] = {1000, 4000};
+      const double density = 0.85;
+      for (int iSize = 0; iSize < nSize; ++iSize) {
+         generate(sizes[iSize], density);
+         benchForces(report, density);
+      }
+   }
+
+   /**
+   * Set number of repetitions of each kernel.
+   */
+   void setNRep(int nRep)
+   {  nRep_ = nRep; }
+
+private:
+
+   MdSimulation sim_;
+   DArray<int> capacities_;
+   DArray<double> diameters_;
+   int nRep_;
+   int nAtom_;
+
+};
+
+/*
+* Usage: SpmeBench [-o output.json] [-b baseline.json] [-t tol] [-r nRep]
+*
+* Returns a nonzero exit status if any kernel is slower than the 
+* baseline by more than a fraction tol (default 0.10).
+*/
+int main(int argc, char **argv)
+{
+   std::string outFileName;
+   std::string baselineFileName;
+   double tolerance = 0.10;
+   int nRep = 10;
+   int c;
+   while ((c = getopt(argc, argv, "o:b:t:r:")) != -1) {
+      switch (c) {
+      case 'o': 
+         outFileName = optarg;
+         break;
+      case 'b': 
+         baselineFileName = optarg;
+         break;
+      case 't': 
+         tolerance = atof(optarg);
+         break;
+      case 'r': 
+         nRep = atoi(optarg);
+         break;
+      default:
+         std::cerr << "Unknown option" << std::endl;
+         return 1;
+      }
+   }
+
+   SpmeBench bench;
+   bench.readParam("in/SpmeBench");
+   bench.setNRep(nRep);
+   BenchmarkReport report;
+   bench.run(report);
+   int nRegression = report.output(outFileName, baselineFileName, tolerance);
+   return (nRegression > 0) ? 2 : 0;
+}
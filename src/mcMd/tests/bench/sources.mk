@@ -0,0 +1,17 @@
+mcMd_tests_bench_= \
+   mcMd/tests/bench/MdBench.cc \
+   mcMd/tests/bench/McBench.cc
+
+ifdef SIMP_COULOMB
+ifdef SIMP_FFTW
+mcMd_tests_bench_+= \
+   mcMd/tests/bench/SpmeBench.cc
+endif
+endif
+
+mcMd_tests_bench_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(mcMd_tests_bench_))
+mcMd_tests_bench_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(mcMd_tests_bench_:.cc=.o))
+mcMd_tests_bench_EXES=\
+     $(addprefix $(BLD_DIR)/, $(mcMd_tests_bench_:.cc=))
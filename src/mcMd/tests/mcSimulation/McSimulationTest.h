@@ -3,6 +3,11 @@
 
 #include <mcMd/mcSimulation/McSimulation.h>
 #include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/mcSimulation/McReplicaBatch.h>
+#include <mcMd/mcSimulation/McEnergyCache.h>
+#include <mcMd/mcMoves/McMoveManager.h>
+#include <mcMd/mcMoves/McMove.h>
+#include <simp/ensembles/EnergyEnsemble.h>
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <simp/species/Species.h>
 #include <mcMd/chemistry/Molecule.h>
@@ -13,6 +18,9 @@
 #ifdef SIMP_ANGLE
 #include <mcMd/potentials/angle/AnglePotential.h>
 #endif
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/McCoulombPotential.h>
+#endif
 
 #include <util/archives/BinaryFileOArchive.h>
 #include <util/archives/BinaryFileIArchive.h>
@@ -39,11 +47,19 @@ public:
    void testReadParamBond();
    void testReadConfigBond();
    void testPairEnergy();
+   void testTrialEnergies();
    void testBondEnergy();
    void testActivate();
    void testMdSystemCopy();
    void testSimulateBond();
    void testWriteRestartBond();
+   void testSimulateReplicas();
+   void testSimulateCheckerboard();
+   void testSimulateEnergyCache();
+   void testSimulatePackedCells();
+   #ifdef SIMP_COULOMB
+   void testSimulateCoulomb();
+   #endif
    void testReadRestart();
 
    #ifdef SIMP_ANGLE
@@ -169,6 +185,47 @@ void McSimulationTest::testPairEnergy()
    TEST_ASSERT(eq(0.5*energy, total));
 }
 
+void McSimulationTest::testTrialEnergies()
+{ 
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config");
+
+   // Use positions of all atoms as trial positions for one atom
+   McPairPotential& pair = system_.pairPotential();
+   Molecule& molecule = system_.molecule(1, 0);
+   Atom& atom = molecule.atom(0);
+   Vector oldPos = atom.position();
+   int nTrial = system_.nAtom();
+   DArray<Vector> positions;
+   DArray<double> energies;
+   positions.allocate(nTrial);
+   energies.allocate(nTrial);
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   int i = 0;
+   for (int is=0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            positions[i] = atomIter->position();
+            ++i;
+         }
+      }
+   }
+   TEST_ASSERT(i == nTrial);
+
+   pair.trialEnergies(atom, &positions[0], nTrial, &energies[0]);
+   TEST_ASSERT(atom.position() == oldPos);
+
+   // Compare to one atomEnergy calculation per trial position
+   for (i = 0; i < nTrial; ++i) {
+      atom.position() = positions[i];
+      TEST_ASSERT(eq(energies[i], pair.atomEnergy(atom)));
+   }
+   atom.position() = oldPos;
+}
+
 void McSimulationTest::testBondEnergy()
 { 
    printMethod(TEST_FUNC);
@@ -357,6 +414,161 @@ void McSimulationTest::testSimulateAngle()
 }
 #endif
 
+void McSimulationTest::testSimulateReplicas()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McReplicaBatch"); 
+   readConfig("in/config"); 
+
+   McReplicaBatch& batch = simulation_.replicaBatch();
+   TEST_ASSERT(batch.isActive());
+   TEST_ASSERT(batch.nReplica() == 3);
+   TEST_ASSERT(eq(batch.temperature(0), 1.0));
+   TEST_ASSERT(eq(batch.temperature(2), 2.0));
+
+   batch.simulate(20);
+
+   // Each temperature must be held by exactly one replica
+   for (int k = 0; k < batch.nReplica(); ++k) {
+      TEST_ASSERT(eq(batch.system(k).energyEnsemble().temperature(),
+                     batch.temperature(k)));
+      TEST_ASSERT(batch.system(k).nMolecule(0) == 2);
+      TEST_ASSERT(batch.system(k).nMolecule(1) == 3);
+      for (int j = 0; j < k; ++j) {
+         TEST_ASSERT(&batch.system(k) != &batch.system(j));
+      }
+   }
+
+   // Main system is unchanged by a batch run
+   TEST_ASSERT(simulation_.system().nMolecule(0) == 2);
+   TEST_ASSERT(eq(simulation_.system().energyEnsemble().temperature(), 1.0));
+}
+
+void McSimulationTest::testSimulateCheckerboard()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McCheckerboard"); 
+   readConfig("in/config"); 
+
+   simulation_.simulate(20);
+
+   // Cell list must be consistent with the final positions
+   McSystem& system = simulation_.system();
+   TEST_ASSERT(system.pairPotential().cellList().isValid(system.nAtom()));
+}
+
+void McSimulationTest::testSimulateEnergyCache()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McEnergyCache"); 
+   readConfig("in/config"); 
+
+   McSystem& system = simulation_.system();
+   TEST_ASSERT(system.hasEnergyCache());
+
+   // Build the cache, and apply moves that keep it up to date
+   system.energyCache().compute();
+   for (int i = 0; i < 50; ++i) {
+      McMove& move = simulation_.mcMoveManager().chooseMove();
+      TEST_ASSERT(move.keepsEnergyCache());
+      move.move();
+   }
+   McEnergyCache& cache = system.energyCache();
+   TEST_ASSERT(cache.isValid());
+   double cached = system.potentialEnergy();
+   int nCell = cache.nCell();
+   DArray<double> cellEnergies;
+   cellEnergies.allocate(nCell);
+   int ic;
+   for (ic = 0; ic < nCell; ++ic) {
+      cellEnergies[ic] = cache.cellEnergy(ic);
+   }
+
+   // Compare to energy recomputed from scratch
+   cache.unset();
+   system.positionSignal().notify();
+   TEST_ASSERT(eq(cached, system.potentialEnergy()));
+   TEST_ASSERT(system.pairPotential().cellList().isValid(system.nAtom()));
+
+   // Compare cell totals to those recomputed from scratch
+   cache.compute();
+   TEST_ASSERT(cache.nCell() == nCell);
+   for (ic = 0; ic < nCell; ++ic) {
+      TEST_ASSERT(eq(cellEnergies[ic], cache.cellEnergy(ic)));
+   }
+}
+
+void McSimulationTest::testSimulatePackedCells()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McPackedCells"); 
+   readConfig("in/config"); 
+
+   McPairPotential& pair = system_.pairPotential();
+   TEST_ASSERT(pair.hasPackedCells());
+   TEST_ASSERT(pair.packedCells().isValid(system_.nAtom()));
+
+   simulation_.simulate(50);
+   TEST_ASSERT(pair.packedCells().isValid(system_.nAtom()));
+   TEST_ASSERT(pair.cellList().isValid(system_.nAtom()));
+
+   // Compare sum of atomic energies to total pair energy
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   double energy = 0.0;
+   for (int is=0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            energy += pair.atomEnergy(*atomIter);
+         }
+      }
+   }
+   system_.positionSignal().notify();
+   TEST_ASSERT(eq(0.5*energy, pair.energy()));
+}
+
+#ifdef SIMP_COULOMB
+void McSimulationTest::testSimulateCoulomb()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McCoulomb"); 
+   readConfig("in/config"); 
+
+   TEST_ASSERT(system_.hasCoulombPotential());
+   McCoulombPotential& coulomb = system_.coulombPotential();
+
+   // Compare a trial energy change to a full recalculation
+   Atom& atom = system_.molecule(0, 0).atom(0);
+   Vector oldPos = atom.position();
+   Vector newPos = oldPos;
+   newPos[0] += 0.3;
+   newPos[2] -= 0.2;
+   system_.boundary().shift(newPos);
+   double oldEnergy = coulomb.kSpaceEnergy();
+   coulomb.clearTrial();
+   coulomb.addTrialMove(atom, oldPos, newPos);
+   double dEnergy = coulomb.trialEnergy();
+   atom.position() = newPos;
+   system_.pairPotential().updateAtomCell(atom);
+   coulomb.unsetKSpaceCharge();
+   TEST_ASSERT(eq(oldEnergy + dEnergy, coulomb.kSpaceEnergy()));
+
+   simulation_.simulate(100);
+   TEST_ASSERT(system_.pairPotential().cellList().isValid(system_.nAtom()));
+
+   // Compare energy of incrementally updated charge density to that 
+   // obtained by recomputing the charge density from scratch
+   double kEnergy = coulomb.kSpaceEnergy();
+   coulomb.unsetKSpaceCharge();
+   TEST_ASSERT(eq(kEnergy, coulomb.kSpaceEnergy()));
+}
+#endif
+
 void McSimulationTest::testWriteRestartBond()
 {
    printMethod(TEST_FUNC);
@@ -389,11 +601,19 @@ TEST_BEGIN(McSimulationTest)
 TEST_ADD(McSimulationTest, testReadParamBond)
 TEST_ADD(McSimulationTest, testReadConfigBond)
 TEST_ADD(McSimulationTest, testPairEnergy)
+TEST_ADD(McSimulationTest, testTrialEnergies)
 TEST_ADD(McSimulationTest, testBondEnergy)
 TEST_ADD(McSimulationTest, testActivate)
 TEST_ADD(McSimulationTest, testMdSystemCopy)
 TEST_ADD(McSimulationTest, testSimulateBond)
 TEST_ADD(McSimulationTest, testWriteRestartBond)
+TEST_ADD(McSimulationTest, testSimulateReplicas)
+TEST_ADD(McSimulationTest, testSimulateCheckerboard)
+TEST_ADD(McSimulationTest, testSimulateEnergyCache)
+TEST_ADD(McSimulationTest, testSimulatePackedCells)
+#ifdef SIMP_COULOMB
+TEST_ADD(McSimulationTest, testSimulateCoulomb)
+#endif
 //TEST_ADD(McSimulationTest, testReadRestart)
 #ifdef SIMP_ANGLE
 TEST_ADD(McSimulationTest, testReadParamAngle)
@@ -9,6 +9,16 @@
 #include <simp/species/Species.h>
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
+#ifdef MCMD_OPENMP
+#include <mcMd/simulation/ThreadPool.h>
+#include <util/space/Tensor.h>
+#include <util/containers/DArray.h>
+#ifdef SIMP_COULOMB
+#include <mcMd/potentials/coulomb/MdCoulombPotential.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#endif
 
 #include <test/UnitTestRunner.h>
 #include <test/UnitTest.h>
@@ -37,12 +47,24 @@ public:
    void testSimulate();
    void testWriteRestart();
    void testReadRestart();
+   #ifdef MCMD_OPENMP
+   void testThreadedForces();
+   #ifdef SIMP_COULOMB
+   void testThreadedSpmeForces();
+   #endif
+   #endif
 
 private:
 
    MdSimulation simulation_;
    MdSystem&    system_;
 
+   #ifdef MCMD_OPENMP
+   void computeForces(DArray<Vector>& forces, double& energy, 
+                      Tensor& stress);
+   void checkThreadedForces();
+   #endif
+
 };
 
 
@@ -356,6 +378,147 @@ void MdSimulationTest::testReadRestart()
    configFile.close();
 }
 
+#ifdef MCMD_OPENMP
+/*
+* Compute forces, potential energy and virial stress with the current
+* ThreadPool settings. Forces are stored by atom id.
+*/
+void MdSimulationTest::computeForces(DArray<Vector>& forces, double& energy,
+                                     Tensor& stress)
+{
+   system_.calculateForces();
+   system_.unsetPotentialEnergy();
+   energy = system_.potentialEnergy();
+   system_.unsetVirialStress();
+   system_.computeVirialStress(stress);
+
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int iSpecies = 0; iSpecies < simulation_.nSpecies(); ++iSpecies) {
+      system_.begin(iSpecies, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            forces[atomIter->id()] = atomIter->force();
+         }
+      }
+   }
+}
+
+/*
+* Compare threaded forces, energy and stress to the nThread = 1 result.
+*/
+void MdSimulationTest::checkThreadedForces()
+{
+   int atomCapacity = simulation_.atomCapacity();
+   DArray<Vector> refForces;
+   DArray<Vector> forces;
+   refForces.allocate(atomCapacity);
+   forces.allocate(atomCapacity);
+   for (int i = 0; i < atomCapacity; ++i) {
+      refForces[i].zero();
+      forces[i].zero();
+   }
+   double refEnergy, energy;
+   Tensor refStress, stress;
+
+   ThreadPool& pool = system_.threadPool();
+   pool.setNThread(1);
+   pool.setDeterministic(false);
+   computeForces(refForces, refEnergy, refStress);
+
+   const double tolerance = 1.0E-9;
+   double fMax = 0.0;
+   double sMax = 0.0;
+   int i, j, nThread, iDeterministic;
+   for (i = 0; i < atomCapacity; ++i) {
+      fMax = std::max(fMax, sqrt(refForces[i].square()));
+   }
+   for (i = 0; i < Dimension; ++i) {
+      for (j = 0; j < Dimension; ++j) {
+         sMax = std::max(sMax, fabs(refStress(i, j)));
+      }
+   }
+   TEST_ASSERT(fMax > 0.0);
+
+   Vector dF;
+   for (nThread = 2; nThread <= 3; ++nThread) {
+      for (iDeterministic = 0; iDeterministic < 2; ++iDeterministic) {
+         pool.setNThread(nThread);
+         pool.setDeterministic((bool)iDeterministic);
+         TEST_ASSERT(pool.nThread() == nThread);
+         computeForces(forces, energy, stress);
+
+         for (i = 0; i < atomCapacity; ++i) {
+            dF.subtract(forces[i], refForces[i]);
+            TEST_ASSERT(sqrt(dF.square()) <= tolerance*(1.0 + fMax));
+         }
+         TEST_ASSERT(fabs(energy - refEnergy) 
+                     <= tolerance*(1.0 + fabs(refEnergy)));
+         for (i = 0; i < Dimension; ++i) {
+            for (j = 0; j < Dimension; ++j) {
+               TEST_ASSERT(fabs(stress(i, j) - refStress(i, j)) 
+                           <= tolerance*(1.0 + sMax));
+            }
+         }
+      }
+   }
+   pool.setNThread(1);
+   pool.setDeterministic(false);
+}
+
+/*
+* Threaded pair and bond forces, with and without deterministicForces.
+*/
+void MdSimulationTest::testThreadedForces()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+
+   std::ifstream paramFile;
+   openInputFile("in/MdSimulation", paramFile); 
+   simulation_.readParam(paramFile);
+   paramFile.close();
+   simulation_.readCommands();
+   std::cout << std::endl;
+
+   checkThreadedForces();
+}
+
+#ifdef SIMP_COULOMB
+/*
+* Threaded SPME charge assignment and force interpolation.
+*/
+void MdSimulationTest::testThreadedSpmeForces()
+{
+   printMethod(TEST_FUNC);
+   std::cout << std::endl;
+
+   std::ifstream paramFile;
+   openInputFile("in/MdSpme", paramFile); 
+   simulation_.readParam(paramFile);
+   paramFile.close();
+
+   system_.boundary().setCubic(10.5);
+   int nSpecies = simulation_.nSpecies();
+   DArray<int> capacities;
+   capacities.allocate(nSpecies);
+   for (int i = 0; i < nSpecies; ++i) {
+      capacities[i] = simulation_.species(i).capacity();
+   }
+   int nAtomType = simulation_.nAtomType();
+   DArray<double> diameters;
+   diameters.allocate(nAtomType);
+   for (int i = 0; i < nAtomType; ++i) {
+      diameters[i] = 0.2;
+   }
+   system_.generateMolecules(capacities, diameters);
+   system_.coulombPotential().makeWaves();
+
+   checkThreadedForces();
+}
+#endif
+#endif
+
 TEST_BEGIN(MdSimulationTest)
 TEST_ADD(MdSimulationTest, testReadParam)
 TEST_ADD(MdSimulationTest, testSetZeroVelocities)
@@ -370,6 +533,12 @@ TEST_ADD(MdSimulationTest, testStep)
 TEST_ADD(MdSimulationTest, testSimulate)
 TEST_ADD(MdSimulationTest, testWriteRestart)
 TEST_ADD(MdSimulationTest, testReadRestart)
+#ifdef MCMD_OPENMP
+TEST_ADD(MdSimulationTest, testThreadedForces)
+#ifdef SIMP_COULOMB
+TEST_ADD(MdSimulationTest, testThreadedSpmeForces)
+#endif
+#endif
 TEST_END(MdSimulationTest)
 
 #endif
@@ -5,11 +5,13 @@
 
 #include "CellTest.h"
 #include "CellListTest.h"
+#include "PackedCellListTest.h"
 #include "PairListTest.h"
 
 TEST_COMPOSITE_BEGIN(NeighborTestComposite)
 TEST_COMPOSITE_ADD_UNIT(CellTest);
 TEST_COMPOSITE_ADD_UNIT(CellListTest);
+TEST_COMPOSITE_ADD_UNIT(PackedCellListTest);
 TEST_COMPOSITE_ADD_UNIT(PairListTest);
 TEST_COMPOSITE_END
 
@@ -0,0 +1,298 @@
+#ifndef MCMD_PACKED_CELL_LIST_TEST_H
+#define MCMD_PACKED_CELL_LIST_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <mcMd/neighbor/PackedCellList.h>
+#include <mcMd/neighbor/CellList.h>
+#include <mcMd/chemistry/Atom.h>
+#include <simp/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/random/Random.h>
+#include <util/containers/RArray.h>
+
+#include <iostream>
+
+using namespace Util;
+using namespace Simp;
+using namespace McMd;
+
+/*
+* Visitor that counts atoms and sums their type ids.
+*/
+class PackedCountVisitor
+{
+public:
+
+   PackedCountVisitor()
+    : nAtom(0),
+      typeIdSum(0),
+      nCell(0)
+   {}
+
+   void operator () (const Vector* positions, const int* typeIds,
+                     Atom* const * atomPtrs, int n)
+   {
+      for (int j = 0; j < n; ++j) {
+         typeIdSum += typeIds[j];
+      }
+      nAtom += n;
+      ++nCell;
+   }
+
+   int nAtom;
+   int typeIdSum;
+   int nCell;
+
+};
+
+class PackedCellListTest : public UnitTest
+{
+
+private:
+
+   PackedCellList cellList;
+   Boundary boundary;
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testSetup()
+   {
+      printMethod(TEST_FUNC);
+      double cutoff  = 1.2;
+
+      Vector Lin(2.0, 3.0, 4.0);
+      boundary.setOrthorhombic(Lin);
+      cellList.setAtomCapacity(10);
+      cellList.setup(boundary, cutoff);
+
+      TEST_ASSERT(cellList.gridDimension(0) == 1);
+      TEST_ASSERT(cellList.gridDimension(1) == 2);
+      TEST_ASSERT(cellList.gridDimension(2) == 3);
+      TEST_ASSERT(cellList.totCells() == 6);
+      TEST_ASSERT(cellList.nAtom() == 0);
+      TEST_ASSERT(cellList.isValid(0));
+   }
+
+   void testAddDeleteAtoms()
+   {
+      printMethod(TEST_FUNC);
+      const int nAtom = 20;
+      Vector    pos;
+      Random    random;
+      double    cutoff  = 1.2;
+      int       i;
+
+      Vector Lin(2.0, 3.0, 4.0);
+      boundary.setOrthorhombic(Lin);
+      cellList.setAtomCapacity(nAtom);
+      cellList.setup(boundary, cutoff);
+
+      RArray<Atom>  atoms;
+      Atom::allocate(nAtom, atoms);
+
+      random.setSeed(1098640);
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(i % 2);
+         atoms[i].position() = pos;
+         cellList.addAtom(atoms[i]);
+      }
+
+      try {
+         cellList.isValid(nAtom);
+      }
+      catch (Exception e) {
+         e.write(std::cout);
+         TEST_ASSERT(0);
+      }
+
+      // Delete every third atom
+      int nDeleted = 0;
+      for (i = 0; i < nAtom; i += 3) {
+         cellList.deleteAtom(atoms[i]);
+         ++nDeleted;
+      }
+      TEST_ASSERT(cellList.nAtom() == nAtom - nDeleted);
+
+      try {
+         cellList.isValid(nAtom - nDeleted);
+      }
+      catch (Exception e) {
+         e.write(std::cout);
+         TEST_ASSERT(0);
+      }
+
+      Atom::deallocate();
+   }
+
+   void testGrow()
+   {
+      printMethod(TEST_FUNC);
+      const int nAtom = 100;
+      Vector    pos;
+      Random    random;
+      double    cutoff  = 1.2;
+      int       i, j;
+
+      // A single cell, so all atoms must share it
+      Vector Lin(2.0, 2.0, 2.0);
+      boundary.setOrthorhombic(Lin);
+      cellList.setAtomCapacity(nAtom);
+      cellList.setup(boundary, cutoff);
+      TEST_ASSERT(cellList.totCells() == 1);
+      int oldCapacity = cellList.cellCapacity();
+      TEST_ASSERT(oldCapacity < nAtom);
+
+      RArray<Atom>  atoms;
+      Atom::allocate(nAtom, atoms);
+
+      random.setSeed(1098640);
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(1);
+         atoms[i].position() = pos;
+         cellList.addAtom(atoms[i]);
+      }
+      TEST_ASSERT(cellList.cellCapacity() >= nAtom);
+
+      try {
+         cellList.isValid(nAtom);
+      }
+      catch (Exception e) {
+         e.write(std::cout);
+         TEST_ASSERT(0);
+      }
+
+      // Each packed atom pointer must be a distinct atom
+      PackedCountVisitor visitor;
+      cellList.visitNeighbors(atoms[0].position(), visitor);
+      TEST_ASSERT(visitor.nCell == 1);
+      TEST_ASSERT(visitor.nAtom == nAtom);
+      for (i = 0; i < nAtom; ++i) {
+         for (j = i + 1; j < nAtom; ++j) {
+            TEST_ASSERT(cellList.atomPtrs_[i] != cellList.atomPtrs_[j]);
+         }
+      }
+
+      Atom::deallocate();
+   }
+
+   void testUpdateAtom()
+   {
+      printMethod(TEST_FUNC);
+      const int nAtom = 20;
+      Vector    pos;
+      Random    random;
+      double    cutoff  = 1.2;
+      int       i, j;
+
+      Vector Lin(4.0, 5.0, 6.0);
+      boundary.setOrthorhombic(Lin);
+      cellList.setAtomCapacity(nAtom);
+      cellList.setup(boundary, cutoff);
+
+      RArray<Atom>  atoms;
+      Atom::allocate(nAtom, atoms);
+
+      random.setSeed(1098640);
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(0);
+         atoms[i].position() = pos;
+         cellList.addAtom(atoms[i]);
+      }
+
+      // Move and retype atoms, with and without changes of cell
+      for (j = 0; j < 5; ++j) {
+         for (i = 0; i < nAtom; ++i) {
+            boundary.randomPosition(random, pos);
+            atoms[i].position() = pos;
+            atoms[i].setTypeId(j % 3);
+            cellList.updateAtom(atoms[i]);
+         }
+         try {
+            cellList.isValid(nAtom);
+         }
+         catch (Exception e) {
+            e.write(std::cout);
+            TEST_ASSERT(0);
+         }
+      }
+
+      // An atom that is not in the list is ignored
+      cellList.deleteAtom(atoms[0]);
+      cellList.updateAtom(atoms[0]);
+      TEST_ASSERT(cellList.isValid(nAtom - 1));
+
+      Atom::deallocate();
+   }
+
+   void testVisitNeighbors()
+   {
+      printMethod(TEST_FUNC);
+      const int nAtom = 200;
+      Vector    pos;
+      Random    random;
+      double    cutoff  = 1.2;
+      int       i, j, k;
+
+      // Grids with 1, 2 and more than 2 cells along different axes
+      Vector Lin(1.5, 3.0, 6.5);
+      boundary.setOrthorhombic(Lin);
+      cellList.setAtomCapacity(nAtom);
+      cellList.setup(boundary, cutoff);
+
+      CellList refList;
+      refList.setAtomCapacity(nAtom);
+      refList.setup(boundary, cutoff);
+
+      RArray<Atom>  atoms;
+      Atom::allocate(nAtom, atoms);
+
+      random.setSeed(1098640);
+      for (i = 0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(i % 3);
+         atoms[i].position() = pos;
+         cellList.addAtom(atoms[i]);
+         refList.addAtom(atoms[i]);
+      }
+
+      // Compare with neighbors found by a CellList
+      CellList::NeighborArray neighbors;
+      int typeIdSum;
+      for (k = 0; k < 20; ++k) {
+         boundary.randomPosition(random, pos);
+         PackedCountVisitor visitor;
+         cellList.visitNeighbors(pos, visitor);
+         refList.getNeighbors(pos, neighbors);
+         typeIdSum = 0;
+         for (j = 0; j < neighbors.size(); ++j) {
+            typeIdSum += neighbors[j]->typeId();
+         }
+         TEST_ASSERT(visitor.nAtom == neighbors.size());
+         TEST_ASSERT(visitor.typeIdSum == typeIdSum);
+      }
+
+      Atom::deallocate();
+   }
+
+};
+
+TEST_BEGIN(PackedCellListTest)
+TEST_ADD(PackedCellListTest, testSetup)
+TEST_ADD(PackedCellListTest, testAddDeleteAtoms)
+TEST_ADD(PackedCellListTest, testGrow)
+TEST_ADD(PackedCellListTest, testUpdateAtom)
+TEST_ADD(PackedCellListTest, testVisitNeighbors)
+TEST_END(PackedCellListTest)
+
+#endif
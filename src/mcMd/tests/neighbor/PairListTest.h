@@ -6,6 +6,7 @@
 #include <mcMd/neighbor/PairList.h>
 #include <mcMd/neighbor/PairIterator.h>
 #include <mcMd/chemistry/Atom.h>
+#include <mcMd/simulation/ThreadPool.h>
 #include <util/random/Random.h>
 
 #include <iostream>
@@ -156,12 +157,79 @@ public:
       Atom::deallocate();
    }
 
+   void testBeginRange()
+   {
+      printMethod(TEST_FUNC);
+      const int    nAtom = 20;
+      const double potentialCutoff  = 1.2;
+
+      Atom  *atom1Ptr, *atom2Ptr, *atom3Ptr, *atom4Ptr;
+      int    i, j, nPart, beginPair, endPair;
+
+      // Initialize Boundary
+      Vector Lin(2.0, 3.0, 4.0);
+      boundary.setOrthorhombic(Lin);  
+
+      // Initialize PairList
+      std::ifstream in;
+      openInputFile("in/PairList", in);
+      pairList.readParam(in);
+      pairList.initialize(nAtom, potentialCutoff);
+
+      // Allocate Atoms and place them at random
+      RArray<Atom>  atoms;
+      Atom::allocate(nAtom, atoms);
+      Vector pos;
+      Random random;
+      random.setSeed(1098640);
+      for (i=0; i < nAtom; ++i) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(1);
+         atoms[i].position() = pos;
+      }
+
+      // Build pair list
+      pairList.setup(boundary);
+      for (i=0; i < nAtom; ++i) {
+         pairList.addAtom(atoms[i]);
+      }
+      pairList.build(boundary);
+      TEST_ASSERT(pairList.nPair() > 0);
+
+      // Consecutive ranges must visit the same pairs as one full loop
+      PairIterator iter;
+      PairIterator rangeIter;
+      for (nPart = 1; nPart <= pairList.nPair() + 1; ++nPart) {
+         pairList.begin(iter);
+         for (i = 0; i < nPart; ++i) {
+            ThreadPool::partition(pairList.nPair(), nPart, i,
+                                  beginPair, endPair);
+            pairList.begin(rangeIter, beginPair, endPair);
+            for (j = beginPair; j < endPair; ++j) {
+               TEST_ASSERT(rangeIter.notEnd());
+               TEST_ASSERT(iter.notEnd());
+               rangeIter.getPair(atom1Ptr, atom2Ptr);
+               iter.getPair(atom3Ptr, atom4Ptr);
+               TEST_ASSERT(atom1Ptr == atom3Ptr);
+               TEST_ASSERT(atom2Ptr == atom4Ptr);
+               ++rangeIter;
+               ++iter;
+            }
+            TEST_ASSERT(rangeIter.isEnd());
+         }
+         TEST_ASSERT(iter.isEnd());
+      }
+
+      Atom::deallocate();
+   }
+
 };
 
 
 TEST_BEGIN(PairListTest)
 TEST_ADD(PairListTest, testInitialize)
 TEST_ADD(PairListTest, testBuild)
+TEST_ADD(PairListTest, testBeginRange)
 TEST_END(PairListTest)
 
 #endif
@@ -0,0 +1,127 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryReader.h"
+#include <mcMd/simulation/System.h>
+#include <mcMd/simulation/Simulation.h>
+#include <simp/species/Species.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+
+#include <ios>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryReader::CompressedTrajectoryReader(System &system)
+   : TrajectoryReader(system)
+   {}
+
+   /*
+   * Destructor.
+   */
+   CompressedTrajectoryReader::~CompressedTrajectoryReader()
+   {}
+
+   /*
+   * Open trajectory file and setup to read.
+   */
+   void CompressedTrajectoryReader::open(std::string filename)
+   {
+      // Open trajectory file, read header and frame index
+      simulation().fileMaster().openInputFile(filename, file_, 
+                                              std::ios::in | std::ios::binary);
+      decoder_.readHeader(file_);
+      
+      // Add all molecules to system and check consistency of nAtom.
+      addMolecules();
+      if (decoder_.nAtom() != nAtomTotal_) {
+         UTIL_THROW("Inconsistent values: nAtom != nAtomTotal_");
+      }
+     
+      // Allocate private arrays
+      if (!positions_.isAllocated()) {
+         positions_.allocate(nAtomTotal_);
+      } else 
+      if (nAtomTotal_ != positions_.capacity()) {
+         UTIL_THROW("Inconsistent values of atom capacity");
+      }
+      if (decoder_.hasVelocities() && !velocities_.isAllocated()) {
+         velocities_.allocate(nAtomTotal_);
+      }
+   }
+
+   /*
+   * Read frame, return false if end-of-file
+   */
+   bool CompressedTrajectoryReader::readFrame()
+   {
+      // Preconditions
+      if (!positions_.isAllocated()) {
+         UTIL_THROW("positions_ array is not allocated");
+      }
+
+      long iStep;
+      Vector* velocities = 0;
+      if (decoder_.hasVelocities()) {
+         velocities = velocities_.cArray();
+      }
+      if (!decoder_.readFrame(file_, iStep, boundary(), 
+                              positions_.cArray(), velocities)) {
+         return false;
+      }
+
+      // Assign atom positions, assuming ordered atom ids 
+      int iSpecies, iMol, id;
+      Species *speciesPtr;
+      Molecule::AtomIterator atomIter;
+      Molecule *molPtr;
+      id = 0;
+      for (iSpecies = 0; iSpecies < simulation().nSpecies(); ++iSpecies) {
+         speciesPtr = &simulation().species(iSpecies);
+         for (iMol = 0; iMol < speciesPtr->capacity(); ++iMol) {
+            molPtr = &system().molecule(iSpecies, iMol);
+            for (molPtr->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               boundary().transformGenToCart(positions_[id], 
+                                             atomIter->position());
+               if (velocities) {
+                  atomIter->velocity() = velocities_[id];
+               }
+               id++;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   /*
+   * Skip frames by seeking, using the frame index.
+   */
+   bool CompressedTrajectoryReader::skipFrames(int nFrame)
+   {
+      int iFrame = decoder_.iFrame() + nFrame;
+      if (iFrame > decoder_.nFrame()) {
+         decoder_.seekFrame(file_, decoder_.nFrame());
+         return false;
+      }
+      decoder_.seekFrame(file_, iFrame);
+      return true;
+   }
+
+   /*
+   * Close trajectory file.
+   */
+   void CompressedTrajectoryReader::close()
+   {  file_.close(); }
+
+}
@@ -0,0 +1,95 @@
+#ifndef MCMD_COMPRESSED_TRAJECTORY_READER_H
+#define MCMD_COMPRESSED_TRAJECTORY_READER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/trajectory/TrajectoryReader.h>            // base class
+#include <simp/trajectory/CompressedTrajectoryDecoder.h> // member
+#include <util/containers/DArray.h>                      // member 
+#include <util/space/Vector.h>                           // member 
+
+#include <fstream>
+
+namespace McMd
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * TrajectoryReader for a compressed, indexed trajectory file.
+   *
+   * Reads files written by DdMd::CompressedTrajectoryWriter and 
+   * McMd::CompressedTrajectoryWriter (see Simp::CompressedTrajectoryEncoder
+   * for the format). Like DdMdTrajectoryReader, this class assumes that 
+   * atom ids are ordered by species and molecule. Velocities are also 
+   * assigned if present in the file. Because the file is indexed, 
+   * skipFrames() seeks directly to the requested frame.
+   *
+   * \ingroup McMd_Trajectory_Module
+   */
+   class CompressedTrajectoryReader : public TrajectoryReader
+   {
+   
+   public:
+
+      /**
+      * Constructor. 
+      */
+      CompressedTrajectoryReader(System& system);
+
+      /** 
+      * Destructor.   
+      */
+      virtual ~CompressedTrajectoryReader();
+ 
+      /**
+      * Open trajectory file, read header and index, and allocate memory.
+      *
+      * \param filename trajectory file name
+      */
+      void open(std::string filename);
+
+      /**
+      * Read a single frame.
+      *
+      * \return true if this frame is available, false if end of file
+      */
+      bool readFrame();
+
+      /**
+      * Skip over the next nFrame frames by seeking.
+      *
+      * \param nFrame number of frames to skip
+      * \return true if successful, false if end of file was reached
+      */
+      bool skipFrames(int nFrame);
+
+      /**
+      * Close trajectory file.
+      */
+      void close();
+
+   private:
+
+      /// Trajectory file.
+      std::ifstream file_;
+
+      /// Decompression and frame index.
+      CompressedTrajectoryDecoder decoder_;
+
+      /// Generalized atom positions, indexed by id.
+      DArray<Vector> positions_;
+
+      /// Atom velocities, indexed by id (allocated only if in file).
+      DArray<Vector> velocities_;
+
+   }; 
+
+} 
+#endif
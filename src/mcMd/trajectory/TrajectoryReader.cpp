@@ -33,6 +33,17 @@ namespace McMd
    TrajectoryReader::~TrajectoryReader() 
    {}
 
+   /*
+   * Skip frames by reading them (default implementation).
+   */
+   bool TrajectoryReader::skipFrames(int nFrame)
+   {
+      for (int i = 0; i < nFrame; ++i) {
+         if (!readFrame()) return false;
+      }
+      return true;
+   }
+
    /*
    * Add all molecules and set nAtomTotal_.
    */
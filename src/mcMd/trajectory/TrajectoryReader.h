@@ -66,6 +66,18 @@ namespace McMd
       */
       virtual bool readFrame() = 0;
 
+      /**
+      * Skip over the next nFrame frames, without loading them.
+      *
+      * The default implementation calls readFrame() nFrame times.
+      * Readers for indexed file formats may override this to seek
+      * directly to the requested frame.
+      *
+      * \param nFrame number of frames to skip
+      * \return true if successful, false if end of file was reached
+      */
+      virtual bool skipFrames(int nFrame);
+
       /**
       * Close the trajectory file.
       */
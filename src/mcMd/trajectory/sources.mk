@@ -3,7 +3,8 @@ mcMd_trajectory_=\
     mcMd/trajectory/TrajectoryReaderFactory.cpp \
     mcMd/trajectory/DCDTrajectoryReader.cpp \
     mcMd/trajectory/LammpsDumpReader.cpp \
-    mcMd/trajectory/DdMdTrajectoryReader.cpp 
+    mcMd/trajectory/DdMdTrajectoryReader.cpp \
+    mcMd/trajectory/CompressedTrajectoryReader.cpp 
 
 mcMd_trajectory_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_trajectory_))
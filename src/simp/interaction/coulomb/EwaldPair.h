@@ -0,0 +1,422 @@
+#ifndef SIMP_EWALD_PAIR_H
+#define SIMP_EWALD_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <simp/interaction/coulomb/EwaldInteraction.h>
+#include <util/containers/DArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/global.h>
+
+#include <string>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   /**
+   * Sum of a short-range pair interaction and an Ewald r-space term.
+   *
+   * An EwaldPair<BarePair> adds the short range erfc(alpha r) part of
+   * the Ewald Coulomb interaction to a non-Coulombic pair interaction
+   * of type BarePair (e.g., LJPair). Because charges are properties of
+   * atom types, the sum is itself a pair interaction with the standard
+   * interface, and may be used as the template argument of any pair
+   * potential implementation template.
+   *
+   * The parameter file format is that of BarePair. The EwaldInteraction,
+   * which holds the Ewald parameters, and the charge of each atom type
+   * must be set by calling setEwaldInteraction() and setCharge() before
+   * the parameters are read. The Ewald r-space cutoff must be greater
+   * than or equal to the maximum cutoff of the BarePair interaction.
+   * Masked pairs, which are absent from the pair list, thus have no
+   * r-space Coulomb interaction, but still interact through the k-space
+   * sum, which is not corrected for exclusions.
+   *
+   * \ingroup Simp_Coulomb_Module
+   */
+   template <class BarePair>
+   class EwaldPair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      EwaldPair();
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value, allocate array of charge products.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Set the associated EwaldInteraction.
+      *
+      * \param ewaldInteraction Ewald parameters (owned elsewhere)
+      */
+      void setEwaldInteraction(const EwaldInteraction& ewaldInteraction);
+
+      /**
+      * Set the charge of one atom type.
+      *
+      * \pre nAtomType must be set, by calling setNAtomType().
+      *
+      * \param i  atom type index
+      * \param charge  electrical charge of atoms of type i
+      */
+      void setCharge(int i, double charge);
+
+      /**
+      * Read parameters of the bare pair interaction.
+      *
+      * \pre setNAtomType() and setEwaldInteraction() were called.
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load parameters of the bare pair interaction from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save parameters of the bare pair interaction to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter of the bare pair interaction.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      //@}
+      /// \name Accessors (required)
+      //@{
+
+      /**
+      * Returns total short-range energy for a single pair.
+      *
+      * \param rsq square of distance between particles
+      * \param i   type of particle 1
+      * \param j   type of particle 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of total short-range force to pair separation.
+      *
+      * Precondition: The square separation rsq must be less than
+      * cutoffSq(i, j).
+      *
+      * \param rsq square of distance between particles
+      * \param i type of particle 1
+      * \param j type of particle 2
+      * \return  force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * Equal to the square of the Ewald r-space cutoff for pairs of
+      * charged types, and to the bare cutoff for other pairs.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get a parameter of the bare pair interaction.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      //@}
+      /// \name Accessors (extra)
+      //@{
+
+      /**
+      * Get the bare (non-Coulombic) pair interaction.
+      */
+      const BarePair& barePair() const;
+
+      /**
+      * Get the product of charges for a pair of atom types.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double qProduct(int i, int j) const;
+
+      //@}
+
+   private:
+
+      /// Non-Coulombic pair interaction.
+      BarePair barePair_;
+
+      /// Charge of each atom type.
+      DArray<double> charges_;
+
+      /// Products of charges of atom type pairs.
+      DMatrix<double> qProduct_;
+
+      /// Square of cutoff for each type pair.
+      DMatrix<double> cutoffSq_;
+
+      /// Pointer to associated Ewald interaction.
+      const EwaldInteraction* ewaldPtr_;
+
+      /// Number of atom types.
+      int nAtomType_;
+
+      /// Have parameters been read or loaded?
+      bool isInitialized_;
+
+      /*
+      * Compute cutoffSq_ from charges and bare cutoffs.
+      */
+      void setCutoffs();
+
+   };
+
+   // Inline methods
+
+   /*
+   * Total short-range energy for one pair.
+   */
+   template <class BarePair>
+   inline
+   double EwaldPair<BarePair>::energy(double rsq, int i, int j) const
+   {
+      double energy = barePair_.energy(rsq, i, j);
+      double qq = qProduct_(i, j);
+      if (qq != 0.0 && rsq < ewaldPtr_->rSpaceCutoffSq()) {
+         energy += ewaldPtr_->rSpaceEnergy(rsq, qq);
+      }
+      return energy;
+   }
+
+   /*
+   * Total short-range force over distance for one pair.
+   */
+   template <class BarePair>
+   inline
+   double EwaldPair<BarePair>::forceOverR(double rsq, int i, int j) const
+   {
+      double f = 0.0;
+      if (rsq < barePair_.cutoffSq(i, j)) {
+         f = barePair_.forceOverR(rsq, i, j);
+      }
+      double qq = qProduct_(i, j);
+      if (qq != 0.0) {
+         f += ewaldPtr_->rSpaceForceOverR(rsq, qq);
+      }
+      return f;
+   }
+
+   /*
+   * Square of the cutoff for a type pair.
+   */
+   template <class BarePair>
+   inline
+   double EwaldPair<BarePair>::cutoffSq(int i, int j) const
+   {  return cutoffSq_(i, j); }
+
+   /*
+   * Product of charges for a type pair.
+   */
+   template <class BarePair>
+   inline
+   double EwaldPair<BarePair>::qProduct(int i, int j) const
+   {  return qProduct_(i, j); }
+
+   /*
+   * Get the bare pair interaction.
+   */
+   template <class BarePair>
+   inline
+   const BarePair& EwaldPair<BarePair>::barePair() const
+   {  return barePair_; }
+
+   // Non-inline methods
+
+   /*
+   * Constructor.
+   */
+   template <class BarePair>
+   EwaldPair<BarePair>::EwaldPair()
+    : barePair_(),
+      charges_(),
+      qProduct_(),
+      cutoffSq_(),
+      ewaldPtr_(0),
+      nAtomType_(0),
+      isInitialized_(false)
+   {  setClassName("EwaldPair"); }
+
+   /*
+   * Set nAtomType and allocate arrays.
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::setNAtomType(int nAtomType)
+   {
+      UTIL_CHECK(nAtomType > 0);
+      UTIL_CHECK(nAtomType_ == 0);
+      nAtomType_ = nAtomType;
+      barePair_.setNAtomType(nAtomType);
+      charges_.allocate(nAtomType);
+      qProduct_.allocate(nAtomType, nAtomType);
+      cutoffSq_.allocate(nAtomType, nAtomType);
+      for (int i = 0; i < nAtomType; ++i) {
+         charges_[i] = 0.0;
+         for (int j = 0; j < nAtomType; ++j) {
+            qProduct_(i, j) = 0.0;
+            cutoffSq_(i, j) = 0.0;
+         }
+      }
+   }
+
+   /*
+   * Set pointer to the associated EwaldInteraction.
+   */
+   template <class BarePair>
+   void
+   EwaldPair<BarePair>::setEwaldInteraction(const EwaldInteraction& ewald)
+   {  ewaldPtr_ = &ewald; }
+
+   /*
+   * Set the charge of atom type i, update charge products.
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::setCharge(int i, double charge)
+   {
+      UTIL_CHECK(nAtomType_ > 0);
+      UTIL_CHECK(i >= 0 && i < nAtomType_);
+      charges_[i] = charge;
+      for (int j = 0; j < nAtomType_; ++j) {
+         qProduct_(i, j) = charge*charges_[j];
+         qProduct_(j, i) = qProduct_(i, j);
+      }
+      if (isInitialized_) {
+         setCutoffs();
+      }
+   }
+
+   /*
+   * Read parameters of the bare pair interaction.
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::readParameters(std::istream &in)
+   {
+      UTIL_CHECK(nAtomType_ > 0);
+      UTIL_CHECK(ewaldPtr_);
+      bool nextIndent = false;
+      addParamComposite(barePair_, nextIndent);
+      barePair_.readParameters(in);
+      setCutoffs();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load parameters of the bare pair interaction from an archive.
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::loadParameters(Serializable::IArchive &ar)
+   {
+      UTIL_CHECK(nAtomType_ > 0);
+      UTIL_CHECK(ewaldPtr_);
+      bool nextIndent = false;
+      addParamComposite(barePair_, nextIndent);
+      barePair_.loadParameters(ar);
+      setCutoffs();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save parameters of the bare pair interaction to an archive.
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::save(Serializable::OArchive &ar)
+   {  barePair_.save(ar); }
+
+   /*
+   * Modify a parameter of the bare pair interaction.
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::set(std::string name, int i, int j, double value)
+   {
+      barePair_.set(name, i, j, value);
+      setCutoffs();
+   }
+
+   /*
+   * Get a parameter of the bare pair interaction.
+   */
+   template <class BarePair>
+   double EwaldPair<BarePair>::get(std::string name, int i, int j) const
+   {  return barePair_.get(name, i, j); }
+
+   /*
+   * Get maximum cutoff, equal to the Ewald r-space cutoff.
+   */
+   template <class BarePair>
+   double EwaldPair<BarePair>::maxPairCutoff() const
+   {  return ewaldPtr_->rSpaceCutoff(); }
+
+   /*
+   * Compute the cutoff for each type pair (private).
+   */
+   template <class BarePair>
+   void EwaldPair<BarePair>::setCutoffs()
+   {
+      if (ewaldPtr_->rSpaceCutoff() < barePair_.maxPairCutoff()) {
+         UTIL_THROW("Ewald rSpaceCutoff is less than maxPairCutoff");
+      }
+      for (int i = 0; i < nAtomType_; ++i) {
+         for (int j = 0; j < nAtomType_; ++j) {
+            if (qProduct_(i, j) != 0.0) {
+               cutoffSq_(i, j) = ewaldPtr_->rSpaceCutoffSq();
+            } else {
+               cutoffSq_(i, j) = barePair_.cutoffSq(i, j);
+            }
+         }
+      }
+   }
+
+}
+#endif
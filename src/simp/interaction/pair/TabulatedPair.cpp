@@ -0,0 +1,376 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TabulatedPair.h"
+#include <util/containers/GArray.h>
+#include <util/misc/Log.h>
+#ifdef UTIL_MPI
+#include <util/mpi/MpiLoader.h>
+#endif
+
+#include <fstream>
+#include <iostream>
+#include <math.h>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   TabulatedPair::TabulatedPair()
+    : coeffs_(),
+      tableFileName_(),
+      maxPairCutoff_(0.0),
+      nPoint_(0),
+      nAtomType_(0),
+      isInitialized_(false)
+   {  setClassName("TabulatedPair"); }
+
+   /*
+   * Copy constructor.
+   */
+   TabulatedPair::TabulatedPair(const TabulatedPair& other)
+    : coeffs_(),
+      tableFileName_(other.tableFileName_),
+      maxPairCutoff_(other.maxPairCutoff_),
+      nPoint_(other.nPoint_),
+      nAtomType_(other.nAtomType_),
+      isInitialized_(other.isInitialized_)
+   {
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            cutoff_[i][j]   = other.cutoff_[i][j];
+            cutoffSq_[i][j] = other.cutoffSq_[i][j];
+            rsqMin_[i][j]   = other.rsqMin_[i][j];
+            invDRsq_[i][j]  = other.invDRsq_[i][j];
+            fFactor_[i][j]  = other.fFactor_[i][j];
+            offset_[i][j]   = other.offset_[i][j];
+         }
+      }
+      if (other.coeffs_.isAllocated()) {
+         coeffs_.allocate(other.coeffs_.capacity());
+         for (i = 0; i < coeffs_.capacity(); ++i) {
+            coeffs_[i] = other.coeffs_[i];
+         }
+      }
+   }
+
+   /*
+   * Assignment operator.
+   */
+   TabulatedPair& TabulatedPair::operator = (const TabulatedPair& other)
+   {
+      tableFileName_ = other.tableFileName_;
+      maxPairCutoff_ = other.maxPairCutoff_;
+      nPoint_        = other.nPoint_;
+      nAtomType_     = other.nAtomType_;
+      isInitialized_ = other.isInitialized_;
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            cutoff_[i][j]   = other.cutoff_[i][j];
+            cutoffSq_[i][j] = other.cutoffSq_[i][j];
+            rsqMin_[i][j]   = other.rsqMin_[i][j];
+            invDRsq_[i][j]  = other.invDRsq_[i][j];
+            fFactor_[i][j]  = other.fFactor_[i][j];
+            offset_[i][j]   = other.offset_[i][j];
+         }
+      }
+      if (other.coeffs_.isAllocated()) {
+         if (!coeffs_.isAllocated()) {
+            coeffs_.allocate(other.coeffs_.capacity());
+         }
+         UTIL_CHECK(coeffs_.capacity() == other.coeffs_.capacity());
+         for (i = 0; i < coeffs_.capacity(); ++i) {
+            coeffs_[i] = other.coeffs_[i];
+         }
+      }
+      return *this;
+   }
+
+   /*
+   * Set nAtomType
+   */
+   void TabulatedPair::setNAtomType(int nAtomType)
+   {
+      if (nAtomType <= 0) {
+         UTIL_THROW("nAtomType <= 0");
+      }
+      if (nAtomType > MaxAtomType) {
+         UTIL_THROW("nAtomType > TabulatedPair::MaxAtomType");
+      }
+      nAtomType_ = nAtomType;
+   }
+
+   /*
+   * Read table file name and grid size, then read tables.
+   */
+   void TabulatedPair::readParameters(std::istream &in)
+   {
+      // Preconditions
+      if (nAtomType_ <= 0) {
+         UTIL_THROW( "nAtomType must be set before readParam");
+      }
+      UTIL_CHECK(!coeffs_.isAllocated());
+
+      read<std::string>(in, "tableFile", tableFileName_);
+      read<int>(in, "nPoint", nPoint_);
+      if (nPoint_ < 2) {
+         UTIL_THROW("nPoint must be at least 2");
+      }
+
+      int nTable = nAtomType_*(nAtomType_ + 1)/2;
+      coeffs_.allocate(4*(nPoint_ - 1)*nTable);
+
+      // Read and resample tables on the io processor
+      if (isIoProcessor()) {
+         std::ifstream file(tableFileName_.c_str());
+         if (file.fail()) {
+            Log::file() << "tableFile = " << tableFileName_ << std::endl;
+            UTIL_THROW("Error opening pair table file");
+         }
+         readTables(file);
+         file.close();
+      }
+
+      #ifdef UTIL_MPI
+      // Broadcast tables to all other processors
+      if (hasIoCommunicator()) {
+         ioCommunicator().Bcast(cutoff_[0], MaxAtomType*MaxAtomType,
+                                MPI::DOUBLE, 0);
+         ioCommunicator().Bcast(rsqMin_[0], MaxAtomType*MaxAtomType,
+                                MPI::DOUBLE, 0);
+         ioCommunicator().Bcast(&coeffs_[0], coeffs_.capacity(),
+                                MPI::DOUBLE, 0);
+      }
+      #endif
+
+      setDerived();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Read all tables from file and compute spline coefficients (private).
+   *
+   * For each type pair i >= j, the file contains a line "i j nRow"
+   * followed by nRow lines "r energy force", with increasing r > 0.
+   * Values between input rows are interpolated by cubic Hermite
+   * polynomials in r, using the forces as slopes, and sampled at nPoint_
+   * equally spaced values of rsq between the first and last rows.
+   */
+   void TabulatedPair::readTables(std::istream& in)
+   {
+      GArray<double> r;
+      GArray<double> v;
+      GArray<double> f;
+      double rsq, dRsq, x, h, s, s2, s3;
+      double e0, e1, d0, d1, dvdr;
+      double* c;
+      int i, j, it, jt, nRow, k, m, offset;
+
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j <= i; ++j) {
+
+            // Read one table
+            in >> it >> jt >> nRow;
+            if (in.fail()) {
+               UTIL_THROW("Error reading table header");
+            }
+            if (it != i || jt != j) {
+               Log::file() << "Expected types " << i << " " << j
+                           << ", found " << it << " " << jt << std::endl;
+               UTIL_THROW("Incorrect type indices in pair table");
+            }
+            if (nRow < 2) {
+               UTIL_THROW("Pair table must contain at least 2 rows");
+            }
+            r.clear();
+            v.clear();
+            f.clear();
+            for (k = 0; k < nRow; ++k) {
+               in >> x;
+               r.append(x);
+               in >> x;
+               v.append(x);
+               in >> x;
+               f.append(x);
+               if (in.fail()) {
+                  UTIL_THROW("Error reading pair table row");
+               }
+               if (k == 0 && r[0] <= 0.0) {
+                  UTIL_THROW("Separations in pair table must be positive");
+               }
+               if (k > 0 && r[k] <= r[k-1]) {
+                  UTIL_THROW("Separations in pair table must increase");
+               }
+            }
+            cutoff_[i][j] = r[nRow - 1];
+            rsqMin_[i][j] = r[0]*r[0];
+            dRsq = (cutoff_[i][j]*cutoff_[i][j] - rsqMin_[i][j])
+                 / double(nPoint_ - 1);
+
+            // Sample energy e and de/drsq at grid points, and compute
+            // cubic coefficients for each interval of the rsq grid.
+            offset = 4*(nPoint_ - 1)*(i*(i + 1)/2 + j);
+            k = 0;
+            e0 = d0 = 0.0;
+            for (m = 0; m < nPoint_; ++m) {
+               if (m == nPoint_ - 1) {
+                  rsq = cutoff_[i][j]*cutoff_[i][j];
+               } else {
+                  rsq = rsqMin_[i][j] + m*dRsq;
+               }
+               x = sqrt(rsq);
+               while (k < nRow - 2 && x > r[k+1]) {
+                  ++k;
+               }
+               h  = r[k+1] - r[k];
+               s  = (x - r[k])/h;
+               s2 = s*s;
+               s3 = s2*s;
+               e1 = (2.0*s3 - 3.0*s2 + 1.0)*v[k]
+                  - (s3 - 2.0*s2 + s)*h*f[k]
+                  + (3.0*s2 - 2.0*s3)*v[k+1]
+                  - (s3 - s2)*h*f[k+1];
+               dvdr = (6.0*s2 - 6.0*s)*(v[k] - v[k+1])/h
+                    - (3.0*s2 - 4.0*s + 1.0)*f[k]
+                    - (3.0*s2 - 2.0*s)*f[k+1];
+               d1 = 0.5*dvdr/x;
+               if (m > 0) {
+                  c = &coeffs_[offset + 4*(m - 1)];
+                  c[0] = e0;
+                  c[1] = dRsq*d0;
+                  c[2] = 3.0*(e1 - e0) - dRsq*(2.0*d0 + d1);
+                  c[3] = 2.0*(e0 - e1) + dRsq*(d0 + d1);
+               }
+               e0 = e1;
+               d0 = d1;
+            }
+
+            // Symmetrize
+            cutoff_[j][i] = cutoff_[i][j];
+            rsqMin_[j][i] = rsqMin_[i][j];
+         }
+      }
+   }
+
+   /*
+   * Compute quantities derived from cutoff_, rsqMin_ and nPoint_ (private).
+   */
+   void TabulatedPair::setDerived()
+   {
+      double dRsq;
+      int i, j;
+      maxPairCutoff_ = 0.0;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            cutoffSq_[i][j] = cutoff_[i][j]*cutoff_[i][j];
+            dRsq = (cutoffSq_[i][j] - rsqMin_[i][j])/double(nPoint_ - 1);
+            invDRsq_[i][j] = 1.0/dRsq;
+            fFactor_[i][j] = -2.0*invDRsq_[i][j];
+            if (i >= j) {
+               offset_[i][j] = 4*(nPoint_ - 1)*(i*(i + 1)/2 + j);
+            } else {
+               offset_[i][j] = 4*(nPoint_ - 1)*(j*(j + 1)/2 + i);
+            }
+            if (cutoff_[i][j] > maxPairCutoff_) {
+               maxPairCutoff_ = cutoff_[i][j];
+            }
+         }
+      }
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void TabulatedPair::loadParameters(Serializable::IArchive &ar)
+   {
+      // Preconditions
+      if (nAtomType_ <= 0) {
+         UTIL_THROW( "nAtomType must be set before loadParameters");
+      }
+      UTIL_CHECK(!coeffs_.isAllocated());
+
+      loadParameter<std::string>(ar, "tableFile", tableFileName_);
+      loadParameter<int>(ar, "nPoint", nPoint_);
+      int nTable = nAtomType_*(nAtomType_ + 1)/2;
+      coeffs_.allocate(4*(nPoint_ - 1)*nTable);
+
+      #ifdef UTIL_MPI
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(cutoff_[0], nAtomType_, nAtomType_, MaxAtomType);
+      loader.load(rsqMin_[0], nAtomType_, nAtomType_, MaxAtomType);
+      loader.load(&coeffs_[0], coeffs_.capacity());
+      #else
+      ar.unpack(cutoff_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.unpack(rsqMin_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.unpack(&coeffs_[0], coeffs_.capacity());
+      #endif
+
+      setDerived();
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void TabulatedPair::save(Serializable::OArchive &ar)
+   {
+      ar << tableFileName_;
+      ar << nPoint_;
+      ar.pack(cutoff_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(rsqMin_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(&coeffs_[0], coeffs_.capacity());
+   }
+
+   /*
+   * Get cutoff distance for a type pair.
+   */
+   double TabulatedPair::cutoff(int i, int j) const
+   {
+      assert(i >= 0 && i < nAtomType_);
+      assert(j >= 0 && j < nAtomType_);
+      return cutoff_[i][j];
+   }
+
+   /*
+   * Get number of grid points per table.
+   */
+   int TabulatedPair::nPoint() const
+   {  return nPoint_; }
+
+   /*
+   * Get maximum of pair cutoff distance, for all atom type pairs.
+   */
+   double TabulatedPair::maxPairCutoff() const
+   {  return maxPairCutoff_; }
+
+   /*
+   * Modify a parameter, identified by a string (not supported).
+   */
+   void TabulatedPair::set(std::string name, int i, int j, double value)
+   {  UTIL_THROW("TabulatedPair parameters cannot be modified"); }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double TabulatedPair::get(std::string name, int i, int j) const
+   {
+      double value = 0.0;
+      if (name == "cutoff") {
+         value = cutoff_[i][j];
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      return value;
+   }
+
+}
@@ -0,0 +1,288 @@
+#ifndef SIMP_TABULATED_PAIR_H
+#define SIMP_TABULATED_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+#include <string>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   /**
+   * Tabulated pair potential, interpolated by cubic splines.
+   *
+   * The energy for each pair of atom types is read from a table file
+   * that lists values of the energy and force at an increasing sequence
+   * of separations r. These data are resampled onto a uniform grid in
+   * the squared separation rsq, and stored as one cubic polynomial in
+   * rsq per grid interval. Evaluation of the energy or force thus
+   * requires no square root, and reads four consecutive coefficients
+   * from one block of memory, at a cost comparable to that of LJPair
+   * for any tabulated function.
+   *
+   * \sa \ref simp_interaction_pair_TabulatedPair_page "Parameter file format"
+   * \sa \ref simp_interaction_pair_interface_page
+   * \sa \ref simp_interaction_pair_page
+   *
+   * \ingroup Simp_Interaction_Pair_Module
+   */
+   class TabulatedPair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      TabulatedPair();
+
+      /**
+      * Copy constructor.
+      */
+      TabulatedPair(const TabulatedPair& other);
+
+      /**
+      * Assignment.
+      */
+      TabulatedPair& operator = (const TabulatedPair& other);
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read table file name and grid size, and read tables from file.
+      *
+      * \pre nAtomType must be set, by calling setNAtomType().
+      *
+      * \param in  input parameter stream
+      */
+      void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * Tables are loaded from the archive, so the table file is not
+      * read again on restart.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter, identified by a string.
+      *
+      * No tabulated parameter can be modified, so this always throws
+      * an Exception.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      //@}
+      /// \name Accessors (required)
+      //@{
+
+      /**
+      * Returns interaction energy for a single pair of particles.
+      *
+      * \param rsq square of distance between particles
+      * \param i   type of particle 1
+      * \param j   type of particle 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of scalar pair interaction force to pair separation.
+      *
+      * Multiply this quantity by the components of the separation vector
+      * to obtain the force vector. A positive value for the return value
+      * represents a repulsive force between a pair of particles.
+      *
+      * Precondition: The square separation rsq must be less than cutoffSq.
+      *
+      * \param rsq square of distance between particles
+      * \param i type of particle 1
+      * \param j type of particle 2
+      * \return  force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      * \return    cutoffSq_[i][j]
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * The only recognized name is "cutoff".
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      //@}
+      /// \name Accessors (extra)
+      //@{
+
+      /**
+      * Get cutoff distance (last tabulated separation) for a type pair.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double cutoff(int i, int j) const;
+
+      /**
+      * Get the number of grid points per table.
+      */
+      int nPoint() const;
+
+      //@}
+
+   private:
+
+      /// Maximum allowed value for nAtomType (# of particle types)
+      static const int MaxAtomType = 4;
+
+      /// Spline coefficients, 4 per interval, nPoint_ - 1 intervals per table.
+      DArray<double> coeffs_;
+
+      /// Name of the table file.
+      std::string tableFileName_;
+
+      // Parameters for different types of particle pairs
+      double cutoff_[MaxAtomType][MaxAtomType];   ///< last tabulated r
+      double cutoffSq_[MaxAtomType][MaxAtomType]; ///< square of cutoff
+      double rsqMin_[MaxAtomType][MaxAtomType];   ///< first tabulated rsq
+      double invDRsq_[MaxAtomType][MaxAtomType];  ///< inverse rsq spacing
+      double fFactor_[MaxAtomType][MaxAtomType];  ///< = -2*invDRsq
+      int    offset_[MaxAtomType][MaxAtomType];   ///< first coefficient
+
+      /**
+      * Maximum pair potential cutoff radius, for all monomer type pairs.
+      *
+      * Used in construction of a cell list or Verlet pair list.
+      */
+      double maxPairCutoff_;
+
+      /// Number of uniformly spaced rsq values in each table.
+      int    nPoint_;
+
+      /// Number of possible atom types.
+      int    nAtomType_;
+
+      /// Are all parameters and pointers initialized?
+      bool  isInitialized_;
+
+      /*
+      * Read table file, compute coefficients (call on io processor).
+      */
+      void readTables(std::istream& in);
+
+      /*
+      * Compute cutoffSq_, invDRsq_, fFactor_, offset_ and maxPairCutoff_.
+      */
+      void setDerived();
+
+      /*
+      * Get coefficients of the interval containing rsq, and its
+      * fractional coordinate t within that interval.
+      */
+      const double* interval(double rsq, int i, int j, double& t) const;
+
+   };
+
+   // inline methods
+
+   /*
+   * Get coefficients and fractional coordinate for interval (private).
+   */
+   inline
+   const double*
+   TabulatedPair::interval(double rsq, int i, int j, double& t) const
+   {
+      double x = (rsq - rsqMin_[i][j])*invDRsq_[i][j];
+      int k = int(x);
+      if (k < 0) {
+         k = 0;
+      } else
+      if (k > nPoint_ - 2) {
+         k = nPoint_ - 2;
+      }
+      t = x - double(k);
+      return &coeffs_[offset_[i][j] + 4*k];
+   }
+
+   /*
+   * Calculate interaction energy for a pair, as function of squared distance.
+   */
+   inline double TabulatedPair::energy(double rsq, int i, int j) const
+   {
+      if (rsq < cutoffSq_[i][j]) {
+         double t;
+         const double* c = interval(rsq, i, j, t);
+         return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+      } else {
+         return 0.0;
+      }
+   }
+
+   /*
+   * Calculate force/distance for a pair as function of squared distance.
+   */
+   inline double TabulatedPair::forceOverR(double rsq, int i, int j) const
+   {
+      double t;
+      const double* c = interval(rsq, i, j, t);
+      return fFactor_[i][j]*(c[1] + t*(2.0*c[2] + 3.0*t*c[3]));
+   }
+
+   /*
+   * Return square of cutoff for a specific atom type pair.
+   */
+   inline double TabulatedPair::cutoffSq(int i, int j) const
+   {  return cutoffSq_[i][j]; }
+
+}
+#endif
@@ -0,0 +1,326 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "StructureFactorMesh.h"
+#include <util/math/Constants.h>
+#include <util/format/Dbl.h>
+#include <util/global.h>
+
+#include <cmath>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   // Definition of static constant
+   const int StructureFactorMesh::MaxOrder;
+
+   /*
+   * Constructor.
+   */
+   StructureFactorMesh::StructureFactorMesh()
+    : grid_(),
+      input_(),
+      output_(),
+      sums_(),
+      qSums_(),
+      counts_(),
+      gridDimensions_(),
+      plan_(0),
+      dq_(0.0),
+      qMax_(0.0),
+      nMode_(0),
+      order_(0),
+      nPoint_(0),
+      nBin_(0),
+      nSample_(0),
+      isAllocated_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   StructureFactorMesh::~StructureFactorMesh()
+   {
+      if (isAllocated_) {
+         fftw_destroy_plan(plan_);
+      }
+   }
+
+   /*
+   * Allocate mesh, create plan, and compute deconvolution factors.
+   */
+   void StructureFactorMesh::allocate(const IntVector& gridDimensions, 
+                                      int nMode, int order)
+   {
+      UTIL_CHECK(!isAllocated_);
+      UTIL_CHECK(nMode > 0);
+      if (order < 1 || order > MaxOrder) {
+         UTIL_THROW("Invalid B-spline order");
+      }
+      int i, j;
+      for (j = 0; j < Dimension; ++j) {
+         if (gridDimensions[j] < order || gridDimensions[j] < 2) {
+            UTIL_THROW("Grid dimension too small for B-spline order");
+         }
+      }
+      gridDimensions_ = gridDimensions;
+      nMode_ = nMode;
+      order_ = order;
+      int nx = gridDimensions_[0];
+      int ny = gridDimensions_[1];
+      int nz = gridDimensions_[2];
+      nPoint_ = nx*ny*nz;
+
+      grid_.allocate(nMode_*nPoint_);
+      input_.allocate(nPoint_);
+      output_.allocate(nx*ny*(nz/2 + 1));
+      fftw_complex* out = reinterpret_cast<fftw_complex*>(output_.cArray());
+      plan_ = fftw_plan_dft_r2c_3d(nx, ny, nz, input_.cArray(), out, 
+                                   FFTW_ESTIMATE);
+
+      // Inverse square of the transform of the assignment function,
+      // [sin(pi k/n)/(pi k/n)]^order, indexed by wavenumber index k
+      double x, w;
+      int n, k;
+      for (j = 0; j < Dimension; ++j) {
+         n = gridDimensions_[j];
+         correction_[j].allocate(n);
+         for (i = 0; i < n; ++i) {
+            k = (i <= n/2) ? i : i - n;
+            if (k == 0) {
+               correction_[j][i] = 1.0;
+            } else {
+               x = Constants::Pi*double(k)/double(n);
+               w = pow(sin(x)/x, order_);
+               correction_[j][i] = 1.0/(w*w);
+            }
+         }
+      }
+
+      isAllocated_ = true;
+      clearGrid();
+   }
+
+   /*
+   * Define spherical shells, allocate and clear accumulators.
+   */
+   void StructureFactorMesh::setBins(const Boundary& boundary)
+   {
+      UTIL_CHECK(isAllocated_);
+      double b, qNyquist;
+      dq_ = 0.0;
+      qMax_ = 0.0;
+      for (int j = 0; j < Dimension; ++j) {
+         b = boundary.reciprocalBasisVector(j).abs();
+         qNyquist = b*double(gridDimensions_[j]/2);
+         if (j == 0 || b < dq_) dq_ = b;
+         if (j == 0 || qNyquist < qMax_) qMax_ = qNyquist;
+      }
+      int nBin = int(qMax_/dq_ + 0.5) + 1;
+      if (sums_.isAllocated() && nBin != nBin_) {
+         sums_.deallocate();
+         qSums_.deallocate();
+         counts_.deallocate();
+      }
+      nBin_ = nBin;
+      if (!sums_.isAllocated()) {
+         sums_.allocate(nBin_*nMode_);
+         qSums_.allocate(nBin_);
+         counts_.allocate(nBin_);
+      }
+      clearAccumulators();
+   }
+
+   /*
+   * Clear accumulators.
+   */
+   void StructureFactorMesh::clearAccumulators()
+   {
+      int i;
+      for (i = 0; i < nBin_*nMode_; ++i) {
+         sums_[i] = 0.0;
+      }
+      for (i = 0; i < nBin_; ++i) {
+         qSums_[i] = 0.0;
+         counts_[i] = 0.0;
+      }
+      nSample_ = 0;
+   }
+
+   /*
+   * Set mesh densities to zero.
+   */
+   void StructureFactorMesh::clearGrid()
+   {
+      int size = nMode_*nPoint_;
+      for (int i = 0; i < size; ++i) {
+         grid_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Compute B-spline weights m[j] = M_n(w + j) for j = 0,..,n-1.
+   */
+   void StructureFactorMesh::bSplines(double w, double* m) const
+   {
+      int j, k;
+      double div;
+      if (order_ == 1) {
+         m[0] = 1.0;
+         return;
+      }
+      m[0] = w;
+      m[1] = 1.0 - w;
+      for (k = 3; k <= order_; ++k) {
+         div = 1.0/double(k - 1);
+         m[k-1] = div*(1.0 - w)*m[k-2];
+         for (j = k - 2; j > 0; --j) {
+            m[j] = div*((w + j)*m[j] + (k - w - j)*m[j-1]);
+         }
+         m[0] = div*w*m[0];
+      }
+   }
+
+   /*
+   * Add weights of one atom to the mesh.
+   *
+   * The atom contributes to grid point g with weight M_n(u - g), where
+   * u is the scaled position, for g = floor(u) - j, j = 0,...,n-1.
+   */
+   void StructureFactorMesh::spread(const Vector& position, 
+                                    const double* weights)
+   {
+      double m[Dimension][MaxOrder];
+      int index[Dimension][MaxOrder];
+      double u, w;
+      int i, j, k, n, base;
+
+      for (i = 0; i < Dimension; ++i) {
+         n = gridDimensions_[i];
+         u = position[i] - floor(position[i]);
+         u *= double(n);
+         base = int(u);
+         w = u - double(base);
+         bSplines(w, m[i]);
+         for (j = 0; j < order_; ++j) {
+            k = base - j;
+            if (k < 0) k += n;
+            if (k >= n) k -= n;
+            index[i][j] = k;
+         }
+      }
+
+      const int ny = gridDimensions_[1];
+      const int nz = gridDimensions_[2];
+      double wx, wxy, wxyz;
+      int ix, iy, iz, offset, mode;
+      for (ix = 0; ix < order_; ++ix) {
+         wx = m[0][ix];
+         for (iy = 0; iy < order_; ++iy) {
+            wxy = wx*m[1][iy];
+            offset = (index[0][ix]*ny + index[1][iy])*nz;
+            for (iz = 0; iz < order_; ++iz) {
+               wxyz = wxy*m[2][iz];
+               k = offset + index[2][iz];
+               for (mode = 0; mode < nMode_; ++mode) {
+                  grid_[mode*nPoint_ + k] += weights[mode]*wxyz;
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Transform each mode density and accumulate |rho(q)|^2/V in shells.
+   *
+   * The real-to-complex transform stores only wavevectors with
+   * 0 <= kz <= nz/2. Wavevectors with 0 < kz < nz/2 represent both q
+   * and -q, and so are counted twice.
+   */
+   void StructureFactorMesh::sample(const Boundary& boundary)
+   {
+      UTIL_CHECK(isAllocated_);
+      UTIL_CHECK(nBin_ > 0);
+      const int nx = gridDimensions_[0];
+      const int ny = gridDimensions_[1];
+      const int nz = gridDimensions_[2];
+      const int nzc = nz/2 + 1;
+      const Vector& b0 = boundary.reciprocalBasisVector(0);
+      const Vector& b1 = boundary.reciprocalBasisVector(1);
+      const Vector& b2 = boundary.reciprocalBasisVector(2);
+      const double volume = boundary.volume();
+      Vector q, qx, qxy;
+      double qAbs, cx, cxy, factor, multiplicity;
+      int i, mode, ix, iy, iz, kx, ky, kz, bin, k;
+
+      for (mode = 0; mode < nMode_; ++mode) {
+
+         // Copy mesh density for this mode and transform
+         const double* data = grid_.cArray() + mode*nPoint_;
+         for (i = 0; i < nPoint_; ++i) {
+            input_[i] = data[i];
+         }
+         fftw_execute(plan_);
+
+         // Deconvolve and accumulate in shells
+         for (ix = 0; ix < nx; ++ix) {
+            kx = (ix <= nx/2) ? ix : ix - nx;
+            qx.multiply(b0, double(kx));
+            cx = correction_[0][ix];
+            for (iy = 0; iy < ny; ++iy) {
+               ky = (iy <= ny/2) ? iy : iy - ny;
+               qxy.multiply(b1, double(ky));
+               qxy += qx;
+               cxy = cx*correction_[1][iy];
+               for (iz = 0; iz < nzc; ++iz) {
+                  kz = iz;
+                  q.multiply(b2, double(kz));
+                  q += qxy;
+                  qAbs = q.abs();
+                  if (qAbs == 0.0 || qAbs >= qMax_) continue;
+                  bin = int(qAbs/dq_ + 0.5);
+                  if (bin >= nBin_) continue;
+                  multiplicity = 2.0;
+                  if (iz == 0 || 2*iz == nz) multiplicity = 1.0;
+                  k = (ix*ny + iy)*nzc + iz;
+                  factor = cxy*correction_[2][iz]/volume;
+                  sums_[bin*nMode_ + mode] 
+                     += multiplicity*factor*std::norm(output_[k]);
+                  if (mode == 0) {
+                     qSums_[bin] += multiplicity*qAbs;
+                     counts_[bin] += multiplicity;
+                  }
+               }
+            }
+         }
+
+      }
+      ++nSample_;
+   }
+
+   /*
+   * Output average structure factors for each nonempty shell.
+   */
+   void StructureFactorMesh::output(std::ostream& out) const
+   {
+      int bin, mode;
+      double count;
+      for (bin = 0; bin < nBin_; ++bin) {
+         count = counts_[bin];
+         if (count > 0.0) {
+            out << Dbl(qSums_[bin]/count, 20, 8);
+            for (mode = 0; mode < nMode_; ++mode) {
+               out << Dbl(sums_[bin*nMode_ + mode]/count, 18, 8);
+            }
+            out << std::endl;
+         }
+      }
+   }
+
+}
@@ -0,0 +1,270 @@
+#ifndef SIMP_STRUCTURE_FACTOR_MESH_H
+#define SIMP_STRUCTURE_FACTOR_MESH_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <simp/boundary/Boundary.h>          // typedef
+#include <util/containers/DArray.h>          // member
+#include <util/space/IntVector.h>            // member
+#include <util/space/Vector.h>               // argument
+#include <util/global.h>
+
+#include <complex>
+#include <iostream>
+#include <fftw3.h>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   /**
+   * Mesh-based evaluation of spherically averaged structure factors.
+   *
+   * Each atom contributes a weight v(m, a) for each mode m to a regular
+   * mesh of grid points, using cardinal B-spline assignment functions
+   * of a specified order. The mesh density for each mode is Fourier
+   * transformed with FFTW, divided by the Fourier transform of the 
+   * assignment function, and the resulting values 
+   * \f$ |\rho_m(q)|^2/V \f$ are accumulated in spherical shells of 
+   * width \f$ \Delta q \f$, for all wavevectors with magnitude less 
+   * than the Nyquist limit of the mesh. The cost per sample is 
+   * O(N p^3 + M log M) for N atoms, order p and M grid points, rather 
+   * than O(NK) for K explicit wavevectors.
+   *
+   * The shell width \f$ \Delta q \f$ is the magnitude of the shortest
+   * reciprocal basis vector of the boundary passed to setBins().
+   *
+   * Usage: allocate() once, setBins() to clear the accumulators, and
+   * then, for each sample, clearGrid(), spread() for each atom, and
+   * sample(). The mesh data may be modified through grid() between 
+   * spread() and sample(), e.g., to sum contributions from several 
+   * processors.
+   *
+   * \ingroup Simp_Scattering_Module
+   */
+   class StructureFactorMesh
+   {
+
+   public:
+
+      /// Maximum order of the B-spline assignment function.
+      static const int MaxOrder = 7;
+
+      /**
+      * Constructor.
+      */
+      StructureFactorMesh();
+
+      /**
+      * Destructor (destroys the FFTW plan).
+      */
+      ~StructureFactorMesh();
+
+      /**
+      * Allocate the mesh and create the FFTW plan.
+      *
+      * \param gridDimensions  number of grid points in each direction
+      * \param nMode  number of weighted densities (modes)
+      * \param order  order of the B-spline assignment (1 <= order <= 7)
+      */
+      void allocate(const IntVector& gridDimensions, int nMode, int order);
+
+      /**
+      * Set the shell width and number of shells, and clear accumulators.
+      *
+      * \param boundary  periodic boundary used to define the shells
+      */
+      void setBins(const Boundary& boundary);
+
+      /**
+      * Clear accumulators, without changing the shells.
+      */
+      void clearAccumulators();
+
+      /**
+      * Set all mesh values to zero.
+      */
+      void clearGrid();
+
+      /**
+      * Add the contribution of one atom to the mesh.
+      *
+      * \param position  atom position, in generalized coordinates
+      * \param weights  array of nMode weights for this atom
+      */
+      void spread(const Vector& position, const double* weights);
+
+      /**
+      * Transform the mesh densities and increment the accumulators.
+      *
+      * \param boundary  current periodic boundary
+      */
+      void sample(const Boundary& boundary);
+
+      /**
+      * Write averaged structure factors, one line per nonempty shell.
+      *
+      * Each line contains the average wavenumber of the shell and the
+      * average structure factor for each mode.
+      *
+      * \param out  output stream
+      */
+      void output(std::ostream& out) const;
+
+      /**
+      * Serialize accumulators to or from an archive.
+      *
+      * \param ar  saving or loading archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Pointer to the mesh data (nMode blocks of nPoint values).
+      */
+      double* grid();
+
+      /**
+      * Number of elements in the mesh data array, nMode*nPoint.
+      */
+      int gridSize() const;
+
+      /**
+      * Number of grid points per mode.
+      */
+      int nPoint() const;
+
+      /**
+      * Number of modes.
+      */
+      int nMode() const;
+
+      /**
+      * Number of spherical shells.
+      */
+      int nBin() const;
+
+      /**
+      * Number of samples since the last clearAccumulators().
+      */
+      int nSample() const;
+
+   private:
+
+      typedef std::complex<double> DCMPLX;
+
+      /// Mesh densities, layout [mode][x][y][z].
+      DArray<double> grid_;
+
+      /// Real input array of the FFT (one mode).
+      DArray<double> input_;
+
+      /// Complex output array of the FFT, layout [x][y][z/2 + 1].
+      DArray<DCMPLX> output_;
+
+      /// Inverse square of 1D assignment transforms, for each direction.
+      DArray<double> correction_[Dimension];
+
+      /// Sum of |rho|^2/V, layout [shell][mode].
+      DArray<double> sums_;
+
+      /// Sum of wavenumbers in each shell.
+      DArray<double> qSums_;
+
+      /// Number of wavevectors in each shell, summed over samples.
+      DArray<double> counts_;
+
+      /// Number of grid points in each direction.
+      IntVector gridDimensions_;
+
+      /// FFTW real-to-complex plan.
+      fftw_plan plan_;
+
+      /// Shell width.
+      double dq_;
+
+      /// Maximum wavenumber.
+      double qMax_;
+
+      /// Number of modes.
+      int nMode_;
+
+      /// Order of the B-spline assignment function.
+      int order_;
+
+      /// Number of grid points.
+      int nPoint_;
+
+      /// Number of shells.
+      int nBin_;
+
+      /// Number of samples.
+      int nSample_;
+
+      /// Have the mesh and plan been allocated?
+      bool isAllocated_;
+
+      /*
+      * Compute B-spline weights m[j] = M_n(w + j), j = 0,...,n-1.
+      */
+      void bSplines(double w, double* m) const;
+
+   };
+
+   // Inline methods
+
+   inline double* StructureFactorMesh::grid()
+   {  return grid_.cArray(); }
+
+   inline int StructureFactorMesh::gridSize() const
+   {  return nMode_*nPoint_; }
+
+   inline int StructureFactorMesh::nPoint() const
+   {  return nPoint_; }
+
+   inline int StructureFactorMesh::nMode() const
+   {  return nMode_; }
+
+   inline int StructureFactorMesh::nBin() const
+   {  return nBin_; }
+
+   inline int StructureFactorMesh::nSample() const
+   {  return nSample_; }
+
+   /*
+   * Serialize accumulators to or from an archive.
+   */
+   template <class Archive>
+   void StructureFactorMesh::serialize(Archive& ar, 
+                                       const unsigned int version)
+   {
+      ar & dq_;
+      ar & qMax_;
+      ar & nBin_;
+      ar & nSample_;
+      if (Archive::is_loading()) {
+         if (sums_.isAllocated() && qSums_.capacity() != nBin_) {
+            sums_.deallocate();
+            qSums_.deallocate();
+            counts_.deallocate();
+         }
+         if (!sums_.isAllocated()) {
+            sums_.allocate(nBin_*nMode_);
+            qSums_.allocate(nBin_);
+            counts_.allocate(nBin_);
+         }
+      }
+      ar & sums_;
+      ar & qSums_;
+      ar & counts_;
+   }
+
+}
+#endif
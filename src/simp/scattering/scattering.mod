@@ -0,0 +1,13 @@
+namespace Simp{
+
+   /**
+   * \defgroup Simp_Scattering_Module Scattering
+   * \ingroup  Simp_Module
+   *
+   * \brief   Mesh-based scattering calculations shared by analyzers.
+   *
+   * Classes in this module require the FFTW library, and are compiled
+   * only if SIMP_FFTW is defined.
+   */
+ 
+}
@@ -0,0 +1,11 @@
+
+simp_scattering_=
+
+ifdef SIMP_FFTW
+simp_scattering_+=\
+    simp/scattering/StructureFactorMesh.cpp 
+endif
+
+simp_scattering_SRCS=$(addprefix $(SRC_DIR)/, $(simp_scattering_))
+simp_scattering_OBJS=$(addprefix $(BLD_DIR)/, $(simp_scattering_:.cpp=.o))
+
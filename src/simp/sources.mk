@@ -3,6 +3,8 @@ include $(SRC_DIR)/simp/interaction/sources.mk
 include $(SRC_DIR)/simp/species/sources.mk
 include $(SRC_DIR)/simp/ensembles/sources.mk
 include $(SRC_DIR)/simp/boundary/sources.mk
+include $(SRC_DIR)/simp/trajectory/sources.mk
+include $(SRC_DIR)/simp/scattering/sources.mk
 
 # Concatenate source file lists from subdirectories
 simp_=\
@@ -10,6 +12,8 @@ simp_=\
     $(simp_species_) \
     $(simp_ensembles_) \
     $(simp_boundary_) \
+    $(simp_trajectory_) \
+    $(simp_scattering_) \
 
 # Create lists of src and object files, with absolute paths
 simp_SRCS=\
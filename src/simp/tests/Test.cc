@@ -11,6 +11,10 @@
 #include "interaction/InteractionTestComposite.h"
 #include "species/SpeciesTestComposite.h"
 #include "boundary/BoundaryTestComposite.h"
+#include "trajectory/TrajectoryTestComposite.h"
+#ifdef SIMP_FFTW
+#include "scattering/ScatteringTestComposite.h"
+#endif
 #include <test/CompositeTestRunner.h>
 
 using namespace Simp;
@@ -19,6 +23,10 @@ TEST_COMPOSITE_BEGIN(SimpNsTestComposite)
 addChild(new InteractionTestComposite, "interaction/");
 addChild(new SpeciesTestComposite, "species/");
 addChild(new BoundaryTestComposite, "boundary/");
+addChild(new TrajectoryTestComposite, "trajectory/");
+#ifdef SIMP_FFTW
+addChild(new ScatteringTestComposite, "scattering/");
+#endif
 TEST_COMPOSITE_END
 
 
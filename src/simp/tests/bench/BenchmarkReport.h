@@ -0,0 +1,312 @@
+#ifndef SIMP_BENCHMARK_REPORT_H
+#define SIMP_BENCHMARK_REPORT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/GArray.h>
+#include <util/format/Dbl.h>
+#include <util/format/Int.h>
+#include <util/global.h>
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+using namespace Util;
+
+/**
+* Collection of benchmark timings, with JSON output and comparison.
+*
+* Each record gives the time per atom per repetition (ns/atom/step) and
+* the throughput in pairs per second (0 if not meaningful) for one kernel
+* applied to one synthetic system. Records are written as a JSON object
+* with one record per line, so that a file written by writeJson() can be
+* read back by compare() without a general JSON parser. 
+*
+* Benchmark programs in the tests/bench directories use this class.
+*/
+class BenchmarkReport
+{
+
+public:
+
+   /**
+   * Constructor.
+   */
+   BenchmarkReport()
+    : records_()
+   {}
+
+   /**
+   * Add a record.
+   *
+   * \param kernel  name of timed kernel (e.g., "McMd::PairList::build")
+   * \param system  name of system type (e.g., "lj" or "chain")
+   * \param nAtom   number of atoms (local atoms, in DdMd)
+   * \param density number density
+   * \param nRep    number of repetitions of the kernel
+   * \param time    total wall clock time for nRep repetitions (sec)
+   * \param nPair   number of pairs evaluated per repetition (or 0)
+   */
+   void add(const std::string& kernel, const std::string& system,
+            int nAtom, double density, int nRep, double time, double nPair)
+   {
+      Record record;
+      record.kernel = kernel;
+      record.system = system;
+      record.nAtom = nAtom;
+      record.density = density;
+      record.nRep = nRep;
+      record.nsPerAtomStep = 1.0E9*time/(double(nRep)*double(nAtom));
+      if (nPair > 0.0 && time > 0.0) {
+         record.pairsPerSecond = nPair*double(nRep)/time;
+      } else {
+         record.pairsPerSecond = 0.0;
+      }
+      records_.append(record);
+   }
+
+   /**
+   * Write a human readable table of all records.
+   *
+   * \param out output stream
+   */
+   void writeTable(std::ostream& out) const
+   {
+      out << std::left << std::setw(40) << "kernel" 
+          << std::setw(8) << "system" << std::right
+          << std::setw(10) << "nAtom" 
+          << std::setw(10) << "density" 
+          << std::setw(16) << "ns/atom/step" 
+          << std::setw(16) << "pairs/sec" << std::endl;
+      for (int i = 0; i < records_.size(); ++i) {
+         const Record& r = records_[i];
+         out << std::left << std::setw(40) << r.kernel
+             << std::setw(8) << r.system << std::right
+             << Int(r.nAtom, 10) 
+             << Dbl(r.density, 10, 4)
+             << Dbl(r.nsPerAtomStep, 16, 6)
+             << Dbl(r.pairsPerSecond, 16, 6) << std::endl;
+      }
+   }
+
+   /**
+   * Write all records as JSON.
+   *
+   * \param out output stream
+   */
+   void writeJson(std::ostream& out) const
+   {
+      out << "{\"benchmarks\":[" << std::endl;
+      for (int i = 0; i < records_.size(); ++i) {
+         const Record& r = records_[i];
+         out << "{\"kernel\":\"" << r.kernel << "\""
+             << ",\"system\":\"" << r.system << "\""
+             << ",\"nAtom\":" << r.nAtom
+             << ",\"density\":" << r.density
+             << ",\"nRep\":" << r.nRep
+             << ",\"nsPerAtomStep\":" << r.nsPerAtomStep
+             << ",\"pairsPerSecond\":" << r.pairsPerSecond << "}";
+         if (i < records_.size() - 1) {
+            out << ",";
+         }
+         out << std::endl;
+      }
+      out << "]}" << std::endl;
+   }
+
+   /**
+   * Compare records to a baseline file written by writeJson().
+   *
+   * For each record with a matching kernel, system, nAtom and density
+   * in the baseline, writes the ratio of the current to the baseline
+   * time per atom per step. A ratio greater than 1 + tolerance is 
+   * reported as a regression.
+   *
+   * \param baseline  input stream for baseline JSON file
+   * \param out  output stream for report
+   * \param tolerance  allowed fractional increase in time
+   * \return number of regressions
+   */
+   int compare(std::istream& baseline, std::ostream& out, 
+               double tolerance) const
+   {
+      // Read baseline records
+      GArray<Record> base;
+      Record record;
+      std::string line;
+      while (std::getline(baseline, line)) {
+         if (readRecord(line, record)) {
+            base.append(record);
+         }
+      }
+
+      // Compare
+      int nRegression = 0;
+      double ratio;
+      int i, j;
+      out << std::left << std::setw(40) << "kernel" 
+          << std::setw(8) << "system" << std::right
+          << std::setw(10) << "nAtom" 
+          << std::setw(10) << "density" 
+          << std::setw(12) << "ratio" << std::endl;
+      for (i = 0; i < records_.size(); ++i) {
+         const Record& r = records_[i];
+         for (j = 0; j < base.size(); ++j) {
+            if (matches(r, base[j])) break;
+         }
+         out << std::left << std::setw(40) << r.kernel
+             << std::setw(8) << r.system << std::right
+             << Int(r.nAtom, 10) 
+             << Dbl(r.density, 10, 4);
+         if (j == base.size()) {
+            out << "     (none)" << std::endl;
+            continue;
+         }
+         ratio = r.nsPerAtomStep/base[j].nsPerAtomStep;
+         out << Dbl(ratio, 12, 4);
+         if (ratio > 1.0 + tolerance) {
+            out << "   REGRESSION";
+            ++nRegression;
+         }
+         out << std::endl;
+      }
+      return nRegression;
+   }
+
+   /**
+   * Write table, write JSON, and compare to a baseline.
+   *
+   * JSON is written to file jsonFileName, or to std::cout if this is 
+   * empty. The table and comparison are written to std::cout if JSON 
+   * is written to a file, and otherwise to std::cerr, so that standard 
+   * output contains only JSON. A comparison is made only if 
+   * baselineFileName is not empty.
+   *
+   * \param jsonFileName  name of JSON output file (or empty)
+   * \param baselineFileName  name of baseline JSON file (or empty)
+   * \param tolerance  allowed fractional increase in time
+   * \return number of regressions
+   */
+   int output(const std::string& jsonFileName, 
+              const std::string& baselineFileName, 
+              double tolerance) const
+   {
+      std::ostream& log = jsonFileName.empty() ? std::cerr : std::cout;
+      log << std::endl;
+      writeTable(log);
+      log << std::endl;
+      if (jsonFileName.empty()) {
+         writeJson(std::cout);
+      } else {
+         std::ofstream file(jsonFileName.c_str());
+         if (!file.is_open()) {
+            UTIL_THROW("Error opening benchmark output file");
+         }
+         writeJson(file);
+      }
+      int nRegression = 0;
+      if (!baselineFileName.empty()) {
+         std::ifstream file(baselineFileName.c_str());
+         if (!file.is_open()) {
+            UTIL_THROW("Error opening benchmark baseline file");
+         }
+         log << std::endl;
+         nRegression = compare(file, log, tolerance);
+         log << std::endl << nRegression << " regressions" 
+             << std::endl;
+      }
+      return nRegression;
+   }
+
+   /**
+   * Number of records.
+   */
+   int size() const
+   {  return records_.size(); }
+
+private:
+
+   /*
+   * Results for one kernel and system.
+   */
+   struct Record
+   {
+      std::string kernel;
+      std::string system;
+      int nAtom;
+      double density;
+      int nRep;
+      double nsPerAtomStep;
+      double pairsPerSecond;
+   };
+
+   GArray<Record> records_;
+
+   /*
+   * Do two records describe the same kernel and system?
+   */
+   static bool matches(const Record& a, const Record& b)
+   {
+      if (a.kernel != b.kernel) return false;
+      if (a.system != b.system) return false;
+      if (a.nAtom != b.nAtom) return false;
+      double d = a.density - b.density;
+      return (d < 1.0E-6 && d > -1.0E-6);
+   }
+
+   /*
+   * Return string value of "key":"value" in line, or "" if absent.
+   */
+   static std::string stringValue(const std::string& line, 
+                                  const std::string& key)
+   {
+      std::string pattern = "\"" + key + "\":\"";
+      std::string::size_type begin = line.find(pattern);
+      if (begin == std::string::npos) return std::string();
+      begin += pattern.size();
+      std::string::size_type end = line.find('"', begin);
+      if (end == std::string::npos) return std::string();
+      return line.substr(begin, end - begin);
+   }
+
+   /*
+   * Return numerical value of "key":value in line, or 0 if absent.
+   */
+   static double numberValue(const std::string& line, 
+                             const std::string& key)
+   {
+      std::string pattern = "\"" + key + "\":";
+      std::string::size_type begin = line.find(pattern);
+      if (begin == std::string::npos) return 0.0;
+      begin += pattern.size();
+      return std::atof(line.c_str() + begin);
+   }
+
+   /*
+   * Read one line of a file written by writeJson().
+   */
+   static bool readRecord(const std::string& line, Record& record)
+   {
+      record.kernel = stringValue(line, "kernel");
+      if (record.kernel.empty()) return false;
+      record.system = stringValue(line, "system");
+      record.nAtom = int(numberValue(line, "nAtom"));
+      record.density = numberValue(line, "density");
+      record.nRep = int(numberValue(line, "nRep"));
+      record.nsPerAtomStep = numberValue(line, "nsPerAtomStep");
+      record.pairsPerSecond = numberValue(line, "pairsPerSecond");
+      return (record.nsPerAtomStep > 0.0);
+   }
+
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef TABULATED_PAIR_TEST_H
+#define TABULATED_PAIR_TEST_H
+
+#include <simp/interaction/pair/TabulatedPair.h>
+#include <simp/interaction/pair/DpdPair.h>
+#include <simp/tests/interaction/pair/PairTestTemplate.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace Util;
+using namespace Simp;
+
+class TabulatedPairTest : public PairTestTemplate<TabulatedPair>
+{
+
+protected:
+
+   using PairTestTemplate<TabulatedPair>::setNAtomType;
+   using PairTestTemplate<TabulatedPair>::readParamFile;
+   using PairTestTemplate<TabulatedPair>::forceOverR;
+   using PairTestTemplate<TabulatedPair>::energy;
+
+   // Analytic potential from which in/TabulatedPair.table was generated
+   DpdPair dpd_;
+
+public:
+
+   void setUp()
+   {
+      eps_ = 1.0E-6;
+      setNAtomType(2);
+      readParamFile("in/TabulatedPair");
+
+      std::ifstream in;
+      openInputFile("in/DpdPair", in);
+      dpd_.setNAtomType(2);
+      dpd_.readParameters(in);
+      in.close();
+   }
+
+   void testSetUp() 
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(interaction_.nPoint() == 401);
+      TEST_ASSERT(eq(interaction_.cutoff(0, 1), 1.0));
+      TEST_ASSERT(eq(interaction_.cutoffSq(1, 0), 1.0));
+      TEST_ASSERT(eq(interaction_.maxPairCutoff(), 1.0));
+      if (verbose() > 0) {
+         std::cout << std::endl; 
+         interaction_.writeParam(std::cout);
+      }
+   }
+
+   void testEnergy() 
+   {
+      printMethod(TEST_FUNC);
+      double rsq, diff;
+      int i, j, k;
+
+      for (i = 0; i < 2; ++i) {
+         for (j = 0; j < 2; ++j) {
+            for (k = 0; k < 20; ++k) {
+               rsq = 0.02 + 0.049*k;
+               diff = energy(rsq, i, j) - dpd_.energy(rsq, i, j);
+               TEST_ASSERT(fabs(diff) < 1.0E-5);
+               diff = forceOverR(rsq, i, j) - dpd_.forceOverR(rsq, i, j);
+               TEST_ASSERT(fabs(diff) < 1.0E-3);
+            }
+         }
+      }
+      TEST_ASSERT(eq(energy(1.21, 0, 1), 0.0));
+   }
+
+   void testForceOverR() 
+   {
+      printMethod(TEST_FUNC);
+      type1_ = 0;
+      type2_ = 1;
+
+      rsq_ = 0.25;
+      TEST_ASSERT(testForce());
+      rsq_ = 0.64;
+      TEST_ASSERT(testForce());
+
+      type1_ = 1;
+      type2_ = 1;
+      rsq_ = 0.49;
+      TEST_ASSERT(testForce());
+   }
+
+   void testSaveLoad() 
+   {
+      printMethod(TEST_FUNC);
+
+      Serializable::OArchive oar;
+      openOutputFile("out/serial", oar.file());
+      interaction_.save(oar);
+      oar.file().close();
+
+      Serializable::IArchive iar;
+      openInputFile("out/serial", iar.file());
+
+      TabulatedPair clone;
+      clone.setNAtomType(2);
+      clone.loadParameters(iar);
+
+      TEST_ASSERT(clone.nPoint() == interaction_.nPoint());
+      TEST_ASSERT(eq(interaction_.cutoff(0, 1), clone.cutoff(0, 1)));
+      TEST_ASSERT(eq(interaction_.energy(0.45, 0, 1), clone.energy(0.45, 0, 1)));
+      TEST_ASSERT(eq(interaction_.forceOverR(0.45, 0, 1), clone.forceOverR(0.45, 0, 1)));
+      TEST_ASSERT(eq(interaction_.energy(0.95, 1, 1), clone.energy(0.95, 1, 1)));
+      TEST_ASSERT(eq(interaction_.forceOverR(0.95, 1, 1), clone.forceOverR(0.95, 1, 1)));
+   }
+
+};
+
+TEST_BEGIN(TabulatedPairTest)
+TEST_ADD(TabulatedPairTest, testSetUp)
+TEST_ADD(TabulatedPairTest, testEnergy)
+TEST_ADD(TabulatedPairTest, testForceOverR)
+TEST_ADD(TabulatedPairTest, testSaveLoad)
+TEST_END(TabulatedPairTest)
+
+#endif
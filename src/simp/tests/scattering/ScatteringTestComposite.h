@@ -0,0 +1,12 @@
+#ifndef SIMP_SCATTERING_TEST_COMPOSITE_H
+#define SIMP_SCATTERING_TEST_COMPOSITE_H
+
+#include <test/CompositeTestRunner.h>
+
+#include "StructureFactorMeshTest.h"
+
+TEST_COMPOSITE_BEGIN(ScatteringTestComposite)
+TEST_COMPOSITE_ADD_UNIT(StructureFactorMeshTest);
+TEST_COMPOSITE_END
+
+#endif
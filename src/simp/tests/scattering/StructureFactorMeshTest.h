@@ -0,0 +1,145 @@
+#ifndef SIMP_STRUCTURE_FACTOR_MESH_TEST_H
+#define SIMP_STRUCTURE_FACTOR_MESH_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <simp/scattering/StructureFactorMesh.h>
+#include <simp/boundary/Boundary.h>
+#include <util/math/Constants.h>
+#include <util/containers/DArray.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+
+#include <sstream>
+#include <cmath>
+
+using namespace Util;
+using namespace Simp;
+
+class StructureFactorMeshTest : public UnitTest 
+{
+
+private:
+
+   static const int nAtom = 200;
+   static const int nShell = 3;
+
+   Boundary boundary;
+   DArray<Vector> positions;
+
+   /*
+   * Fill positions with scattered generalized coordinates in [0,1).
+   */
+   void makePositions()
+   {
+      double x;
+      for (int i = 0; i < nAtom; ++i) {
+         for (int j = 0; j < Dimension; ++j) {
+            x = 0.6180339887*double(i + 1) + 0.1*sin(double(7*i + 3*j));
+            x += 0.4142135624*double(j*i);
+            positions[i][j] = x - floor(x);
+         }
+      }
+   }
+
+   /*
+   * Average of |rho(q)|^2/V over all wavevectors in shells 1,..,nShell.
+   *
+   * For a cubic box, wavevector q = 2 pi k/L lies in shell int(|k| + 0.5).
+   */
+   void directSum(DArray<double>& q, DArray<double>& s)
+   {
+      const double twoPi = 2.0*Constants::Pi;
+      const double dq = twoPi/boundary.length(0);
+      const double volume = boundary.volume();
+      DArray<double> counts;
+      counts.allocate(nShell + 1);
+      int i, bin, kx, ky, kz;
+      for (i = 0; i <= nShell; ++i) {
+         q[i] = 0.0;
+         s[i] = 0.0;
+         counts[i] = 0.0;
+      }
+      double kAbs, phase, re, im;
+      for (kx = -nShell; kx <= nShell; ++kx) {
+         for (ky = -nShell; ky <= nShell; ++ky) {
+            for (kz = -nShell; kz <= nShell; ++kz) {
+               kAbs = sqrt(double(kx*kx + ky*ky + kz*kz));
+               bin = int(kAbs + 0.5);
+               if (bin == 0 || bin > nShell) continue;
+               re = 0.0;
+               im = 0.0;
+               for (i = 0; i < nAtom; ++i) {
+                  phase = twoPi*(kx*positions[i][0] 
+                                 + ky*positions[i][1]
+                                 + kz*positions[i][2]);
+                  re += cos(phase);
+                  im += sin(phase);
+               }
+               q[bin] += kAbs*dq;
+               s[bin] += (re*re + im*im)/volume;
+               counts[bin] += 1.0;
+            }
+         }
+      }
+      for (i = 1; i <= nShell; ++i) {
+         q[i] /= counts[i];
+         s[i] /= counts[i];
+      }
+   }
+
+public:
+
+   void setUp()
+   {
+      positions.allocate(nAtom);
+      boundary.setCubic(5.0);
+      makePositions();
+   }
+
+   void tearDown()
+   {}
+
+   void testCompareDirect()
+   {
+      printMethod(TEST_FUNC);
+
+      StructureFactorMesh mesh;
+      IntVector gridDimensions(32);
+      mesh.allocate(gridDimensions, 1, 5);
+      mesh.setBins(boundary);
+      TEST_ASSERT(mesh.nBin() > nShell);
+
+      double weight = 1.0;
+      mesh.clearGrid();
+      for (int i = 0; i < nAtom; ++i) {
+         mesh.spread(positions[i], &weight);
+      }
+      mesh.sample(boundary);
+      TEST_ASSERT(mesh.nSample() == 1);
+
+      DArray<double> q, s;
+      q.allocate(nShell + 1);
+      s.allocate(nShell + 1);
+      directSum(q, s);
+
+      // Shell 0 contains only q = 0, which is omitted from the output
+      std::stringstream out;
+      mesh.output(out);
+      double qMesh, sMesh;
+      for (int bin = 1; bin <= nShell; ++bin) {
+         out >> qMesh >> sMesh;
+         TEST_ASSERT(!out.fail());
+         TEST_ASSERT(std::abs(qMesh - q[bin]) < 1.0E-6*q[bin]);
+         TEST_ASSERT(std::abs(sMesh - s[bin]) < 1.0E-5*s[bin]);
+      }
+   }
+
+};
+
+TEST_BEGIN(StructureFactorMeshTest)
+TEST_ADD(StructureFactorMeshTest, testCompareDirect)
+TEST_END(StructureFactorMeshTest)
+
+#endif
@@ -0,0 +1,9 @@
+#include "ScatteringTestComposite.h"
+
+int main() 
+{
+   ScatteringTestComposite runner;
+   runner.run();
+
+   return 0;
+}
@@ -0,0 +1,14 @@
+
+simp_tests_scattering_=
+
+ifdef SIMP_FFTW
+simp_tests_scattering_+=simp/tests/scattering/Test.cc
+endif
+
+simp_tests_scattering_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(simp_tests_scattering_))
+simp_tests_scattering_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(simp_tests_scattering_:.cc=.o))
+simp_tests_scattering_EXES=\
+     $(addprefix $(BLD_DIR)/, $(simp_tests_scattering_:.cc=))
+
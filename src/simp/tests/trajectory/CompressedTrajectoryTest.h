@@ -0,0 +1,218 @@
+#ifndef SIMP_COMPRESSED_TRAJECTORY_TEST_H
+#define SIMP_COMPRESSED_TRAJECTORY_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <simp/trajectory/CompressedTrajectoryEncoder.h>
+#include <simp/trajectory/CompressedTrajectoryDecoder.h>
+#include <simp/boundary/Boundary.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+#include <fstream>
+#include <cmath>
+
+using namespace Util;
+using namespace Simp;
+
+class CompressedTrajectoryTest : public UnitTest 
+{
+
+private:
+
+   static const int nAtom = 150;
+   static const int nFrame = 5;
+
+   Boundary boundary;
+   DArray<Vector> positions;
+   DArray<Vector> velocities;
+   DArray<Vector> inPositions;
+   DArray<Vector> inVelocities;
+
+   /*
+   * Fill positions and velocities for frame iFrame.
+   *
+   * Some generalized coordinates lie outside [0,1), to test wrapping.
+   */
+   void makeFrame(int iFrame)
+   {
+      double x;
+      for (int i = 0; i < nAtom; ++i) {
+         for (int j = 0; j < Dimension; ++j) {
+            x = 0.01*i + 0.37*j + 0.05*iFrame + 0.002*sin(double(i*j + 1));
+            positions[i][j] = x - 1.0;
+            velocities[i][j] = 2.0*cos(double(3*i + j + iFrame));
+         }
+      }
+   }
+
+   /*
+   * Write a trajectory, with or without an index.
+   */
+   void writeFile(const char* filename, double velocityPrecision,
+                  bool hasIndex)
+   {
+      CompressedTrajectoryEncoder encoder;
+      std::ofstream file;
+      openOutputFile(filename, file);
+      encoder.setPositionBits(16);
+      encoder.setVelocityPrecision(velocityPrecision);
+      encoder.writeHeader(file, nAtom);
+      for (int iFrame = 0; iFrame < nFrame; ++iFrame) {
+         makeFrame(iFrame);
+         encoder.writeFrame(file, 10*iFrame, boundary, 
+                            positions.cArray(), velocities.cArray());
+      }
+      TEST_ASSERT(encoder.nFrame() == nFrame);
+      if (hasIndex) {
+         encoder.writeIndex(file);
+      }
+      file.close();
+   }
+
+   /*
+   * Compare decoded frame iFrame to the original.
+   */
+   bool checkFrame(int iFrame, bool hasVelocities, double velocityPrecision)
+   {
+      const double dr = 0.5/double(1 << 16) + 1.0E-10;
+      double x, y, d;
+      makeFrame(iFrame);
+      for (int i = 0; i < nAtom; ++i) {
+         for (int j = 0; j < Dimension; ++j) {
+            x = inPositions[i][j];
+            if (x < 0.0 || x >= 1.0) return false;
+            y = positions[i][j];
+            d = x - (y - floor(y));
+            if (d > 0.5) d -= 1.0;
+            if (d < -0.5) d += 1.0;
+            if (fabs(d) > dr) return false;
+            if (hasVelocities) {
+               d = inVelocities[i][j] - velocities[i][j];
+               if (fabs(d) > 0.5*velocityPrecision + 1.0E-10) return false;
+            }
+         }
+      }
+      return true;
+   }
+
+public:
+
+   void setUp()
+   {
+      Vector lengths;
+      lengths[0] = 2.0;
+      lengths[1] = 3.0;
+      lengths[2] = 4.0;
+      boundary.setOrthorhombic(lengths);
+      positions.allocate(nAtom);
+      velocities.allocate(nAtom);
+      inPositions.allocate(nAtom);
+      inVelocities.allocate(nAtom);
+   }
+
+   void tearDown()
+   {}
+
+   void testZigzag() 
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(zigzagEncode(0) == 0);
+      TEST_ASSERT(zigzagEncode(-1) == 1);
+      TEST_ASSERT(zigzagEncode(1) == 2);
+      TEST_ASSERT(zigzagEncode(-2) == 3);
+      for (int i = -1000; i <= 1000; ++i) {
+         TEST_ASSERT(zigzagDecode(zigzagEncode(i)) == i);
+      }
+      TEST_ASSERT(nBitRequired(0) == 0);
+      TEST_ASSERT(nBitRequired(1) == 1);
+      TEST_ASSERT(nBitRequired(255) == 8);
+      TEST_ASSERT(nBitRequired(256) == 9);
+   }
+
+   void testReadWrite() 
+   {
+      printMethod(TEST_FUNC);
+      const double velocityPrecision = 0.001;
+      writeFile("tmp/velocities.trj", velocityPrecision, true);
+
+      CompressedTrajectoryDecoder decoder;
+      std::ifstream file;
+      openInputFile("tmp/velocities.trj", file);
+      decoder.readHeader(file);
+      TEST_ASSERT(decoder.nAtom() == nAtom);
+      TEST_ASSERT(decoder.nFrame() == nFrame);
+      TEST_ASSERT(decoder.hasVelocities());
+
+      Boundary inBoundary;
+      long iStep;
+      for (int iFrame = 0; iFrame < nFrame; ++iFrame) {
+         TEST_ASSERT(decoder.frameStep(iFrame) == 10*iFrame);
+         TEST_ASSERT(decoder.readFrame(file, iStep, inBoundary, 
+                     inPositions.cArray(), inVelocities.cArray()));
+         TEST_ASSERT(iStep == 10*iFrame);
+         TEST_ASSERT(inBoundary.lengths() == boundary.lengths());
+         TEST_ASSERT(checkFrame(iFrame, true, velocityPrecision));
+      }
+      TEST_ASSERT(!decoder.readFrame(file, iStep, inBoundary, 
+                  inPositions.cArray(), inVelocities.cArray()));
+   }
+
+   void testSeek() 
+   {
+      printMethod(TEST_FUNC);
+      writeFile("tmp/positions.trj", 0.0, true);
+
+      CompressedTrajectoryDecoder decoder;
+      std::ifstream file;
+      openInputFile("tmp/positions.trj", file);
+      decoder.readHeader(file);
+      TEST_ASSERT(decoder.nFrame() == nFrame);
+      TEST_ASSERT(!decoder.hasVelocities());
+
+      Boundary inBoundary;
+      long iStep;
+      int order[nFrame] = {3, 1, 4, 0, 2};
+      for (int k = 0; k < nFrame; ++k) {
+         decoder.seekFrame(file, order[k]);
+         TEST_ASSERT(decoder.readFrame(file, iStep, inBoundary, 
+                     inPositions.cArray(), 0));
+         TEST_ASSERT(iStep == 10*order[k]);
+         TEST_ASSERT(checkFrame(order[k], false, 0.0));
+         TEST_ASSERT(decoder.iFrame() == order[k] + 1);
+      }
+   }
+
+   void testScanWithoutIndex() 
+   {
+      printMethod(TEST_FUNC);
+      writeFile("tmp/noindex.trj", 0.0, false);
+
+      CompressedTrajectoryDecoder decoder;
+      std::ifstream file;
+      openInputFile("tmp/noindex.trj", file);
+      decoder.readHeader(file);
+      TEST_ASSERT(decoder.nFrame() == nFrame);
+
+      Boundary inBoundary;
+      long iStep;
+      decoder.seekFrame(file, nFrame - 1);
+      TEST_ASSERT(decoder.readFrame(file, iStep, inBoundary, 
+                  inPositions.cArray(), 0));
+      TEST_ASSERT(iStep == 10*(nFrame - 1));
+      TEST_ASSERT(checkFrame(nFrame - 1, false, 0.0));
+      TEST_ASSERT(!decoder.readFrame(file, iStep, inBoundary, 
+                  inPositions.cArray(), 0));
+   }
+
+};
+
+TEST_BEGIN(CompressedTrajectoryTest)
+TEST_ADD(CompressedTrajectoryTest, testZigzag)
+TEST_ADD(CompressedTrajectoryTest, testReadWrite)
+TEST_ADD(CompressedTrajectoryTest, testSeek)
+TEST_ADD(CompressedTrajectoryTest, testScanWithoutIndex)
+TEST_END(CompressedTrajectoryTest)
+
+#endif
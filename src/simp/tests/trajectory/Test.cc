@@ -0,0 +1,9 @@
+#include "TrajectoryTestComposite.h"
+
+int main() 
+{
+   TrajectoryTestComposite runner;
+   runner.run();
+
+   return 0;
+}
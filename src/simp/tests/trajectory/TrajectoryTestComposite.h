@@ -0,0 +1,12 @@
+#ifndef SIMP_TRAJECTORY_TEST_COMPOSITE_H
+#define SIMP_TRAJECTORY_TEST_COMPOSITE_H
+
+#include <test/CompositeTestRunner.h>
+
+#include "CompressedTrajectoryTest.h"
+
+TEST_COMPOSITE_BEGIN(TrajectoryTestComposite)
+TEST_COMPOSITE_ADD_UNIT(CompressedTrajectoryTest);
+TEST_COMPOSITE_END
+
+#endif
@@ -0,0 +1,10 @@
+
+simp_tests_trajectory_=simp/tests/trajectory/Test.cc
+
+simp_tests_trajectory_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(simp_tests_trajectory_))
+simp_tests_trajectory_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(simp_tests_trajectory_:.cc=.o))
+simp_tests_trajectory_EXES=\
+     $(addprefix $(BLD_DIR)/, $(simp_tests_trajectory_:.cc=))
+
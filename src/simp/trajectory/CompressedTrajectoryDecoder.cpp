@@ -0,0 +1,280 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryDecoder.h"
+#include "CompressedTrajectoryEncoder.h"
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/global.h>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   typedef CompressedTrajectoryEncoder Encoder;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryDecoder::CompressedTrajectoryDecoder()
+    : buffer_(),
+      offsets_(),
+      steps_(),
+      velocityPrecision_(0.0),
+      endOffset_(0),
+      bits_(0),
+      nBits_(0),
+      cursor_(0),
+      nAtom_(0),
+      positionBits_(0),
+      iFrame_(0),
+      hasVelocities_(false)
+   {}
+
+   /*
+   * Read file header and index, position file at first frame.
+   */
+   void CompressedTrajectoryDecoder::readHeader(std::ifstream& file)
+   {
+      BinaryFileIArchive ar(file);
+      unsigned int magic;
+      int version, hasVelocities;
+      ar >> magic;
+      if (!file || magic != Encoder::FileMagic) {
+         UTIL_THROW("File is not a compressed trajectory file");
+      }
+      ar >> version;
+      if (version != Encoder::Version) {
+         UTIL_THROW("Unsupported compressed trajectory file version");
+      }
+      ar >> nAtom_;
+      ar >> positionBits_;
+      ar >> hasVelocities;
+      ar >> velocityPrecision_;
+      if (!file || nAtom_ < 0 || positionBits_ < 8 || positionBits_ > 30) {
+         UTIL_THROW("Invalid compressed trajectory file header");
+      }
+      hasVelocities_ = bool(hasVelocities);
+
+      long headerEnd = long(file.tellg());
+      file.seekg(0, std::ios::end);
+      long fileEnd = long(file.tellg());
+      if (!readIndex(file, headerEnd, fileEnd)) {
+         scanFrames(file, headerEnd, fileEnd);
+      }
+      seekFrame(file, 0);
+   }
+
+   /*
+   * Read the index at the end of the file, if present and consistent.
+   */
+   bool CompressedTrajectoryDecoder::readIndex(std::ifstream& file,
+                                               long headerEnd, long fileEnd)
+   {
+      const long tailSize = sizeof(long) + sizeof(unsigned int);
+      if (fileEnd - headerEnd < tailSize) return false;
+
+      BinaryFileIArchive ar(file);
+      long indexOffset;
+      unsigned int magic;
+      file.clear();
+      file.seekg(fileEnd - tailSize);
+      ar >> indexOffset;
+      ar >> magic;
+      if (!file || magic != Encoder::FileMagic) return false;
+      if (indexOffset < headerEnd || indexOffset >= fileEnd) return false;
+
+      long nFrame;
+      file.seekg(indexOffset);
+      ar >> magic;
+      ar >> nFrame;
+      if (!file || magic != Encoder::IndexMagic || nFrame < 0) return false;
+      long indexSize = sizeof(unsigned int) + (2*nFrame + 1)*sizeof(long);
+      if (indexOffset + indexSize + tailSize != fileEnd) return false;
+
+      long offset, iStep;
+      offsets_.clear();
+      steps_.clear();
+      for (long i = 0; i < nFrame; ++i) {
+         ar >> offset;
+         ar >> iStep;
+         offsets_.append(offset);
+         steps_.append(iStep);
+      }
+      endOffset_ = indexOffset;
+      return bool(file);
+   }
+
+   /*
+   * Construct the index by reading frame headers, skipping data.
+   *
+   * Scanning stops at the first incomplete or invalid frame.
+   */
+   void CompressedTrajectoryDecoder::scanFrames(std::ifstream& file,
+                                                long headerEnd, long fileEnd)
+   {
+      BinaryFileIArchive ar(file);
+      Boundary boundary;
+      unsigned int magic;
+      long offset, next, iStep, nByte;
+
+      offsets_.clear();
+      steps_.clear();
+      file.clear();
+      file.seekg(headerEnd);
+      offset = headerEnd;
+      while (offset < fileEnd) {
+         ar >> magic;
+         if (!file || magic != Encoder::FrameMagic) break;
+         ar >> iStep;
+         ar >> boundary;
+         ar >> nByte;
+         if (!file || nByte < 0) break;
+         next = long(file.tellg()) + nByte;
+         if (next > fileEnd) break;
+         offsets_.append(offset);
+         steps_.append(iStep);
+         file.seekg(next);
+         offset = next;
+      }
+      endOffset_ = offset;
+      file.clear();
+   }
+
+   /*
+   * Position the file at the beginning of frame iFrame.
+   */
+   void CompressedTrajectoryDecoder::seekFrame(std::ifstream& file,
+                                               int iFrame)
+   {
+      if (iFrame < 0 || iFrame > offsets_.size()) {
+         UTIL_THROW("Frame index out of range");
+      }
+      file.clear();
+      if (iFrame < offsets_.size()) {
+         file.seekg(offsets_[iFrame]);
+      } else {
+         file.seekg(endOffset_);
+      }
+      iFrame_ = iFrame;
+   }
+
+   /*
+   * Read and decompress the next frame.
+   */
+   bool CompressedTrajectoryDecoder::readFrame(std::ifstream& file,
+                                               long& iStep,
+                                               Boundary& boundary,
+                                               Vector* positions,
+                                               Vector* velocities)
+   {
+      if (iFrame_ >= offsets_.size()) return false;
+
+      BinaryFileIArchive ar(file);
+      unsigned int magic;
+      long nByte;
+      ar >> magic;
+      if (!file || magic != Encoder::FrameMagic) {
+         UTIL_THROW("Invalid frame in compressed trajectory file");
+      }
+      ar >> iStep;
+      ar >> boundary;
+      ar >> nByte;
+      buffer_.resize(int(nByte));
+      if (nByte > 0) {
+         file.read((char*)buffer_.cArray(), nByte);
+      }
+      if (!file) {
+         UTIL_THROW("Error reading frame of compressed trajectory file");
+      }
+
+      cursor_ = 0;
+      bits_ = 0;
+      nBits_ = 0;
+      decodePositions(positions);
+      if (hasVelocities_ && velocities) {
+         decodeVelocities(velocities);
+      }
+      ++iFrame_;
+      return true;
+   }
+
+   /*
+   * Return the next nBit bits from the buffer.
+   */
+   unsigned int CompressedTrajectoryDecoder::getBits(int nBit)
+   {
+      if (nBit > 16) {
+         unsigned int high = getBits(nBit - 16);
+         unsigned int low = getBits(16);
+         return (high << 16) | low;
+      }
+      if (nBit == 0) return 0u;
+      while (nBits_ < nBit) {
+         if (cursor_ >= buffer_.size()) {
+            UTIL_THROW("Corrupt frame in compressed trajectory file");
+         }
+         bits_ = (bits_ << 8) | (unsigned int)buffer_[cursor_];
+         ++cursor_;
+         nBits_ += 8;
+      }
+      nBits_ -= nBit;
+      unsigned int value = (bits_ >> nBits_) & ((1u << nBit) - 1u);
+      bits_ &= (1u << nBits_) - 1u;
+      return value;
+   }
+
+   /*
+   * Decompress generalized coordinates (see encodePositions).
+   *
+   * Each coordinate is placed at the center of its quantization bin.
+   */
+   void CompressedTrajectoryDecoder::decodePositions(Vector* positions)
+   {
+      const int blockSize = Encoder::BlockSize;
+      const unsigned int mask = (1u << positionBits_) - 1u;
+      const double h = 1.0/double(1u << positionBits_);
+      unsigned int q;
+      int begin, n, i, j, width;
+
+      for (begin = 0; begin < nAtom_; begin += blockSize) {
+         n = nAtom_ - begin;
+         if (n > blockSize) n = blockSize;
+         for (j = 0; j < Dimension; ++j) {
+            q = getBits(positionBits_);
+            positions[begin][j] = (double(q) + 0.5)*h;
+            width = int(getBits(5));
+            for (i = 1; i < n; ++i) {
+               q = (q + (unsigned int)zigzagDecode(getBits(width))) & mask;
+               positions[begin + i][j] = (double(q) + 0.5)*h;
+            }
+         }
+      }
+   }
+
+   /*
+   * Decompress velocities (see encodeVelocities).
+   */
+   void CompressedTrajectoryDecoder::decodeVelocities(Vector* velocities)
+   {
+      const int blockSize = Encoder::BlockSize;
+      int begin, n, i, j, width;
+
+      for (begin = 0; begin < nAtom_; begin += blockSize) {
+         n = nAtom_ - begin;
+         if (n > blockSize) n = blockSize;
+         for (j = 0; j < Dimension; ++j) {
+            width = int(getBits(6));
+            for (i = 0; i < n; ++i) {
+               velocities[begin + i][j]
+                  = velocityPrecision_*zigzagDecode(getBits(width));
+            }
+         }
+      }
+   }
+
+}
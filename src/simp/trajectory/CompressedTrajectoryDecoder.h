@@ -0,0 +1,189 @@
+#ifndef SIMP_COMPRESSED_TRAJECTORY_DECODER_H
+#define SIMP_COMPRESSED_TRAJECTORY_DECODER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <simp/boundary/Boundary.h>          // typedef
+#include <util/containers/GArray.h>          // member
+#include <util/space/Vector.h>               // argument
+
+#include <fstream>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   /**
+   * Reader for the compressed, indexed binary trajectory format.
+   *
+   * See CompressedTrajectoryEncoder for a description of the format.
+   * The readHeader() function reads the header and the frame index. If
+   * the file has no index, because the writer did not finish, the index
+   * is reconstructed by reading only the fixed-size header of each
+   * frame and skipping over its compressed data. Frames may then be
+   * read consecutively with readFrame(), or in any order by calling
+   * seekFrame() before readFrame().
+   *
+   * \ingroup Simp_Trajectory_Module
+   */
+   class CompressedTrajectoryDecoder
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CompressedTrajectoryDecoder();
+
+      /**
+      * Read file header and frame index.
+      *
+      * On return, the file is positioned at the first frame.
+      *
+      * \param file  input file, open in binary mode
+      */
+      void readHeader(std::ifstream& file);
+
+      /**
+      * Position the file at the beginning of a frame.
+      *
+      * \param file  input file
+      * \param iFrame  frame index (0 <= iFrame <= nFrame())
+      */
+      void seekFrame(std::ifstream& file, int iFrame);
+
+      /**
+      * Read and decompress the next frame.
+      *
+      * Positions are returned in generalized coordinates, in [0,1),
+      * indexed by atom id. If the velocities argument is null, or if
+      * the file contains no velocities, velocities are not returned.
+      *
+      * \param file  input file
+      * \param iStep  time step index (output)
+      * \param boundary  periodic boundary (output)
+      * \param positions  array of nAtom() positions (output)
+      * \param velocities  array of nAtom() velocities (output, or 0)
+      * \return true if a frame was read, false at end of trajectory
+      */
+      bool readFrame(std::ifstream& file, long& iStep, Boundary& boundary,
+                     Vector* positions, Vector* velocities);
+
+      /**
+      * Number of atoms in each frame.
+      */
+      int nAtom() const;
+
+      /**
+      * Number of frames in the file.
+      */
+      int nFrame() const;
+
+      /**
+      * Time step index of a frame, from the index.
+      *
+      * \param iFrame  frame index
+      */
+      long frameStep(int iFrame) const;
+
+      /**
+      * Index of the next frame to be read.
+      */
+      int iFrame() const;
+
+      /**
+      * Does the file contain velocities?
+      */
+      bool hasVelocities() const;
+
+   private:
+
+      /// Compressed data for one frame.
+      GArray<unsigned char> buffer_;
+
+      /// File offset of each frame.
+      GArray<long> offsets_;
+
+      /// Time step index of each frame.
+      GArray<long> steps_;
+
+      /// Resolution of velocity components.
+      double velocityPrecision_;
+
+      /// File offset of the end of the last frame.
+      long endOffset_;
+
+      /// Bits read from buffer_ but not yet used.
+      unsigned int bits_;
+
+      /// Number of bits in bits_.
+      int nBits_;
+
+      /// Index of the next byte of buffer_.
+      int cursor_;
+
+      /// Number of atoms.
+      int nAtom_;
+
+      /// Number of bits per generalized coordinate.
+      int positionBits_;
+
+      /// Index of the next frame.
+      int iFrame_;
+
+      /// Does the file contain velocities?
+      bool hasVelocities_;
+
+      /*
+      * Read the index at the end of the file, return false if absent.
+      */
+      bool readIndex(std::ifstream& file, long headerEnd, long fileEnd);
+
+      /*
+      * Construct the index by scanning frame headers.
+      */
+      void scanFrames(std::ifstream& file, long headerEnd, long fileEnd);
+
+      /*
+      * Return the next nBit bits of buffer_ (0 <= nBit <= 32).
+      */
+      unsigned int getBits(int nBit);
+
+      /*
+      * Decompress positions from buffer_.
+      */
+      void decodePositions(Vector* positions);
+
+      /*
+      * Decompress velocities from buffer_.
+      */
+      void decodeVelocities(Vector* velocities);
+
+   };
+
+   // Inline methods
+
+   inline int CompressedTrajectoryDecoder::nAtom() const
+   {  return nAtom_; }
+
+   inline int CompressedTrajectoryDecoder::nFrame() const
+   {  return offsets_.size(); }
+
+   inline long CompressedTrajectoryDecoder::frameStep(int iFrame) const
+   {  return steps_[iFrame]; }
+
+   inline int CompressedTrajectoryDecoder::iFrame() const
+   {  return iFrame_; }
+
+   inline bool CompressedTrajectoryDecoder::hasVelocities() const
+   {  return hasVelocities_; }
+
+}
+#endif
@@ -0,0 +1,267 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryEncoder.h"
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/global.h>
+
+#include <cmath>
+#include <climits>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   // Definitions of static constants
+   const unsigned int CompressedTrajectoryEncoder::FileMagic;
+   const unsigned int CompressedTrajectoryEncoder::FrameMagic;
+   const unsigned int CompressedTrajectoryEncoder::IndexMagic;
+   const int CompressedTrajectoryEncoder::Version;
+   const int CompressedTrajectoryEncoder::BlockSize;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryEncoder::CompressedTrajectoryEncoder()
+    : buffer_(),
+      offsets_(),
+      steps_(),
+      velocityPrecision_(0.0),
+      bits_(0),
+      nBits_(0),
+      nAtom_(0),
+      positionBits_(20)
+   {}
+
+   /*
+   * Set number of bits per generalized coordinate.
+   */
+   void CompressedTrajectoryEncoder::setPositionBits(int positionBits)
+   {
+      if (positionBits < 8 || positionBits > 30) {
+         UTIL_THROW("positionBits must be in range 8 <= positionBits <= 30");
+      }
+      positionBits_ = positionBits;
+   }
+
+   /*
+   * Set resolution of velocities (zero for no velocities).
+   */
+   void
+   CompressedTrajectoryEncoder::setVelocityPrecision(double velocityPrecision)
+   {
+      if (velocityPrecision < 0.0) {
+         UTIL_THROW("Negative velocityPrecision");
+      }
+      velocityPrecision_ = velocityPrecision;
+   }
+
+   /*
+   * Write file header.
+   */
+   void CompressedTrajectoryEncoder::writeHeader(std::ofstream& file,
+                                                 int nAtom)
+   {
+      UTIL_CHECK(nAtom >= 0);
+      nAtom_ = nAtom;
+      offsets_.clear();
+      steps_.clear();
+
+      BinaryFileOArchive ar(file);
+      unsigned int magic = FileMagic;
+      int version = Version;
+      int hasVelocities = int(velocityPrecision_ > 0.0);
+      ar << magic;
+      ar << version;
+      ar << nAtom_;
+      ar << positionBits_;
+      ar << hasVelocities;
+      ar << velocityPrecision_;
+   }
+
+   /*
+   * Compress and write one frame.
+   */
+   void CompressedTrajectoryEncoder::writeFrame(std::ofstream& file,
+                                                long iStep,
+                                                Boundary& boundary,
+                                                const Vector* positions,
+                                                const Vector* velocities)
+   {
+      // Compress atomic data
+      buffer_.clear();
+      bits_ = 0;
+      nBits_ = 0;
+      encodePositions(positions);
+      if (hasVelocities()) {
+         UTIL_CHECK(velocities);
+         encodeVelocities(velocities);
+      }
+      flushBits();
+
+      // Record position in index
+      offsets_.append(long(file.tellp()));
+      steps_.append(iStep);
+
+      // Write frame header and data
+      BinaryFileOArchive ar(file);
+      unsigned int magic = FrameMagic;
+      long nByte = buffer_.size();
+      ar << magic;
+      ar << iStep;
+      ar << boundary;
+      ar << nByte;
+      if (nByte > 0) {
+         file.write((const char*)buffer_.cArray(), nByte);
+      }
+   }
+
+   /*
+   * Write index of frame offsets.
+   */
+   void CompressedTrajectoryEncoder::writeIndex(std::ofstream& file)
+   {
+      BinaryFileOArchive ar(file);
+      long indexOffset = long(file.tellp());
+      unsigned int magic = IndexMagic;
+      long nFrame = offsets_.size();
+      ar << magic;
+      ar << nFrame;
+      for (int i = 0; i < offsets_.size(); ++i) {
+         ar << offsets_[i];
+         ar << steps_[i];
+      }
+      ar << indexOffset;
+      magic = FileMagic;
+      ar << magic;
+   }
+
+   /*
+   * Append lowest nBit bits of value to the buffer.
+   */
+   void CompressedTrajectoryEncoder::putBits(unsigned int value, int nBit)
+   {
+      if (nBit > 16) {
+         putBits(value >> 16, nBit - 16);
+         putBits(value & 0xFFFFu, 16);
+         return;
+      }
+      if (nBit == 0) return;
+      bits_ = (bits_ << nBit) | (value & ((1u << nBit) - 1u));
+      nBits_ += nBit;
+      while (nBits_ >= 8) {
+         nBits_ -= 8;
+         buffer_.append((unsigned char)((bits_ >> nBits_) & 0xFFu));
+      }
+      bits_ &= (1u << nBits_) - 1u;
+   }
+
+   /*
+   * Pad the final byte with zeros.
+   */
+   void CompressedTrajectoryEncoder::flushBits()
+   {
+      if (nBits_ > 0) {
+         putBits(0u, 8 - nBits_);
+      }
+   }
+
+   /*
+   * Quantize and bit-pack generalized coordinates.
+   *
+   * For each block and direction, the first value is written with
+   * positionBits bits, followed by a 5 bit width w and the remaining
+   * differences between consecutive atoms, each as a w bit zigzag
+   * code. Differences are taken modulo 2^positionBits, so that an
+   * atom and its periodic image are treated as neighbors.
+   */
+   void
+   CompressedTrajectoryEncoder::encodePositions(const Vector* positions)
+   {
+      const unsigned int nBin = 1u << positionBits_;
+      const unsigned int mask = nBin - 1u;
+      const unsigned int half = nBin >> 1;
+      const double scale = double(nBin);
+      unsigned int q[BlockSize];
+      unsigned int z[BlockSize];
+      unsigned int zMax, delta;
+      double r;
+      int begin, n, i, j, width;
+
+      for (begin = 0; begin < nAtom_; begin += BlockSize) {
+         n = nAtom_ - begin;
+         if (n > BlockSize) n = BlockSize;
+         for (j = 0; j < Dimension; ++j) {
+
+            // Quantize
+            for (i = 0; i < n; ++i) {
+               r = positions[begin + i][j];
+               r -= floor(r);
+               q[i] = ((unsigned int)(r*scale)) & mask;
+            }
+
+            // Differences, as zigzag codes
+            zMax = 0;
+            for (i = 1; i < n; ++i) {
+               delta = (q[i] - q[i-1]) & mask;
+               if (delta >= half) {
+                  z[i] = zigzagEncode(-int(nBin - delta));
+               } else {
+                  z[i] = zigzagEncode(int(delta));
+               }
+               if (z[i] > zMax) zMax = z[i];
+            }
+            width = nBitRequired(zMax);
+
+            putBits(q[0], positionBits_);
+            putBits((unsigned int)width, 5);
+            for (i = 1; i < n; ++i) {
+               putBits(z[i], width);
+            }
+         }
+      }
+   }
+
+   /*
+   * Quantize and bit-pack velocities.
+   *
+   * For each block and direction, a 6 bit width w is followed by the
+   * zigzag code of each quantized velocity component, using w bits.
+   */
+   void
+   CompressedTrajectoryEncoder::encodeVelocities(const Vector* velocities)
+   {
+      const double maxValue = double(INT_MAX);
+      unsigned int z[BlockSize];
+      unsigned int zMax;
+      double v;
+      int begin, n, i, j, width;
+
+      for (begin = 0; begin < nAtom_; begin += BlockSize) {
+         n = nAtom_ - begin;
+         if (n > BlockSize) n = BlockSize;
+         for (j = 0; j < Dimension; ++j) {
+            zMax = 0;
+            for (i = 0; i < n; ++i) {
+               v = floor(velocities[begin + i][j]/velocityPrecision_ + 0.5);
+               if (v > maxValue || v < -maxValue) {
+                  UTIL_THROW("Velocity too large for velocityPrecision");
+               }
+               z[i] = zigzagEncode(int(v));
+               if (z[i] > zMax) zMax = z[i];
+            }
+            width = nBitRequired(zMax);
+            putBits((unsigned int)width, 6);
+            for (i = 0; i < n; ++i) {
+               putBits(z[i], width);
+            }
+         }
+      }
+   }
+
+}
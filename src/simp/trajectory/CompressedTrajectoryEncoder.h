@@ -0,0 +1,246 @@
+#ifndef SIMP_COMPRESSED_TRAJECTORY_ENCODER_H
+#define SIMP_COMPRESSED_TRAJECTORY_ENCODER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <simp/boundary/Boundary.h>          // typedef
+#include <util/containers/GArray.h>          // member
+#include <util/space/Vector.h>               // argument
+
+#include <fstream>
+
+namespace Simp
+{
+
+   using namespace Util;
+
+   /**
+   * Writer for the compressed, indexed binary trajectory format.
+   *
+   * A compressed trajectory file contains a header, a sequence of
+   * frames, and an index of frame offsets at the end of the file.
+   * Within each frame, atoms are listed in order of increasing atom id,
+   * and atom ids are implicit. Generalized (scaled) coordinates are
+   * quantized to positionBits bits, and the differences between the
+   * coordinates of consecutive atoms are bit-packed in blocks of
+   * BlockSize atoms, using the minimum number of bits for each block
+   * and Cartesian direction. Velocities, if present, are quantized in
+   * units of velocityPrecision and bit-packed in the same way, without
+   * differencing.
+   *
+   * File layout (native binary representation of each type):
+   * \code
+   *    header:  unsigned int  FileMagic
+   *             int           Version
+   *             int           nAtom
+   *             int           positionBits
+   *             int           hasVelocities (0 or 1)
+   *             double        velocityPrecision
+   *    frame:   unsigned int  FrameMagic
+   *             long          iStep
+   *             Boundary      boundary (serialized)
+   *             long          nByte
+   *             char[nByte]   bit-packed positions and velocities
+   *    index:   unsigned int  IndexMagic
+   *             long          nFrame
+   *             long[2*nFrame] file offset and iStep of each frame
+   *             long          offset of IndexMagic
+   *             unsigned int  FileMagic
+   * \endcode
+   *
+   * Usage: call writeHeader() once, writeFrame() once per frame, and
+   * writeIndex() once, immediately before the file is closed. The
+   * CompressedTrajectoryDecoder can read a file with a missing index
+   * (e.g., from a simulation that did not finish), by scanning frames.
+   *
+   * \ingroup Simp_Trajectory_Module
+   */
+   class CompressedTrajectoryEncoder
+   {
+
+   public:
+
+      /// Identifier at the beginning and end of a file.
+      static const unsigned int FileMagic = 0x4A525443;
+
+      /// Identifier at the beginning of each frame.
+      static const unsigned int FrameMagic = 0x4D415246;
+
+      /// Identifier at the beginning of the index.
+      static const unsigned int IndexMagic = 0x58444E49;
+
+      /// File format version.
+      static const int Version = 1;
+
+      /// Number of atoms in each block of bit-packed values.
+      static const int BlockSize = 64;
+
+      /**
+      * Constructor.
+      */
+      CompressedTrajectoryEncoder();
+
+      /**
+      * Set number of bits per generalized coordinate (8 to 30).
+      *
+      * \param positionBits  number of bits (default 20)
+      */
+      void setPositionBits(int positionBits);
+
+      /**
+      * Set velocity resolution, or disable velocities.
+      *
+      * \param velocityPrecision  resolution of velocity components,
+      *                           or zero for no velocities (default)
+      */
+      void setVelocityPrecision(double velocityPrecision);
+
+      /**
+      * Write the file header.
+      *
+      * \param file  output file, open in binary mode
+      * \param nAtom  number of atoms in every frame
+      */
+      void writeHeader(std::ofstream& file, int nAtom);
+
+      /**
+      * Compress and write one frame.
+      *
+      * Positions and velocities are indexed by atom id. Positions must
+      * be in generalized coordinates, and are wrapped into [0,1).
+      *
+      * \param file  output file
+      * \param iStep  time step index
+      * \param boundary  periodic boundary
+      * \param positions  array of nAtom generalized positions
+      * \param velocities  array of nAtom velocities (0 if none)
+      */
+      void writeFrame(std::ofstream& file, long iStep, Boundary& boundary,
+                      const Vector* positions, const Vector* velocities);
+
+      /**
+      * Write the frame index. Call once, after the last frame.
+      *
+      * \param file  output file
+      */
+      void writeIndex(std::ofstream& file);
+
+      /**
+      * Number of frames written since writeHeader().
+      */
+      int nFrame() const;
+
+      /**
+      * Are velocities written?
+      */
+      bool hasVelocities() const;
+
+   private:
+
+      /// Compressed data for one frame.
+      GArray<unsigned char> buffer_;
+
+      /// File offset of each frame.
+      GArray<long> offsets_;
+
+      /// Time step index of each frame.
+      GArray<long> steps_;
+
+      /// Resolution of velocity components.
+      double velocityPrecision_;
+
+      /// Bits not yet written to buffer_ (fewer than 8).
+      unsigned int bits_;
+
+      /// Number of bits in bits_.
+      int nBits_;
+
+      /// Number of atoms.
+      int nAtom_;
+
+      /// Number of bits per generalized coordinate.
+      int positionBits_;
+
+      /*
+      * Append the lowest nBit bits of value to buffer_ (0 <= nBit <= 32).
+      */
+      void putBits(unsigned int value, int nBit);
+
+      /*
+      * Pad the last byte with zero bits.
+      */
+      void flushBits();
+
+      /*
+      * Compress positions into buffer_.
+      */
+      void encodePositions(const Vector* positions);
+
+      /*
+      * Compress velocities into buffer_.
+      */
+      void encodeVelocities(const Vector* velocities);
+
+   };
+
+   // Inline methods
+
+   inline int CompressedTrajectoryEncoder::nFrame() const
+   {  return offsets_.size(); }
+
+   inline bool CompressedTrajectoryEncoder::hasVelocities() const
+   {  return (velocityPrecision_ > 0.0); }
+
+   /**
+   * Number of bits required to represent an unsigned integer.
+   *
+   * \ingroup Simp_Trajectory_Module
+   */
+   inline int nBitRequired(unsigned int value)
+   {
+      int n = 0;
+      while (value) {
+         ++n;
+         value >>= 1;
+      }
+      return n;
+   }
+
+   /**
+   * Map a signed integer onto an unsigned integer (zigzag encoding).
+   *
+   * Values 0, -1, 1, -2, 2, ... are mapped to 0, 1, 2, 3, 4, ... so
+   * that values of small magnitude require few bits.
+   *
+   * \ingroup Simp_Trajectory_Module
+   */
+   inline unsigned int zigzagEncode(int value)
+   {
+      if (value >= 0) {
+         return 2u*((unsigned int)value);
+      } else {
+         return 2u*((unsigned int)(-(value + 1))) + 1u;
+      }
+   }
+
+   /**
+   * Inverse of zigzagEncode.
+   *
+   * \ingroup Simp_Trajectory_Module
+   */
+   inline int zigzagDecode(unsigned int value)
+   {
+      if (value & 1u) {
+         return -((int)(value >> 1)) - 1;
+      } else {
+         return (int)(value >> 1);
+      }
+   }
+
+}
+#endif
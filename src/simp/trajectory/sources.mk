@@ -0,0 +1,8 @@
+
+simp_trajectory_=\
+    simp/trajectory/CompressedTrajectoryEncoder.cpp \
+    simp/trajectory/CompressedTrajectoryDecoder.cpp 
+
+simp_trajectory_SRCS=$(addprefix $(SRC_DIR)/, $(simp_trajectory_))
+simp_trajectory_OBJS=$(addprefix $(BLD_DIR)/, $(simp_trajectory_:.cpp=.o))
+
@@ -0,0 +1,15 @@
+namespace Simp{
+
+   /**
+   * \defgroup Simp_Trajectory_Module Trajectory
+   * \ingroup  Simp_Module
+   *
+   * \brief   Trajectory file encoding shared by all programs.
+   *
+   * Classes that encode and decode a compressed binary trajectory file
+   * format with a frame index. They are used by the trajectory writers
+   * and readers of the DdMd, McMd and Tools namespaces, so that a file 
+   * written by any program can be read by mcSim, mdSim or mdPp.
+   */
+ 
+}
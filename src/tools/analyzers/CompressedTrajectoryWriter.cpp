@@ -0,0 +1,119 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryWriter.h"
+#include <tools/storage/Configuration.h>
+#include <tools/chemistry/Atom.h>
+
+namespace Tools
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryWriter::CompressedTrajectoryWriter(Processor& processor)
+    : TrajectoryWriter(processor, true),
+      encoder_(),
+      positions_(),
+      velocities_(),
+      velocityPrecision_(0.0),
+      positionBits_(20),
+      nAtom_(0)
+   {  setClassName("CompressedTrajectoryWriter"); }
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryWriter::CompressedTrajectoryWriter(
+                                             Configuration& configuration,
+                                             FileMaster& fileMaster)
+    : TrajectoryWriter(configuration, fileMaster, true),
+      encoder_(),
+      positions_(),
+      velocities_(),
+      velocityPrecision_(0.0),
+      positionBits_(20),
+      nAtom_(0)
+   {  setClassName("CompressedTrajectoryWriter"); }
+
+   /*
+   * Destructor.
+   */
+   CompressedTrajectoryWriter::~CompressedTrajectoryWriter()
+   {}
+
+   /*
+   * Read parameters of base class, and optional compression parameters.
+   */
+   void CompressedTrajectoryWriter::readParameters(std::istream& in)
+   {
+      TrajectoryWriter::readParameters(in);
+      positionBits_ = 20;
+      readOptional<int>(in, "positionBits", positionBits_);
+      velocityPrecision_ = 0.0;
+      readOptional<double>(in, "velocityPrecision", velocityPrecision_);
+      encoder_.setPositionBits(positionBits_);
+      encoder_.setVelocityPrecision(velocityPrecision_);
+   }
+
+   /*
+   * Allocate arrays and write file header.
+   */
+   void CompressedTrajectoryWriter::writeHeader(std::ofstream &file)
+   {
+      nAtom_ = atoms().size();
+      if (positions_.isAllocated() && positions_.capacity() != nAtom_) {
+         positions_.deallocate();
+         if (velocities_.isAllocated()) {
+            velocities_.deallocate();
+         }
+      }
+      if (!positions_.isAllocated() && nAtom_ > 0) {
+         positions_.allocate(nAtom_);
+         if (encoder_.hasVelocities()) {
+            velocities_.allocate(nAtom_);
+         }
+      }
+      encoder_.writeHeader(file, nAtom_);
+   }
+
+   /*
+   * Write a frame, with atoms ordered by id.
+   */
+   void CompressedTrajectoryWriter::writeFrame(std::ofstream& file, long iStep)
+   {
+      if (atoms().size() != nAtom_) {
+         UTIL_THROW("Number of atoms changed since header was written");
+      }
+      bool hasVelocities = encoder_.hasVelocities();
+      int id;
+      AtomStorage::Iterator iter;
+      atoms().begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         id = iter->id;
+         if (id < 0 || id >= nAtom_) {
+            UTIL_THROW("Atom id out of range");
+         }
+         boundary().transformCartToGen(iter->position, positions_[id]);
+         if (hasVelocities) {
+            velocities_[id] = iter->velocity;
+         }
+      }
+      Vector* velocities = hasVelocities ? velocities_.cArray() : 0;
+      encoder_.writeFrame(file, iStep, boundary(), positions_.cArray(), 
+                          velocities);
+   }
+
+   /*
+   * Write the frame index at the end of the file.
+   */
+   void CompressedTrajectoryWriter::writeFooter(std::ofstream &file)
+   {  encoder_.writeIndex(file); }
+
+}
@@ -0,0 +1,120 @@
+#ifndef TOOLS_COMPRESSED_TRAJECTORY_WRITER_H
+#define TOOLS_COMPRESSED_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <tools/analyzers/TrajectoryWriter.h>            // base class
+#include <simp/trajectory/CompressedTrajectoryEncoder.h> // member
+#include <util/containers/DArray.h>                      // member
+#include <util/space/Vector.h>                           // member
+
+namespace Tools
+{
+
+   class Processor;
+   class Configuration;
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Write a trajectory in the compressed, indexed binary format.
+   *
+   * See Simp::CompressedTrajectoryEncoder for the file format. Atom 
+   * ids must be 0,...,nAtom-1. 
+   *
+   * Parameter file format:
+   * \code
+   *    interval           int
+   *    outputFileName     string
+   *    positionBits*      int    (20 by default)
+   *    velocityPrecision* double (0.0 by default, no velocities)
+   * \endcode
+   *
+   * \ingroup Tools_Analyzer_Module
+   */
+   class CompressedTrajectoryWriter : public TrajectoryWriter
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param processor parent Processor object
+      */
+      CompressedTrajectoryWriter(Processor& processor);
+
+      /**
+      * Constructor.
+      *
+      * \param configuration parent Configuration object
+      * \param fileMaster asssociated Util::FileMaster object 
+      */
+      CompressedTrajectoryWriter(Configuration& configuration, 
+                                 FileMaster& fileMaster);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CompressedTrajectoryWriter();
+
+      /**
+      * Read parameters.
+      *
+      * \param in input parameter file
+      */
+      virtual void readParameters(std::istream& in);
+
+   protected:
+
+      /**
+      * Write the file header.
+      *
+      * \param file output file stream
+      */
+      void writeHeader(std::ofstream &file);
+
+      /**
+      * Write a single frame.
+      *
+      * \param file output file stream
+      * \param iStep MD time step index
+      */
+      void writeFrame(std::ofstream &file, long iStep);
+
+      /**
+      * Write the frame index.
+      *
+      * \param file output file stream
+      */
+      void writeFooter(std::ofstream &file);
+
+   private:
+
+      /// Compression and file format.
+      CompressedTrajectoryEncoder encoder_;
+
+      /// Generalized positions, indexed by atom id.
+      DArray<Vector> positions_;
+
+      /// Velocities, indexed by atom id.
+      DArray<Vector> velocities_;
+
+      /// Resolution of velocity components (0 for no velocities).
+      double velocityPrecision_;
+
+      /// Number of bits per generalized coordinate.
+      int positionBits_;
+
+      /// Number of atoms in the file.
+      int nAtom_;
+
+   };
+
+}
+#endif
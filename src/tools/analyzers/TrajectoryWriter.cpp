@@ -156,12 +156,13 @@ namespace Tools
    }
 
    /*
-   * Clear sample counter and close file.
+   * Clear sample counter, write footer and close file.
    */
    void TrajectoryWriter::clear()
    {
       nSample_ = 0;
       if (outputFile_.is_open()) {
+         writeFooter(outputFile_);
          outputFile_.close();
       }
    }
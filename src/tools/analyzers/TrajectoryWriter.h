@@ -128,6 +128,17 @@ namespace Tools
       */
       virtual void writeFrame(std::ofstream& out, long iStep) = 0;
 
+      /**
+      * Write data that should appear once, at the end of the file.
+      *
+      * Called by clear() before the file is closed. Default 
+      * implementation is empty.
+      *
+      * \param out output file stream
+      */
+      virtual void writeFooter(std::ofstream& out)
+      {};
+
       /**
       * Get Boundary by reference.
       */
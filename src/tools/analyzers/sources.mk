@@ -4,6 +4,7 @@ tools_analyzers_=\
      tools/analyzers/AtomMSD.cpp \
      tools/analyzers/TrajectoryWriter.cpp \
      tools/analyzers/LammpsDumpWriter.cpp \
+     tools/analyzers/CompressedTrajectoryWriter.cpp \
      tools/analyzers/PairEnergy.cpp
 
 tools_analyzers_SRCS=\
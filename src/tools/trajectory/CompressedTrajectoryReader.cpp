@@ -0,0 +1,85 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CompressedTrajectoryReader.h" 
+#include <tools/storage/Configuration.h>
+#include <simp/boundary/Boundary.h>
+
+namespace Tools
+{
+
+   using namespace Util;
+   using namespace Simp;
+
+   /*
+   * Constructor.
+   */
+   CompressedTrajectoryReader::CompressedTrajectoryReader(Configuration& config)
+    : TrajectoryReader(config, true)
+   {  setClassName("CompressedTrajectoryReader"); }
+
+   /*
+   * Destructor.
+   */
+   CompressedTrajectoryReader::~CompressedTrajectoryReader()
+   {}
+
+   /*
+   * Read header and index, allocate arrays indexed by id.
+   */
+   void CompressedTrajectoryReader::readHeader(std::ifstream &file)
+   {
+      decoder_.readHeader(file);
+      int nAtom = decoder_.nAtom();
+      if (positions_.isAllocated() && positions_.capacity() != nAtom) {
+         positions_.deallocate();
+         if (velocities_.isAllocated()) {
+            velocities_.deallocate();
+         }
+      }
+      if (!positions_.isAllocated() && nAtom > 0) {
+         positions_.allocate(nAtom);
+         if (decoder_.hasVelocities()) {
+            velocities_.allocate(nAtom);
+         }
+      }
+   }
+
+   /*
+   * Read a frame.
+   */
+   bool CompressedTrajectoryReader::readFrame(std::ifstream& file)
+   {
+      long iStep;
+      Boundary& boundary = configuration().boundary();
+      Vector* velocities = 0;
+      if (decoder_.hasVelocities()) {
+         velocities = velocities_.cArray();
+      }
+      if (!decoder_.readFrame(file, iStep, boundary, 
+                              positions_.cArray(), velocities)) {
+         return false;
+      }
+
+      AtomStorage* storagePtr = &configuration().atoms();
+      Atom* atomPtr;
+      int nAtom = decoder_.nAtom();
+      for (int id = 0; id < nAtom; ++id) {
+         atomPtr = storagePtr->ptr(id);
+         if (atomPtr == 0) {
+            UTIL_THROW("Unknown atom");
+         }
+         boundary.transformGenToCart(positions_[id], atomPtr->position);
+         if (velocities) {
+            atomPtr->velocity = velocities_[id];
+         }
+      }
+
+      return true;
+   }
+
+}
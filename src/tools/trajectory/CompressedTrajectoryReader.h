@@ -0,0 +1,78 @@
+#ifndef TOOLS_COMPRESSED_TRAJECTORY_READER_H
+#define TOOLS_COMPRESSED_TRAJECTORY_READER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <tools/trajectory/TrajectoryReader.h>           // base class
+#include <simp/trajectory/CompressedTrajectoryDecoder.h> // member
+#include <util/containers/DArray.h>                      // member
+#include <util/space/Vector.h>                           // member
+
+namespace Tools
+{
+
+   class Configuration;
+   using namespace Util;
+   using namespace Simp;
+
+   /**
+   * Reader for the compressed, indexed trajectory file format.
+   *
+   * See Simp::CompressedTrajectoryEncoder for the file format. Atom
+   * ids in the file are 0,...,nAtom-1. Velocities are also read if
+   * present in the file.
+   *
+   * \ingroup Tools_Trajectory_Module
+   */
+   class CompressedTrajectoryReader  : public TrajectoryReader
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param configuration parent Configuration object
+      */
+      CompressedTrajectoryReader(Configuration& configuration);
+
+      /**
+      * Destructor.
+      */
+      virtual ~CompressedTrajectoryReader();
+
+      /**
+      * Read the header and frame index.
+      *
+      * \param file input file 
+      */
+      virtual void readHeader(std::ifstream& file);
+
+      /**
+      * Read a frame.
+      *
+      * \param file input file 
+      * \return true if a frame was found, false if end of file
+      */
+      virtual bool readFrame(std::ifstream& file);
+
+   private:
+
+      /// Decompression and frame index.
+      CompressedTrajectoryDecoder decoder_;
+
+      /// Generalized positions, indexed by id.
+      DArray<Vector> positions_;
+
+      /// Velocities, indexed by id (allocated only if in file).
+      DArray<Vector> velocities_;
+
+   };
+
+}
+#endif
@@ -2,6 +2,7 @@ tools_trajectory_=\
    tools/trajectory/TrajectoryReader.cpp \
    tools/trajectory/LammpsDumpReader.cpp \
    tools/trajectory/DdMdTrajectoryReader.cpp \
+   tools/trajectory/CompressedTrajectoryReader.cpp \
    tools/trajectory/TrajectoryReaderFactory.cpp 
 
 tools_trajectory_SRCS=\